@@ -0,0 +1,33 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _ANIMATIONBENCHMARKS_H
+#define _ANIMATIONBENCHMARKS_H
+
+#include "Benchmarks/BenchmarkSuite.h"
+
+namespace AnimationProgramming::Benchmarks
+{
+	/**
+	* Benchmarks of the Animator phases, Timeline::Update and the playback of a crowd (Pose cache, transitions, sync groups, blend spaces, baked animations,
+	* lanes, skeleton instances), on the skeleton and animation of the stub engine
+	*/
+	class AnimationBenchmarks final
+	{
+	public:
+		/* Prevent this static class from being instancied */
+		AnimationBenchmarks() = delete;
+
+		/**
+		* Add every benchmark of this category to the given suite
+		* @param p_suite
+		*/
+		static void Register(BenchmarkSuite& p_suite);
+	};
+}
+
+#endif // _ANIMATIONBENCHMARKS_H
@@ -0,0 +1,93 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _BENCHMARKFIXTURES_H
+#define _BENCHMARKFIXTURES_H
+
+#include <functional>
+#include <memory>
+#include <stdint.h>
+
+#include "AnimationProgramming/Animation/Animator.h"
+#include "AnimationProgramming/Rig/SkeletonDefinition.h"
+
+namespace AnimationProgramming::Benchmarks
+{
+	/* Duration of one frame of the fixtures */
+	constexpr float kFrameTime = 1.0f / 60.0f;
+
+	/* Characters of the crowd fixtures */
+	constexpr uint32_t kCrowdSize = 64;
+
+	/* The ends of the first two limbs of the stub skeleton play the feet */
+	constexpr uint32_t kStubLeftFoot = 15;
+	constexpr uint32_t kStubRightFoot = 23;
+
+	/**
+	* Return the definition of the stub skeleton, shared by every crowd character
+	*/
+	std::shared_ptr<const Rig::SkeletonDefinition> GetCrowdDefinition();
+
+	/**
+	* Return the number of threads of a default Tools::ThreadPool (Known before any fixture creates its pool)
+	*/
+	uint32_t GetThreadPoolSize();
+
+	/**
+	* A character of a crowd (Its own animator, no skeleton : the definition is shared)
+	*/
+	struct CrowdCharacter final
+	{
+		CrowdCharacter();
+
+		Animation::Animator animator;
+	};
+
+	/**
+	* A fixture created by the first benchmark using it, so that filtered out benchmarks don't build (Or write) anything.
+	* The suite calls every body once before measuring it (See BenchmarkSuite::Run), so the creation is never timed
+	*/
+	template<typename T>
+	class LazyFixture final
+	{
+	public:
+		/**
+		* Return a lazy fixture constructed from the given arguments on first use
+		* @param p_arguments (Copied until the creation)
+		*/
+		template<typename... Args>
+		static std::shared_ptr<LazyFixture> Create(Args... p_arguments)
+		{
+			return std::make_shared<LazyFixture>([p_arguments...] { return std::make_unique<T>(p_arguments...); });
+		}
+
+		/**
+		* Create a lazy fixture from the given factory
+		* @param p_factory
+		*/
+		LazyFixture(std::function<std::unique_ptr<T>()> p_factory) :
+			m_factory(std::move(p_factory))
+		{}
+
+		/**
+		* Return the fixture, created if it is the first call
+		*/
+		T& Get()
+		{
+			if (!m_fixture)
+				m_fixture = m_factory();
+
+			return *m_fixture;
+		}
+
+	private:
+		std::function<std::unique_ptr<T>()> m_factory;
+		std::unique_ptr<T> m_fixture;
+	};
+}
+
+#endif // _BENCHMARKFIXTURES_H
@@ -0,0 +1,58 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _BENCHMARKREPORT_H
+#define _BENCHMARKREPORT_H
+
+#include <string>
+#include <vector>
+
+#include "Benchmarks/BenchmarkResult.h"
+
+namespace AnimationProgramming::Benchmarks
+{
+	/**
+	* Serialization of benchmark results (JSON) and comparison against a stored baseline
+	*/
+	class BenchmarkReport final
+	{
+	public:
+		/* Prevent this static class from being instancied */
+		BenchmarkReport() = delete;
+
+		/**
+		* Return the given results as a JSON document
+		* @param p_results
+		*/
+		static std::string ToJson(const std::vector<BenchmarkResult>& p_results);
+
+		/**
+		* Write the given results as JSON into the given file. Return false if the file can't be written
+		* @param p_results
+		* @param p_filePath
+		*/
+		static bool WriteJson(const std::vector<BenchmarkResult>& p_results, const std::string& p_filePath);
+
+		/**
+		* Read results from a JSON file written by WriteJson. Return false if the file can't be read
+		* @param p_filePath
+		* @param p_results
+		*/
+		static bool ReadJson(const std::string& p_filePath, std::vector<BenchmarkResult>& p_results);
+
+		/**
+		* Print the difference between the current results and the baseline, and return the number of regressions
+		* (Benchmarks that got slower by more than p_thresholdPercent). Benchmarks missing from the baseline are ignored
+		* @param p_baseline
+		* @param p_current
+		* @param p_thresholdPercent
+		*/
+		static uint32_t Compare(const std::vector<BenchmarkResult>& p_baseline, const std::vector<BenchmarkResult>& p_current, double p_thresholdPercent);
+	};
+}
+
+#endif // _BENCHMARKREPORT_H
@@ -0,0 +1,30 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _BENCHMARKRESULT_H
+#define _BENCHMARKRESULT_H
+
+#include <stdint.h>
+#include <string>
+
+namespace AnimationProgramming::Benchmarks
+{
+	/**
+	* Result of one benchmark (The fastest repetition is kept)
+	*/
+	struct BenchmarkResult final
+	{
+		std::string name;
+		double nanosecondsPerIteration = 0.0;
+		uint64_t iterations = 0;
+
+		/* Throughput, for benchmarks that process several items per iteration (0 otherwise) */
+		double itemsPerSecondPerThread = 0.0;
+	};
+}
+
+#endif // _BENCHMARKRESULT_H
@@ -0,0 +1,80 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _BENCHMARKSUITE_H
+#define _BENCHMARKSUITE_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Benchmarks/BenchmarkResult.h"
+
+namespace AnimationProgramming::Benchmarks
+{
+	/**
+	* A list of named benchmarks. Each benchmark is run enough iterations to last a minimum duration,
+	* several times, and the fastest repetition is kept to reduce noise
+	*/
+	class BenchmarkSuite final
+	{
+	public:
+		/**
+		* A benchmark body must run the measured code p_iterations times (Looping inside the body
+		* avoids measuring the cost of calling a std::function per iteration)
+		*/
+		using Body = std::function<void(uint64_t p_iterations)>;
+
+		/**
+		* Register a benchmark
+		* @param p_name (Use "Category/Operation" names so they can be filtered)
+		* @param p_body
+		* @param p_itemsPerIteration (If not 0, the throughput per thread is reported too)
+		* @param p_threadCount (Number of threads the body runs on)
+		*/
+		void Add(const std::string& p_name, Body p_body, uint64_t p_itemsPerIteration = 0, uint32_t p_threadCount = 1);
+
+		/**
+		* Run every benchmark whose name contains p_filter and return the results (Progress is printed to the standard output)
+		* @param p_filter (Empty to run every benchmark)
+		* @param p_minimumMilliseconds (Minimum duration of one repetition)
+		* @param p_repetitions
+		*/
+		std::vector<BenchmarkResult> Run(const std::string& p_filter, double p_minimumMilliseconds, uint32_t p_repetitions) const;
+
+		/**
+		* Make the given value observable so the compiler can't remove the code that produced it
+		* @param p_value
+		*/
+		static void Consume(float p_value);
+
+		/**
+		* Print the result of a correctness check made by a benchmark or its fixture (A failed check makes the program exit with an error code)
+		* @param p_description
+		* @param p_passed
+		*/
+		static void Check(const std::string& p_description, bool p_passed);
+
+		/**
+		* Return the number of checks that failed so far
+		*/
+		static uint32_t GetFailedCheckCount();
+
+	private:
+		struct Benchmark final
+		{
+			std::string name;
+			Body body;
+			uint64_t itemsPerIteration;
+			uint32_t threadCount;
+		};
+
+		std::vector<Benchmark> m_benchmarks;
+	};
+}
+
+#endif // _BENCHMARKSUITE_H
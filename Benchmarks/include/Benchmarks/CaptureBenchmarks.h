@@ -0,0 +1,32 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _CAPTUREBENCHMARKS_H
+#define _CAPTUREBENCHMARKS_H
+
+#include "Benchmarks/BenchmarkSuite.h"
+
+namespace AnimationProgramming::Benchmarks
+{
+	/**
+	* Benchmarks of the capture of a crowd : pose streams (Written and decoded) and animator snapshots (Saved and restored)
+	*/
+	class CaptureBenchmarks final
+	{
+	public:
+		/* Prevent this static class from being instancied */
+		CaptureBenchmarks() = delete;
+
+		/**
+		* Add every benchmark of this category to the given suite
+		* @param p_suite
+		*/
+		static void Register(BenchmarkSuite& p_suite);
+	};
+}
+
+#endif // _CAPTUREBENCHMARKS_H
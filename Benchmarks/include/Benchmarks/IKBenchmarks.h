@@ -0,0 +1,32 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _IKBENCHMARKS_H
+#define _IKBENCHMARKS_H
+
+#include "Benchmarks/BenchmarkSuite.h"
+
+namespace AnimationProgramming::Benchmarks
+{
+	/**
+	* Benchmarks of the IK solvers and of the other passes applied to a sampled pose (Foot planting, aim constraints, spring bones), per character and for a crowd
+	*/
+	class IKBenchmarks final
+	{
+	public:
+		/* Prevent this static class from being instancied */
+		IKBenchmarks() = delete;
+
+		/**
+		* Add every benchmark of this category to the given suite
+		* @param p_suite
+		*/
+		static void Register(BenchmarkSuite& p_suite);
+	};
+}
+
+#endif // _IKBENCHMARKS_H
@@ -0,0 +1,32 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _MATHBENCHMARKS_H
+#define _MATHBENCHMARKS_H
+
+#include "Benchmarks/BenchmarkSuite.h"
+
+namespace AnimationProgramming::Benchmarks
+{
+	/**
+	* Benchmarks of the AltMath primitives, the SIMD kernels (Per instruction set) and Matrix3x4
+	*/
+	class MathBenchmarks final
+	{
+	public:
+		/* Prevent this static class from being instancied */
+		MathBenchmarks() = delete;
+
+		/**
+		* Add every benchmark of this category to the given suite
+		* @param p_suite
+		*/
+		static void Register(BenchmarkSuite& p_suite);
+	};
+}
+
+#endif // _MATHBENCHMARKS_H
@@ -0,0 +1,32 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _MOTIONBENCHMARKS_H
+#define _MOTIONBENCHMARKS_H
+
+#include "Benchmarks/BenchmarkSuite.h"
+
+namespace AnimationProgramming::Benchmarks
+{
+	/**
+	* Benchmarks of the motion analysis : transition index, motion matching queries against the size of the database, and retargeting to another rig
+	*/
+	class MotionBenchmarks final
+	{
+	public:
+		/* Prevent this static class from being instancied */
+		MotionBenchmarks() = delete;
+
+		/**
+		* Add every benchmark of this category to the given suite
+		* @param p_suite
+		*/
+		static void Register(BenchmarkSuite& p_suite);
+	};
+}
+
+#endif // _MOTIONBENCHMARKS_H
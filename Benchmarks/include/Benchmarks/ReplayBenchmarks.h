@@ -0,0 +1,36 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _REPLAYBENCHMARKS_H
+#define _REPLAYBENCHMARKS_H
+
+#include <string>
+
+#include "Benchmarks/BenchmarkSuite.h"
+
+namespace AnimationProgramming::Benchmarks
+{
+	/**
+	* Headless replay of a session recorded by the application (Input::InputRecorder) : the same delta times and keys drive a stub character,
+	* so that a performance run can be reproduced exactly, on any machine
+	*/
+	class ReplayBenchmarks final
+	{
+	public:
+		/* Prevent this static class from being instancied */
+		ReplayBenchmarks() = delete;
+
+		/**
+		* Add the replay of the given recording to the given suite (Nothing is added if the recording can't be loaded)
+		* @param p_suite
+		* @param p_recordingPath
+		*/
+		static void Register(BenchmarkSuite& p_suite, const std::string& p_recordingPath);
+	};
+}
+
+#endif // _REPLAYBENCHMARKS_H
@@ -0,0 +1,32 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _SKINNINGBENCHMARKS_H
+#define _SKINNINGBENCHMARKS_H
+
+#include "Benchmarks/BenchmarkSuite.h"
+
+namespace AnimationProgramming::Benchmarks
+{
+	/**
+	* Benchmarks of Skinning::CPUSkinning on a synthetic mesh, for every supported SIMD level, on one thread and on a thread pool
+	*/
+	class SkinningBenchmarks final
+	{
+	public:
+		/* Prevent this static class from being instancied */
+		SkinningBenchmarks() = delete;
+
+		/**
+		* Add every benchmark of this category to the given suite
+		* @param p_suite
+		*/
+		static void Register(BenchmarkSuite& p_suite);
+	};
+}
+
+#endif // _SKINNINGBENCHMARKS_H
@@ -0,0 +1,43 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _STUBENGINE_H
+#define _STUBENGINE_H
+
+#include <stdint.h>
+
+namespace AnimationProgramming::Benchmarks
+{
+	/**
+	* Headless implementation of the engine API (Engine/Engine.h) used by the benchmarks.
+	* It exposes a procedural skeleton (A spine with limbs, followed by IK bones like the real mannequin)
+	* and procedural animations, so the animation code can run without a window or resources
+	*/
+	class StubEngine final
+	{
+	public:
+		/* Prevent this static class from being instancied */
+		StubEngine() = delete;
+
+		/* Bones used by the animation code (AnimationEngine::GetSkeletonBoneCount ignores the IK bones) */
+		static constexpr uint32_t BoneCount		= 64;
+		static constexpr uint32_t IKBoneCount	= 7;
+		static constexpr uint32_t KeyFrameCount	= 30;
+
+		/**
+		* Return the number of skinning poses received through SetSkinningPose
+		*/
+		static uint64_t GetSkinningPoseCount();
+
+		/**
+		* Return the first element of the last skinning pose received (Consumed by benchmarks to keep the pose alive)
+		*/
+		static float GetLastSkinningPoseFirstValue();
+	};
+}
+
+#endif // _STUBENGINE_H
@@ -0,0 +1,32 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _TOOLSBENCHMARKS_H
+#define _TOOLSBENCHMARKS_H
+
+#include "Benchmarks/BenchmarkSuite.h"
+
+namespace AnimationProgramming::Benchmarks
+{
+	/**
+	* Benchmarks of Tools::Event::Invoke and GyvrIni::Core::IniFile::Get
+	*/
+	class ToolsBenchmarks final
+	{
+	public:
+		/* Prevent this static class from being instancied */
+		ToolsBenchmarks() = delete;
+
+		/**
+		* Add every benchmark of this category to the given suite
+		* @param p_suite
+		*/
+		static void Register(BenchmarkSuite& p_suite);
+	};
+}
+
+#endif // _TOOLSBENCHMARKS_H
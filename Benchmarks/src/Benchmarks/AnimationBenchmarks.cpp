@@ -0,0 +1,724 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <cmath>
+#include <iostream>
+#include <memory>
+
+#include "AnimationProgramming/Animation/AnimationBaker.h"
+#include "AnimationProgramming/Animation/BlendSpacePlayer.h"
+#include "AnimationProgramming/Animation/CrowdEvaluator.h"
+#include "AnimationProgramming/Animation/PoseCache.h"
+#include "AnimationProgramming/Animation/SyncGroup.h"
+#include "AnimationProgramming/Animation/SyncMarkerTrack.h"
+#include "AnimationProgramming/Animation/Timeline.h"
+#include "AnimationProgramming/Rig/Skeleton.h"
+#include "AnimationProgramming/Rig/SkeletonInstance.h"
+#include "AnimationProgramming/Tools/SIMD.h"
+#include "AnimationProgramming/Tools/ThreadPool.h"
+
+#include "Benchmarks/AnimationBenchmarks.h"
+#include "Benchmarks/BenchmarkFixtures.h"
+#include "Benchmarks/StubEngine.h"
+
+namespace
+{
+	using namespace AnimationProgramming;
+	using namespace AnimationProgramming::Benchmarks;
+
+	/**
+	* A skeleton playing a looping animation of the stub engine (Members are declared in dependency order)
+	*/
+	struct AnimationFixture final
+	{
+		AnimationFixture() :
+			animationInfo("ThirdPersonWalk.anim"),
+			animationInstance(animationInfo),
+			animator(skeleton)
+		{
+			skeleton.CreateSkeletonFromBindPose();
+
+			animationInstance.loop = true;
+			animator.PlayAnimation(animationInstance);
+
+			timeline.SyncToAnimation(animationInstance);
+			timeline.Play();
+		}
+
+		Rig::Skeleton skeleton;
+		Animation::AnimationInfo animationInfo;
+		Animation::AnimationInstance animationInstance;
+		Animation::Animator animator;
+		Animation::Timeline timeline;
+	};
+
+	/**
+	* A crowd of characters that started the same looping animation together
+	*/
+	struct CrowdFixture final
+	{
+		CrowdFixture() :
+			animationInfo("ThirdPersonWalk.anim"),
+			animationInstance(animationInfo)
+		{
+			animationInstance.loop = true;
+
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+			{
+				characters.push_back(std::make_unique<CrowdCharacter>());
+				characters.back()->animator.PlayAnimation(animationInstance);
+			}
+		}
+
+		/**
+		* Update every character for one frame, using the pose cache or not
+		*/
+		void UpdateFrame(bool p_usePoseCache, Tools::ThreadPool* p_threadPool)
+		{
+			poseCache.BeginFrame();
+
+			for (auto& character : characters)
+				character->animator.SetPoseCache(p_usePoseCache ? &poseCache : nullptr);
+
+			auto updateCharacters = [this](uint32_t p_begin, uint32_t p_end)
+			{
+				for (uint32_t i = p_begin; i < p_end; ++i)
+					characters[i]->animator.UpdatePose(kFrameTime);
+			};
+
+			if (p_threadPool)
+				p_threadPool->ParallelFor(kCrowdSize, 4, updateCharacters);
+			else
+				updateCharacters(0, kCrowdSize);
+		}
+
+		Animation::AnimationInfo animationInfo;
+		Animation::AnimationInstance animationInstance;
+		Animation::PoseCache poseCache;
+		std::vector<std::unique_ptr<CrowdCharacter>> characters;
+		Tools::ThreadPool threadPool;
+	};
+
+	/**
+	* A crowd of characters switching between two animations every frame, with the given transition mode
+	*/
+	struct TransitionCrowdFixture final
+	{
+		TransitionCrowdFixture(Animation::ETransitionMode p_mode) :
+			walkInfo("ThirdPersonWalk.anim"),
+			runInfo("ThirdPersonRun.anim"),
+			walk(walkInfo),
+			run(runInfo)
+		{
+			walk.loop = true;
+			run.loop = true;
+
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+			{
+				characters.push_back(std::make_unique<CrowdCharacter>());
+				characters.back()->animator.SetTransitionMode(p_mode);
+				characters.back()->animator.PlayAnimation(walk);
+				characters.back()->animator.UpdatePose(kFrameTime);
+			}
+		}
+
+		/**
+		* Make every character switch to the other animation, then update them for one frame
+		*/
+		void SwitchAndUpdateFrame()
+		{
+			Animation::AnimationInstance& next = playingWalk ? run : walk;
+
+			for (auto& character : characters)
+			{
+				character->animator.PlayAnimation(next);
+				character->animator.UpdatePose(kFrameTime);
+			}
+
+			playingWalk = !playingWalk;
+		}
+
+		Animation::AnimationInfo walkInfo;
+		Animation::AnimationInfo runInfo;
+		Animation::AnimationInstance walk;
+		Animation::AnimationInstance run;
+		std::vector<std::unique_ptr<CrowdCharacter>> characters;
+		bool playingWalk = true;
+	};
+
+	/**
+	* A crowd of characters blending walk and run in a sync group (Each character has its own group, the marker tracks are shared)
+	*/
+	struct SyncGroupCrowdFixture final
+	{
+		SyncGroupCrowdFixture() :
+			walkInfo("ThirdPersonWalk.anim"),
+			runInfo("ThirdPersonRun.anim"),
+			walk(walkInfo),
+			run(runInfo)
+		{
+			walk.loop = true;
+			run.loop = true;
+
+			Rig::Skeleton skeleton;
+			skeleton.CreateSkeletonFromBindPose();
+
+			walkMarkers = std::make_unique<Animation::SyncMarkerTrack>(Animation::SyncMarkerTrack::CreateFromFootContacts(skeleton, walk, kStubLeftFoot, kStubRightFoot));
+			runMarkers = std::make_unique<Animation::SyncMarkerTrack>(Animation::SyncMarkerTrack::CreateFromFootContacts(skeleton, run, kStubLeftFoot, kStubRightFoot));
+
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+			{
+				groups.push_back(std::make_unique<Animation::SyncGroup>());
+				groups.back()->AddAnimation(*walkMarkers, 1.0f);
+				groups.back()->AddAnimation(*runMarkers, 2.0f);
+				groups.back()->SetSpeed(1.5f);
+
+				characters.push_back(std::make_unique<CrowdCharacter>());
+				characters.back()->animator.PlayPoseSource(*groups.back());
+			}
+		}
+
+		/**
+		* Update every character for one frame
+		*/
+		void UpdateFrame()
+		{
+			for (auto& character : characters)
+				character->animator.UpdatePose(kFrameTime);
+		}
+
+		Animation::AnimationInfo walkInfo;
+		Animation::AnimationInfo runInfo;
+		Animation::AnimationInstance walk;
+		Animation::AnimationInstance run;
+		std::unique_ptr<Animation::SyncMarkerTrack> walkMarkers;
+		std::unique_ptr<Animation::SyncMarkerTrack> runMarkers;
+		std::vector<std::unique_ptr<Animation::SyncGroup>> groups;
+		std::vector<std::unique_ptr<CrowdCharacter>> characters;
+	};
+
+	/**
+	* A blend space of the given number of samples (On a jittered grid, like directional clips at several speeds), and a crowd playing it
+	*/
+	struct BlendSpaceFixture final
+	{
+		BlendSpaceFixture(uint32_t p_samplesPerAxis) :
+			animationInfo("ThirdPersonWalk.anim"),
+			animationInstance(animationInfo)
+		{
+			animationInstance.loop = true;
+
+			for (uint32_t y = 0; y < p_samplesPerAxis; ++y)
+			{
+				for (uint32_t x = 0; x < p_samplesPerAxis; ++x)
+				{
+					const float jitter = 0.25f * std::sin(static_cast<float>(x * 7 + y * 13));
+					blendSpace.AddSample(animationInstance, AltMath::Vector2f(static_cast<float>(x) + jitter, static_cast<float>(y) - jitter));
+				}
+			}
+
+			blendSpace.Build();
+
+			const float extent = static_cast<float>(p_samplesPerAxis - 1);
+
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+			{
+				players.push_back(std::make_unique<Animation::BlendSpacePlayer>(blendSpace));
+				players.back()->SetPosition(AltMath::Vector2f(extent * (0.5f + 0.4f * std::sin(i * 0.37f)), extent * (0.5f + 0.4f * std::cos(i * 0.61f))));
+
+				characters.push_back(std::make_unique<CrowdCharacter>());
+				characters.back()->animator.PlayPoseSource(*players.back());
+			}
+		}
+
+		/**
+		* Move every character in the blend space, then update them for one frame
+		*/
+		void UpdateFrame()
+		{
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+			{
+				const AltMath::Vector2f& position = players[i]->GetPosition();
+				players[i]->SetPosition(AltMath::Vector2f(position.x + 0.01f, position.y));
+				characters[i]->animator.UpdatePose(kFrameTime);
+			}
+		}
+
+		Animation::AnimationInfo animationInfo;
+		Animation::AnimationInstance animationInstance;
+		Animation::BlendSpace2D blendSpace;
+		std::vector<std::unique_ptr<Animation::BlendSpacePlayer>> players;
+		std::vector<std::unique_ptr<CrowdCharacter>> characters;
+	};
+
+	/**
+	* Find the weights at many positions of the given blend space (One per iteration)
+	*/
+	void FindBlendSpaceWeights(const Animation::BlendSpace2D& p_blendSpace, float p_extent, uint64_t p_iterations)
+	{
+		Animation::BlendSpace2D::Weights weights;
+		float total = 0.0f;
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+		{
+			const float x = p_extent * (0.5f + 0.5f * std::sin(static_cast<float>(i) * 0.37f));
+			const float y = p_extent * (0.5f + 0.5f * std::cos(static_cast<float>(i) * 0.23f));
+
+			p_blendSpace.FindWeights(AltMath::Vector2f(x, y), weights);
+			total += weights.weights[0];
+		}
+
+		Benchmarks::BenchmarkSuite::Consume(total);
+	}
+
+	constexpr float kBakedSampleRate = 30.0f;
+
+	/**
+	* A crowd of characters playing the same looping animation, baked in full and half precision
+	*/
+	struct BakedCrowdFixture final
+	{
+		BakedCrowdFixture() :
+			animationInfo("ThirdPersonWalk.anim"),
+			animationInstance(animationInfo)
+		{
+			skeleton.CreateSkeletonFromBindPose();
+			animationInstance.loop = true;
+
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+				characters.push_back(std::make_unique<CrowdCharacter>());
+
+			fullPrecision = Animation::AnimationBaker::Bake(*skeleton.GetDefinition(), animationInstance, kBakedSampleRate, Animation::EBakedPrecision::FULL, &threadPool);
+			halfPrecision = Animation::AnimationBaker::Bake(*skeleton.GetDefinition(), animationInstance, kBakedSampleRate, Animation::EBakedPrecision::HALF, &threadPool);
+		}
+
+		/**
+		* Make every character play the given baked animation, if it isn't already the case
+		*/
+		void Play(const Animation::BakedAnimation& p_bakedAnimation)
+		{
+			if (playing == &p_bakedAnimation)
+				return;
+
+			for (auto& character : characters)
+				character->animator.PlayBakedAnimation(p_bakedAnimation);
+
+			playing = &p_bakedAnimation;
+		}
+
+		/**
+		* Update every character for one frame
+		*/
+		void UpdateFrame()
+		{
+			for (auto& character : characters)
+				character->animator.UpdatePose(kFrameTime);
+		}
+
+		Rig::Skeleton skeleton;
+		Animation::AnimationInfo animationInfo;
+		Animation::AnimationInstance animationInstance;
+		std::vector<std::unique_ptr<CrowdCharacter>> characters;
+		Tools::ThreadPool threadPool;
+		Animation::BakedAnimation fullPrecision;
+		Animation::BakedAnimation halfPrecision;
+		const Animation::BakedAnimation* playing = nullptr;
+	};
+
+	/**
+	* A crowd of characters evaluated by lanes, playing two animations at different times
+	*/
+	struct LaneCrowdFixture final
+	{
+		LaneCrowdFixture() :
+			animationInfo("ThirdPersonWalk.anim"),
+			walk(animationInfo),
+			walkBackward(animationInfo)
+		{
+			skeleton.CreateSkeletonFromBindPose();
+			crowdEvaluator = std::make_unique<Animation::CrowdEvaluator>(*skeleton.GetDefinition());
+
+			walk.loop = true;
+			walkBackward.loop = true;
+			walkBackward.reverse = true;
+
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+				crowdEvaluator->AddCharacter(i % 2 ? walkBackward : walk, static_cast<float>(i) * 0.01f);
+		}
+
+		Rig::Skeleton skeleton;
+		Animation::AnimationInfo animationInfo;
+		Animation::AnimationInstance walk;
+		Animation::AnimationInstance walkBackward;
+		std::unique_ptr<Animation::CrowdEvaluator> crowdEvaluator;
+		Tools::ThreadPool threadPool;
+		std::vector<Data::Matrix3x4> palette;
+	};
+
+	/**
+	* A walking crowd sharing one skeleton definition (Each character at its own time in the walk)
+	*/
+	struct SkeletonInstanceFixture final
+	{
+		SkeletonInstanceFixture() :
+			animationInfo("ThirdPersonWalk.anim"),
+			animationInstance(animationInfo)
+		{
+			skeleton.CreateSkeletonFromBindPose();
+			definition = skeleton.GetDefinition();
+
+			animationInstance.loop = true;
+
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+			{
+				instances.emplace_back(definition);
+				times.push_back(static_cast<float>(i) * 0.05f);
+			}
+
+			std::cout << "Skeleton instance: " << instances.front().GetMemorySize() << " bytes per character ("
+				<< skeleton.GetBones().size() * sizeof(Rig::Bone) << " bytes of bones per Rig::Skeleton, without names and listeners)" << std::endl;
+		}
+
+		void UpdateFrame()
+		{
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+			{
+				times[i] = std::fmod(times[i] + kFrameTime, animationInstance.GetDuration());
+
+				animationInstance.SamplePose(times[i], instances[i].GetLocalPose());
+				instances[i].UpdateModelMatrices();
+				instances[i].CalculateSkinningPalette();
+			}
+		}
+
+		Rig::Skeleton skeleton;
+		std::shared_ptr<const Rig::SkeletonDefinition> definition;
+		Animation::AnimationInfo animationInfo;
+		Animation::AnimationInstance animationInstance;
+		std::vector<Rig::SkeletonInstance> instances;
+		std::vector<float> times;
+	};
+}
+
+void AnimationProgramming::Benchmarks::AnimationBenchmarks::Register(BenchmarkSuite& p_suite)
+{
+	auto animation = LazyFixture<AnimationFixture>::Create();
+
+	p_suite.Add("Animator/UpdateFrameTransformations", [animation](uint64_t p_iterations)
+	{
+		AnimationFixture& fixture = animation->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.animator.UpdateFrameTransformations();
+	});
+
+	p_suite.Add("Animator/ApplyAnimationToSkeleton", [animation](uint64_t p_iterations)
+	{
+		AnimationFixture& fixture = animation->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.animator.ApplyAnimationToSkeleton();
+
+		BenchmarkSuite::Consume(fixture.skeleton.GetBones().back().GetTransform().GetWorldMatrix().elements[3]);
+	});
+
+	p_suite.Add("Animator/SendSkinningMatricesToGPU", [animation](uint64_t p_iterations)
+	{
+		AnimationFixture& fixture = animation->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+		{
+			fixture.animator.SendSkinningMatricesToGPU();
+			BenchmarkSuite::Consume(StubEngine::GetLastSkinningPoseFirstValue());
+		}
+	});
+
+	p_suite.Add("Animator/SendSkinningDualQuaternionsToGPU", [animation](uint64_t p_iterations)
+	{
+		AnimationFixture& fixture = animation->Get();
+
+		fixture.animator.SetSkinningPaletteFormat(Animation::ESkinningPaletteFormat::DUAL_QUATERNION);
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+		{
+			fixture.animator.SendSkinningMatricesToGPU();
+			BenchmarkSuite::Consume(StubEngine::GetLastSkinningPoseFirstValue());
+		}
+
+		fixture.animator.SetSkinningPaletteFormat(Animation::ESkinningPaletteFormat::MATRIX);
+	});
+
+	p_suite.Add("Animator/Update", [animation](uint64_t p_iterations)
+	{
+		AnimationFixture& fixture = animation->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+		{
+			fixture.animator.Update(kFrameTime);
+			BenchmarkSuite::Consume(StubEngine::GetLastSkinningPoseFirstValue());
+		}
+	});
+
+	/* One iteration is one frame of a 144 Hz display : the animation ticks every frame, or at 30 Hz with interpolated palettes */
+	p_suite.Add("Animator/Update.144Hz", [animation](uint64_t p_iterations)
+	{
+		AnimationFixture& fixture = animation->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+		{
+			fixture.animator.Update(1.0f / 144.0f);
+			BenchmarkSuite::Consume(StubEngine::GetLastSkinningPoseFirstValue());
+		}
+	});
+
+	p_suite.Add("Animator/Update.144Hz.Tick30", [animation](uint64_t p_iterations)
+	{
+		AnimationFixture& fixture = animation->Get();
+
+		fixture.animator.SetTickRate(30.0f);
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+		{
+			fixture.animator.Update(1.0f / 144.0f);
+			BenchmarkSuite::Consume(StubEngine::GetLastSkinningPoseFirstValue());
+		}
+
+		fixture.animator.SetTickRate(0.0f);
+	});
+
+	p_suite.Add("Timeline/Update", [animation](uint64_t p_iterations)
+	{
+		AnimationFixture& fixture = animation->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.timeline.Update(kFrameTime);
+
+		BenchmarkSuite::Consume(static_cast<float>(fixture.timeline.GetCurrentKeyFrame()));
+	});
+
+	auto crowd = LazyFixture<CrowdFixture>::Create();
+
+	/* One iteration is one frame of the whole crowd */
+	p_suite.Add("Crowd/UpdatePose", [crowd](uint64_t p_iterations)
+	{
+		CrowdFixture& fixture = crowd->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.UpdateFrame(false, nullptr);
+
+		BenchmarkSuite::Consume(fixture.characters.back()->animator.GetSkinningPalette().front().elements[3]);
+	}, kCrowdSize);
+
+	p_suite.Add("Crowd/UpdatePose.PoseCache", [crowd](uint64_t p_iterations)
+	{
+		CrowdFixture& fixture = crowd->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.UpdateFrame(true, nullptr);
+
+		BenchmarkSuite::Consume(fixture.characters.back()->animator.GetSkinningPalette().front().elements[3]);
+	}, kCrowdSize);
+
+	p_suite.Add("Crowd/UpdatePose.PoseCache.ThreadPool", [crowd](uint64_t p_iterations)
+	{
+		CrowdFixture& fixture = crowd->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.UpdateFrame(true, &fixture.threadPool);
+
+		BenchmarkSuite::Consume(fixture.characters.back()->animator.GetSkinningPalette().front().elements[3]);
+	}, kCrowdSize, GetThreadPoolSize());
+
+	auto crossfadeCrowd = LazyFixture<TransitionCrowdFixture>::Create(Animation::ETransitionMode::CROSSFADE);
+	auto inertializationCrowd = LazyFixture<TransitionCrowdFixture>::Create(Animation::ETransitionMode::INERTIALIZATION);
+
+	/* One iteration is one frame where the whole crowd starts a transition */
+	p_suite.Add("Crowd/Transition.Crossfade", [crossfadeCrowd](uint64_t p_iterations)
+	{
+		TransitionCrowdFixture& fixture = crossfadeCrowd->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.SwitchAndUpdateFrame();
+
+		BenchmarkSuite::Consume(fixture.characters.back()->animator.GetSkinningPalette().front().elements[3]);
+	}, kCrowdSize);
+
+	p_suite.Add("Crowd/Transition.Inertialization", [inertializationCrowd](uint64_t p_iterations)
+	{
+		TransitionCrowdFixture& fixture = inertializationCrowd->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.SwitchAndUpdateFrame();
+
+		BenchmarkSuite::Consume(fixture.characters.back()->animator.GetSkinningPalette().front().elements[3]);
+	}, kCrowdSize);
+
+	/* Switching every frame keeps the stack full : this is its worst case */
+	auto stackCrowd = LazyFixture<TransitionCrowdFixture>::Create(Animation::ETransitionMode::STACK);
+
+	p_suite.Add("Crowd/Transition.Stack", [stackCrowd](uint64_t p_iterations)
+	{
+		TransitionCrowdFixture& fixture = stackCrowd->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.SwitchAndUpdateFrame();
+
+		BenchmarkSuite::Consume(fixture.characters.back()->animator.GetSkinningPalette().front().elements[3]);
+	}, kCrowdSize);
+
+	/* Two animations are sampled and blended per character (Compare with Crowd/UpdatePose, which samples one) */
+	auto syncGroupCrowd = LazyFixture<SyncGroupCrowdFixture>::Create();
+
+	p_suite.Add("Crowd/SyncGroup", [syncGroupCrowd](uint64_t p_iterations)
+	{
+		SyncGroupCrowdFixture& fixture = syncGroupCrowd->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.UpdateFrame();
+
+		BenchmarkSuite::Consume(fixture.characters.back()->animator.GetSkinningPalette().front().elements[3]);
+	}, kCrowdSize);
+
+	/* One iteration is one phase to time lookup */
+	p_suite.Add("SyncMarkerTrack/GetTime", [syncGroupCrowd](uint64_t p_iterations)
+	{
+		SyncGroupCrowdFixture& fixture = syncGroupCrowd->Get();
+		float phase = 0.0f;
+		float time = 0.0f;
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+		{
+			time += fixture.walkMarkers->GetTime(phase);
+			phase += 0.0137f;
+		}
+
+		BenchmarkSuite::Consume(time);
+	});
+
+	/* The lookup cost shouldn't grow with the number of samples */
+	auto smallBlendSpace = LazyFixture<BlendSpaceFixture>::Create(4);
+	auto largeBlendSpace = LazyFixture<BlendSpaceFixture>::Create(20);
+
+	p_suite.Add("BlendSpace2D/FindWeights.16", [smallBlendSpace](uint64_t p_iterations)
+	{
+		FindBlendSpaceWeights(smallBlendSpace->Get().blendSpace, 3.0f, p_iterations);
+	});
+
+	p_suite.Add("BlendSpace2D/FindWeights.400", [largeBlendSpace](uint64_t p_iterations)
+	{
+		FindBlendSpaceWeights(largeBlendSpace->Get().blendSpace, 19.0f, p_iterations);
+	});
+
+	p_suite.Add("Crowd/BlendSpace", [largeBlendSpace](uint64_t p_iterations)
+	{
+		BlendSpaceFixture& fixture = largeBlendSpace->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.UpdateFrame();
+
+		BenchmarkSuite::Consume(fixture.characters.back()->animator.GetSkinningPalette().front().elements[3]);
+	}, kCrowdSize);
+
+	auto bakedCrowd = LazyFixture<BakedCrowdFixture>::Create();
+
+	p_suite.Add("Crowd/UpdatePose.Baked", [bakedCrowd](uint64_t p_iterations)
+	{
+		BakedCrowdFixture& fixture = bakedCrowd->Get();
+
+		fixture.Play(fixture.fullPrecision);
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.UpdateFrame();
+
+		BenchmarkSuite::Consume(fixture.characters.back()->animator.GetSkinningPalette().front().elements[3]);
+	}, kCrowdSize);
+
+	p_suite.Add("Crowd/UpdatePose.Baked.Half", [bakedCrowd](uint64_t p_iterations)
+	{
+		BakedCrowdFixture& fixture = bakedCrowd->Get();
+
+		fixture.Play(fixture.halfPrecision);
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.UpdateFrame();
+
+		BenchmarkSuite::Consume(fixture.characters.back()->animator.GetSkinningPalette().front().elements[3]);
+	}, kCrowdSize);
+
+	/* One iteration is the baking of the whole animation */
+	p_suite.Add("AnimationBaker/Bake", [bakedCrowd](uint64_t p_iterations)
+	{
+		BakedCrowdFixture& fixture = bakedCrowd->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+		{
+			const Animation::BakedAnimation baked = Animation::AnimationBaker::Bake(*fixture.skeleton.GetDefinition(), fixture.animationInstance, kBakedSampleRate);
+			BenchmarkSuite::Consume(static_cast<float>(baked.GetFrameCount()));
+		}
+	});
+
+	p_suite.Add("AnimationBaker/Bake.ThreadPool", [bakedCrowd](uint64_t p_iterations)
+	{
+		BakedCrowdFixture& fixture = bakedCrowd->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+		{
+			const Animation::BakedAnimation baked = Animation::AnimationBaker::Bake(*fixture.skeleton.GetDefinition(), fixture.animationInstance, kBakedSampleRate, Animation::EBakedPrecision::FULL, &fixture.threadPool);
+			BenchmarkSuite::Consume(static_cast<float>(baked.GetFrameCount()));
+		}
+	}, 0, GetThreadPoolSize());
+
+	auto laneCrowd = LazyFixture<LaneCrowdFixture>::Create();
+
+	p_suite.Add("Crowd/CrowdEvaluator.Scalar", [laneCrowd](uint64_t p_iterations)
+	{
+		LaneCrowdFixture& fixture = laneCrowd->Get();
+
+		Tools::SIMD::SetLevel(Tools::ESIMDLevel::SCALAR);
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.crowdEvaluator->Update(kFrameTime);
+
+		Tools::SIMD::SetLevel(Tools::SIMD::GetSupportedLevel());
+		fixture.crowdEvaluator->ReadPalette(kCrowdSize - 1, fixture.palette);
+		BenchmarkSuite::Consume(fixture.palette.front().elements[3]);
+	}, kCrowdSize);
+
+	p_suite.Add("Crowd/CrowdEvaluator", [laneCrowd](uint64_t p_iterations)
+	{
+		LaneCrowdFixture& fixture = laneCrowd->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.crowdEvaluator->Update(kFrameTime);
+
+		fixture.crowdEvaluator->ReadPalette(kCrowdSize - 1, fixture.palette);
+		BenchmarkSuite::Consume(fixture.palette.front().elements[3]);
+	}, kCrowdSize);
+
+	p_suite.Add("Crowd/CrowdEvaluator.ThreadPool", [laneCrowd](uint64_t p_iterations)
+	{
+		LaneCrowdFixture& fixture = laneCrowd->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.crowdEvaluator->Update(kFrameTime, &fixture.threadPool);
+
+		fixture.crowdEvaluator->ReadPalette(kCrowdSize - 1, fixture.palette);
+		BenchmarkSuite::Consume(fixture.palette.front().elements[3]);
+	}, kCrowdSize, GetThreadPoolSize());
+
+	/* Same work as Crowd/UpdatePose (Sample, hierarchy, palette) on skeleton instances. The memory owned by each character is reported on creation */
+	auto instanceCrowd = LazyFixture<SkeletonInstanceFixture>::Create();
+
+	p_suite.Add("Crowd/UpdatePose.SkeletonInstance", [instanceCrowd](uint64_t p_iterations)
+	{
+		SkeletonInstanceFixture& fixture = instanceCrowd->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.UpdateFrame();
+
+		BenchmarkSuite::Consume(fixture.instances.back().GetSkinningPalette()[24].elements[3]);
+	}, kCrowdSize);
+}
@@ -0,0 +1,31 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include "AnimationProgramming/Rig/Skeleton.h"
+#include "AnimationProgramming/Tools/ThreadPool.h"
+
+#include "Benchmarks/BenchmarkFixtures.h"
+
+std::shared_ptr<const AnimationProgramming::Rig::SkeletonDefinition> AnimationProgramming::Benchmarks::GetCrowdDefinition()
+{
+	static const std::shared_ptr<const Rig::SkeletonDefinition> definition = []
+	{
+		Rig::Skeleton skeleton;
+		skeleton.CreateSkeletonFromBindPose();
+		return skeleton.GetDefinition();
+	}();
+
+	return definition;
+}
+
+uint32_t AnimationProgramming::Benchmarks::GetThreadPoolSize()
+{
+	return Tools::ThreadPool::GetDefaultWorkerCount() + 1;
+}
+
+AnimationProgramming::Benchmarks::CrowdCharacter::CrowdCharacter() :
+	animator(GetCrowdDefinition())
+{}
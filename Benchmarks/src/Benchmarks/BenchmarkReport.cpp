@@ -0,0 +1,138 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+
+#include "Benchmarks/BenchmarkReport.h"
+
+namespace
+{
+	/**
+	* Return the raw text of the value following "p_key": in the given JSON object (Without quotes for strings)
+	*/
+	std::string ExtractJsonValue(const std::string& p_object, const std::string& p_key)
+	{
+		const size_t keyPosition = p_object.find("\"" + p_key + "\"");
+		if (keyPosition == std::string::npos)
+			return "";
+
+		size_t valueStart = p_object.find(':', keyPosition);
+		if (valueStart == std::string::npos)
+			return "";
+
+		valueStart = p_object.find_first_not_of(" \t\r\n", valueStart + 1);
+		if (valueStart == std::string::npos)
+			return "";
+
+		if (p_object[valueStart] == '"')
+		{
+			const size_t valueEnd = p_object.find('"', valueStart + 1);
+			return p_object.substr(valueStart + 1, valueEnd - valueStart - 1);
+		}
+
+		const size_t valueEnd = p_object.find_first_of(",}\r\n", valueStart);
+		return p_object.substr(valueStart, valueEnd - valueStart);
+	}
+}
+
+std::string AnimationProgramming::Benchmarks::BenchmarkReport::ToJson(const std::vector<BenchmarkResult>& p_results)
+{
+	std::ostringstream json;
+	json << std::fixed << std::setprecision(3);
+	json << "{\n\t\"benchmarks\": [\n";
+
+	for (size_t i = 0; i < p_results.size(); ++i)
+	{
+		json << "\t\t{ \"name\": \"" << p_results[i].name << "\", \"ns_per_iteration\": " << p_results[i].nanosecondsPerIteration << ", \"iterations\": " << p_results[i].iterations;
+
+		if (p_results[i].itemsPerSecondPerThread > 0.0)
+			json << ", \"items_per_second_per_thread\": " << p_results[i].itemsPerSecondPerThread;
+
+		json << " }";
+		json << (i + 1 < p_results.size() ? ",\n" : "\n");
+	}
+
+	json << "\t]\n}\n";
+	return json.str();
+}
+
+bool AnimationProgramming::Benchmarks::BenchmarkReport::WriteJson(const std::vector<BenchmarkResult>& p_results, const std::string& p_filePath)
+{
+	std::ofstream file(p_filePath);
+	if (!file)
+		return false;
+
+	file << ToJson(p_results);
+	return static_cast<bool>(file);
+}
+
+bool AnimationProgramming::Benchmarks::BenchmarkReport::ReadJson(const std::string& p_filePath, std::vector<BenchmarkResult>& p_results)
+{
+	std::ifstream file(p_filePath);
+	if (!file)
+		return false;
+
+	std::stringstream content;
+	content << file.rdbuf();
+	const std::string json = content.str();
+
+	/* Each result is a flat object, so we can simply iterate over the {...} blocks of the "benchmarks" array */
+	size_t objectStart = json.find('{', json.find('['));
+	while (objectStart != std::string::npos)
+	{
+		const size_t objectEnd = json.find('}', objectStart);
+		if (objectEnd == std::string::npos)
+			break;
+
+		const std::string object = json.substr(objectStart, objectEnd - objectStart + 1);
+
+		BenchmarkResult result;
+		result.name = ExtractJsonValue(object, "name");
+		result.nanosecondsPerIteration = std::atof(ExtractJsonValue(object, "ns_per_iteration").c_str());
+		result.iterations = std::strtoull(ExtractJsonValue(object, "iterations").c_str(), nullptr, 10);
+		result.itemsPerSecondPerThread = std::atof(ExtractJsonValue(object, "items_per_second_per_thread").c_str());
+
+		if (!result.name.empty())
+			p_results.push_back(result);
+
+		objectStart = json.find('{', objectEnd);
+	}
+
+	return true;
+}
+
+uint32_t AnimationProgramming::Benchmarks::BenchmarkReport::Compare(const std::vector<BenchmarkResult>& p_baseline, const std::vector<BenchmarkResult>& p_current, double p_thresholdPercent)
+{
+	std::unordered_map<std::string, double> baseline;
+	for (const BenchmarkResult& result : p_baseline)
+		baseline[result.name] = result.nanosecondsPerIteration;
+
+	uint32_t regressions = 0;
+
+	std::cout << std::endl << std::left << std::setw(56) << "Benchmark" << std::right << std::setw(14) << "Baseline" << std::setw(14) << "Current" << std::setw(10) << "Change" << std::endl;
+
+	for (const BenchmarkResult& result : p_current)
+	{
+		auto found = baseline.find(result.name);
+		if (found == baseline.end() || found->second <= 0.0)
+			continue;
+
+		const double change = (result.nanosecondsPerIteration - found->second) / found->second * 100.0;
+		const bool isRegression = change > p_thresholdPercent;
+		regressions += isRegression ? 1 : 0;
+
+		std::cout << std::left << std::setw(56) << result.name << std::right << std::fixed << std::setprecision(2) << std::setw(14) << found->second << std::setw(14) << result.nanosecondsPerIteration << std::setw(9) << std::showpos << change << std::noshowpos << "%" << (isRegression ? "  REGRESSION" : "") << std::endl;
+	}
+
+	std::cout << std::endl << regressions << " regression(s) above " << p_thresholdPercent << "%" << std::endl;
+
+	return regressions;
+}
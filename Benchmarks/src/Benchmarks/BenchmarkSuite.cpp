@@ -0,0 +1,97 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+#include "Benchmarks/BenchmarkSuite.h"
+
+namespace
+{
+	/* Written by Consume, volatile so the compiler must keep every value that reaches it */
+	volatile float g_consumedValue = 0.0f;
+
+	/* Incremented by Check */
+	uint32_t g_failedCheckCount = 0;
+
+	/* Upper bound of the iteration calibration (Avoids looping forever on an empty body) */
+	constexpr uint64_t kMaximumIterations = 1ull << 30;
+}
+
+void AnimationProgramming::Benchmarks::BenchmarkSuite::Add(const std::string& p_name, Body p_body, uint64_t p_itemsPerIteration, uint32_t p_threadCount)
+{
+	m_benchmarks.push_back({ p_name, std::move(p_body), p_itemsPerIteration, std::max(p_threadCount, 1u) });
+}
+
+std::vector<AnimationProgramming::Benchmarks::BenchmarkResult> AnimationProgramming::Benchmarks::BenchmarkSuite::Run(const std::string& p_filter, double p_minimumMilliseconds, uint32_t p_repetitions) const
+{
+	std::vector<BenchmarkResult> results;
+
+	auto measureMilliseconds = [](const Body& p_body, uint64_t p_iterations)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		p_body(p_iterations);
+		const auto end = std::chrono::steady_clock::now();
+		return std::chrono::duration<double, std::milli>(end - start).count();
+	};
+
+	for (const auto&[name, body, itemsPerIteration, threadCount] : m_benchmarks)
+	{
+		if (!p_filter.empty() && name.find(p_filter) == std::string::npos)
+			continue;
+
+		/* The first call creates the fixtures of the benchmark (See LazyFixture) : it must not be part of the calibration */
+		body(1);
+
+		/* Calibration : double the iteration count until one repetition lasts long enough */
+		uint64_t iterations = 1;
+		while (iterations < kMaximumIterations && measureMilliseconds(body, iterations) < p_minimumMilliseconds)
+			iterations *= 2;
+
+		BenchmarkResult result;
+		result.name = name;
+		result.iterations = iterations;
+		result.nanosecondsPerIteration = std::numeric_limits<double>::max();
+
+		for (uint32_t repetition = 0; repetition < std::max(p_repetitions, 1u); ++repetition)
+			result.nanosecondsPerIteration = std::min(result.nanosecondsPerIteration, measureMilliseconds(body, iterations) * 1000000.0 / static_cast<double>(iterations));
+
+		std::cout << std::left << std::setw(56) << name << std::right << std::fixed << std::setprecision(2) << std::setw(14) << result.nanosecondsPerIteration << " ns";
+
+		if (itemsPerIteration != 0)
+		{
+			result.itemsPerSecondPerThread = static_cast<double>(itemsPerIteration) * 1000000000.0 / result.nanosecondsPerIteration / static_cast<double>(threadCount);
+			std::cout << std::setw(14) << result.itemsPerSecondPerThread / 1000000.0 << " M items/s per thread";
+		}
+
+		std::cout << std::endl;
+
+		results.push_back(result);
+	}
+
+	return results;
+}
+
+void AnimationProgramming::Benchmarks::BenchmarkSuite::Consume(float p_value)
+{
+	g_consumedValue = g_consumedValue + p_value;
+}
+
+void AnimationProgramming::Benchmarks::BenchmarkSuite::Check(const std::string& p_description, bool p_passed)
+{
+	std::cout << p_description << ": " << (p_passed ? "OK" : "FAILED") << std::endl;
+
+	if (!p_passed)
+		++g_failedCheckCount;
+}
+
+uint32_t AnimationProgramming::Benchmarks::BenchmarkSuite::GetFailedCheckCount()
+{
+	return g_failedCheckCount;
+}
@@ -0,0 +1,351 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "AnimationProgramming/Animation/PoseStreamReader.h"
+#include "AnimationProgramming/Animation/PoseStreamWriter.h"
+#include "AnimationProgramming/Tools/Snapshot.h"
+
+#include "Benchmarks/BenchmarkFixtures.h"
+#include "Benchmarks/CaptureBenchmarks.h"
+
+namespace
+{
+	using namespace AnimationProgramming;
+	using namespace AnimationProgramming::Benchmarks;
+
+	constexpr uint32_t kPoseStreamFrameCount = 60;
+	constexpr const char* kPoseStreamLocalPosePath = "pose_stream_local_pose_benchmark.capture";
+	constexpr const char* kPoseStreamPalettePath = "pose_stream_palette_benchmark.capture";
+
+	/**
+	* The local poses and the skinning palettes of a walking crowd over one second (Each character at its own time in the walk)
+	*/
+	struct PoseStreamFixture final
+	{
+		PoseStreamFixture() :
+			animationInfo("ThirdPersonWalk.anim"),
+			animationInstance(animationInfo)
+		{
+			animationInstance.loop = true;
+
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+			{
+				characters.push_back(std::make_unique<CrowdCharacter>());
+				characters.back()->animator.PlayAnimation(animationInstance);
+				characters.back()->animator.UpdatePose(static_cast<float>(i) * 0.05f);
+			}
+
+			for (uint32_t frame = 0; frame < kPoseStreamFrameCount; ++frame)
+			{
+				for (auto& character : characters)
+				{
+					character->animator.UpdatePose(kFrameTime);
+					localPoses.push_back(character->animator.GetLocalPose());
+					palettes.push_back(character->animator.GetSkinningPalette());
+				}
+			}
+
+			/* The read benchmarks decode these files */
+			Capture(kPoseStreamLocalPosePath, Animation::EPoseStreamContent::LOCAL_POSE);
+			Capture(kPoseStreamPalettePath, Animation::EPoseStreamContent::SKINNING_PALETTE);
+
+			for (const char* path : { kPoseStreamLocalPosePath, kPoseStreamPalettePath })
+			{
+				Animation::PoseStreamReader reader(path);
+				const bool localPose = reader.GetContent() == Animation::EPoseStreamContent::LOCAL_POSE;
+				const size_t valuesPerBone = localPose ? 7 : 12;
+
+				std::cout << "Pose stream (" << (localPose ? "Local pose" : "Skinning palette") << "): "
+					<< reader.GetBytesPerCharacterFrame() << " bytes per character and frame (" << reader.GetBoneCount() * valuesPerBone * sizeof(float) << " uncompressed)" << std::endl;
+
+				/* Every decoded value is the captured one rounded to the nearest step : half a step away at most (Plus the float rounding) */
+				const float error = CalculateRoundTripError(reader);
+				std::ostringstream description;
+				description << "Pose stream round trip (" << (localPose ? "Local pose" : "Skinning palette") << "): largest error of " << std::setprecision(3) << error << " quantization step";
+
+				BenchmarkSuite::Check(description.str(), error <= 0.51f);
+			}
+		}
+
+		/**
+		* Decode the whole capture of the given reader and return the largest difference with the captured values, in quantization steps
+		* (Infinite if a frame is missing)
+		*/
+		float CalculateRoundTripError(Animation::PoseStreamReader& p_reader)
+		{
+			const bool localPose = p_reader.GetContent() == Animation::EPoseStreamContent::LOCAL_POSE;
+			const std::vector<float> steps = Animation::PoseStreamWriter::CalculateQuantizationSteps(p_reader.GetContent(),
+				Animation::PoseStreamWriter::DefaultPositionPrecision, Animation::PoseStreamWriter::DefaultRotationPrecision);
+
+			if (p_reader.GetFrameCount() != kPoseStreamFrameCount || p_reader.GetCharacterCount() != kCrowdSize)
+				return std::numeric_limits<float>::infinity();
+
+			float largestError = 0.0f;
+
+			auto compare = [&largestError, &steps](const float* p_captured, const float* p_decoded)
+			{
+				for (size_t i = 0; i < steps.size(); ++i)
+					largestError = std::max(largestError, std::abs(p_decoded[i] - p_captured[i]) / steps[i]);
+			};
+
+			p_reader.Rewind();
+
+			for (uint32_t frame = 0; p_reader.ReadFrame(); ++frame)
+			{
+				for (uint32_t i = 0; i < kCrowdSize; ++i)
+				{
+					const size_t capture = static_cast<size_t>(frame) * kCrowdSize + i;
+
+					if (localPose)
+					{
+						p_reader.GetLocalPose(i, decodedPose);
+
+						for (size_t bone = 0; bone < decodedPose.size(); ++bone)
+						{
+							const Data::Transformation& captured = localPoses[capture][bone];
+							const Data::Transformation& decoded = decodedPose[bone];
+
+							const float capturedValues[7] = { captured.first.x, captured.first.y, captured.first.z, captured.second.GetXAxisValue(),
+								captured.second.GetYAxisValue(), captured.second.GetZAxisValue(), captured.second.GetRealValue() };
+							const float decodedValues[7] = { decoded.first.x, decoded.first.y, decoded.first.z, decoded.second.GetXAxisValue(),
+								decoded.second.GetYAxisValue(), decoded.second.GetZAxisValue(), decoded.second.GetRealValue() };
+
+							compare(capturedValues, decodedValues);
+						}
+					}
+					else
+					{
+						p_reader.GetSkinningPalette(i, decodedPalette);
+
+						for (size_t bone = 0; bone < decodedPalette.size(); ++bone)
+							compare(palettes[capture][bone].elements, decodedPalette[bone].elements);
+					}
+				}
+			}
+
+			return largestError;
+		}
+
+		/**
+		* Capture the whole session to the given file (Nothing is dropped : the queue holds every frame)
+		*/
+		void Capture(const std::string& p_path, Animation::EPoseStreamContent p_content) const
+		{
+			const bool localPose = p_content == Animation::EPoseStreamContent::LOCAL_POSE;
+			const uint32_t boneCount = static_cast<uint32_t>(localPose ? localPoses.front().size() : palettes.front().size());
+
+			Animation::PoseStreamWriter writer(p_path, p_content, kCrowdSize, boneCount, Animation::PoseStreamWriter::DefaultPositionPrecision,
+				Animation::PoseStreamWriter::DefaultRotationPrecision, Animation::PoseStreamWriter::DefaultFramesPerBlock, kPoseStreamFrameCount);
+
+			for (uint32_t frame = 0; frame < kPoseStreamFrameCount; ++frame)
+			{
+				for (uint32_t i = 0; i < kCrowdSize; ++i)
+				{
+					if (localPose)
+						writer.CaptureLocalPose(i, localPoses[frame * kCrowdSize + i]);
+					else
+						writer.CaptureSkinningPalette(i, palettes[frame * kCrowdSize + i]);
+				}
+
+				writer.SubmitFrame();
+			}
+		}
+
+		Animation::AnimationInfo animationInfo;
+		Animation::AnimationInstance animationInstance;
+		std::vector<std::unique_ptr<CrowdCharacter>> characters;
+		std::vector<std::vector<Data::Transformation>> localPoses;
+		std::vector<std::vector<Data::Matrix3x4>> palettes;
+		std::vector<Data::Transformation> decodedPose;
+		std::vector<Data::Matrix3x4> decodedPalette;
+	};
+
+	/* Frames played from a snapshot by the rollback check */
+	constexpr uint32_t kSnapshotReplayedFrameCount = 30;
+
+	/**
+	* Return true if the given buffers hold the same bytes
+	*/
+	template<typename T>
+	bool IsBitwiseEqual(const std::vector<T>& p_left, const std::vector<T>& p_right)
+	{
+		return p_left.size() == p_right.size() && std::memcmp(p_left.data(), p_right.data(), p_left.size() * sizeof(T)) == 0;
+	}
+
+	/**
+	* A walking crowd and one snapshot per character (A frame of a rollback buffer)
+	*/
+	struct SnapshotFixture final
+	{
+		SnapshotFixture() :
+			animationInfo("ThirdPersonWalk.anim"),
+			animationInstance(animationInfo),
+			snapshots(kCrowdSize)
+		{
+			animationInstance.loop = true;
+
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+			{
+				characters.push_back(std::make_unique<CrowdCharacter>());
+				characters.back()->animator.PlayAnimation(animationInstance);
+				characters.back()->animator.UpdatePose(static_cast<float>(i) * 0.05f);
+			}
+
+			Save();
+
+			std::cout << "Animator snapshot: " << snapshots.front().GetSize() << " bytes per character" << std::endl;
+			BenchmarkSuite::Check("Animator snapshot round trip: restored and replayed poses identical bit for bit", IsRollbackExact());
+		}
+
+		/**
+		* Play a few frames from the snapshots, restore them and play the same frames again : return true if the restored poses are the saved ones
+		* and the replayed poses the played ones, bit for bit (The characters are left on their snapshot)
+		*/
+		bool IsRollbackExact()
+		{
+			bool exact = true;
+
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+			{
+				Animation::Animator& animator = characters[i]->animator;
+				const std::vector<Data::Transformation> savedPose = animator.GetLocalPose();
+				const std::vector<Data::Matrix3x4> savedPalette = animator.GetSkinningPalette();
+
+				for (uint32_t frame = 0; frame < kSnapshotReplayedFrameCount; ++frame)
+					animator.UpdatePose(kFrameTime);
+
+				const std::vector<Data::Transformation> playedPose = animator.GetLocalPose();
+				const std::vector<Data::Matrix3x4> playedPalette = animator.GetSkinningPalette();
+
+				snapshots[i].Rewind();
+				animator.RestoreSnapshot(snapshots[i]);
+				exact = exact && snapshots[i].IsFullyRead() && IsBitwiseEqual(savedPose, animator.GetLocalPose()) && IsBitwiseEqual(savedPalette, animator.GetSkinningPalette());
+
+				for (uint32_t frame = 0; frame < kSnapshotReplayedFrameCount; ++frame)
+					animator.UpdatePose(kFrameTime);
+
+				exact = exact && IsBitwiseEqual(playedPose, animator.GetLocalPose()) && IsBitwiseEqual(playedPalette, animator.GetSkinningPalette());
+
+				snapshots[i].Rewind();
+				animator.RestoreSnapshot(snapshots[i]);
+			}
+
+			return exact;
+		}
+
+		void Save()
+		{
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+			{
+				snapshots[i].Clear();
+				characters[i]->animator.SaveSnapshot(snapshots[i]);
+			}
+		}
+
+		void Restore()
+		{
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+			{
+				snapshots[i].Rewind();
+				characters[i]->animator.RestoreSnapshot(snapshots[i]);
+			}
+		}
+
+		Animation::AnimationInfo animationInfo;
+		Animation::AnimationInstance animationInstance;
+		std::vector<std::unique_ptr<CrowdCharacter>> characters;
+		std::vector<Tools::Snapshot> snapshots;
+	};
+}
+
+void AnimationProgramming::Benchmarks::CaptureBenchmarks::Register(BenchmarkSuite& p_suite)
+{
+	/* One iteration captures (Or decodes) the whole session of the crowd, until the file is written. The size of the streams is reported on creation */
+	auto poseStream = LazyFixture<PoseStreamFixture>::Create();
+
+	p_suite.Add("PoseStream/Capture.LocalPose", [poseStream](uint64_t p_iterations)
+	{
+		PoseStreamFixture& fixture = poseStream->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.Capture(kPoseStreamLocalPosePath, Animation::EPoseStreamContent::LOCAL_POSE);
+	}, kPoseStreamFrameCount * kCrowdSize);
+
+	p_suite.Add("PoseStream/Capture.SkinningPalette", [poseStream](uint64_t p_iterations)
+	{
+		PoseStreamFixture& fixture = poseStream->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.Capture(kPoseStreamPalettePath, Animation::EPoseStreamContent::SKINNING_PALETTE);
+	}, kPoseStreamFrameCount * kCrowdSize);
+
+	p_suite.Add("PoseStream/Read.LocalPose", [poseStream](uint64_t p_iterations)
+	{
+		PoseStreamFixture& fixture = poseStream->Get();
+		Animation::PoseStreamReader reader(kPoseStreamLocalPosePath);
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+		{
+			reader.Rewind();
+
+			while (reader.ReadFrame())
+				for (uint32_t character = 0; character < reader.GetCharacterCount(); ++character)
+					reader.GetLocalPose(character, fixture.decodedPose);
+		}
+
+		BenchmarkSuite::Consume(fixture.decodedPose.back().first.x);
+	}, kPoseStreamFrameCount * kCrowdSize);
+
+	p_suite.Add("PoseStream/Read.SkinningPalette", [poseStream](uint64_t p_iterations)
+	{
+		PoseStreamFixture& fixture = poseStream->Get();
+		Animation::PoseStreamReader reader(kPoseStreamPalettePath);
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+		{
+			reader.Rewind();
+
+			while (reader.ReadFrame())
+				for (uint32_t character = 0; character < reader.GetCharacterCount(); ++character)
+					reader.GetSkinningPalette(character, fixture.decodedPalette);
+		}
+
+		BenchmarkSuite::Consume(fixture.decodedPalette.back().elements[3]);
+	}, kPoseStreamFrameCount * kCrowdSize);
+
+	/* One iteration saves (Or restores) the state of every character of the crowd. The size of a snapshot is reported on creation */
+	auto snapshotCrowd = LazyFixture<SnapshotFixture>::Create();
+
+	p_suite.Add("Crowd/SaveSnapshot", [snapshotCrowd](uint64_t p_iterations)
+	{
+		SnapshotFixture& fixture = snapshotCrowd->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.Save();
+
+		BenchmarkSuite::Consume(static_cast<float>(fixture.snapshots.back().GetSize()));
+	}, kCrowdSize);
+
+	p_suite.Add("Crowd/RestoreSnapshot", [snapshotCrowd](uint64_t p_iterations)
+	{
+		SnapshotFixture& fixture = snapshotCrowd->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.Restore();
+
+		BenchmarkSuite::Consume(fixture.characters.back()->animator.GetLocalPose()[24].first.x);
+	}, kCrowdSize);
+}
@@ -0,0 +1,629 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <cmath>
+#include <memory>
+
+#include "AnimationProgramming/Animation/AimConstraints.h"
+#include "AnimationProgramming/Animation/ChainIK.h"
+#include "AnimationProgramming/Animation/FootContactTrack.h"
+#include "AnimationProgramming/Animation/FootPlanting.h"
+#include "AnimationProgramming/Animation/HeightfieldGroundProvider.h"
+#include "AnimationProgramming/Animation/LimbIK.h"
+#include "AnimationProgramming/Animation/SpringBones.h"
+#include "AnimationProgramming/Animation/TwoBoneIKSolver.h"
+#include "AnimationProgramming/Data/AlignedTypes.h"
+#include "AnimationProgramming/Rig/Skeleton.h"
+#include "AnimationProgramming/Tools/SIMD.h"
+#include "AnimationProgramming/Tools/ThreadPool.h"
+
+#include "Benchmarks/BenchmarkFixtures.h"
+#include "Benchmarks/IKBenchmarks.h"
+
+namespace
+{
+	using namespace AnimationProgramming;
+	using namespace AnimationProgramming::Benchmarks;
+
+	/* Requests solved by one iteration of the solver benchmarks */
+	constexpr uint32_t kIKRequestCount = 4096;
+
+	/**
+	* Pseudo-random two-bone chains and targets (Some of them out of reach)
+	*/
+	struct TwoBoneIKFixture final
+	{
+		TwoBoneIKFixture()
+		{
+			/* Deterministic pseudo-random values in [-1, 1] */
+			uint32_t seed = 0;
+			auto random = [&seed]() { return std::sin(static_cast<float>(++seed) * 12.9898f); };
+
+			for (uint32_t i = 0; i < kIKRequestCount; ++i)
+			{
+				Animation::TwoBoneIKSolver::Request request;
+				request.root = AltMath::Vector3f(random(), random(), random());
+				request.joint = request.root + AltMath::Vector3f(random(), random(), random()) * 10.0f;
+				request.end = request.joint + AltMath::Vector3f(random(), random(), random()) * 10.0f;
+				request.target = request.root + AltMath::Vector3f(random(), random(), random()) * 8.0f;
+				request.bendAxis = AltMath::Vector3f(0.0f, 0.0f, 1.0f);
+				request.weight = 1.0f;
+				requests.push_back(request);
+			}
+		}
+
+		std::vector<Animation::TwoBoneIKSolver::Request> requests;
+		std::vector<Animation::TwoBoneIKSolver::Result> results;
+		Tools::ThreadPool threadPool;
+	};
+
+	/**
+	* A crowd of characters sampling the walk of the stub engine, with their four limbs reaching a target under their sampled end bone
+	*/
+	struct LimbIKCrowdFixture final
+	{
+		LimbIKCrowdFixture() :
+			animationInfo("ThirdPersonWalk.anim"),
+			walk(animationInfo)
+		{
+			skeleton.CreateSkeletonFromBindPose();
+			walk.loop = true;
+
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+			{
+				limbIKs.push_back(std::make_unique<Animation::LimbIK>(*skeleton.GetDefinition()));
+
+				/* The last three bones of four limbs of the stub skeleton */
+				for (uint32_t end : { kStubLeftFoot, kStubRightFoot, kStubLeftFoot + 16, kStubRightFoot + 16 })
+				{
+					limbIKs.back()->AddLimb(end - 2, end - 1, end);
+					limbIKs.back()->SetTarget(limbIKs.back()->GetLimbCount() - 1, AltMath::Vector3f(static_cast<float>(i % 8), -20.0f, static_cast<float>(end)));
+				}
+			}
+
+			poses.resize(kCrowdSize);
+		}
+
+		/**
+		* Sample the pose of every character, then solve their limbs : in one batch for the whole crowd, or character per character
+		*/
+		void UpdateFrame(bool p_batched, Tools::ThreadPool* p_threadPool)
+		{
+			time += kFrameTime;
+
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+				walk.SamplePose(time + static_cast<float>(i) * 0.05f, poses[i]);
+
+			if (!p_batched)
+			{
+				for (uint32_t i = 0; i < kCrowdSize; ++i)
+					limbIKs[i]->Solve(poses[i]);
+
+				return;
+			}
+
+			requests.clear();
+			firstRequests.clear();
+
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+			{
+				firstRequests.push_back(static_cast<uint32_t>(requests.size()));
+				limbIKs[i]->GatherRequests(poses[i], requests);
+			}
+
+			Animation::TwoBoneIKSolver::Solve(requests, results, p_threadPool);
+
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+				limbIKs[i]->ApplyResults(results.data() + firstRequests[i], poses[i]);
+		}
+
+		Rig::Skeleton skeleton;
+		Animation::AnimationInfo animationInfo;
+		Animation::AnimationInstance walk;
+		std::vector<std::unique_ptr<Animation::LimbIK>> limbIKs;
+		std::vector<std::vector<Data::Transformation>> poses;
+		std::vector<Animation::TwoBoneIKSolver::Request> requests;
+		std::vector<Animation::TwoBoneIKSolver::Result> results;
+		std::vector<uint32_t> firstRequests;
+		Tools::ThreadPool threadPool;
+		float time = 0.0f;
+	};
+
+	/* Chains of each character of the chain IK benchmarks (The four limbs of the stub skeleton) */
+	constexpr uint32_t kChainsPerCharacter = 4;
+
+	/**
+	* A crowd of characters with the four limbs of their sampled walk (Eight bones each) reaching targets moving from frame to frame
+	*/
+	struct ChainIKCrowdFixture final
+	{
+		ChainIKCrowdFixture(Animation::ChainIK::EMethod p_method, bool p_warmStart) :
+			animationInfo("ThirdPersonWalk.anim"),
+			walk(animationInfo)
+		{
+			skeleton.CreateSkeletonFromBindPose();
+			walk.SamplePose(0.0f, sampledPose);
+
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+			{
+				chainIKs.push_back(std::make_unique<Animation::ChainIK>(*skeleton.GetDefinition()));
+
+				for (uint32_t chain = 0; chain < kChainsPerCharacter; ++chain)
+				{
+					chainIKs.back()->AddChain(8 + chain * 8, 15 + chain * 8, p_method, 10, 0.1f);
+					chainIKs.back()->SetWarmStart(chain, p_warmStart);
+				}
+			}
+
+			/* Targets within reach : the sampled end of each limb, moved toward its root */
+			Animation::ChainIK& reference = *chainIKs.front();
+			std::vector<AltMath::Vector3f> positions(sampledPose.size());
+			std::vector<AltMath::Quaternion> rotations(sampledPose.size());
+
+			for (uint32_t bone = 0; bone < skeleton.GetBones().size(); ++bone)
+			{
+				Rig::Bone& skeletonBone = skeleton.GetBones()[bone];
+				const AltMath::Vector3f position = skeletonBone.GetDefaultTransform().GetLocalPosition() + sampledPose[bone].first;
+				const AltMath::Quaternion rotation = skeletonBone.GetDefaultTransform().GetLocalRotation() * sampledPose[bone].second;
+				const uint32_t parent = skeletonBone.HasParent() ? skeletonBone.GetParent().GetIndex() : bone;
+
+				positions[bone] = skeletonBone.HasParent() ? positions[parent] + rotations[parent] * position : position;
+				rotations[bone] = skeletonBone.HasParent() ? rotations[parent] * rotation : rotation;
+			}
+
+			for (uint32_t chain = 0; chain < kChainsPerCharacter; ++chain)
+			{
+				const AltMath::Vector3f root = positions[reference.GetChainBone(chain, 0)];
+				const AltMath::Vector3f end = positions[reference.GetChainBone(chain, reference.GetChain(chain).jointCount - 1)];
+				targets.push_back(root + (end - root) * 0.6f);
+			}
+
+			pose = sampledPose;
+		}
+
+		/**
+		* Solve the chains of every character, for targets moving around their base position
+		*/
+		void UpdateFrame()
+		{
+			time += kFrameTime;
+
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+			{
+				const float phase = time + static_cast<float>(i) * 0.05f;
+				const AltMath::Vector3f offset(4.0f * std::sin(phase), 4.0f * std::cos(phase), 0.0f);
+
+				for (uint32_t chain = 0; chain < kChainsPerCharacter; ++chain)
+					chainIKs[i]->SetTarget(chain, targets[chain] + offset);
+
+				std::copy(sampledPose.begin(), sampledPose.end(), pose.begin());
+				chainIKs[i]->Solve(pose);
+			}
+		}
+
+		Rig::Skeleton skeleton;
+		Animation::AnimationInfo animationInfo;
+		Animation::AnimationInstance walk;
+		std::vector<std::unique_ptr<Animation::ChainIK>> chainIKs;
+		std::vector<Data::Transformation> sampledPose;
+		std::vector<Data::Transformation> pose;
+		std::vector<AltMath::Vector3f> targets;
+		float time = 0.0f;
+	};
+
+	/**
+	* A crowd of characters spread over an uneven ground, each one at its own time of the walk, with their feet planted on the ground
+	*/
+	struct FootPlantingCrowdFixture final
+	{
+		FootPlantingCrowdFixture() :
+			animationInfo("ThirdPersonWalk.anim"),
+			walk(animationInfo),
+			ground(129, 129, 25.0f, AltMath::Vector2f(-1600.0f, -1600.0f))
+		{
+			skeleton.CreateSkeletonFromBindPose();
+			walk.loop = true;
+
+			for (uint32_t y = 0; y < 129; ++y)
+				for (uint32_t x = 0; x < 129; ++x)
+					ground.SetHeight(x, y, 8.0f * std::sin(static_cast<float>(x) * 0.6f) * std::cos(static_cast<float>(y) * 0.4f));
+
+			const uint32_t pelvis = skeleton.GetBones()[8].GetParent().GetIndex();
+			contacts = std::make_unique<Animation::FootContactTrack>(skeleton, animationInfo, kStubLeftFoot, kStubRightFoot);
+
+			sampledPoses.resize(kCrowdSize);
+
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+			{
+				const float time = static_cast<float>(i) * 0.05f;
+				uint32_t currentKey;
+				uint32_t nextKey;
+				float alpha;
+
+				walk.SamplePose(time, sampledPoses[i]);
+				walk.SampleKeyFrames(time, currentKey, nextKey, alpha);
+
+				footPlantings.push_back(std::make_unique<Animation::FootPlanting>(*skeleton.GetDefinition(), pelvis, kStubLeftFoot, kStubRightFoot));
+				footPlantings.back()->AddContactTrack(*contacts);
+				footPlantings.back()->SetContacts(&animationInfo, currentKey, nextKey, alpha);
+				footPlantings.back()->SetRootPosition(AltMath::Vector3f(static_cast<float>(i % 8) * 150.0f - 600.0f, static_cast<float>(i / 8) * 150.0f - 600.0f, 0.0f));
+				characters.push_back(footPlantings.back().get());
+			}
+
+			poses = sampledPoses;
+
+			for (std::vector<Data::Transformation>& pose : poses)
+				posePointers.push_back(&pose);
+		}
+
+		/**
+		* Plant the feet of every character : in one batch for the whole crowd, or character per character
+		*/
+		void UpdateFrame(bool p_batched, Tools::ThreadPool* p_threadPool)
+		{
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+				std::copy(sampledPoses[i].begin(), sampledPoses[i].end(), poses[i].begin());
+
+			if (p_batched)
+			{
+				Animation::FootPlanting::SolveCrowd(characters, posePointers, ground, scratch, p_threadPool);
+				return;
+			}
+
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+				footPlantings[i]->Solve(poses[i], ground);
+		}
+
+		Rig::Skeleton skeleton;
+		Animation::AnimationInfo animationInfo;
+		Animation::AnimationInstance walk;
+		Animation::HeightfieldGroundProvider ground;
+		std::unique_ptr<Animation::FootContactTrack> contacts;
+		std::vector<std::unique_ptr<Animation::FootPlanting>> footPlantings;
+		std::vector<Animation::FootPlanting*> characters;
+		std::vector<std::vector<Data::Transformation>> sampledPoses;
+		std::vector<std::vector<Data::Transformation>> poses;
+		std::vector<std::vector<Data::Transformation>*> posePointers;
+		Animation::FootPlanting::CrowdScratch scratch;
+		Tools::ThreadPool threadPool;
+	};
+
+	/**
+	* A crowd of characters, each one at its own time of the walk, with a look-at (Three bones of a limb) and an aim (Three bones of another limb, with an offset)
+	* following targets moving from frame to frame
+	*/
+	struct AimConstraintsCrowdFixture final
+	{
+		AimConstraintsCrowdFixture() :
+			animationInfo("ThirdPersonWalk.anim"),
+			walk(animationInfo)
+		{
+			skeleton.CreateSkeletonFromBindPose();
+			walk.loop = true;
+
+			constraints = std::make_unique<Animation::AimConstraints>(*skeleton.GetDefinition());
+			constraints->AddLookAt({ 9, 11, 13 }, AltMath::Vector3f(1.0f, 0.0f, 0.0f), 1.2f, { 0.2f, 0.3f });
+			constraints->AddAim({ 17, 19, 20 }, AltMath::Vector3f(5.0f, 0.0f, 0.0f), AltMath::Vector3f(0.0f, 1.0f, 0.0f), 0.8f);
+
+			sampledPoses.resize(kCrowdSize);
+
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+				walk.SamplePose(static_cast<float>(i) * 0.05f, sampledPoses[i]);
+
+			poses = sampledPoses;
+
+			for (std::vector<Data::Transformation>& pose : poses)
+				posePointers.push_back(&pose);
+
+			targets.resize(kCrowdSize * constraints->GetConstraintCount());
+		}
+
+		/**
+		* Constrain the poses of every character, for targets moving around them
+		*/
+		void UpdateFrame(Tools::ThreadPool* p_threadPool)
+		{
+			time += kFrameTime;
+
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+			{
+				const float phase = time + static_cast<float>(i) * 0.05f;
+
+				targets[i * 2] = { AltMath::Vector3f(100.0f * std::cos(phase), 100.0f * std::sin(phase), 150.0f), 1.0f };
+				targets[i * 2 + 1] = { AltMath::Vector3f(200.0f, 50.0f * std::sin(phase), 100.0f), 0.5f + 0.5f * std::cos(phase) };
+
+				std::copy(sampledPoses[i].begin(), sampledPoses[i].end(), poses[i].begin());
+			}
+
+			constraints->Apply(posePointers, targets, p_threadPool);
+		}
+
+		Rig::Skeleton skeleton;
+		Animation::AnimationInfo animationInfo;
+		Animation::AnimationInstance walk;
+		std::unique_ptr<Animation::AimConstraints> constraints;
+		std::vector<std::vector<Data::Transformation>> sampledPoses;
+		std::vector<std::vector<Data::Transformation>> poses;
+		std::vector<std::vector<Data::Transformation>*> posePointers;
+		std::vector<Animation::AimConstraints::Target> targets;
+		Tools::ThreadPool threadPool;
+		float time = 0.0f;
+	};
+
+	/**
+	* A crowd of characters walking in circles, each one at its own time of the walk, with two limbs (Eight bones each) as spring bones
+	*/
+	struct SpringBonesCrowdFixture final
+	{
+		SpringBonesCrowdFixture() :
+			animationInfo("ThirdPersonWalk.anim"),
+			walk(animationInfo)
+		{
+			skeleton.CreateSkeletonFromBindPose();
+			walk.loop = true;
+
+			sampledPoses.resize(kCrowdSize);
+
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+			{
+				walk.SamplePose(static_cast<float>(i) * 0.05f, sampledPoses[i]);
+
+				springBones.push_back(std::make_unique<Animation::SpringBones>(*skeleton.GetDefinition()));
+				springBones.back()->AddChain(24, 31);
+				springBones.back()->AddChain(32, 39, 0.2f, 0.1f);
+				characters.push_back(springBones.back().get());
+			}
+
+			poses = sampledPoses;
+
+			for (std::vector<Data::Transformation>& pose : poses)
+				posePointers.push_back(&pose);
+		}
+
+		/**
+		* Enable the spring bones of the given share of the crowd only (The nearest characters)
+		*/
+		void SetEnabledShare(float p_share)
+		{
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+				springBones[i]->SetEnabled(static_cast<float>(i) < p_share * static_cast<float>(kCrowdSize));
+		}
+
+		/**
+		* Move every character along its circle, then step its spring bones
+		*/
+		void UpdateFrame(Tools::ThreadPool* p_threadPool)
+		{
+			time += kFrameTime;
+
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+			{
+				const float phase = time + static_cast<float>(i) * 0.05f;
+				springBones[i]->SetRootPosition(AltMath::Vector3f(100.0f * std::cos(phase), 100.0f * std::sin(phase), 0.0f));
+
+				std::copy(sampledPoses[i].begin(), sampledPoses[i].end(), poses[i].begin());
+			}
+
+			Animation::SpringBones::SolveCrowd(characters, posePointers, kFrameTime, p_threadPool);
+		}
+
+		Rig::Skeleton skeleton;
+		Animation::AnimationInfo animationInfo;
+		Animation::AnimationInstance walk;
+		std::vector<std::unique_ptr<Animation::SpringBones>> springBones;
+		std::vector<Animation::SpringBones*> characters;
+		std::vector<std::vector<Data::Transformation>> sampledPoses;
+		std::vector<std::vector<Data::Transformation>> poses;
+		std::vector<std::vector<Data::Transformation>*> posePointers;
+		Tools::ThreadPool threadPool;
+		float time = 0.0f;
+	};
+}
+
+void AnimationProgramming::Benchmarks::IKBenchmarks::Register(BenchmarkSuite& p_suite)
+{
+	/* One iteration is one solve of the whole set of requests */
+	auto twoBoneIK = LazyFixture<TwoBoneIKFixture>::Create();
+
+	p_suite.Add("TwoBoneIKSolver/Solve.Scalar", [twoBoneIK](uint64_t p_iterations)
+	{
+		TwoBoneIKFixture& fixture = twoBoneIK->Get();
+
+		Tools::SIMD::SetLevel(Tools::ESIMDLevel::SCALAR);
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			Animation::TwoBoneIKSolver::Solve(fixture.requests, fixture.results);
+
+		Tools::SIMD::SetLevel(Tools::SIMD::GetSupportedLevel());
+		BenchmarkSuite::Consume(Data::AlignedQuaternion(fixture.results.back().jointRotation).w);
+	}, kIKRequestCount);
+
+	p_suite.Add("TwoBoneIKSolver/Solve", [twoBoneIK](uint64_t p_iterations)
+	{
+		TwoBoneIKFixture& fixture = twoBoneIK->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			Animation::TwoBoneIKSolver::Solve(fixture.requests, fixture.results);
+
+		BenchmarkSuite::Consume(Data::AlignedQuaternion(fixture.results.back().jointRotation).w);
+	}, kIKRequestCount);
+
+	p_suite.Add("TwoBoneIKSolver/Solve.ThreadPool", [twoBoneIK](uint64_t p_iterations)
+	{
+		TwoBoneIKFixture& fixture = twoBoneIK->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			Animation::TwoBoneIKSolver::Solve(fixture.requests, fixture.results, &fixture.threadPool);
+
+		BenchmarkSuite::Consume(Data::AlignedQuaternion(fixture.results.back().jointRotation).w);
+	}, kIKRequestCount, GetThreadPoolSize());
+
+	/* One iteration is one frame of the whole crowd (Sampling included) */
+	auto limbIKCrowd = LazyFixture<LimbIKCrowdFixture>::Create();
+
+	p_suite.Add("Crowd/LimbIK.PerCharacter", [limbIKCrowd](uint64_t p_iterations)
+	{
+		LimbIKCrowdFixture& fixture = limbIKCrowd->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.UpdateFrame(false, nullptr);
+
+		BenchmarkSuite::Consume(Data::AlignedQuaternion(fixture.poses.back()[kStubLeftFoot - 1].second).w);
+	}, kCrowdSize);
+
+	p_suite.Add("Crowd/LimbIK", [limbIKCrowd](uint64_t p_iterations)
+	{
+		LimbIKCrowdFixture& fixture = limbIKCrowd->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.UpdateFrame(true, nullptr);
+
+		BenchmarkSuite::Consume(Data::AlignedQuaternion(fixture.poses.back()[kStubLeftFoot - 1].second).w);
+	}, kCrowdSize);
+
+	p_suite.Add("Crowd/LimbIK.ThreadPool", [limbIKCrowd](uint64_t p_iterations)
+	{
+		LimbIKCrowdFixture& fixture = limbIKCrowd->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.UpdateFrame(true, &fixture.threadPool);
+
+		BenchmarkSuite::Consume(Data::AlignedQuaternion(fixture.poses.back()[kStubLeftFoot - 1].second).w);
+	}, kCrowdSize, GetThreadPoolSize());
+
+	/* One iteration is one frame of the whole crowd (Sampling excluded) */
+	const std::pair<const char*, std::shared_ptr<LazyFixture<ChainIKCrowdFixture>>> chainIKCrowds[] =
+	{
+		{ "Crowd/ChainIK.FABRIK", LazyFixture<ChainIKCrowdFixture>::Create(Animation::ChainIK::EMethod::FABRIK, false) },
+		{ "Crowd/ChainIK.FABRIK.WarmStart", LazyFixture<ChainIKCrowdFixture>::Create(Animation::ChainIK::EMethod::FABRIK, true) },
+		{ "Crowd/ChainIK.CCD", LazyFixture<ChainIKCrowdFixture>::Create(Animation::ChainIK::EMethod::CCD, false) },
+		{ "Crowd/ChainIK.CCD.WarmStart", LazyFixture<ChainIKCrowdFixture>::Create(Animation::ChainIK::EMethod::CCD, true) }
+	};
+
+	for (const auto&[name, lazyFixture] : chainIKCrowds)
+	{
+		auto chainIKCrowd = lazyFixture;
+
+		p_suite.Add(name, [chainIKCrowd](uint64_t p_iterations)
+		{
+			ChainIKCrowdFixture& fixture = chainIKCrowd->Get();
+
+			for (uint64_t i = 0; i < p_iterations; ++i)
+				fixture.UpdateFrame();
+
+			BenchmarkSuite::Consume(Data::AlignedQuaternion(fixture.pose[kStubLeftFoot - 1].second).w);
+		}, kCrowdSize * kChainsPerCharacter);
+	}
+
+	/* One iteration is one frame of the whole crowd (Sampling excluded) */
+	auto footPlantingCrowd = LazyFixture<FootPlantingCrowdFixture>::Create();
+
+	p_suite.Add("Crowd/FootPlanting.PerCharacter", [footPlantingCrowd](uint64_t p_iterations)
+	{
+		FootPlantingCrowdFixture& fixture = footPlantingCrowd->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.UpdateFrame(false, nullptr);
+
+		BenchmarkSuite::Consume(Data::AlignedQuaternion(fixture.poses.back()[kStubLeftFoot - 1].second).w);
+	}, kCrowdSize);
+
+	p_suite.Add("Crowd/FootPlanting", [footPlantingCrowd](uint64_t p_iterations)
+	{
+		FootPlantingCrowdFixture& fixture = footPlantingCrowd->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.UpdateFrame(true, nullptr);
+
+		BenchmarkSuite::Consume(Data::AlignedQuaternion(fixture.poses.back()[kStubLeftFoot - 1].second).w);
+	}, kCrowdSize);
+
+	p_suite.Add("Crowd/FootPlanting.ThreadPool", [footPlantingCrowd](uint64_t p_iterations)
+	{
+		FootPlantingCrowdFixture& fixture = footPlantingCrowd->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.UpdateFrame(true, &fixture.threadPool);
+
+		BenchmarkSuite::Consume(Data::AlignedQuaternion(fixture.poses.back()[kStubLeftFoot - 1].second).w);
+	}, kCrowdSize, GetThreadPoolSize());
+
+	/* One iteration is one frame of the whole crowd (Sampling excluded) */
+	auto aimConstraintsCrowd = LazyFixture<AimConstraintsCrowdFixture>::Create();
+
+	p_suite.Add("Crowd/AimConstraints.Scalar", [aimConstraintsCrowd](uint64_t p_iterations)
+	{
+		AimConstraintsCrowdFixture& fixture = aimConstraintsCrowd->Get();
+
+		Tools::SIMD::SetLevel(Tools::ESIMDLevel::SCALAR);
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.UpdateFrame(nullptr);
+
+		Tools::SIMD::SetLevel(Tools::SIMD::GetSupportedLevel());
+		BenchmarkSuite::Consume(Data::AlignedQuaternion(fixture.poses.back()[13].second).w);
+	}, kCrowdSize);
+
+	p_suite.Add("Crowd/AimConstraints", [aimConstraintsCrowd](uint64_t p_iterations)
+	{
+		AimConstraintsCrowdFixture& fixture = aimConstraintsCrowd->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.UpdateFrame(nullptr);
+
+		BenchmarkSuite::Consume(Data::AlignedQuaternion(fixture.poses.back()[13].second).w);
+	}, kCrowdSize);
+
+	p_suite.Add("Crowd/AimConstraints.ThreadPool", [aimConstraintsCrowd](uint64_t p_iterations)
+	{
+		AimConstraintsCrowdFixture& fixture = aimConstraintsCrowd->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.UpdateFrame(&fixture.threadPool);
+
+		BenchmarkSuite::Consume(Data::AlignedQuaternion(fixture.poses.back()[13].second).w);
+	}, kCrowdSize, GetThreadPoolSize());
+
+	/* One iteration is one frame of the whole crowd, two fixed steps at 120 Hz (Sampling excluded) */
+	auto springBonesCrowd = LazyFixture<SpringBonesCrowdFixture>::Create();
+
+	p_suite.Add("Crowd/SpringBones", [springBonesCrowd](uint64_t p_iterations)
+	{
+		SpringBonesCrowdFixture& fixture = springBonesCrowd->Get();
+
+		fixture.SetEnabledShare(1.0f);
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.UpdateFrame(nullptr);
+
+		BenchmarkSuite::Consume(Data::AlignedQuaternion(fixture.poses.back()[24].second).w);
+	}, kCrowdSize);
+
+	p_suite.Add("Crowd/SpringBones.ThreadPool", [springBonesCrowd](uint64_t p_iterations)
+	{
+		SpringBonesCrowdFixture& fixture = springBonesCrowd->Get();
+
+		fixture.SetEnabledShare(1.0f);
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.UpdateFrame(&fixture.threadPool);
+
+		BenchmarkSuite::Consume(Data::AlignedQuaternion(fixture.poses.back()[24].second).w);
+	}, kCrowdSize, GetThreadPoolSize());
+
+	/* A quarter of the crowd near the camera keeps its spring bones */
+	p_suite.Add("Crowd/SpringBones.LOD", [springBonesCrowd](uint64_t p_iterations)
+	{
+		SpringBonesCrowdFixture& fixture = springBonesCrowd->Get();
+
+		fixture.SetEnabledShare(0.25f);
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.UpdateFrame(nullptr);
+
+		BenchmarkSuite::Consume(Data::AlignedQuaternion(fixture.poses.front()[24].second).w);
+	}, kCrowdSize);
+}
@@ -0,0 +1,113 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "AnimationProgramming/Tools/IniManager.h"
+#include "AnimationProgramming/Tools/SIMD.h"
+
+#include "Benchmarks/AnimationBenchmarks.h"
+#include "Benchmarks/BenchmarkReport.h"
+#include "Benchmarks/BenchmarkSuite.h"
+#include "Benchmarks/CaptureBenchmarks.h"
+#include "Benchmarks/IKBenchmarks.h"
+#include "Benchmarks/MathBenchmarks.h"
+#include "Benchmarks/MotionBenchmarks.h"
+#include "Benchmarks/ReplayBenchmarks.h"
+#include "Benchmarks/SkinningBenchmarks.h"
+#include "Benchmarks/ToolsBenchmarks.h"
+
+using namespace AnimationProgramming;
+using namespace AnimationProgramming::Benchmarks;
+
+namespace
+{
+	void PrintUsage()
+	{
+		std::cout << "Usage: Benchmarks [options]" << std::endl;
+		std::cout << "  --filter <text>       Only run benchmarks whose name contains <text>" << std::endl;
+		std::cout << "  --json <file>         Write the results as JSON into <file>" << std::endl;
+		std::cout << "  --baseline <file>     Compare the results with a JSON file written by --json" << std::endl;
+		std::cout << "  --threshold <percent> Slowdown above which a benchmark is a regression (Default: 10)" << std::endl;
+		std::cout << "  --min-time <ms>       Minimum duration of one repetition (Default: 50)" << std::endl;
+		std::cout << "  --repetitions <count> Number of repetitions, the fastest is kept (Default: 5)" << std::endl;
+		std::cout << "  --replay <file>       Replay a session recorded by the application (record_inputs in animation.ini)" << std::endl;
+	}
+}
+
+int main(int p_argc, char** p_argv)
+{
+	std::string filter;
+	std::string jsonPath;
+	std::string baselinePath;
+	double threshold = 10.0;
+	double minimumMilliseconds = 50.0;
+	uint32_t repetitions = 5;
+	std::string replayPath;
+
+	for (int i = 1; i < p_argc; ++i)
+	{
+		const std::string argument = p_argv[i];
+		const bool hasValue = i + 1 < p_argc;
+
+		if (argument == "--filter" && hasValue)				filter = p_argv[++i];
+		else if (argument == "--json" && hasValue)			jsonPath = p_argv[++i];
+		else if (argument == "--baseline" && hasValue)		baselinePath = p_argv[++i];
+		else if (argument == "--threshold" && hasValue)		threshold = std::atof(p_argv[++i]);
+		else if (argument == "--min-time" && hasValue)		minimumMilliseconds = std::atof(p_argv[++i]);
+		else if (argument == "--repetitions" && hasValue)	repetitions = static_cast<uint32_t>(std::atoi(p_argv[++i]));
+		else if (argument == "--replay" && hasValue)		replayPath = p_argv[++i];
+		else
+		{
+			PrintUsage();
+			return EXIT_FAILURE;
+		}
+	}
+
+	/* The timeline reads its effectors from the ini files, like in the application */
+	Tools::IniManager::Initialize();
+	Tools::SIMD::Initialize();
+
+	std::cout << "Supported SIMD level: " << Tools::SIMD::GetLevelName(Tools::SIMD::GetSupportedLevel()) << std::endl << std::endl;
+
+	BenchmarkSuite suite;
+	MathBenchmarks::Register(suite);
+	AnimationBenchmarks::Register(suite);
+	MotionBenchmarks::Register(suite);
+	IKBenchmarks::Register(suite);
+	CaptureBenchmarks::Register(suite);
+	SkinningBenchmarks::Register(suite);
+	ToolsBenchmarks::Register(suite);
+
+	if (!replayPath.empty())
+		ReplayBenchmarks::Register(suite, replayPath);
+
+	const std::vector<BenchmarkResult> results = suite.Run(filter, minimumMilliseconds, repetitions);
+
+	if (!jsonPath.empty() && !BenchmarkReport::WriteJson(results, jsonPath))
+	{
+		std::cerr << "Cannot write " << jsonPath << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	uint32_t regressions = 0;
+
+	if (!baselinePath.empty())
+	{
+		std::vector<BenchmarkResult> baseline;
+		if (!BenchmarkReport::ReadJson(baselinePath, baseline))
+		{
+			std::cerr << "Cannot read " << baselinePath << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		regressions = BenchmarkReport::Compare(baseline, results, threshold);
+	}
+
+	return regressions == 0 && BenchmarkSuite::GetFailedCheckCount() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
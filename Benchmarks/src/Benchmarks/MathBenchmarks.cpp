@@ -0,0 +1,194 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <memory>
+#include <random>
+
+#include <AltMath/AltMath.h>
+
+#include "AnimationProgramming/Data/AlignedTypes.h"
+#include "AnimationProgramming/Data/Matrix3x4.h"
+#include "AnimationProgramming/Tools/SIMD.h"
+
+#include "Benchmarks/MathBenchmarks.h"
+
+namespace
+{
+	using namespace AnimationProgramming;
+
+	/* Power of two, so the input index can wrap with a mask */
+	constexpr uint32_t kInputCount = 1024;
+	constexpr uint32_t kInputMask = kInputCount - 1;
+
+	/**
+	* Random inputs shared by every math benchmark (Generated once with a fixed seed)
+	*/
+	struct MathInputs final
+	{
+		MathInputs()
+		{
+			std::mt19937 generator(42);
+			std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+			for (uint32_t i = 0; i < kInputCount; ++i)
+			{
+				AltMath::Quaternion rotation = AltMath::Quaternion(unit(generator), unit(generator), unit(generator), unit(generator)).Normalize();
+				AltMath::Vector3f position = AltMath::Vector3f(unit(generator), unit(generator), unit(generator)) * 100.0f;
+
+				quaternions.push_back(rotation);
+				vectors.push_back(position);
+				alphas.push_back(unit(generator) * 0.5f + 0.5f);
+
+				AltMath::Matrix4f matrix = rotation.ToMatrix4();
+				matrix.elements[3] = position.x;
+				matrix.elements[7] = position.y;
+				matrix.elements[11] = position.z;
+				matrices.push_back(matrix);
+
+				affineMatrices.emplace_back(position, rotation);
+				alignedMatrices.emplace_back(matrix);
+				alignedQuaternions.emplace_back(rotation);
+				alignedVectors.emplace_back(position);
+			}
+		}
+
+		std::vector<AltMath::Matrix4f> matrices;
+		std::vector<AltMath::Quaternion> quaternions;
+		std::vector<AltMath::Vector3f> vectors;
+		std::vector<float> alphas;
+		std::vector<Data::Matrix3x4> affineMatrices;
+		std::vector<Data::AlignedMatrix4> alignedMatrices;
+		std::vector<Data::AlignedQuaternion> alignedQuaternions;
+		std::vector<Data::AlignedVector3> alignedVectors;
+	};
+
+	/**
+	* Wrap a SIMD operation (Called with the iteration index) into a benchmark body that runs it at the given level.
+	* The fastest supported level is restored afterward, since other benchmarks rely on it
+	*/
+	template <typename Operation>
+	Benchmarks::BenchmarkSuite::Body MakeSIMDBenchmark(Tools::ESIMDLevel p_level, Operation p_operation)
+	{
+		return [p_level, p_operation](uint64_t p_iterations)
+		{
+			Tools::SIMD::SetLevel(p_level);
+
+			for (uint64_t i = 0; i < p_iterations; ++i)
+				p_operation(i);
+
+			Tools::SIMD::SetLevel(Tools::SIMD::GetSupportedLevel());
+		};
+	}
+}
+
+void AnimationProgramming::Benchmarks::MathBenchmarks::Register(BenchmarkSuite& p_suite)
+{
+	auto inputs = std::make_shared<MathInputs>();
+
+	/* AltMath primitives (Scalar reference) */
+	p_suite.Add("AltMath/Matrix4f.Multiply", [inputs](uint64_t p_iterations)
+	{
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			BenchmarkSuite::Consume((inputs->matrices[i & kInputMask] * inputs->matrices[(i + 1) & kInputMask]).elements[0]);
+	});
+
+	p_suite.Add("AltMath/Matrix4f.Inverse", [inputs](uint64_t p_iterations)
+	{
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			BenchmarkSuite::Consume(inputs->matrices[i & kInputMask].Inverse().elements[0]);
+	});
+
+	p_suite.Add("AltMath/Quaternion.Slerp", [inputs](uint64_t p_iterations)
+	{
+		for (uint64_t i = 0; i < p_iterations; ++i)
+		{
+			/* AltMath interpolations normalize their inputs in place, so we work on copies */
+			AltMath::Quaternion start = inputs->quaternions[i & kInputMask];
+			AltMath::Quaternion end = inputs->quaternions[(i + 1) & kInputMask];
+			BenchmarkSuite::Consume(AltMath::Quaternion::Slerp(start, end, inputs->alphas[i & kInputMask]).GetRealValue());
+		}
+	});
+
+	p_suite.Add("AltMath/Quaternion.Nlerp", [inputs](uint64_t p_iterations)
+	{
+		for (uint64_t i = 0; i < p_iterations; ++i)
+		{
+			AltMath::Quaternion start = inputs->quaternions[i & kInputMask];
+			AltMath::Quaternion end = inputs->quaternions[(i + 1) & kInputMask];
+			BenchmarkSuite::Consume(AltMath::Quaternion::Nlerp(start, end, inputs->alphas[i & kInputMask]).GetRealValue());
+		}
+	});
+
+	p_suite.Add("AltMath/Quaternion.ToMatrix4", [inputs](uint64_t p_iterations)
+	{
+		for (uint64_t i = 0; i < p_iterations; ++i)
+		{
+			AltMath::Quaternion rotation = inputs->quaternions[i & kInputMask];
+			BenchmarkSuite::Consume(rotation.ToMatrix4().elements[0]);
+		}
+	});
+
+	p_suite.Add("AltMath/Vector3f.Lerp", [inputs](uint64_t p_iterations)
+	{
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			BenchmarkSuite::Consume(AltMath::Vector3f::Lerp(inputs->vectors[i & kInputMask], inputs->vectors[(i + 1) & kInputMask], inputs->alphas[i & kInputMask]).x);
+	});
+
+	/* Affine matrices used by the bone hierarchy */
+	p_suite.Add("Data/Matrix3x4.Multiply", [inputs](uint64_t p_iterations)
+	{
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			BenchmarkSuite::Consume((inputs->affineMatrices[i & kInputMask] * inputs->affineMatrices[(i + 1) & kInputMask]).elements[0]);
+	});
+
+	p_suite.Add("Data/Matrix3x4.RigidInverse", [inputs](uint64_t p_iterations)
+	{
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			BenchmarkSuite::Consume(inputs->affineMatrices[i & kInputMask].RigidInverse().elements[0]);
+	});
+
+	/* SIMD kernels, once per instruction set supported by the CPU */
+	for (int level = 0; level <= static_cast<int>(Tools::SIMD::GetSupportedLevel()); ++level)
+	{
+		const Tools::ESIMDLevel simdLevel = static_cast<Tools::ESIMDLevel>(level);
+		const std::string prefix = std::string("SIMD/") + Tools::SIMD::GetLevelName(simdLevel) + "/";
+
+		p_suite.Add(prefix + "Multiply", MakeSIMDBenchmark(simdLevel, [inputs](uint64_t i)
+		{
+			Data::AlignedMatrix4 result;
+			Tools::SIMD::Multiply(inputs->alignedMatrices[i & kInputMask], inputs->alignedMatrices[(i + 1) & kInputMask], result);
+			BenchmarkSuite::Consume(result.elements[0]);
+		}));
+
+		p_suite.Add(prefix + "Inverse", MakeSIMDBenchmark(simdLevel, [inputs](uint64_t i)
+		{
+			Data::AlignedMatrix4 result;
+			Tools::SIMD::Inverse(inputs->alignedMatrices[i & kInputMask], result);
+			BenchmarkSuite::Consume(result.elements[0]);
+		}));
+
+		p_suite.Add(prefix + "Slerp", MakeSIMDBenchmark(simdLevel, [inputs](uint64_t i)
+		{
+			Data::AlignedQuaternion result;
+			Tools::SIMD::Slerp(inputs->alignedQuaternions[i & kInputMask], inputs->alignedQuaternions[(i + 1) & kInputMask], inputs->alphas[i & kInputMask], result);
+			BenchmarkSuite::Consume(result.w);
+		}));
+
+		p_suite.Add(prefix + "ToMatrix4", MakeSIMDBenchmark(simdLevel, [inputs](uint64_t i)
+		{
+			Data::AlignedMatrix4 result;
+			Tools::SIMD::ToMatrix4(inputs->alignedQuaternions[i & kInputMask], result);
+			BenchmarkSuite::Consume(result.elements[0]);
+		}));
+
+		p_suite.Add(prefix + "Lerp", MakeSIMDBenchmark(simdLevel, [inputs](uint64_t i)
+		{
+			Data::AlignedVector3 result;
+			Tools::SIMD::Lerp(inputs->alignedVectors[i & kInputMask], inputs->alignedVectors[(i + 1) & kInputMask], inputs->alphas[i & kInputMask], result);
+			BenchmarkSuite::Consume(result.x);
+		}));
+	}
+}
@@ -0,0 +1,457 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <cmath>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "AnimationProgramming/Animation/MotionMatcher.h"
+#include "AnimationProgramming/Animation/RetargetedPoseSource.h"
+#include "AnimationProgramming/Animation/Retargeter.h"
+#include "AnimationProgramming/Animation/TransitionIndex.h"
+#include "AnimationProgramming/Rig/Skeleton.h"
+#include "AnimationProgramming/Tools/SIMD.h"
+#include "AnimationProgramming/Tools/ThreadPool.h"
+
+#include "Benchmarks/BenchmarkFixtures.h"
+#include "Benchmarks/MotionBenchmarks.h"
+
+namespace
+{
+	using namespace AnimationProgramming;
+	using namespace AnimationProgramming::Benchmarks;
+
+	/**
+	* The walk and run of the stub engine, forward and backward, for the transition index
+	*/
+	struct TransitionIndexFixture final
+	{
+		TransitionIndexFixture() :
+			walkInfo("ThirdPersonWalk.anim"),
+			runInfo("ThirdPersonRun.anim"),
+			walk(walkInfo),
+			run(runInfo),
+			walkBackward(walkInfo),
+			runBackward(runInfo)
+		{
+			skeleton.CreateSkeletonFromBindPose();
+
+			for (Animation::AnimationInstance* clip : { &walk, &run, &walkBackward, &runBackward })
+			{
+				clip->loop = true;
+				clips.push_back(clip);
+			}
+
+			walkBackward.reverse = true;
+			runBackward.reverse = true;
+		}
+
+		Rig::Skeleton skeleton;
+		Animation::AnimationInfo walkInfo;
+		Animation::AnimationInfo runInfo;
+		Animation::AnimationInstance walk;
+		Animation::AnimationInstance run;
+		Animation::AnimationInstance walkBackward;
+		Animation::AnimationInstance runBackward;
+		std::vector<const Animation::AnimationInstance*> clips;
+		Animation::TransitionIndex transitionIndex;
+		Tools::ThreadPool threadPool;
+	};
+
+	constexpr const char* kTransitionIndexCachePath = "transition_index_benchmark.cache";
+
+	constexpr uint32_t kMotionFramesPerClip = 200;
+	constexpr uint32_t kMotionFeatureGroups = 9;
+	constexpr uint32_t kMotionQueryCount = 256;
+	constexpr uint32_t kMotionLeafBudget = 8;
+
+	/**
+	* A motion matching database of the given number of frames, with synthetic features (Smooth curves, one per clip, like the features
+	* of real clips), and queries close to some of its frames
+	*/
+	struct MotionDatabaseFixture final
+	{
+		MotionDatabaseFixture(uint32_t p_frameCount)
+		{
+			const std::vector<Animation::MotionDatabase::FeatureGroup> groups(kMotionFeatureGroups, { 3, 1.0f });
+			const uint32_t dimensions = 3 * kMotionFeatureGroups;
+
+			std::vector<Animation::MotionDatabase::Frame> frames(p_frameCount);
+			std::vector<float> features(static_cast<size_t>(p_frameCount) * dimensions);
+
+			for (uint32_t frame = 0; frame < p_frameCount; ++frame)
+			{
+				const uint32_t clip = frame / kMotionFramesPerClip;
+				const uint32_t key = frame % kMotionFramesPerClip;
+				frames[frame] = { clip, key };
+
+				for (uint32_t dimension = 0; dimension < dimensions; ++dimension)
+				{
+					const float frequency = 0.05f + 0.01f * static_cast<float>(dimension);
+					const float amplitude = 1.0f + 0.1f * static_cast<float>(clip % 7);
+					features[static_cast<size_t>(frame) * dimensions + dimension] = amplitude * std::sin(static_cast<float>(key) * frequency + static_cast<float>(clip) * 1.7f + static_cast<float>(dimension) * 0.3f);
+				}
+			}
+
+			database.Build(frames, features, groups);
+
+			queries.resize(static_cast<size_t>(kMotionQueryCount) * dimensions);
+
+			for (uint32_t query = 0; query < kMotionQueryCount; ++query)
+			{
+				const float* frameFeatures = database.GetNormalizedFeatures((query * 7919u) % p_frameCount);
+
+				for (uint32_t dimension = 0; dimension < dimensions; ++dimension)
+					queries[static_cast<size_t>(query) * dimensions + dimension] = frameFeatures[dimension] + 0.05f * std::sin(static_cast<float>(query + dimension));
+			}
+		}
+
+		/**
+		* Return the given query (Wrapped)
+		*/
+		const float* GetQuery(uint64_t p_index) const
+		{
+			return queries.data() + (p_index % kMotionQueryCount) * 3 * kMotionFeatureGroups;
+		}
+
+		Animation::MotionDatabase database;
+		std::vector<float> queries;
+	};
+
+	/**
+	* Search the best frame of the given queries of the given database with the k-d tree
+	*/
+	float FindBestFrames(const MotionDatabaseFixture& p_fixture, uint32_t p_begin, uint32_t p_end, uint32_t p_maxLeafVisits)
+	{
+		float frames = 0.0f;
+		float cost = 0.0f;
+
+		for (uint32_t query = p_begin; query < p_end; ++query)
+			frames += static_cast<float>(p_fixture.database.FindBestFrame(p_fixture.GetQuery(query), cost, p_maxLeafVisits));
+
+		return frames;
+	}
+
+	/**
+	* The motion matching databases of the benchmarks, created on first use (The largest ones take a while to build)
+	*/
+	struct MotionDatabaseCache final
+	{
+		MotionDatabaseFixture& Get(uint32_t p_frameCount)
+		{
+			std::unique_ptr<MotionDatabaseFixture>& fixture = fixtures[p_frameCount];
+
+			if (!fixture)
+				fixture = std::make_unique<MotionDatabaseFixture>(p_frameCount);
+
+			return *fixture;
+		}
+
+		std::map<uint32_t, std::unique_ptr<MotionDatabaseFixture>> fixtures;
+		Tools::ThreadPool threadPool;
+	};
+
+	/**
+	* A motion matching database built from the walk of the stub engine (Forward and backward), and a crowd playing it
+	*/
+	struct MotionMatchingCrowdFixture final
+	{
+		MotionMatchingCrowdFixture() :
+			animationInfo("ThirdPersonWalk.anim"),
+			walk(animationInfo),
+			walkBackward(animationInfo)
+		{
+			skeleton.CreateSkeletonFromBindPose();
+
+			walk.loop = true;
+			walkBackward.loop = true;
+			walkBackward.reverse = true;
+
+			Animation::MotionDatabase::Settings settings;
+			settings.featureBones = { kStubLeftFoot, kStubRightFoot };
+			database.Build(*skeleton.GetDefinition(), { &walk, &walkBackward }, settings);
+
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+			{
+				matchers.push_back(std::make_unique<Animation::MotionMatcher>(database));
+				matchers.back()->PlayFrame((i * 13) % database.GetFrameCount());
+
+				characters.push_back(std::make_unique<CrowdCharacter>());
+				characters.back()->animator.PlayPoseSource(*matchers.back());
+			}
+		}
+
+		/**
+		* Steer every character along a turning trajectory, then update them for one frame
+		*/
+		void UpdateFrame()
+		{
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+			{
+				const float side = std::sin(static_cast<float>(frame + i) * 0.01f);
+				matchers[i]->SetDesiredTrajectory({ AltMath::Vector3f(side * 10.0f, 0.0f, 0.0f), AltMath::Vector3f(side * 20.0f, 0.0f, 0.0f), AltMath::Vector3f(side * 30.0f, 0.0f, 0.0f) });
+				characters[i]->animator.UpdatePose(kFrameTime);
+			}
+
+			++frame;
+		}
+
+		Rig::Skeleton skeleton;
+		Animation::AnimationInfo animationInfo;
+		Animation::AnimationInstance walk;
+		Animation::AnimationInstance walkBackward;
+		Animation::MotionDatabase database;
+		std::vector<std::unique_ptr<Animation::MotionMatcher>> matchers;
+		std::vector<std::unique_ptr<CrowdCharacter>> characters;
+		uint32_t frame = 0;
+	};
+
+	/**
+	* A crowd of characters of another rig (Renamed bones mapped by role, rotated bind frames and longer bones) playing the walk of the stub engine
+	*/
+	struct RetargetCrowdFixture final
+	{
+		RetargetCrowdFixture() :
+			animationInfo("ThirdPersonWalk.anim"),
+			walk(animationInfo)
+		{
+			source.CreateSkeletonFromBindPose();
+			walk.loop = true;
+
+			std::vector<Rig::Bone>& bones = source.GetBones();
+			std::vector<Rig::Skeleton::BoneDescription> description(bones.size());
+			std::vector<AltMath::Vector3f> worldPositions(bones.size());
+			std::vector<AltMath::Quaternion> worldRotations(bones.size());
+			Animation::Retargeter::RoleTable sourceRoles;
+			Animation::Retargeter::RoleTable targetRoles;
+
+			for (uint32_t i = 0; i < bones.size(); ++i)
+			{
+				/* A quarter turn around an axis that changes with the bone */
+				const float angle = static_cast<float>(i);
+				const AltMath::Vector3f axis(std::sin(angle), std::cos(angle), 0.5f);
+				const AltMath::Vector3f halfTurn = axis * (0.7071f / axis.Length());
+				const AltMath::Quaternion frame(halfTurn.x, halfTurn.y, halfTurn.z, 0.7071f);
+
+				worldPositions[i] = bones[i].GetDefaultTransform().GetWorldPosition() * 1.25f;
+				worldRotations[i] = bones[i].GetDefaultTransform().GetWorldRotation() * frame;
+
+				description[i].name = "rig_" + bones[i].GetName();
+				description[i].parentIndex = bones[i].HasParent() ? static_cast<int32_t>(bones[i].GetParent().GetIndex()) : -1;
+
+				if (description[i].parentIndex == -1)
+				{
+					description[i].bindPose = { worldPositions[i], worldRotations[i] };
+				}
+				else
+				{
+					const AltMath::Quaternion parentInverse = AltMath::Quaternion::Conjugate(worldRotations[description[i].parentIndex]);
+					description[i].bindPose = { parentInverse * (worldPositions[i] - worldPositions[description[i].parentIndex]), parentInverse * worldRotations[i] };
+				}
+
+				sourceRoles[bones[i].GetName()] = "role_" + std::to_string(i);
+				targetRoles[description[i].name] = "role_" + std::to_string(i);
+			}
+
+			target.CreateSkeletonFromDescription(description);
+			retargeter.Build(*source.GetDefinition(), *target.GetDefinition(), sourceRoles, targetRoles);
+			walk.SamplePose(0.0f, sourcePose);
+
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+			{
+				characters.push_back(std::make_unique<Animation::RetargetedPoseSource>(walk, retargeter));
+				characters.back()->SetTime(static_cast<float>(i) * 0.05f);
+			}
+
+			poses.resize(kCrowdSize);
+		}
+
+		/**
+		* Sample and retarget the pose of every character for one frame
+		*/
+		void UpdateFrame()
+		{
+			for (uint32_t i = 0; i < kCrowdSize; ++i)
+			{
+				characters[i]->Update(kFrameTime);
+				characters[i]->Evaluate(poses[i]);
+			}
+		}
+
+		Rig::Skeleton source;
+		Rig::Skeleton target;
+		Animation::AnimationInfo animationInfo;
+		Animation::AnimationInstance walk;
+		Animation::Retargeter retargeter;
+		std::vector<Data::Transformation> sourcePose;
+		std::vector<Data::Transformation> targetPose;
+		std::vector<std::unique_ptr<Animation::RetargetedPoseSource>> characters;
+		std::vector<std::vector<Data::Transformation>> poses;
+	};
+}
+
+void AnimationProgramming::Benchmarks::MotionBenchmarks::Register(BenchmarkSuite& p_suite)
+{
+	/* One iteration is the analysis of every pair of clips */
+	auto transitionIndex = LazyFixture<TransitionIndexFixture>::Create();
+
+	p_suite.Add("TransitionIndex/Build", [transitionIndex](uint64_t p_iterations)
+	{
+		TransitionIndexFixture& fixture = transitionIndex->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.transitionIndex.Build(*fixture.skeleton.GetDefinition(), fixture.clips);
+
+		BenchmarkSuite::Consume(static_cast<float>(fixture.transitionIndex.GetEntryKey(0, 0, 1)));
+	});
+
+	p_suite.Add("TransitionIndex/Build.ThreadPool", [transitionIndex](uint64_t p_iterations)
+	{
+		TransitionIndexFixture& fixture = transitionIndex->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.transitionIndex.Build(*fixture.skeleton.GetDefinition(), fixture.clips, &fixture.threadPool);
+
+		BenchmarkSuite::Consume(static_cast<float>(fixture.transitionIndex.GetEntryKey(0, 0, 1)));
+	}, 0, GetThreadPoolSize());
+
+	/* The cache is written by the first call : the next ones only extract the features to check the signature, and read the file */
+	p_suite.Add("TransitionIndex/LoadOrBuild.Cached", [transitionIndex](uint64_t p_iterations)
+	{
+		TransitionIndexFixture& fixture = transitionIndex->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.transitionIndex.LoadOrBuild(kTransitionIndexCachePath, *fixture.skeleton.GetDefinition(), fixture.clips, &fixture.threadPool);
+
+		BenchmarkSuite::Consume(static_cast<float>(fixture.transitionIndex.GetEntryKey(0, 0, 1)));
+	}, 0, GetThreadPoolSize());
+
+	/* One iteration is one lookup of the best entry key */
+	p_suite.Add("TransitionIndex/FindEntryKey", [transitionIndex](uint64_t p_iterations)
+	{
+		TransitionIndexFixture& fixture = transitionIndex->Get();
+		const Animation::TransitionIndex& index = fixture.transitionIndex;
+		uint32_t total = 0;
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+		{
+			uint32_t entryKey = 0;
+			index.FindEntryKey(*fixture.clips[i % 4], static_cast<uint32_t>(i % 31), *fixture.clips[(i + 1) % 4], entryKey);
+			total += entryKey;
+		}
+
+		BenchmarkSuite::Consume(static_cast<float>(total));
+	});
+
+	/* Query latency against the size of the database. The cost of a k-d tree query depends on the query : one iteration is the whole set of queries */
+	auto motionDatabases = std::make_shared<MotionDatabaseCache>();
+	const std::pair<const char*, uint32_t> motionDatabaseSizes[] = { { "1k", 1000 }, { "10k", 10000 }, { "100k", 100000 }, { "1M", 1000000 } };
+
+	for (const auto&[suffix, frameCount] : motionDatabaseSizes)
+	{
+		const uint32_t size = frameCount;
+
+		p_suite.Add(std::string("MotionMatching/KDTree.") + suffix, [motionDatabases, size](uint64_t p_iterations)
+		{
+			const MotionDatabaseFixture& fixture = motionDatabases->Get(size);
+
+			for (uint64_t i = 0; i < p_iterations; ++i)
+				BenchmarkSuite::Consume(FindBestFrames(fixture, 0, kMotionQueryCount, 0));
+		}, kMotionQueryCount);
+
+		p_suite.Add(std::string("MotionMatching/KDTree.Budget.") + suffix, [motionDatabases, size](uint64_t p_iterations)
+		{
+			const MotionDatabaseFixture& fixture = motionDatabases->Get(size);
+
+			for (uint64_t i = 0; i < p_iterations; ++i)
+				BenchmarkSuite::Consume(FindBestFrames(fixture, 0, kMotionQueryCount, kMotionLeafBudget));
+		}, kMotionQueryCount);
+
+		p_suite.Add(std::string("MotionMatching/KDTree.ThreadPool.") + suffix, [motionDatabases, size](uint64_t p_iterations)
+		{
+			const MotionDatabaseFixture& fixture = motionDatabases->Get(size);
+			std::vector<float> results(kMotionQueryCount);
+
+			for (uint64_t i = 0; i < p_iterations; ++i)
+			{
+				motionDatabases->threadPool.ParallelFor(kMotionQueryCount, 16, [&fixture, &results](uint32_t p_begin, uint32_t p_end)
+				{
+					results[p_begin] = FindBestFrames(fixture, p_begin, p_end, 0);
+				});
+			}
+
+			BenchmarkSuite::Consume(results.front());
+		}, kMotionQueryCount, motionDatabases->threadPool.GetThreadCount());
+
+		/* The cost of a brute force query doesn't depend on the query : one iteration is one query */
+		p_suite.Add(std::string("MotionMatching/BruteForce.") + suffix, [motionDatabases, size](uint64_t p_iterations)
+		{
+			const MotionDatabaseFixture& fixture = motionDatabases->Get(size);
+			float cost = 0.0f;
+
+			for (uint64_t i = 0; i < p_iterations; ++i)
+				BenchmarkSuite::Consume(static_cast<float>(fixture.database.FindBestFrameBruteForce(fixture.GetQuery(i), cost)));
+		});
+
+		p_suite.Add(std::string("MotionMatching/BruteForce.ThreadPool.") + suffix, [motionDatabases, size](uint64_t p_iterations)
+		{
+			const MotionDatabaseFixture& fixture = motionDatabases->Get(size);
+			float cost = 0.0f;
+
+			for (uint64_t i = 0; i < p_iterations; ++i)
+				BenchmarkSuite::Consume(static_cast<float>(fixture.database.FindBestFrameBruteForce(fixture.GetQuery(i), cost, &motionDatabases->threadPool)));
+		}, 0, motionDatabases->threadPool.GetThreadCount());
+	}
+
+	auto motionMatchingCrowd = LazyFixture<MotionMatchingCrowdFixture>::Create();
+
+	p_suite.Add("Crowd/MotionMatching", [motionMatchingCrowd](uint64_t p_iterations)
+	{
+		MotionMatchingCrowdFixture& fixture = motionMatchingCrowd->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.UpdateFrame();
+
+		BenchmarkSuite::Consume(fixture.characters.back()->animator.GetSkinningPalette().front().elements[3]);
+	}, kCrowdSize);
+
+	/* One iteration is the retargeting of one pose of the engine skeleton */
+	auto retargetCrowd = LazyFixture<RetargetCrowdFixture>::Create();
+
+	p_suite.Add("Retargeter/Retarget.Scalar", [retargetCrowd](uint64_t p_iterations)
+	{
+		RetargetCrowdFixture& fixture = retargetCrowd->Get();
+
+		Tools::SIMD::SetLevel(Tools::ESIMDLevel::SCALAR);
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.retargeter.Retarget(fixture.sourcePose, fixture.targetPose);
+
+		Tools::SIMD::SetLevel(Tools::SIMD::GetSupportedLevel());
+		BenchmarkSuite::Consume(fixture.targetPose.back().first.x);
+	});
+
+	p_suite.Add("Retargeter/Retarget", [retargetCrowd](uint64_t p_iterations)
+	{
+		RetargetCrowdFixture& fixture = retargetCrowd->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.retargeter.Retarget(fixture.sourcePose, fixture.targetPose);
+
+		BenchmarkSuite::Consume(fixture.targetPose.back().first.x);
+	});
+
+	p_suite.Add("Crowd/Retarget", [retargetCrowd](uint64_t p_iterations)
+	{
+		RetargetCrowdFixture& fixture = retargetCrowd->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			fixture.UpdateFrame();
+
+		BenchmarkSuite::Consume(fixture.poses.back().back().first.x);
+	}, kCrowdSize);
+}
@@ -0,0 +1,128 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+
+#include "AnimationProgramming/Animation/Animator.h"
+#include "AnimationProgramming/Input/InputManager.h"
+#include "AnimationProgramming/Input/InputReplayer.h"
+#include "AnimationProgramming/Rig/Skeleton.h"
+
+#include "Benchmarks/ReplayBenchmarks.h"
+#include "Benchmarks/StubEngine.h"
+
+namespace
+{
+	using namespace AnimationProgramming;
+
+	/**
+	* A character driven by a recorded session, with the walk and the run of the stub engine (Members are declared in dependency order)
+	*/
+	struct ReplayFixture final
+	{
+		ReplayFixture(const std::string& p_recordingPath) :
+			walkAnimation("ThirdPersonWalk.anim"),
+			runAnimation("ThirdPersonRun.anim"),
+			walkAnimationInstance(walkAnimation),
+			runAnimationInstance(runAnimation),
+			animator(skeleton),
+			replayer(p_recordingPath)
+		{
+			skeleton.CreateSkeletonFromBindPose();
+
+			walkAnimationInstance.loop = true;
+			runAnimationInstance.loop = true;
+		}
+
+		/**
+		* Replay the whole session from the start
+		*/
+		void Replay()
+		{
+			replayer.Rewind();
+			inputManager.Update(std::vector<Input::KeyEvent>());
+			animator.SetGlobalSpeedCoefficient(1.0f);
+			animator.PlayAnimation(walkAnimationInstance);
+
+			float deltaTime = 0.0f;
+
+			while (replayer.ReadFrame(deltaTime, keyEvents))
+			{
+				inputManager.Update(keyEvents);
+				CheckInputs();
+				animator.Update(deltaTime);
+			}
+
+			/* Release the keys still pressed at the end of the session, for the next replay */
+			keyEvents.clear();
+
+			for (uint32_t key = 0; key < 256; ++key)
+				if (inputManager.IsKeyPressed(static_cast<char>(key)))
+					keyEvents.push_back({ static_cast<uint8_t>(key), false });
+
+			inputManager.Update(keyEvents);
+		}
+
+		/**
+		* Apply the keys of the application (Simulations::CSimulation::CheckInputs) that change the animation of the character
+		*/
+		void CheckInputs()
+		{
+			if (inputManager.IsKeyEventOccured('1'))
+				animator.PlayAnimation(walkAnimationInstance);
+
+			if (inputManager.IsKeyEventOccured('2'))
+				animator.PlayAnimation(runAnimationInstance);
+
+			if (inputManager.IsKeyEventOccured('5'))
+				animator.StopAnimation();
+
+			if (inputManager.IsKeyEventOccured('N') && animator.GetGlobalSpeedCoefficient() > 0.1f)
+				animator.SetGlobalSpeedCoefficient(std::max<float>(animator.GetGlobalSpeedCoefficient() * 0.75f, 0.1f));
+
+			if (inputManager.IsKeyEventOccured('M') && animator.GetGlobalSpeedCoefficient() < 10.0f)
+				animator.SetGlobalSpeedCoefficient(std::min<float>(animator.GetGlobalSpeedCoefficient() * 1.5f, 10.0f));
+
+			if (inputManager.IsKeyEventOccured('J'))
+				animator.SetGlobalSpeedCoefficient(1.0f);
+		}
+
+		Rig::Skeleton skeleton;
+		Animation::AnimationInfo walkAnimation;
+		Animation::AnimationInfo runAnimation;
+		Animation::AnimationInstance walkAnimationInstance;
+		Animation::AnimationInstance runAnimationInstance;
+		Animation::Animator animator;
+		Input::InputManager inputManager;
+		Input::InputReplayer replayer;
+		std::vector<Input::KeyEvent> keyEvents;
+	};
+}
+
+void AnimationProgramming::Benchmarks::ReplayBenchmarks::Register(BenchmarkSuite& p_suite, const std::string& p_recordingPath)
+{
+	auto fixture = std::make_shared<ReplayFixture>(p_recordingPath);
+
+	if (!fixture->replayer.IsLoaded())
+	{
+		std::cerr << "Cannot read the recording " << p_recordingPath << std::endl;
+		return;
+	}
+
+	std::cout << "Replaying " << fixture->replayer.GetFrameCount() << " frames from " << p_recordingPath << std::endl << std::endl;
+
+	/* One iteration is the whole session, one item is one frame */
+	p_suite.Add("Replay/Session", [fixture](uint64_t p_iterations)
+	{
+		for (uint64_t i = 0; i < p_iterations; ++i)
+		{
+			fixture->Replay();
+			BenchmarkSuite::Consume(StubEngine::GetLastSkinningPoseFirstValue());
+		}
+	}, fixture->replayer.GetFrameCount());
+}
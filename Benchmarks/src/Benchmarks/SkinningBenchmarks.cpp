@@ -0,0 +1,139 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <memory>
+#include <random>
+
+#include "AnimationProgramming/Animation/Animator.h"
+#include "AnimationProgramming/Rig/Skeleton.h"
+#include "AnimationProgramming/Skinning/CPUSkinning.h"
+#include "AnimationProgramming/Tools/SIMD.h"
+
+#include "Benchmarks/BenchmarkFixtures.h"
+#include "Benchmarks/SkinningBenchmarks.h"
+
+namespace
+{
+	using namespace AnimationProgramming;
+
+	/* Roughly the vertex count of a detailed character */
+	constexpr uint32_t kVertexCount = 65536;
+
+	/**
+	* A synthetic mesh skinned to the skeleton of the stub engine, and the palette of one frame of its animation
+	*/
+	struct SkinningFixture final
+	{
+		SkinningFixture() :
+			animationInfo("ThirdPersonWalk.anim"),
+			animationInstance(animationInfo),
+			animator(skeleton)
+		{
+			skeleton.CreateSkeletonFromBindPose();
+
+			animationInstance.loop = true;
+			animator.PlayAnimation(animationInstance);
+			animator.Update(0.3f);
+
+			/* Keep the dual quaternion palette of the same frame too */
+			animator.SetSkinningPaletteFormat(Animation::ESkinningPaletteFormat::DUAL_QUATERNION);
+			animator.SendSkinningMatricesToGPU();
+			animator.SetSkinningPaletteFormat(Animation::ESkinningPaletteFormat::MATRIX);
+
+			const std::vector<Data::Matrix3x4>& palette = animator.GetSkinningPalette();
+			const uint32_t boneCount = static_cast<uint32_t>(palette.size());
+
+			std::mt19937 generator(42);
+			std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+			std::uniform_real_distribution<float> weight(0.0f, 1.0f);
+
+			bindPose.Resize(kVertexCount);
+			weights.Resize(kVertexCount);
+
+			/* Each vertex surrounds a bone and is influenced by that bone and the following ones, like the skin around a joint */
+			for (uint32_t vertex = 0; vertex < kVertexCount; ++vertex)
+			{
+				const uint32_t bone = vertex % boneCount;
+				const AltMath::Vector3f normal = AltMath::Vector3f(unit(generator), unit(generator), unit(generator)).Normalize();
+
+				bindPose.SetVertex(vertex, AltMath::Vector3f(unit(generator), unit(generator), unit(generator)) * 50.0f, normal);
+				weights.SetInfluences(vertex,
+					{ bone, (bone + 1) % boneCount, (bone + 2) % boneCount, (bone + 3) % boneCount },
+					{ 1.0f, weight(generator), weight(generator) * 0.5f, weight(generator) * 0.25f });
+			}
+		}
+
+		Rig::Skeleton skeleton;
+		Animation::AnimationInfo animationInfo;
+		Animation::AnimationInstance animationInstance;
+		Animation::Animator animator;
+
+		Skinning::VertexBuffer bindPose;
+		Skinning::SkinWeights weights;
+		Skinning::VertexBuffer result;
+		Tools::ThreadPool threadPool;
+	};
+}
+
+void AnimationProgramming::Benchmarks::SkinningBenchmarks::Register(BenchmarkSuite& p_suite)
+{
+	auto skinning = LazyFixture<SkinningFixture>::Create();
+	const uint32_t threadCount = GetThreadPoolSize();
+
+	for (int level = 0; level <= static_cast<int>(Tools::SIMD::GetSupportedLevel()); ++level)
+	{
+		const Tools::ESIMDLevel simdLevel = static_cast<Tools::ESIMDLevel>(level);
+		const std::string prefix = std::string("Skinning/") + Tools::SIMD::GetLevelName(simdLevel) + "/";
+
+		p_suite.Add(prefix + "SingleThread", [skinning, simdLevel](uint64_t p_iterations)
+		{
+			SkinningFixture& fixture = skinning->Get();
+
+			Tools::SIMD::SetLevel(simdLevel);
+
+			for (uint64_t i = 0; i < p_iterations; ++i)
+				Skinning::CPUSkinning::Skin(fixture.animator.GetSkinningPalette(), fixture.bindPose, fixture.weights, fixture.result);
+
+			Tools::SIMD::SetLevel(Tools::SIMD::GetSupportedLevel());
+			BenchmarkSuite::Consume(fixture.result.positionsX.back());
+		}, kVertexCount, 1);
+
+		/* The thread count isn't part of the name, so results of different machines can still be compared */
+		p_suite.Add(prefix + "ThreadPool", [skinning, simdLevel](uint64_t p_iterations)
+		{
+			SkinningFixture& fixture = skinning->Get();
+
+			Tools::SIMD::SetLevel(simdLevel);
+
+			for (uint64_t i = 0; i < p_iterations; ++i)
+				Skinning::CPUSkinning::Skin(fixture.animator.GetSkinningPalette(), fixture.bindPose, fixture.weights, fixture.result, fixture.threadPool);
+
+			Tools::SIMD::SetLevel(Tools::SIMD::GetSupportedLevel());
+			BenchmarkSuite::Consume(fixture.result.positionsX.back());
+		}, kVertexCount, threadCount);
+	}
+
+	/* Dual quaternion skinning (Scalar reference only) */
+	p_suite.Add("Skinning/DualQuaternion/SingleThread", [skinning](uint64_t p_iterations)
+	{
+		SkinningFixture& fixture = skinning->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			Skinning::CPUSkinning::Skin(fixture.animator.GetDualQuaternionPalette(), fixture.bindPose, fixture.weights, fixture.result);
+
+		BenchmarkSuite::Consume(fixture.result.positionsX.back());
+	}, kVertexCount, 1);
+
+	p_suite.Add("Skinning/DualQuaternion/ThreadPool", [skinning](uint64_t p_iterations)
+	{
+		SkinningFixture& fixture = skinning->Get();
+
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			Skinning::CPUSkinning::Skin(fixture.animator.GetDualQuaternionPalette(), fixture.bindPose, fixture.weights, fixture.result, fixture.threadPool);
+
+		BenchmarkSuite::Consume(fixture.result.positionsX.back());
+	}, kVertexCount, threadCount);
+}
@@ -0,0 +1,149 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include <Engine/Engine.h>
+#include <Engine/Simulation.h>
+
+#include "Benchmarks/StubEngine.h"
+
+using AnimationProgramming::Benchmarks::StubEngine;
+
+namespace
+{
+	constexpr uint32_t kTotalBoneCount = StubEngine::BoneCount + StubEngine::IKBoneCount;
+
+	/* The skeleton is a spine of 8 bones with 7 limbs of 8 bones, each limb being attached to a spine bone */
+	constexpr int kChainLength = 8;
+
+	/* Same IK bones, in the same order, as the mannequin (ThirdPersonWalk.skel) */
+	const char* const kIKBoneNames[StubEngine::IKBoneCount] = { "ik_foot_root", "ik_foot_l", "ik_foot_r", "ik_hand_root", "ik_hand_gun", "ik_hand_l", "ik_hand_r" };
+
+	/* Parent of each IK bone, among the IK bones (-1 : the root bone of the skeleton) */
+	const int kIKBoneParents[StubEngine::IKBoneCount] = { -1, 0, 0, -1, 3, 4, 4 };
+
+	uint64_t g_skinningPoseCount = 0;
+	float g_lastSkinningPoseFirstValue = 0.0f;
+
+	/**
+	* Write a normalized quaternion rotating around a fixed axis (Depending on the seed) by the given angle
+	*/
+	void MakeRotation(uint32_t p_seed, float p_angle, float& p_quatW, float& p_quatX, float& p_quatY, float& p_quatZ)
+	{
+		const float axisX = std::sin(p_seed * 1.7f);
+		const float axisY = std::cos(p_seed * 0.9f);
+		const float axisZ = std::sin(p_seed * 2.3f + 1.0f);
+		const float axisLength = std::sqrt(axisX * axisX + axisY * axisY + axisZ * axisZ);
+		const float halfSin = std::sin(p_angle * 0.5f) / axisLength;
+
+		p_quatW = std::cos(p_angle * 0.5f);
+		p_quatX = axisX * halfSin;
+		p_quatY = axisY * halfSin;
+		p_quatZ = axisZ * halfSin;
+	}
+}
+
+uint64_t AnimationProgramming::Benchmarks::StubEngine::GetSkinningPoseCount()
+{
+	return g_skinningPoseCount;
+}
+
+float AnimationProgramming::Benchmarks::StubEngine::GetLastSkinningPoseFirstValue()
+{
+	return g_lastSkinningPoseFirstValue;
+}
+
+void Run(ISimulation* pSimulation, unsigned int, unsigned int)
+{
+	/* Headless run : 10 seconds of simulation at 60 FPS */
+	pSimulation->Init();
+
+	for (uint32_t frame = 0; frame < 600; ++frame)
+		pSimulation->Update(1.0f / 60.0f);
+}
+
+void SetSkinningPose(const float* boneMatrices, size_t boneCount)
+{
+	++g_skinningPoseCount;
+	g_lastSkinningPoseFirstValue = boneCount > 0 ? boneMatrices[0] : 0.0f;
+}
+
+size_t GetSkeletonBoneCount()
+{
+	return kTotalBoneCount;
+}
+
+const char* GetSkeletonBoneName(int boneIndex)
+{
+	static char names[StubEngine::BoneCount][16];
+
+	if (boneIndex >= static_cast<int>(StubEngine::BoneCount))
+		return kIKBoneNames[boneIndex - StubEngine::BoneCount];
+
+	std::snprintf(names[boneIndex], sizeof(names[boneIndex]), "bone_%02d", boneIndex);
+	return names[boneIndex];
+}
+
+int GetSkeletonBoneIndex(const char* name)
+{
+	for (int boneIndex = 0; boneIndex < static_cast<int>(kTotalBoneCount); ++boneIndex)
+	{
+		if (std::strcmp(GetSkeletonBoneName(boneIndex), name) == 0)
+			return boneIndex;
+	}
+
+	return -1;
+}
+
+int GetSkeletonBoneParentIndex(int boneIndex)
+{
+	/* The IK roots are attached to the root bone, like on the mannequin */
+	if (boneIndex >= static_cast<int>(StubEngine::BoneCount))
+	{
+		const int ikParent = kIKBoneParents[boneIndex - StubEngine::BoneCount];
+		return ikParent == -1 ? 0 : static_cast<int>(StubEngine::BoneCount) + ikParent;
+	}
+
+	if (boneIndex < kChainLength)
+		return boneIndex - 1;
+
+	const int limb = (boneIndex - kChainLength) / kChainLength;
+	const int limbBone = (boneIndex - kChainLength) % kChainLength;
+
+	return limbBone == 0 ? limb % kChainLength : boneIndex - 1;
+}
+
+void GetSkeletonBoneLocalBindTransform(int boneIndex, float& posX, float& posY, float& posZ, float& quatW, float& quatX, float& quatY, float& quatZ)
+{
+	posX = boneIndex == 0 ? 0.0f : 2.0f;
+	posY = boneIndex == 0 ? 0.0f : 10.0f;
+	posZ = 0.0f;
+	MakeRotation(boneIndex, 0.2f, quatW, quatX, quatY, quatZ);
+}
+
+size_t GetAnimKeyCount(const char*)
+{
+	return StubEngine::KeyFrameCount;
+}
+
+void GetAnimLocalBoneTransform(const char* animName, int boneIndex, int keyFrameIndex, float& posX, float& posY, float& posZ, float& quatW, float& quatX, float& quatY, float& quatZ)
+{
+	/* Every animation is a looping oscillation of each bone, the animation name only changes the amplitude */
+	const float amplitude = static_cast<float>(std::strlen(animName) % 4 + 1) * 0.2f;
+	const float phase = 6.2831853f * static_cast<float>(keyFrameIndex) / static_cast<float>(StubEngine::KeyFrameCount);
+
+	posX = 0.0f;
+	posY = boneIndex == 0 ? std::sin(phase) * amplitude : 0.0f;
+	posZ = 0.0f;
+	MakeRotation(boneIndex + 100, std::sin(phase + boneIndex * 0.3f) * amplitude, quatW, quatX, quatY, quatZ);
+}
+
+void DrawLine(float, float, float, float, float, float, float, float, float)
+{
+}
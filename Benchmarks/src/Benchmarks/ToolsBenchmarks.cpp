@@ -0,0 +1,52 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <memory>
+
+#include <GyvrIni/GyvrIni.h>
+
+#include "AnimationProgramming/Tools/Event.h"
+
+#include "Benchmarks/ToolsBenchmarks.h"
+
+void AnimationProgramming::Benchmarks::ToolsBenchmarks::Register(BenchmarkSuite& p_suite)
+{
+	/* An event with as many listeners as a bone transform can have children */
+	auto event = std::make_shared<Tools::Event<>>();
+	auto counter = std::make_shared<uint64_t>(0);
+
+	for (uint8_t listener = 0; listener < 8; ++listener)
+		event->AddListener([counter] { ++*counter; });
+
+	p_suite.Add("Event/Invoke (8 listeners)", [event, counter](uint64_t p_iterations)
+	{
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			event->Invoke();
+
+		BenchmarkSuite::Consume(static_cast<float>(*counter));
+	});
+
+	/* The animation settings files are read the same way by IniManager::SetupAnimationInstanceFromIniFile */
+	auto iniFile = std::make_shared<GyvrIni::Core::IniFile>("config/animations_settings/walk_anim.ini");
+
+	p_suite.Add("IniFile/Get<float>", [iniFile](uint64_t p_iterations)
+	{
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			BenchmarkSuite::Consume(iniFile->Get<float>("frame_duration"));
+	});
+
+	p_suite.Add("IniFile/Get<bool>", [iniFile](uint64_t p_iterations)
+	{
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			BenchmarkSuite::Consume(iniFile->Get<bool>("loop") ? 1.0f : 0.0f);
+	});
+
+	p_suite.Add("IniFile/Get<std::string>", [iniFile](uint64_t p_iterations)
+	{
+		for (uint64_t i = 0; i < p_iterations; ++i)
+			BenchmarkSuite::Consume(static_cast<float>(iniFile->Get<std::string>("transition_duration").size()));
+	});
+}
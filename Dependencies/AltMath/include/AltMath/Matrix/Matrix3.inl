@@ -8,6 +8,7 @@
 #include <sstream>
 #include <iostream>
 #include <cmath>
+#include <cstring>
 #include "Matrix2.h"
 #include "AltMath/Vector/Vector2.h"
 #include "AltMath/Vector/Vector3.h"
@@ -4,11 +4,13 @@
 #define _MATRIX4_INL
 #define _USE_MATH_DEFINES
 #include <cmath>
+#include <cstring>
 #include <utility>
 #include <string>
 #include <sstream>
 #include <iostream>
 #include "Matrix4.h"
+#include "AltMath/Tools/Generics.h"
 
 namespace AltMath
 {
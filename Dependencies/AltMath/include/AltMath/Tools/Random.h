@@ -5,8 +5,8 @@
  */
 
 #pragma once
-#ifndef _RANDOM_H
-#define _RANDOM_H
+#ifndef _ALTMATH_RANDOM_H
+#define _ALTMATH_RANDOM_H
 
 #pragma warning(push)
 #pragma warning(disable: 4251)
@@ -58,4 +58,4 @@ namespace AltMath
 #include "Random.inl"
 
 #pragma warning(pop)
-#endif //_RANDOM_H
\ No newline at end of file
+#endif //_ALTMATH_RANDOM_H
\ No newline at end of file
@@ -37,7 +37,7 @@ template <typename T>
 T AltMath::Tools::Utils::SquareRootF(T p_value)
 {
 	static_assert(std::is_arithmetic<T>::value, "The value to root must be arithmetic");
-	return static_cast<T>(std::sqrtf(p_value));
+	return static_cast<T>(std::sqrt(static_cast<float>(p_value)));
 }
 
 template<typename T>
@@ -1,7 +1,9 @@
 #ifndef ALTMATH_EXPORT_INCLUDE
 #pragma once
 
-#ifdef ALTMATH_EXPORT
+#if !defined(_WIN32)
+#define ALTMATH_API
+#elif defined(ALTMATH_EXPORT)
 #define ALTMATH_API __declspec(dllexport)
 #else
 #define ALTMATH_API __declspec(dllimport)
@@ -0,0 +1,247 @@
+/**
+ * Project AltMath
+ * @author GP2021
+ * @version 1.0.0
+ */
+
+/**
+ * Portable source of the Quaternion members used by the animation code (Only the Windows DLL is shipped).
+ * The other members are declared by the header but not built
+ */
+
+#include <cmath>
+
+#include "AltMath/Quaternion/Quaternion.h"
+
+/* Slerp falls back to a normalized lerp above this dot product (acos is imprecise near 1) */
+static constexpr double kSlerpLerpThreshold = 0.9998;
+
+AltMath::Quaternion AltMath::Quaternion::Identity()
+{
+	return Quaternion(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+AltMath::Quaternion::Quaternion() :
+	m_x(0.0f), m_y(0.0f), m_z(0.0f), m_w(1.0f)
+{
+}
+
+AltMath::Quaternion::Quaternion(float p_x, float p_y, float p_z, float p_w) :
+	m_x(p_x), m_y(p_y), m_z(p_z), m_w(p_w)
+{
+}
+
+AltMath::Quaternion::Quaternion(const Quaternion& p_other) :
+	m_x(p_other.m_x), m_y(p_other.m_y), m_z(p_other.m_z), m_w(p_other.m_w)
+{
+}
+
+AltMath::Quaternion::Quaternion(const Matrix3<float>& p_matrix)
+{
+	const float* e = p_matrix.elements;
+	const float trace = e[0] + e[4] + e[8];
+
+	/* The largest of w, x, y and z is computed from the diagonal, the others from the off-diagonal elements */
+	if (trace > 0.0f)
+	{
+		const float s = std::sqrt(trace + 1.0f) * 2.0f;
+		m_w = 0.25f * s;
+		m_x = (e[7] - e[5]) / s;
+		m_y = (e[2] - e[6]) / s;
+		m_z = (e[3] - e[1]) / s;
+	}
+	else if (e[0] > e[4] && e[0] > e[8])
+	{
+		const float s = std::sqrt(1.0f + e[0] - e[4] - e[8]) * 2.0f;
+		m_w = (e[7] - e[5]) / s;
+		m_x = 0.25f * s;
+		m_y = (e[1] + e[3]) / s;
+		m_z = (e[2] + e[6]) / s;
+	}
+	else if (e[4] > e[8])
+	{
+		const float s = std::sqrt(1.0f + e[4] - e[0] - e[8]) * 2.0f;
+		m_w = (e[2] - e[6]) / s;
+		m_x = (e[1] + e[3]) / s;
+		m_y = 0.25f * s;
+		m_z = (e[5] + e[7]) / s;
+	}
+	else
+	{
+		const float s = std::sqrt(1.0f + e[8] - e[0] - e[4]) * 2.0f;
+		m_w = (e[3] - e[1]) / s;
+		m_x = (e[2] + e[6]) / s;
+		m_y = (e[5] + e[7]) / s;
+		m_z = 0.25f * s;
+	}
+}
+
+AltMath::Quaternion::Quaternion(const Vector3<float>& p_axis, float p_angleInRadians)
+{
+	const float halfSin = std::sin(p_angleInRadians * 0.5f);
+
+	m_x = p_axis.x * halfSin;
+	m_y = p_axis.y * halfSin;
+	m_z = p_axis.z * halfSin;
+	m_w = std::cos(p_angleInRadians * 0.5f);
+}
+
+float AltMath::Quaternion::DotProduct(const Quaternion& p_otherQuat) const
+{
+	return m_x * p_otherQuat.m_x + m_y * p_otherQuat.m_y + m_z * p_otherQuat.m_z + m_w * p_otherQuat.m_w;
+}
+
+float AltMath::Quaternion::DotProduct(const Quaternion& p_left, const Quaternion& p_right)
+{
+	return p_left.DotProduct(p_right);
+}
+
+AltMath::Quaternion AltMath::Quaternion::operator*(const float p_scale) const
+{
+	return Quaternion(m_x * p_scale, m_y * p_scale, m_z * p_scale, m_w * p_scale);
+}
+
+AltMath::Quaternion AltMath::Quaternion::operator*(const Quaternion& p_otherQuat) const
+{
+	return Quaternion
+	(
+		m_w * p_otherQuat.m_x + m_x * p_otherQuat.m_w + m_y * p_otherQuat.m_z - m_z * p_otherQuat.m_y,
+		m_w * p_otherQuat.m_y - m_x * p_otherQuat.m_z + m_y * p_otherQuat.m_w + m_z * p_otherQuat.m_x,
+		m_w * p_otherQuat.m_z + m_x * p_otherQuat.m_y - m_y * p_otherQuat.m_x + m_z * p_otherQuat.m_w,
+		m_w * p_otherQuat.m_w - m_x * p_otherQuat.m_x - m_y * p_otherQuat.m_y - m_z * p_otherQuat.m_z
+	);
+}
+
+AltMath::Vector3<float> AltMath::Quaternion::operator*(const Vector3<float>& p_toMultiply) const
+{
+	/* q * (v, 0) * conjugate(q) */
+	const Quaternion rotated = *this * Quaternion(p_toMultiply.x, p_toMultiply.y, p_toMultiply.z, 0.0f) * Conjugate(*this);
+	return Vector3<float>(rotated.m_x, rotated.m_y, rotated.m_z);
+}
+
+AltMath::Quaternion& AltMath::Quaternion::Normalize()
+{
+	const float length = std::sqrt(DotProduct(*this));
+
+	if (length > 0.0f)
+	{
+		m_x /= length;
+		m_y /= length;
+		m_z /= length;
+		m_w /= length;
+	}
+
+	return *this;
+}
+
+AltMath::Quaternion AltMath::Quaternion::Normalize(const Quaternion& p_quaternion)
+{
+	Quaternion result(p_quaternion);
+	return result.Normalize();
+}
+
+AltMath::Quaternion AltMath::Quaternion::Conjugate(const Quaternion& p_quaternion)
+{
+	return Quaternion(-p_quaternion.m_x, -p_quaternion.m_y, -p_quaternion.m_z, p_quaternion.m_w);
+}
+
+float AltMath::Quaternion::GetXAxisValue() const
+{
+	return m_x;
+}
+
+float AltMath::Quaternion::GetYAxisValue() const
+{
+	return m_y;
+}
+
+float AltMath::Quaternion::GetZAxisValue() const
+{
+	return m_z;
+}
+
+float AltMath::Quaternion::GetRealValue() const
+{
+	return m_w;
+}
+
+AltMath::Quaternion AltMath::Quaternion::Slerp(Quaternion& p_first, Quaternion& p_second, const float p_alpha)
+{
+	/* The inputs are normalized in place */
+	p_first.Normalize();
+	p_second.Normalize();
+
+	Quaternion end(p_second);
+	float dot = p_first.DotProduct(end);
+
+	/* Take the shortest path */
+	if (dot < 0.0f)
+	{
+		end = end * -1.0f;
+		dot = -dot;
+	}
+
+	if (static_cast<double>(dot) > kSlerpLerpThreshold)
+	{
+		const Quaternion lerp
+		(
+			p_first.m_x + (end.m_x - p_first.m_x) * p_alpha,
+			p_first.m_y + (end.m_y - p_first.m_y) * p_alpha,
+			p_first.m_z + (end.m_z - p_first.m_z) * p_alpha,
+			p_first.m_w + (end.m_w - p_first.m_w) * p_alpha
+		);
+
+		return Normalize(lerp);
+	}
+
+	const float theta = std::acos(dot);
+	const float inverseSinTheta = 1.0f / std::sin(theta);
+	const float startWeight = std::sin((1.0f - p_alpha) * theta) * inverseSinTheta;
+	const float endWeight = std::sin(p_alpha * theta) * inverseSinTheta;
+
+	return Quaternion
+	(
+		p_first.m_x * startWeight + end.m_x * endWeight,
+		p_first.m_y * startWeight + end.m_y * endWeight,
+		p_first.m_z * startWeight + end.m_z * endWeight,
+		p_first.m_w * startWeight + end.m_w * endWeight
+	);
+}
+
+AltMath::Quaternion AltMath::Quaternion::Nlerp(Quaternion& p_first, Quaternion& p_second, const float p_alpha)
+{
+	/* The inputs are normalized in place */
+	p_first.Normalize();
+	p_second.Normalize();
+
+	/* Take the shortest path */
+	const Quaternion end = p_first.DotProduct(p_second) < 0.0f ? p_second * -1.0f : p_second;
+
+	const Quaternion lerp
+	(
+		p_first.m_x + (end.m_x - p_first.m_x) * p_alpha,
+		p_first.m_y + (end.m_y - p_first.m_y) * p_alpha,
+		p_first.m_z + (end.m_z - p_first.m_z) * p_alpha,
+		p_first.m_w + (end.m_w - p_first.m_w) * p_alpha
+	);
+
+	return Normalize(lerp);
+}
+
+AltMath::Matrix4<float> AltMath::Quaternion::ToMatrix4()
+{
+	/* The quaternion is normalized in place */
+	Normalize();
+
+	const float xx = 2.0f * m_x * m_x, yy = 2.0f * m_y * m_y, zz = 2.0f * m_z * m_z;
+	const float xy = 2.0f * m_x * m_y, xz = 2.0f * m_x * m_z, yz = 2.0f * m_y * m_z;
+	const float xw = 2.0f * m_x * m_w, yw = 2.0f * m_y * m_w, zw = 2.0f * m_z * m_w;
+
+	return Matrix4<float>
+	(
+		1.0f - yy - zz,	xy - zw,		xz + yw,		0.0f,
+		xy + zw,		1.0f - xx - zz,	yz - xw,		0.0f,
+		xz - yw,		yz + xw,		1.0f - xx - yy,	0.0f,
+		0.0f,			0.0f,			0.0f,			1.0f
+	);
+}
@@ -0,0 +1,10 @@
+/**
+ * Project AltMath
+ * @author GP2021
+ * @version 1.0.0
+ */
+
+#include "AltMath/Tools/Generics.h"
+
+const float AltMath::Tools::Generics::Pi	= 3.14159265358979323846f;
+const float AltMath::Tools::Generics::E		= 2.71828182845904523536f;
@@ -0,0 +1,34 @@
+/**
+ * Project AltMath
+ * @author GP2021
+ * @version 1.0.0
+ */
+
+/**
+ * Portable source of the Utils members used by the animation code (Only the Windows DLL is shipped)
+ */
+
+#include <cmath>
+
+#include "AltMath/Tools/Generics.h"
+#include "AltMath/Tools/Utils.h"
+
+float AltMath::Tools::Utils::ToRadians(float p_angle)
+{
+	return p_angle * Generics::Pi / 180.0f;
+}
+
+float AltMath::Tools::Utils::ToDegrees(float p_angle)
+{
+	return p_angle * 180.0f / Generics::Pi;
+}
+
+float AltMath::Tools::Utils::SinF(float p_value)
+{
+	return std::sin(p_value);
+}
+
+float AltMath::Tools::Utils::CosF(float p_value)
+{
+	return std::cos(p_value);
+}
@@ -1,7 +1,11 @@
 #ifndef __ENGINE_H__
 #define __ENGINE_H__
 
-#ifdef ENGINE_EXPORTS
+#include <stddef.h>
+
+#if !defined(_WIN32)
+#define ENGINE_API
+#elif defined(ENGINE_EXPORTS)
 #define ENGINE_API __declspec(dllexport) 
 #else
 #define ENGINE_API __declspec(dllimport) 
@@ -11,7 +11,9 @@
 #pragma warning(disable : 4251)
 #pragma warning(disable : 4275)
 
-#ifdef GYVRINI_EXPORT
+#if !defined(_WIN32)
+#define API_GYVRINI
+#elif defined(GYVRINI_EXPORT)
 #define API_GYVRINI __declspec(dllexport)
 #else
 #define API_GYVRINI __declspec(dllimport)
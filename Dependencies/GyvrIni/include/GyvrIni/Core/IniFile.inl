@@ -44,7 +44,7 @@ inline T GyvrIni::Core::IniFile::Get(const std::string& p_key)
 	}
 	else
 	{
-		static_assert(false, "The given type must be : bool, integral, floating point or string");
+		static_assert(sizeof(T) == 0, "The given type must be : bool, integral, floating point or string");
 		return T();
 	}
 }
@@ -72,7 +72,7 @@ inline bool GyvrIni::Core::IniFile::Set(const std::string& p_key, const T& p_val
 		}
 		else
 		{
-			static_assert(false, "The given type must be : bool, integral, floating point or string");
+			static_assert(sizeof(T) == 0, "The given type must be : bool, integral, floating point or string");
 		}
 
 		return true;
@@ -104,7 +104,7 @@ inline bool GyvrIni::Core::IniFile::Add(const std::string & p_key, const T & p_v
 		}
 		else
 		{
-			static_assert(false, "The given type must be : bool, integral, floating point or std::string");
+			static_assert(sizeof(T) == 0, "The given type must be : bool, integral, floating point or std::string");
 		}
 
 		return true;
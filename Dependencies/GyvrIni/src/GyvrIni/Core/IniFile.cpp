@@ -0,0 +1,100 @@
+/**
+* Project GyvrIni
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+#include <fstream>
+
+#include "GyvrIni/Core/IniFile.h"
+
+GyvrIni::Core::IniFile::IniFile(const std::string& p_filePath) : m_filePath(p_filePath)
+{
+	Load();
+}
+
+void GyvrIni::Core::IniFile::Reload()
+{
+	RemoveAll();
+	Load();
+}
+
+void GyvrIni::Core::IniFile::Rewrite() const
+{
+	std::ofstream outfile(m_filePath, std::ios::out | std::ios::trunc);
+
+	for (const std::string& line : GetFormattedContent())
+		outfile << line << std::endl;
+}
+
+bool GyvrIni::Core::IniFile::Remove(const std::string& p_key)
+{
+	return m_data.erase(p_key) != 0;
+}
+
+void GyvrIni::Core::IniFile::RemoveAll()
+{
+	m_data.clear();
+}
+
+bool GyvrIni::Core::IniFile::IsKeyExisting(const std::string& p_key) const
+{
+	return m_data.find(p_key) != m_data.end();
+}
+
+std::vector<std::string> GyvrIni::Core::IniFile::GetFormattedContent() const
+{
+	std::vector<std::string> result;
+
+	for (const AttributePair& pair : m_data)
+		result.push_back(pair.first + "=" + pair.second);
+
+	return result;
+}
+
+void GyvrIni::Core::IniFile::RegisterPair(const std::string& p_key, const std::string& p_value)
+{
+	RegisterPair(std::make_pair(p_key, p_value));
+}
+
+void GyvrIni::Core::IniFile::RegisterPair(const AttributePair& p_pair)
+{
+	m_data.insert(p_pair);
+}
+
+void GyvrIni::Core::IniFile::Load()
+{
+	std::ifstream file(m_filePath);
+	std::string currentLine;
+
+	while (std::getline(file, currentLine))
+	{
+		/* Files written on Windows end their lines with "\r\n" */
+		if (!currentLine.empty() && currentLine.back() == '\r')
+			currentLine.pop_back();
+
+		if (IsValidLine(currentLine))
+			RegisterPair(ExtractKeyAndValue(currentLine));
+	}
+}
+
+GyvrIni::Core::IniFile::AttributePair GyvrIni::Core::IniFile::ExtractKeyAndValue(const std::string& p_attributeLine) const
+{
+	const size_t separator = p_attributeLine.find('=');
+	return { p_attributeLine.substr(0, separator), p_attributeLine.substr(separator + 1) };
+}
+
+bool GyvrIni::Core::IniFile::IsValidLine(const std::string& p_attributeLine) const
+{
+	/* Empty lines, comments (# or ;) and lines without exactly one '=' are ignored */
+	if (p_attributeLine.empty() || p_attributeLine[0] == '#' || p_attributeLine[0] == ';')
+		return false;
+
+	return std::count(p_attributeLine.begin(), p_attributeLine.end(), '=') == 1;
+}
+
+bool GyvrIni::Core::IniFile::StringToBoolean(const std::string& p_value) const
+{
+	return p_value == "1" || p_value == "T" || p_value == "t" || p_value == "True" || p_value == "true" || p_value == "TRUE";
+}
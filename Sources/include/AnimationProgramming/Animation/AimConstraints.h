@@ -0,0 +1,142 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _AIMCONSTRAINTS_H
+#define _AIMCONSTRAINTS_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "AnimationProgramming/Data/Transform.h"
+#include "AnimationProgramming/Rig/SkeletonDefinition.h"
+#include "AnimationProgramming/Tools/ThreadPool.h"
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* Look-at (Head, eyes) and aim (Weapon) constraints applied on top of the sampled poses, before the hierarchy is updated.
+	* A constraint turns an axis of the last bone of a chain (spine_02, neck_01, head for example) toward a target, within an angle limit :
+	* each bone of the chain takes its share of the rotation (The falloff), the last one takes what remains. The constraints are declared once
+	* per skeleton and compiled into index arrays, then the poses of many characters are constrained at once, LaneWidth characters at a time
+	*/
+	class AimConstraints final
+	{
+	public:
+		/* Number of characters constrained at once */
+		static constexpr uint32_t LaneWidth = 8;
+
+		/**
+		* Target of a constraint for a character, in its model space (A weight of 0 disables the constraint)
+		*/
+		struct Target
+		{
+			AltMath::Vector3f position;
+			float weight;
+		};
+
+		/**
+		* Create the constraints of the given skeleton definition (Shared : it must outlive the constraints)
+		* @param p_definition
+		*/
+		AimConstraints(const Rig::SkeletonDefinition& p_definition);
+
+		/**
+		* Declare a look-at : the given axis of the last bone of the chain (In its space) points at the target.
+		* Return the index of the constraint, or UINT32_MAX if a bone of the chain isn't below the previous one
+		* @param p_chain (From the first bone turned to the bone looking at the target)
+		* @param p_axis
+		* @param p_maxAngle (In radians)
+		* @param p_falloff (Share of the rotation of each bone but the last, even shares if empty)
+		*/
+		uint32_t AddLookAt(const std::vector<uint32_t>& p_chain, const AltMath::Vector3f& p_axis, float p_maxAngle, const std::vector<float>& p_falloff = {});
+
+		/**
+		* Declare an aim : the given axis, going through the given point (The muzzle of a weapon held by the last bone of the chain, in its space),
+		* points at the target. Return the index of the constraint, or UINT32_MAX if a bone of the chain isn't below the previous one
+		* @param p_chain (From the first bone turned to the bone holding the weapon)
+		* @param p_offset
+		* @param p_axis
+		* @param p_maxAngle (In radians)
+		* @param p_falloff (Share of the rotation of each bone but the last, even shares if empty)
+		*/
+		uint32_t AddAim(const std::vector<uint32_t>& p_chain, const AltMath::Vector3f& p_offset, const AltMath::Vector3f& p_axis, float p_maxAngle, const std::vector<float>& p_falloff = {});
+
+		/**
+		* Return the number of constraints
+		*/
+		uint32_t GetConstraintCount() const;
+
+		/**
+		* Apply every constraint, one after the other, to the given poses
+		* @param p_poses (One pose per character)
+		* @param p_targets (The target of the constraint c for the character i is at [i * GetConstraintCount() + c])
+		* @param p_threadPool (Optional, the groups of characters are constrained in parallel if provided)
+		*/
+		void Apply(const std::vector<std::vector<Data::Transformation>*>& p_poses, const std::vector<Target>& p_targets, Tools::ThreadPool* p_threadPool = nullptr) const;
+
+	private:
+		/**
+		* A compiled constraint. Its path goes from the root of the skeleton to the last bone of its chain : the bone of the entry i is the parent of the bone of the entry i + 1
+		*/
+		struct Constraint
+		{
+			uint32_t firstEntry;
+			uint32_t entryCount;
+
+			/* First entry of the path turned by the constraint */
+			uint32_t chainStart;
+
+			AltMath::Vector3f offset;
+			AltMath::Vector3f axis;
+			float maxAngleCos;
+			float maxAngleSin;
+		};
+
+		/**
+		* A transformation for every lane of a group (Component c of the lane l is at [c * LaneWidth + l])
+		*/
+		struct alignas(32) TransformLanes
+		{
+			float position[3 * LaneWidth];
+			float rotation[4 * LaneWidth];
+		};
+
+		/**
+		* Compile the given chain into a constraint. Return its index, or UINT32_MAX if a bone of the chain isn't below the previous one
+		* @param p_chain
+		* @param p_offset
+		* @param p_axis
+		* @param p_maxAngle
+		* @param p_falloff
+		*/
+		uint32_t AddConstraint(const std::vector<uint32_t>& p_chain, const AltMath::Vector3f& p_offset, const AltMath::Vector3f& p_axis, float p_maxAngle, const std::vector<float>& p_falloff);
+
+		/**
+		* Apply the given constraint to one group of characters
+		* @param p_constraintIndex
+		* @param p_poses
+		* @param p_targets
+		* @param p_group
+		* @param p_locals (Scratch memory, one entry per entry of the path)
+		* @param p_worlds (Scratch memory, one entry per entry of the path)
+		*/
+		void ApplyGroup(uint32_t p_constraintIndex, const std::vector<std::vector<Data::Transformation>*>& p_poses, const std::vector<Target>& p_targets, uint32_t p_group, std::vector<TransformLanes>& p_locals, std::vector<TransformLanes>& p_worlds) const;
+
+	private:
+		/* Hierarchy and bind pose of the bones (Local), read from the shared skeleton definition */
+		const std::vector<int32_t>& m_parents;
+		const std::vector<Data::Transformation>& m_bindPose;
+
+		std::vector<Constraint> m_constraints;
+
+		/* Paths of every constraint : bone, and share of the rotation (0 for the bones of the path outside of the chain) */
+		std::vector<uint32_t> m_entryBones;
+		std::vector<float> m_entryShares;
+	};
+}
+
+#endif // _AIMCONSTRAINTS_H
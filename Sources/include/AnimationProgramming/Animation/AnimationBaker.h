@@ -0,0 +1,52 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _ANIMATIONBAKER_H
+#define _ANIMATIONBAKER_H
+
+#include <vector>
+
+#include "AnimationProgramming/Animation/AnimationInstance.h"
+#include "AnimationProgramming/Animation/BakedAnimation.h"
+#include "AnimationProgramming/Rig/SkeletonDefinition.h"
+#include "AnimationProgramming/Tools/ThreadPool.h"
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* Precalculate the skinning palettes of animations at a fixed sample rate, for crowds playing the same clips.
+	* The timeline effectors and the transitions aren't baked : only the settings of the animation instance are used
+	*/
+	class AnimationBaker final
+	{
+	public:
+		/* Prevent this static class from being instancied */
+		AnimationBaker() = delete;
+
+		/**
+		* Bake the given animation for the given skeleton definition
+		* @param p_definition
+		* @param p_animation
+		* @param p_sampleRate (Frames per second)
+		* @param p_precision
+		* @param p_threadPool (Optional, the frames are baked in parallel if provided)
+		*/
+		static BakedAnimation Bake(const Rig::SkeletonDefinition& p_definition, const AnimationInstance& p_animation, float p_sampleRate, EBakedPrecision p_precision = EBakedPrecision::FULL, Tools::ThreadPool* p_threadPool = nullptr);
+
+		/**
+		* Bake every given animation for the given skeleton definition (The frames of every animation are baked in parallel if a thread pool is provided)
+		* @param p_definition
+		* @param p_animations
+		* @param p_sampleRate (Frames per second)
+		* @param p_precision
+		* @param p_threadPool (Optional)
+		*/
+		static std::vector<BakedAnimation> Bake(const Rig::SkeletonDefinition& p_definition, const std::vector<const AnimationInstance*>& p_animations, float p_sampleRate, EBakedPrecision p_precision = EBakedPrecision::FULL, Tools::ThreadPool* p_threadPool = nullptr);
+	};
+}
+
+#endif // _ANIMATIONBAKER_H
@@ -8,6 +8,7 @@
 #ifndef _ANIMATIONINFO_H
 #define _ANIMATIONINFO_H
 
+#include <string>
 #include <vector>
 
 #include <AltMath/AltMath.h>
@@ -49,6 +50,19 @@ namespace AnimationProgramming::Animation
 		*/
 		Data::Transformation GetBoneTransformations(uint32_t p_boneID, uint32_t p_keyFrame) const;
 
+		/**
+		* Load the IK bones of the animation (Only needed by LimbIK : the IK bones aren't loaded by default). The IK bones of a custom animation stay at their bind pose
+		*/
+		void LoadIKBoneTransformations();
+
+		/**
+		* Return a position and a rotation about the given IK bone (Counted from the first IK bone of the engine skeleton) for the given key frame.
+		* LoadIKBoneTransformations must be called before
+		* @param p_ikBoneID
+		* @param p_keyFrame
+		*/
+		Data::Transformation GetIKBoneTransformations(uint32_t p_ikBoneID, uint32_t p_keyFrame) const;
+
 		/**
 		* Return the start key of the animation
 		* @param p_excludeZero
@@ -79,12 +93,20 @@ namespace AnimationProgramming::Animation
 		*/
 		uint32_t GetBonesCount() const;
 
+		/**
+		* Return the number of IK bones of the skeleton binded to the animation (0 until LoadIKBoneTransformations is called)
+		*/
+		uint32_t GetIKBonesCount() const;
+
 	private:
+		std::string m_animationName;
 		uint32_t m_bonesCount	= 0;
+		uint32_t m_ikBonesCount	= 0;
 		uint32_t m_keyCount		= 0;
 		uint32_t m_startKey		= 0;
 		uint32_t m_endKey		= 0;
 		std::vector<std::vector<Data::Transformation>> m_animationTransformations;
+		std::vector<std::vector<Data::Transformation>> m_ikTransformations;
 	};
 }
 
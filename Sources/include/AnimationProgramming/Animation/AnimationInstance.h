@@ -8,6 +8,8 @@
 #ifndef _ANIMATIONINSTANCE_H
 #define _ANIMATIONINSTANCE_H
 
+#include <vector>
+
 #include "AnimationProgramming/Animation/AnimationInfo.h"
 
 namespace AnimationProgramming::Animation
@@ -23,6 +25,40 @@ namespace AnimationProgramming::Animation
 		*/
 		AnimationInstance(const Animation::AnimationInfo& p_animationInfo);
 
+		/**
+		* Return the number of keys played (From the start key to the end key)
+		*/
+		uint32_t GetKeyCount() const;
+
+		/**
+		* Return the duration of the animation in seconds, without the speed coefficient
+		* (A looping animation also interpolates from its last key to its first key)
+		*/
+		float GetDuration() const;
+
+		/**
+		* Return the time at which the given key (Counted from the start key) is played, in the playing direction
+		* @param p_key
+		*/
+		float GetKeyTime(uint32_t p_key) const;
+
+		/**
+		* Find the keys to interpolate, and the interpolation alpha, at the given time of the animation.
+		* The time is wrapped if the animation loops and clamped otherwise. A reversed animation starts from its last key
+		* @param p_time
+		* @param p_currentKey
+		* @param p_nextKey
+		* @param p_alpha
+		*/
+		void SampleKeyFrames(float p_time, uint32_t& p_currentKey, uint32_t& p_nextKey, float& p_alpha) const;
+
+		/**
+		* Store the interpolated pose of the animation at the given time into p_pose (One transformation per bone, relative to the bind pose)
+		* @param p_time
+		* @param p_pose
+		*/
+		void SamplePose(float p_time, std::vector<Data::Transformation>& p_pose) const;
+
 		/* The attached animation (AnimationInfo). Cannot be changed after creation */
 		const Animation::AnimationInfo& attachedAnimation;
 
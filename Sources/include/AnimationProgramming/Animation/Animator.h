@@ -8,11 +8,32 @@
 #ifndef _ANIMATOR_H
 #define _ANIMATOR_H
 
+#include <memory>
+#include <optional>
 #include <string>
 
 #include "AnimationProgramming/Animation/Timeline.h"
+#include "AnimationProgramming/Animation/AimConstraints.h"
 #include "AnimationProgramming/Animation/AnimationInstance.h"
+#include "AnimationProgramming/Animation/BakedAnimation.h"
+#include "AnimationProgramming/Animation/ChainIK.h"
+#include "AnimationProgramming/Animation/ESkinningPaletteFormat.h"
+#include "AnimationProgramming/Animation/ETransitionMode.h"
+#include "AnimationProgramming/Animation/FootPlanting.h"
+#include "AnimationProgramming/Animation/IGroundProvider.h"
+#include "AnimationProgramming/Animation/Inertializer.h"
+#include "AnimationProgramming/Animation/IPoseSource.h"
+#include "AnimationProgramming/Animation/LimbIK.h"
+#include "AnimationProgramming/Animation/PoseCache.h"
+#include "AnimationProgramming/Animation/SpringBones.h"
+#include "AnimationProgramming/Animation/TransitionIndex.h"
+#include "AnimationProgramming/Animation/TransitionStack.h"
+#include "AnimationProgramming/Data/DualQuaternion.h"
 #include "AnimationProgramming/Rig/Skeleton.h"
+#include "AnimationProgramming/Rig/SkeletonDefinition.h"
+#include "AnimationProgramming/Rig/SkeletonInstance.h"
+#include "AnimationProgramming/Tools/FixedTimestep.h"
+#include "AnimationProgramming/Tools/Snapshot.h"
 
 namespace AnimationProgramming::Animation
 {
@@ -23,11 +44,20 @@ namespace AnimationProgramming::Animation
 	{
 	public:
 		/**
-		* Create the animator reponsible of the animation of the given skeleton
+		* Create the animator reponsible of the animation of the given skeleton. Its definition is shared with the other users of the skeleton
+		* (See Rig::Skeleton::GetDefinition), and requested with the pose buffers the first time the animator needs them : the skeleton must be created before the first animation is played
 		* @param p_skeleton
 		*/
 		Animator(Rig::Skeleton& p_skeleton);
 
+		/**
+		* Create an animator using the given shared definition (The pose is evaluated from the definition only, no skeleton is owned).
+		* The bones of the optional skeleton are updated on demand (See UpdateSkeleton), it must have been created from the same definition
+		* @param p_definition
+		* @param p_skeleton
+		*/
+		Animator(std::shared_ptr<const Rig::SkeletonDefinition> p_definition, Rig::Skeleton* p_skeleton = nullptr);
+
 		/**
 		* Return true if there is a binded animation
 		*/
@@ -50,23 +80,161 @@ namespace AnimationProgramming::Animation
 		void SetGlobalSpeedCoefficient(float p_coefficient);
 
 		/**
-		* Play the given animation from the key 0 to the last key
+		* Return the format of the skinning palette sent to the GPU
+		*/
+		ESkinningPaletteFormat GetSkinningPaletteFormat() const;
+
+		/**
+		* Set the format of the skinning palette sent to the GPU (Matrices by default)
+		* @param p_format
+		*/
+		void SetSkinningPaletteFormat(ESkinningPaletteFormat p_format);
+
+		/**
+		* Return the rate of the animation ticks (0 if the animation ticks once per frame)
+		*/
+		float GetTickRate() const;
+
+		/**
+		* Tick the animation at the given fixed rate, whatever the frame rate (0, the default, to tick once per frame).
+		* Update runs zero or more ticks, then sends the palette interpolated between the last two ticks : the animation work
+		* follows the tick rate only, and the same frame times always give the same poses
+		* @param p_tickRate (Ticks per second)
+		*/
+		void SetTickRate(float p_tickRate);
+
+		/**
+		* Return the way transitions between animations are played
+		*/
+		ETransitionMode GetTransitionMode() const;
+
+		/**
+		* Set the way transitions between animations are played (Cross-fade by default)
+		* @param p_mode
+		*/
+		void SetTransitionMode(ETransitionMode p_mode);
+
+		/**
+		* Return the transition stack used by the STACK transition mode (To change its cap for example)
+		*/
+		TransitionStack& GetTransitionStack();
+
+		/**
+		* Enter the played animations at the key the closest to the current pose, found in the given index (nullptr to enter them at their first key).
+		* Only the animations of the index are concerned
+		* @param p_transitionIndex
+		*/
+		void SetTransitionIndex(const TransitionIndex* p_transitionIndex);
+
+		/**
+		* Share the pose evaluation with the other animators using the given cache (nullptr to stop using it).
+		* Only the animators sharing the same skeleton definition share their poses.
+		* Transitions (Cross-fades, inertializations and transition stacks) are never shared, since they start from the previous pose of each animator
+		* @param p_poseCache
+		*/
+		void SetPoseCache(PoseCache* p_poseCache);
+
+		/**
+		* Apply the given limb IK to the pose of every frame, after the sampling and the transitions (nullptr to stop using it).
+		* The IK bones of the played animation are the default targets of the limbs. The pose cache isn't used while a limb IK is set,
+		* since the pose of each character is modified
+		* @param p_limbIK
+		*/
+		void SetLimbIK(LimbIK* p_limbIK);
+
+		/**
+		* Apply the given chain IK to the pose of every frame, before the limb IK (nullptr to stop using it).
+		* The pose cache isn't used while a chain IK is set, since the pose of each character is modified
+		* @param p_chainIK
+		*/
+		void SetChainIK(ChainIK* p_chainIK);
+
+		/**
+		* Apply the given look-at and aim constraints to the pose of every frame, after the chain IK and before the foot planting (nullptr to stop using them).
+		* Every target starts with a weight of 0. The pose cache isn't used while constraints are set
+		* @param p_aimConstraints
+		*/
+		void SetAimConstraints(const AimConstraints* p_aimConstraints);
+
+		/**
+		* Set the target of the given constraint, in model space
+		* @param p_constraint
+		* @param p_position
+		* @param p_weight
+		*/
+		void SetAimTarget(uint32_t p_constraint, const AltMath::Vector3f& p_position, float p_weight = 1.0f);
+
+		/**
+		* Adapt the pose of every frame to the given ground, after the chain IK and before the limb IK (nullptr to stop using it).
+		* The foot contacts are read from the contact tracks of the foot planting. The pose cache isn't used while a foot planting is set
+		* @param p_footPlanting
+		* @param p_ground
+		*/
+		void SetFootPlanting(FootPlanting* p_footPlanting, const IGroundProvider* p_ground);
+
+		/**
+		* Apply the given spring bones to the pose of every frame, after every IK (nullptr to stop using them).
+		* The pose cache isn't used while spring bones are set, since the pose of each character is modified
+		* @param p_springBones
+		*/
+		void SetSpringBones(SpringBones* p_springBones);
+
+		/**
+		* Play the given animation from the key 0 to the last key (Or from the best entry key of the transition index, if any)
 		* @param p_toPlay
 		*/
 		void PlayAnimation(Animation::AnimationInstance& p_toPlay);
 
+		/**
+		* Play the given baked animation from its first frame (Without transition). The skinning palette is read from the baked
+		* animation instead of being calculated : the skeleton isn't updated and the palette is always sent as matrices
+		* @param p_toPlay
+		*/
+		void PlayBakedAnimation(const BakedAnimation& p_toPlay);
+
+		/**
+		* Return true if the animator is playing a baked animation
+		*/
+		bool IsPlayingBakedAnimation() const;
+
+		/**
+		* Play the given pose source (A sync group or a blend space player : it is updated by the animator, its parameters can be changed at any time).
+		* The timeline isn't used. The transition from the current pose is always an inertialization, since the source doesn't start from a first key
+		* @param p_toPlay
+		* @param p_transitionDuration
+		*/
+		void PlayPoseSource(IPoseSource& p_toPlay, float p_transitionDuration = 0.0f);
+
+		/**
+		* Add a pose source to the animator without playing it, and return its index (PlayPoseSource adds the pose sources it plays).
+		* The snapshots refer to the pose sources by this index : the animator restoring a snapshot must have the same pose sources added in the same order
+		* @param p_poseSource (Must outlive the animator)
+		*/
+		uint32_t AddPoseSource(IPoseSource& p_poseSource);
+
+		/**
+		* Return true if the animator is playing a pose source
+		*/
+		bool IsPlayingPoseSource() const;
+
 		/**
 		* Stop the current animation and return in T-Pose
 		*/
 		void StopAnimation();
 
 		/**
-		* If there is an animation, the timeline is updated and the animation is applied to the skeleton
-		* and the actual pose is send to GPU
+		* If there is an animation, the timeline is updated, the local pose is evaluated and the actual palette is send to GPU.
+		* The bones of the skeleton aren't updated : call UpdateSkeleton before reading them (Debug drawing for example)
 		* @param p_deltaTime
 		*/
 		void Update(float p_deltaTime);
 
+		/**
+		* Same as Update, without sending the pose to the GPU (The engine isn't thread-safe, so this is what worker threads should call)
+		* @param p_deltaTime
+		*/
+		void UpdatePose(float p_deltaTime);
+
 		/**
 		* Update the new start and end transformations for each bones to the current and next frame (Needed for interpolation)
 		*/
@@ -92,27 +260,192 @@ namespace AnimationProgramming::Animation
 		void ApplyAnimationToSkeleton();
 
 		/**
-		* Apply the bind pose (Or T-Pose) to the skeleton
+		* Calculate the local pose (Relative to the bind pose) of the current animation frame, without applying it to the skeleton
+		* @param p_alpha
+		*/
+		void EvaluateLocalPose(float p_alpha);
+
+		/**
+		* Apply the last evaluated local pose to the skeleton
+		*/
+		void ApplyLocalPoseToSkeleton();
+
+		/**
+		* Apply the bind pose (Or T-Pose) to the local pose and to the skeleton
 		*/
 		void ApplyBindPoseToSkeleton();
 
 		/**
-		* Send every matrices needed for hardware skinning to the GPU
+		* Apply the last evaluated local pose to the skeleton if it changed since the last time the bones were updated.
+		* Does nothing if the skeleton is up to date, or if the animator has no skeleton
+		*/
+		void UpdateSkeleton();
+
+		/**
+		* Return true if the bones of the skeleton don't match the last evaluated local pose (See UpdateSkeleton)
+		*/
+		bool IsSkeletonOutdated() const;
+
+		/**
+		* Send every matrices (Or dual quaternions, depending on the palette format) needed for hardware skinning to the GPU
 		*/
 		void SendSkinningMatricesToGPU();
 
+		/**
+		* Calculate the skinning palette of the last evaluated local pose, in the current palette format
+		*/
+		void CalculateSkinningPalette();
+
+		/**
+		* Send the last calculated skinning palette to the GPU
+		*/
+		void UploadSkinningPalette();
+
+		/**
+		* Send the palette interpolated between the previous tick and the last one to the GPU. The local poses of the two ticks are
+		* interpolated, then the palette is calculated from the result (Baked animations only have palettes : their rigid parts are interpolated)
+		* @param p_alpha
+		*/
+		void UploadInterpolatedSkinningPalette(float p_alpha);
+
+		/**
+		* Return the skinning matrices of the last calculated palette (One per non-IK bone).
+		* Can be used to skin a mesh on the CPU (See Skinning::CPUSkinning)
+		*/
+		const std::vector<Data::Matrix3x4>& GetSkinningPalette() const;
+
+		/**
+		* Return the skinning dual quaternions of the last calculated palette, if the palette format is DUAL_QUATERNION (One per non-IK bone)
+		*/
+		const std::vector<Data::DualQuaternion>& GetDualQuaternionPalette() const;
+
+		/**
+		* Return the last evaluated local pose (One transformation per bone, relative to the bind pose)
+		*/
+		const std::vector<Data::Transformation>& GetLocalPose() const;
+
+		/**
+		* Append the state of the animator (Timeline, poses, transitions, palettes and tick clock) to the given snapshot, to restore it later (Rollback).
+		* The skeleton isn't saved : its bones are updated from the restored local pose by UpdateSkeleton.
+		* The played animations are saved as handles : they must outlive the snapshot. The played pose source is saved as its index (See AddPoseSource), with the
+		* playback state of every added pose source. The state the linked chain IK, foot planting and spring bones keep between frames (Warm starts, particles)
+		* is saved too : the same ones must be set when the snapshot is restored. The limb IK, the aim constraints, the transition index, the pose cache and
+		* the ground keep nothing between frames (Their inputs are set by the game, the aim targets are saved)
+		* @param p_snapshot
+		*/
+		void SaveSnapshot(Tools::Snapshot& p_snapshot) const;
+
+		/**
+		* Restore the state saved by SaveSnapshot, on this animator or on another animator of the same skeleton definition. No timeline event is triggered
+		* @param p_snapshot
+		*/
+		void RestoreSnapshot(Tools::Snapshot& p_snapshot);
+
+	private:
+		/**
+		* Return the pose buffers of the character, created from the skeleton definition the first time they are needed
+		*/
+		Rig::SkeletonInstance& GetInstance();
+
+		/**
+		* Return the skeleton definition, requested from the skeleton the first time it is needed
+		*/
+		const Rig::SkeletonDefinition& GetDefinition();
+
+		/**
+		* Reuse the pose of the pose cache, or evaluate it and store it in the cache
+		*/
+		void EvaluatePoseFromCache();
+
+		/**
+		* Apply the chain IK, then the aim constraints, then the foot planting, then the limb IK (If any) to the local pose
+		*/
+		void ApplyIK();
+
+		/**
+		* Step the spring bones (If any) and apply them to the local pose
+		* @param p_deltaTime
+		*/
+		void ApplySpringBones(float p_deltaTime);
+
+		/**
+		* Return the timeline effectors as bits (One per ETimelineEffector)
+		*/
+		uint32_t GetEffectorBits() const;
+
+		/**
+		* Calculate the skinning palette as matrices : BoneCurrentWorldMatrix * Inverse(BoneTPoseWorldMatrix)
+		*/
+		void CalculateMatrixPalette();
+
+		/**
+		* Calculate the skinning palette as dual quaternions, directly from the local pose
+		*/
+		void CalculateDualQuaternionPalette();
+
 	private:
 		/* Timeline relatives */
 		Timeline m_timeline;
 
-		/* Linked things */
-		Rig::Skeleton&					m_skeleton;
+		/* Linked things (The skeleton is optional) */
+		Rig::Skeleton*					m_skeleton = nullptr;
 		Animation::AnimationInstance*	m_currentAnimation = nullptr;
 
 		/* Current and next key frame transformations (One transformation per bone per frame) */
 		std::vector<Data::Transformation> m_currentKeyFrameTransformations;
 		std::vector<Data::Transformation> m_nextKeyFrameTransformations;
 
+		/* Baked animation playback (Optional) */
+		const BakedAnimation*	m_bakedAnimation = nullptr;
+		float					m_bakedTime = 0.0f;
+
+		/* Pose source playback (Optional), the snapshots refer to the pose sources by their index in m_poseSources */
+		std::vector<IPoseSource*> m_poseSources;
+		IPoseSource* m_poseSource = nullptr;
+		std::vector<Data::Transformation> m_poseSourcePose;
+
+		/* Last evaluated local pose, its model matrices and skinning palettes (The definition is shared between the animators of a crowd, the bones of the skeleton are only updated on demand) */
+		std::optional<Rig::SkeletonInstance> m_instance;
+		bool m_skeletonOutdated = false;
+
+		/* Inertialization (The pose of the previous frame is kept to know the velocity of the bones when a transition starts) */
+		ETransitionMode m_transitionMode = ETransitionMode::CROSSFADE;
+		Inertializer m_inertializer;
+		std::vector<Data::Transformation> m_previousLocalPose;
+		float m_previousDeltaTime = 0.0f;
+
+		/* Overlapping transitions (STACK transition mode only) */
+		TransitionStack m_transitionStack;
+
+		/* Best entry keys between animations (Optional) */
+		const TransitionIndex* m_transitionIndex = nullptr;
+
+		/* Shared pose evaluation (Optional) */
+		PoseCache* m_poseCache = nullptr;
+
+		/* Post-passes on the local pose (Optional) */
+		ChainIK* m_chainIK = nullptr;
+		const AimConstraints* m_aimConstraints = nullptr;
+		std::vector<AimConstraints::Target> m_aimTargets;
+		FootPlanting* m_footPlanting = nullptr;
+		const IGroundProvider* m_ground = nullptr;
+		LimbIK* m_limbIK = nullptr;
+		SpringBones* m_springBones = nullptr;
+
+		/* Format of the skinning palette sent to the GPU */
+		ESkinningPaletteFormat m_skinningPaletteFormat = ESkinningPaletteFormat::MATRIX;
+
+		/* Fixed rate ticks (Optional), pose (Or baked palette) of the previous tick and interpolated results (Kept as members to reuse their memory between frames) */
+		float m_tickRate = 0.0f;
+		Tools::FixedTimestep m_tickClock;
+		std::vector<Data::Transformation> m_previousTickLocalPose;
+		std::vector<Data::Matrix3x4> m_previousTickPalette;
+		std::vector<Data::Transformation> m_interpolatedLocalPose;
+		std::vector<Data::Matrix3x4> m_interpolatedModelMatrices;
+		std::vector<Data::Matrix3x4> m_interpolatedPalette;
+		std::vector<Data::DualQuaternion> m_interpolatedWorldDualQuaternions;
+		std::vector<Data::DualQuaternion> m_interpolatedDualQuaternionPalette;
+
 		/* Other settings */
 		float m_globalSpeedCoefficient = 1.0f;
 	};
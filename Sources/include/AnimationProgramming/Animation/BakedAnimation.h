@@ -0,0 +1,119 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _BAKEDANIMATION_H
+#define _BAKEDANIMATION_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "AnimationProgramming/Animation/EBakedPrecision.h"
+#include "AnimationProgramming/Data/HalfMatrix3x4.h"
+#include "AnimationProgramming/Data/Matrix3x4.h"
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* The skinning palettes of an animation, precalculated at a fixed sample rate (See AnimationBaker).
+	* Playing it back is a table lookup : no interpolation and no hierarchy update
+	*/
+	class BakedAnimation final
+	{
+	public:
+		/**
+		* Create an empty baked animation
+		*/
+		BakedAnimation() = default;
+
+		/**
+		* Create a baked animation with room for the given number of frames (Every palette is identity)
+		* @param p_frameCount
+		* @param p_paletteSize (Number of matrices per frame)
+		* @param p_sampleRate (Frames per second)
+		* @param p_duration (In seconds)
+		* @param p_loop
+		* @param p_speedCoefficient (Applied when playing the baked animation)
+		* @param p_precision
+		*/
+		BakedAnimation(uint32_t p_frameCount, uint32_t p_paletteSize, float p_sampleRate, float p_duration, bool p_loop, float p_speedCoefficient, EBakedPrecision p_precision);
+
+		/**
+		* Return the number of frames
+		*/
+		uint32_t GetFrameCount() const;
+
+		/**
+		* Return the number of matrices per frame
+		*/
+		uint32_t GetPaletteSize() const;
+
+		/**
+		* Return the sample rate (Frames per second)
+		*/
+		float GetSampleRate() const;
+
+		/**
+		* Return the duration in seconds
+		*/
+		float GetDuration() const;
+
+		/**
+		* Return true if the baked animation loops
+		*/
+		bool IsLooping() const;
+
+		/**
+		* Return the speed coefficient of the animation instance that has been baked
+		*/
+		float GetSpeedCoefficient() const;
+
+		/**
+		* Return the precision of the stored palettes
+		*/
+		EBakedPrecision GetPrecision() const;
+
+		/**
+		* Return the size of the stored palettes in bytes
+		*/
+		size_t GetMemorySize() const;
+
+		/**
+		* Return the frame to display at the given time (Nearest frame, wrapped if the animation loops, clamped otherwise)
+		* @param p_time
+		*/
+		uint32_t GetFrameIndex(float p_time) const;
+
+		/**
+		* Store the palette of the given frame (Different frames can be written from different threads)
+		* @param p_frame
+		* @param p_palette
+		*/
+		void SetFramePalette(uint32_t p_frame, const std::vector<Data::Matrix3x4>& p_palette);
+
+		/**
+		* Copy the palette of the given frame into p_palette (Resized to the palette size)
+		* @param p_frame
+		* @param p_palette
+		*/
+		void ReadFramePalette(uint32_t p_frame, std::vector<Data::Matrix3x4>& p_palette) const;
+
+	private:
+		uint32_t m_frameCount = 0;
+		uint32_t m_paletteSize = 0;
+		float m_sampleRate = 0.0f;
+		float m_duration = 0.0f;
+		bool m_loop = false;
+		float m_speedCoefficient = 1.0f;
+		EBakedPrecision m_precision = EBakedPrecision::FULL;
+
+		/* Frame after frame, only one of them is used depending on the precision */
+		std::vector<Data::Matrix3x4> m_palettes;
+		std::vector<Data::HalfMatrix3x4> m_halfPalettes;
+	};
+}
+
+#endif // _BAKEDANIMATION_H
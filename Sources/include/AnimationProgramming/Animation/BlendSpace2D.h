@@ -0,0 +1,141 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _BLENDSPACE2D_H
+#define _BLENDSPACE2D_H
+
+#include <stdint.h>
+#include <vector>
+
+#include <AltMath/AltMath.h>
+
+#include "AnimationProgramming/Animation/AnimationInstance.h"
+#include "AnimationProgramming/Animation/SyncMarkerTrack.h"
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* A 2D blend space asset : animations placed at points of a 2D parameter space (Speed and direction for example).
+	* The points are triangulated (Delaunay) when the blend space is built, and the triangles are sorted into a uniform grid,
+	* so that finding the (At most three) animations to blend and their barycentric weights only tests the few triangles of one cell,
+	* whatever the number of samples. Positions are clamped into the bounding box of the samples (Like the axis ranges of the blend space),
+	* then, outside of the triangulation, the closest point of the triangulation is used.
+	* The blend space is shared by every character : the playback state is held by a BlendSpacePlayer
+	*/
+	class BlendSpace2D final
+	{
+	public:
+		/* Maximum number of animations blended together (The vertices of a triangle) */
+		static constexpr uint32_t MaxBlendedSamples = 3;
+
+		struct Sample
+		{
+			const AnimationInstance* animation;
+			const SyncMarkerTrack* markers;
+			AltMath::Vector2f position;
+		};
+
+		/**
+		* The samples to blend at a position of the blend space, and their weights (Which sum to 1)
+		*/
+		struct Weights
+		{
+			uint32_t count = 0;
+			uint32_t samples[MaxBlendedSamples] = {};
+			float weights[MaxBlendedSamples] = {};
+		};
+
+		/**
+		* Add a sample to the blend space and return its index (The blend space must be built again before being used)
+		* @param p_animation
+		* @param p_position
+		* @param p_markers (Optional, keeps the feet of the samples in lockstep instead of their normalized time)
+		*/
+		uint32_t AddSample(const AnimationInstance& p_animation, const AltMath::Vector2f& p_position, const SyncMarkerTrack* p_markers = nullptr);
+
+		/**
+		* Triangulate the samples and build the lookup grid. Must be called once every sample is added
+		*/
+		void Build();
+
+		/**
+		* Return the number of samples
+		*/
+		uint32_t GetSampleCount() const;
+
+		/**
+		* Return the given sample
+		* @param p_index
+		*/
+		const Sample& GetSample(uint32_t p_index) const;
+
+		/**
+		* Return the number of triangles of the triangulation (0 if the samples are aligned : they are blended along their line)
+		*/
+		uint32_t GetTriangleCount() const;
+
+		/**
+		* Find the samples to blend at the given position, and their weights (None if the blend space isn't built since its last sample)
+		* @param p_position
+		* @param p_weights
+		*/
+		void FindWeights(const AltMath::Vector2f& p_position, Weights& p_weights) const;
+
+	private:
+		struct Triangle
+		{
+			uint32_t vertices[3];
+		};
+
+		/**
+		* Bowyer-Watson triangulation of the samples
+		*/
+		void Triangulate();
+
+		/**
+		* Sort the triangles into the cells of the lookup grid
+		*/
+		void BuildGrid();
+
+		/**
+		* Find the weights when there is no triangle (Every sample is on the same line)
+		* @param p_position
+		* @param p_weights
+		*/
+		void FindLineWeights(const AltMath::Vector2f& p_position, Weights& p_weights) const;
+
+		/**
+		* Return the squared distance between the given point and triangle, and store the barycentric coordinates of the closest point of the triangle
+		* @param p_point
+		* @param p_triangle
+		* @param p_barycentric
+		*/
+		float CalculateClosestPoint(const AltMath::Vector2f& p_point, const Triangle& p_triangle, float p_barycentric[3]) const;
+
+	private:
+		std::vector<Sample> m_samples;
+		std::vector<Triangle> m_triangles;
+
+		/* Lookup grid : the triangles that can contain (Or be the closest to) the points of the cell i are m_cellTriangles[m_cellStarts[i], m_cellStarts[i + 1]] */
+		AltMath::Vector2f m_gridMin;
+		AltMath::Vector2f m_gridMax;
+		AltMath::Vector2f m_cellSize;
+		uint32_t m_cellsPerAxis = 0;
+		std::vector<uint32_t> m_cellStarts;
+		std::vector<uint32_t> m_cellTriangles;
+
+		/* Aligned samples : sorted by their position along the line */
+		AltMath::Vector2f m_lineOrigin;
+		AltMath::Vector2f m_lineDirection;
+		std::vector<uint32_t> m_lineOrder;
+		std::vector<float> m_lineProjections;
+
+		bool m_built = false;
+	};
+}
+
+#endif // _BLENDSPACE2D_H
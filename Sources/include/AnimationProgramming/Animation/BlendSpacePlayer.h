@@ -0,0 +1,101 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _BLENDSPACEPLAYER_H
+#define _BLENDSPACEPLAYER_H
+
+#include <vector>
+
+#include "AnimationProgramming/Animation/BlendSpace2D.h"
+#include "AnimationProgramming/Animation/IPoseSource.h"
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* The playback state of a 2D blend space for one character. The blended samples share a normalized phase (Mapped through their markers
+	* if they have some), which advances with their weighted cycle durations. Only the (At most three) blended samples are sampled,
+	* into the same pose buffers every frame
+	*/
+	class BlendSpacePlayer final : public IPoseSource
+	{
+	public:
+		/**
+		* Create a player of the given blend space (Which must be built, and must outlive the player)
+		* @param p_blendSpace
+		*/
+		BlendSpacePlayer(const BlendSpace2D& p_blendSpace);
+
+		/**
+		* Return the position of the player in the blend space
+		*/
+		const AltMath::Vector2f& GetPosition() const;
+
+		/**
+		* Set the position of the player in the blend space, and find the samples to blend
+		* @param p_position
+		*/
+		void SetPosition(const AltMath::Vector2f& p_position);
+
+		/**
+		* Return the samples blended at the current position, and their weights
+		*/
+		const BlendSpace2D::Weights& GetWeights() const;
+
+		/**
+		* Return the normalized phase of the player, in [0, 1[
+		*/
+		float GetPhase() const;
+
+		/**
+		* Set the normalized phase of the player (Wrapped into [0, 1[)
+		* @param p_phase
+		*/
+		void SetPhase(float p_phase);
+
+		/**
+		* Advance the phase with the cycle durations of the blended samples, weighted by their weights (And their speed coefficients)
+		* @param p_deltaTime
+		*/
+		virtual void Update(float p_deltaTime) override;
+
+		/**
+		* Store the blended pose at the current position and phase into p_pose (One transformation per bone, relative to the bind pose)
+		* @param p_pose
+		*/
+		virtual void Evaluate(std::vector<Data::Transformation>& p_pose) override;
+
+		/**
+		* Append the position and the phase of the player to the given snapshot
+		* @param p_snapshot
+		*/
+		virtual void SaveSnapshot(Tools::Snapshot& p_snapshot) const override;
+
+		/**
+		* Restore the position and the phase saved by SaveSnapshot (The weights are found again from the position)
+		* @param p_snapshot
+		*/
+		virtual void RestoreSnapshot(Tools::Snapshot& p_snapshot) override;
+
+	private:
+		/**
+		* Return the time of the given sample at the current phase
+		* @param p_sample
+		*/
+		float CalculateSampleTime(const BlendSpace2D::Sample& p_sample) const;
+
+	private:
+		const BlendSpace2D& m_blendSpace;
+		AltMath::Vector2f m_position;
+		BlendSpace2D::Weights m_weights;
+		float m_phase = 0.0f;
+
+		/* Scratch pose of the blended samples (Kept as a member to reuse its memory between frames) */
+		std::vector<Data::Transformation> m_samplePose;
+	};
+}
+
+#endif // _BLENDSPACEPLAYER_H
@@ -0,0 +1,191 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _CHAINIK_H
+#define _CHAINIK_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "AnimationProgramming/Data/Transform.h"
+#include "AnimationProgramming/Rig/SkeletonDefinition.h"
+#include "AnimationProgramming/Tools/Snapshot.h"
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* Iterative IK of chains of any length (Spines, tails, arms...) of one character, applied as a post-pass on its sampled pose.
+	* The joint positions of every chain are extracted into flat arrays, solved with FABRIK or CCD, then written back as local rotations
+	* before the hierarchy is updated. Each chain has its own budget (Iterations and tolerance) so that its cost is bounded,
+	* can start from its previous solution (Warm start) and can limit the angle of its joints
+	*/
+	class ChainIK final
+	{
+	public:
+		/**
+		* Algorithm used to solve a chain
+		*/
+		enum class EMethod
+		{
+			FABRIK,
+			CCD
+		};
+
+		/**
+		* A chain of bones (Each bone is the parent of the next one), from its root to its end
+		*/
+		struct Chain
+		{
+			EMethod method;
+
+			/* Joints of the chain in the flat arrays : [firstJoint, firstJoint + jointCount), from the root to the end */
+			uint32_t firstJoint;
+			uint32_t jointCount;
+
+			/* Budget of a solve : the iterations stop once the end is closer to the target than the tolerance */
+			uint32_t maxIterations;
+			float tolerance;
+
+			/* Target in model space */
+			AltMath::Vector3f target;
+			float weight;
+			bool hasTarget;
+
+			/* The previous solution is the first guess of the next solve */
+			bool warmStart;
+			bool hasPreviousSolution;
+
+			/* Iterations done and distance left between the end and the target, by the last solve */
+			uint32_t lastIterationCount;
+			float lastError;
+		};
+
+		/**
+		* Create the chain IK of the given skeleton definition (Shared : it must outlive the chain IK)
+		* @param p_definition
+		*/
+		ChainIK(const Rig::SkeletonDefinition& p_definition);
+
+		/**
+		* Add the chain going from p_root down to p_end. Return the index of the chain, or UINT32_MAX if p_end isn't below p_root
+		* @param p_root
+		* @param p_end
+		* @param p_method
+		* @param p_maxIterations
+		* @param p_tolerance
+		*/
+		uint32_t AddChain(uint32_t p_root, uint32_t p_end, EMethod p_method = EMethod::FABRIK, uint32_t p_maxIterations = 10, float p_tolerance = 0.1f);
+
+		/**
+		* Return the number of chains
+		*/
+		uint32_t GetChainCount() const;
+
+		/**
+		* Return the given chain
+		* @param p_chain
+		*/
+		const Chain& GetChain(uint32_t p_chain) const;
+
+		/**
+		* Return the bone of the given joint of a chain (The joint 0 is the root of the chain)
+		* @param p_chain
+		* @param p_joint
+		*/
+		uint32_t GetChainBone(uint32_t p_chain, uint32_t p_joint) const;
+
+		/**
+		* Start each solve of the given chain from its previous solution (true) or from the sampled pose (false, the default)
+		* @param p_chain
+		* @param p_warmStart
+		*/
+		void SetWarmStart(uint32_t p_chain, bool p_warmStart);
+
+		/**
+		* Limit the angle between the bone entering the given joint of a chain and the bone leaving it (In radians, PI for no limit).
+		* The root and the end of a chain have no limit
+		* @param p_chain
+		* @param p_joint
+		* @param p_maxAngle
+		*/
+		void SetJointLimit(uint32_t p_chain, uint32_t p_joint, float p_maxAngle);
+
+		/**
+		* Set the target of the given chain, in model space
+		* @param p_chain
+		* @param p_target
+		* @param p_weight
+		*/
+		void SetTarget(uint32_t p_chain, const AltMath::Vector3f& p_target, float p_weight = 1.0f);
+
+		/**
+		* Remove the target of the given chain (It keeps its sampled pose, and forgets its previous solution)
+		* @param p_chain
+		*/
+		void ClearTarget(uint32_t p_chain);
+
+		/**
+		* Solve the chains of the given pose
+		* @param p_pose
+		*/
+		void Solve(std::vector<Data::Transformation>& p_pose);
+
+		/**
+		* Append the targets and the previous solutions (Warm start) of every chain to the given snapshot. The chains and their settings aren't saved
+		* @param p_snapshot
+		*/
+		void SaveSnapshot(Tools::Snapshot& p_snapshot) const;
+
+		/**
+		* Restore the state saved by SaveSnapshot (On a chain IK with the same chains)
+		* @param p_snapshot
+		*/
+		void RestoreSnapshot(Tools::Snapshot& p_snapshot);
+
+	private:
+		/**
+		* Run the iterations of FABRIK on the joint positions of the given chain. Return the number of iterations done
+		* @param p_chain
+		* @param p_target
+		*/
+		uint32_t SolveFABRIK(Chain& p_chain, const AltMath::Vector3f& p_target);
+
+		/**
+		* Run the iterations of CCD on the joint positions of the given chain. Return the number of iterations done
+		* @param p_chain
+		* @param p_target
+		*/
+		uint32_t SolveCCD(Chain& p_chain, const AltMath::Vector3f& p_target);
+
+		/**
+		* Return the given direction of the bone leaving a joint, limited by the angle of the joint
+		* @param p_joint (In the flat arrays, not the root of its chain)
+		* @param p_direction (Normalized)
+		*/
+		AltMath::Vector3f LimitDirection(uint32_t p_joint, const AltMath::Vector3f& p_direction) const;
+
+	private:
+		/* Shared skeleton definition, with the hierarchy and bind pose of its bones (Local) */
+		const Rig::SkeletonDefinition& m_definition;
+		const std::vector<int32_t>& m_parents;
+		const std::vector<Data::Transformation>& m_bindPose;
+
+		std::vector<Chain> m_chains;
+
+		/* Flat arrays of the joints of every chain : bone, limit of the joint angle, length of the bone leaving the joint */
+		std::vector<uint32_t> m_bones;
+		std::vector<float> m_limitCosines;
+		std::vector<float> m_limitSines;
+		std::vector<float> m_lengths;
+
+		/* Joint positions being solved (Model space) and previous solution (Relative to the root of the chain) */
+		std::vector<AltMath::Vector3f> m_positions;
+		std::vector<AltMath::Vector3f> m_previousPositions;
+	};
+}
+
+#endif // _CHAINIK_H
@@ -0,0 +1,136 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _CROWDEVALUATOR_H
+#define _CROWDEVALUATOR_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "AnimationProgramming/Animation/AnimationInstance.h"
+#include "AnimationProgramming/Data/Matrix3x4.h"
+#include "AnimationProgramming/Rig/SkeletonDefinition.h"
+#include "AnimationProgramming/Tools/ThreadPool.h"
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* Evaluate the skinning palettes of many characters sharing the same skeleton. The characters are grouped by LaneWidth
+	* (One SIMD lane per character), so that the interpolation and the hierarchy update process the same bone of a whole group at once.
+	* Every character plays its own animation at its own time. Timeline effectors and transitions aren't supported : characters that need them
+	* should use an Animator
+	*/
+	class CrowdEvaluator final
+	{
+	public:
+		/* Number of characters evaluated together (One AVX2 register of floats) */
+		static constexpr uint32_t LaneWidth = 8;
+
+		/**
+		* Create a crowd evaluator for characters using the given skeleton definition
+		* @param p_definition
+		*/
+		CrowdEvaluator(const Rig::SkeletonDefinition& p_definition);
+
+		/**
+		* Add a character playing the given animation, and return its index
+		* @param p_animation
+		* @param p_time
+		*/
+		uint32_t AddCharacter(const AnimationInstance& p_animation, float p_time = 0.0f);
+
+		/**
+		* Change the animation played by the given character
+		* @param p_character
+		* @param p_animation
+		* @param p_time
+		*/
+		void SetAnimation(uint32_t p_character, const AnimationInstance& p_animation, float p_time = 0.0f);
+
+		/**
+		* Return the time of the animation played by the given character
+		* @param p_character
+		*/
+		float GetTime(uint32_t p_character) const;
+
+		/**
+		* Set the time of the animation played by the given character
+		* @param p_character
+		* @param p_time
+		*/
+		void SetTime(uint32_t p_character, float p_time);
+
+		/**
+		* Return the number of characters
+		*/
+		uint32_t GetCharacterCount() const;
+
+		/**
+		* Return the number of matrices in the palette of a character (One per non-IK bone)
+		*/
+		uint32_t GetPaletteSize() const;
+
+		/**
+		* Advance the time of every character (Using the speed coefficient of its animation) and evaluate the palettes
+		* @param p_deltaTime
+		* @param p_threadPool (Optional, the groups of characters are evaluated in parallel if provided)
+		*/
+		void Update(float p_deltaTime, Tools::ThreadPool* p_threadPool = nullptr);
+
+		/**
+		* Evaluate the palettes of every character at their current time
+		* @param p_threadPool (Optional, the groups of characters are evaluated in parallel if provided)
+		*/
+		void Evaluate(Tools::ThreadPool* p_threadPool = nullptr);
+
+		/**
+		* Copy the last evaluated palette of the given character into p_palette (Same matrices as Animator::GetSkinningPalette)
+		* @param p_character
+		* @param p_palette
+		*/
+		void ReadPalette(uint32_t p_character, std::vector<Data::Matrix3x4>& p_palette) const;
+
+	private:
+		/**
+		* A 3x4 matrix for every lane of a group : the element i of the lane l is elements[i * LaneWidth + l]
+		*/
+		struct alignas(32) MatrixLanes
+		{
+			float elements[12 * LaneWidth];
+		};
+
+		struct CharacterState
+		{
+			const AnimationInstance* animation;
+			float time;
+		};
+
+		/**
+		* Evaluate the palettes of the given group of characters
+		* @param p_group
+		* @param p_worldMatrices (Scratch memory, one entry per bone)
+		*/
+		void EvaluateGroup(uint32_t p_group, std::vector<MatrixLanes>& p_worldMatrices);
+
+	private:
+		/* Skeleton definition, laid out for the evaluation (Extracted once, the bones are never accessed during the evaluation) */
+		std::vector<int32_t> m_parents;
+		std::vector<int32_t> m_paletteIndices;
+		std::vector<uint32_t> m_order;
+		std::vector<float> m_defaultPositions;
+		std::vector<float> m_defaultRotations;
+		std::vector<Data::Matrix3x4> m_inverseBindPalette;
+		uint32_t m_paletteSize = 0;
+
+		std::vector<CharacterState> m_characters;
+
+		/* Palettes of every group, group after group */
+		std::vector<MatrixLanes> m_palettes;
+	};
+}
+
+#endif // _CROWDEVALUATOR_H
@@ -0,0 +1,23 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _EBAKEDPRECISION_H
+#define _EBAKEDPRECISION_H
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* Precision of the skinning palettes stored in a BakedAnimation
+	*/
+	enum class EBakedPrecision
+	{
+		FULL,
+		HALF
+	};
+}
+
+#endif // _EBAKEDPRECISION_H
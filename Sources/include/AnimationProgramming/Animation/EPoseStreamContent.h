@@ -0,0 +1,24 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _EPOSESTREAMCONTENT_H
+#define _EPOSESTREAMCONTENT_H
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* What a pose stream (PoseStreamWriter) captures for every character : its local pose (A position and a rotation per bone),
+	* or its skinning palette (A matrix per non-IK bone)
+	*/
+	enum class EPoseStreamContent
+	{
+		LOCAL_POSE,
+		SKINNING_PALETTE
+	};
+}
+
+#endif // _EPOSESTREAMCONTENT_H
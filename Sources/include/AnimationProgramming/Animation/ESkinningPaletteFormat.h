@@ -0,0 +1,23 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _ESKINNINGPALETTEFORMAT_H
+#define _ESKINNINGPALETTEFORMAT_H
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* Format of the skinning palette produced by an Animator
+	*/
+	enum class ESkinningPaletteFormat
+	{
+		MATRIX,
+		DUAL_QUATERNION
+	};
+}
+
+#endif // _ESKINNINGPALETTEFORMAT_H
@@ -0,0 +1,29 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _ETRANSITIONMODE_H
+#define _ETRANSITIONMODE_H
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* How an Animator transits from an animation to another
+	*/
+	enum class ETransitionMode
+	{
+		/* The previous pose is frozen and interpolated to the first key of the new animation */
+		CROSSFADE,
+
+		/* The new animation plays immediately, the offset from the previous pose decays over the transition duration */
+		INERTIALIZATION,
+
+		/* Every animation keeps playing while it fades out, transitions can overlap (See TransitionStack) */
+		STACK
+	};
+}
+
+#endif // _ETRANSITIONMODE_H
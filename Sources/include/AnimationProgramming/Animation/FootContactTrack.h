@@ -0,0 +1,92 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _FOOTCONTACTTRACK_H
+#define _FOOTCONTACTTRACK_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "AnimationProgramming/Animation/AnimationInfo.h"
+#include "AnimationProgramming/Animation/AnimationInstance.h"
+#include "AnimationProgramming/Rig/Skeleton.h"
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* The foot contacts of a locomotion animation, precomputed for every key : a foot is down while its height (Along Z, the up axis of the mannequin)
+	* is within a tolerance of its lowest height in the animation. The runtime reads the contact weight of a foot by interpolating two keys
+	*/
+	class FootContactTrack final
+	{
+	public:
+		/* Indices of the feet */
+		static constexpr uint32_t LeftFoot = 0;
+		static constexpr uint32_t RightFoot = 1;
+		static constexpr uint32_t FootCount = 2;
+
+		/* Default height above its lowest height under which a foot is down */
+		static constexpr float DefaultHeightTolerance = 3.0f;
+
+		/**
+		* Detect the contacts of the given feet in every key of the animation. The heights are calculated from the bind pose of the given skeleton
+		* (The skeleton isn't modified)
+		* @param p_skeleton
+		* @param p_animation
+		* @param p_leftFootBone
+		* @param p_rightFootBone
+		* @param p_heightTolerance
+		*/
+		FootContactTrack(Rig::Skeleton& p_skeleton, const AnimationInfo& p_animation, uint32_t p_leftFootBone, uint32_t p_rightFootBone, float p_heightTolerance = DefaultHeightTolerance);
+
+		/**
+		* Return the animation of this track
+		*/
+		const AnimationInfo& GetAnimation() const;
+
+		/**
+		* Return the height of the given foot when it is down (Its lowest height in the animation)
+		* @param p_foot
+		*/
+		float GetContactHeight(uint32_t p_foot) const;
+
+		/**
+		* Return true if the given foot is down at the given key
+		* @param p_foot
+		* @param p_key
+		*/
+		bool IsInContact(uint32_t p_foot, uint32_t p_key) const;
+
+		/**
+		* Return the contact weight of the given foot (0 in the air, 1 down), interpolated between two keys
+		* @param p_foot
+		* @param p_currentKey
+		* @param p_nextKey
+		* @param p_alpha
+		*/
+		float GetContactWeight(uint32_t p_foot, uint32_t p_currentKey, uint32_t p_nextKey, float p_alpha) const;
+
+		/**
+		* Return the contact weight of the given foot at the given time of an instance of the animation
+		* @param p_foot
+		* @param p_instance
+		* @param p_time
+		*/
+		float GetContactWeight(uint32_t p_foot, const AnimationInstance& p_instance, float p_time) const;
+
+	private:
+		const AnimationInfo& m_animation;
+		uint32_t m_keyCount;
+
+		float m_contactHeights[FootCount];
+
+		/* Contact of the foot f at the key k (0 or 1) : [f * m_keyCount + k] */
+		std::vector<float> m_contacts;
+	};
+}
+
+#endif // _FOOTCONTACTTRACK_H
@@ -0,0 +1,155 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _FOOTPLANTING_H
+#define _FOOTPLANTING_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "AnimationProgramming/Animation/FootContactTrack.h"
+#include "AnimationProgramming/Animation/IGroundProvider.h"
+#include "AnimationProgramming/Animation/LimbIK.h"
+#include "AnimationProgramming/Data/Transform.h"
+#include "AnimationProgramming/Rig/SkeletonDefinition.h"
+#include "AnimationProgramming/Tools/Snapshot.h"
+#include "AnimationProgramming/Tools/ThreadPool.h"
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* Adapt the sampled pose of one character to the ground under its feet, as a post-pass. A foot down (Read from the contact track of the played animation)
+	* follows the ground under it, a foot in the air keeps its height relative to the pelvis but stays above the ground. The pelvis is moved
+	* so that the feet down can be reached, then the legs are solved with two-bone IK. The model space is the world space translated by the root position.
+	* The ground heights of many characters are queried in one call : GatherQueries, then IGroundProvider::QueryHeights, then Adjust (SolveCrowd does it for a crowd)
+	*/
+	class FootPlanting final
+	{
+	public:
+		/* Ground heights queried per character (One per foot) */
+		static constexpr uint32_t QueriesPerCharacter = FootContactTrack::FootCount;
+
+		/**
+		* Scratch memory of SolveCrowd (Kept by the caller to reuse its memory between frames)
+		*/
+		struct CrowdScratch
+		{
+			std::vector<AltMath::Vector2f> queries;
+			std::vector<float> heights;
+			std::vector<TwoBoneIKSolver::Request> requests;
+			std::vector<TwoBoneIKSolver::Result> results;
+			std::vector<uint32_t> firstRequests;
+		};
+
+		/**
+		* Create the foot planting of the given skeleton definition (Shared : it must outlive the foot planting). The legs are the feet, their parents and grand-parents
+		* @param p_definition
+		* @param p_pelvisBone
+		* @param p_leftFootBone
+		* @param p_rightFootBone
+		*/
+		FootPlanting(const Rig::SkeletonDefinition& p_definition, uint32_t p_pelvisBone, uint32_t p_leftFootBone, uint32_t p_rightFootBone);
+
+		/**
+		* Return true if the pelvis and both legs were found
+		*/
+		bool IsValid() const;
+
+		/**
+		* Add the contact track of an animation (The track must outlive this foot planting)
+		* @param p_track
+		*/
+		void AddContactTrack(const FootContactTrack& p_track);
+
+		/**
+		* Set the position of the character in the world (The origin of its model space)
+		* @param p_position
+		*/
+		void SetRootPosition(const AltMath::Vector3f& p_position);
+
+		/**
+		* Set the keys of the played animation, to read the foot contacts. Without animation, or without contact track for it, both feet are down
+		* @param p_animation
+		* @param p_currentKey
+		* @param p_nextKey
+		* @param p_alpha
+		*/
+		void SetContacts(const AnimationInfo* p_animation, uint32_t p_currentKey = 0, uint32_t p_nextKey = 0, float p_alpha = 0.0f);
+
+		/**
+		* Append the ground points under the feet of the given pose to p_queries (QueriesPerCharacter points)
+		* @param p_pose
+		* @param p_queries
+		*/
+		void GatherQueries(const std::vector<Data::Transformation>& p_pose, std::vector<AltMath::Vector2f>& p_queries);
+
+		/**
+		* Move the pelvis of the given pose and set the targets of the legs, from the ground heights of the points gathered by GatherQueries.
+		* The legs are solved by the limb IK (See GetLimbIK)
+		* @param p_heights (The first height of this character)
+		* @param p_pose
+		*/
+		void Adjust(const float* p_heights, std::vector<Data::Transformation>& p_pose);
+
+		/**
+		* Return the limb IK of the legs (The left leg is the limb 0, the right leg is the limb 1)
+		*/
+		LimbIK& GetLimbIK();
+
+		/**
+		* Adapt the given pose to the ground (Queries, pelvis and legs of this character only)
+		* @param p_pose
+		* @param p_ground
+		*/
+		void Solve(std::vector<Data::Transformation>& p_pose, const IGroundProvider& p_ground);
+
+		/**
+		* Adapt the poses of a crowd to the ground : one ground query for the whole crowd, and one solve for all the legs
+		* @param p_characters
+		* @param p_poses (One pose per character)
+		* @param p_ground
+		* @param p_scratch
+		* @param p_threadPool (Optional, the legs are solved in parallel if provided)
+		*/
+		static void SolveCrowd(const std::vector<FootPlanting*>& p_characters, const std::vector<std::vector<Data::Transformation>*>& p_poses, const IGroundProvider& p_ground, CrowdScratch& p_scratch, Tools::ThreadPool* p_threadPool = nullptr);
+
+		/**
+		* Append the root position, the contacts and the feet positions of the last gathered pose to the given snapshot
+		* @param p_snapshot
+		*/
+		void SaveSnapshot(Tools::Snapshot& p_snapshot) const;
+
+		/**
+		* Restore the state saved by SaveSnapshot
+		* @param p_snapshot
+		*/
+		void RestoreSnapshot(Tools::Snapshot& p_snapshot);
+
+	private:
+		/* Shared skeleton definition, with the hierarchy of its bones */
+		const Rig::SkeletonDefinition& m_definition;
+		const std::vector<int32_t>& m_parents;
+
+		uint32_t m_pelvis;
+		uint32_t m_feet[FootContactTrack::FootCount];
+		LimbIK m_limbIK;
+
+		std::vector<const FootContactTrack*> m_contactTracks;
+		AltMath::Vector3f m_rootPosition;
+
+		/* Contacts of the played keys, and feet positions (Model space) of the last gathered pose */
+		float m_contactWeights[FootContactTrack::FootCount];
+		float m_contactHeights[FootContactTrack::FootCount];
+		AltMath::Vector3f m_feetPositions[FootContactTrack::FootCount];
+
+		/* Scratch queries and heights of Solve (Kept as members to reuse their memory between frames) */
+		std::vector<AltMath::Vector2f> m_queries;
+		std::vector<float> m_heights;
+	};
+}
+
+#endif // _FOOTPLANTING_H
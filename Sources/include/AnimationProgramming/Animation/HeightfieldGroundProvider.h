@@ -0,0 +1,72 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _HEIGHTFIELDGROUNDPROVIDER_H
+#define _HEIGHTFIELDGROUNDPROVIDER_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "AnimationProgramming/Animation/IGroundProvider.h"
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* Ground defined by a grid of heights, bilinearly interpolated between its samples. Outside of the grid, the height of the nearest border is used
+	*/
+	class HeightfieldGroundProvider final : public IGroundProvider
+	{
+	public:
+		/**
+		* Create a flat heightfield (Every height is 0)
+		* @param p_width (Number of samples along X)
+		* @param p_depth (Number of samples along Y)
+		* @param p_cellSize (Distance between two samples)
+		* @param p_origin (Position of the sample (0, 0))
+		*/
+		HeightfieldGroundProvider(uint32_t p_width, uint32_t p_depth, float p_cellSize, const AltMath::Vector2f& p_origin = AltMath::Vector2f(0.0f, 0.0f));
+
+		/**
+		* Set the height of the given sample
+		* @param p_x
+		* @param p_y
+		* @param p_height
+		*/
+		void SetHeight(uint32_t p_x, uint32_t p_y, float p_height);
+
+		/**
+		* Return the height of the given sample
+		* @param p_x
+		* @param p_y
+		*/
+		float GetHeight(uint32_t p_x, uint32_t p_y) const;
+
+		/**
+		* Return the height of the ground under the given point
+		* @param p_point
+		*/
+		float SampleHeight(const AltMath::Vector2f& p_point) const;
+
+		/**
+		* Store the height of the ground under each of the given points into p_heights
+		* @param p_points
+		* @param p_heights
+		*/
+		void QueryHeights(const std::vector<AltMath::Vector2f>& p_points, std::vector<float>& p_heights) const override;
+
+	private:
+		uint32_t m_width;
+		uint32_t m_depth;
+		float m_cellSize;
+		AltMath::Vector2f m_origin;
+
+		/* Height of the sample (x, y) : [y * m_width + x] */
+		std::vector<float> m_heights;
+	};
+}
+
+#endif // _HEIGHTFIELDGROUNDPROVIDER_H
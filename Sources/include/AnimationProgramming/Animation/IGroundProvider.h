@@ -0,0 +1,35 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _IGROUNDPROVIDER_H
+#define _IGROUNDPROVIDER_H
+
+#include <vector>
+
+#include <AltMath/AltMath.h>
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* Interface of the ground under the characters (Heightfield, physics raycasts...). The up axis is Z : a point of the ground plane is (x, y).
+	* The queries of every character are sent in one call, so that an implementation can process them as a batch
+	*/
+	class IGroundProvider
+	{
+	public:
+		virtual ~IGroundProvider() = default;
+
+		/**
+		* Store the height of the ground under each of the given points into p_heights (One height per point)
+		* @param p_points
+		* @param p_heights
+		*/
+		virtual void QueryHeights(const std::vector<AltMath::Vector2f>& p_points, std::vector<float>& p_heights) const = 0;
+	};
+}
+
+#endif // _IGROUNDPROVIDER_H
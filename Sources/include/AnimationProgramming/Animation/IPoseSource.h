@@ -0,0 +1,53 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _IPOSESOURCE_H
+#define _IPOSESOURCE_H
+
+#include <vector>
+
+#include "AnimationProgramming/Data/Transform.h"
+#include "AnimationProgramming/Tools/Snapshot.h"
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* Interface of the blends driven by their own parameters instead of a timeline (Sync groups, blend spaces...).
+	* A pose source holds the state of one character and can be played by an Animator
+	*/
+	class IPoseSource
+	{
+	public:
+		virtual ~IPoseSource() = default;
+
+		/**
+		* Advance the playback of the pose source
+		* @param p_deltaTime
+		*/
+		virtual void Update(float p_deltaTime) = 0;
+
+		/**
+		* Store the current pose into p_pose (One transformation per bone, relative to the bind pose)
+		* @param p_pose
+		*/
+		virtual void Evaluate(std::vector<Data::Transformation>& p_pose) = 0;
+
+		/**
+		* Append the playback state of the pose source (Phase, time, parameters...) to the given snapshot (See Animator::SaveSnapshot)
+		* @param p_snapshot
+		*/
+		virtual void SaveSnapshot(Tools::Snapshot& p_snapshot) const = 0;
+
+		/**
+		* Restore the playback state saved by SaveSnapshot
+		* @param p_snapshot
+		*/
+		virtual void RestoreSnapshot(Tools::Snapshot& p_snapshot) = 0;
+	};
+}
+
+#endif // _IPOSESOURCE_H
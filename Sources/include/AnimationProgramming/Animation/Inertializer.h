@@ -0,0 +1,116 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _INERTIALIZER_H
+#define _INERTIALIZER_H
+
+#include <vector>
+
+#include "AnimationProgramming/Data/Transform.h"
+#include "AnimationProgramming/Tools/Snapshot.h"
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* Inertialization (D. Bollo, "Inertialization: High-Performance Animation Transitions in Gears of War", GDC 2018).
+	* When an animation starts, the offset between the previous pose and the new pose is recorded with its velocity,
+	* then it is added to the new animation while decaying to zero with a quintic polynomial. No pose of the previous animation
+	* is sampled during the transition
+	*/
+	class Inertializer final
+	{
+	public:
+		/**
+		* Start a transition toward the given target pose
+		* @param p_previousPose (Source pose of the frame before p_currentPose, to get its velocity)
+		* @param p_currentPose (Last source pose)
+		* @param p_deltaTime (Time between p_previousPose and p_currentPose, the velocity is ignored if zero)
+		* @param p_targetPose (First pose of the new animation)
+		* @param p_duration
+		*/
+		void Start(const std::vector<Data::Transformation>& p_previousPose, const std::vector<Data::Transformation>& p_currentPose, float p_deltaTime, const std::vector<Data::Transformation>& p_targetPose, float p_duration);
+
+		/**
+		* Stop the current transition
+		*/
+		void Stop();
+
+		/**
+		* Return true if a transition is in progress
+		*/
+		bool IsActive() const;
+
+		/**
+		* Advance the transition, which stops once its duration is reached
+		* @param p_deltaTime
+		*/
+		void Update(float p_deltaTime);
+
+		/**
+		* Add the current offsets to the given pose
+		* @param p_pose
+		*/
+		void Apply(std::vector<Data::Transformation>& p_pose) const;
+
+		/**
+		* Append the offsets and the progress of the transition to the given snapshot
+		* @param p_snapshot
+		*/
+		void SaveSnapshot(Tools::Snapshot& p_snapshot) const;
+
+		/**
+		* Restore the offsets and the progress of the transition saved by SaveSnapshot
+		* @param p_snapshot
+		*/
+		void RestoreSnapshot(Tools::Snapshot& p_snapshot);
+
+	private:
+		/**
+		* A scalar offset decaying from x0 (With the velocity v0) to zero
+		*/
+		struct DecayingOffset
+		{
+			float x0 = 0.0f;
+			float v0 = 0.0f;
+			float a0 = 0.0f;
+			float a = 0.0f;
+			float b = 0.0f;
+			float c = 0.0f;
+			float duration = 0.0f;
+
+			/**
+			* Calculate the coefficients of the polynomial (The duration is shortened if the velocity would overshoot)
+			* @param p_x0
+			* @param p_v0
+			* @param p_duration
+			*/
+			void Initialize(float p_x0, float p_v0, float p_duration);
+
+			/**
+			* Return the offset at the given time
+			* @param p_time
+			*/
+			float Evaluate(float p_time) const;
+		};
+
+		struct BoneOffset
+		{
+			AltMath::Vector3f positionDirection;
+			DecayingOffset position;
+
+			AltMath::Vector3f rotationAxis;
+			DecayingOffset rotation;
+		};
+
+		std::vector<BoneOffset> m_offsets;
+		float m_time = 0.0f;
+		float m_duration = 0.0f;
+		bool m_active = false;
+	};
+}
+
+#endif // _INERTIALIZER_H
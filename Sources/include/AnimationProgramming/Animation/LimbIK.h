@@ -0,0 +1,172 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _LIMBIK_H
+#define _LIMBIK_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "AnimationProgramming/Animation/AnimationInfo.h"
+#include "AnimationProgramming/Animation/TwoBoneIKSolver.h"
+#include "AnimationProgramming/Data/Transform.h"
+#include "AnimationProgramming/Rig/SkeletonDefinition.h"
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* Two-bone IK of the limbs of one character, applied as a post-pass on its sampled pose. The target of a limb is given explicitly,
+	* or is its IK bone (ik_foot_l, ik_hand_l...) sampled from the played clip. The requests of many characters can be gathered
+	* into one array and solved at once by the TwoBoneIKSolver, then applied back to each pose (Solve does it for one character)
+	*/
+	class LimbIK final
+	{
+	public:
+		/**
+		* A chain of three bones (Each bone is the parent of the next one)
+		*/
+		struct Limb
+		{
+			uint32_t root;
+			uint32_t joint;
+			uint32_t end;
+
+			/* IK bone used as target (Counted from the first IK bone), UINT32_MAX if none */
+			uint32_t ikBone;
+
+			/* Axis the joint bends around when the limb is straight, in the space of the root bone (From the bind pose) */
+			AltMath::Vector3f bendAxis;
+
+			/* Explicit target in model space (Used instead of the IK bone) */
+			AltMath::Vector3f target;
+			float weight;
+			bool hasTarget;
+		};
+
+		/**
+		* Create the limb IK of the given skeleton definition (Shared : it must outlive the limb IK). The IK bones are read from the engine
+		* @param p_definition
+		*/
+		LimbIK(const Rig::SkeletonDefinition& p_definition);
+
+		/**
+		* Add a limb. Return false if the bones don't form a chain
+		* @param p_root
+		* @param p_joint
+		* @param p_end
+		* @param p_ikBone (Optional)
+		*/
+		bool AddLimb(uint32_t p_root, uint32_t p_joint, uint32_t p_end, uint32_t p_ikBone = UINT32_MAX);
+
+		/**
+		* Add the legs (thigh/calf/foot, targeting ik_foot_*) and the arms (upperarm/lowerarm/hand, targeting ik_hand_*) of the mannequin
+		* found in the skeleton. Return the number of limbs added
+		*/
+		uint32_t AddMannequinLimbs();
+
+		/**
+		* Return the index of the IK bone with the given name, or UINT32_MAX if there is none
+		* @param p_name
+		*/
+		uint32_t FindIKBone(const std::string& p_name) const;
+
+		/**
+		* Return the number of limbs
+		*/
+		uint32_t GetLimbCount() const;
+
+		/**
+		* Return the given limb
+		* @param p_limb
+		*/
+		const Limb& GetLimb(uint32_t p_limb) const;
+
+		/**
+		* Set an explicit target for the given limb, in model space
+		* @param p_limb
+		* @param p_target
+		* @param p_weight
+		*/
+		void SetTarget(uint32_t p_limb, const AltMath::Vector3f& p_target, float p_weight = 1.0f);
+
+		/**
+		* Remove the explicit target of the given limb (Its IK bone becomes its target again)
+		* @param p_limb
+		*/
+		void ClearTarget(uint32_t p_limb);
+
+		/**
+		* Sample the IK bones of the given animation (Interpolated between the two given keys)
+		* @param p_animation
+		* @param p_currentKey
+		* @param p_nextKey
+		* @param p_alpha
+		*/
+		void SetIKBonePose(const AnimationInfo& p_animation, uint32_t p_currentKey, uint32_t p_nextKey, float p_alpha);
+
+		/**
+		* Forget the sampled IK bones : only the limbs with an explicit target are solved
+		*/
+		void ClearIKBonePose();
+
+		/**
+		* Append the request of every limb with a target to p_requests, for the given pose. Return the number of requests appended
+		* @param p_pose
+		* @param p_requests
+		*/
+		uint32_t GatherRequests(const std::vector<Data::Transformation>& p_pose, std::vector<TwoBoneIKSolver::Request>& p_requests) const;
+
+		/**
+		* Apply the results of the requests gathered by GatherRequests to the given pose
+		* @param p_results (The first result of this character)
+		* @param p_pose
+		*/
+		void ApplyResults(const TwoBoneIKSolver::Result* p_results, std::vector<Data::Transformation>& p_pose) const;
+
+		/**
+		* Solve the limbs of the given pose
+		* @param p_pose
+		*/
+		void Solve(std::vector<Data::Transformation>& p_pose);
+
+	private:
+		/**
+		* Return true if the given limb has a target
+		* @param p_limb
+		*/
+		bool HasTarget(const Limb& p_limb) const;
+
+		/**
+		* Return the position of the given IK bone in model space, for the given pose and the sampled IK bones
+		* @param p_ikBone
+		* @param p_pose
+		*/
+		AltMath::Vector3f CalculateIKBonePosition(uint32_t p_ikBone, const std::vector<Data::Transformation>& p_pose) const;
+
+	private:
+		/* Shared skeleton definition, with the hierarchy and bind pose of its bones (Local) */
+		const Rig::SkeletonDefinition& m_definition;
+		const std::vector<int32_t>& m_parents;
+		const std::vector<Data::Transformation>& m_bindPose;
+
+		/* Hierarchy (Engine indices), names, bind pose and sampled pose of the IK bones */
+		std::vector<int32_t> m_ikParents;
+		std::vector<std::string> m_ikNames;
+		std::vector<Data::Transformation> m_ikBindPose;
+		std::vector<Data::Transformation> m_ikPose;
+		bool m_hasIKBonePose = false;
+
+		std::vector<Limb> m_limbs;
+
+		/* Scratch requests and results of Solve (Kept as members to reuse their memory between frames) */
+		std::vector<TwoBoneIKSolver::Request> m_requests;
+		std::vector<TwoBoneIKSolver::Result> m_results;
+	};
+}
+
+#endif // _LIMBIK_H
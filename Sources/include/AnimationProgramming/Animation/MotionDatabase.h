@@ -0,0 +1,176 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _MOTIONDATABASE_H
+#define _MOTIONDATABASE_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "AnimationProgramming/Animation/AnimationInstance.h"
+#include "AnimationProgramming/Rig/SkeletonDefinition.h"
+#include "AnimationProgramming/Tools/KDTree.h"
+#include "AnimationProgramming/Tools/ThreadPool.h"
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* The feature database of motion matching : one feature vector per key of every clip, extracted offline.
+	* Features of the clips (In the space of the root bone) : the position of every feature bone, then their velocity,
+	* then the future positions of the root bone (Its trajectory). Every group of features is normalized (Mean and standard deviation
+	* over the database) and weighted, so that the best next frame is the one whose features are the closest to the query.
+	* The normalized features are stored contiguously, in the order of a k-d tree
+	*/
+	class MotionDatabase final
+	{
+	public:
+		/* Floats of a row of features are padded to a multiple of this (One AVX2 register) */
+		static constexpr uint32_t RowAlignment = 8;
+
+		struct Settings
+		{
+			std::vector<uint32_t> featureBones;
+			uint32_t rootBone = 0;
+
+			/* Keys ahead of the current key where the trajectory is sampled */
+			std::vector<uint32_t> trajectoryKeys = { 10, 20, 30 };
+
+			float positionWeight = 1.0f;
+			float velocityWeight = 1.0f;
+			float trajectoryWeight = 1.0f;
+		};
+
+		/**
+		* Features normalized together (The 3 coordinates of a position for example), and their weight in the search
+		*/
+		struct FeatureGroup
+		{
+			uint32_t size;
+			float weight;
+		};
+
+		struct Frame
+		{
+			uint32_t clip;
+			uint32_t key;
+		};
+
+		/**
+		* Extract the features of every key of the given clips. The feature positions are calculated from the bind pose
+		* of the given skeleton definition and the keys of the clips. The clips must outlive the database
+		* @param p_definition
+		* @param p_clips
+		* @param p_settings
+		*/
+		void Build(const Rig::SkeletonDefinition& p_definition, const std::vector<const AnimationInstance*>& p_clips, const Settings& p_settings);
+
+		/**
+		* Create the database from features extracted elsewhere (One row per frame, the groups cover the row). There is no clip to play
+		* @param p_frames
+		* @param p_features
+		* @param p_groups
+		*/
+		void Build(const std::vector<Frame>& p_frames, const std::vector<float>& p_features, const std::vector<FeatureGroup>& p_groups);
+
+		/**
+		* Return the number of frames
+		*/
+		uint32_t GetFrameCount() const;
+
+		/**
+		* Return the number of features of a frame
+		*/
+		uint32_t GetDimensionCount() const;
+
+		/**
+		* Return the index of the first trajectory feature (Databases built from clips only)
+		*/
+		uint32_t GetTrajectoryDimension() const;
+
+		/**
+		* Return the given frame
+		* @param p_frame
+		*/
+		const Frame& GetFrame(uint32_t p_frame) const;
+
+		/**
+		* Return the number of clips (Databases built from clips only)
+		*/
+		uint32_t GetClipCount() const;
+
+		/**
+		* Return the given clip
+		* @param p_clip
+		*/
+		const AnimationInstance& GetClip(uint32_t p_clip) const;
+
+		/**
+		* Return the frame of the given key of the given clip
+		* @param p_clip
+		* @param p_key
+		*/
+		uint32_t GetClipFrame(uint32_t p_clip, uint32_t p_key) const;
+
+		/**
+		* Return the normalized features of the given frame (GetDimensionCount() floats)
+		* @param p_frame
+		*/
+		const float* GetNormalizedFeatures(uint32_t p_frame) const;
+
+		/**
+		* Return the normalized value of the given feature
+		* @param p_dimension
+		* @param p_value
+		*/
+		float NormalizeFeature(uint32_t p_dimension, float p_value) const;
+
+		/**
+		* Return the frame whose normalized features are the closest to the given normalized query, and store its cost (Squared distance).
+		* Uses the k-d tree, with an optional budget (See Tools::KDTree::FindNearest)
+		* @param p_query
+		* @param p_cost
+		* @param p_maxLeafVisits (0 for an exact search)
+		*/
+		uint32_t FindBestFrame(const float* p_query, float& p_cost, uint32_t p_maxLeafVisits = 0) const;
+
+		/**
+		* Same as FindBestFrame, by comparing the query to every frame (Vectorized, and split between threads if a thread pool is provided)
+		* @param p_query
+		* @param p_cost
+		* @param p_threadPool
+		*/
+		uint32_t FindBestFrameBruteForce(const float* p_query, float& p_cost, Tools::ThreadPool* p_threadPool = nullptr) const;
+
+	private:
+		/**
+		* Normalize the given features, store them padded and build the k-d tree
+		* @param p_features
+		*/
+		void StoreFeatures(const std::vector<float>& p_features);
+
+	private:
+		std::vector<const AnimationInstance*> m_clips;
+		std::vector<uint32_t> m_clipFirstFrames;
+		std::vector<Frame> m_frames;
+
+		std::vector<FeatureGroup> m_groups;
+		uint32_t m_dimensions = 0;
+		uint32_t m_stride = 0;
+		uint32_t m_trajectoryDimension = 0;
+
+		/* Normalization : normalized = (value - mean) * scale */
+		std::vector<float> m_means;
+		std::vector<float> m_scales;
+
+		/* Normalized features, one padded row per frame, in the order of the k-d tree */
+		std::vector<float> m_features;
+		std::vector<uint32_t> m_frameRows;
+		Tools::KDTree m_tree;
+	};
+}
+
+#endif // _MOTIONDATABASE_H
@@ -0,0 +1,125 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _MOTIONMATCHER_H
+#define _MOTIONMATCHER_H
+
+#include <stdint.h>
+#include <vector>
+
+#include <AltMath/AltMath.h>
+
+#include "AnimationProgramming/Animation/IPoseSource.h"
+#include "AnimationProgramming/Animation/MotionDatabase.h"
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* The motion matching playback of one character. The current frame of the database is played like a clip, and at a fixed
+	* interval the database is searched for the frame that best continues the current pose while following the desired trajectory.
+	* When the best frame isn't the natural continuation of the current one, the matcher jumps to it with a crossfade
+	*/
+	class MotionMatcher final : public IPoseSource
+	{
+	public:
+		/**
+		* Create a matcher playing the given database (Which must be built from clips, and must outlive the matcher)
+		* @param p_database
+		*/
+		MotionMatcher(const MotionDatabase& p_database);
+
+		/**
+		* Play the given frame of the database, without transition
+		* @param p_frame
+		*/
+		void PlayFrame(uint32_t p_frame);
+
+		/**
+		* Return the frame of the database currently played (The closest key)
+		*/
+		uint32_t GetCurrentFrame() const;
+
+		/**
+		* Set the desired future positions of the root, in the space of the root (One per trajectory key of the database).
+		* An empty trajectory keeps the trajectory of the current frame
+		* @param p_trajectory
+		*/
+		void SetDesiredTrajectory(const std::vector<AltMath::Vector3f>& p_trajectory);
+
+		/**
+		* Set the time between two searches
+		* @param p_interval
+		*/
+		void SetSearchInterval(float p_interval);
+
+		/**
+		* Set the maximum number of leaves of the k-d tree visited by a search (0 for an exact search)
+		* @param p_maxLeafVisits
+		*/
+		void SetSearchBudget(uint32_t p_maxLeafVisits);
+
+		/**
+		* Set the duration of the crossfade when jumping to another frame
+		* @param p_duration
+		*/
+		void SetTransitionDuration(float p_duration);
+
+		/**
+		* Advance the played frame, and search the database when the search interval is elapsed
+		* @param p_deltaTime
+		*/
+		virtual void Update(float p_deltaTime) override;
+
+		/**
+		* Store the pose of the played frame into p_pose (Blended with the previous frame during a transition)
+		* @param p_pose
+		*/
+		virtual void Evaluate(std::vector<Data::Transformation>& p_pose) override;
+
+		/**
+		* Append the played and previous frames, the transition and search timers and the desired trajectory to the given snapshot
+		* @param p_snapshot
+		*/
+		virtual void SaveSnapshot(Tools::Snapshot& p_snapshot) const override;
+
+		/**
+		* Restore the state saved by SaveSnapshot (The settings aren't saved : the matcher must be set up the same way)
+		* @param p_snapshot
+		*/
+		virtual void RestoreSnapshot(Tools::Snapshot& p_snapshot) override;
+
+	private:
+		/**
+		* Search the database for the best frame to continue with, and jump to it if it isn't the current one
+		*/
+		void Search();
+
+	private:
+		const MotionDatabase& m_database;
+
+		uint32_t m_clip = 0;
+		float m_time = 0.0f;
+
+		/* Frame played before the last jump, faded out during the transition */
+		uint32_t m_previousClip = 0;
+		float m_previousTime = 0.0f;
+		float m_transitionTime = 0.0f;
+		float m_transitionDuration = 0.2f;
+
+		float m_searchInterval = 0.1f;
+		float m_searchTimer = 0.0f;
+		uint32_t m_searchBudget = 0;
+
+		std::vector<AltMath::Vector3f> m_desiredTrajectory;
+
+		/* Scratch buffers (Kept as members to reuse their memory between frames) */
+		std::vector<float> m_query;
+		std::vector<Data::Transformation> m_previousPose;
+	};
+}
+
+#endif // _MOTIONMATCHER_H
@@ -0,0 +1,149 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _POSECACHE_H
+#define _POSECACHE_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "AnimationProgramming/Animation/AnimationInfo.h"
+#include "AnimationProgramming/Animation/ESkinningPaletteFormat.h"
+#include "AnimationProgramming/Data/DualQuaternion.h"
+#include "AnimationProgramming/Data/Matrix3x4.h"
+#include "AnimationProgramming/Data/Transform.h"
+#include "AnimationProgramming/Rig/SkeletonDefinition.h"
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* Identify a pose : every animator of the same skeleton definition playing the same clip with the same timeline state produces the same pose
+	*/
+	struct PoseCacheKey final
+	{
+		bool operator==(const PoseCacheKey& p_other) const;
+
+		const Rig::SkeletonDefinition* skeleton = nullptr;
+		const AnimationInfo* clip = nullptr;
+		uint32_t currentKeyFrame = 0;
+		uint32_t nextKeyFrame = 0;
+		uint32_t quantizedAlpha = 0;
+		uint32_t effectors = 0;
+		ESkinningPaletteFormat paletteFormat = ESkinningPaletteFormat::MATRIX;
+	};
+
+	/**
+	* Hash function of PoseCacheKey (Used by the unordered_map of the cache)
+	*/
+	struct PoseCacheKeyHash final
+	{
+		size_t operator()(const PoseCacheKey& p_key) const;
+	};
+
+	/**
+	* The result of a pose evaluation that other animators can reuse : the local pose (Relative to the bind pose) and the skinning palette
+	*/
+	struct CachedPose final
+	{
+		std::vector<Data::Transformation> localPose;
+		std::vector<Data::Matrix3x4> matrixPalette;
+		std::vector<Data::DualQuaternion> dualQuaternionPalette;
+	};
+
+	/**
+	* A per-frame cache of evaluated poses, shared by the animators of characters in the same animation state (A crowd started together).
+	* The first animator requesting a pose evaluates it, the others wait for it and reuse it. Poses are only shared between the animators
+	* of the same skeleton definition (Other rigs get their own entries). Can be used concurrently from several threads
+	*/
+	class PoseCache final
+	{
+	public:
+		/**
+		* Create the cache
+		* @param p_alphaTolerance (Interpolation alphas closer than this share the same pose. 0 to only share identical alphas)
+		*/
+		PoseCache(float p_alphaTolerance = 0.01f);
+
+		/**
+		* Return the alpha quantization tolerance
+		*/
+		float GetAlphaTolerance() const;
+
+		/**
+		* Set the alpha quantization tolerance (Poses already cached are kept until the next BeginFrame)
+		* @param p_alphaTolerance
+		*/
+		void SetAlphaTolerance(float p_alphaTolerance);
+
+		/**
+		* Return the key of the pose produced by the given timeline state
+		* @param p_skeleton
+		* @param p_clip
+		* @param p_currentKeyFrame
+		* @param p_nextKeyFrame
+		* @param p_alpha
+		* @param p_effectors (One bit per ETimelineEffector)
+		* @param p_paletteFormat
+		*/
+		PoseCacheKey MakeKey(const Rig::SkeletonDefinition& p_skeleton, const AnimationInfo& p_clip, uint32_t p_currentKeyFrame, uint32_t p_nextKeyFrame, float p_alpha, uint32_t p_effectors, ESkinningPaletteFormat p_paletteFormat) const;
+
+		/**
+		* Return the cached pose of the given key. If the pose isn't cached yet, p_evaluate is called to fill it (Only once, even if
+		* several threads request the same key at the same time)
+		* @param p_key
+		* @param p_evaluate
+		* @param p_evaluated (Set to true if p_evaluate has been called by this call)
+		*/
+		std::shared_ptr<const CachedPose> GetOrEvaluate(const PoseCacheKey& p_key, const std::function<void(CachedPose&)>& p_evaluate, bool& p_evaluated);
+
+		/**
+		* Forget every cached pose. Must be called once per frame, before the animators are updated
+		*/
+		void BeginFrame();
+
+		/**
+		* Return the number of requests that reused a cached pose
+		*/
+		uint64_t GetHitCount() const;
+
+		/**
+		* Return the number of requests that had to evaluate the pose
+		*/
+		uint64_t GetMissCount() const;
+
+		/**
+		* Return the ratio of requests that reused a cached pose (0 if there was no request)
+		*/
+		float GetHitRate() const;
+
+		/**
+		* Reset the hit and miss counters
+		*/
+		void ResetCounters();
+
+	private:
+		struct Entry final
+		{
+			std::once_flag evaluated;
+			CachedPose pose;
+		};
+
+		float m_alphaTolerance;
+
+		std::mutex m_entriesMutex;
+		std::unordered_map<PoseCacheKey, std::shared_ptr<Entry>, PoseCacheKeyHash> m_entries;
+
+		std::atomic<uint64_t> m_hitCount;
+		std::atomic<uint64_t> m_missCount;
+	};
+}
+
+#endif // _POSECACHE_H
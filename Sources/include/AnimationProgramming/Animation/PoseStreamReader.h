@@ -0,0 +1,127 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _POSESTREAMREADER_H
+#define _POSESTREAMREADER_H
+
+#include <stdint.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "AnimationProgramming/Animation/EPoseStreamContent.h"
+#include "AnimationProgramming/Data/Matrix3x4.h"
+#include "AnimationProgramming/Data/Transform.h"
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* Read back, frame after frame, a pose stream written by a PoseStreamWriter. The file is read one block at a time,
+	* so that long sessions can be analysed without loading them entirely. The values are exact up to the precision of the stream
+	*/
+	class PoseStreamReader final
+	{
+	public:
+		/**
+		* Open the given file and count its frames. The reader is empty if the file can't be read or isn't a pose stream
+		* @param p_path
+		*/
+		PoseStreamReader(const std::string& p_path);
+
+		/**
+		* Return true if the file has been opened
+		*/
+		bool IsLoaded() const;
+
+		/**
+		* Return what the stream captures
+		*/
+		EPoseStreamContent GetContent() const;
+
+		/**
+		* Return the number of characters of a frame
+		*/
+		uint32_t GetCharacterCount() const;
+
+		/**
+		* Return the number of transformations per character
+		*/
+		uint32_t GetBoneCount() const;
+
+		/**
+		* Return the number of frames of the stream (A block truncated by an interrupted capture isn't counted)
+		*/
+		uint32_t GetFrameCount() const;
+
+		/**
+		* Return the size of the file in bytes
+		*/
+		uint64_t GetFileSize() const;
+
+		/**
+		* Return the average number of bytes per frame and per character (Header excluded)
+		*/
+		float GetBytesPerCharacterFrame() const;
+
+		/**
+		* Go back to the first frame
+		*/
+		void Rewind();
+
+		/**
+		* Decode the next frame. Return false if every frame has been read
+		*/
+		bool ReadFrame();
+
+		/**
+		* Copy the local pose of the given character in the last decoded frame into p_pose (Resized to the bone count)
+		* @param p_character
+		* @param p_pose
+		*/
+		void GetLocalPose(uint32_t p_character, std::vector<Data::Transformation>& p_pose) const;
+
+		/**
+		* Copy the skinning palette of the given character in the last decoded frame into p_palette (Resized to the bone count)
+		* @param p_character
+		* @param p_palette
+		*/
+		void GetSkinningPalette(uint32_t p_character, std::vector<Data::Matrix3x4>& p_palette) const;
+
+	private:
+		/**
+		* Read and decompress the next block. Return false if there is no complete block left
+		*/
+		bool ReadBlock();
+
+	private:
+		std::ifstream m_file;
+		bool m_loaded;
+
+		EPoseStreamContent m_content;
+		uint32_t m_characterCount;
+		uint32_t m_boneCount;
+		uint32_t m_valuesPerBone;
+		std::vector<float> m_steps;
+
+		uint32_t m_frameCount;
+		uint32_t m_frame;
+		uint64_t m_fileSize;
+		std::streamoff m_firstBlockOffset;
+
+		/* Current block (Decompressed), position of the next frame in it and frames left */
+		std::vector<uint8_t> m_compressedBlock;
+		std::vector<uint8_t> m_block;
+		size_t m_blockCursor;
+		uint32_t m_blockFramesLeft;
+		bool m_firstFrameOfBlock;
+
+		/* Quantized values of the last decoded frame */
+		std::vector<int32_t> m_values;
+	};
+}
+
+#endif // _POSESTREAMREADER_H
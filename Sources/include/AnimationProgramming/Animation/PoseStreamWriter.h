@@ -0,0 +1,188 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _POSESTREAMWRITER_H
+#define _POSESTREAMWRITER_H
+
+#include <stdint.h>
+#include <atomic>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AnimationProgramming/Animation/EPoseStreamContent.h"
+#include "AnimationProgramming/Data/Matrix3x4.h"
+#include "AnimationProgramming/Data/Transform.h"
+#include "AnimationProgramming/Tools/SPSCQueue.h"
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* Capture the animated output of a group of characters, frame after frame, to a file (Read it with a PoseStreamReader).
+	* The frame thread only copies the values of the frame into a lock-free queue : a background thread quantizes them, encodes
+	* the difference with the previous frame and compresses the frames by blocks. When the background thread can't keep up,
+	* frames are dropped instead of stalling the frame (See GetDroppedFrameCount).
+	* The first frame of a block is encoded from zero, so every block can be decoded on its own
+	*/
+	class PoseStreamWriter final
+	{
+	public:
+		/* File identifier ("APPS") and format version */
+		static constexpr uint32_t Magic = 0x53505041;
+		static constexpr uint32_t Version = 1;
+
+		/* Default quantization steps of the positions (Units) and of the rotations (Quaternion components or matrix elements) */
+		static constexpr float DefaultPositionPrecision = 0.01f;
+		static constexpr float DefaultRotationPrecision = 1.0f / 32768.0f;
+
+		static constexpr uint32_t DefaultFramesPerBlock = 64;
+		static constexpr uint32_t DefaultQueueCapacity = 16;
+
+		/**
+		* Create the given file (Any existing one is replaced), write the header and start the background thread
+		* @param p_path
+		* @param p_content
+		* @param p_characterCount
+		* @param p_boneCount (Transformations per character : bones of the local pose, or matrices of the skinning palette)
+		* @param p_positionPrecision
+		* @param p_rotationPrecision
+		* @param p_framesPerBlock
+		* @param p_queueCapacity (Frames waiting to be encoded at most)
+		*/
+		PoseStreamWriter(const std::string& p_path, EPoseStreamContent p_content, uint32_t p_characterCount, uint32_t p_boneCount, float p_positionPrecision = DefaultPositionPrecision, float p_rotationPrecision = DefaultRotationPrecision, uint32_t p_framesPerBlock = DefaultFramesPerBlock, uint32_t p_queueCapacity = DefaultQueueCapacity);
+
+		/**
+		* Encode the frames still in the queue, write the last block and stop the background thread
+		*/
+		~PoseStreamWriter();
+
+		PoseStreamWriter(const PoseStreamWriter&) = delete;
+		PoseStreamWriter& operator=(const PoseStreamWriter&) = delete;
+
+		/**
+		* Return true if the file could be created
+		*/
+		bool IsOpen() const;
+
+		/**
+		* Return what the stream captures
+		*/
+		EPoseStreamContent GetContent() const;
+
+		/**
+		* Return the number of characters of a frame
+		*/
+		uint32_t GetCharacterCount() const;
+
+		/**
+		* Return the number of transformations per character
+		*/
+		uint32_t GetBoneCount() const;
+
+		/**
+		* Set the local pose of the given character for the next frame (Ignored if the stream captures skinning palettes)
+		* @param p_character
+		* @param p_pose
+		*/
+		void CaptureLocalPose(uint32_t p_character, const std::vector<Data::Transformation>& p_pose);
+
+		/**
+		* Set the skinning palette of the given character for the next frame (Ignored if the stream captures local poses)
+		* @param p_character
+		* @param p_palette
+		*/
+		void CaptureSkinningPalette(uint32_t p_character, const std::vector<Data::Matrix3x4>& p_palette);
+
+		/**
+		* Send the captured frame to the background thread. Return false if the frame has been dropped (The queue is full)
+		*/
+		bool SubmitFrame();
+
+		/**
+		* Return the number of frames submitted, dropped included
+		*/
+		uint32_t GetSubmittedFrameCount() const;
+
+		/**
+		* Return the number of frames dropped because the queue was full
+		*/
+		uint32_t GetDroppedFrameCount() const;
+
+		/**
+		* Return the number of frames written to the file so far (The frames of the current block are written with it)
+		*/
+		uint32_t GetWrittenFrameCount() const;
+
+		/**
+		* Return the number of bytes written to the file so far
+		*/
+		uint64_t GetWrittenBytes() const;
+
+		/**
+		* Return the average number of bytes written per frame and per character (Header excluded)
+		*/
+		float GetBytesPerCharacterFrame() const;
+
+		/**
+		* Return the quantization step of each value of a bone, for the given content (The positions use the position precision, the rest the rotation precision)
+		* @param p_content
+		* @param p_positionPrecision
+		* @param p_rotationPrecision
+		*/
+		static std::vector<float> CalculateQuantizationSteps(EPoseStreamContent p_content, float p_positionPrecision, float p_rotationPrecision);
+
+	private:
+		/**
+		* Encode the frames of the queue until the writer is destroyed
+		*/
+		void WriterLoop();
+
+		/**
+		* Quantize the given frame and append its difference with the previous one to the current block
+		* @param p_frame
+		*/
+		void EncodeFrame(const std::vector<float>& p_frame);
+
+		/**
+		* Compress the current block and write it to the file
+		*/
+		void WriteBlock();
+
+	private:
+		EPoseStreamContent m_content;
+		uint32_t m_characterCount;
+		uint32_t m_boneCount;
+		uint32_t m_valuesPerBone;
+		uint32_t m_framesPerBlock;
+
+		/* Quantization step of each value of a bone, and its inverse */
+		std::vector<float> m_steps;
+		std::vector<float> m_inverseSteps;
+
+		/* Frame being captured (Frame thread), and frames waiting to be encoded */
+		std::vector<float> m_capture;
+		Tools::SPSCQueue<std::vector<float>> m_queue;
+
+		/* Background thread only : quantized values of the previous frame, the last encoded frame and the current block (Encoded and compressed) */
+		std::ofstream m_file;
+		std::vector<int32_t> m_previous;
+		std::vector<uint8_t> m_encodedFrame;
+		std::vector<uint8_t> m_block;
+		std::vector<uint8_t> m_compressedBlock;
+		uint32_t m_blockFrameCount;
+
+		std::atomic<uint32_t> m_submittedFrameCount;
+		std::atomic<uint32_t> m_droppedFrameCount;
+		std::atomic<uint32_t> m_writtenFrameCount;
+		std::atomic<uint64_t> m_writtenBytes;
+		std::atomic<bool> m_stopping;
+		std::thread m_thread;
+	};
+}
+
+#endif // _POSESTREAMWRITER_H
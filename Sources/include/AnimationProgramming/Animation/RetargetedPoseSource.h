@@ -0,0 +1,86 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _RETARGETEDPOSESOURCE_H
+#define _RETARGETEDPOSESOURCE_H
+
+#include <vector>
+
+#include "AnimationProgramming/Animation/AnimationInstance.h"
+#include "AnimationProgramming/Animation/IPoseSource.h"
+#include "AnimationProgramming/Animation/Retargeter.h"
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* Plays a clip (Or any pose source) made for the source skeleton of a retargeter on its target skeleton :
+	* the pose is sampled for the source skeleton, then retargeted
+	*/
+	class RetargetedPoseSource final : public IPoseSource
+	{
+	public:
+		/**
+		* Create a pose source playing the given clip of the source skeleton (The clip and the retargeter must outlive the pose source)
+		* @param p_animation
+		* @param p_retargeter
+		*/
+		RetargetedPoseSource(const AnimationInstance& p_animation, const Retargeter& p_retargeter);
+
+		/**
+		* Create a pose source retargeting the given pose source of the source skeleton (Both must outlive the pose source)
+		* @param p_source
+		* @param p_retargeter
+		*/
+		RetargetedPoseSource(IPoseSource& p_source, const Retargeter& p_retargeter);
+
+		/**
+		* Return the time of the played clip
+		*/
+		float GetTime() const;
+
+		/**
+		* Set the time of the played clip
+		* @param p_time
+		*/
+		void SetTime(float p_time);
+
+		/**
+		* Advance the clip (With its speed coefficient) or the retargeted pose source
+		* @param p_deltaTime
+		*/
+		virtual void Update(float p_deltaTime) override;
+
+		/**
+		* Store the retargeted pose into p_pose (One transformation per bone of the target skeleton, relative to its bind pose)
+		* @param p_pose
+		*/
+		virtual void Evaluate(std::vector<Data::Transformation>& p_pose) override;
+
+		/**
+		* Append the time of the clip, or the state of the retargeted pose source, to the given snapshot
+		* @param p_snapshot
+		*/
+		virtual void SaveSnapshot(Tools::Snapshot& p_snapshot) const override;
+
+		/**
+		* Restore the state saved by SaveSnapshot
+		* @param p_snapshot
+		*/
+		virtual void RestoreSnapshot(Tools::Snapshot& p_snapshot) override;
+
+	private:
+		const AnimationInstance* m_animation = nullptr;
+		IPoseSource* m_source = nullptr;
+		const Retargeter& m_retargeter;
+		float m_time = 0.0f;
+
+		/* Scratch pose of the source skeleton (Kept as a member to reuse its memory between frames) */
+		std::vector<Data::Transformation> m_sourcePose;
+	};
+}
+
+#endif // _RETARGETEDPOSESOURCE_H
@@ -0,0 +1,94 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _RETARGETER_H
+#define _RETARGETER_H
+
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AnimationProgramming/Data/Transform.h"
+#include "AnimationProgramming/Rig/SkeletonDefinition.h"
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* Transfers the poses of a source skeleton (The one the clips are made for) to a target skeleton with another hierarchy and other proportions,
+	* so that several rigs share one clip library. The bones are mapped once, by role or by name, into flat tables :
+	* the source bone of every target bone, a rotation correction (Between the bind frames of the two bones) and a translation correction
+	* (Between the bind frames of their parents, and the ratio of their lengths). The runtime pass is a sweep over these tables,
+	* LaneWidth target bones at a time. Target bones without source bone keep their bind pose
+	*/
+	class Retargeter final
+	{
+	public:
+		/* Number of target bones corrected at once */
+		static constexpr uint32_t LaneWidth = 8;
+
+		/* Role of the bones (Bone name to role, "hips" or "left_foot" for example) : bones with the same role are mapped together */
+		using RoleTable = std::unordered_map<std::string, std::string>;
+
+		/**
+		* Map the bones of the target skeleton to the bones of the source skeleton : by role if both bones have one, by name otherwise
+		* @param p_source
+		* @param p_target
+		* @param p_sourceRoles
+		* @param p_targetRoles
+		*/
+		void Build(const Rig::SkeletonDefinition& p_source, const Rig::SkeletonDefinition& p_target, const RoleTable& p_sourceRoles = {}, const RoleTable& p_targetRoles = {});
+
+		/**
+		* Return the number of bones of the source skeleton
+		*/
+		uint32_t GetSourceBoneCount() const;
+
+		/**
+		* Return the number of bones of the target skeleton
+		*/
+		uint32_t GetTargetBoneCount() const;
+
+		/**
+		* Return the number of target bones with a source bone
+		*/
+		uint32_t GetMappedBoneCount() const;
+
+		/**
+		* Return the source bone of the given target bone, or UINT32_MAX if it has none
+		* @param p_targetBone
+		*/
+		uint32_t GetSourceBone(uint32_t p_targetBone) const;
+
+		/**
+		* Calculate the pose of the target skeleton from the given pose of the source skeleton (Both relative to the bind pose of their skeleton)
+		* @param p_sourcePose
+		* @param p_targetPose
+		*/
+		void Retarget(const std::vector<Data::Transformation>& p_sourcePose, std::vector<Data::Transformation>& p_targetPose) const;
+
+	private:
+		uint32_t m_sourceBoneCount = 0;
+		uint32_t m_targetBoneCount = 0;
+		uint32_t m_mappedBoneCount = 0;
+
+		/* Source bone of every target bone (m_sourceBoneCount for the target bones without source bone : they read the identity) */
+		std::vector<uint32_t> m_sourceBones;
+
+		/*
+		* Corrections of every target bone, padded to a multiple of LaneWidth. Component c of the bone b is at [((b / LaneWidth) * componentCount + c) * LaneWidth + b % LaneWidth],
+		* so that a group of LaneWidth bones is read with one load per component :
+		* targetRotation = conjugate(rotationCorrection) * sourceRotation * rotationCorrection,
+		* targetTranslation = translationScale * rotate(conjugate(parentCorrection), sourceTranslation)
+		*/
+		std::vector<float> m_rotationCorrections;
+		std::vector<float> m_parentCorrections;
+		std::vector<float> m_translationScales;
+	};
+}
+
+#endif // _RETARGETER_H
@@ -0,0 +1,172 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _SPRINGBONES_H
+#define _SPRINGBONES_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "AnimationProgramming/Data/Transform.h"
+#include "AnimationProgramming/Rig/SkeletonDefinition.h"
+#include "AnimationProgramming/Tools/Snapshot.h"
+#include "AnimationProgramming/Tools/ThreadPool.h"
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* Secondary motion (Hair, cloth straps, accessories) of the chains of one character, applied as a post-pass on its final pose.
+	* The joints of every chain are verlet particles pulled back toward their animated positions, stepped at a fixed rate whatever the frame rate :
+	* the same sequence of poses and delta times always gives the same motion. The particles are kept in flat arrays and written back as local rotations.
+	* The spring bones of a crowd are solved in parallel chunks (SolveCrowd), and can be disabled per character (Level of detail)
+	*/
+	class SpringBones final
+	{
+	public:
+		/* Default rate of the fixed steps (Steps per second) */
+		static constexpr float DefaultStepRate = 120.0f;
+
+		/* Steps done in one frame at most : a long frame slows the motion down instead of costing more */
+		static constexpr uint32_t MaxStepsPerFrame = 8;
+
+		/**
+		* A chain of bones (Each bone is the parent of the next one), from its root (Animated only) to its end
+		*/
+		struct Chain
+		{
+			/* Joints of the chain in the flat arrays : [firstJoint, firstJoint + jointCount), from the root to the end */
+			uint32_t firstJoint;
+			uint32_t jointCount;
+
+			/* Share of the distance to the animated position recovered per step (0 : no spring, 1 : animated only) */
+			float stiffness;
+
+			/* Share of the velocity lost per step */
+			float damping;
+
+			/* Acceleration of the particles, in model space (Units per second squared) */
+			AltMath::Vector3f gravity;
+		};
+
+		/**
+		* Create the spring bones of the given skeleton definition (Shared : it must outlive the spring bones)
+		* @param p_definition
+		* @param p_stepRate
+		*/
+		SpringBones(const Rig::SkeletonDefinition& p_definition, float p_stepRate = DefaultStepRate);
+
+		/**
+		* Add the chain going from p_root down to p_end. Return the index of the chain, or UINT32_MAX if p_end isn't below p_root
+		* @param p_root
+		* @param p_end
+		* @param p_stiffness
+		* @param p_damping
+		* @param p_gravity
+		*/
+		uint32_t AddChain(uint32_t p_root, uint32_t p_end, float p_stiffness = 0.1f, float p_damping = 0.05f, const AltMath::Vector3f& p_gravity = AltMath::Vector3f(0.0f, 0.0f, -980.0f));
+
+		/**
+		* Return the number of chains
+		*/
+		uint32_t GetChainCount() const;
+
+		/**
+		* Return the given chain
+		* @param p_chain
+		*/
+		const Chain& GetChain(uint32_t p_chain) const;
+
+		/**
+		* Enable or disable the simulation (Level of detail). A disabled simulation leaves the pose untouched and restarts from it once enabled again
+		* @param p_enabled
+		*/
+		void SetEnabled(bool p_enabled);
+
+		/**
+		* Return true if the simulation is enabled
+		*/
+		bool IsEnabled() const;
+
+		/**
+		* Set the position of the character in the world (The origin of its model space). The particles react to the motion of the character
+		* @param p_position
+		*/
+		void SetRootPosition(const AltMath::Vector3f& p_position);
+
+		/**
+		* Restart the simulation from the next pose (After a teleport for example)
+		*/
+		void Reset();
+
+		/**
+		* Step the simulation toward the given pose and write the particles back into it
+		* @param p_pose
+		* @param p_deltaTime
+		*/
+		void Solve(std::vector<Data::Transformation>& p_pose, float p_deltaTime);
+
+		/**
+		* Solve the spring bones of a crowd, in parallel chunks of characters
+		* @param p_characters
+		* @param p_poses (One pose per character)
+		* @param p_deltaTime
+		* @param p_threadPool (Optional, the characters are solved in parallel if provided)
+		*/
+		static void SolveCrowd(const std::vector<SpringBones*>& p_characters, const std::vector<std::vector<Data::Transformation>*>& p_poses, float p_deltaTime, Tools::ThreadPool* p_threadPool = nullptr);
+
+		/**
+		* Append the state of the simulation (Particles, step clock, root position) to the given snapshot. The chains and their settings aren't saved
+		* @param p_snapshot
+		*/
+		void SaveSnapshot(Tools::Snapshot& p_snapshot) const;
+
+		/**
+		* Restore the state saved by SaveSnapshot (On spring bones with the same chains)
+		* @param p_snapshot
+		*/
+		void RestoreSnapshot(Tools::Snapshot& p_snapshot);
+
+	private:
+		/**
+		* Calculate the animated positions of the joints of every chain, for the given pose (World space)
+		* @param p_pose
+		*/
+		void CalculateAnimatedPositions(const std::vector<Data::Transformation>& p_pose);
+
+		/**
+		* Move the particles by one fixed step, toward the animated positions interpolated by the given alpha between the last frame and this one
+		* @param p_alpha
+		*/
+		void Step(float p_alpha);
+
+	private:
+		/* Shared skeleton definition, with the hierarchy and bind pose of its bones (Local) */
+		const Rig::SkeletonDefinition& m_definition;
+		const std::vector<int32_t>& m_parents;
+		const std::vector<Data::Transformation>& m_bindPose;
+
+		std::vector<Chain> m_chains;
+
+		/* Flat arrays of the joints of every chain : bone, and length of the bone entering the joint */
+		std::vector<uint32_t> m_bones;
+		std::vector<float> m_lengths;
+
+		/* Particles (World space) : position, position of the previous step, animated positions of the last frame and of this frame */
+		std::vector<AltMath::Vector3f> m_positions;
+		std::vector<AltMath::Vector3f> m_previousPositions;
+		std::vector<AltMath::Vector3f> m_previousAnimatedPositions;
+		std::vector<AltMath::Vector3f> m_animatedPositions;
+
+		float m_stepTime;
+		float m_accumulatedTime;
+		AltMath::Vector3f m_rootPosition;
+		bool m_enabled;
+		bool m_hasState;
+	};
+}
+
+#endif // _SPRINGBONES_H
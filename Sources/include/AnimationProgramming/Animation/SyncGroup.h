@@ -0,0 +1,113 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _SYNCGROUP_H
+#define _SYNCGROUP_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "AnimationProgramming/Animation/IPoseSource.h"
+#include "AnimationProgramming/Animation/SyncMarkerTrack.h"
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* A sync group blends animations of the same movement at different speeds (Walk and run for example) while keeping them in lockstep.
+	* The group has a single normalized phase, mapped to the time of each animation by its marker track (So that the feet of every animation
+	* land together). The weights are a continuous function of the speed : the two animations whose speeds surround the speed are blended,
+	* and the phase advances with the blended cycle duration. A sync group holds the state of one character
+	*/
+	class SyncGroup final : public IPoseSource
+	{
+	public:
+		/**
+		* Add an animation to the group (Through its marker track, which must outlive the group)
+		* @param p_track
+		* @param p_speed (The movement speed this animation represents)
+		*/
+		void AddAnimation(const SyncMarkerTrack& p_track, float p_speed);
+
+		/**
+		* Return the number of animations of the group
+		*/
+		uint32_t GetAnimationCount() const;
+
+		/**
+		* Return the speed of the group
+		*/
+		float GetSpeed() const;
+
+		/**
+		* Set the speed of the group and recalculate the weights (Below the slowest animation or above the fastest one, it plays alone)
+		* @param p_speed
+		*/
+		void SetSpeed(float p_speed);
+
+		/**
+		* Return the weight of the given animation (In the order of their speeds)
+		* @param p_index
+		*/
+		float GetWeight(uint32_t p_index) const;
+
+		/**
+		* Return the normalized phase of the group, in [0, 1[
+		*/
+		float GetPhase() const;
+
+		/**
+		* Set the normalized phase of the group (Wrapped into [0, 1[)
+		* @param p_phase
+		*/
+		void SetPhase(float p_phase);
+
+		/**
+		* Advance the phase with the cycle durations of the animations, weighted by their weights (And their speed coefficients)
+		* @param p_deltaTime
+		*/
+		virtual void Update(float p_deltaTime) override;
+
+		/**
+		* Store the blended pose of the group at its current phase into p_pose (One transformation per bone, relative to the bind pose).
+		* Only the animations with a weight are sampled
+		* @param p_pose
+		*/
+		virtual void Evaluate(std::vector<Data::Transformation>& p_pose) override;
+
+		/**
+		* Append the speed and the phase of the group to the given snapshot
+		* @param p_snapshot
+		*/
+		virtual void SaveSnapshot(Tools::Snapshot& p_snapshot) const override;
+
+		/**
+		* Restore the speed and the phase saved by SaveSnapshot (The weights are recalculated from the speed)
+		* @param p_snapshot
+		*/
+		virtual void RestoreSnapshot(Tools::Snapshot& p_snapshot) override;
+
+	private:
+		struct Entry
+		{
+			const SyncMarkerTrack* track;
+			float speed;
+			float weight;
+		};
+
+		void UpdateWeights();
+
+	private:
+		std::vector<Entry> m_entries;
+		float m_speed = 0.0f;
+		float m_phase = 0.0f;
+
+		/* Scratch pose of the second blended animation (Kept as a member to reuse its memory between frames) */
+		std::vector<Data::Transformation> m_entryPose;
+	};
+}
+
+#endif // _SYNCGROUP_H
@@ -0,0 +1,122 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _SYNCMARKERTRACK_H
+#define _SYNCMARKERTRACK_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <AltMath/AltMath.h>
+
+#include "AnimationProgramming/Animation/AnimationInstance.h"
+#include "AnimationProgramming/Rig/Skeleton.h"
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* The markers of a looping animation (Left foot down, right foot down...) used to keep animations of a sync group in lockstep.
+	* The normalized phase [0, 1[ of a cycle is split in as many equal segments as there are markers : the phase 0 is the origin
+	* marker, and the phase k / markerCount is the k-th marker after it. Between two markers, the time progresses linearly.
+	* The phase to time mapping is precomputed into a table, so that the runtime never scans the markers
+	*/
+	class SyncMarkerTrack final
+	{
+	public:
+		/* Default number of entries of the phase table */
+		static constexpr uint32_t DefaultPhaseTableSize = 256;
+
+		/* Names of the markers created by CreateFromFootContacts */
+		static constexpr const char* LeftFootDown = "LeftFootDown";
+		static constexpr const char* RightFootDown = "RightFootDown";
+
+		struct Marker
+		{
+			std::string name;
+			float time;
+		};
+
+		/**
+		* Create an empty marker track for the given animation (Without markers, the phase is the normalized time)
+		* @param p_animation
+		*/
+		SyncMarkerTrack(const AnimationInstance& p_animation);
+
+		/**
+		* Create the marker track of a locomotion animation : a marker is placed where each foot is the lowest (Along p_upAxis).
+		* The feet heights are calculated from the bind pose of the given skeleton and the keys of the animation (The skeleton isn't modified).
+		* The phase origin is the left foot contact
+		* @param p_skeleton
+		* @param p_animation
+		* @param p_leftFootBone
+		* @param p_rightFootBone
+		* @param p_upAxis
+		*/
+		static SyncMarkerTrack CreateFromFootContacts(Rig::Skeleton& p_skeleton, const AnimationInstance& p_animation, uint32_t p_leftFootBone, uint32_t p_rightFootBone, const AltMath::Vector3f& p_upAxis = AltMath::Vector3f(0.0f, 0.0f, 1.0f));
+
+		/**
+		* Add a marker at the given time of the animation (The phase table must be rebuilt after adding markers)
+		* @param p_name
+		* @param p_time
+		*/
+		void AddMarker(const std::string& p_name, float p_time);
+
+		/**
+		* Return the markers, sorted by time
+		*/
+		const std::vector<Marker>& GetMarkers() const;
+
+		/**
+		* Precompute the phase to time table. The phase 0 is the first marker named p_originMarker (Or the first marker if there is none)
+		* @param p_originMarker
+		* @param p_tableSize
+		*/
+		void BuildPhaseTable(const std::string& p_originMarker = "", uint32_t p_tableSize = DefaultPhaseTableSize);
+
+		/**
+		* Return the animation of this track
+		*/
+		const AnimationInstance& GetAnimation() const;
+
+		/**
+		* Return the duration of a cycle in seconds (The duration of the animation)
+		*/
+		float GetCycleDuration() const;
+
+		/**
+		* Return the time of the animation at the given phase (Wrapped into [0, 1[), interpolated from the phase table
+		* @param p_phase
+		*/
+		float GetTime(float p_phase) const;
+
+		/**
+		* Return the phase at the given time of the animation (Scans the markers : used when entering a sync group, not every frame)
+		* @param p_time
+		*/
+		float GetPhase(float p_time) const;
+
+	private:
+		/**
+		* Return the time of the animation at the given phase, calculated from the markers
+		* @param p_phase
+		*/
+		float CalculateTime(float p_phase) const;
+
+	private:
+		const AnimationInstance& m_animation;
+		float m_duration;
+
+		std::vector<Marker> m_markers;
+		uint32_t m_originMarker = 0;
+
+		/* Time of the animation at the phase i / size (Unwrapped : the times increase along the table) */
+		std::vector<float> m_phaseTable;
+	};
+}
+
+#endif // _SYNCMARKERTRACK_H
@@ -9,6 +9,7 @@
 #define _TIMELINE_H
 
 #include "AnimationProgramming/Tools/Event.h"
+#include "AnimationProgramming/Tools/Snapshot.h"
 #include "AnimationProgramming/Animation/AnimationInstance.h"
 #include "AnimationProgramming/Animation/ETimelineState.h"
 #include "AnimationProgramming/Animation/ETimelineEffector.h"
@@ -138,6 +139,17 @@ namespace AnimationProgramming::Animation
 		*/
 		void Reset();
 
+		/**
+		* Return the key frame where the synced animation is entered (By a transition) : the first key frame, unless an entry key frame is set
+		*/
+		uint32_t GetEntryKeyFrame() const;
+
+		/**
+		* Enter the synced animation at the given key frame instead of its first key frame (Until the next reset), and go to this key frame
+		* @param p_keyFrame
+		*/
+		void SetEntryKeyFrame(uint32_t p_keyFrame);
+
 		/**
 		* Set the current state to the timeline to play mode
 		*/
@@ -186,6 +198,19 @@ namespace AnimationProgramming::Animation
 		*/
 		void UpdateTransitioningState(float p_deltaTime);
 
+		/**
+		* Append the state of the timeline (Key frames, timers, playing state and effectors) to the given snapshot.
+		* The listeners of FrameChangedEvent aren't part of the state
+		* @param p_snapshot
+		*/
+		void SaveSnapshot(Tools::Snapshot& p_snapshot) const;
+
+		/**
+		* Restore the state saved by SaveSnapshot, without invoking FrameChangedEvent
+		* @param p_snapshot
+		*/
+		void RestoreSnapshot(Tools::Snapshot& p_snapshot);
+
 	public:
 		/**
 		* This event is invoked when the current key frame index is changed
@@ -197,6 +222,8 @@ namespace AnimationProgramming::Animation
 		uint32_t m_currentKeyFrame;
 		uint32_t m_startKeyFrame;
 		uint32_t m_endKeyFrame;
+		uint32_t m_entryKeyFrame = 0;
+		bool m_hasEntryKeyFrame = false;
 
 		/* Frame-relatives */
 		float m_frameTimer;
@@ -214,8 +241,8 @@ namespace AnimationProgramming::Animation
 		ETimelineState m_pausePreviousState = ETimelineState::PAUSE;
 		ETimelineState m_currentState = ETimelineState::PAUSE;
 
-		/* Effectors-relatives */
-		std::unordered_map<ETimelineEffector, bool> m_effectors;
+		/* Effectors-relatives (One bit per effector) */
+		uint32_t m_effectors = 0;
 	};
 }
 
@@ -0,0 +1,133 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _TRANSITIONINDEX_H
+#define _TRANSITIONINDEX_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "AnimationProgramming/Animation/AnimationInstance.h"
+#include "AnimationProgramming/Rig/SkeletonDefinition.h"
+#include "AnimationProgramming/Tools/ThreadPool.h"
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* The best transition points between clips, calculated once at load time : for every pair of clips, the distance between the poses
+	* of every key of the source and every key of the target is calculated, and the target key the closest to each source key is kept.
+	* Entering the target at this key instead of its first key is then an O(1) lookup.
+	* The pose of a key is the position of every bone in the space of the root bone, and its velocity in the playing direction of the clip.
+	* Since the analysis is quadratic in the number of keys, it is split between threads and can be cached in a file
+	*/
+	class TransitionIndex final
+	{
+	public:
+		/* Weight of the squared velocities (Per second) against the squared positions : velocities matter over a tenth of a second */
+		static constexpr float DefaultVelocityWeight = 0.01f;
+
+		/**
+		* Analyze every pair of the given clips (The clips must outlive the index)
+		* @param p_definition
+		* @param p_clips
+		* @param p_threadPool (Optional, the distances are calculated in parallel if provided)
+		* @param p_velocityWeight
+		*/
+		void Build(const Rig::SkeletonDefinition& p_definition, const std::vector<const AnimationInstance*>& p_clips, Tools::ThreadPool* p_threadPool = nullptr, float p_velocityWeight = DefaultVelocityWeight);
+
+		/**
+		* Load the index from the given cache file if it was built from the same poses, otherwise build it and save it to the cache file.
+		* Return true if the index was loaded from the cache
+		* @param p_cachePath
+		* @param p_definition
+		* @param p_clips
+		* @param p_threadPool (Optional)
+		* @param p_velocityWeight
+		*/
+		bool LoadOrBuild(const std::string& p_cachePath, const Rig::SkeletonDefinition& p_definition, const std::vector<const AnimationInstance*>& p_clips, Tools::ThreadPool* p_threadPool = nullptr, float p_velocityWeight = DefaultVelocityWeight);
+
+		/**
+		* Save the index to the given file. Return false if the file can't be written
+		* @param p_path
+		*/
+		bool Save(const std::string& p_path) const;
+
+		/**
+		* Return the number of clips
+		*/
+		uint32_t GetClipCount() const;
+
+		/**
+		* Return the index of the given clip, or UINT32_MAX if it isn't in the index
+		* @param p_clip
+		*/
+		uint32_t FindClip(const AnimationInstance& p_clip) const;
+
+		/**
+		* Return the key of the target clip the closest to the given key of the source clip (Keys are counted from the first key of the clips)
+		* @param p_sourceClip
+		* @param p_sourceKey
+		* @param p_targetClip
+		*/
+		uint32_t GetEntryKey(uint32_t p_sourceClip, uint32_t p_sourceKey, uint32_t p_targetClip) const;
+
+		/**
+		* Find the key of the target the closest to the given key of the source. Return false if one of the clips isn't in the index
+		* @param p_source
+		* @param p_sourceKey
+		* @param p_target
+		* @param p_entryKey
+		*/
+		bool FindEntryKey(const AnimationInstance& p_source, uint32_t p_sourceKey, const AnimationInstance& p_target, uint32_t& p_entryKey) const;
+
+	private:
+		/**
+		* Store the clips and calculate the pose features of their keys (One row per key)
+		* @param p_definition
+		* @param p_clips
+		* @param p_threadPool
+		*/
+		void ExtractFeatures(const Rig::SkeletonDefinition& p_definition, const std::vector<const AnimationInstance*>& p_clips, Tools::ThreadPool* p_threadPool);
+
+		/**
+		* Return a signature of the pose features, the velocity weight and the layout of the clips (Identifies the content of a cache file)
+		* @param p_velocityWeight
+		*/
+		uint64_t CalculateSignature(float p_velocityWeight) const;
+
+		/**
+		* Find the best entry keys of every pair of clips
+		* @param p_threadPool
+		* @param p_velocityWeight
+		*/
+		void FindEntryKeys(Tools::ThreadPool* p_threadPool, float p_velocityWeight);
+
+		/**
+		* Read the best entry keys from the given file. Return false if the file is missing or doesn't match the signature
+		* @param p_path
+		* @param p_signature
+		*/
+		bool Load(const std::string& p_path, uint64_t p_signature);
+
+	private:
+		std::vector<const AnimationInstance*> m_clips;
+
+		/* Keys of the clip i are the rows [m_clipFirstKeys[i], m_clipFirstKeys[i + 1]] of every table */
+		std::vector<uint32_t> m_clipFirstKeys;
+
+		/* Pose features : positions then velocities of every bone, one row of m_featureSize floats per key (Released once the index is built) */
+		uint32_t m_featureSize = 0;
+		std::vector<float> m_features;
+
+		/* Best entry keys : the row of a source key holds one entry key per target clip */
+		std::vector<uint32_t> m_entryKeys;
+		uint64_t m_signature = 0;
+	};
+}
+
+#endif // _TRANSITIONINDEX_H
@@ -0,0 +1,156 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _TRANSITIONSTACK_H
+#define _TRANSITIONSTACK_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "AnimationProgramming/Animation/AnimationInstance.h"
+#include "AnimationProgramming/Data/Transform.h"
+#include "AnimationProgramming/Tools/Snapshot.h"
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* A stack of overlapping transitions. Every animation keeps playing while the animations started after it fade in over it,
+	* so an interrupted transition continues from the blended pose instead of restarting from a frozen one.
+	* Entries hidden by a fully faded-in entry are removed, and the number of animations sampled per evaluation is capped :
+	* when a new animation exceeds the cap, the two oldest entries are blended once into a frozen pose (Which costs no sampling)
+	*/
+	class TransitionStack final
+	{
+	public:
+		/* Default maximum number of animations sampled per evaluation */
+		static constexpr uint32_t DefaultMaxSampledAnimations = 3;
+
+		/**
+		* Create an empty transition stack
+		* @param p_maxSampledAnimations (At least 1)
+		*/
+		TransitionStack(uint32_t p_maxSampledAnimations = DefaultMaxSampledAnimations);
+
+		/**
+		* Return the maximum number of animations sampled per evaluation
+		*/
+		uint32_t GetMaxSampledAnimations() const;
+
+		/**
+		* Set the maximum number of animations sampled per evaluation (Applied on the next push)
+		* @param p_maxSampledAnimations (At least 1)
+		*/
+		void SetMaxSampledAnimations(uint32_t p_maxSampledAnimations);
+
+		/**
+		* Start a transition to the given animation, from the current blended pose
+		* @param p_animation
+		* @param p_transitionDuration (0 to replace every entry)
+		* @param p_startTime (Time of the animation where it starts playing)
+		*/
+		void Push(const AnimationInstance& p_animation, float p_transitionDuration, float p_startTime = 0.0f);
+
+		/**
+		* Start a transition from the given frozen pose (Used when the previous animation isn't in the stack)
+		* @param p_pose
+		*/
+		void PushPose(const std::vector<Data::Transformation>& p_pose);
+
+		/**
+		* Remove every entry
+		*/
+		void Clear();
+
+		/**
+		* Return true if the stack has no entry
+		*/
+		bool IsEmpty() const;
+
+		/**
+		* Return true if more than one entry contributes to the pose
+		*/
+		bool IsTransitioning() const;
+
+		/**
+		* Return the number of entries (Sampled animations and frozen pose)
+		*/
+		uint32_t GetEntryCount() const;
+
+		/**
+		* Return the number of animations sampled by Evaluate
+		*/
+		uint32_t GetSampledAnimationCount() const;
+
+		/**
+		* Advance the time of every animation and the weight of every transition, then remove the entries that are fully hidden
+		* @param p_deltaTime (The speed coefficient of each animation is applied)
+		*/
+		void Update(float p_deltaTime);
+
+		/**
+		* Calculate the blended local pose (One transformation per bone, relative to the bind pose)
+		* @param p_pose
+		*/
+		void Evaluate(std::vector<Data::Transformation>& p_pose);
+
+		/**
+		* Append the entries (Animations, times, weights and frozen poses) to the given snapshot. The animations are saved as handles : they must outlive the snapshot
+		* @param p_snapshot
+		*/
+		void SaveSnapshot(Tools::Snapshot& p_snapshot) const;
+
+		/**
+		* Restore the entries saved by SaveSnapshot (The memory of the frozen poses is reused)
+		* @param p_snapshot
+		*/
+		void RestoreSnapshot(Tools::Snapshot& p_snapshot);
+
+	private:
+		struct Entry
+		{
+			/* nullptr for a frozen pose */
+			const AnimationInstance* animation = nullptr;
+			std::vector<Data::Transformation> frozenPose;
+
+			float time = 0.0f;
+			float elapsed = 0.0f;
+			float duration = 0.0f;
+
+			/**
+			* Return the weight of this entry over the entries below it
+			*/
+			float GetWeight() const;
+		};
+
+		/**
+		* Calculate the pose of the given entry
+		* @param p_entry
+		* @param p_pose
+		*/
+		void SampleEntry(const Entry& p_entry, std::vector<Data::Transformation>& p_pose) const;
+
+		/**
+		* Blend the entries from p_begin to p_end (Excluded) into p_pose
+		* @param p_begin
+		* @param p_end
+		* @param p_pose
+		*/
+		void BlendEntries(size_t p_begin, size_t p_end, std::vector<Data::Transformation>& p_pose);
+
+		/**
+		* Remove the entries hidden by a fully faded-in entry
+		*/
+		void Collapse();
+
+	private:
+		std::vector<Entry> m_entries;
+		std::vector<Data::Transformation> m_entryPose;
+		uint32_t m_maxSampledAnimations;
+	};
+}
+
+#endif // _TRANSITIONSTACK_H
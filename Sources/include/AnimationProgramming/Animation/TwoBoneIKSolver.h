@@ -0,0 +1,71 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _TWOBONEIKSOLVER_H
+#define _TWOBONEIKSOLVER_H
+
+#include <stdint.h>
+#include <vector>
+
+#include <AltMath/AltMath.h>
+
+#include "AnimationProgramming/Tools/ThreadPool.h"
+
+namespace AnimationProgramming::Animation
+{
+	/**
+	* Analytic two-bone IK (Thigh/calf/foot, upperarm/lowerarm/hand...) solved for arrays of requests, usually gathered from many characters.
+	* The angles of the chain are found with the law of cosines, then the chain is turned toward the target. No trigonometric function
+	* is evaluated : the rotations are built from the cosines through their half angles. The requests are solved LaneWidth at a time
+	*/
+	class TwoBoneIKSolver final
+	{
+	public:
+		/* Number of requests solved at once */
+		static constexpr uint32_t LaneWidth = 8;
+
+		/**
+		* A chain to solve, in model space
+		*/
+		struct Request
+		{
+			AltMath::Vector3f root;
+			AltMath::Vector3f joint;
+			AltMath::Vector3f end;
+			AltMath::Vector3f target;
+
+			/* Axis the joint bends around when the chain is straight (Normalized) */
+			AltMath::Vector3f bendAxis;
+
+			/* 0 to keep the chain, 1 to reach the target */
+			float weight;
+		};
+
+		/**
+		* Rotations to apply to a chain, in model space : the new world rotation of the root is rootRotation * rootWorldRotation,
+		* the new world rotation of the joint is jointRotation * jointWorldRotation
+		*/
+		struct Result
+		{
+			AltMath::Quaternion rootRotation;
+			AltMath::Quaternion jointRotation;
+		};
+
+		/* Prevent this static class from being instancied */
+		TwoBoneIKSolver() = delete;
+
+		/**
+		* Solve the given requests into p_results (One result per request). Targets out of reach are approached as close as possible
+		* @param p_requests
+		* @param p_results
+		* @param p_threadPool (Optional, the groups of requests are split between threads if provided)
+		*/
+		static void Solve(const std::vector<Request>& p_requests, std::vector<Result>& p_results, Tools::ThreadPool* p_threadPool = nullptr);
+	};
+}
+
+#endif // _TWOBONEIKSOLVER_H
@@ -11,6 +11,8 @@
 #include <AltMath/AltMath.h>
 
 #include "AnimationProgramming/Data/Transform.h"
+#include "AnimationProgramming/Data/Matrix3x4.h"
+#include "AnimationProgramming/Data/DualQuaternion.h"
 
 /* Forward declaration in global namespace */
 class ISimulation;
@@ -38,17 +40,30 @@ namespace AnimationProgramming::Core
 		static void Run(ISimulation& p_simulation, uint16_t p_windowWidth, uint16_t p_windowHeight);
 
 		/**
-		* Set a skinning pose for the given skeleton
-		* @param p_boneIndex
-		* @param p_localMatrix
+		* Set a skinning pose for the given skeleton. Affine matrices are expanded to 4x4 matrices here, because it is what the engine expects
+		* @param p_bonesTransformations
+		*/
+		static void SetSkinningPose(const std::vector<Data::Matrix3x4>& p_bonesTransformations);
+
+		/**
+		* Set a skinning pose for the given skeleton, as dual quaternions (8 floats per bone).
+		* The engine only has a matrix entry point, so this stand-in converts them back to 4x4 matrices. An engine with
+		* dual quaternion skinning would receive the dual quaternions as is (Blended by the shader instead of matrices)
+		* @param p_bonesTransformations
 		*/
-		static void SetSkinningPose(std::vector<AltMath::Matrix4f>& p_bonesTransformations);
+		static void SetSkinningPose(const std::vector<Data::DualQuaternion>& p_bonesTransformations);
 
 		/**
-		* Return the current skeleton bone count
+		* Return the current skeleton bone count (Without the IK bones)
 		*/
 		static uint32_t GetSkeletonBoneCount();
 
+		/**
+		* Return the number of IK bones of the skeleton (The last bones of the engine skeleton named ik_*). They follow the bones of the skeleton :
+		* the engine index of the IK bone i is GetSkeletonBoneCount() + i
+		*/
+		static uint32_t GetSkeletonIKBoneCount();
+
 		/**
 		* Return a skeleton bone name
 		* @param p_boneIndex
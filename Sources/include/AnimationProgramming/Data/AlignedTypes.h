@@ -0,0 +1,94 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _ALIGNEDTYPES_H
+#define _ALIGNEDTYPES_H
+
+#include <AltMath/AltMath.h>
+
+namespace AnimationProgramming::Data
+{
+	/**
+	* A Vector3 padded to 16 bytes so it can be loaded in one SSE register
+	*/
+	struct alignas(16) AlignedVector3 final
+	{
+		/**
+		* Create a zero vector
+		*/
+		AlignedVector3();
+
+		/**
+		* Create an aligned copy of the given vector
+		* @param p_vector
+		*/
+		AlignedVector3(const AltMath::Vector3f& p_vector);
+
+		/**
+		* Return an AltMath copy of this vector
+		*/
+		AltMath::Vector3f ToVector3() const;
+
+		float x;
+		float y;
+		float z;
+		float padding;
+	};
+
+	/**
+	* A quaternion stored as 4 aligned floats (x, y, z, w) so it can be loaded in one SSE register
+	*/
+	struct alignas(16) AlignedQuaternion final
+	{
+		/**
+		* Create an identity quaternion
+		*/
+		AlignedQuaternion();
+
+		/**
+		* Create an aligned copy of the given quaternion
+		* @param p_quaternion
+		*/
+		AlignedQuaternion(const AltMath::Quaternion& p_quaternion);
+
+		/**
+		* Return an AltMath copy of this quaternion
+		*/
+		AltMath::Quaternion ToQuaternion() const;
+
+		float x;
+		float y;
+		float z;
+		float w;
+	};
+
+	/**
+	* A row-major 4x4 matrix aligned on 32 bytes so that two rows can be loaded in one AVX register
+	*/
+	struct alignas(32) AlignedMatrix4 final
+	{
+		/**
+		* Create an identity matrix
+		*/
+		AlignedMatrix4();
+
+		/**
+		* Create an aligned copy of the given matrix
+		* @param p_matrix
+		*/
+		AlignedMatrix4(const AltMath::Matrix4f& p_matrix);
+
+		/**
+		* Return an AltMath copy of this matrix
+		*/
+		AltMath::Matrix4f ToMatrix4() const;
+
+		float elements[16];
+	};
+}
+
+#endif // _ALIGNEDTYPES_H
@@ -0,0 +1,95 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _DUALQUATERNION_H
+#define _DUALQUATERNION_H
+
+#include <AltMath/AltMath.h>
+
+#include "AnimationProgramming/Data/Matrix3x4.h"
+
+namespace AnimationProgramming::Data
+{
+	/**
+	* A unit dual quaternion representing a rigid transformation (Rotation + translation) in 8 floats.
+	* Blending dual quaternions keeps the volume of the skin around twisting joints, where blending matrices collapses it.
+	* Both parts are stored as (x, y, z, w)
+	*/
+	struct alignas(16) DualQuaternion final
+	{
+		/**
+		* Create an identity dual quaternion
+		*/
+		DualQuaternion();
+
+		/**
+		* Create a dual quaternion from a translation and a rotation (Translation * Rotation, like Matrix3x4).
+		* The rotation is normalized
+		* @param p_position
+		* @param p_rotation
+		*/
+		DualQuaternion(const AltMath::Vector3f& p_position, const AltMath::Quaternion& p_rotation);
+
+		/**
+		* Return the result of p_left * p_right (p_right is applied first)
+		* @param p_left
+		* @param p_right
+		*/
+		static DualQuaternion Multiply(const DualQuaternion& p_left, const DualQuaternion& p_right);
+
+		/**
+		* Return the result of this * p_other
+		* @param p_other
+		*/
+		DualQuaternion operator*(const DualQuaternion& p_other) const;
+
+		/**
+		* Return the rigid transformation between p_from (p_alpha = 0) and p_to (p_alpha = 1), blended along the shortest path and normalized
+		* @param p_from
+		* @param p_to
+		* @param p_alpha
+		*/
+		static DualQuaternion Interpolate(const DualQuaternion& p_from, const DualQuaternion& p_to, float p_alpha);
+
+		/**
+		* Return the inverse transformation (The conjugate of both parts, since the dual quaternion is unit)
+		*/
+		DualQuaternion Inverse() const;
+
+		/**
+		* Transform the given point (Rotation and translation are applied)
+		* @param p_point
+		*/
+		AltMath::Vector3f TransformPoint(const AltMath::Vector3f& p_point) const;
+
+		/**
+		* Transform the given direction (Only the rotation is applied)
+		* @param p_vector
+		*/
+		AltMath::Vector3f TransformVector(const AltMath::Vector3f& p_vector) const;
+
+		/**
+		* Return the translation part of the dual quaternion
+		*/
+		AltMath::Vector3f GetPosition() const;
+
+		/**
+		* Return the rotation part of the dual quaternion
+		*/
+		AltMath::Quaternion GetRotation() const;
+
+		/**
+		* Return the equivalent affine matrix
+		*/
+		Matrix3x4 ToMatrix3x4() const;
+
+		float real[4];
+		float dual[4];
+	};
+}
+
+#endif // _DUALQUATERNION_H
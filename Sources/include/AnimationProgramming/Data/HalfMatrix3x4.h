@@ -0,0 +1,52 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _HALFMATRIX3X4_H
+#define _HALFMATRIX3X4_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "AnimationProgramming/Data/Matrix3x4.h"
+
+namespace AnimationProgramming::Data
+{
+	/**
+	* A Matrix3x4 stored with half-precision floats (24 bytes instead of 48). Translations keep about 3 significant digits,
+	* so it is meant for characters that are far from the camera
+	*/
+	struct HalfMatrix3x4 final
+	{
+		/**
+		* Create an identity matrix
+		*/
+		HalfMatrix3x4();
+
+		/**
+		* Create a half-precision copy of the given matrix
+		* @param p_matrix
+		*/
+		HalfMatrix3x4(const Matrix3x4& p_matrix);
+
+		/**
+		* Return the full precision matrix
+		*/
+		Matrix3x4 ToMatrix3x4() const;
+
+		/**
+		* Convert an array of half-precision matrices to full precision matrices (Faster than converting them one by one)
+		* @param p_source
+		* @param p_destination
+		* @param p_count
+		*/
+		static void ToMatrix3x4(const HalfMatrix3x4* p_source, Matrix3x4* p_destination, size_t p_count);
+
+		uint16_t elements[12];
+	};
+}
+
+#endif // _HALFMATRIX3X4_H
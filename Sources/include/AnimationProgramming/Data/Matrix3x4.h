@@ -0,0 +1,98 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _MATRIX3X4_H
+#define _MATRIX3X4_H
+
+#include <AltMath/AltMath.h>
+
+namespace AnimationProgramming::Data
+{
+	/**
+	* A row-major affine matrix (3 rows of 4 floats). The implicit fourth row is always (0, 0, 0, 1).
+	* Every bone transformation is a rigid transformation (Rotation + translation), so we can skip the last row
+	* that a Matrix4 would carry. Each row fits in one SSE register
+	*/
+	struct alignas(16) Matrix3x4 final
+	{
+		static const Matrix3x4 Identity;
+
+		/**
+		* Create an identity matrix
+		*/
+		Matrix3x4();
+
+		/**
+		* Create a matrix from a translation and a rotation (Translation * Rotation)
+		* @param p_position
+		* @param p_rotation
+		*/
+		Matrix3x4(const AltMath::Vector3f& p_position, const AltMath::Quaternion& p_rotation);
+
+		/**
+		* Return the result of p_left * p_right (p_right is applied first)
+		* @param p_left
+		* @param p_right
+		*/
+		static Matrix3x4 Multiply(const Matrix3x4& p_left, const Matrix3x4& p_right);
+
+		/**
+		* Return the result of this * p_other
+		* @param p_other
+		*/
+		Matrix3x4 operator*(const Matrix3x4& p_other) const;
+
+		/**
+		* Return the inverse of the matrix, assuming it has no scale (Transposed rotation and inverted translation)
+		*/
+		Matrix3x4 RigidInverse() const;
+
+		/**
+		* Transform the given point (Rotation and translation are applied)
+		* @param p_point
+		*/
+		AltMath::Vector3f TransformPoint(const AltMath::Vector3f& p_point) const;
+
+		/**
+		* Transform the given direction (Only the rotation is applied)
+		* @param p_vector
+		*/
+		AltMath::Vector3f TransformVector(const AltMath::Vector3f& p_vector) const;
+
+		/**
+		* Return the translation part of the matrix
+		*/
+		AltMath::Vector3f GetPosition() const;
+
+		/**
+		* Return the rotation part of the matrix as a quaternion
+		*/
+		AltMath::Quaternion GetRotation() const;
+
+		/**
+		* Return a copy of this matrix as a 4x4 matrix (Should only be used at the engine boundary)
+		*/
+		AltMath::Matrix4f ToMatrix4() const;
+
+		/**
+		* Write the 16 floats of the equivalent row-major 4x4 matrix to the given destination
+		* @param p_destination
+		*/
+		void WriteMatrix4(float* p_destination) const;
+
+		/**
+		* Return the element at the given row and column
+		* @param p_row
+		* @param p_column
+		*/
+		float operator()(uint8_t p_row, uint8_t p_column) const;
+
+		float elements[12];
+	};
+}
+
+#endif // _MATRIX3X4_H
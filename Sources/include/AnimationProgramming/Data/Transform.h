@@ -11,6 +11,8 @@
 #include <AltMath/AltMath.h>
 
 #include "AnimationProgramming/Tools/Event.h"
+#include "AnimationProgramming/Tools/Snapshot.h"
+#include "AnimationProgramming/Data/Matrix3x4.h"
 
 namespace AnimationProgramming::Data
 {
@@ -71,12 +73,12 @@ namespace AnimationProgramming::Data
 		/**
 		* Return the local position of the transform
 		*/
-		AltMath::Vector3f GetLocalPosition() /* SHOULD BE CONST BUT CANT */;
+		AltMath::Vector3f GetLocalPosition() const;
 
 		/**
-		* Return local rotation of the transform
+		* Return local rotation of the transform (Normalized)
 		*/
-		AltMath::Quaternion GetLocalRotation() /* SHOULD BE CONST BUT CANT */;
+		AltMath::Quaternion GetLocalRotation() const;
 		
 		/**
 		* Return the world position of the transform
@@ -91,19 +93,34 @@ namespace AnimationProgramming::Data
 		/**
 		* Return the local matrix
 		*/
-		const AltMath::Matrix4f& GetLocalMatrix() const;
+		const Data::Matrix3x4& GetLocalMatrix() const;
 
 		/**
-		* Return the local matrix
+		* Return the world matrix
+		*/
+		const Data::Matrix3x4& GetWorldMatrix() const;
+
+		/**
+		* Append the local and world transformations to the given snapshot (The parent and the listeners aren't part of the state)
+		* @param p_snapshot
+		*/
+		void SaveSnapshot(Tools::Snapshot& p_snapshot) const;
+
+		/**
+		* Restore the local and world transformations saved by SaveSnapshot. The listeners aren't notified :
+		* the world transformations are restored as they were, consistent with the restored parents
+		* @param p_snapshot
 		*/
-		const AltMath::Matrix4f& GetWorldMatrix() const;
+		void RestoreSnapshot(Tools::Snapshot& p_snapshot);
 
 	public:
 		Tools::Event<> TransformChangedEvent;
 
 	private:
-		AltMath::Matrix4f								m_localMatrix;
-		AltMath::Matrix4f								m_worldMatrix;
+		Data::Matrix3x4									m_localMatrix;
+		Data::Matrix3x4									m_worldMatrix;
+		AltMath::Vector3f								m_localPosition;
+		AltMath::Quaternion								m_localRotation;
 		Transform*										m_parent;
 	};
 }
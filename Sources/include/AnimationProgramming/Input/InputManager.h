@@ -9,7 +9,9 @@
 #define _INPUTMANAGER_H
 
 #include <unordered_map>
-#include <Windows.h>
+#include <vector>
+
+#include "AnimationProgramming/Input/KeyEvent.h"
 
 namespace AnimationProgramming::Input
 {
@@ -22,10 +24,21 @@ namespace AnimationProgramming::Input
 		InputManager() = default;
 
 		/**
-		* Update the input manager
+		* Update the input manager from the keyboard (No key is ever pressed without a keyboard, on a headless run)
 		*/
 		void Update();
 
+		/**
+		* Update the input manager from the given changes of key states instead of the keyboard (A replayed frame)
+		* @param p_events
+		*/
+		void Update(const std::vector<KeyEvent>& p_events);
+
+		/**
+		* Return the changes of key states of the last update
+		*/
+		const std::vector<KeyEvent>& GetFrameEvents() const;
+
 		/**
 		* Check if the given key is pressed
 		* @param p_key
@@ -38,9 +51,18 @@ namespace AnimationProgramming::Input
 		*/
 		bool IsKeyEventOccured(char p_key);
 
+	private:
+		/**
+		* Set the state of the given key for this frame, and keep the change if any
+		* @param p_key
+		* @param p_pressed
+		*/
+		void SetKeyState(uint8_t p_key, bool p_pressed);
+
 	private:
 		std::unordered_map<char, bool> m_keyEvents;
 		std::unordered_map<char, bool> m_keyStates;
+		std::vector<KeyEvent> m_frameEvents;
 	};
 }
 
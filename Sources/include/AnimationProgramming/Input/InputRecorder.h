@@ -0,0 +1,59 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _INPUTRECORDER_H
+#define _INPUTRECORDER_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "AnimationProgramming/Input/KeyEvent.h"
+
+namespace AnimationProgramming::Input
+{
+	/**
+	* Write the delta time and the changes of key states of every frame of a session to a binary file, to replay it later (InputReplayer).
+	* A frame takes 5 bytes plus one byte per key changing of state : the delta time is written as is (Its exact bits), so that the replay is bit-exact
+	*/
+	class InputRecorder final
+	{
+	public:
+		/* File identifier ("APIR") and format version */
+		static constexpr uint32_t Magic = 0x52495041;
+		static constexpr uint32_t Version = 1;
+
+		/**
+		* Create the given file (Any existing one is replaced) and write the header
+		* @param p_path
+		*/
+		InputRecorder(const std::string& p_path);
+
+		/**
+		* Return true if the file could be created
+		*/
+		bool IsOpen() const;
+
+		/**
+		* Return the number of recorded frames
+		*/
+		uint32_t GetFrameCount() const;
+
+		/**
+		* Record a frame
+		* @param p_deltaTime
+		* @param p_events (The changes of key states of the frame, at most 255)
+		*/
+		void RecordFrame(float p_deltaTime, const std::vector<KeyEvent>& p_events);
+
+	private:
+		std::ofstream m_file;
+		uint32_t m_frameCount;
+	};
+}
+
+#endif // _INPUTRECORDER_H
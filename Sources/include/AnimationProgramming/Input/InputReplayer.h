@@ -0,0 +1,68 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _INPUTREPLAYER_H
+#define _INPUTREPLAYER_H
+
+#include <string>
+#include <vector>
+
+#include "AnimationProgramming/Input/KeyEvent.h"
+
+namespace AnimationProgramming::Input
+{
+	/**
+	* Read back, frame after frame, a session recorded by an InputRecorder. The whole file is loaded at once, so that reading a frame never touches the disk
+	*/
+	class InputReplayer final
+	{
+	public:
+		/**
+		* Load the given file. The replayer is empty if the file can't be read or isn't a recording
+		* @param p_path
+		*/
+		InputReplayer(const std::string& p_path);
+
+		/**
+		* Return true if the file has been loaded
+		*/
+		bool IsLoaded() const;
+
+		/**
+		* Return the number of frames of the recording
+		*/
+		uint32_t GetFrameCount() const;
+
+		/**
+		* Return true if every frame has been read
+		*/
+		bool IsFinished() const;
+
+		/**
+		* Go back to the first frame
+		*/
+		void Rewind();
+
+		/**
+		* Read the next frame. Return false (And leave the outputs untouched) if every frame has been read
+		* @param p_deltaTime
+		* @param p_events (Replaced by the changes of key states of the frame)
+		*/
+		bool ReadFrame(float& p_deltaTime, std::vector<KeyEvent>& p_events);
+
+	private:
+		std::vector<uint8_t> m_data;
+		uint32_t m_frameCount;
+		size_t m_cursor;
+		uint32_t m_frame;
+
+		/* States of the keys after the frames read so far (The recording only keeps the keys changing of state) */
+		bool m_keyStates[256];
+	};
+}
+
+#endif // _INPUTREPLAYER_H
@@ -0,0 +1,25 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _KEYEVENT_H
+#define _KEYEVENT_H
+
+#include <stdint.h>
+
+namespace AnimationProgramming::Input
+{
+	/**
+	* A change of state of a key during a frame
+	*/
+	struct KeyEvent
+	{
+		uint8_t key;
+		bool pressed;
+	};
+}
+
+#endif // _KEYEVENT_H
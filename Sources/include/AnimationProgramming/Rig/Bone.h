@@ -83,11 +83,21 @@ namespace AnimationProgramming::Rig
 		*/
 		uint32_t GetIndex();
 
+		/**
+		* Return the name of the bone
+		*/
+		const std::string& GetName() const;
+
 		/**
 		* Return a reference to the transform of the bone
 		*/
 		AnimationProgramming::Data::Transform& GetTransform();
 
+		/**
+		* Return a const reference to the transform of the bone
+		*/
+		const AnimationProgramming::Data::Transform& GetTransform() const;
+
 		/**
 		* Return a reference to the default transform of the bone
 		*/
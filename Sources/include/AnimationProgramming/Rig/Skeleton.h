@@ -8,20 +8,35 @@
 #ifndef _SKELETON_H
 #define _SKELETON_H
 
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "AnimationProgramming/Core/AnimationEngine.h"
+#include "AnimationProgramming/Data/Matrix3x4.h"
+#include "AnimationProgramming/Data/Transform.h"
 #include "AnimationProgramming/Rig/Bone.h"
 
 namespace AnimationProgramming::Rig
 {
+	class SkeletonDefinition;
+
 	/**
 	* Represents a set of bones
 	*/
 	class Skeleton final
 	{
 	public:
+		/**
+		* A bone of a custom rig
+		*/
+		struct BoneDescription
+		{
+			std::string name;
+			int32_t parentIndex;
+			Data::Transformation bindPose;
+		};
+
 		/**
 		* Constructor of the skeleton
 		*/
@@ -32,6 +47,12 @@ namespace AnimationProgramming::Rig
 		*/
 		void CreateSkeletonFromBindPose();
 
+		/**
+		* Create the skeleton of a custom rig (Another character than the one of the engine). The parents are given by index
+		* @param p_bones
+		*/
+		void CreateSkeletonFromDescription(const std::vector<BoneDescription>& p_bones);
+
 		/**
 		* Create the bones, following the directives of the BonesHierarchy (Must be created before calling CreateBone())
 		*/
@@ -47,8 +68,41 @@ namespace AnimationProgramming::Rig
 		*/
 		std::vector<Bone>& GetBones();
 
+		/**
+		* Return the index of the bone with the given name, or UINT32_MAX if there is none
+		* @param p_name
+		*/
+		uint32_t FindBone(const std::string& p_name) const;
+
+		/**
+		* Return the definition of the skeleton, extracted the first time it is requested. Every user of this skeleton (Animators, solvers...)
+		* shares the same definition, so the pose cache shares their poses. The skeleton must be created first
+		*/
+		std::shared_ptr<const SkeletonDefinition> GetDefinition();
+
+		/**
+		* Return the world matrix of the given bone for the given local pose (One transformation per bone, relative to the bind pose).
+		* The bones aren't modified
+		* @param p_boneIndex
+		* @param p_localPose
+		*/
+		Data::Matrix3x4 CalculateWorldMatrix(uint32_t p_boneIndex, const std::vector<Data::Transformation>& p_localPose);
+
+		/**
+		* Append the transformations of every bone to the given snapshot (The hierarchy and the bind pose aren't part of the state)
+		* @param p_snapshot
+		*/
+		void SaveSnapshot(Tools::Snapshot& p_snapshot) const;
+
+		/**
+		* Restore the transformations of every bone saved by SaveSnapshot (On a skeleton with the same bones)
+		* @param p_snapshot
+		*/
+		void RestoreSnapshot(Tools::Snapshot& p_snapshot);
+
 	private:
 		std::vector<Bone> m_bones;
+		std::shared_ptr<const SkeletonDefinition> m_definition;
 	};
 }
 
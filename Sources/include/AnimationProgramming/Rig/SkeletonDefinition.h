@@ -0,0 +1,145 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _SKELETONDEFINITION_H
+#define _SKELETONDEFINITION_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "AnimationProgramming/Data/DualQuaternion.h"
+#include "AnimationProgramming/Data/Matrix3x4.h"
+#include "AnimationProgramming/Data/Transform.h"
+#include "AnimationProgramming/Rig/Skeleton.h"
+
+namespace AnimationProgramming::Rig
+{
+	/**
+	* The immutable part of a skeleton (Names, hierarchy, bind pose, inverse bind palette, bone masks), extracted once and shared by every
+	* character using it (See SkeletonInstance). Bones are referenced by index, the parents come before their children in the evaluation order
+	*/
+	class SkeletonDefinition final
+	{
+	public:
+		/**
+		* Extract the definition of the given skeleton (The skeleton isn't modified and can be destroyed afterward)
+		* @param p_skeleton
+		*/
+		explicit SkeletonDefinition(Skeleton& p_skeleton);
+
+		/**
+		* Return the number of bones
+		*/
+		uint32_t GetBoneCount() const;
+
+		/**
+		* Return the number of matrices in a skinning palette (One per non-IK bone, in the bones order)
+		*/
+		uint32_t GetPaletteSize() const;
+
+		/**
+		* Return the name of the given bone
+		* @param p_bone
+		*/
+		const std::string& GetName(uint32_t p_bone) const;
+
+		/**
+		* Return the index of the bone with the given name, or UINT32_MAX if there is none
+		* @param p_name
+		*/
+		uint32_t FindBone(const std::string& p_name) const;
+
+		/**
+		* Return the parent index of every bone (-1 for the roots)
+		*/
+		const std::vector<int32_t>& GetParents() const;
+
+		/**
+		* Return the bones ordered so that every parent comes before its children
+		*/
+		const std::vector<uint32_t>& GetEvaluationOrder() const;
+
+		/**
+		* Return the local transformation of every bone in the bind pose
+		*/
+		const std::vector<Data::Transformation>& GetBindPose() const;
+
+		/**
+		* Return the inverse of the bind pose world matrix of every bone of the palette
+		*/
+		const std::vector<Data::Matrix3x4>& GetInverseBindPalette() const;
+
+		/**
+		* Return the inverse of the bind pose world dual quaternion of every bone of the palette
+		*/
+		const std::vector<Data::DualQuaternion>& GetInverseBindDualQuaternions() const;
+
+		/**
+		* Return the index in the palette of every bone (-1 for the IK bones, which aren't skinned)
+		*/
+		const std::vector<int32_t>& GetPaletteIndices() const;
+
+		/**
+		* Return a mask of the bones of the given branch (1 for the given bone and everything below it, 0 for the other bones).
+		* Can be used to layer a pose over another one (Upper body, arms...)
+		* @param p_root
+		*/
+		std::vector<uint8_t> CreateBranchMask(uint32_t p_root) const;
+
+		/**
+		* Calculate the model matrix of every bone from the given local pose (Relative to the bind pose, same rule as Bone::SetRelativePositionAndRotation)
+		* @param p_localPose
+		* @param p_modelMatrices (Resized to the number of bones)
+		*/
+		void CalculateModelMatrices(const std::vector<Data::Transformation>& p_localPose, std::vector<Data::Matrix3x4>& p_modelMatrices) const;
+
+		/**
+		* Calculate the skinning palette from the given model matrices : ModelMatrix * Inverse(BindPoseModelMatrix), IK bones ignored
+		* @param p_modelMatrices
+		* @param p_palette (Resized to the palette size)
+		*/
+		void CalculateSkinningPalette(const std::vector<Data::Matrix3x4>& p_modelMatrices, std::vector<Data::Matrix3x4>& p_palette) const;
+
+		/**
+		* Calculate the skinning palette as dual quaternions, directly from the given local pose
+		* @param p_localPose
+		* @param p_worldDualQuaternions (World dual quaternion of every bone, resized to the number of bones)
+		* @param p_palette (Resized to the palette size)
+		*/
+		void CalculateDualQuaternionPalette(const std::vector<Data::Transformation>& p_localPose, std::vector<Data::DualQuaternion>& p_worldDualQuaternions, std::vector<Data::DualQuaternion>& p_palette) const;
+
+		/**
+		* Return the transformation of the given bone in model space, for the given local pose (Only its parents are walked : cheaper than
+		* CalculateModelMatrices for a few bones)
+		* @param p_bone
+		* @param p_localPose
+		*/
+		Data::Transformation CalculateModelTransformation(uint32_t p_bone, const std::vector<Data::Transformation>& p_localPose) const;
+
+		/**
+		* Turn the bones of a chain so that each child lands on its given model position, written back into the local pose as rotations.
+		* Only the directions between the positions matter : the chain keeps its bone lengths
+		* @param p_bones (Each bone is the parent of the next one)
+		* @param p_positions (Model position of each bone of the chain)
+		* @param p_count
+		* @param p_localPose
+		*/
+		void ApplyChainPositions(const uint32_t* p_bones, const AltMath::Vector3f* p_positions, uint32_t p_count, std::vector<Data::Transformation>& p_localPose) const;
+
+	private:
+		std::vector<std::string> m_names;
+		std::vector<int32_t> m_parents;
+		std::vector<uint32_t> m_order;
+		std::vector<Data::Transformation> m_bindPose;
+		std::vector<Data::Matrix3x4> m_inverseBindPalette;
+		std::vector<Data::DualQuaternion> m_inverseBindDualQuaternions;
+		std::vector<int32_t> m_paletteIndices;
+	};
+}
+
+#endif // _SKELETONDEFINITION_H
@@ -0,0 +1,125 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _SKELETONINSTANCE_H
+#define _SKELETONINSTANCE_H
+
+#include <memory>
+#include <vector>
+
+#include "AnimationProgramming/Data/DualQuaternion.h"
+#include "AnimationProgramming/Data/Matrix3x4.h"
+#include "AnimationProgramming/Data/Transform.h"
+#include "AnimationProgramming/Rig/SkeletonDefinition.h"
+#include "AnimationProgramming/Tools/Snapshot.h"
+
+namespace AnimationProgramming::Rig
+{
+	/**
+	* The pose of one character using a shared SkeletonDefinition. Only the pose buffers are owned (Local pose, model matrices, skinning palettes) :
+	* no name, bone object or listener, so the memory of a crowd only grows with the size of its poses
+	*/
+	class SkeletonInstance final
+	{
+	public:
+		/**
+		* Create an instance of the given definition, in the bind pose
+		* @param p_definition
+		*/
+		SkeletonInstance(std::shared_ptr<const SkeletonDefinition> p_definition);
+
+		/**
+		* Return the shared definition of the skeleton
+		*/
+		const SkeletonDefinition& GetDefinition() const;
+
+		/**
+		* Return the local pose, to be written (One transformation per bone, relative to the bind pose)
+		*/
+		std::vector<Data::Transformation>& GetLocalPose();
+
+		/**
+		* Return the local pose (One transformation per bone, relative to the bind pose)
+		*/
+		const std::vector<Data::Transformation>& GetLocalPose() const;
+
+		/**
+		* Set every bone of the local pose back to the bind pose
+		*/
+		void ResetToBindPose();
+
+		/**
+		* Calculate the model matrices of every bone from the local pose (Same result as the bones of a Skeleton)
+		*/
+		void UpdateModelMatrices();
+
+		/**
+		* Calculate the skinning palette from the model matrices (Same matrices as Animator::GetSkinningPalette)
+		*/
+		void CalculateSkinningPalette();
+
+		/**
+		* Calculate the skinning palette as dual quaternions, directly from the local pose (The dual quaternion buffers stay empty until the first call)
+		*/
+		void CalculateDualQuaternionPalette();
+
+		/**
+		* Return the model matrix of every bone, calculated by the last UpdateModelMatrices
+		*/
+		const std::vector<Data::Matrix3x4>& GetModelMatrices() const;
+
+		/**
+		* Return the skinning palette calculated by the last CalculateSkinningPalette (One matrix per non-IK bone)
+		*/
+		const std::vector<Data::Matrix3x4>& GetSkinningPalette() const;
+
+		/**
+		* Return the skinning palette, to be written (A baked or cached palette replaces the calculated one)
+		*/
+		std::vector<Data::Matrix3x4>& GetSkinningPalette();
+
+		/**
+		* Return the dual quaternion palette calculated by the last CalculateDualQuaternionPalette (One dual quaternion per non-IK bone)
+		*/
+		const std::vector<Data::DualQuaternion>& GetDualQuaternionPalette() const;
+
+		/**
+		* Return the dual quaternion palette, to be written (A cached palette replaces the calculated one)
+		*/
+		std::vector<Data::DualQuaternion>& GetDualQuaternionPalette();
+
+		/**
+		* Return the number of bytes owned by the instance (The shared definition isn't counted)
+		*/
+		size_t GetMemorySize() const;
+
+		/**
+		* Append the pose buffers to the given snapshot
+		* @param p_snapshot
+		*/
+		void SaveSnapshot(Tools::Snapshot& p_snapshot) const;
+
+		/**
+		* Restore the pose buffers saved by SaveSnapshot
+		* @param p_snapshot
+		*/
+		void RestoreSnapshot(Tools::Snapshot& p_snapshot);
+
+	private:
+		std::shared_ptr<const SkeletonDefinition> m_definition;
+
+		std::vector<Data::Transformation> m_localPose;
+		std::vector<Data::Matrix3x4> m_modelMatrices;
+		std::vector<Data::Matrix3x4> m_skinningPalette;
+
+		/* Dual quaternion skinning (Only filled for the characters using it), the world dual quaternions are kept to reuse their memory between frames */
+		std::vector<Data::DualQuaternion> m_worldDualQuaternions;
+		std::vector<Data::DualQuaternion> m_dualQuaternionPalette;
+	};
+}
+
+#endif // _SKELETONINSTANCE_H
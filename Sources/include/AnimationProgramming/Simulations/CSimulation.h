@@ -11,9 +11,19 @@
 #include <Engine/Simulation.h>
 
 #include "AnimationProgramming/Input/InputManager.h"
+#include "AnimationProgramming/Input/InputRecorder.h"
+#include "AnimationProgramming/Input/InputReplayer.h"
 #include "AnimationProgramming/Rendering/Renderer.h"
 #include "AnimationProgramming/Rig/Skeleton.h"
+#include "AnimationProgramming/Animation/AimConstraints.h"
 #include "AnimationProgramming/Animation/Animator.h"
+#include "AnimationProgramming/Animation/FootContactTrack.h"
+#include "AnimationProgramming/Animation/FootPlanting.h"
+#include "AnimationProgramming/Animation/HeightfieldGroundProvider.h"
+#include "AnimationProgramming/Animation/LimbIK.h"
+#include "AnimationProgramming/Animation/PoseStreamWriter.h"
+#include "AnimationProgramming/Animation/SyncGroup.h"
+#include "AnimationProgramming/Animation/TransitionIndex.h"
 #include "AnimationProgramming/Rendering/TimelineDrawer.h"
 #include "AnimationProgramming/Rendering/SkeletonDrawer.h"
 
@@ -57,6 +67,41 @@ namespace AnimationProgramming::Simulations
 		*/
 		void CreateSkeleton();
 
+		/**
+		* Create the sync markers of the locomotion animations and the walk/run sync group
+		*/
+		void CreateSyncGroups();
+
+		/**
+		* Find the best entry keys between the animations (Or load them from the cache), and make the animator use them
+		*/
+		void CreateTransitionIndex();
+
+		/**
+		* Create the limb IK of the legs and the arms, and make the animator apply it (If enabled in the animation settings)
+		*/
+		void CreateLimbIK();
+
+		/**
+		* Create a look-at of the spine, the neck and the head toward a fixed point, and make the animator apply it (If enabled in the animation settings)
+		*/
+		void CreateLookAt();
+
+		/**
+		* Create an uneven ground and the foot planting of the walk and the run, and make the animator apply it (If enabled in the animation settings)
+		*/
+		void CreateFootPlanting();
+
+		/**
+		* Create the recorder or the replayer of the inputs of the session (If enabled in the animation settings)
+		*/
+		void CreateInputRecording();
+
+		/**
+		* Create the capture of the poses of the session (If enabled in the animation settings)
+		*/
+		void CreatePoseCapture();
+
 		/**
 		* Play the default animation
 		*/
@@ -94,6 +139,17 @@ namespace AnimationProgramming::Simulations
 		*/
 		void ToggleWireframe();
 
+		/**
+		* Switch to the next transition mode of the animator (Cross-fade, inertialization, stack), and print it to the console
+		*/
+		void ToggleTransitionMode();
+
+		/**
+		* Change the speed of the locomotion sync group (Between walk and run), and print it to the console
+		* @param p_offset
+		*/
+		void ChangeLocomotionSpeed(float p_offset);
+
 		/**
 		* Display the framerate (Calculated with the given deltaTime) to the console
 		* @param p_deltaTime
@@ -109,6 +165,11 @@ namespace AnimationProgramming::Simulations
 		/* Inputs */
 		Input::InputManager m_inputManager;
 
+		/* Recording or replay of the inputs of the session (Optional) */
+		std::unique_ptr<Input::InputRecorder> m_inputRecorder;
+		std::unique_ptr<Input::InputReplayer> m_inputReplayer;
+		std::vector<Input::KeyEvent> m_replayedKeyEvents;
+
 		/* Rig stuffs */
 		Rig::Skeleton m_skeleton;
 		Animation::Animator m_animator;
@@ -127,6 +188,29 @@ namespace AnimationProgramming::Simulations
 		std::unique_ptr<Animation::AnimationInstance> m_runAnimationInstance;
 		std::unique_ptr<Animation::AnimationInstance> m_dabAnimationInstance;
 		std::unique_ptr<Animation::AnimationInstance> m_squatAnimationInstance;
+
+		/* Walk/Run blending */
+		std::unique_ptr<Animation::SyncMarkerTrack> m_walkSyncMarkers;
+		std::unique_ptr<Animation::SyncMarkerTrack> m_runSyncMarkers;
+		Animation::SyncGroup m_locomotionSyncGroup;
+
+		/* Best entry keys between the animations */
+		Animation::TransitionIndex m_transitionIndex;
+
+		/* Two-bone IK of the limbs (Optional) */
+		std::unique_ptr<Animation::LimbIK> m_limbIK;
+
+		/* Look-at of the head (Optional) */
+		std::unique_ptr<Animation::AimConstraints> m_lookAt;
+
+		/* Adaptation to an uneven ground (Optional) */
+		std::unique_ptr<Animation::HeightfieldGroundProvider> m_ground;
+		std::unique_ptr<Animation::FootContactTrack> m_walkFootContacts;
+		std::unique_ptr<Animation::FootContactTrack> m_runFootContacts;
+		std::unique_ptr<Animation::FootPlanting> m_footPlanting;
+
+		/* Capture of the animated output (Optional) */
+		std::unique_ptr<Animation::PoseStreamWriter> m_poseCapture;
 	};
 }
 
@@ -0,0 +1,101 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _CPUSKINNING_H
+#define _CPUSKINNING_H
+
+#include <vector>
+
+#include "AnimationProgramming/Data/DualQuaternion.h"
+#include "AnimationProgramming/Data/Matrix3x4.h"
+#include "AnimationProgramming/Skinning/SkinWeights.h"
+#include "AnimationProgramming/Skinning/VertexBuffer.h"
+#include "AnimationProgramming/Tools/ThreadPool.h"
+
+namespace AnimationProgramming::Skinning
+{
+	/**
+	* Skinning on the CPU, for when the deformed mesh is needed without a GPU (Hit detection, bounding boxes, offline rendering).
+	* It takes the same palette as the GPU (Animator::GetSkinningPalette or Animator::GetDualQuaternionPalette). Linear blend
+	* skinning is processed by the instruction set selected by Tools::SIMD (8 vertices at once with AVX2)
+	*/
+	class CPUSkinning final
+	{
+	public:
+		/* Prevent this static class from being instancied */
+		CPUSkinning() = delete;
+
+		/* Default number of vertices per chunk when skinning with a thread pool */
+		static constexpr uint32_t DefaultChunkSize = 4096;
+
+		/**
+		* Deform the positions and normals of p_bindPose into p_result (Resized to the vertex count of p_bindPose).
+		* Deformed normals are normalized
+		* @param p_palette
+		* @param p_bindPose
+		* @param p_weights
+		* @param p_result
+		*/
+		static void Skin(const std::vector<Data::Matrix3x4>& p_palette, const VertexBuffer& p_bindPose, const SkinWeights& p_weights, VertexBuffer& p_result);
+
+		/**
+		* Same as Skin, with the vertices split in chunks processed by the threads of the given pool
+		* @param p_palette
+		* @param p_bindPose
+		* @param p_weights
+		* @param p_result
+		* @param p_threadPool
+		* @param p_chunkSize
+		*/
+		static void Skin(const std::vector<Data::Matrix3x4>& p_palette, const VertexBuffer& p_bindPose, const SkinWeights& p_weights, VertexBuffer& p_result, Tools::ThreadPool& p_threadPool, uint32_t p_chunkSize = DefaultChunkSize);
+
+		/**
+		* Deform the vertices in [p_begin, p_end) only (p_result must already have the right size)
+		* @param p_palette
+		* @param p_bindPose
+		* @param p_weights
+		* @param p_result
+		* @param p_begin
+		* @param p_end
+		*/
+		static void SkinRange(const std::vector<Data::Matrix3x4>& p_palette, const VertexBuffer& p_bindPose, const SkinWeights& p_weights, VertexBuffer& p_result, uint32_t p_begin, uint32_t p_end);
+
+		/**
+		* Dual quaternion skinning of p_bindPose into p_result (Resized to the vertex count of p_bindPose). This is the
+		* scalar reference of what a GPU receiving Animator::GetDualQuaternionPalette should produce
+		* @param p_palette
+		* @param p_bindPose
+		* @param p_weights
+		* @param p_result
+		*/
+		static void Skin(const std::vector<Data::DualQuaternion>& p_palette, const VertexBuffer& p_bindPose, const SkinWeights& p_weights, VertexBuffer& p_result);
+
+		/**
+		* Same as the dual quaternion Skin, with the vertices split in chunks processed by the threads of the given pool
+		* @param p_palette
+		* @param p_bindPose
+		* @param p_weights
+		* @param p_result
+		* @param p_threadPool
+		* @param p_chunkSize
+		*/
+		static void Skin(const std::vector<Data::DualQuaternion>& p_palette, const VertexBuffer& p_bindPose, const SkinWeights& p_weights, VertexBuffer& p_result, Tools::ThreadPool& p_threadPool, uint32_t p_chunkSize = DefaultChunkSize);
+
+		/**
+		* Dual quaternion skinning of the vertices in [p_begin, p_end) only (p_result must already have the right size)
+		* @param p_palette
+		* @param p_bindPose
+		* @param p_weights
+		* @param p_result
+		* @param p_begin
+		* @param p_end
+		*/
+		static void SkinRange(const std::vector<Data::DualQuaternion>& p_palette, const VertexBuffer& p_bindPose, const SkinWeights& p_weights, VertexBuffer& p_result, uint32_t p_begin, uint32_t p_end);
+	};
+}
+
+#endif // _CPUSKINNING_H
@@ -0,0 +1,50 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _SKINWEIGHTS_H
+#define _SKINWEIGHTS_H
+
+#include <stdint.h>
+#include <array>
+#include <vector>
+
+namespace AnimationProgramming::Skinning
+{
+	/**
+	* Bone influences of each vertex (Up to 4), stored as a structure of arrays like VertexBuffer.
+	* Bone indices refer to the skinning palette, so IK bones are not counted
+	*/
+	struct SkinWeights final
+	{
+		static constexpr uint8_t MaxInfluences = 4;
+
+		/**
+		* Resize every array to the given vertex count
+		* @param p_vertexCount
+		*/
+		void Resize(uint32_t p_vertexCount);
+
+		/**
+		* Return the number of vertices
+		*/
+		uint32_t GetVertexCount() const;
+
+		/**
+		* Set the influences of the given vertex. The weights are normalized so they sum to 1 (Unused influences must have a weight of 0)
+		* @param p_index
+		* @param p_boneIndices
+		* @param p_weights
+		*/
+		void SetInfluences(uint32_t p_index, const std::array<uint32_t, MaxInfluences>& p_boneIndices, const std::array<float, MaxInfluences>& p_weights);
+
+		/* 32 bits indices, so AVX2 can gather the palette with them directly */
+		std::array<std::vector<int32_t>, MaxInfluences> boneIndices;
+		std::array<std::vector<float>, MaxInfluences> weights;
+	};
+}
+
+#endif // _SKINWEIGHTS_H
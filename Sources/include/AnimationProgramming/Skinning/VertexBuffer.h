@@ -0,0 +1,64 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _VERTEXBUFFER_H
+#define _VERTEXBUFFER_H
+
+#include <stdint.h>
+#include <vector>
+
+#include <AltMath/AltMath.h>
+
+namespace AnimationProgramming::Skinning
+{
+	/**
+	* Vertex positions and normals stored as a structure of arrays (One array per component), so SIMD
+	* kernels can load the same component of consecutive vertices in one register
+	*/
+	struct VertexBuffer final
+	{
+		/**
+		* Resize every component array to the given vertex count
+		* @param p_vertexCount
+		*/
+		void Resize(uint32_t p_vertexCount);
+
+		/**
+		* Return the number of vertices
+		*/
+		uint32_t GetVertexCount() const;
+
+		/**
+		* Set the position and the normal of the given vertex
+		* @param p_index
+		* @param p_position
+		* @param p_normal
+		*/
+		void SetVertex(uint32_t p_index, const AltMath::Vector3f& p_position, const AltMath::Vector3f& p_normal);
+
+		/**
+		* Return the position of the given vertex
+		* @param p_index
+		*/
+		AltMath::Vector3f GetPosition(uint32_t p_index) const;
+
+		/**
+		* Return the normal of the given vertex
+		* @param p_index
+		*/
+		AltMath::Vector3f GetNormal(uint32_t p_index) const;
+
+		std::vector<float> positionsX;
+		std::vector<float> positionsY;
+		std::vector<float> positionsZ;
+		std::vector<float> normalsX;
+		std::vector<float> normalsY;
+		std::vector<float> normalsZ;
+	};
+}
+
+#endif // _VERTEXBUFFER_H
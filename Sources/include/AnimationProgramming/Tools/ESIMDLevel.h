@@ -0,0 +1,24 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _ESIMDLEVEL_H
+#define _ESIMDLEVEL_H
+
+namespace AnimationProgramming::Tools
+{
+	/**
+	* Instruction sets that the SIMD math kernels can be dispatched to (Ordered from the slowest to the fastest)
+	*/
+	enum class ESIMDLevel
+	{
+		SCALAR,
+		SSE41,
+		AVX2
+	};
+}
+
+#endif // _ESIMDLEVEL_H
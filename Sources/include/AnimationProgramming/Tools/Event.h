@@ -9,6 +9,7 @@
 #define _EVENT_H
 
 #include <functional>
+#include <stdint.h>
 
 namespace AnimationProgramming::Tools
 {
@@ -0,0 +1,85 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _FIXEDTIMESTEP_H
+#define _FIXEDTIMESTEP_H
+
+#include <stdint.h>
+
+#include "AnimationProgramming/Tools/Snapshot.h"
+
+namespace AnimationProgramming::Tools
+{
+	/**
+	* A clock ticking at a fixed rate, whatever the frame rate : each frame runs zero or more ticks, and the time left until
+	* the next tick is kept for the next frame. The alpha tells where the frame stands between the last two ticks
+	*/
+	class FixedTimestep final
+	{
+	public:
+		/* Ticks run in one frame at most by default : a long frame slows the clock down instead of costing more */
+		static constexpr uint32_t DefaultMaxTicksPerFrame = 4;
+
+		/**
+		* Create the clock
+		* @param p_tickRate (Ticks per second)
+		* @param p_maxTicksPerFrame
+		*/
+		FixedTimestep(float p_tickRate = 30.0f, uint32_t p_maxTicksPerFrame = DefaultMaxTicksPerFrame);
+
+		/**
+		* Change the tick rate (The time accumulated is kept)
+		* @param p_tickRate (Ticks per second)
+		*/
+		void SetTickRate(float p_tickRate);
+
+		/**
+		* Return the tick rate (Ticks per second)
+		*/
+		float GetTickRate() const;
+
+		/**
+		* Return the duration of a tick (In seconds)
+		*/
+		float GetTickTime() const;
+
+		/**
+		* Add the time of a frame and return the number of ticks to run for it
+		* @param p_deltaTime
+		*/
+		uint32_t Advance(float p_deltaTime);
+
+		/**
+		* Return the time accumulated since the last tick, relative to the duration of a tick (In [0, 1))
+		*/
+		float GetAlpha() const;
+
+		/**
+		* Forget the time accumulated
+		*/
+		void Reset();
+
+		/**
+		* Append the tick rate and the time accumulated to the given snapshot
+		* @param p_snapshot
+		*/
+		void SaveSnapshot(Snapshot& p_snapshot) const;
+
+		/**
+		* Restore the tick rate and the time accumulated saved by SaveSnapshot
+		* @param p_snapshot
+		*/
+		void RestoreSnapshot(Snapshot& p_snapshot);
+
+	private:
+		float m_tickTime;
+		uint32_t m_maxTicksPerFrame;
+		float m_accumulatedTime;
+	};
+}
+
+#endif // _FIXEDTIMESTEP_H
@@ -0,0 +1,95 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _KDTREE_H
+#define _KDTREE_H
+
+#include <stdint.h>
+#include <vector>
+
+namespace AnimationProgramming::Tools
+{
+	/**
+	* A k-d tree over the rows of a row-major float matrix, used for nearest neighbour searches in high dimension (Pose features for example).
+	* The rows are reordered in place when the tree is built, so that the rows of a leaf are contiguous in memory : the tree doesn't copy
+	* the points, it only keeps a pointer to them (They must outlive the tree and not be moved)
+	*/
+	class KDTree final
+	{
+	public:
+		/* Default maximum number of rows of a leaf */
+		static constexpr uint32_t DefaultLeafSize = 16;
+
+		/**
+		* Build the tree, reordering the rows of p_points. GetOriginalIndex gives the index a row had before the reordering
+		* @param p_points
+		* @param p_count (Number of rows)
+		* @param p_dimensions (Number of values of a row used by the search)
+		* @param p_stride (Number of floats between two rows, at least p_dimensions)
+		* @param p_leafSize
+		*/
+		void Build(float* p_points, uint32_t p_count, uint32_t p_dimensions, uint32_t p_stride, uint32_t p_leafSize = DefaultLeafSize);
+
+		/**
+		* Return the number of rows of the tree
+		*/
+		uint32_t GetCount() const;
+
+		/**
+		* Return the index the given row had before the tree reordered the rows
+		* @param p_row
+		*/
+		uint32_t GetOriginalIndex(uint32_t p_row) const;
+
+		/**
+		* Return the row of the point closest to p_query (Squared euclidean distance), and store its squared distance into p_squaredDistance.
+		* With a budget, the search stops after visiting p_maxLeafVisits leaves and returns the closest row found so far (The closest leaves are
+		* visited first, so the result is usually exact long before the whole tree is visited). Return UINT32_MAX if the tree is empty
+		* @param p_query
+		* @param p_squaredDistance
+		* @param p_maxLeafVisits (0 for an exact search)
+		*/
+		uint32_t FindNearest(const float* p_query, float& p_squaredDistance, uint32_t p_maxLeafVisits = 0) const;
+
+	private:
+		struct Node
+		{
+			/* Leaves have no children : their rows are [begin, end) */
+			uint32_t begin;
+			uint32_t end;
+			uint32_t children[2];
+			uint32_t dimension;
+			float split;
+		};
+
+		/**
+		* Create the node of the rows [p_begin, p_end), split it recursively, and return its index
+		* @param p_begin
+		* @param p_end
+		*/
+		uint32_t BuildNode(uint32_t p_begin, uint32_t p_end);
+
+		/**
+		* Return the squared distance between p_query and the given row
+		* @param p_query
+		* @param p_row
+		*/
+		float CalculateSquaredDistance(const float* p_query, uint32_t p_row) const;
+
+	private:
+		float* m_points = nullptr;
+		uint32_t m_count = 0;
+		uint32_t m_dimensions = 0;
+		uint32_t m_stride = 0;
+		uint32_t m_leafSize = DefaultLeafSize;
+
+		std::vector<Node> m_nodes;
+		std::vector<uint32_t> m_originalIndices;
+	};
+}
+
+#endif // _KDTREE_H
@@ -5,8 +5,10 @@
 */
 
 #pragma once
-#ifndef _MATH_H
-#define _MATH_H
+#ifndef _TOOLS_MATH_H
+#define _TOOLS_MATH_H
+
+#include <stdint.h>
 
 #include <AltMath/AltMath.h>
 
@@ -18,6 +20,12 @@ namespace AnimationProgramming::Tools
 	class Math final
 	{
 	public:
+		/* Below this squared length, a direction is considered degenerate */
+		static constexpr float MinimumLength2 = 1e-12f;
+
+		/* Below this cosine, two directions are considered opposite */
+		static constexpr float OppositeCosine = -0.999999f;
+
 		/* Prevent this static class from being instancied */
 		Math() = delete;
 
@@ -26,7 +34,39 @@ namespace AnimationProgramming::Tools
 		* @param p_euler
 		*/
 		static AltMath::Quaternion CreateQuaternionFromEuler(const AltMath::Vector3f& p_euler);
+
+		/**
+		* Return a normalized direction orthogonal to the given one
+		* @param p_direction (Normalized)
+		*/
+		static AltMath::Vector3f CalculateOrthogonal(const AltMath::Vector3f& p_direction);
+
+		/**
+		* Return the given vector normalized, or the fallback if it is degenerate (See MinimumLength2)
+		* @param p_vector
+		* @param p_fallback
+		*/
+		static AltMath::Vector3f Normalize(const AltMath::Vector3f& p_vector, const AltMath::Vector3f& p_fallback);
+
+		/**
+		* Return the shortest rotation turning p_from onto p_to (Half a turn around an orthogonal axis if they are opposite, see OppositeCosine)
+		* @param p_from (Normalized)
+		* @param p_to (Normalized)
+		*/
+		static AltMath::Quaternion CalculateRotationBetween(const AltMath::Vector3f& p_from, const AltMath::Vector3f& p_to);
+
+		/**
+		* Convert a float to a half-precision float (IEEE 754 binary16, rounded to nearest even)
+		* @param p_value
+		*/
+		static uint16_t FloatToHalf(float p_value);
+
+		/**
+		* Convert a half-precision float (IEEE 754 binary16) to a float
+		* @param p_value
+		*/
+		static float HalfToFloat(uint16_t p_value);
 	};
 }
 
-#endif // _MATH_H
\ No newline at end of file
+#endif // _TOOLS_MATH_H
\ No newline at end of file
@@ -0,0 +1,136 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _SIMD_H
+#define _SIMD_H
+
+#include <stdint.h>
+
+#include <AltMath/AltMath.h>
+
+#include "AnimationProgramming/Data/AlignedTypes.h"
+#include "AnimationProgramming/Tools/ESIMDLevel.h"
+
+namespace AnimationProgramming::Tools
+{
+	/**
+	* Float specializations of the AltMath operations used per bone per frame (Matrix4 multiply and inverse,
+	* quaternion slerp and conversion to matrix, vector lerp). Every operation is dispatched at runtime to the
+	* best instruction set supported by the CPU, the scalar level forwards to AltMath
+	*/
+	class SIMD final
+	{
+	public:
+		/* Prevent this static class from being instancied */
+		SIMD() = delete;
+
+		/**
+		* Detect the instruction sets supported by the CPU and select the fastest one.
+		* Before this call, every operation uses the scalar level
+		*/
+		static void Initialize();
+
+		/**
+		* Return the fastest level supported by the CPU
+		*/
+		static ESIMDLevel GetSupportedLevel();
+
+		/**
+		* Return the level currently used by the operations
+		*/
+		static ESIMDLevel GetLevel();
+
+		/**
+		* Force the level used by the operations (Clamped to the supported level). Mostly useful to compare levels
+		* @param p_level
+		*/
+		static void SetLevel(ESIMDLevel p_level);
+
+		/**
+		* Return the name of the given level
+		* @param p_level
+		*/
+		static const char* GetLevelName(ESIMDLevel p_level);
+
+		/**
+		* Store p_left * p_right into p_result
+		* @param p_left
+		* @param p_right
+		* @param p_result
+		*/
+		static void Multiply(const Data::AlignedMatrix4& p_left, const Data::AlignedMatrix4& p_right, Data::AlignedMatrix4& p_result);
+
+		/**
+		* Store the inverse of p_matrix into p_result (Identity if the matrix isn't invertible, like AltMath does)
+		* @param p_matrix
+		* @param p_result
+		*/
+		static void Inverse(const Data::AlignedMatrix4& p_matrix, Data::AlignedMatrix4& p_result);
+
+		/**
+		* Store the spherical interpolation between p_start and p_end into p_result
+		* @param p_start
+		* @param p_end
+		* @param p_alpha
+		* @param p_result
+		*/
+		static void Slerp(const Data::AlignedQuaternion& p_start, const Data::AlignedQuaternion& p_end, float p_alpha, Data::AlignedQuaternion& p_result);
+
+		/**
+		* Store the rotation matrix of the given quaternion into p_result
+		* @param p_quaternion
+		* @param p_result
+		*/
+		static void ToMatrix4(const Data::AlignedQuaternion& p_quaternion, Data::AlignedMatrix4& p_result);
+
+		/**
+		* Store the linear interpolation between p_start and p_end into p_result
+		* @param p_start
+		* @param p_end
+		* @param p_alpha
+		* @param p_result
+		*/
+		static void Lerp(const Data::AlignedVector3& p_start, const Data::AlignedVector3& p_end, float p_alpha, Data::AlignedVector3& p_result);
+
+		/**
+		* Return p_left * p_right
+		* @param p_left
+		* @param p_right
+		*/
+		static AltMath::Matrix4f Multiply(const AltMath::Matrix4f& p_left, const AltMath::Matrix4f& p_right);
+
+		/**
+		* Return the inverse of p_matrix
+		* @param p_matrix
+		*/
+		static AltMath::Matrix4f Inverse(const AltMath::Matrix4f& p_matrix);
+
+		/**
+		* Return the spherical interpolation between p_start and p_end. Unlike AltMath, the inputs are not modified
+		* @param p_start
+		* @param p_end
+		* @param p_alpha
+		*/
+		static AltMath::Quaternion Slerp(const AltMath::Quaternion& p_start, const AltMath::Quaternion& p_end, float p_alpha);
+
+		/**
+		* Return the rotation matrix of the given quaternion
+		* @param p_quaternion
+		*/
+		static AltMath::Matrix4f ToMatrix4(const AltMath::Quaternion& p_quaternion);
+
+		/**
+		* Return the linear interpolation between p_start and p_end
+		* @param p_start
+		* @param p_end
+		* @param p_alpha
+		*/
+		static AltMath::Vector3f Lerp(const AltMath::Vector3f& p_start, const AltMath::Vector3f& p_end, float p_alpha);
+	};
+}
+
+#endif // _SIMD_H
@@ -0,0 +1,25 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _SIMDTARGET_H
+#define _SIMDTARGET_H
+
+/**
+* Attributes to put in front of a function that uses the intrinsics of a given instruction set.
+* Such functions must only be called when Tools::SIMD reports that the CPU supports the instruction set.
+* MSVC allows any intrinsic in any function, other compilers need the instruction set to be enabled per function.
+* The AVX2 level also includes FMA and F16C (Every CPU with AVX2 supports them, Tools::SIMD checks them anyway)
+*/
+#if defined(_MSC_VER)
+#define SIMD_TARGET_SSE41
+#define SIMD_TARGET_AVX2
+#else
+#define SIMD_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2,fma,f16c")))
+#endif
+
+#endif // _SIMDTARGET_H
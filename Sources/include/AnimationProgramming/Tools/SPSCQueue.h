@@ -0,0 +1,111 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _SPSCQUEUE_H
+#define _SPSCQUEUE_H
+
+#include <stdint.h>
+#include <atomic>
+#include <vector>
+
+namespace AnimationProgramming::Tools
+{
+	/**
+	* A lock-free queue between one producer thread and one consumer thread, with a fixed number of slots.
+	* The slots are constructed once and reused : the producer fills the slot returned by BeginPush in place,
+	* so pushing a value that owns memory (A vector for example) doesn't allocate once the slot has grown
+	*/
+	template<typename T>
+	class SPSCQueue final
+	{
+	public:
+		/**
+		* Create a queue that can hold the given number of values
+		* @param p_capacity
+		*/
+		SPSCQueue(uint32_t p_capacity) : m_slots(p_capacity + 1), m_head(0), m_tail(0)
+		{
+		}
+
+		SPSCQueue(const SPSCQueue&) = delete;
+		SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+		/**
+		* Return the number of values the queue can hold
+		*/
+		uint32_t GetCapacity() const
+		{
+			return static_cast<uint32_t>(m_slots.size()) - 1;
+		}
+
+		/**
+		* Return true if the queue holds no value (Exact from the consumer thread only)
+		*/
+		bool IsEmpty() const
+		{
+			return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+		}
+
+		/**
+		* Return the slot to fill, or nullptr if the queue is full (Producer thread only). The value is pushed by EndPush
+		*/
+		T* BeginPush()
+		{
+			const uint32_t tail = m_tail.load(std::memory_order_relaxed);
+
+			if (Next(tail) == m_head.load(std::memory_order_acquire))
+				return nullptr;
+
+			return &m_slots[tail];
+		}
+
+		/**
+		* Push the slot returned by the last BeginPush (Producer thread only)
+		*/
+		void EndPush()
+		{
+			m_tail.store(Next(m_tail.load(std::memory_order_relaxed)), std::memory_order_release);
+		}
+
+		/**
+		* Return the oldest value, or nullptr if the queue is empty (Consumer thread only). The value stays in the queue until Pop is called
+		*/
+		T* Front()
+		{
+			const uint32_t head = m_head.load(std::memory_order_relaxed);
+
+			if (head == m_tail.load(std::memory_order_acquire))
+				return nullptr;
+
+			return &m_slots[head];
+		}
+
+		/**
+		* Remove the value returned by the last Front, its slot can be filled again (Consumer thread only)
+		*/
+		void Pop()
+		{
+			m_head.store(Next(m_head.load(std::memory_order_relaxed)), std::memory_order_release);
+		}
+
+	private:
+		uint32_t Next(uint32_t p_index) const
+		{
+			return p_index + 1 == m_slots.size() ? 0 : p_index + 1;
+		}
+
+	private:
+		/* One slot more than the capacity : the queue is full when the tail is right before the head */
+		std::vector<T> m_slots;
+
+		/* Next slot to read (Written by the consumer) and next slot to fill (Written by the producer), on their own cache lines */
+		alignas(64) std::atomic<uint32_t> m_head;
+		alignas(64) std::atomic<uint32_t> m_tail;
+	};
+}
+
+#endif // _SPSCQUEUE_H
@@ -0,0 +1,202 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _SNAPSHOT_H
+#define _SNAPSHOT_H
+
+#include <stdint.h>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <AltMath/AltMath.h>
+
+namespace AnimationProgramming::Tools
+{
+	/**
+	* A flat block of bytes holding the state of some objects (An animator, its timeline and its skeleton for example), saved and restored with memcpy.
+	* Only trivially copyable values are written as bytes (Numbers, enums, matrices, handles to shared objects) : listeners and pointers to owned memory never are,
+	* so the bytes can be copied anywhere (A ring buffer of rollback frames, another snapshot). The memory is kept when the snapshot is cleared,
+	* saving the same objects again doesn't allocate.
+	* AltMath vectors and quaternions have their own copy constructors : they are converted to plain floats instead (Overloads below, also used by transformations)
+	*/
+	class Snapshot final
+	{
+	public:
+		/**
+		* Create an empty snapshot
+		*/
+		Snapshot() = default;
+
+		/**
+		* Empty the snapshot (Its memory is kept) to save new states
+		*/
+		void Clear();
+
+		/**
+		* Go back to the first byte, to restore the saved states in the order they were saved
+		*/
+		void Rewind();
+
+		/**
+		* Return the number of saved bytes
+		*/
+		size_t GetSize() const;
+
+		/**
+		* Return the saved bytes
+		*/
+		const uint8_t* GetData() const;
+
+		/**
+		* Replace the content of the snapshot by the given bytes (Saved by another snapshot), and rewind it
+		* @param p_data
+		* @param p_size
+		*/
+		void Assign(const uint8_t* p_data, size_t p_size);
+
+		/**
+		* Return true if every saved byte has been read, and no read went past the end
+		*/
+		bool IsFullyRead() const;
+
+		/**
+		* Append the given value
+		* @param p_value
+		*/
+		template<typename T>
+		void Write(const T& p_value)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be saved in a snapshot");
+
+			WriteBytes(&p_value, sizeof(T));
+		}
+
+		/**
+		* Append the number of values of the given vector, then its values
+		* @param p_values
+		*/
+		template<typename T>
+		void WriteArray(const std::vector<T>& p_values)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be saved in a snapshot");
+
+			Write(static_cast<uint32_t>(p_values.size()));
+			WriteBytes(p_values.data(), p_values.size() * sizeof(T));
+		}
+
+		/**
+		* Read the next value
+		* @param p_value
+		*/
+		template<typename T>
+		void Read(T& p_value)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be saved in a snapshot");
+
+			ReadBytes(&p_value, sizeof(T));
+		}
+
+		/**
+		* Read the next vector (Resized to its saved size, so its memory is reused when the size doesn't change)
+		* @param p_values
+		*/
+		template<typename T>
+		void ReadArray(std::vector<T>& p_values)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be saved in a snapshot");
+
+			const uint32_t size = ReadArraySize(sizeof(T));
+
+			if (m_overflow)
+				return;
+
+			p_values.resize(size);
+			ReadBytes(p_values.data(), p_values.size() * sizeof(T));
+		}
+
+		/**
+		* Read the number of elements of the next array (Written as a uint32_t before its elements). The snapshot is flagged as overflowed,
+		* and 0 is returned, if there are less than p_elementSize bytes left per element
+		* @param p_elementSize
+		*/
+		uint32_t ReadArraySize(size_t p_elementSize);
+
+		/**
+		* Append the given vector as plain floats
+		* @param p_value
+		*/
+		void Write(const AltMath::Vector3f& p_value);
+
+		/**
+		* Append the given quaternion as plain floats
+		* @param p_value
+		*/
+		void Write(const AltMath::Quaternion& p_value);
+
+		/**
+		* Append the number of vectors, then the vectors as plain floats
+		* @param p_values
+		*/
+		void WriteArray(const std::vector<AltMath::Vector3f>& p_values);
+
+		/**
+		* Append the number of transformations, then the transformations as plain floats (Position, then rotation)
+		* @param p_values
+		*/
+		void WriteArray(const std::vector<std::pair<AltMath::Vector3f, AltMath::Quaternion>>& p_values);
+
+		/**
+		* Read the next vector
+		* @param p_value
+		*/
+		void Read(AltMath::Vector3f& p_value);
+
+		/**
+		* Read the next quaternion
+		* @param p_value
+		*/
+		void Read(AltMath::Quaternion& p_value);
+
+		/**
+		* Read the next vector of vectors (Resized to its saved size)
+		* @param p_values
+		*/
+		void ReadArray(std::vector<AltMath::Vector3f>& p_values);
+
+		/**
+		* Read the next vector of transformations (Resized to its saved size)
+		* @param p_values
+		*/
+		void ReadArray(std::vector<std::pair<AltMath::Vector3f, AltMath::Quaternion>>& p_values);
+
+	private:
+		/**
+		* Append the given bytes, growing the memory if needed
+		* @param p_source
+		* @param p_size
+		*/
+		void WriteBytes(const void* p_source, size_t p_size);
+
+		/**
+		* Read the next bytes, or flag the snapshot as overflowed if there aren't enough bytes left
+		* @param p_destination
+		* @param p_size
+		*/
+		void ReadBytes(void* p_destination, size_t p_size);
+
+	private:
+		/* Grows but never shrinks : m_size is the number of saved bytes */
+		std::vector<uint8_t> m_data;
+		size_t m_size = 0;
+		size_t m_cursor = 0;
+		bool m_overflow = false;
+	};
+}
+
+#endif // _SNAPSHOT_H
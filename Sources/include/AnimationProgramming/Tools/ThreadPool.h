@@ -0,0 +1,78 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _THREADPOOL_H
+#define _THREADPOOL_H
+
+#include <stdint.h>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace AnimationProgramming::Tools
+{
+	/**
+	* A fixed set of worker threads used to split data-parallel work (Like skinning) into chunks.
+	* The thread calling ParallelFor also processes chunks, so a pool without worker runs everything inline
+	*/
+	class ThreadPool final
+	{
+	public:
+		/**
+		* A function processing the elements in [p_begin, p_end)
+		*/
+		using RangeFunction = std::function<void(uint32_t p_begin, uint32_t p_end)>;
+
+		/**
+		* Create the pool and start its workers
+		* @param p_workerCount (Number of threads created in addition to the calling thread)
+		*/
+		ThreadPool(uint32_t p_workerCount = GetDefaultWorkerCount());
+
+		/**
+		* Stop and join every worker
+		*/
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		/**
+		* Return the number of threads that process chunks during ParallelFor (Workers + calling thread)
+		*/
+		uint32_t GetThreadCount() const;
+
+		/**
+		* Call p_function on chunks of at most p_chunkSize elements covering [0, p_count), in parallel.
+		* Return once every chunk has been processed
+		* @param p_count
+		* @param p_chunkSize
+		* @param p_function
+		*/
+		void ParallelFor(uint32_t p_count, uint32_t p_chunkSize, const RangeFunction& p_function);
+
+		/**
+		* Return one worker per hardware thread, minus the calling thread
+		*/
+		static uint32_t GetDefaultWorkerCount();
+
+	private:
+		void WorkerLoop();
+
+	private:
+		std::vector<std::thread> m_workers;
+		std::queue<std::function<void()>> m_tasks;
+		std::mutex m_tasksMutex;
+		std::condition_variable m_tasksCondition;
+		bool m_stopping = false;
+	};
+}
+
+#endif // _THREADPOOL_H
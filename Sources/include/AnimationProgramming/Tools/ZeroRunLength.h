@@ -0,0 +1,45 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _ZERORUNLENGTH_H
+#define _ZERORUNLENGTH_H
+
+#include <cstddef>
+#include <stdint.h>
+#include <vector>
+
+namespace AnimationProgramming::Tools
+{
+	/**
+	* A byte compression made for delta encoded data, where most bytes are zeros : a run of zeros becomes a zero followed by
+	* the length of the run (Up to 255), every other byte is kept as is
+	*/
+	class ZeroRunLength final
+	{
+	public:
+		/* Prevent this static class from being instancied */
+		ZeroRunLength() = delete;
+
+		/**
+		* Append the compressed bytes of p_source to p_destination
+		* @param p_source
+		* @param p_size
+		* @param p_destination
+		*/
+		static void Compress(const uint8_t* p_source, size_t p_size, std::vector<uint8_t>& p_destination);
+
+		/**
+		* Replace the content of p_destination by the decompressed bytes of p_source. Return false if p_source isn't valid compressed data
+		* @param p_source
+		* @param p_size
+		* @param p_destination
+		*/
+		static bool Decompress(const uint8_t* p_source, size_t p_size, std::vector<uint8_t>& p_destination);
+	};
+}
+
+#endif // _ZERORUNLENGTH_H
@@ -0,0 +1,606 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <immintrin.h>
+#include <limits>
+
+#include "AnimationProgramming/Animation/AimConstraints.h"
+#include "AnimationProgramming/Tools/Math.h"
+#include "AnimationProgramming/Tools/SIMD.h"
+#include "AnimationProgramming/Tools/SIMDTarget.h"
+
+namespace
+{
+	using AnimationProgramming::Tools::Math;
+
+	constexpr uint32_t kLaneWidth = AnimationProgramming::Animation::AimConstraints::LaneWidth;
+
+	/* Floats between two transformations of the lanes (Positions, then rotations) */
+	constexpr uint32_t kTransformStride = 7 * kLaneWidth;
+
+	/* Groups of characters constrained by a thread at once */
+	constexpr uint32_t kGroupsPerChunk = 4;
+
+	constexpr float kEpsilon = 1e-8f;
+
+	constexpr float kPi = 3.14159265358979f;
+
+	/**
+	* What the kernels read from a compiled constraint
+	*/
+	struct ConstraintParameters
+	{
+		const float* shares;
+		uint32_t entryCount;
+		uint32_t chainStart;
+		float offset[3];
+		float axis[3];
+		float maxAngleCos;
+		float maxAngleSin;
+	};
+
+	/**
+	* Targets of one group (Component c of the lane l is at [c * kLaneWidth + l])
+	*/
+	struct alignas(32) TargetLanes
+	{
+		float position[3 * kLaneWidth];
+		float weight[kLaneWidth];
+	};
+
+	AltMath::Vector3f ReadVector(const float* p_components, uint32_t p_lane)
+	{
+		return AltMath::Vector3f(p_components[p_lane], p_components[kLaneWidth + p_lane], p_components[2 * kLaneWidth + p_lane]);
+	}
+
+	void StoreVector(float* p_components, uint32_t p_lane, const AltMath::Vector3f& p_vector)
+	{
+		p_components[p_lane] = p_vector.x;
+		p_components[kLaneWidth + p_lane] = p_vector.y;
+		p_components[2 * kLaneWidth + p_lane] = p_vector.z;
+	}
+
+	AltMath::Quaternion ReadQuaternion(const float* p_components, uint32_t p_lane)
+	{
+		return AltMath::Quaternion(p_components[p_lane], p_components[kLaneWidth + p_lane], p_components[2 * kLaneWidth + p_lane], p_components[3 * kLaneWidth + p_lane]);
+	}
+
+	void StoreQuaternion(float* p_components, uint32_t p_lane, const AltMath::Quaternion& p_quaternion)
+	{
+		p_components[p_lane] = p_quaternion.GetXAxisValue();
+		p_components[kLaneWidth + p_lane] = p_quaternion.GetYAxisValue();
+		p_components[2 * kLaneWidth + p_lane] = p_quaternion.GetZAxisValue();
+		p_components[3 * kLaneWidth + p_lane] = p_quaternion.GetRealValue();
+	}
+
+	/**
+	* Return the given share of a rotation, with a normalized lerp from the identity (w >= 0)
+	*/
+	AltMath::Quaternion CalculateShare(const AltMath::Quaternion& p_rotation, float p_share)
+	{
+		const float x = p_share * p_rotation.GetXAxisValue();
+		const float y = p_share * p_rotation.GetYAxisValue();
+		const float z = p_share * p_rotation.GetZAxisValue();
+		const float w = 1.0f - p_share + p_share * p_rotation.GetRealValue();
+		const float inverseLength = 1.0f / std::sqrt(x * x + y * y + z * z + w * w);
+
+		return AltMath::Quaternion(x * inverseLength, y * inverseLength, z * inverseLength, w * inverseLength);
+	}
+
+	/**
+	* Return the direction from the given origin toward the target, within the angle limit around the given direction and weighted
+	*/
+	AltMath::Vector3f CalculateWantedDirection(const ConstraintParameters& p_constraint, const AltMath::Vector3f& p_direction, const AltMath::Vector3f& p_origin, const AltMath::Vector3f& p_target, float p_weight)
+	{
+		const AltMath::Vector3f toTarget = Math::Normalize(p_target - p_origin, p_direction);
+		const float cosine = AltMath::Vector3f::DotProduct(p_direction, toTarget);
+		AltMath::Vector3f limited = toTarget;
+
+		if (cosine < p_constraint.maxAngleCos)
+		{
+			const AltMath::Vector3f side = Math::Normalize(toTarget - p_direction * cosine, Math::CalculateOrthogonal(p_direction));
+			limited = p_direction * p_constraint.maxAngleCos + side * p_constraint.maxAngleSin;
+		}
+
+		return Math::Normalize(p_direction + (limited - p_direction) * p_weight, p_direction);
+	}
+
+	/**
+	* Constrain one group, one lane after the other : the local rotations of the chain are replaced
+	*/
+	void ConstrainGroupScalar(const ConstraintParameters& p_constraint, float* p_locals, float* p_worlds, const TargetLanes& p_targets)
+	{
+		const AltMath::Vector3f axis(p_constraint.axis[0], p_constraint.axis[1], p_constraint.axis[2]);
+		const AltMath::Vector3f offset(p_constraint.offset[0], p_constraint.offset[1], p_constraint.offset[2]);
+		const uint32_t last = p_constraint.entryCount - 1;
+
+		for (uint32_t lane = 0; lane < kLaneWidth; ++lane)
+		{
+			/* Down the path, from the root of the skeleton */
+			for (uint32_t entry = 0; entry <= last; ++entry)
+			{
+				const float* local = p_locals + entry * kTransformStride;
+				float* world = p_worlds + entry * kTransformStride;
+
+				if (entry == 0)
+				{
+					StoreVector(world, lane, ReadVector(local, lane));
+					StoreQuaternion(world + 3 * kLaneWidth, lane, ReadQuaternion(local + 3 * kLaneWidth, lane));
+					continue;
+				}
+
+				const float* parent = world - kTransformStride;
+				const AltMath::Quaternion parentRotation = ReadQuaternion(parent + 3 * kLaneWidth, lane);
+
+				StoreVector(world, lane, ReadVector(parent, lane) + parentRotation * ReadVector(local, lane));
+				StoreQuaternion(world + 3 * kLaneWidth, lane, parentRotation * ReadQuaternion(local + 3 * kLaneWidth, lane));
+			}
+
+			/* Current direction, and direction toward the target (Within the angle limit, and weighted) */
+			const float* end = p_worlds + last * kTransformStride;
+			const AltMath::Quaternion endRotation = ReadQuaternion(end + 3 * kLaneWidth, lane);
+			const AltMath::Vector3f direction = endRotation * axis;
+			const AltMath::Vector3f target = ReadVector(p_targets.position, lane);
+			const float weight = p_targets.weight[lane];
+			const AltMath::Quaternion rotation = Math::CalculateRotationBetween(direction, CalculateWantedDirection(p_constraint, direction, ReadVector(end, lane) + endRotation * offset, target, weight));
+
+			/* Down the chain : each bone takes its share of the rotation */
+			AltMath::Vector3f parentPosition(0.0f, 0.0f, 0.0f);
+			AltMath::Quaternion parentRotation = AltMath::Quaternion::Identity();
+
+			if (p_constraint.chainStart > 0)
+			{
+				const float* parent = p_worlds + (p_constraint.chainStart - 1) * kTransformStride;
+				parentPosition = ReadVector(parent, lane);
+				parentRotation = ReadQuaternion(parent + 3 * kLaneWidth, lane);
+			}
+
+			for (uint32_t entry = p_constraint.chainStart; entry <= last; ++entry)
+			{
+				float* local = p_locals + entry * kTransformStride;
+				const AltMath::Quaternion worldRotation = parentRotation * ReadQuaternion(local + 3 * kLaneWidth, lane);
+
+				const AltMath::Vector3f position = parentPosition + parentRotation * ReadVector(local, lane);
+
+				AltMath::Quaternion turned = worldRotation;
+
+				/* The last bone was moved by the others : the direction toward the target is taken again from its new position */
+				if (entry == last)
+				{
+					const AltMath::Vector3f wanted = CalculateWantedDirection(p_constraint, direction, position + worldRotation * offset, target, weight);
+					turned = Math::CalculateRotationBetween(Math::Normalize(worldRotation * axis, wanted), wanted) * worldRotation;
+				}
+				else if (p_constraint.shares[entry] > 0.0f)
+				{
+					turned = CalculateShare(rotation, p_constraint.shares[entry]) * worldRotation;
+				}
+
+				StoreQuaternion(local + 3 * kLaneWidth, lane, AltMath::Quaternion::Conjugate(parentRotation) * turned);
+
+				parentPosition = position;
+				parentRotation = turned;
+			}
+		}
+	}
+
+	/**
+	* Three and four component lanes
+	*/
+	struct Vector3Lanes
+	{
+		__m256 x, y, z;
+	};
+
+	struct QuaternionLanes
+	{
+		__m256 x, y, z, w;
+	};
+
+	SIMD_TARGET_AVX2 inline Vector3Lanes Load3(const float* p_components)
+	{
+		return { _mm256_load_ps(p_components), _mm256_load_ps(p_components + kLaneWidth), _mm256_load_ps(p_components + 2 * kLaneWidth) };
+	}
+
+	SIMD_TARGET_AVX2 inline void Store3(float* p_components, const Vector3Lanes& p_vector)
+	{
+		_mm256_store_ps(p_components, p_vector.x);
+		_mm256_store_ps(p_components + kLaneWidth, p_vector.y);
+		_mm256_store_ps(p_components + 2 * kLaneWidth, p_vector.z);
+	}
+
+	SIMD_TARGET_AVX2 inline QuaternionLanes Load4(const float* p_components)
+	{
+		return { _mm256_load_ps(p_components), _mm256_load_ps(p_components + kLaneWidth), _mm256_load_ps(p_components + 2 * kLaneWidth), _mm256_load_ps(p_components + 3 * kLaneWidth) };
+	}
+
+	SIMD_TARGET_AVX2 inline void Store4(float* p_components, const QuaternionLanes& p_quaternion)
+	{
+		_mm256_store_ps(p_components, p_quaternion.x);
+		_mm256_store_ps(p_components + kLaneWidth, p_quaternion.y);
+		_mm256_store_ps(p_components + 2 * kLaneWidth, p_quaternion.z);
+		_mm256_store_ps(p_components + 3 * kLaneWidth, p_quaternion.w);
+	}
+
+	SIMD_TARGET_AVX2 inline Vector3Lanes Broadcast3(const float* p_vector)
+	{
+		return { _mm256_set1_ps(p_vector[0]), _mm256_set1_ps(p_vector[1]), _mm256_set1_ps(p_vector[2]) };
+	}
+
+	SIMD_TARGET_AVX2 inline Vector3Lanes Add3(const Vector3Lanes& p_left, const Vector3Lanes& p_right)
+	{
+		return { _mm256_add_ps(p_left.x, p_right.x), _mm256_add_ps(p_left.y, p_right.y), _mm256_add_ps(p_left.z, p_right.z) };
+	}
+
+	SIMD_TARGET_AVX2 inline Vector3Lanes Subtract3(const Vector3Lanes& p_left, const Vector3Lanes& p_right)
+	{
+		return { _mm256_sub_ps(p_left.x, p_right.x), _mm256_sub_ps(p_left.y, p_right.y), _mm256_sub_ps(p_left.z, p_right.z) };
+	}
+
+	SIMD_TARGET_AVX2 inline Vector3Lanes Scale3(const Vector3Lanes& p_vector, __m256 p_scale)
+	{
+		return { _mm256_mul_ps(p_vector.x, p_scale), _mm256_mul_ps(p_vector.y, p_scale), _mm256_mul_ps(p_vector.z, p_scale) };
+	}
+
+	SIMD_TARGET_AVX2 inline __m256 Dot3(const Vector3Lanes& p_left, const Vector3Lanes& p_right)
+	{
+		return _mm256_fmadd_ps(p_left.x, p_right.x, _mm256_fmadd_ps(p_left.y, p_right.y, _mm256_mul_ps(p_left.z, p_right.z)));
+	}
+
+	SIMD_TARGET_AVX2 inline Vector3Lanes Cross3(const Vector3Lanes& p_left, const Vector3Lanes& p_right)
+	{
+		return
+		{
+			_mm256_fmsub_ps(p_left.y, p_right.z, _mm256_mul_ps(p_left.z, p_right.y)),
+			_mm256_fmsub_ps(p_left.z, p_right.x, _mm256_mul_ps(p_left.x, p_right.z)),
+			_mm256_fmsub_ps(p_left.x, p_right.y, _mm256_mul_ps(p_left.y, p_right.x))
+		};
+	}
+
+	SIMD_TARGET_AVX2 inline Vector3Lanes Select3(const Vector3Lanes& p_false, const Vector3Lanes& p_true, __m256 p_mask)
+	{
+		return { _mm256_blendv_ps(p_false.x, p_true.x, p_mask), _mm256_blendv_ps(p_false.y, p_true.y, p_mask), _mm256_blendv_ps(p_false.z, p_true.z, p_mask) };
+	}
+
+	/**
+	* Same as Math::Normalize, every lane at once
+	*/
+	SIMD_TARGET_AVX2 inline Vector3Lanes NormalizeOr3(const Vector3Lanes& p_vector, const Vector3Lanes& p_fallback)
+	{
+		const __m256 minimumLength2 = _mm256_set1_ps(Math::MinimumLength2);
+		const __m256 length2 = Dot3(p_vector, p_vector);
+		const __m256 valid = _mm256_cmp_ps(length2, minimumLength2, _CMP_GT_OQ);
+		const __m256 inverseLength = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(_mm256_max_ps(length2, minimumLength2)));
+
+		return Select3(p_fallback, Scale3(p_vector, inverseLength), valid);
+	}
+
+	SIMD_TARGET_AVX2 inline QuaternionLanes Multiply(const QuaternionLanes& p_left, const QuaternionLanes& p_right)
+	{
+		return
+		{
+			_mm256_fmadd_ps(p_left.w, p_right.x, _mm256_fmadd_ps(p_left.x, p_right.w, _mm256_fmsub_ps(p_left.y, p_right.z, _mm256_mul_ps(p_left.z, p_right.y)))),
+			_mm256_fmadd_ps(p_left.w, p_right.y, _mm256_fmadd_ps(p_left.y, p_right.w, _mm256_fmsub_ps(p_left.z, p_right.x, _mm256_mul_ps(p_left.x, p_right.z)))),
+			_mm256_fmadd_ps(p_left.w, p_right.z, _mm256_fmadd_ps(p_left.z, p_right.w, _mm256_fmsub_ps(p_left.x, p_right.y, _mm256_mul_ps(p_left.y, p_right.x)))),
+			_mm256_fnmadd_ps(p_left.x, p_right.x, _mm256_fnmadd_ps(p_left.y, p_right.y, _mm256_fnmadd_ps(p_left.z, p_right.z, _mm256_mul_ps(p_left.w, p_right.w))))
+		};
+	}
+
+	SIMD_TARGET_AVX2 inline QuaternionLanes Conjugate(const QuaternionLanes& p_quaternion)
+	{
+		const __m256 signMask = _mm256_set1_ps(-0.0f);
+		return { _mm256_xor_ps(p_quaternion.x, signMask), _mm256_xor_ps(p_quaternion.y, signMask), _mm256_xor_ps(p_quaternion.z, signMask), p_quaternion.w };
+	}
+
+	/**
+	* Rotate the given vector : v + w * t + u x t, with u the vector part of the rotation and t = 2 * (u x v)
+	*/
+	SIMD_TARGET_AVX2 inline Vector3Lanes Rotate(const QuaternionLanes& p_rotation, const Vector3Lanes& p_vector)
+	{
+		const Vector3Lanes u = { p_rotation.x, p_rotation.y, p_rotation.z };
+		const Vector3Lanes uCrossV = Cross3(u, p_vector);
+		const Vector3Lanes t = Add3(uCrossV, uCrossV);
+
+		return Add3(Add3(p_vector, Scale3(t, p_rotation.w)), Cross3(u, t));
+	}
+
+	/**
+	* Same as Math::CalculateOrthogonal, every lane at once
+	*/
+	SIMD_TARGET_AVX2 inline Vector3Lanes CalculateOrthogonalAVX2(const Vector3Lanes& p_direction)
+	{
+		const __m256 zero = _mm256_setzero_ps();
+
+		/* Cross products with the X and the Y axes */
+		const Vector3Lanes crossX = { zero, p_direction.z, _mm256_sub_ps(zero, p_direction.y) };
+		const Vector3Lanes crossY = { _mm256_sub_ps(zero, p_direction.z), zero, p_direction.x };
+		const Vector3Lanes orthogonal = Select3(crossY, crossX, _mm256_cmp_ps(Dot3(crossX, crossX), _mm256_set1_ps(1e-6f), _CMP_LT_OQ));
+
+		return Scale3(orthogonal, _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(Dot3(orthogonal, orthogonal))));
+	}
+
+	/**
+	* Same as Math::CalculateRotationBetween, every lane at once
+	*/
+	SIMD_TARGET_AVX2 inline QuaternionLanes CalculateRotationBetweenAVX2(const Vector3Lanes& p_from, const Vector3Lanes& p_to)
+	{
+		const __m256 cosine = Dot3(p_from, p_to);
+		const __m256 opposite = _mm256_cmp_ps(cosine, _mm256_set1_ps(Math::OppositeCosine), _CMP_LT_OQ);
+
+		const Vector3Lanes axis = Select3(Cross3(p_from, p_to), CalculateOrthogonalAVX2(p_from), opposite);
+		const __m256 w = _mm256_blendv_ps(_mm256_add_ps(_mm256_set1_ps(1.0f), cosine), _mm256_setzero_ps(), opposite);
+		const __m256 inverseLength = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(_mm256_fmadd_ps(w, w, Dot3(axis, axis))));
+
+		return { _mm256_mul_ps(axis.x, inverseLength), _mm256_mul_ps(axis.y, inverseLength), _mm256_mul_ps(axis.z, inverseLength), _mm256_mul_ps(w, inverseLength) };
+	}
+
+	/**
+	* Same as CalculateShare, every lane at once
+	*/
+	SIMD_TARGET_AVX2 inline QuaternionLanes CalculateShareAVX2(const QuaternionLanes& p_rotation, __m256 p_share)
+	{
+		const __m256 x = _mm256_mul_ps(p_share, p_rotation.x);
+		const __m256 y = _mm256_mul_ps(p_share, p_rotation.y);
+		const __m256 z = _mm256_mul_ps(p_share, p_rotation.z);
+		const __m256 w = _mm256_fmadd_ps(p_share, p_rotation.w, _mm256_sub_ps(_mm256_set1_ps(1.0f), p_share));
+		const __m256 inverseLength = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(_mm256_fmadd_ps(x, x, _mm256_fmadd_ps(y, y, _mm256_fmadd_ps(z, z, _mm256_mul_ps(w, w))))));
+
+		return { _mm256_mul_ps(x, inverseLength), _mm256_mul_ps(y, inverseLength), _mm256_mul_ps(z, inverseLength), _mm256_mul_ps(w, inverseLength) };
+	}
+
+	/**
+	* Same as CalculateWantedDirection, every lane at once
+	*/
+	SIMD_TARGET_AVX2 inline Vector3Lanes CalculateWantedDirectionAVX2(const ConstraintParameters& p_constraint, const Vector3Lanes& p_direction, const Vector3Lanes& p_origin, const Vector3Lanes& p_target, __m256 p_weight)
+	{
+		const Vector3Lanes toTarget = NormalizeOr3(Subtract3(p_target, p_origin), p_direction);
+		const __m256 cosine = Dot3(p_direction, toTarget);
+		const Vector3Lanes side = NormalizeOr3(Subtract3(toTarget, Scale3(p_direction, cosine)), CalculateOrthogonalAVX2(p_direction));
+		const Vector3Lanes onLimit = Add3(Scale3(p_direction, _mm256_set1_ps(p_constraint.maxAngleCos)), Scale3(side, _mm256_set1_ps(p_constraint.maxAngleSin)));
+		const Vector3Lanes limited = Select3(toTarget, onLimit, _mm256_cmp_ps(cosine, _mm256_set1_ps(p_constraint.maxAngleCos), _CMP_LT_OQ));
+
+		return NormalizeOr3(Add3(p_direction, Scale3(Subtract3(limited, p_direction), p_weight)), p_direction);
+	}
+
+	/**
+	* Same as ConstrainGroupScalar, every lane at once
+	*/
+	SIMD_TARGET_AVX2 void ConstrainGroupAVX2(const ConstraintParameters& p_constraint, float* p_locals, float* p_worlds, const TargetLanes& p_targets)
+	{
+		const Vector3Lanes axis = Broadcast3(p_constraint.axis);
+		const Vector3Lanes offset = Broadcast3(p_constraint.offset);
+		const uint32_t last = p_constraint.entryCount - 1;
+
+		/* Down the path, from the root of the skeleton */
+		Store3(p_worlds, Load3(p_locals));
+		Store4(p_worlds + 3 * kLaneWidth, Load4(p_locals + 3 * kLaneWidth));
+
+		for (uint32_t entry = 1; entry <= last; ++entry)
+		{
+			const float* local = p_locals + entry * kTransformStride;
+			const float* parent = p_worlds + (entry - 1) * kTransformStride;
+			float* world = p_worlds + entry * kTransformStride;
+			const QuaternionLanes parentRotation = Load4(parent + 3 * kLaneWidth);
+
+			Store3(world, Add3(Load3(parent), Rotate(parentRotation, Load3(local))));
+			Store4(world + 3 * kLaneWidth, Multiply(parentRotation, Load4(local + 3 * kLaneWidth)));
+		}
+
+		/* Current direction, and direction toward the target (Within the angle limit, and weighted) */
+		const float* end = p_worlds + last * kTransformStride;
+		const QuaternionLanes endRotation = Load4(end + 3 * kLaneWidth);
+		const Vector3Lanes direction = Rotate(endRotation, axis);
+		const Vector3Lanes target = Load3(p_targets.position);
+		const __m256 weight = _mm256_load_ps(p_targets.weight);
+		const QuaternionLanes rotation = CalculateRotationBetweenAVX2(direction, CalculateWantedDirectionAVX2(p_constraint, direction, Add3(Load3(end), Rotate(endRotation, offset)), target, weight));
+
+		/* Down the chain : each bone takes its share of the rotation */
+		const __m256 zero = _mm256_setzero_ps();
+		Vector3Lanes parentPosition = { zero, zero, zero };
+		QuaternionLanes parentRotation = { zero, zero, zero, _mm256_set1_ps(1.0f) };
+
+		if (p_constraint.chainStart > 0)
+		{
+			const float* parent = p_worlds + (p_constraint.chainStart - 1) * kTransformStride;
+			parentPosition = Load3(parent);
+			parentRotation = Load4(parent + 3 * kLaneWidth);
+		}
+
+		for (uint32_t entry = p_constraint.chainStart; entry <= last; ++entry)
+		{
+			float* local = p_locals + entry * kTransformStride;
+			const QuaternionLanes worldRotation = Multiply(parentRotation, Load4(local + 3 * kLaneWidth));
+
+			const Vector3Lanes position = Add3(parentPosition, Rotate(parentRotation, Load3(local)));
+
+			QuaternionLanes turned = worldRotation;
+
+			/* The last bone was moved by the others : the direction toward the target is taken again from its new position */
+			if (entry == last)
+			{
+				const Vector3Lanes wanted = CalculateWantedDirectionAVX2(p_constraint, direction, Add3(position, Rotate(worldRotation, offset)), target, weight);
+				turned = Multiply(CalculateRotationBetweenAVX2(NormalizeOr3(Rotate(worldRotation, axis), wanted), wanted), worldRotation);
+			}
+			else if (p_constraint.shares[entry] > 0.0f)
+			{
+				turned = Multiply(CalculateShareAVX2(rotation, _mm256_set1_ps(p_constraint.shares[entry])), worldRotation);
+			}
+
+			Store4(local + 3 * kLaneWidth, Multiply(Conjugate(parentRotation), turned));
+
+			parentPosition = position;
+			parentRotation = turned;
+		}
+	}
+}
+
+AnimationProgramming::Animation::AimConstraints::AimConstraints(const Rig::SkeletonDefinition& p_definition) :
+	m_parents(p_definition.GetParents()),
+	m_bindPose(p_definition.GetBindPose())
+{
+}
+
+uint32_t AnimationProgramming::Animation::AimConstraints::AddLookAt(const std::vector<uint32_t>& p_chain, const AltMath::Vector3f& p_axis, float p_maxAngle, const std::vector<float>& p_falloff)
+{
+	return AddConstraint(p_chain, AltMath::Vector3f(0.0f, 0.0f, 0.0f), p_axis, p_maxAngle, p_falloff);
+}
+
+uint32_t AnimationProgramming::Animation::AimConstraints::AddAim(const std::vector<uint32_t>& p_chain, const AltMath::Vector3f& p_offset, const AltMath::Vector3f& p_axis, float p_maxAngle, const std::vector<float>& p_falloff)
+{
+	return AddConstraint(p_chain, p_offset, p_axis, p_maxAngle, p_falloff);
+}
+
+uint32_t AnimationProgramming::Animation::AimConstraints::GetConstraintCount() const
+{
+	return static_cast<uint32_t>(m_constraints.size());
+}
+
+void AnimationProgramming::Animation::AimConstraints::Apply(const std::vector<std::vector<Data::Transformation>*>& p_poses, const std::vector<Target>& p_targets, Tools::ThreadPool* p_threadPool) const
+{
+	const uint32_t groupCount = static_cast<uint32_t>((p_poses.size() + LaneWidth - 1) / LaneWidth);
+
+	uint32_t maxEntryCount = 0;
+
+	for (const Constraint& constraint : m_constraints)
+		maxEntryCount = std::max(maxEntryCount, constraint.entryCount);
+
+	auto constrainGroups = [this, &p_poses, &p_targets, maxEntryCount](uint32_t p_begin, uint32_t p_end)
+	{
+		std::vector<TransformLanes> locals(maxEntryCount);
+		std::vector<TransformLanes> worlds(maxEntryCount);
+
+		for (uint32_t group = p_begin; group < p_end; ++group)
+		{
+			for (uint32_t constraint = 0; constraint < m_constraints.size(); ++constraint)
+				ApplyGroup(constraint, p_poses, p_targets, group, locals, worlds);
+		}
+	};
+
+	if (p_threadPool)
+		p_threadPool->ParallelFor(groupCount, kGroupsPerChunk, constrainGroups);
+	else
+		constrainGroups(0, groupCount);
+}
+
+uint32_t AnimationProgramming::Animation::AimConstraints::AddConstraint(const std::vector<uint32_t>& p_chain, const AltMath::Vector3f& p_offset, const AltMath::Vector3f& p_axis, float p_maxAngle, const std::vector<float>& p_falloff)
+{
+	const uint32_t boneCount = static_cast<uint32_t>(m_parents.size());
+
+	if (p_chain.empty() || p_chain.back() >= boneCount || p_axis.LengthSquare() < kEpsilon)
+		return std::numeric_limits<uint32_t>::max();
+
+	/* The path, up from the last bone of the chain to the root of the skeleton */
+	std::vector<uint32_t> path;
+
+	for (int32_t bone = static_cast<int32_t>(p_chain.back()); bone != -1; bone = m_parents[bone])
+		path.push_back(static_cast<uint32_t>(bone));
+
+	std::reverse(path.begin(), path.end());
+
+	/* Each bone of the chain must be found in the path after the previous one */
+	std::vector<float> shares(path.size(), 0.0f);
+	uint32_t chainStart = 0;
+	uint32_t searchFrom = 0;
+
+	for (size_t i = 0; i < p_chain.size(); ++i)
+	{
+		auto found = std::find(path.begin() + searchFrom, path.end(), p_chain[i]);
+
+		if (found == path.end())
+			return std::numeric_limits<uint32_t>::max();
+
+		const uint32_t entry = static_cast<uint32_t>(found - path.begin());
+
+		if (i == 0)
+			chainStart = entry;
+
+		/* The last bone takes what remains : its share only marks it as part of the chain */
+		shares[entry] = i + 1 < p_chain.size() ? (i < p_falloff.size() ? p_falloff[i] : 1.0f / static_cast<float>(p_chain.size())) : 1.0f;
+		searchFrom = entry + 1;
+	}
+
+	const float maxAngle = std::clamp(p_maxAngle, 0.0f, kPi);
+
+	Constraint constraint;
+	constraint.firstEntry = static_cast<uint32_t>(m_entryBones.size());
+	constraint.entryCount = static_cast<uint32_t>(path.size());
+	constraint.chainStart = chainStart;
+	constraint.offset = p_offset;
+	constraint.axis = p_axis / p_axis.Length();
+	constraint.maxAngleCos = std::cos(maxAngle);
+	constraint.maxAngleSin = std::sin(maxAngle);
+
+	m_entryBones.insert(m_entryBones.end(), path.begin(), path.end());
+	m_entryShares.insert(m_entryShares.end(), shares.begin(), shares.end());
+	m_constraints.push_back(constraint);
+
+	return static_cast<uint32_t>(m_constraints.size() - 1);
+}
+
+void AnimationProgramming::Animation::AimConstraints::ApplyGroup(uint32_t p_constraintIndex, const std::vector<std::vector<Data::Transformation>*>& p_poses, const std::vector<Target>& p_targets, uint32_t p_group, std::vector<TransformLanes>& p_locals, std::vector<TransformLanes>& p_worlds) const
+{
+	const Constraint& constraint = m_constraints[p_constraintIndex];
+	const uint32_t constraintCount = static_cast<uint32_t>(m_constraints.size());
+	const uint32_t firstCharacter = p_group * LaneWidth;
+	const uint32_t laneCount = std::min(LaneWidth, static_cast<uint32_t>(p_poses.size()) - firstCharacter);
+
+	/* The padding lanes repeat the last character of the group */
+	TargetLanes targets;
+
+	for (uint32_t lane = 0; lane < LaneWidth; ++lane)
+	{
+		const Target& target = p_targets[(firstCharacter + std::min(lane, laneCount - 1)) * constraintCount + p_constraintIndex];
+
+		StoreVector(targets.position, lane, target.position);
+		targets.weight[lane] = target.weight;
+	}
+
+	/* Local transformations of the path (Bind pose and pose combined) */
+	for (uint32_t entry = 0; entry < constraint.entryCount; ++entry)
+	{
+		const uint32_t bone = m_entryBones[constraint.firstEntry + entry];
+
+		for (uint32_t lane = 0; lane < LaneWidth; ++lane)
+		{
+			const Data::Transformation& transformation = (*p_poses[firstCharacter + std::min(lane, laneCount - 1)])[bone];
+
+			StoreVector(p_locals[entry].position, lane, m_bindPose[bone].first + transformation.first);
+			StoreQuaternion(p_locals[entry].rotation, lane, m_bindPose[bone].second * transformation.second);
+		}
+	}
+
+	ConstraintParameters parameters;
+	parameters.shares = m_entryShares.data() + constraint.firstEntry;
+	parameters.entryCount = constraint.entryCount;
+	parameters.chainStart = constraint.chainStart;
+	parameters.offset[0] = constraint.offset.x;
+	parameters.offset[1] = constraint.offset.y;
+	parameters.offset[2] = constraint.offset.z;
+	parameters.axis[0] = constraint.axis.x;
+	parameters.axis[1] = constraint.axis.y;
+	parameters.axis[2] = constraint.axis.z;
+	parameters.maxAngleCos = constraint.maxAngleCos;
+	parameters.maxAngleSin = constraint.maxAngleSin;
+
+	if (Tools::SIMD::GetLevel() == Tools::ESIMDLevel::AVX2)
+		ConstrainGroupAVX2(parameters, p_locals[0].position, p_worlds[0].position, targets);
+	else
+		ConstrainGroupScalar(parameters, p_locals[0].position, p_worlds[0].position, targets);
+
+	/* Back to the poses, relative to the bind pose (Only the bones of the chain turned) */
+	for (uint32_t entry = constraint.chainStart; entry < constraint.entryCount; ++entry)
+	{
+		if (m_entryShares[constraint.firstEntry + entry] <= 0.0f)
+			continue;
+
+		const uint32_t bone = m_entryBones[constraint.firstEntry + entry];
+		const AltMath::Quaternion inverseBindRotation = AltMath::Quaternion::Conjugate(m_bindPose[bone].second);
+
+		for (uint32_t lane = 0; lane < laneCount; ++lane)
+			(*p_poses[firstCharacter + lane])[bone].second = inverseBindRotation * ReadQuaternion(p_locals[entry].rotation, lane);
+	}
+}
@@ -0,0 +1,83 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "AnimationProgramming/Animation/AnimationBaker.h"
+
+namespace
+{
+	/* Number of frames baked by a thread pool task */
+	constexpr uint32_t FramesPerChunk = 4;
+
+	uint32_t GetFrameCount(const AnimationProgramming::Animation::AnimationInstance& p_animation, float p_sampleRate)
+	{
+		const float frames = p_animation.GetDuration() * p_sampleRate;
+
+		/* A non-looping animation needs its last pose, a looping one reaches its first pose again */
+		if (p_animation.loop)
+			return std::max(static_cast<uint32_t>(std::ceil(frames)), 1u);
+		else
+			return static_cast<uint32_t>(std::ceil(frames)) + 1;
+	}
+
+	void BakeFrame(const AnimationProgramming::Rig::SkeletonDefinition& p_definition, const AnimationProgramming::Animation::AnimationInstance& p_animation, uint32_t p_frame, AnimationProgramming::Animation::BakedAnimation& p_result, std::vector<AnimationProgramming::Data::Transformation>& p_localPose, std::vector<AnimationProgramming::Data::Matrix3x4>& p_modelMatrices, std::vector<AnimationProgramming::Data::Matrix3x4>& p_palette)
+	{
+		/* A non-looping animation is clamped on its last pose */
+		p_animation.SamplePose(static_cast<float>(p_frame) / p_result.GetSampleRate(), p_localPose);
+
+		/* Same palette as Animator::CalculateMatrixPalette : BoneCurrentWorldMatrix * Inverse(BoneTPoseWorldMatrix), IK ignored */
+		p_definition.CalculateModelMatrices(p_localPose, p_modelMatrices);
+		p_definition.CalculateSkinningPalette(p_modelMatrices, p_palette);
+
+		p_result.SetFramePalette(p_frame, p_palette);
+	}
+}
+
+AnimationProgramming::Animation::BakedAnimation AnimationProgramming::Animation::AnimationBaker::Bake(const Rig::SkeletonDefinition& p_definition, const AnimationInstance& p_animation, float p_sampleRate, EBakedPrecision p_precision, Tools::ThreadPool* p_threadPool)
+{
+	std::vector<BakedAnimation> result = Bake(p_definition, { &p_animation }, p_sampleRate, p_precision, p_threadPool);
+	return std::move(result.front());
+}
+
+std::vector<AnimationProgramming::Animation::BakedAnimation> AnimationProgramming::Animation::AnimationBaker::Bake(const Rig::SkeletonDefinition& p_definition, const std::vector<const AnimationInstance*>& p_animations, float p_sampleRate, EBakedPrecision p_precision, Tools::ThreadPool* p_threadPool)
+{
+	std::vector<BakedAnimation> result;
+	result.reserve(p_animations.size());
+
+	/* Every (animation, frame) pair is an independent work item */
+	std::vector<std::pair<uint32_t, uint32_t>> items;
+
+	for (uint32_t i = 0; i < p_animations.size(); ++i)
+	{
+		const AnimationInstance& animation = *p_animations[i];
+		const uint32_t frameCount = GetFrameCount(animation, p_sampleRate);
+
+		result.emplace_back(frameCount, p_definition.GetPaletteSize(), p_sampleRate, animation.GetDuration(), animation.loop, animation.speedCoefficient, p_precision);
+
+		for (uint32_t frame = 0; frame < frameCount; ++frame)
+			items.emplace_back(i, frame);
+	}
+
+	auto bakeRange = [&](uint32_t p_begin, uint32_t p_end)
+	{
+		/* The definition is only read : the worker threads share it, each one with its own buffers */
+		std::vector<Data::Transformation> localPose;
+		std::vector<Data::Matrix3x4> modelMatrices;
+		std::vector<Data::Matrix3x4> palette;
+
+		for (uint32_t i = p_begin; i < p_end; ++i)
+			BakeFrame(p_definition, *p_animations[items[i].first], items[i].second, result[items[i].first], localPose, modelMatrices, palette);
+	};
+
+	if (p_threadPool)
+		p_threadPool->ParallelFor(static_cast<uint32_t>(items.size()), FramesPerChunk, bakeRange);
+	else
+		bakeRange(0, static_cast<uint32_t>(items.size()));
+
+	return result;
+}
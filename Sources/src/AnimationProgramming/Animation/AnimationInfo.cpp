@@ -26,6 +26,7 @@ AnimationProgramming::Animation::AnimationInfo::AnimationInfo(uint32_t p_frames)
 }
 
 AnimationProgramming::Animation::AnimationInfo::AnimationInfo(const std::string & p_animationName) :
+	m_animationName(p_animationName),
 	m_bonesCount(Core::AnimationEngine::GetSkeletonBoneCount()),
 	m_keyCount(Core::AnimationEngine::GetAnimationKeyFrameCount(p_animationName)),
 	m_startKey(0),
@@ -52,6 +53,33 @@ AnimationProgramming::Data::Transformation AnimationProgramming::Animation::Anim
 	return m_animationTransformations[p_keyFrame][p_boneID];
 }
 
+void AnimationProgramming::Animation::AnimationInfo::LoadIKBoneTransformations()
+{
+	m_ikBonesCount = Core::AnimationEngine::GetSkeletonIKBoneCount();
+	m_ikTransformations.clear();
+
+	for (uint32_t currentKey = 0; currentKey < m_animationTransformations.size(); ++currentKey)
+	{
+		std::vector<Data::Transformation> ikTransformations;
+
+		/* The IK bones follow the bones of the skeleton in the engine */
+		for (uint32_t ikBoneID = 0; ikBoneID < m_ikBonesCount; ++ikBoneID)
+		{
+			if (m_animationName.empty())
+				ikTransformations.emplace_back(AltMath::Vector3f(0.0f, 0.0f, 0.0f), AltMath::Quaternion(0.0f, 0.0f, 0.0f, 1.0f));
+			else
+				ikTransformations.push_back(Core::AnimationEngine::GetSkeletonAnimationBoneLocalTransform(m_bonesCount + ikBoneID, m_animationName, currentKey));
+		}
+
+		m_ikTransformations.push_back(ikTransformations);
+	}
+}
+
+AnimationProgramming::Data::Transformation AnimationProgramming::Animation::AnimationInfo::GetIKBoneTransformations(uint32_t p_ikBoneID, uint32_t p_keyFrame) const
+{
+	return m_ikTransformations[p_keyFrame][p_ikBoneID];
+}
+
 uint32_t AnimationProgramming::Animation::AnimationInfo::GetStartKey(bool p_excludeZero) const
 {
 	return m_startKey + (p_excludeZero ? 1 : 0);
@@ -76,3 +104,8 @@ uint32_t AnimationProgramming::Animation::AnimationInfo::GetBonesCount() const
 {
 	return m_bonesCount;
 }
+
+uint32_t AnimationProgramming::Animation::AnimationInfo::GetIKBonesCount() const
+{
+	return m_ikBonesCount;
+}
@@ -4,8 +4,83 @@
 * @version 1.0
 */
 
+#include <algorithm>
+#include <cmath>
+
 #include "AnimationProgramming/Animation/AnimationInstance.h"
+#include "AnimationProgramming/Tools/SIMD.h"
 
 AnimationProgramming::Animation::AnimationInstance::AnimationInstance(const Animation::AnimationInfo & p_animationInfo) :
 	attachedAnimation(p_animationInfo)
 {}
+
+uint32_t AnimationProgramming::Animation::AnimationInstance::GetKeyCount() const
+{
+	return attachedAnimation.GetEndKey() - attachedAnimation.GetStartKey() + 1;
+}
+
+float AnimationProgramming::Animation::AnimationInstance::GetDuration() const
+{
+	const uint32_t keyCount = GetKeyCount();
+	return static_cast<float>(loop ? keyCount : keyCount - 1) * frameDuration;
+}
+
+float AnimationProgramming::Animation::AnimationInstance::GetKeyTime(uint32_t p_key) const
+{
+	/* A reversed animation plays its last key at time 0 (See SampleKeyFrames) */
+	const uint32_t key = std::min(p_key, GetKeyCount() - 1);
+	return static_cast<float>(reverse ? GetKeyCount() - 1 - key : key) * frameDuration;
+}
+
+void AnimationProgramming::Animation::AnimationInstance::SampleKeyFrames(float p_time, uint32_t& p_currentKey, uint32_t& p_nextKey, float& p_alpha) const
+{
+	const uint32_t keyCount = GetKeyCount();
+	const float duration = GetDuration();
+
+	float time = p_time;
+
+	if (loop)
+	{
+		time = std::fmod(time, duration);
+		if (time < 0.0f)
+			time += duration;
+	}
+	else
+	{
+		time = std::clamp(time, 0.0f, duration);
+	}
+
+	/* Playing backward is playing forward from the mirrored time (Which wraps on the first key if the animation loops) */
+	if (reverse)
+	{
+		if (loop)
+			time = std::fmod(static_cast<float>(keyCount - 1) * frameDuration - time + duration, duration);
+		else
+			time = duration - time;
+	}
+
+	const float keyPosition = time / frameDuration;
+	const uint32_t keyOffset = std::min(static_cast<uint32_t>(keyPosition), keyCount - 1);
+
+	p_currentKey = attachedAnimation.GetStartKey() + keyOffset;
+	p_nextKey = keyOffset + 1 < keyCount ? p_currentKey + 1 : attachedAnimation.GetStartKey();
+	p_alpha = interpolateKeyFrames ? std::min(keyPosition - static_cast<float>(keyOffset), 1.0f) : 0.0f;
+}
+
+void AnimationProgramming::Animation::AnimationInstance::SamplePose(float p_time, std::vector<Data::Transformation>& p_pose) const
+{
+	uint32_t currentKey, nextKey;
+	float alpha;
+	SampleKeyFrames(p_time, currentKey, nextKey, alpha);
+
+	p_pose.resize(attachedAnimation.GetBonesCount());
+
+	for (uint32_t bone = 0; bone < attachedAnimation.GetBonesCount(); ++bone)
+	{
+		auto[startPosition, startRotation] = attachedAnimation.GetBoneTransformations(bone, currentKey);
+		auto[endPosition, endRotation] = attachedAnimation.GetBoneTransformations(bone, nextKey);
+
+		p_pose[bone].first = Tools::SIMD::Lerp(startPosition, endPosition, alpha);
+		p_pose[bone].second = Tools::SIMD::Slerp(startRotation, endRotation, alpha);
+	}
+}
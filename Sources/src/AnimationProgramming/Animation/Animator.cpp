@@ -4,12 +4,36 @@
 * @version 1.0
 */
 
+#include <algorithm>
+#include <limits>
+
 #include "AnimationProgramming/Animation/Animator.h"
 #include "AnimationProgramming/Tools/IniManager.h"
+#include "AnimationProgramming/Tools/SIMD.h"
+
+namespace
+{
+	using namespace AnimationProgramming;
+
+	/* Returned while the animator has no pose buffers yet (They are created with the definition, the first time the animator needs it) */
+	const std::vector<Data::Transformation> kNoLocalPose;
+	const std::vector<Data::Matrix3x4> kNoMatrixPalette;
+	const std::vector<Data::DualQuaternion> kNoDualQuaternionPalette;
+
+	/* Index of the played pose source in the snapshots when none is played */
+	constexpr uint32_t kNoPoseSource = std::numeric_limits<uint32_t>::max();
+}
 
 AnimationProgramming::Animation::Animator::Animator(Rig::Skeleton & p_skeleton) :
+	Animator(nullptr, &p_skeleton)
+{}
+
+AnimationProgramming::Animation::Animator::Animator(std::shared_ptr<const Rig::SkeletonDefinition> p_definition, Rig::Skeleton* p_skeleton) :
 	m_skeleton(p_skeleton)
 {
+	if (p_definition)
+		m_instance.emplace(std::move(p_definition));
+
 	/* Listening for FrameChangedEvent allows the animator to update his data only when he needs to */
 	m_timeline.FrameChangedEvent.AddListener(std::bind(&Animator::UpdateFrameTransformations, this));
 }
@@ -34,10 +58,100 @@ float AnimationProgramming::Animation::Animator::GetGlobalSpeedCoefficient()
 	return m_globalSpeedCoefficient;
 }
 
+AnimationProgramming::Animation::ESkinningPaletteFormat AnimationProgramming::Animation::Animator::GetSkinningPaletteFormat() const
+{
+	return m_skinningPaletteFormat;
+}
+
+void AnimationProgramming::Animation::Animator::SetSkinningPaletteFormat(ESkinningPaletteFormat p_format)
+{
+	m_skinningPaletteFormat = p_format;
+}
+
+float AnimationProgramming::Animation::Animator::GetTickRate() const
+{
+	return m_tickRate;
+}
+
+void AnimationProgramming::Animation::Animator::SetTickRate(float p_tickRate)
+{
+	m_tickRate = std::max(p_tickRate, 0.0f);
+
+	if (m_tickRate > 0.0f)
+		m_tickClock.SetTickRate(m_tickRate);
+
+	m_tickClock.Reset();
+}
+
+AnimationProgramming::Animation::ETransitionMode AnimationProgramming::Animation::Animator::GetTransitionMode() const
+{
+	return m_transitionMode;
+}
+
+void AnimationProgramming::Animation::Animator::SetTransitionMode(ETransitionMode p_mode)
+{
+	m_transitionMode = p_mode;
+
+	if (m_transitionMode != ETransitionMode::INERTIALIZATION)
+		m_inertializer.Stop();
+
+	if (m_transitionMode != ETransitionMode::STACK)
+		m_transitionStack.Clear();
+}
+
+AnimationProgramming::Animation::TransitionStack& AnimationProgramming::Animation::Animator::GetTransitionStack()
+{
+	return m_transitionStack;
+}
+
+void AnimationProgramming::Animation::Animator::SetTransitionIndex(const TransitionIndex* p_transitionIndex)
+{
+	m_transitionIndex = p_transitionIndex;
+}
+
+void AnimationProgramming::Animation::Animator::SetPoseCache(PoseCache* p_poseCache)
+{
+	m_poseCache = p_poseCache;
+}
+
+void AnimationProgramming::Animation::Animator::SetLimbIK(LimbIK* p_limbIK)
+{
+	m_limbIK = p_limbIK;
+}
+
+void AnimationProgramming::Animation::Animator::SetChainIK(ChainIK* p_chainIK)
+{
+	m_chainIK = p_chainIK;
+}
+
+void AnimationProgramming::Animation::Animator::SetAimConstraints(const AimConstraints* p_aimConstraints)
+{
+	m_aimConstraints = p_aimConstraints;
+	m_aimTargets.assign(p_aimConstraints ? p_aimConstraints->GetConstraintCount() : 0, { AltMath::Vector3f(0.0f, 0.0f, 0.0f), 0.0f });
+}
+
+void AnimationProgramming::Animation::Animator::SetAimTarget(uint32_t p_constraint, const AltMath::Vector3f& p_position, float p_weight)
+{
+	if (p_constraint < m_aimTargets.size())
+		m_aimTargets[p_constraint] = { p_position, p_weight };
+}
+
+void AnimationProgramming::Animation::Animator::SetFootPlanting(FootPlanting* p_footPlanting, const IGroundProvider* p_ground)
+{
+	m_footPlanting = p_footPlanting;
+	m_ground = p_ground;
+}
+
+void AnimationProgramming::Animation::Animator::SetSpringBones(SpringBones* p_springBones)
+{
+	m_springBones = p_springBones;
+}
+
 void AnimationProgramming::Animation::Animator::PlayAnimation(Animation::AnimationInstance& p_toPlay)
 {
-	/* Verify if we should play a transition before playing the new animation */
-	bool willingForTransition = HasAnimation() && !m_timeline.GetEffector(ETimelineEffector::IGNORE_TRANSITIONING);
+	/* Verify if we should play a transition before playing the new animation (Leaving a pose source can only blend from its pose) */
+	bool canTransition = HasAnimation() || (IsPlayingPoseSource() && m_transitionMode != ETransitionMode::CROSSFADE);
+	bool willingForTransition = canTransition && !m_timeline.GetEffector(ETimelineEffector::IGNORE_TRANSITIONING);
 
 	/** 
 	* The previous alpha is used to re-caclulate the start point of the transition
@@ -45,11 +159,40 @@ void AnimationProgramming::Animation::Animator::PlayAnimation(Animation::Animati
 	*/
 	float previousAlpha = m_timeline.CalculateInterpolationAlpha();
 
+	/* Enter the new animation at the key the closest to the current key of the previous animation */
+	uint32_t entryKey = 0;
+	const bool hasEntryKey = m_transitionIndex && HasAnimation() && m_transitionIndex->FindEntryKey(*m_currentAnimation, m_timeline.GetCurrentKeyFrame() - m_currentAnimation->attachedAnimation.GetStartKey(), p_toPlay, entryKey);
+
+	m_bakedAnimation = nullptr;
+	m_poseSource = nullptr;
 	m_currentAnimation = &p_toPlay;
 	m_timeline.SyncToAnimation(p_toPlay);
 	m_timeline.Reset();
 
-	if (willingForTransition)
+	if (hasEntryKey)
+		m_timeline.SetEntryKeyFrame(p_toPlay.attachedAnimation.GetStartKey() + entryKey);
+
+	if (m_transitionMode == ETransitionMode::STACK)
+	{
+		/* The previous animations keep playing in the stack while the new one fades in (From the current pose if the stack is empty) */
+		if (willingForTransition && m_transitionStack.IsEmpty())
+			m_transitionStack.PushPose(GetInstance().GetLocalPose());
+
+		/* The stack fades from the current pose : an inertialization started by a pose source would offset it twice */
+		m_inertializer.Stop();
+
+		m_transitionStack.Push(p_toPlay, willingForTransition ? p_toPlay.transitionDuration : 0.0f, hasEntryKey ? p_toPlay.GetKeyTime(entryKey) : 0.0f);
+		UpdateFrameTransformations();
+		m_timeline.Play();
+	}
+	else if (willingForTransition && m_transitionMode == ETransitionMode::INERTIALIZATION)
+	{
+		/* Play the new animation immediately, the offset from the current pose decays over the transition duration */
+		UpdateFrameTransformations();
+		m_inertializer.Start(m_previousLocalPose, GetInstance().GetLocalPose(), m_previousDeltaTime, m_currentKeyFrameTransformations, p_toPlay.transitionDuration);
+		m_timeline.Play();
+	}
+	else if (willingForTransition)
 	{
 		/* Prepare and play the new animation WITH transition */
 		CalculateTransitionStartAndEndPoint(previousAlpha);
@@ -58,11 +201,78 @@ void AnimationProgramming::Animation::Animator::PlayAnimation(Animation::Animati
 	else
 	{
 		/* Prepare and play the new animation WITHOUT transition */
+		m_inertializer.Stop();
 		UpdateFrameTransformations();
 		m_timeline.Play();
 	}
 }
 
+void AnimationProgramming::Animation::Animator::PlayBakedAnimation(const BakedAnimation& p_toPlay)
+{
+	/* The baked animation replaces the current animation, the timeline isn't used */
+	m_currentKeyFrameTransformations.clear();
+	m_nextKeyFrameTransformations.clear();
+	m_currentAnimation = nullptr;
+	m_poseSource = nullptr;
+	m_timeline.Pause();
+	m_inertializer.Stop();
+	m_transitionStack.Clear();
+
+	m_bakedAnimation = &p_toPlay;
+	m_bakedTime = 0.0f;
+	m_bakedAnimation->ReadFramePalette(0, GetInstance().GetSkinningPalette());
+}
+
+bool AnimationProgramming::Animation::Animator::IsPlayingBakedAnimation() const
+{
+	return m_bakedAnimation != nullptr;
+}
+
+void AnimationProgramming::Animation::Animator::PlayPoseSource(IPoseSource& p_toPlay, float p_transitionDuration)
+{
+	const bool willingForTransition = (HasAnimation() || IsPlayingPoseSource()) && p_transitionDuration > 0.0f;
+
+	/* The pose source replaces the current animation, the timeline isn't used */
+	m_currentKeyFrameTransformations.clear();
+	m_nextKeyFrameTransformations.clear();
+	m_currentAnimation = nullptr;
+	m_bakedAnimation = nullptr;
+	m_timeline.Pause();
+	m_transitionStack.Clear();
+
+	m_poseSource = m_poseSources[AddPoseSource(p_toPlay)];
+
+	if (willingForTransition)
+	{
+		/* The previous pose is only tracked in INERTIALIZATION mode : otherwise the transition starts without velocity */
+		const bool hasPreviousPose = m_transitionMode == ETransitionMode::INERTIALIZATION;
+
+		const std::vector<Data::Transformation>& localPose = GetInstance().GetLocalPose();
+
+		m_poseSource->Evaluate(m_poseSourcePose);
+		m_inertializer.Start(hasPreviousPose ? m_previousLocalPose : localPose, localPose, hasPreviousPose ? m_previousDeltaTime : 0.0f, m_poseSourcePose, p_transitionDuration);
+	}
+	else
+	{
+		m_inertializer.Stop();
+	}
+}
+
+uint32_t AnimationProgramming::Animation::Animator::AddPoseSource(IPoseSource& p_poseSource)
+{
+	const auto found = std::find(m_poseSources.begin(), m_poseSources.end(), &p_poseSource);
+	if (found != m_poseSources.end())
+		return static_cast<uint32_t>(found - m_poseSources.begin());
+
+	m_poseSources.push_back(&p_poseSource);
+	return static_cast<uint32_t>(m_poseSources.size() - 1);
+}
+
+bool AnimationProgramming::Animation::Animator::IsPlayingPoseSource() const
+{
+	return m_poseSource != nullptr;
+}
+
 void AnimationProgramming::Animation::Animator::StopAnimation()
 {
 	/* Clear animation informations */
@@ -71,6 +281,10 @@ void AnimationProgramming::Animation::Animator::StopAnimation()
 
 	/* Remove the current animation */
 	m_currentAnimation = nullptr;
+	m_bakedAnimation = nullptr;
+	m_poseSource = nullptr;
+	m_inertializer.Stop();
+	m_transitionStack.Clear();
 
 	/* Pause the timeline */
 	m_timeline.Pause();
@@ -84,12 +298,112 @@ void AnimationProgramming::Animation::Animator::StopAnimation()
 
 void AnimationProgramming::Animation::Animator::Update(float p_deltaTime)
 {
-	if (HasAnimation())
+	if (!HasAnimation() && !IsPlayingBakedAnimation() && !IsPlayingPoseSource())
+		return;
+
+	if (m_tickRate <= 0.0f)
 	{
+		UpdatePose(p_deltaTime);
+		UploadSkinningPalette();
+		return;
+	}
+
+	/* Zero or more ticks of fixed duration : the poses of the last two are interpolated (The palettes for baked animations) */
+	const uint32_t tickCount = m_tickClock.Advance(p_deltaTime);
+
+	for (uint32_t tick = 0; tick < tickCount; ++tick)
+	{
+		if (tick + 1 == tickCount && IsPlayingBakedAnimation())
+		{
+			m_previousTickPalette = GetInstance().GetSkinningPalette();
+			m_previousTickLocalPose.clear();
+		}
+		else if (tick + 1 == tickCount)
+		{
+			m_previousTickLocalPose = GetInstance().GetLocalPose();
+			m_previousTickPalette.clear();
+		}
+
+		UpdatePose(m_tickClock.GetTickTime());
+	}
+
+	UploadInterpolatedSkinningPalette(m_tickClock.GetAlpha());
+}
+
+void AnimationProgramming::Animation::Animator::UpdatePose(float p_deltaTime)
+{
+	std::vector<Data::Transformation>& localPose = GetInstance().GetLocalPose();
+
+	if (IsPlayingBakedAnimation())
+	{
+		/* No sampling, no hierarchy update and no palette calculation : the palette is a table lookup */
+		m_bakedTime += p_deltaTime * m_globalSpeedCoefficient * m_bakedAnimation->GetSpeedCoefficient();
+		m_bakedAnimation->ReadFramePalette(m_bakedAnimation->GetFrameIndex(m_bakedTime), m_instance->GetSkinningPalette());
+	}
+	else if (IsPlayingPoseSource())
+	{
+		if (m_transitionMode == ETransitionMode::INERTIALIZATION)
+		{
+			m_previousLocalPose = localPose;
+			m_previousDeltaTime = p_deltaTime * m_globalSpeedCoefficient;
+		}
+
+		/* The pose depends on the parameters of the source : it is never shared through the pose cache */
+		m_poseSource->Update(p_deltaTime * m_globalSpeedCoefficient);
+		m_inertializer.Update(p_deltaTime * m_globalSpeedCoefficient);
+
+		m_poseSource->Evaluate(localPose);
+		if (m_inertializer.IsActive())
+			m_inertializer.Apply(localPose);
+
+		ApplyIK();
+		ApplySpringBones(p_deltaTime * m_globalSpeedCoefficient);
+		CalculateSkinningPalette();
+	}
+	else if (HasAnimation())
+	{
+		/* The velocity of the bones is needed when an inertialization starts */
+		if (m_transitionMode == ETransitionMode::INERTIALIZATION)
+		{
+			m_previousLocalPose = localPose;
+			m_previousDeltaTime = p_deltaTime * m_globalSpeedCoefficient;
+		}
+
 		m_timeline.Update(p_deltaTime * m_globalSpeedCoefficient * m_currentAnimation->speedCoefficient);
-		ApplyAnimationToSkeleton();
-		SendSkinningMatricesToGPU();
+		m_inertializer.Update(p_deltaTime * m_globalSpeedCoefficient);
+		m_transitionStack.Update(p_deltaTime * m_globalSpeedCoefficient);
+
+		if (m_inertializer.IsActive())
+		{
+			EvaluateLocalPose(m_timeline.CalculateInterpolationAlpha());
+			m_inertializer.Apply(localPose);
+			ApplyIK();
+			ApplySpringBones(p_deltaTime * m_globalSpeedCoefficient);
+			CalculateSkinningPalette();
+		}
+		else if (m_transitionStack.IsTransitioning())
+		{
+			m_transitionStack.Evaluate(localPose);
+			ApplyIK();
+			ApplySpringBones(p_deltaTime * m_globalSpeedCoefficient);
+			CalculateSkinningPalette();
+		}
+		else if (m_poseCache && !m_chainIK && !m_aimConstraints && !m_footPlanting && !m_limbIK && !m_springBones && m_timeline.IsPlaying())
+		{
+			EvaluatePoseFromCache();
+		}
+		else
+		{
+			EvaluateLocalPose(m_timeline.CalculateInterpolationAlpha());
+			ApplyIK();
+			ApplySpringBones(p_deltaTime * m_globalSpeedCoefficient);
+			CalculateSkinningPalette();
+		}
 	}
+
+	/* The bones are only read to draw the skeleton : they are updated on demand (Baked animations don't change the local pose) */
+	if (!IsPlayingBakedAnimation())
+		m_skeletonOutdated = true;
 }
 
 void AnimationProgramming::Animation::Animator::UpdateFrameTransformations()
@@ -97,78 +411,423 @@ void AnimationProgramming::Animation::Animator::UpdateFrameTransformations()
 	m_currentKeyFrameTransformations.clear();
 	m_nextKeyFrameTransformations.clear();
 
-	for (Rig::Bone& bone : m_skeleton.GetBones())
-	{
-		const Animation::AnimationInfo& animationInfo = m_currentAnimation->attachedAnimation;
+	const uint32_t boneCount = GetDefinition().GetBoneCount();
+	const Animation::AnimationInfo& animationInfo = m_currentAnimation->attachedAnimation;
 
-		m_currentKeyFrameTransformations.push_back(animationInfo.GetBoneTransformations(bone.GetIndex(), m_timeline.GetCurrentKeyFrame()));
-		m_nextKeyFrameTransformations.push_back(animationInfo.GetBoneTransformations(bone.GetIndex(), m_timeline.GetNextKeyFrame()));
+	for (uint32_t bone = 0; bone < boneCount; ++bone)
+	{
+		m_currentKeyFrameTransformations.push_back(animationInfo.GetBoneTransformations(bone, m_timeline.GetCurrentKeyFrame()));
+		m_nextKeyFrameTransformations.push_back(animationInfo.GetBoneTransformations(bone, m_timeline.GetNextKeyFrame()));
 	}
 }
 
 void AnimationProgramming::Animation::Animator::CalculateTransitionStartAndEndPoint(float p_previousAlpha)
 {
-	for (Rig::Bone& bone : m_skeleton.GetBones())
+	const uint32_t boneCount = GetDefinition().GetBoneCount();
+
+	for (uint32_t bone = 0; bone < boneCount; ++bone)
 	{
-		auto[startPosition, startRotation] = CalculateInterpolation(bone.GetIndex(), p_previousAlpha);
-		m_currentKeyFrameTransformations[bone.GetIndex()].first = startPosition;
-		m_currentKeyFrameTransformations[bone.GetIndex()].second = startRotation;
+		auto[startPosition, startRotation] = CalculateInterpolation(bone, p_previousAlpha);
+		m_currentKeyFrameTransformations[bone].first = startPosition;
+		m_currentKeyFrameTransformations[bone].second = startRotation;
 
-		auto[newEndPosition, newEndRotation] = m_currentAnimation->attachedAnimation.GetBoneTransformations(bone.GetIndex(), m_timeline.GetFirstKeyFrame());
-		m_nextKeyFrameTransformations[bone.GetIndex()].first = newEndPosition;
-		m_nextKeyFrameTransformations[bone.GetIndex()].second = newEndRotation;
+		auto[newEndPosition, newEndRotation] = m_currentAnimation->attachedAnimation.GetBoneTransformations(bone, m_timeline.GetEntryKeyFrame());
+		m_nextKeyFrameTransformations[bone].first = newEndPosition;
+		m_nextKeyFrameTransformations[bone].second = newEndRotation;
 	}
 }
 
 AnimationProgramming::Data::Transformation AnimationProgramming::Animation::Animator::CalculateInterpolation(uint32_t p_boneIndex, float p_alpha)
 {
 	/* Get the start and end informations used for the interpolation */
-	AltMath::Vector3f& startPosition = m_currentKeyFrameTransformations[p_boneIndex].first;
-	AltMath::Vector3f& endPosition = m_nextKeyFrameTransformations[p_boneIndex].first;
-	AltMath::Quaternion& startRotation = m_currentKeyFrameTransformations[p_boneIndex].second;
-	AltMath::Quaternion& endRotation = m_nextKeyFrameTransformations[p_boneIndex].second;
+	const AltMath::Vector3f& startPosition = m_currentKeyFrameTransformations[p_boneIndex].first;
+	const AltMath::Vector3f& endPosition = m_nextKeyFrameTransformations[p_boneIndex].first;
+	const AltMath::Quaternion& startRotation = m_currentKeyFrameTransformations[p_boneIndex].second;
+	const AltMath::Quaternion& endRotation = m_nextKeyFrameTransformations[p_boneIndex].second;
 
-	/* Calculate the actual interpolation */
-	AltMath::Vector3f currentPosition = AltMath::Vector3f::Lerp(startPosition, endPosition, p_alpha);
-	AltMath::Quaternion currentRotation = AltMath::Quaternion::Slerp(startRotation, endRotation, p_alpha);
+	/* Calculate the actual interpolation (Dispatched to the fastest instruction set available) */
+	AltMath::Vector3f currentPosition = Tools::SIMD::Lerp(startPosition, endPosition, p_alpha);
+	AltMath::Quaternion currentRotation = Tools::SIMD::Slerp(startRotation, endRotation, p_alpha);
 
 	return std::make_pair(currentPosition, currentRotation);
 }
 
 void AnimationProgramming::Animation::Animator::ApplyAnimationToSkeleton()
 {
-	for (Rig::Bone& bone : m_skeleton.GetBones())
+	EvaluateLocalPose(m_timeline.CalculateInterpolationAlpha());
+	ApplyLocalPoseToSkeleton();
+}
+
+void AnimationProgramming::Animation::Animator::EvaluateLocalPose(float p_alpha)
+{
+	std::vector<Data::Transformation>& localPose = GetInstance().GetLocalPose();
+
+	for (uint32_t bone = 0; bone < localPose.size(); ++bone)
+		localPose[bone] = CalculateInterpolation(bone, p_alpha);
+}
+
+void AnimationProgramming::Animation::Animator::ApplyLocalPoseToSkeleton()
+{
+	if (m_skeleton)
 	{
-		float alpha = m_timeline.CalculateInterpolationAlpha();
-		auto[currentPosition, currentRotation] = CalculateInterpolation(bone.GetIndex(), alpha);
-		bone.SetRelativePositionAndRotation(currentPosition, currentRotation);
+		const std::vector<Data::Transformation>& localPose = GetInstance().GetLocalPose();
+
+		for (Rig::Bone& bone : m_skeleton->GetBones())
+		{
+			auto&[currentPosition, currentRotation] = localPose[bone.GetIndex()];
+			bone.SetRelativePositionAndRotation(currentPosition, currentRotation);
+		}
 	}
+
+	m_skeletonOutdated = false;
 }
 
 void AnimationProgramming::Animation::Animator::ApplyBindPoseToSkeleton()
 {
-	for (Rig::Bone& bone : m_skeleton.GetBones())
-		bone.ResetPositionAndRotation();
+	GetInstance().ResetToBindPose();
+
+	if (m_skeleton)
+	{
+		for (Rig::Bone& bone : m_skeleton->GetBones())
+			bone.ResetPositionAndRotation();
+	}
+
+	m_skeletonOutdated = false;
+}
+
+void AnimationProgramming::Animation::Animator::UpdateSkeleton()
+{
+	if (m_skeletonOutdated)
+		ApplyLocalPoseToSkeleton();
+}
+
+bool AnimationProgramming::Animation::Animator::IsSkeletonOutdated() const
+{
+	return m_skeletonOutdated;
 }
 
 void AnimationProgramming::Animation::Animator::SendSkinningMatricesToGPU()
 {
-	/* Prepare a set of data to send to GPU */
-	std::vector<AltMath::Matrix4f> skinningPoseData;
+	CalculateSkinningPalette();
+	UploadSkinningPalette();
+}
+
+void AnimationProgramming::Animation::Animator::CalculateSkinningPalette()
+{
+	if (m_skinningPaletteFormat == ESkinningPaletteFormat::DUAL_QUATERNION)
+		CalculateDualQuaternionPalette();
+	else
+		CalculateMatrixPalette();
+}
+
+void AnimationProgramming::Animation::Animator::UploadSkinningPalette()
+{
+	/* Send the actual data to GPU (Baked animations only store matrices) */
+	if (m_skinningPaletteFormat == ESkinningPaletteFormat::DUAL_QUATERNION && !IsPlayingBakedAnimation())
+		Core::AnimationEngine::SetSkinningPose(GetInstance().GetDualQuaternionPalette());
+	else
+		Core::AnimationEngine::SetSkinningPose(GetInstance().GetSkinningPalette());
+}
 
-	for (Rig::Bone& bone : m_skeleton.GetBones())
+void AnimationProgramming::Animation::Animator::UploadInterpolatedSkinningPalette(float p_alpha)
+{
+	/* Nothing ticked yet */
+	if (!m_instance)
+		return;
+
+	if (IsPlayingBakedAnimation())
 	{
-		/* We ignore IK for now */
-		if (!bone.IsIK())
+		const std::vector<Data::Matrix3x4>& skinningPalette = m_instance->GetSkinningPalette();
+
+		/* Without a previous tick (First tick, or the palette just changed), the last tick is sent as is */
+		if (m_previousTickPalette.size() != skinningPalette.size())
 		{
-			AltMath::Matrix4f boneCurrentWorldMatrix = bone.GetTransform().GetWorldMatrix();
-			AltMath::Matrix4f boneDefaultWorldMatrix = bone.GetDefaultTransform().GetWorldMatrix();
+			UploadSkinningPalette();
+			return;
+		}
+
+		/* The baked matrices are rigid : their rotations and translations are interpolated apart (Lerping the matrices would shear and shrink them) */
+		m_interpolatedPalette.resize(skinningPalette.size());
 
-			/* The GPU is waiting for matrices resulting from : BoneCurrentWorldMatrix * Inverse(BoneTPoseWorldMatrix) */
-			skinningPoseData.push_back(boneCurrentWorldMatrix * boneDefaultWorldMatrix.Inverse());
+		for (size_t i = 0; i < skinningPalette.size(); ++i)
+		{
+			const AltMath::Vector3f position = Tools::SIMD::Lerp(m_previousTickPalette[i].GetPosition(), skinningPalette[i].GetPosition(), p_alpha);
+			const AltMath::Quaternion rotation = Tools::SIMD::Slerp(m_previousTickPalette[i].GetRotation(), skinningPalette[i].GetRotation(), p_alpha);
+			m_interpolatedPalette[i] = Data::Matrix3x4(position, rotation);
 		}
+
+		Core::AnimationEngine::SetSkinningPose(m_interpolatedPalette);
+		return;
+	}
+
+	const std::vector<Data::Transformation>& localPose = m_instance->GetLocalPose();
+
+	if (m_previousTickLocalPose.size() != localPose.size())
+	{
+		UploadSkinningPalette();
+		return;
+	}
+
+	/* The two ticks are interpolated like two key frames, then the hierarchy and the palette are calculated from the result (Apart from the buffers of the last tick) */
+	m_interpolatedLocalPose.resize(localPose.size());
+
+	for (size_t i = 0; i < localPose.size(); ++i)
+	{
+		m_interpolatedLocalPose[i].first = Tools::SIMD::Lerp(m_previousTickLocalPose[i].first, localPose[i].first, p_alpha);
+		m_interpolatedLocalPose[i].second = Tools::SIMD::Slerp(m_previousTickLocalPose[i].second, localPose[i].second, p_alpha);
+	}
+
+	const Rig::SkeletonDefinition& definition = m_instance->GetDefinition();
+
+	if (m_skinningPaletteFormat == ESkinningPaletteFormat::DUAL_QUATERNION)
+	{
+		definition.CalculateDualQuaternionPalette(m_interpolatedLocalPose, m_interpolatedWorldDualQuaternions, m_interpolatedDualQuaternionPalette);
+		Core::AnimationEngine::SetSkinningPose(m_interpolatedDualQuaternionPalette);
 	}
+	else
+	{
+		definition.CalculateModelMatrices(m_interpolatedLocalPose, m_interpolatedModelMatrices);
+		definition.CalculateSkinningPalette(m_interpolatedModelMatrices, m_interpolatedPalette);
+		Core::AnimationEngine::SetSkinningPose(m_interpolatedPalette);
+	}
+}
 
-	/* Send the actual data to GPU */
-	Core::AnimationEngine::SetSkinningPose(skinningPoseData);
+const std::vector<AnimationProgramming::Data::Matrix3x4>& AnimationProgramming::Animation::Animator::GetSkinningPalette() const
+{
+	return m_instance ? m_instance->GetSkinningPalette() : kNoMatrixPalette;
+}
+
+const std::vector<AnimationProgramming::Data::DualQuaternion>& AnimationProgramming::Animation::Animator::GetDualQuaternionPalette() const
+{
+	return m_instance ? m_instance->GetDualQuaternionPalette() : kNoDualQuaternionPalette;
+}
+
+const std::vector<AnimationProgramming::Data::Transformation>& AnimationProgramming::Animation::Animator::GetLocalPose() const
+{
+	return m_instance ? m_instance->GetLocalPose() : kNoLocalPose;
+}
+
+void AnimationProgramming::Animation::Animator::SaveSnapshot(Tools::Snapshot& p_snapshot) const
+{
+	m_timeline.SaveSnapshot(p_snapshot);
+
+	p_snapshot.Write(m_currentAnimation);
+	p_snapshot.WriteArray(m_currentKeyFrameTransformations);
+	p_snapshot.WriteArray(m_nextKeyFrameTransformations);
+
+	p_snapshot.Write(m_bakedAnimation);
+	p_snapshot.Write(m_bakedTime);
+
+	/* The played pose source is saved as its index (The pointer would be the source of this animator only) */
+	const auto poseSource = std::find(m_poseSources.begin(), m_poseSources.end(), m_poseSource);
+	p_snapshot.Write(poseSource != m_poseSources.end() ? static_cast<uint32_t>(poseSource - m_poseSources.begin()) : kNoPoseSource);
+
+	/* The pose buffers only exist once the definition was requested */
+	p_snapshot.Write(m_instance.has_value());
+	if (m_instance)
+		m_instance->SaveSnapshot(p_snapshot);
+
+	p_snapshot.Write(m_transitionMode);
+	m_inertializer.SaveSnapshot(p_snapshot);
+	p_snapshot.WriteArray(m_previousLocalPose);
+	p_snapshot.Write(m_previousDeltaTime);
+	m_transitionStack.SaveSnapshot(p_snapshot);
+
+	p_snapshot.Write(static_cast<uint32_t>(m_aimTargets.size()));
+
+	for (const AimConstraints::Target& target : m_aimTargets)
+	{
+		p_snapshot.Write(target.position);
+		p_snapshot.Write(target.weight);
+	}
+
+	p_snapshot.Write(m_skinningPaletteFormat);
+
+	p_snapshot.Write(m_tickRate);
+	m_tickClock.SaveSnapshot(p_snapshot);
+	p_snapshot.WriteArray(m_previousTickLocalPose);
+	p_snapshot.WriteArray(m_previousTickPalette);
+
+	p_snapshot.Write(m_globalSpeedCoefficient);
+
+	/* The post-passes keep a state between frames : a rollback without it would diverge from the saved frame */
+	if (m_chainIK)
+		m_chainIK->SaveSnapshot(p_snapshot);
+
+	if (m_footPlanting)
+		m_footPlanting->SaveSnapshot(p_snapshot);
+
+	if (m_springBones)
+		m_springBones->SaveSnapshot(p_snapshot);
+
+	/* The pose sources keep their playback state (Phase, time...) : the ones which aren't played are saved too, to be played again from it */
+	for (const IPoseSource* source : m_poseSources)
+		source->SaveSnapshot(p_snapshot);
+}
+
+void AnimationProgramming::Animation::Animator::RestoreSnapshot(Tools::Snapshot& p_snapshot)
+{
+	m_timeline.RestoreSnapshot(p_snapshot);
+	m_skeletonOutdated = true;
+
+	p_snapshot.Read(m_currentAnimation);
+	p_snapshot.ReadArray(m_currentKeyFrameTransformations);
+	p_snapshot.ReadArray(m_nextKeyFrameTransformations);
+
+	p_snapshot.Read(m_bakedAnimation);
+	p_snapshot.Read(m_bakedTime);
+
+	uint32_t poseSource = kNoPoseSource;
+	p_snapshot.Read(poseSource);
+	m_poseSource = poseSource < m_poseSources.size() ? m_poseSources[poseSource] : nullptr;
+
+	bool hasInstance = false;
+	p_snapshot.Read(hasInstance);
+	if (hasInstance)
+		GetInstance().RestoreSnapshot(p_snapshot);
+
+	p_snapshot.Read(m_transitionMode);
+	m_inertializer.RestoreSnapshot(p_snapshot);
+	p_snapshot.ReadArray(m_previousLocalPose);
+	p_snapshot.Read(m_previousDeltaTime);
+	m_transitionStack.RestoreSnapshot(p_snapshot);
+
+	m_aimTargets.resize(p_snapshot.ReadArraySize(sizeof(float) * 4));
+
+	for (AimConstraints::Target& target : m_aimTargets)
+	{
+		p_snapshot.Read(target.position);
+		p_snapshot.Read(target.weight);
+	}
+
+	p_snapshot.Read(m_skinningPaletteFormat);
+
+	p_snapshot.Read(m_tickRate);
+	m_tickClock.RestoreSnapshot(p_snapshot);
+	p_snapshot.ReadArray(m_previousTickLocalPose);
+	p_snapshot.ReadArray(m_previousTickPalette);
+
+	p_snapshot.Read(m_globalSpeedCoefficient);
+
+	if (m_chainIK)
+		m_chainIK->RestoreSnapshot(p_snapshot);
+
+	if (m_footPlanting)
+		m_footPlanting->RestoreSnapshot(p_snapshot);
+
+	if (m_springBones)
+		m_springBones->RestoreSnapshot(p_snapshot);
+
+	for (IPoseSource* source : m_poseSources)
+		source->RestoreSnapshot(p_snapshot);
+}
+
+AnimationProgramming::Rig::SkeletonInstance& AnimationProgramming::Animation::Animator::GetInstance()
+{
+	if (!m_instance)
+		m_instance.emplace(m_skeleton->GetDefinition());
+
+	return *m_instance;
+}
+
+const AnimationProgramming::Rig::SkeletonDefinition& AnimationProgramming::Animation::Animator::GetDefinition()
+{
+	return GetInstance().GetDefinition();
+}
+
+void AnimationProgramming::Animation::Animator::EvaluatePoseFromCache()
+{
+	const PoseCacheKey key = m_poseCache->MakeKey(GetDefinition(), m_currentAnimation->attachedAnimation, m_timeline.GetCurrentKeyFrame(), m_timeline.GetNextKeyFrame(), m_timeline.CalculateInterpolationAlpha(), GetEffectorBits(), m_skinningPaletteFormat);
+
+	bool evaluated = false;
+	std::shared_ptr<const CachedPose> pose = m_poseCache->GetOrEvaluate(key, [this](CachedPose& p_pose)
+	{
+		EvaluateLocalPose(m_timeline.CalculateInterpolationAlpha());
+		CalculateSkinningPalette();
+
+		p_pose.localPose = m_instance->GetLocalPose();
+		p_pose.matrixPalette = m_instance->GetSkinningPalette();
+		p_pose.dualQuaternionPalette = m_instance->GetDualQuaternionPalette();
+	}, evaluated);
+
+	/* Another animator evaluated this pose : we skip the sampling, the hierarchy update and the palette calculation */
+	if (!evaluated)
+	{
+		m_instance->GetLocalPose() = pose->localPose;
+		m_instance->GetSkinningPalette() = pose->matrixPalette;
+		m_instance->GetDualQuaternionPalette() = pose->dualQuaternionPalette;
+	}
+}
+
+void AnimationProgramming::Animation::Animator::ApplyIK()
+{
+	std::vector<Data::Transformation>& localPose = GetInstance().GetLocalPose();
+
+	/* The chains (Spine, neck...) move the limbs : they are solved first */
+	if (m_chainIK)
+		m_chainIK->Solve(localPose);
+
+	/* The head and the weapon follow their targets before the feet are planted */
+	if (m_aimConstraints)
+		m_aimConstraints->Apply({ &localPose }, m_aimTargets);
+
+	if (m_footPlanting && m_ground)
+	{
+		/* The foot contacts come from the played animation (A pose source has none : both feet are down) */
+		if (HasAnimation() && !IsPlayingPoseSource())
+			m_footPlanting->SetContacts(&m_currentAnimation->attachedAnimation, m_timeline.GetCurrentKeyFrame(), m_timeline.GetNextKeyFrame(), m_timeline.CalculateInterpolationAlpha());
+		else
+			m_footPlanting->SetContacts(nullptr);
+
+		m_footPlanting->Solve(localPose, *m_ground);
+	}
+
+	if (!m_limbIK)
+		return;
+
+	/* The IK bones of the played animation are the default targets (A pose source has none) */
+	if (HasAnimation() && !IsPlayingPoseSource())
+		m_limbIK->SetIKBonePose(m_currentAnimation->attachedAnimation, m_timeline.GetCurrentKeyFrame(), m_timeline.GetNextKeyFrame(), m_timeline.CalculateInterpolationAlpha());
+	else
+		m_limbIK->ClearIKBonePose();
+
+	m_limbIK->Solve(localPose);
+}
+
+void AnimationProgramming::Animation::Animator::ApplySpringBones(float p_deltaTime)
+{
+	/* The secondary motion reacts to the final pose : it comes after every IK */
+	if (m_springBones)
+		m_springBones->Solve(GetInstance().GetLocalPose(), p_deltaTime);
+}
+
+uint32_t AnimationProgramming::Animation::Animator::GetEffectorBits() const
+{
+	const ETimelineEffector effectors[] =
+	{
+		ETimelineEffector::REWIND,
+		ETimelineEffector::IGNORE_LOOPING,
+		ETimelineEffector::IGNORE_TRANSITIONING,
+		ETimelineEffector::IGNORE_FRAME_INTERPOLATION
+	};
+
+	uint32_t bits = 0;
+
+	for (ETimelineEffector effector : effectors)
+		bits |= m_timeline.GetEffector(effector) ? 1u << static_cast<uint32_t>(effector) : 0u;
+
+	return bits;
+}
+
+void AnimationProgramming::Animation::Animator::CalculateMatrixPalette()
+{
+	/* The GPU is waiting for matrices resulting from : BoneCurrentWorldMatrix * Inverse(BoneTPoseWorldMatrix) (The buffers are kept between frames) */
+	Rig::SkeletonInstance& instance = GetInstance();
+	instance.UpdateModelMatrices();
+	instance.CalculateSkinningPalette();
+}
+
+void AnimationProgramming::Animation::Animator::CalculateDualQuaternionPalette()
+{
+	GetInstance().CalculateDualQuaternionPalette();
 }
\ No newline at end of file
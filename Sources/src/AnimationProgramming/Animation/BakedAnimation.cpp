@@ -0,0 +1,106 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "AnimationProgramming/Animation/BakedAnimation.h"
+
+AnimationProgramming::Animation::BakedAnimation::BakedAnimation(uint32_t p_frameCount, uint32_t p_paletteSize, float p_sampleRate, float p_duration, bool p_loop, float p_speedCoefficient, EBakedPrecision p_precision) :
+	m_frameCount(p_frameCount),
+	m_paletteSize(p_paletteSize),
+	m_sampleRate(p_sampleRate),
+	m_duration(p_duration),
+	m_loop(p_loop),
+	m_speedCoefficient(p_speedCoefficient),
+	m_precision(p_precision)
+{
+	if (m_precision == EBakedPrecision::HALF)
+		m_halfPalettes.resize(static_cast<size_t>(m_frameCount) * m_paletteSize);
+	else
+		m_palettes.resize(static_cast<size_t>(m_frameCount) * m_paletteSize);
+}
+
+uint32_t AnimationProgramming::Animation::BakedAnimation::GetFrameCount() const
+{
+	return m_frameCount;
+}
+
+uint32_t AnimationProgramming::Animation::BakedAnimation::GetPaletteSize() const
+{
+	return m_paletteSize;
+}
+
+float AnimationProgramming::Animation::BakedAnimation::GetSampleRate() const
+{
+	return m_sampleRate;
+}
+
+float AnimationProgramming::Animation::BakedAnimation::GetDuration() const
+{
+	return m_duration;
+}
+
+bool AnimationProgramming::Animation::BakedAnimation::IsLooping() const
+{
+	return m_loop;
+}
+
+float AnimationProgramming::Animation::BakedAnimation::GetSpeedCoefficient() const
+{
+	return m_speedCoefficient;
+}
+
+AnimationProgramming::Animation::EBakedPrecision AnimationProgramming::Animation::BakedAnimation::GetPrecision() const
+{
+	return m_precision;
+}
+
+size_t AnimationProgramming::Animation::BakedAnimation::GetMemorySize() const
+{
+	return m_palettes.size() * sizeof(Data::Matrix3x4) + m_halfPalettes.size() * sizeof(Data::HalfMatrix3x4);
+}
+
+uint32_t AnimationProgramming::Animation::BakedAnimation::GetFrameIndex(float p_time) const
+{
+	if (m_frameCount == 0)
+		return 0;
+
+	if (m_loop && m_duration > 0.0f)
+	{
+		float time = std::fmod(p_time, m_duration);
+		if (time < 0.0f)
+			time += m_duration;
+
+		/* Rounding the time just before the end gives the frame count, which is the first frame again */
+		return static_cast<uint32_t>(time * m_sampleRate + 0.5f) % m_frameCount;
+	}
+
+	const float frame = std::max(p_time, 0.0f) * m_sampleRate + 0.5f;
+	return std::min(static_cast<uint32_t>(std::min(frame, static_cast<float>(m_frameCount))), m_frameCount - 1);
+}
+
+void AnimationProgramming::Animation::BakedAnimation::SetFramePalette(uint32_t p_frame, const std::vector<Data::Matrix3x4>& p_palette)
+{
+	const size_t offset = static_cast<size_t>(p_frame) * m_paletteSize;
+
+	if (m_precision == EBakedPrecision::HALF)
+		std::copy(p_palette.begin(), p_palette.begin() + m_paletteSize, m_halfPalettes.begin() + offset);
+	else
+		std::copy(p_palette.begin(), p_palette.begin() + m_paletteSize, m_palettes.begin() + offset);
+}
+
+void AnimationProgramming::Animation::BakedAnimation::ReadFramePalette(uint32_t p_frame, std::vector<Data::Matrix3x4>& p_palette) const
+{
+	const size_t offset = static_cast<size_t>(p_frame) * m_paletteSize;
+
+	p_palette.resize(m_paletteSize);
+
+	if (m_precision == EBakedPrecision::HALF)
+		Data::HalfMatrix3x4::ToMatrix3x4(m_halfPalettes.data() + offset, p_palette.data(), m_paletteSize);
+	else
+		std::copy(m_palettes.begin() + offset, m_palettes.begin() + offset + m_paletteSize, p_palette.begin());
+}
@@ -0,0 +1,443 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#include "AnimationProgramming/Animation/BlendSpace2D.h"
+
+namespace
+{
+	/* Samples closer than this are considered as the same point by the triangulation */
+	constexpr double kDuplicateDistance = 1e-6;
+
+	/* Size of the triangle containing every sample at the start of the triangulation (Relatively to the extent of the samples) */
+	constexpr double kSuperTriangleScale = 1000.0;
+
+	struct Point
+	{
+		double x;
+		double y;
+	};
+
+	struct BuildTriangle
+	{
+		uint32_t vertices[3];
+		Point circumcenter;
+		double squaredRadius;
+	};
+
+	double Cross(const Point& p_origin, const Point& p_a, const Point& p_b)
+	{
+		return (p_a.x - p_origin.x) * (p_b.y - p_origin.y) - (p_a.y - p_origin.y) * (p_b.x - p_origin.x);
+	}
+
+	BuildTriangle MakeTriangle(const std::vector<Point>& p_points, uint32_t p_a, uint32_t p_b, uint32_t p_c)
+	{
+		/* Counter-clockwise vertices */
+		if (Cross(p_points[p_a], p_points[p_b], p_points[p_c]) < 0.0)
+			std::swap(p_b, p_c);
+
+		const Point& a = p_points[p_a];
+		const Point& b = p_points[p_b];
+		const Point& c = p_points[p_c];
+
+		BuildTriangle triangle = { { p_a, p_b, p_c }, { 0.0, 0.0 }, -1.0 };
+
+		const double determinant = 2.0 * (a.x * (b.y - c.y) + b.x * (c.y - a.y) + c.x * (a.y - b.y));
+
+		/* A flat triangle has no circumcircle : it is never considered as containing a point, and is removed at the end */
+		if (std::abs(determinant) > 0.0)
+		{
+			const double aSquared = a.x * a.x + a.y * a.y;
+			const double bSquared = b.x * b.x + b.y * b.y;
+			const double cSquared = c.x * c.x + c.y * c.y;
+
+			triangle.circumcenter.x = (aSquared * (b.y - c.y) + bSquared * (c.y - a.y) + cSquared * (a.y - b.y)) / determinant;
+			triangle.circumcenter.y = (aSquared * (c.x - b.x) + bSquared * (a.x - c.x) + cSquared * (b.x - a.x)) / determinant;
+
+			const double dx = a.x - triangle.circumcenter.x;
+			const double dy = a.y - triangle.circumcenter.y;
+			triangle.squaredRadius = dx * dx + dy * dy;
+		}
+
+		return triangle;
+	}
+
+	float Cross2D(const AltMath::Vector2f& p_a, const AltMath::Vector2f& p_b)
+	{
+		return p_a.x * p_b.y - p_a.y * p_b.x;
+	}
+
+	float Dot2D(const AltMath::Vector2f& p_a, const AltMath::Vector2f& p_b)
+	{
+		return p_a.x * p_b.x + p_a.y * p_b.y;
+	}
+}
+
+uint32_t AnimationProgramming::Animation::BlendSpace2D::AddSample(const AnimationInstance& p_animation, const AltMath::Vector2f& p_position, const SyncMarkerTrack* p_markers)
+{
+	m_samples.push_back({ &p_animation, p_markers, p_position });
+	m_built = false;
+	return static_cast<uint32_t>(m_samples.size() - 1);
+}
+
+void AnimationProgramming::Animation::BlendSpace2D::Build()
+{
+	m_triangles.clear();
+	m_cellStarts.clear();
+	m_cellTriangles.clear();
+	m_lineOrder.clear();
+	m_lineProjections.clear();
+	m_built = true;
+
+	if (m_samples.empty())
+		return;
+
+	Triangulate();
+
+	if (!m_triangles.empty())
+	{
+		BuildGrid();
+		return;
+	}
+
+	/* Aligned samples : the line goes from the first sample to the farthest one */
+	m_lineOrigin = m_samples.front().position;
+	m_lineDirection = AltMath::Vector2f(1.0f, 0.0f);
+
+	float farthestDistance = 0.0f;
+	for (const Sample& sample : m_samples)
+	{
+		const AltMath::Vector2f offset = sample.position - m_lineOrigin;
+		const float distance = std::sqrt(Dot2D(offset, offset));
+
+		if (distance > farthestDistance)
+		{
+			farthestDistance = distance;
+			m_lineDirection = offset / distance;
+		}
+	}
+
+	m_lineOrder.resize(m_samples.size());
+	for (uint32_t i = 0; i < m_samples.size(); ++i)
+		m_lineOrder[i] = i;
+
+	std::sort(m_lineOrder.begin(), m_lineOrder.end(), [this](uint32_t p_left, uint32_t p_right)
+	{
+		return Dot2D(m_samples[p_left].position - m_lineOrigin, m_lineDirection) < Dot2D(m_samples[p_right].position - m_lineOrigin, m_lineDirection);
+	});
+
+	for (uint32_t index : m_lineOrder)
+		m_lineProjections.push_back(Dot2D(m_samples[index].position - m_lineOrigin, m_lineDirection));
+}
+
+uint32_t AnimationProgramming::Animation::BlendSpace2D::GetSampleCount() const
+{
+	return static_cast<uint32_t>(m_samples.size());
+}
+
+const AnimationProgramming::Animation::BlendSpace2D::Sample& AnimationProgramming::Animation::BlendSpace2D::GetSample(uint32_t p_index) const
+{
+	return m_samples[p_index];
+}
+
+uint32_t AnimationProgramming::Animation::BlendSpace2D::GetTriangleCount() const
+{
+	return static_cast<uint32_t>(m_triangles.size());
+}
+
+void AnimationProgramming::Animation::BlendSpace2D::FindWeights(const AltMath::Vector2f& p_position, Weights& p_weights) const
+{
+	p_weights.count = 0;
+
+	/* Without a build, the triangles and the line don't match the samples : nothing is blended */
+	assert(m_built && "BlendSpace2D::Build must be called after the last AddSample");
+	if (!m_built)
+		return;
+
+	if (m_samples.size() < 2)
+	{
+		if (!m_samples.empty())
+		{
+			p_weights.count = 1;
+			p_weights.samples[0] = 0;
+			p_weights.weights[0] = 1.0f;
+		}
+
+		return;
+	}
+
+	if (m_triangles.empty())
+	{
+		FindLineWeights(p_position, p_weights);
+		return;
+	}
+
+	/* The axes of the blend space range over the samples : the grid covers every clamped position */
+	const AltMath::Vector2f position(std::clamp(p_position.x, m_gridMin.x, m_gridMax.x), std::clamp(p_position.y, m_gridMin.y, m_gridMax.y));
+
+	const uint32_t cellX = std::min(static_cast<uint32_t>((position.x - m_gridMin.x) / m_cellSize.x), m_cellsPerAxis - 1);
+	const uint32_t cellY = std::min(static_cast<uint32_t>((position.y - m_gridMin.y) / m_cellSize.y), m_cellsPerAxis - 1);
+	const uint32_t cell = cellY * m_cellsPerAxis + cellX;
+
+	float closestDistance = std::numeric_limits<float>::max();
+	uint32_t closestTriangle = 0;
+	float closestBarycentric[3] = {};
+
+	for (uint32_t i = m_cellStarts[cell]; i < m_cellStarts[cell + 1]; ++i)
+	{
+		float barycentric[3];
+		const float distance = CalculateClosestPoint(position, m_triangles[m_cellTriangles[i]], barycentric);
+
+		if (distance < closestDistance)
+		{
+			closestDistance = distance;
+			closestTriangle = m_cellTriangles[i];
+			std::copy(barycentric, barycentric + 3, closestBarycentric);
+
+			if (distance <= 0.0f)
+				break;
+		}
+	}
+
+	float totalWeight = 0.0f;
+
+	for (uint32_t vertex = 0; vertex < 3; ++vertex)
+	{
+		if (closestBarycentric[vertex] > 0.0f)
+		{
+			p_weights.samples[p_weights.count] = m_triangles[closestTriangle].vertices[vertex];
+			p_weights.weights[p_weights.count] = closestBarycentric[vertex];
+			totalWeight += closestBarycentric[vertex];
+			++p_weights.count;
+		}
+	}
+
+	for (uint32_t i = 0; i < p_weights.count; ++i)
+		p_weights.weights[i] /= totalWeight;
+}
+
+void AnimationProgramming::Animation::BlendSpace2D::Triangulate()
+{
+	std::vector<Point> points;
+	points.reserve(m_samples.size() + 3);
+
+	Point minimum = { m_samples.front().position.x, m_samples.front().position.y };
+	Point maximum = minimum;
+
+	for (const Sample& sample : m_samples)
+	{
+		points.push_back({ sample.position.x, sample.position.y });
+		minimum = { std::min(minimum.x, points.back().x), std::min(minimum.y, points.back().y) };
+		maximum = { std::max(maximum.x, points.back().x), std::max(maximum.y, points.back().y) };
+	}
+
+	const uint32_t sampleCount = static_cast<uint32_t>(m_samples.size());
+	if (sampleCount < 3)
+		return;
+
+	/* A triangle containing every sample starts the triangulation, its vertices are removed at the end */
+	const double extent = std::max({ maximum.x - minimum.x, maximum.y - minimum.y, 1.0 }) * kSuperTriangleScale;
+	const Point center = { (minimum.x + maximum.x) * 0.5, (minimum.y + maximum.y) * 0.5 };
+
+	points.push_back({ center.x - extent, center.y - extent });
+	points.push_back({ center.x + extent, center.y - extent });
+	points.push_back({ center.x, center.y + extent });
+
+	std::vector<BuildTriangle> triangles = { MakeTriangle(points, sampleCount, sampleCount + 1, sampleCount + 2) };
+	std::vector<std::pair<uint32_t, uint32_t>> edges;
+
+	for (uint32_t i = 0; i < sampleCount; ++i)
+	{
+		const Point& point = points[i];
+
+		/* A duplicated sample would create flat triangles : only the first one is triangulated */
+		bool duplicated = false;
+		for (uint32_t j = 0; j < i && !duplicated; ++j)
+			duplicated = std::abs(points[j].x - point.x) < kDuplicateDistance && std::abs(points[j].y - point.y) < kDuplicateDistance;
+
+		if (duplicated)
+			continue;
+
+		/* The triangles whose circumcircle contains the point are removed, and the hole is filled with triangles fanning from the point */
+		edges.clear();
+
+		for (size_t t = 0; t < triangles.size();)
+		{
+			const BuildTriangle& triangle = triangles[t];
+			const double dx = point.x - triangle.circumcenter.x;
+			const double dy = point.y - triangle.circumcenter.y;
+
+			if (triangle.squaredRadius >= 0.0 && dx * dx + dy * dy < triangle.squaredRadius)
+			{
+				for (uint32_t edge = 0; edge < 3; ++edge)
+					edges.emplace_back(triangle.vertices[edge], triangle.vertices[(edge + 1) % 3]);
+
+				triangles[t] = triangles.back();
+				triangles.pop_back();
+			}
+			else
+			{
+				++t;
+			}
+		}
+
+		/* The edges shared by two removed triangles are inside the hole */
+		for (size_t e = 0; e < edges.size(); ++e)
+		{
+			bool shared = false;
+
+			for (size_t other = 0; other < edges.size(); ++other)
+			{
+				if (other != e && edges[other].first == edges[e].second && edges[other].second == edges[e].first)
+				{
+					shared = true;
+					break;
+				}
+			}
+
+			if (!shared)
+				triangles.push_back(MakeTriangle(points, edges[e].first, edges[e].second, i));
+		}
+	}
+
+	for (const BuildTriangle& triangle : triangles)
+	{
+		const bool usesSuperTriangle = triangle.vertices[0] >= sampleCount || triangle.vertices[1] >= sampleCount || triangle.vertices[2] >= sampleCount;
+		const double area = Cross(points[triangle.vertices[0]], points[triangle.vertices[1]], points[triangle.vertices[2]]);
+
+		if (!usesSuperTriangle && area > kDuplicateDistance * kDuplicateDistance)
+			m_triangles.push_back({ { triangle.vertices[0], triangle.vertices[1], triangle.vertices[2] } });
+	}
+}
+
+void AnimationProgramming::Animation::BlendSpace2D::BuildGrid()
+{
+	m_gridMin = m_gridMax = m_samples.front().position;
+
+	for (const Sample& sample : m_samples)
+	{
+		m_gridMin = AltMath::Vector2f(std::min(m_gridMin.x, sample.position.x), std::min(m_gridMin.y, sample.position.y));
+		m_gridMax = AltMath::Vector2f(std::max(m_gridMax.x, sample.position.x), std::max(m_gridMax.y, sample.position.y));
+	}
+
+	/* About one triangle per cell */
+	m_cellsPerAxis = std::max(static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(m_triangles.size())))), 1u);
+	m_cellSize = AltMath::Vector2f((m_gridMax.x - m_gridMin.x) / m_cellsPerAxis, (m_gridMax.y - m_gridMin.y) / m_cellsPerAxis);
+
+	const float halfDiagonal = 0.5f * std::sqrt(Dot2D(m_cellSize, m_cellSize));
+	std::vector<float> distances(m_triangles.size());
+
+	m_cellStarts.push_back(0);
+
+	for (uint32_t cellY = 0; cellY < m_cellsPerAxis; ++cellY)
+	{
+		for (uint32_t cellX = 0; cellX < m_cellsPerAxis; ++cellX)
+		{
+			const AltMath::Vector2f center(m_gridMin.x + (cellX + 0.5f) * m_cellSize.x, m_gridMin.y + (cellY + 0.5f) * m_cellSize.y);
+			float closestDistance = std::numeric_limits<float>::max();
+
+			for (uint32_t t = 0; t < m_triangles.size(); ++t)
+			{
+				float barycentric[3];
+				distances[t] = std::sqrt(CalculateClosestPoint(center, m_triangles[t], barycentric));
+				closestDistance = std::min(closestDistance, distances[t]);
+			}
+
+			/**
+			* For any point of the cell, the closest triangle is at most (closestDistance + halfDiagonal) from the point,
+			* so at most (closestDistance + 2 * halfDiagonal) from the center : the other triangles can be ignored
+			*/
+			const float maximumDistance = closestDistance + 2.0f * halfDiagonal + 1e-5f;
+
+			for (uint32_t t = 0; t < m_triangles.size(); ++t)
+			{
+				if (distances[t] <= maximumDistance)
+					m_cellTriangles.push_back(t);
+			}
+
+			/* The containing triangles are found sooner when the closest ones are tested first */
+			std::sort(m_cellTriangles.begin() + m_cellStarts.back(), m_cellTriangles.end(), [&distances](uint32_t p_left, uint32_t p_right) { return distances[p_left] < distances[p_right]; });
+
+			m_cellStarts.push_back(static_cast<uint32_t>(m_cellTriangles.size()));
+		}
+	}
+}
+
+void AnimationProgramming::Animation::BlendSpace2D::FindLineWeights(const AltMath::Vector2f& p_position, Weights& p_weights) const
+{
+	const float projection = Dot2D(p_position - m_lineOrigin, m_lineDirection);
+	const size_t next = std::upper_bound(m_lineProjections.begin(), m_lineProjections.end(), projection) - m_lineProjections.begin();
+
+	if (next == 0 || next == m_lineProjections.size())
+	{
+		p_weights.count = 1;
+		p_weights.samples[0] = m_lineOrder[next == 0 ? 0 : next - 1];
+		p_weights.weights[0] = 1.0f;
+		return;
+	}
+
+	const float length = m_lineProjections[next] - m_lineProjections[next - 1];
+	const float alpha = length > 0.0f ? (projection - m_lineProjections[next - 1]) / length : 0.0f;
+
+	p_weights.count = 2;
+	p_weights.samples[0] = m_lineOrder[next - 1];
+	p_weights.samples[1] = m_lineOrder[next];
+	p_weights.weights[0] = 1.0f - alpha;
+	p_weights.weights[1] = alpha;
+}
+
+float AnimationProgramming::Animation::BlendSpace2D::CalculateClosestPoint(const AltMath::Vector2f& p_point, const Triangle& p_triangle, float p_barycentric[3]) const
+{
+	const AltMath::Vector2f& a = m_samples[p_triangle.vertices[0]].position;
+	const AltMath::Vector2f& b = m_samples[p_triangle.vertices[1]].position;
+	const AltMath::Vector2f& c = m_samples[p_triangle.vertices[2]].position;
+
+	/* Barycentric coordinates from the signed areas (The vertices are counter-clockwise) */
+	const float area = Cross2D(b - a, c - a);
+	const float weightA = Cross2D(c - b, p_point - b) / area;
+	const float weightB = Cross2D(a - c, p_point - c) / area;
+	const float weightC = 1.0f - weightA - weightB;
+
+	constexpr float tolerance = -1e-6f;
+
+	if (weightA >= tolerance && weightB >= tolerance && weightC >= tolerance)
+	{
+		p_barycentric[0] = std::max(weightA, 0.0f);
+		p_barycentric[1] = std::max(weightB, 0.0f);
+		p_barycentric[2] = std::max(weightC, 0.0f);
+		return 0.0f;
+	}
+
+	/* Outside : the closest point is on an edge */
+	float closestDistance = std::numeric_limits<float>::max();
+
+	for (uint32_t edge = 0; edge < 3; ++edge)
+	{
+		const uint32_t start = edge;
+		const uint32_t end = (edge + 1) % 3;
+
+		const AltMath::Vector2f& startPosition = m_samples[p_triangle.vertices[start]].position;
+		const AltMath::Vector2f direction = m_samples[p_triangle.vertices[end]].position - startPosition;
+
+		const float alpha = std::clamp(Dot2D(p_point - startPosition, direction) / Dot2D(direction, direction), 0.0f, 1.0f);
+		const AltMath::Vector2f offset = p_point - (startPosition + direction * alpha);
+		const float distance = Dot2D(offset, offset);
+
+		if (distance < closestDistance)
+		{
+			closestDistance = distance;
+			p_barycentric[start] = 1.0f - alpha;
+			p_barycentric[end] = alpha;
+			p_barycentric[3 - start - end] = 0.0f;
+		}
+	}
+
+	return closestDistance;
+}
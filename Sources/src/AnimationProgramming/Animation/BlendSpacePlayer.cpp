@@ -0,0 +1,114 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "AnimationProgramming/Animation/BlendSpacePlayer.h"
+#include "AnimationProgramming/Tools/SIMD.h"
+
+AnimationProgramming::Animation::BlendSpacePlayer::BlendSpacePlayer(const BlendSpace2D& p_blendSpace) :
+	m_blendSpace(p_blendSpace),
+	m_position(AltMath::Vector2f(0.0f, 0.0f))
+{
+	m_blendSpace.FindWeights(m_position, m_weights);
+}
+
+const AltMath::Vector2f& AnimationProgramming::Animation::BlendSpacePlayer::GetPosition() const
+{
+	return m_position;
+}
+
+void AnimationProgramming::Animation::BlendSpacePlayer::SetPosition(const AltMath::Vector2f& p_position)
+{
+	m_position = p_position;
+	m_blendSpace.FindWeights(m_position, m_weights);
+}
+
+const AnimationProgramming::Animation::BlendSpace2D::Weights& AnimationProgramming::Animation::BlendSpacePlayer::GetWeights() const
+{
+	return m_weights;
+}
+
+float AnimationProgramming::Animation::BlendSpacePlayer::GetPhase() const
+{
+	return m_phase;
+}
+
+void AnimationProgramming::Animation::BlendSpacePlayer::SetPhase(float p_phase)
+{
+	m_phase = p_phase - std::floor(p_phase);
+	if (m_phase >= 1.0f)
+		m_phase = 0.0f;
+}
+
+void AnimationProgramming::Animation::BlendSpacePlayer::Update(float p_deltaTime)
+{
+	float phaseRate = 0.0f;
+
+	for (uint32_t i = 0; i < m_weights.count; ++i)
+	{
+		const AnimationInstance& animation = *m_blendSpace.GetSample(m_weights.samples[i]).animation;
+		const float cycleDuration = animation.GetDuration();
+
+		if (cycleDuration > 0.0f)
+			phaseRate += m_weights.weights[i] * animation.speedCoefficient / cycleDuration;
+	}
+
+	SetPhase(m_phase + p_deltaTime * phaseRate);
+}
+
+void AnimationProgramming::Animation::BlendSpacePlayer::Evaluate(std::vector<Data::Transformation>& p_pose)
+{
+	float accumulatedWeight = 0.0f;
+
+	for (uint32_t i = 0; i < m_weights.count; ++i)
+	{
+		const BlendSpace2D::Sample& sample = m_blendSpace.GetSample(m_weights.samples[i]);
+		const float weight = m_weights.weights[i];
+
+		if (accumulatedWeight <= 0.0f)
+		{
+			sample.animation->SamplePose(CalculateSampleTime(sample), p_pose);
+			accumulatedWeight = weight;
+			continue;
+		}
+
+		/* Every sample is blended over the blend of the previous ones, with its share of the weight accumulated so far */
+		sample.animation->SamplePose(CalculateSampleTime(sample), m_samplePose);
+
+		accumulatedWeight += weight;
+		const float alpha = weight / accumulatedWeight;
+		const size_t boneCount = std::min(p_pose.size(), m_samplePose.size());
+
+		for (size_t bone = 0; bone < boneCount; ++bone)
+		{
+			p_pose[bone].first = Tools::SIMD::Lerp(p_pose[bone].first, m_samplePose[bone].first, alpha);
+			p_pose[bone].second = Tools::SIMD::Slerp(p_pose[bone].second, m_samplePose[bone].second, alpha);
+		}
+	}
+}
+
+float AnimationProgramming::Animation::BlendSpacePlayer::CalculateSampleTime(const BlendSpace2D::Sample& p_sample) const
+{
+	return p_sample.markers ? p_sample.markers->GetTime(m_phase) : m_phase * p_sample.animation->GetDuration();
+}
+
+void AnimationProgramming::Animation::BlendSpacePlayer::SaveSnapshot(Tools::Snapshot& p_snapshot) const
+{
+	p_snapshot.Write(m_position.x);
+	p_snapshot.Write(m_position.y);
+	p_snapshot.Write(m_phase);
+}
+
+void AnimationProgramming::Animation::BlendSpacePlayer::RestoreSnapshot(Tools::Snapshot& p_snapshot)
+{
+	AltMath::Vector2f position;
+	p_snapshot.Read(position.x);
+	p_snapshot.Read(position.y);
+	p_snapshot.Read(m_phase);
+	SetPosition(position);
+}
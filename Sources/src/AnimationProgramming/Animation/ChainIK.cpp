@@ -0,0 +1,309 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "AnimationProgramming/Animation/ChainIK.h"
+#include "AnimationProgramming/Tools/Math.h"
+
+namespace
+{
+	constexpr float kPi = 3.14159265358979f;
+}
+
+AnimationProgramming::Animation::ChainIK::ChainIK(const Rig::SkeletonDefinition& p_definition) :
+	m_definition(p_definition),
+	m_parents(p_definition.GetParents()),
+	m_bindPose(p_definition.GetBindPose())
+{
+}
+
+uint32_t AnimationProgramming::Animation::ChainIK::AddChain(uint32_t p_root, uint32_t p_end, EMethod p_method, uint32_t p_maxIterations, float p_tolerance)
+{
+	const uint32_t boneCount = static_cast<uint32_t>(m_parents.size());
+
+	if (p_root >= boneCount || p_end >= boneCount || p_root == p_end)
+		return std::numeric_limits<uint32_t>::max();
+
+	/* Up from the end to the root */
+	std::vector<uint32_t> bones;
+	int32_t bone = static_cast<int32_t>(p_end);
+
+	while (bone != -1 && bone != static_cast<int32_t>(p_root))
+	{
+		bones.push_back(static_cast<uint32_t>(bone));
+		bone = m_parents[bone];
+	}
+
+	if (bone == -1)
+		return std::numeric_limits<uint32_t>::max();
+
+	bones.push_back(p_root);
+
+	Chain chain;
+	chain.method = p_method;
+	chain.firstJoint = static_cast<uint32_t>(m_bones.size());
+	chain.jointCount = static_cast<uint32_t>(bones.size());
+	chain.maxIterations = p_maxIterations;
+	chain.tolerance = p_tolerance;
+	chain.target = AltMath::Vector3f(0.0f, 0.0f, 0.0f);
+	chain.weight = 1.0f;
+	chain.hasTarget = false;
+	chain.warmStart = false;
+	chain.hasPreviousSolution = false;
+	chain.lastIterationCount = 0;
+	chain.lastError = 0.0f;
+
+	m_bones.insert(m_bones.end(), bones.rbegin(), bones.rend());
+	m_limitCosines.resize(m_bones.size(), -1.0f);
+	m_limitSines.resize(m_bones.size(), 0.0f);
+	m_lengths.resize(m_bones.size(), 0.0f);
+	m_positions.resize(m_bones.size(), AltMath::Vector3f(0.0f, 0.0f, 0.0f));
+	m_previousPositions.resize(m_bones.size(), AltMath::Vector3f(0.0f, 0.0f, 0.0f));
+	m_chains.push_back(chain);
+
+	return static_cast<uint32_t>(m_chains.size() - 1);
+}
+
+uint32_t AnimationProgramming::Animation::ChainIK::GetChainCount() const
+{
+	return static_cast<uint32_t>(m_chains.size());
+}
+
+const AnimationProgramming::Animation::ChainIK::Chain& AnimationProgramming::Animation::ChainIK::GetChain(uint32_t p_chain) const
+{
+	return m_chains[p_chain];
+}
+
+uint32_t AnimationProgramming::Animation::ChainIK::GetChainBone(uint32_t p_chain, uint32_t p_joint) const
+{
+	return m_bones[m_chains[p_chain].firstJoint + p_joint];
+}
+
+void AnimationProgramming::Animation::ChainIK::SetWarmStart(uint32_t p_chain, bool p_warmStart)
+{
+	m_chains[p_chain].warmStart = p_warmStart;
+}
+
+void AnimationProgramming::Animation::ChainIK::SetJointLimit(uint32_t p_chain, uint32_t p_joint, float p_maxAngle)
+{
+	const float maxAngle = std::clamp(p_maxAngle, 0.0f, kPi);
+	const uint32_t joint = m_chains[p_chain].firstJoint + p_joint;
+
+	m_limitCosines[joint] = std::cos(maxAngle);
+	m_limitSines[joint] = std::sin(maxAngle);
+}
+
+void AnimationProgramming::Animation::ChainIK::SetTarget(uint32_t p_chain, const AltMath::Vector3f& p_target, float p_weight)
+{
+	m_chains[p_chain].target = p_target;
+	m_chains[p_chain].weight = p_weight;
+	m_chains[p_chain].hasTarget = true;
+}
+
+void AnimationProgramming::Animation::ChainIK::ClearTarget(uint32_t p_chain)
+{
+	m_chains[p_chain].weight = 1.0f;
+	m_chains[p_chain].hasTarget = false;
+	m_chains[p_chain].hasPreviousSolution = false;
+}
+
+void AnimationProgramming::Animation::ChainIK::Solve(std::vector<Data::Transformation>& p_pose)
+{
+	for (Chain& chain : m_chains)
+	{
+		if (!chain.hasTarget)
+			continue;
+
+		const uint32_t first = chain.firstJoint;
+		const uint32_t last = first + chain.jointCount - 1;
+
+		/* Joint positions of the sampled pose : only the root walks up the hierarchy */
+		Data::Transformation joint = m_definition.CalculateModelTransformation(m_bones[first], p_pose);
+		float reach = 0.0f;
+
+		m_positions[first] = joint.first;
+
+		for (uint32_t i = first + 1; i <= last; ++i)
+		{
+			const uint32_t bone = m_bones[i];
+
+			m_positions[i] = joint.first + joint.second * (m_bindPose[bone].first + p_pose[bone].first);
+			m_lengths[i - 1] = (m_positions[i] - m_positions[i - 1]).Length();
+			reach += m_lengths[i - 1];
+
+			joint.first = m_positions[i];
+			joint.second = joint.second * (m_bindPose[bone].second * p_pose[bone].second);
+		}
+
+		/* A weight below 1 brings the target back toward the sampled end */
+		const AltMath::Vector3f target = m_positions[last] + (chain.target - m_positions[last]) * chain.weight;
+
+		chain.lastIterationCount = 0;
+		chain.lastError = (target - m_positions[last]).Length();
+
+		/* The sampled pose already reaches the target */
+		if (chain.lastError <= chain.tolerance)
+			continue;
+
+		/* The directions of the previous solution, with the bone lengths of this pose */
+		if (chain.warmStart && chain.hasPreviousSolution)
+		{
+			AltMath::Vector3f sampledParent = m_positions[first];
+
+			for (uint32_t i = first + 1; i <= last; ++i)
+			{
+				const AltMath::Vector3f sampled = m_positions[i];
+				const AltMath::Vector3f direction = Tools::Math::Normalize(m_previousPositions[i] - m_previousPositions[i - 1], Tools::Math::Normalize(sampled - sampledParent, AltMath::Vector3f(0.0f, 1.0f, 0.0f)));
+
+				m_positions[i] = m_positions[i - 1] + direction * m_lengths[i - 1];
+				sampledParent = sampled;
+			}
+		}
+
+		const AltMath::Vector3f rootToTarget = target - m_positions[first];
+
+		if (rootToTarget.LengthSquare() >= reach * reach)
+		{
+			/* Out of reach : the chain is stretched toward the target, no iteration is needed */
+			const AltMath::Vector3f direction = Tools::Math::Normalize(rootToTarget, AltMath::Vector3f(0.0f, 1.0f, 0.0f));
+
+			for (uint32_t i = first + 1; i <= last; ++i)
+				m_positions[i] = m_positions[i - 1] + direction * m_lengths[i - 1];
+		}
+		else
+		{
+			chain.lastIterationCount = chain.method == EMethod::FABRIK ? SolveFABRIK(chain, target) : SolveCCD(chain, target);
+		}
+
+		chain.lastError = (target - m_positions[last]).Length();
+		chain.hasPreviousSolution = true;
+
+		for (uint32_t i = first; i <= last; ++i)
+			m_previousPositions[i] = m_positions[i] - m_positions[first];
+
+		m_definition.ApplyChainPositions(&m_bones[first], &m_positions[first], chain.jointCount, p_pose);
+	}
+}
+
+uint32_t AnimationProgramming::Animation::ChainIK::SolveFABRIK(Chain& p_chain, const AltMath::Vector3f& p_target)
+{
+	const uint32_t first = p_chain.firstJoint;
+	const uint32_t last = first + p_chain.jointCount - 1;
+	const AltMath::Vector3f root = m_positions[first];
+	const float tolerance2 = p_chain.tolerance * p_chain.tolerance;
+
+	uint32_t iteration = 0;
+
+	for (; iteration < p_chain.maxIterations && (p_target - m_positions[last]).LengthSquare() > tolerance2; ++iteration)
+	{
+		/* Backward : the end is put on the target, then each joint is pulled to the length of its bone */
+		m_positions[last] = p_target;
+
+		for (uint32_t i = last; i-- > first;)
+		{
+			const AltMath::Vector3f direction = Tools::Math::Normalize(m_positions[i] - m_positions[i + 1], AltMath::Vector3f(0.0f, 1.0f, 0.0f));
+			m_positions[i] = m_positions[i + 1] + direction * m_lengths[i];
+		}
+
+		/* Forward : the root is put back, then each joint is pushed to the length of its bone, within the limits of its parent joint */
+		m_positions[first] = root;
+
+		for (uint32_t i = first + 1; i <= last; ++i)
+		{
+			AltMath::Vector3f direction = Tools::Math::Normalize(m_positions[i] - m_positions[i - 1], AltMath::Vector3f(0.0f, 1.0f, 0.0f));
+
+			if (i - 1 > first)
+				direction = LimitDirection(i - 1, direction);
+
+			m_positions[i] = m_positions[i - 1] + direction * m_lengths[i - 1];
+		}
+	}
+
+	return iteration;
+}
+
+uint32_t AnimationProgramming::Animation::ChainIK::SolveCCD(Chain& p_chain, const AltMath::Vector3f& p_target)
+{
+	const uint32_t first = p_chain.firstJoint;
+	const uint32_t last = first + p_chain.jointCount - 1;
+	const float tolerance2 = p_chain.tolerance * p_chain.tolerance;
+
+	uint32_t iteration = 0;
+
+	for (; iteration < p_chain.maxIterations && (p_target - m_positions[last]).LengthSquare() > tolerance2; ++iteration)
+	{
+		/* From the last joint to the root, each joint turns the rest of the chain toward the target */
+		for (uint32_t joint = last; joint-- > first;)
+		{
+			const AltMath::Vector3f pivot = m_positions[joint];
+			const AltMath::Vector3f toEnd = m_positions[last] - pivot;
+			const AltMath::Vector3f toTarget = p_target - pivot;
+
+			if (toEnd.LengthSquare() <= Tools::Math::MinimumLength2 || toTarget.LengthSquare() <= Tools::Math::MinimumLength2)
+				continue;
+
+			AltMath::Quaternion rotation = Tools::Math::CalculateRotationBetween(toEnd / toEnd.Length(), toTarget / toTarget.Length());
+
+			/* The bone leaving the joint is brought back within its limits */
+			if (joint > first)
+			{
+				const AltMath::Vector3f turned = Tools::Math::Normalize(rotation * (m_positions[joint + 1] - pivot), AltMath::Vector3f(0.0f, 1.0f, 0.0f));
+				rotation = Tools::Math::CalculateRotationBetween(turned, LimitDirection(joint, turned)) * rotation;
+			}
+
+			for (uint32_t i = joint + 1; i <= last; ++i)
+				m_positions[i] = pivot + rotation * (m_positions[i] - pivot);
+		}
+	}
+
+	return iteration;
+}
+
+AltMath::Vector3f AnimationProgramming::Animation::ChainIK::LimitDirection(uint32_t p_joint, const AltMath::Vector3f& p_direction) const
+{
+	const AltMath::Vector3f parentDirection = Tools::Math::Normalize(m_positions[p_joint] - m_positions[p_joint - 1], p_direction);
+	const float cosine = AltMath::Vector3f::DotProduct(parentDirection, p_direction);
+
+	if (cosine >= m_limitCosines[p_joint])
+		return p_direction;
+
+	/* Onto the cone of the limit, on the side of the given direction */
+	const AltMath::Vector3f side = Tools::Math::Normalize(p_direction - parentDirection * cosine, Tools::Math::CalculateOrthogonal(parentDirection));
+	return parentDirection * m_limitCosines[p_joint] + side * m_limitSines[p_joint];
+}
+
+void AnimationProgramming::Animation::ChainIK::SaveSnapshot(Tools::Snapshot& p_snapshot) const
+{
+	for (const Chain& chain : m_chains)
+	{
+		p_snapshot.Write(chain.target);
+		p_snapshot.Write(chain.weight);
+		p_snapshot.Write(chain.hasTarget);
+		p_snapshot.Write(chain.hasPreviousSolution);
+		p_snapshot.Write(chain.lastIterationCount);
+		p_snapshot.Write(chain.lastError);
+	}
+
+	p_snapshot.WriteArray(m_previousPositions);
+}
+
+void AnimationProgramming::Animation::ChainIK::RestoreSnapshot(Tools::Snapshot& p_snapshot)
+{
+	for (Chain& chain : m_chains)
+	{
+		p_snapshot.Read(chain.target);
+		p_snapshot.Read(chain.weight);
+		p_snapshot.Read(chain.hasTarget);
+		p_snapshot.Read(chain.hasPreviousSolution);
+		p_snapshot.Read(chain.lastIterationCount);
+		p_snapshot.Read(chain.lastError);
+	}
+
+	p_snapshot.ReadArray(m_previousPositions);
+}
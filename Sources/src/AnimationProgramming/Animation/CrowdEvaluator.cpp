@@ -0,0 +1,458 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <immintrin.h>
+#include <tuple>
+
+#include "AnimationProgramming/Animation/CrowdEvaluator.h"
+#include "AnimationProgramming/Tools/SIMD.h"
+#include "AnimationProgramming/Tools/SIMDTarget.h"
+
+namespace
+{
+	constexpr uint32_t kLaneWidth = AnimationProgramming::Animation::CrowdEvaluator::LaneWidth;
+
+	/* Number of groups evaluated by a thread pool task */
+	constexpr uint32_t kGroupsPerChunk = 2;
+
+	/**
+	* The keys of one bone for every lane of a group (Component c of the lane l is at [c * kLaneWidth + l])
+	*/
+	struct alignas(32) KeyLanes
+	{
+		float startPosition[3 * kLaneWidth];
+		float endPosition[3 * kLaneWidth];
+		float startRotation[4 * kLaneWidth];
+		float endRotation[4 * kLaneWidth];
+		float alpha[kLaneWidth];
+	};
+
+	/**
+	* Slerp without trigonometric functions, so that every lane can take its own path (D. Eberly, "A Fast and Accurate Algorithm for Computing SLERP").
+	* The last coefficients are scaled to minimize the error, which stays below 1e-6 for unit quaternions
+	*/
+	constexpr float kSlerpOnePlusMu = 1.90110745351730037f;
+
+	constexpr float kSlerpU[8] =
+	{
+		1.0f / (1.0f * 3.0f), 1.0f / (2.0f * 5.0f), 1.0f / (3.0f * 7.0f), 1.0f / (4.0f * 9.0f),
+		1.0f / (5.0f * 11.0f), 1.0f / (6.0f * 13.0f), 1.0f / (7.0f * 15.0f), kSlerpOnePlusMu / (8.0f * 17.0f)
+	};
+
+	constexpr float kSlerpV[8] =
+	{
+		1.0f / 3.0f, 2.0f / 5.0f, 3.0f / 7.0f, 4.0f / 9.0f,
+		5.0f / 11.0f, 6.0f / 13.0f, 7.0f / 15.0f, kSlerpOnePlusMu * 8.0f / 17.0f
+	};
+
+	/**
+	* Calculate the world matrix (And the palette matrix) of one bone for every lane of a group, one lane after the other
+	*/
+	void EvaluateBoneScalar(const KeyLanes& p_keys, const float* p_defaultPosition, const float* p_defaultRotation, const float* p_parentWorld, float* p_world, const AnimationProgramming::Data::Matrix3x4* p_inverseBind, float* p_palette)
+	{
+		for (uint32_t lane = 0; lane < kLaneWidth; ++lane)
+		{
+			auto key = [lane](const float* p_components, uint32_t p_component) { return p_components[p_component * kLaneWidth + lane]; };
+
+			const float t = p_keys.alpha[lane];
+
+			/* Position : lerp, then relative to the bind pose */
+			float position[3];
+			for (uint32_t c = 0; c < 3; ++c)
+				position[c] = p_defaultPosition[c] + key(p_keys.startPosition, c) + (key(p_keys.endPosition, c) - key(p_keys.startPosition, c)) * t;
+
+			/* Rotation : slerp on the shortest path */
+			float dot = 0.0f;
+			for (uint32_t c = 0; c < 4; ++c)
+				dot += key(p_keys.startRotation, c) * key(p_keys.endRotation, c);
+
+			const float sign = dot < 0.0f ? -1.0f : 1.0f;
+			const float xm1 = dot * sign - 1.0f;
+			const float d = 1.0f - t;
+
+			float weightT = 1.0f, weightD = 1.0f;
+			for (int32_t i = 7; i >= 0; --i)
+			{
+				weightT = 1.0f + (kSlerpU[i] * t * t - kSlerpV[i]) * xm1 * weightT;
+				weightD = 1.0f + (kSlerpU[i] * d * d - kSlerpV[i]) * xm1 * weightD;
+			}
+
+			weightT *= t * sign;
+			weightD *= d;
+
+			float r[4];
+			for (uint32_t c = 0; c < 4; ++c)
+				r[c] = key(p_keys.startRotation, c) * weightD + key(p_keys.endRotation, c) * weightT;
+
+			/* Relative to the bind pose : defaultRotation * rotation */
+			const float* q = p_defaultRotation;
+			const float x = q[3] * r[0] + q[0] * r[3] + q[1] * r[2] - q[2] * r[1];
+			const float y = q[3] * r[1] - q[0] * r[2] + q[1] * r[3] + q[2] * r[0];
+			const float z = q[3] * r[2] + q[0] * r[1] - q[1] * r[0] + q[2] * r[3];
+			const float w = q[3] * r[3] - q[0] * r[0] - q[1] * r[1] - q[2] * r[2];
+
+			/* Same conversion as the Matrix3x4 constructor */
+			const float lengthSquare = x * x + y * y + z * z + w * w;
+			const float s = lengthSquare > 0.0f ? 2.0f / lengthSquare : 0.0f;
+
+			const float xx = x * x * s, yy = y * y * s, zz = z * z * s;
+			const float xy = x * y * s, xz = x * z * s, yz = y * z * s;
+			const float xw = x * w * s, yw = y * w * s, zw = z * w * s;
+
+			const float local[12] =
+			{
+				1.0f - yy - zz,	xy - zw,		xz + yw,		position[0],
+				xy + zw,		1.0f - xx - zz,	yz - xw,		position[1],
+				xz - yw,		yz + xw,		1.0f - xx - yy,	position[2]
+			};
+
+			float world[12];
+
+			if (p_parentWorld)
+			{
+				for (uint32_t row = 0; row < 3; ++row)
+				{
+					for (uint32_t column = 0; column < 4; ++column)
+					{
+						float value = column == 3 ? key(p_parentWorld, row * 4 + 3) : 0.0f;
+						for (uint32_t k = 0; k < 3; ++k)
+							value += key(p_parentWorld, row * 4 + k) * local[k * 4 + column];
+						world[row * 4 + column] = value;
+					}
+				}
+			}
+			else
+			{
+				std::copy(local, local + 12, world);
+			}
+
+			for (uint32_t i = 0; i < 12; ++i)
+				p_world[i * kLaneWidth + lane] = world[i];
+
+			/* BoneCurrentWorldMatrix * Inverse(BoneTPoseWorldMatrix) */
+			if (p_inverseBind)
+			{
+				const float* inverseBind = p_inverseBind->elements;
+
+				for (uint32_t row = 0; row < 3; ++row)
+				{
+					for (uint32_t column = 0; column < 4; ++column)
+					{
+						float value = column == 3 ? world[row * 4 + 3] : 0.0f;
+						for (uint32_t k = 0; k < 3; ++k)
+							value += world[row * 4 + k] * inverseBind[k * 4 + column];
+						p_palette[(row * 4 + column) * kLaneWidth + lane] = value;
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	* Same as EvaluateBoneScalar, every lane at once
+	*/
+	SIMD_TARGET_AVX2 void EvaluateBoneAVX2(const KeyLanes& p_keys, const float* p_defaultPosition, const float* p_defaultRotation, const float* p_parentWorld, float* p_world, const AnimationProgramming::Data::Matrix3x4* p_inverseBind, float* p_palette)
+	{
+		const __m256 one = _mm256_set1_ps(1.0f);
+		const __m256 t = _mm256_load_ps(p_keys.alpha);
+
+		/* Position : lerp, then relative to the bind pose */
+		__m256 position[3];
+		for (uint32_t c = 0; c < 3; ++c)
+		{
+			const __m256 start = _mm256_load_ps(p_keys.startPosition + c * kLaneWidth);
+			const __m256 end = _mm256_load_ps(p_keys.endPosition + c * kLaneWidth);
+			position[c] = _mm256_add_ps(_mm256_set1_ps(p_defaultPosition[c]), _mm256_fmadd_ps(_mm256_sub_ps(end, start), t, start));
+		}
+
+		/* Rotation : slerp on the shortest path */
+		__m256 start[4], end[4];
+		__m256 dot = _mm256_setzero_ps();
+		for (uint32_t c = 0; c < 4; ++c)
+		{
+			start[c] = _mm256_load_ps(p_keys.startRotation + c * kLaneWidth);
+			end[c] = _mm256_load_ps(p_keys.endRotation + c * kLaneWidth);
+			dot = _mm256_fmadd_ps(start[c], end[c], dot);
+		}
+
+		const __m256 signBit = _mm256_and_ps(dot, _mm256_set1_ps(-0.0f));
+		const __m256 xm1 = _mm256_sub_ps(_mm256_xor_ps(dot, signBit), one);
+		const __m256 d = _mm256_sub_ps(one, t);
+		const __m256 squareT = _mm256_mul_ps(t, t);
+		const __m256 squareD = _mm256_mul_ps(d, d);
+
+		__m256 weightT = one, weightD = one;
+		for (int32_t i = 7; i >= 0; --i)
+		{
+			const __m256 u = _mm256_set1_ps(kSlerpU[i]);
+			const __m256 v = _mm256_set1_ps(kSlerpV[i]);
+			weightT = _mm256_fmadd_ps(_mm256_mul_ps(_mm256_fmsub_ps(u, squareT, v), xm1), weightT, one);
+			weightD = _mm256_fmadd_ps(_mm256_mul_ps(_mm256_fmsub_ps(u, squareD, v), xm1), weightD, one);
+		}
+
+		weightT = _mm256_xor_ps(_mm256_mul_ps(weightT, t), signBit);
+		weightD = _mm256_mul_ps(weightD, d);
+
+		__m256 r[4];
+		for (uint32_t c = 0; c < 4; ++c)
+			r[c] = _mm256_fmadd_ps(start[c], weightD, _mm256_mul_ps(end[c], weightT));
+
+		/* Relative to the bind pose : defaultRotation * rotation */
+		const __m256 qx = _mm256_set1_ps(p_defaultRotation[0]);
+		const __m256 qy = _mm256_set1_ps(p_defaultRotation[1]);
+		const __m256 qz = _mm256_set1_ps(p_defaultRotation[2]);
+		const __m256 qw = _mm256_set1_ps(p_defaultRotation[3]);
+
+		const __m256 x = _mm256_sub_ps(_mm256_fmadd_ps(qw, r[0], _mm256_fmadd_ps(qx, r[3], _mm256_mul_ps(qy, r[2]))), _mm256_mul_ps(qz, r[1]));
+		const __m256 y = _mm256_add_ps(_mm256_fmsub_ps(qw, r[1], _mm256_mul_ps(qx, r[2])), _mm256_fmadd_ps(qy, r[3], _mm256_mul_ps(qz, r[0])));
+		const __m256 z = _mm256_add_ps(_mm256_fmsub_ps(qw, r[2], _mm256_mul_ps(qy, r[0])), _mm256_fmadd_ps(qx, r[1], _mm256_mul_ps(qz, r[3])));
+		const __m256 w = _mm256_sub_ps(_mm256_mul_ps(qw, r[3]), _mm256_fmadd_ps(qx, r[0], _mm256_fmadd_ps(qy, r[1], _mm256_mul_ps(qz, r[2]))));
+
+		/* Same conversion as the Matrix3x4 constructor */
+		const __m256 lengthSquare = _mm256_fmadd_ps(x, x, _mm256_fmadd_ps(y, y, _mm256_fmadd_ps(z, z, _mm256_mul_ps(w, w))));
+		const __m256 s = _mm256_and_ps(_mm256_div_ps(_mm256_set1_ps(2.0f), lengthSquare), _mm256_cmp_ps(lengthSquare, _mm256_setzero_ps(), _CMP_GT_OQ));
+
+		const __m256 xs = _mm256_mul_ps(x, s), ys = _mm256_mul_ps(y, s), zs = _mm256_mul_ps(z, s);
+		const __m256 xx = _mm256_mul_ps(x, xs), yy = _mm256_mul_ps(y, ys), zz = _mm256_mul_ps(z, zs);
+		const __m256 xy = _mm256_mul_ps(x, ys), xz = _mm256_mul_ps(x, zs), yz = _mm256_mul_ps(y, zs);
+		const __m256 xw = _mm256_mul_ps(w, xs), yw = _mm256_mul_ps(w, ys), zw = _mm256_mul_ps(w, zs);
+
+		const __m256 local[12] =
+		{
+			_mm256_sub_ps(one, _mm256_add_ps(yy, zz)),	_mm256_sub_ps(xy, zw),						_mm256_add_ps(xz, yw),						position[0],
+			_mm256_add_ps(xy, zw),						_mm256_sub_ps(one, _mm256_add_ps(xx, zz)),	_mm256_sub_ps(yz, xw),						position[1],
+			_mm256_sub_ps(xz, yw),						_mm256_add_ps(yz, xw),						_mm256_sub_ps(one, _mm256_add_ps(xx, yy)),	position[2]
+		};
+
+		__m256 world[12];
+
+		if (p_parentWorld)
+		{
+			for (uint32_t row = 0; row < 3; ++row)
+			{
+				const __m256 parent0 = _mm256_load_ps(p_parentWorld + (row * 4 + 0) * kLaneWidth);
+				const __m256 parent1 = _mm256_load_ps(p_parentWorld + (row * 4 + 1) * kLaneWidth);
+				const __m256 parent2 = _mm256_load_ps(p_parentWorld + (row * 4 + 2) * kLaneWidth);
+				const __m256 parent3 = _mm256_load_ps(p_parentWorld + (row * 4 + 3) * kLaneWidth);
+
+				for (uint32_t column = 0; column < 4; ++column)
+				{
+					__m256 value = _mm256_fmadd_ps(parent0, local[column], column == 3 ? parent3 : _mm256_setzero_ps());
+					value = _mm256_fmadd_ps(parent1, local[4 + column], value);
+					world[row * 4 + column] = _mm256_fmadd_ps(parent2, local[8 + column], value);
+				}
+			}
+		}
+		else
+		{
+			std::copy(local, local + 12, world);
+		}
+
+		for (uint32_t i = 0; i < 12; ++i)
+			_mm256_store_ps(p_world + i * kLaneWidth, world[i]);
+
+		/* BoneCurrentWorldMatrix * Inverse(BoneTPoseWorldMatrix) */
+		if (p_inverseBind)
+		{
+			const float* inverseBind = p_inverseBind->elements;
+
+			for (uint32_t row = 0; row < 3; ++row)
+			{
+				for (uint32_t column = 0; column < 4; ++column)
+				{
+					__m256 value = _mm256_fmadd_ps(world[row * 4 + 0], _mm256_set1_ps(inverseBind[column]), column == 3 ? world[row * 4 + 3] : _mm256_setzero_ps());
+					value = _mm256_fmadd_ps(world[row * 4 + 1], _mm256_set1_ps(inverseBind[4 + column]), value);
+					value = _mm256_fmadd_ps(world[row * 4 + 2], _mm256_set1_ps(inverseBind[8 + column]), value);
+					_mm256_store_ps(p_palette + (row * 4 + column) * kLaneWidth, value);
+				}
+			}
+		}
+	}
+}
+
+AnimationProgramming::Animation::CrowdEvaluator::CrowdEvaluator(const Rig::SkeletonDefinition& p_definition) :
+	m_parents(p_definition.GetParents()),
+	m_paletteIndices(p_definition.GetPaletteIndices()),
+	m_order(p_definition.GetEvaluationOrder()),
+	m_inverseBindPalette(p_definition.GetInverseBindPalette()),
+	m_paletteSize(p_definition.GetPaletteSize())
+{
+	const std::vector<Data::Transformation>& bindPose = p_definition.GetBindPose();
+
+	m_defaultPositions.resize(bindPose.size() * 3);
+	m_defaultRotations.resize(bindPose.size() * 4);
+
+	for (uint32_t bone = 0; bone < bindPose.size(); ++bone)
+	{
+		const auto&[position, rotation] = bindPose[bone];
+
+		m_defaultPositions[bone * 3 + 0] = position.x;
+		m_defaultPositions[bone * 3 + 1] = position.y;
+		m_defaultPositions[bone * 3 + 2] = position.z;
+		m_defaultRotations[bone * 4 + 0] = rotation.GetXAxisValue();
+		m_defaultRotations[bone * 4 + 1] = rotation.GetYAxisValue();
+		m_defaultRotations[bone * 4 + 2] = rotation.GetZAxisValue();
+		m_defaultRotations[bone * 4 + 3] = rotation.GetRealValue();
+	}
+}
+
+uint32_t AnimationProgramming::Animation::CrowdEvaluator::AddCharacter(const AnimationInstance& p_animation, float p_time)
+{
+	m_characters.push_back({ &p_animation, p_time });
+
+	/* A new group is needed every LaneWidth characters */
+	const size_t groupCount = (m_characters.size() + LaneWidth - 1) / LaneWidth;
+	m_palettes.resize(groupCount * m_paletteSize);
+
+	return static_cast<uint32_t>(m_characters.size() - 1);
+}
+
+void AnimationProgramming::Animation::CrowdEvaluator::SetAnimation(uint32_t p_character, const AnimationInstance& p_animation, float p_time)
+{
+	m_characters[p_character] = { &p_animation, p_time };
+}
+
+float AnimationProgramming::Animation::CrowdEvaluator::GetTime(uint32_t p_character) const
+{
+	return m_characters[p_character].time;
+}
+
+void AnimationProgramming::Animation::CrowdEvaluator::SetTime(uint32_t p_character, float p_time)
+{
+	m_characters[p_character].time = p_time;
+}
+
+uint32_t AnimationProgramming::Animation::CrowdEvaluator::GetCharacterCount() const
+{
+	return static_cast<uint32_t>(m_characters.size());
+}
+
+uint32_t AnimationProgramming::Animation::CrowdEvaluator::GetPaletteSize() const
+{
+	return m_paletteSize;
+}
+
+void AnimationProgramming::Animation::CrowdEvaluator::Update(float p_deltaTime, Tools::ThreadPool* p_threadPool)
+{
+	for (CharacterState& character : m_characters)
+	{
+		character.time += p_deltaTime * character.animation->speedCoefficient;
+
+		/* Keep the time small, to keep its precision */
+		if (character.animation->loop)
+			character.time = std::fmod(character.time, character.animation->GetDuration());
+		else
+			character.time = std::min(character.time, character.animation->GetDuration());
+	}
+
+	Evaluate(p_threadPool);
+}
+
+void AnimationProgramming::Animation::CrowdEvaluator::Evaluate(Tools::ThreadPool* p_threadPool)
+{
+	const uint32_t groupCount = static_cast<uint32_t>((m_characters.size() + LaneWidth - 1) / LaneWidth);
+
+	auto evaluateGroups = [this](uint32_t p_begin, uint32_t p_end)
+	{
+		std::vector<MatrixLanes> worldMatrices(m_parents.size());
+
+		for (uint32_t group = p_begin; group < p_end; ++group)
+			EvaluateGroup(group, worldMatrices);
+	};
+
+	if (p_threadPool)
+		p_threadPool->ParallelFor(groupCount, kGroupsPerChunk, evaluateGroups);
+	else
+		evaluateGroups(0, groupCount);
+}
+
+void AnimationProgramming::Animation::CrowdEvaluator::ReadPalette(uint32_t p_character, std::vector<Data::Matrix3x4>& p_palette) const
+{
+	const MatrixLanes* groupPalette = m_palettes.data() + (p_character / LaneWidth) * m_paletteSize;
+	const uint32_t lane = p_character % LaneWidth;
+
+	p_palette.resize(m_paletteSize);
+
+	for (uint32_t i = 0; i < m_paletteSize; ++i)
+	{
+		for (uint32_t element = 0; element < 12; ++element)
+			p_palette[i].elements[element] = groupPalette[i].elements[element * LaneWidth + lane];
+	}
+}
+
+void AnimationProgramming::Animation::CrowdEvaluator::EvaluateGroup(uint32_t p_group, std::vector<MatrixLanes>& p_worldMatrices)
+{
+	const uint32_t firstCharacter = p_group * LaneWidth;
+	const uint32_t laneCount = std::min(LaneWidth, static_cast<uint32_t>(m_characters.size()) - firstCharacter);
+
+	/* Every lane has its own animation and time, so the keys are found lane by lane */
+	const AnimationInfo* animations[LaneWidth];
+	uint32_t currentKeys[LaneWidth];
+	uint32_t nextKeys[LaneWidth];
+
+	KeyLanes keys;
+
+	for (uint32_t lane = 0; lane < LaneWidth; ++lane)
+	{
+		if (lane < laneCount)
+		{
+			const CharacterState& character = m_characters[firstCharacter + lane];
+			animations[lane] = &character.animation->attachedAnimation;
+			character.animation->SampleKeyFrames(character.time, currentKeys[lane], nextKeys[lane], keys.alpha[lane]);
+		}
+		else
+		{
+			animations[lane] = nullptr;
+			keys.alpha[lane] = 0.0f;
+		}
+	}
+
+	const bool useAVX2 = Tools::SIMD::GetLevel() == Tools::ESIMDLevel::AVX2;
+	MatrixLanes* groupPalette = m_palettes.data() + p_group * m_paletteSize;
+
+	for (uint32_t bone : m_order)
+	{
+		/* Gather the keys of this bone (Unused lanes get the identity) */
+		for (uint32_t lane = 0; lane < LaneWidth; ++lane)
+		{
+			AltMath::Vector3f startPosition, endPosition;
+			AltMath::Quaternion startRotation(0.0f, 0.0f, 0.0f, 1.0f), endRotation(0.0f, 0.0f, 0.0f, 1.0f);
+
+			if (animations[lane])
+			{
+				std::tie(startPosition, startRotation) = animations[lane]->GetBoneTransformations(bone, currentKeys[lane]);
+				std::tie(endPosition, endRotation) = animations[lane]->GetBoneTransformations(bone, nextKeys[lane]);
+			}
+
+			keys.startPosition[0 * LaneWidth + lane] = startPosition.x;
+			keys.startPosition[1 * LaneWidth + lane] = startPosition.y;
+			keys.startPosition[2 * LaneWidth + lane] = startPosition.z;
+			keys.endPosition[0 * LaneWidth + lane] = endPosition.x;
+			keys.endPosition[1 * LaneWidth + lane] = endPosition.y;
+			keys.endPosition[2 * LaneWidth + lane] = endPosition.z;
+			keys.startRotation[0 * LaneWidth + lane] = startRotation.GetXAxisValue();
+			keys.startRotation[1 * LaneWidth + lane] = startRotation.GetYAxisValue();
+			keys.startRotation[2 * LaneWidth + lane] = startRotation.GetZAxisValue();
+			keys.startRotation[3 * LaneWidth + lane] = startRotation.GetRealValue();
+			keys.endRotation[0 * LaneWidth + lane] = endRotation.GetXAxisValue();
+			keys.endRotation[1 * LaneWidth + lane] = endRotation.GetYAxisValue();
+			keys.endRotation[2 * LaneWidth + lane] = endRotation.GetZAxisValue();
+			keys.endRotation[3 * LaneWidth + lane] = endRotation.GetRealValue();
+		}
+
+		const float* parentWorld = m_parents[bone] >= 0 ? p_worldMatrices[m_parents[bone]].elements : nullptr;
+		const int32_t paletteIndex = m_paletteIndices[bone];
+		const Data::Matrix3x4* inverseBind = paletteIndex >= 0 ? &m_inverseBindPalette[paletteIndex] : nullptr;
+		float* palette = paletteIndex >= 0 ? groupPalette[paletteIndex].elements : nullptr;
+
+		if (useAVX2)
+			EvaluateBoneAVX2(keys, &m_defaultPositions[bone * 3], &m_defaultRotations[bone * 4], parentWorld, p_worldMatrices[bone].elements, inverseBind, palette);
+		else
+			EvaluateBoneScalar(keys, &m_defaultPositions[bone * 3], &m_defaultRotations[bone * 4], parentWorld, p_worldMatrices[bone].elements, inverseBind, palette);
+	}
+}
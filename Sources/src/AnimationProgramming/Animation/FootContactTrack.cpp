@@ -0,0 +1,76 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+
+#include "AnimationProgramming/Animation/FootContactTrack.h"
+
+AnimationProgramming::Animation::FootContactTrack::FootContactTrack(Rig::Skeleton& p_skeleton, const AnimationInfo& p_animation, uint32_t p_leftFootBone, uint32_t p_rightFootBone, float p_heightTolerance) :
+	m_animation(p_animation),
+	m_keyCount(p_animation.GetEndKey() + 1)
+{
+	const uint32_t feet[FootCount] = { p_leftFootBone, p_rightFootBone };
+
+	/* Heights of the feet at every key */
+	std::vector<float> heights(FootCount * m_keyCount);
+	std::vector<Data::Transformation> pose(p_animation.GetBonesCount());
+
+	for (uint32_t key = 0; key < m_keyCount; ++key)
+	{
+		for (uint32_t bone = 0; bone < p_animation.GetBonesCount(); ++bone)
+			pose[bone] = p_animation.GetBoneTransformations(bone, key);
+
+		for (uint32_t foot = 0; foot < FootCount; ++foot)
+			heights[foot * m_keyCount + key] = p_skeleton.CalculateWorldMatrix(feet[foot], pose).elements[11];
+	}
+
+	/* The key 0 can hold the bind pose : only the played keys set the lowest height */
+	const uint32_t startKey = std::min(p_animation.GetStartKey(), p_animation.GetEndKey());
+	m_contacts.resize(FootCount * m_keyCount);
+
+	for (uint32_t foot = 0; foot < FootCount; ++foot)
+	{
+		const auto first = heights.begin() + foot * m_keyCount;
+		m_contactHeights[foot] = *std::min_element(first + startKey, first + m_keyCount);
+
+		for (uint32_t key = 0; key < m_keyCount; ++key)
+			m_contacts[foot * m_keyCount + key] = heights[foot * m_keyCount + key] <= m_contactHeights[foot] + p_heightTolerance ? 1.0f : 0.0f;
+	}
+}
+
+const AnimationProgramming::Animation::AnimationInfo& AnimationProgramming::Animation::FootContactTrack::GetAnimation() const
+{
+	return m_animation;
+}
+
+float AnimationProgramming::Animation::FootContactTrack::GetContactHeight(uint32_t p_foot) const
+{
+	return m_contactHeights[p_foot];
+}
+
+bool AnimationProgramming::Animation::FootContactTrack::IsInContact(uint32_t p_foot, uint32_t p_key) const
+{
+	return m_contacts[p_foot * m_keyCount + std::min(p_key, m_keyCount - 1)] > 0.5f;
+}
+
+float AnimationProgramming::Animation::FootContactTrack::GetContactWeight(uint32_t p_foot, uint32_t p_currentKey, uint32_t p_nextKey, float p_alpha) const
+{
+	/* During a transition, the keys can belong to the previous animation */
+	const float current = m_contacts[p_foot * m_keyCount + std::min(p_currentKey, m_keyCount - 1)];
+	const float next = m_contacts[p_foot * m_keyCount + std::min(p_nextKey, m_keyCount - 1)];
+
+	return current + (next - current) * p_alpha;
+}
+
+float AnimationProgramming::Animation::FootContactTrack::GetContactWeight(uint32_t p_foot, const AnimationInstance& p_instance, float p_time) const
+{
+	uint32_t currentKey;
+	uint32_t nextKey;
+	float alpha;
+
+	p_instance.SampleKeyFrames(p_time, currentKey, nextKey, alpha);
+	return GetContactWeight(p_foot, currentKey, nextKey, alpha);
+}
@@ -0,0 +1,171 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+
+#include "AnimationProgramming/Animation/FootPlanting.h"
+
+AnimationProgramming::Animation::FootPlanting::FootPlanting(const Rig::SkeletonDefinition& p_definition, uint32_t p_pelvisBone, uint32_t p_leftFootBone, uint32_t p_rightFootBone) :
+	m_definition(p_definition),
+	m_parents(p_definition.GetParents()),
+	m_pelvis(p_pelvisBone),
+	m_feet{ p_leftFootBone, p_rightFootBone },
+	m_limbIK(p_definition),
+	m_rootPosition(0.0f, 0.0f, 0.0f),
+	m_contactWeights{ 1.0f, 1.0f },
+	m_contactHeights{ 0.0f, 0.0f }
+{
+	/* The calf and the thigh are the parent and the grand-parent of the foot */
+	const uint32_t boneCount = static_cast<uint32_t>(m_parents.size());
+
+	for (uint32_t foot : m_feet)
+	{
+		const int32_t calf = foot < boneCount ? m_parents[foot] : -1;
+		const int32_t thigh = calf != -1 ? m_parents[calf] : -1;
+
+		if (thigh != -1)
+			m_limbIK.AddLimb(static_cast<uint32_t>(thigh), static_cast<uint32_t>(calf), foot);
+	}
+}
+
+bool AnimationProgramming::Animation::FootPlanting::IsValid() const
+{
+	return m_pelvis < m_parents.size() && m_limbIK.GetLimbCount() == FootContactTrack::FootCount;
+}
+
+void AnimationProgramming::Animation::FootPlanting::AddContactTrack(const FootContactTrack& p_track)
+{
+	m_contactTracks.push_back(&p_track);
+}
+
+void AnimationProgramming::Animation::FootPlanting::SetRootPosition(const AltMath::Vector3f& p_position)
+{
+	m_rootPosition = p_position;
+}
+
+void AnimationProgramming::Animation::FootPlanting::SetContacts(const AnimationInfo* p_animation, uint32_t p_currentKey, uint32_t p_nextKey, float p_alpha)
+{
+	auto track = std::find_if(m_contactTracks.begin(), m_contactTracks.end(), [p_animation](const FootContactTrack* p_track) { return &p_track->GetAnimation() == p_animation; });
+
+	for (uint32_t foot = 0; foot < FootContactTrack::FootCount; ++foot)
+	{
+		m_contactWeights[foot] = track != m_contactTracks.end() ? (*track)->GetContactWeight(foot, p_currentKey, p_nextKey, p_alpha) : 1.0f;
+		m_contactHeights[foot] = track != m_contactTracks.end() ? (*track)->GetContactHeight(foot) : 0.0f;
+	}
+}
+
+void AnimationProgramming::Animation::FootPlanting::GatherQueries(const std::vector<Data::Transformation>& p_pose, std::vector<AltMath::Vector2f>& p_queries)
+{
+	for (uint32_t foot = 0; foot < FootContactTrack::FootCount; ++foot)
+	{
+		m_feetPositions[foot] = IsValid() ? m_definition.CalculateModelTransformation(m_feet[foot], p_pose).first : AltMath::Vector3f(0.0f, 0.0f, 0.0f);
+		p_queries.emplace_back(m_rootPosition.x + m_feetPositions[foot].x, m_rootPosition.y + m_feetPositions[foot].y);
+	}
+}
+
+void AnimationProgramming::Animation::FootPlanting::Adjust(const float* p_heights, std::vector<Data::Transformation>& p_pose)
+{
+	if (!IsValid())
+		return;
+
+	/* Height of the ground under each foot, relative to the ground of the animation (The plane z = 0 of the model space) */
+	float grounds[FootContactTrack::FootCount];
+
+	for (uint32_t foot = 0; foot < FootContactTrack::FootCount; ++foot)
+		grounds[foot] = p_heights[foot] - m_rootPosition.z;
+
+	/* The pelvis goes down to the lowest foot down : a foot in the air doesn't pull it (Its ground counts as the highest one) */
+	const float highest = *std::max_element(grounds, grounds + FootContactTrack::FootCount);
+	float pelvisOffset = highest;
+
+	for (uint32_t foot = 0; foot < FootContactTrack::FootCount; ++foot)
+		pelvisOffset = std::min(pelvisOffset, highest + (grounds[foot] - highest) * m_contactWeights[foot]);
+
+	/* The offset is along Z in model space, and in the space of the parent in the pose */
+	const AltMath::Vector3f offset(0.0f, 0.0f, pelvisOffset);
+	const int32_t pelvisParent = m_parents[m_pelvis];
+
+	if (pelvisParent != -1)
+		p_pose[m_pelvis].first = p_pose[m_pelvis].first + AltMath::Quaternion::Conjugate(m_definition.CalculateModelTransformation(static_cast<uint32_t>(pelvisParent), p_pose).second) * offset;
+	else
+		p_pose[m_pelvis].first = p_pose[m_pelvis].first + offset;
+
+	for (uint32_t foot = 0; foot < FootContactTrack::FootCount; ++foot)
+	{
+		/* A foot down is on the ground under it, a foot in the air follows the pelvis without going under the ground */
+		const AltMath::Vector3f& position = m_feetPositions[foot];
+		const float down = position.z + grounds[foot];
+		const float air = std::max(position.z + pelvisOffset, grounds[foot] + m_contactHeights[foot]);
+
+		m_limbIK.SetTarget(foot, AltMath::Vector3f(position.x, position.y, air + (down - air) * m_contactWeights[foot]));
+	}
+}
+
+AnimationProgramming::Animation::LimbIK& AnimationProgramming::Animation::FootPlanting::GetLimbIK()
+{
+	return m_limbIK;
+}
+
+void AnimationProgramming::Animation::FootPlanting::Solve(std::vector<Data::Transformation>& p_pose, const IGroundProvider& p_ground)
+{
+	m_queries.clear();
+
+	GatherQueries(p_pose, m_queries);
+	p_ground.QueryHeights(m_queries, m_heights);
+	Adjust(m_heights.data(), p_pose);
+	m_limbIK.Solve(p_pose);
+}
+
+void AnimationProgramming::Animation::FootPlanting::SolveCrowd(const std::vector<FootPlanting*>& p_characters, const std::vector<std::vector<Data::Transformation>*>& p_poses, const IGroundProvider& p_ground, CrowdScratch& p_scratch, Tools::ThreadPool* p_threadPool)
+{
+	p_scratch.queries.clear();
+
+	for (size_t i = 0; i < p_characters.size(); ++i)
+		p_characters[i]->GatherQueries(*p_poses[i], p_scratch.queries);
+
+	/* One query for the whole crowd */
+	p_ground.QueryHeights(p_scratch.queries, p_scratch.heights);
+
+	p_scratch.requests.clear();
+	p_scratch.firstRequests.clear();
+
+	for (size_t i = 0; i < p_characters.size(); ++i)
+	{
+		p_characters[i]->Adjust(p_scratch.heights.data() + i * QueriesPerCharacter, *p_poses[i]);
+		p_scratch.firstRequests.push_back(static_cast<uint32_t>(p_scratch.requests.size()));
+		p_characters[i]->m_limbIK.GatherRequests(*p_poses[i], p_scratch.requests);
+	}
+
+	/* One solve for all the legs */
+	TwoBoneIKSolver::Solve(p_scratch.requests, p_scratch.results, p_threadPool);
+
+	for (size_t i = 0; i < p_characters.size(); ++i)
+		p_characters[i]->m_limbIK.ApplyResults(p_scratch.results.data() + p_scratch.firstRequests[i], *p_poses[i]);
+}
+
+void AnimationProgramming::Animation::FootPlanting::SaveSnapshot(Tools::Snapshot& p_snapshot) const
+{
+	p_snapshot.Write(m_rootPosition);
+
+	for (uint32_t foot = 0; foot < FootContactTrack::FootCount; ++foot)
+	{
+		p_snapshot.Write(m_contactWeights[foot]);
+		p_snapshot.Write(m_contactHeights[foot]);
+		p_snapshot.Write(m_feetPositions[foot]);
+	}
+}
+
+void AnimationProgramming::Animation::FootPlanting::RestoreSnapshot(Tools::Snapshot& p_snapshot)
+{
+	p_snapshot.Read(m_rootPosition);
+
+	for (uint32_t foot = 0; foot < FootContactTrack::FootCount; ++foot)
+	{
+		p_snapshot.Read(m_contactWeights[foot]);
+		p_snapshot.Read(m_contactHeights[foot]);
+		p_snapshot.Read(m_feetPositions[foot]);
+	}
+}
@@ -0,0 +1,55 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+
+#include "AnimationProgramming/Animation/HeightfieldGroundProvider.h"
+
+AnimationProgramming::Animation::HeightfieldGroundProvider::HeightfieldGroundProvider(uint32_t p_width, uint32_t p_depth, float p_cellSize, const AltMath::Vector2f& p_origin) :
+	m_width(std::max(p_width, 1u)),
+	m_depth(std::max(p_depth, 1u)),
+	m_cellSize(p_cellSize),
+	m_origin(p_origin),
+	m_heights(m_width * m_depth, 0.0f)
+{
+}
+
+void AnimationProgramming::Animation::HeightfieldGroundProvider::SetHeight(uint32_t p_x, uint32_t p_y, float p_height)
+{
+	m_heights[p_y * m_width + p_x] = p_height;
+}
+
+float AnimationProgramming::Animation::HeightfieldGroundProvider::GetHeight(uint32_t p_x, uint32_t p_y) const
+{
+	return m_heights[p_y * m_width + p_x];
+}
+
+float AnimationProgramming::Animation::HeightfieldGroundProvider::SampleHeight(const AltMath::Vector2f& p_point) const
+{
+	/* Position in samples, clamped to the grid */
+	const float x = std::clamp((p_point.x - m_origin.x) / m_cellSize, 0.0f, static_cast<float>(m_width - 1));
+	const float y = std::clamp((p_point.y - m_origin.y) / m_cellSize, 0.0f, static_cast<float>(m_depth - 1));
+
+	const uint32_t x0 = std::min(static_cast<uint32_t>(x), m_width - 1);
+	const uint32_t y0 = std::min(static_cast<uint32_t>(y), m_depth - 1);
+	const uint32_t x1 = std::min(x0 + 1, m_width - 1);
+	const uint32_t y1 = std::min(y0 + 1, m_depth - 1);
+	const float alphaX = x - static_cast<float>(x0);
+	const float alphaY = y - static_cast<float>(y0);
+
+	const float bottom = GetHeight(x0, y0) + (GetHeight(x1, y0) - GetHeight(x0, y0)) * alphaX;
+	const float top = GetHeight(x0, y1) + (GetHeight(x1, y1) - GetHeight(x0, y1)) * alphaX;
+
+	return bottom + (top - bottom) * alphaY;
+}
+
+void AnimationProgramming::Animation::HeightfieldGroundProvider::QueryHeights(const std::vector<AltMath::Vector2f>& p_points, std::vector<float>& p_heights) const
+{
+	p_heights.resize(p_points.size());
+
+	for (size_t i = 0; i < p_points.size(); ++i)
+		p_heights[i] = SampleHeight(p_points[i]);
+}
@@ -0,0 +1,207 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "AnimationProgramming/Animation/Inertializer.h"
+
+namespace
+{
+	/* Under this offset, a bone is considered already aligned with the new animation */
+	constexpr float kMinimumOffset = 1e-6f;
+
+	/**
+	* Return the rotation from p_target to p_source (Shortest path) as an axis and an angle
+	*/
+	void CalculateRotationOffset(const AltMath::Quaternion& p_source, const AltMath::Quaternion& p_target, AltMath::Vector3f& p_axis, float& p_angle)
+	{
+		AltMath::Quaternion offset = p_source * AltMath::Quaternion::Conjugate(p_target);
+
+		if (offset.GetRealValue() < 0.0f)
+			offset = offset * -1.0f;
+
+		const AltMath::Vector3f vector(offset.GetXAxisValue(), offset.GetYAxisValue(), offset.GetZAxisValue());
+		const float sinHalfAngle = vector.Length();
+
+		if (sinHalfAngle > kMinimumOffset)
+		{
+			p_axis = vector / sinHalfAngle;
+			p_angle = 2.0f * std::atan2(sinHalfAngle, offset.GetRealValue());
+		}
+		else
+		{
+			p_axis = AltMath::Vector3f(1.0f, 0.0f, 0.0f);
+			p_angle = 0.0f;
+		}
+	}
+}
+
+void AnimationProgramming::Animation::Inertializer::Start(const std::vector<Data::Transformation>& p_previousPose, const std::vector<Data::Transformation>& p_currentPose, float p_deltaTime, const std::vector<Data::Transformation>& p_targetPose, float p_duration)
+{
+	/* Without a source pose (Nothing has been evaluated yet), there is nothing to blend from */
+	if (p_currentPose.size() != p_targetPose.size())
+	{
+		Stop();
+		return;
+	}
+
+	const bool hasVelocity = p_deltaTime > 0.0f && p_previousPose.size() == p_currentPose.size();
+
+	m_offsets.resize(p_targetPose.size());
+
+	for (size_t i = 0; i < p_targetPose.size(); ++i)
+	{
+		auto&[currentPosition, currentRotation] = p_currentPose[i];
+		auto&[targetPosition, targetRotation] = p_targetPose[i];
+		BoneOffset& offset = m_offsets[i];
+
+		/* Position : the offset is a distance along a fixed direction, the velocity is projected on this direction */
+		const AltMath::Vector3f positionOffset = currentPosition - targetPosition;
+		const float distance = positionOffset.Length();
+		float positionVelocity = 0.0f;
+
+		offset.positionDirection = distance > kMinimumOffset ? positionOffset / distance : AltMath::Vector3f(1.0f, 0.0f, 0.0f);
+
+		if (hasVelocity)
+		{
+			const AltMath::Vector3f previousOffset = p_previousPose[i].first - targetPosition;
+			positionVelocity = (distance - AltMath::Vector3f::DotProduct(previousOffset, offset.positionDirection)) / p_deltaTime;
+		}
+
+		offset.position.Initialize(distance, positionVelocity, p_duration);
+
+		/* Rotation : the offset is an angle around a fixed axis, the velocity is projected on this axis */
+		float angle;
+		float rotationVelocity = 0.0f;
+		CalculateRotationOffset(currentRotation, targetRotation, offset.rotationAxis, angle);
+
+		if (hasVelocity)
+		{
+			AltMath::Vector3f previousAxis;
+			float previousAngle;
+			CalculateRotationOffset(p_previousPose[i].second, targetRotation, previousAxis, previousAngle);
+			rotationVelocity = (angle - AltMath::Vector3f::DotProduct(previousAxis * previousAngle, offset.rotationAxis)) / p_deltaTime;
+		}
+
+		offset.rotation.Initialize(angle, rotationVelocity, p_duration);
+	}
+
+	m_time = 0.0f;
+	m_duration = p_duration;
+	m_active = p_duration > 0.0f && !m_offsets.empty();
+}
+
+void AnimationProgramming::Animation::Inertializer::Stop()
+{
+	m_active = false;
+}
+
+bool AnimationProgramming::Animation::Inertializer::IsActive() const
+{
+	return m_active;
+}
+
+void AnimationProgramming::Animation::Inertializer::Update(float p_deltaTime)
+{
+	if (!m_active)
+		return;
+
+	m_time += p_deltaTime;
+
+	if (m_time >= m_duration)
+		Stop();
+}
+
+void AnimationProgramming::Animation::Inertializer::Apply(std::vector<Data::Transformation>& p_pose) const
+{
+	if (!m_active)
+		return;
+
+	const size_t boneCount = std::min(p_pose.size(), m_offsets.size());
+
+	for (size_t i = 0; i < boneCount; ++i)
+	{
+		auto&[position, rotation] = p_pose[i];
+		const BoneOffset& offset = m_offsets[i];
+
+		position += offset.positionDirection * offset.position.Evaluate(m_time);
+
+		const float angle = offset.rotation.Evaluate(m_time);
+		if (angle != 0.0f)
+			rotation = AltMath::Quaternion(offset.rotationAxis, angle) * rotation;
+	}
+}
+
+void AnimationProgramming::Animation::Inertializer::SaveSnapshot(Tools::Snapshot& p_snapshot) const
+{
+	/* The offsets hold AltMath vectors : they are written field by field */
+	p_snapshot.Write(static_cast<uint32_t>(m_offsets.size()));
+
+	for (const BoneOffset& offset : m_offsets)
+	{
+		p_snapshot.Write(offset.positionDirection);
+		p_snapshot.Write(offset.position);
+		p_snapshot.Write(offset.rotationAxis);
+		p_snapshot.Write(offset.rotation);
+	}
+
+	p_snapshot.Write(m_time);
+	p_snapshot.Write(m_duration);
+	p_snapshot.Write(m_active);
+}
+
+void AnimationProgramming::Animation::Inertializer::RestoreSnapshot(Tools::Snapshot& p_snapshot)
+{
+	m_offsets.resize(p_snapshot.ReadArraySize(sizeof(float) * 6 + sizeof(DecayingOffset) * 2));
+
+	for (BoneOffset& offset : m_offsets)
+	{
+		p_snapshot.Read(offset.positionDirection);
+		p_snapshot.Read(offset.position);
+		p_snapshot.Read(offset.rotationAxis);
+		p_snapshot.Read(offset.rotation);
+	}
+
+	p_snapshot.Read(m_time);
+	p_snapshot.Read(m_duration);
+	p_snapshot.Read(m_active);
+}
+
+void AnimationProgramming::Animation::Inertializer::DecayingOffset::Initialize(float p_x0, float p_v0, float p_duration)
+{
+	x0 = p_x0;
+
+	/* A velocity moving away from the target would overshoot : the offset only decays */
+	v0 = std::min(p_v0, 0.0f);
+
+	/* A fast velocity reaches the target earlier, the duration is shortened to avoid an overshoot */
+	duration = v0 < 0.0f ? std::min(p_duration, -5.0f * x0 / v0) : p_duration;
+
+	if (x0 <= kMinimumOffset || duration <= 0.0f)
+	{
+		duration = 0.0f;
+		return;
+	}
+
+	const float t1 = duration;
+	const float t2 = t1 * t1;
+	const float t3 = t2 * t1;
+
+	a0 = std::max((-8.0f * v0 * t1 - 20.0f * x0) / t2, 0.0f);
+	a = -(a0 * t2 + 6.0f * v0 * t1 + 12.0f * x0) / (2.0f * t3 * t2);
+	b = (3.0f * a0 * t2 + 16.0f * v0 * t1 + 30.0f * x0) / (2.0f * t2 * t2);
+	c = -(3.0f * a0 * t2 + 12.0f * v0 * t1 + 20.0f * x0) / (2.0f * t3);
+}
+
+float AnimationProgramming::Animation::Inertializer::DecayingOffset::Evaluate(float p_time) const
+{
+	if (p_time >= duration)
+		return 0.0f;
+
+	const float t = p_time;
+	return ((((a * t + b) * t + c) * t + 0.5f * a0) * t + v0) * t + x0;
+}
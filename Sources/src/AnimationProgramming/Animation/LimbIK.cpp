@@ -0,0 +1,259 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+#include <limits>
+
+#include "AnimationProgramming/Animation/LimbIK.h"
+#include "AnimationProgramming/Core/AnimationEngine.h"
+#include "AnimationProgramming/Tools/SIMD.h"
+
+namespace
+{
+	/**
+	* Bones of a limb of the mannequin, and its IK bone
+	*/
+	struct MannequinLimb
+	{
+		const char* root;
+		const char* joint;
+		const char* end;
+		const char* ikBone;
+	};
+
+	const MannequinLimb kMannequinLimbs[] =
+	{
+		{ "thigh_l", "calf_l", "foot_l", "ik_foot_l" },
+		{ "thigh_r", "calf_r", "foot_r", "ik_foot_r" },
+		{ "upperarm_l", "lowerarm_l", "hand_l", "ik_hand_l" },
+		{ "upperarm_r", "lowerarm_r", "hand_r", "ik_hand_r" }
+	};
+
+	/* Below this squared length, a bend axis is considered degenerate */
+	constexpr float kMinimumAxisLength2 = 1e-8f;
+}
+
+AnimationProgramming::Animation::LimbIK::LimbIK(const Rig::SkeletonDefinition& p_definition) :
+	m_definition(p_definition),
+	m_parents(p_definition.GetParents()),
+	m_bindPose(p_definition.GetBindPose())
+{
+	/* The IK bones of the engine follow its skeleton : a custom rig has none */
+	const uint32_t boneCount = p_definition.GetBoneCount();
+
+	if (boneCount == Core::AnimationEngine::GetSkeletonBoneCount())
+	{
+		for (uint32_t ikBone = 0; ikBone < Core::AnimationEngine::GetSkeletonIKBoneCount(); ++ikBone)
+		{
+			m_ikParents.push_back(Core::AnimationEngine::GetSkeletonBoneParentIndex(boneCount + ikBone));
+			m_ikNames.push_back(Core::AnimationEngine::GetSkeletonBoneName(boneCount + ikBone));
+			m_ikBindPose.push_back(Core::AnimationEngine::GetSkeletonBindPoseBoneLocalTransform(boneCount + ikBone));
+		}
+	}
+
+	m_ikPose.assign(m_ikParents.size(), std::make_pair(AltMath::Vector3f(0.0f, 0.0f, 0.0f), AltMath::Quaternion::Identity()));
+}
+
+bool AnimationProgramming::Animation::LimbIK::AddLimb(uint32_t p_root, uint32_t p_joint, uint32_t p_end, uint32_t p_ikBone)
+{
+	const uint32_t boneCount = static_cast<uint32_t>(m_parents.size());
+
+	if (p_root >= boneCount || p_joint >= boneCount || p_end >= boneCount || m_parents[p_joint] != static_cast<int32_t>(p_root) || m_parents[p_end] != static_cast<int32_t>(p_joint))
+		return false;
+
+	/* The bend axis of the bind pose (Same convention as the solver : end-to-root cross root-to-joint), in the space of the root bone */
+	const std::vector<Data::Transformation> bindPose(boneCount, std::make_pair(AltMath::Vector3f(0.0f, 0.0f, 0.0f), AltMath::Quaternion::Identity()));
+	const Data::Transformation root = m_definition.CalculateModelTransformation(p_root, bindPose);
+	const Data::Transformation joint = m_definition.CalculateModelTransformation(p_joint, bindPose);
+	const Data::Transformation end = m_definition.CalculateModelTransformation(p_end, bindPose);
+
+	const AltMath::Vector3f rootToJoint = joint.first - root.first;
+	const AltMath::Vector3f rootToEnd = end.first - root.first;
+	AltMath::Vector3f bendAxis = AltMath::Vector3f::CrossProduct(rootToEnd, rootToJoint);
+
+	/* A straight limb bends around any axis orthogonal to it */
+	if (bendAxis.LengthSquare() < kMinimumAxisLength2 * rootToEnd.LengthSquare() * rootToJoint.LengthSquare())
+	{
+		bendAxis = AltMath::Vector3f::CrossProduct(rootToJoint, AltMath::Vector3f(1.0f, 0.0f, 0.0f));
+
+		if (bendAxis.LengthSquare() < kMinimumAxisLength2 * rootToJoint.LengthSquare())
+			bendAxis = AltMath::Vector3f::CrossProduct(rootToJoint, AltMath::Vector3f(0.0f, 1.0f, 0.0f));
+	}
+
+	bendAxis = AltMath::Quaternion::Conjugate(root.second) * (bendAxis / bendAxis.Length());
+
+	const uint32_t ikBone = p_ikBone < m_ikParents.size() ? p_ikBone : std::numeric_limits<uint32_t>::max();
+	m_limbs.push_back({ p_root, p_joint, p_end, ikBone, bendAxis, AltMath::Vector3f(0.0f, 0.0f, 0.0f), 1.0f, false });
+
+	return true;
+}
+
+uint32_t AnimationProgramming::Animation::LimbIK::AddMannequinLimbs()
+{
+	/* The bones are looked up in the engine : the bones of the skeleton are the bones of the engine */
+	const uint32_t boneCount = static_cast<uint32_t>(m_parents.size());
+	uint32_t added = 0;
+
+	for (const MannequinLimb& limb : kMannequinLimbs)
+	{
+		const uint32_t root = Core::AnimationEngine::GetSkeletonBoneIndex(limb.root);
+		const uint32_t joint = Core::AnimationEngine::GetSkeletonBoneIndex(limb.joint);
+		const uint32_t end = Core::AnimationEngine::GetSkeletonBoneIndex(limb.end);
+
+		if (root < boneCount && joint < boneCount && end < boneCount && AddLimb(root, joint, end, FindIKBone(limb.ikBone)))
+			++added;
+	}
+
+	return added;
+}
+
+uint32_t AnimationProgramming::Animation::LimbIK::FindIKBone(const std::string& p_name) const
+{
+	auto found = std::find(m_ikNames.begin(), m_ikNames.end(), p_name);
+	return found != m_ikNames.end() ? static_cast<uint32_t>(found - m_ikNames.begin()) : std::numeric_limits<uint32_t>::max();
+}
+
+uint32_t AnimationProgramming::Animation::LimbIK::GetLimbCount() const
+{
+	return static_cast<uint32_t>(m_limbs.size());
+}
+
+const AnimationProgramming::Animation::LimbIK::Limb& AnimationProgramming::Animation::LimbIK::GetLimb(uint32_t p_limb) const
+{
+	return m_limbs[p_limb];
+}
+
+void AnimationProgramming::Animation::LimbIK::SetTarget(uint32_t p_limb, const AltMath::Vector3f& p_target, float p_weight)
+{
+	m_limbs[p_limb].target = p_target;
+	m_limbs[p_limb].weight = p_weight;
+	m_limbs[p_limb].hasTarget = true;
+}
+
+void AnimationProgramming::Animation::LimbIK::ClearTarget(uint32_t p_limb)
+{
+	m_limbs[p_limb].weight = 1.0f;
+	m_limbs[p_limb].hasTarget = false;
+}
+
+void AnimationProgramming::Animation::LimbIK::SetIKBonePose(const AnimationInfo& p_animation, uint32_t p_currentKey, uint32_t p_nextKey, float p_alpha)
+{
+	/* During a transition, the keys can belong to the previous animation */
+	const uint32_t currentKey = std::min(p_currentKey, p_animation.GetEndKey());
+	const uint32_t nextKey = std::min(p_nextKey, p_animation.GetEndKey());
+	const uint32_t ikBoneCount = std::min(static_cast<uint32_t>(m_ikPose.size()), p_animation.GetIKBonesCount());
+
+	for (uint32_t ikBone = 0; ikBone < ikBoneCount; ++ikBone)
+	{
+		const Data::Transformation current = p_animation.GetIKBoneTransformations(ikBone, currentKey);
+		const Data::Transformation next = p_animation.GetIKBoneTransformations(ikBone, nextKey);
+
+		m_ikPose[ikBone].first = Tools::SIMD::Lerp(current.first, next.first, p_alpha);
+		m_ikPose[ikBone].second = Tools::SIMD::Slerp(current.second, next.second, p_alpha);
+	}
+
+	m_hasIKBonePose = ikBoneCount > 0;
+}
+
+void AnimationProgramming::Animation::LimbIK::ClearIKBonePose()
+{
+	m_hasIKBonePose = false;
+}
+
+uint32_t AnimationProgramming::Animation::LimbIK::GatherRequests(const std::vector<Data::Transformation>& p_pose, std::vector<TwoBoneIKSolver::Request>& p_requests) const
+{
+	uint32_t gathered = 0;
+
+	for (const Limb& limb : m_limbs)
+	{
+		if (!HasTarget(limb))
+			continue;
+
+		/* The joint and the end are the direct children of the root : only the root walks up the hierarchy */
+		const Data::Transformation root = m_definition.CalculateModelTransformation(limb.root, p_pose);
+		const AltMath::Quaternion jointRotation = root.second * (m_bindPose[limb.joint].second * p_pose[limb.joint].second);
+		const AltMath::Vector3f joint = root.first + root.second * (m_bindPose[limb.joint].first + p_pose[limb.joint].first);
+		const AltMath::Vector3f end = joint + jointRotation * (m_bindPose[limb.end].first + p_pose[limb.end].first);
+
+		TwoBoneIKSolver::Request request;
+		request.root = root.first;
+		request.joint = joint;
+		request.end = end;
+		request.target = limb.hasTarget ? limb.target : CalculateIKBonePosition(limb.ikBone, p_pose);
+		request.bendAxis = root.second * limb.bendAxis;
+		request.weight = limb.weight;
+
+		p_requests.push_back(request);
+		++gathered;
+	}
+
+	return gathered;
+}
+
+void AnimationProgramming::Animation::LimbIK::ApplyResults(const TwoBoneIKSolver::Result* p_results, std::vector<Data::Transformation>& p_pose) const
+{
+	for (const Limb& limb : m_limbs)
+	{
+		if (!HasTarget(limb))
+			continue;
+
+		const TwoBoneIKSolver::Result& result = *p_results++;
+
+		/* World rotations before and after the solve : newRoot = R * root, newJoint = J * joint */
+		const AltMath::Quaternion parentRotation = m_parents[limb.root] != -1 ? m_definition.CalculateModelTransformation(m_parents[limb.root], p_pose).second : AltMath::Quaternion::Identity();
+		const AltMath::Quaternion rootLocal = m_bindPose[limb.root].second * p_pose[limb.root].second;
+		const AltMath::Quaternion jointLocal = m_bindPose[limb.joint].second * p_pose[limb.joint].second;
+		const AltMath::Quaternion rootWorld = parentRotation * rootLocal;
+		const AltMath::Quaternion solvedRootWorld = result.rootRotation * rootWorld;
+		const AltMath::Quaternion solvedJointWorld = result.jointRotation * (rootWorld * jointLocal);
+
+		/* Back to the local space, relative to the bind pose */
+		const AltMath::Quaternion solvedRootLocal = AltMath::Quaternion::Conjugate(parentRotation) * solvedRootWorld;
+		const AltMath::Quaternion solvedJointLocal = AltMath::Quaternion::Conjugate(solvedRootWorld) * solvedJointWorld;
+
+		p_pose[limb.root].second = AltMath::Quaternion::Conjugate(m_bindPose[limb.root].second) * solvedRootLocal;
+		p_pose[limb.joint].second = AltMath::Quaternion::Conjugate(m_bindPose[limb.joint].second) * solvedJointLocal;
+	}
+}
+
+void AnimationProgramming::Animation::LimbIK::Solve(std::vector<Data::Transformation>& p_pose)
+{
+	m_requests.clear();
+
+	if (GatherRequests(p_pose, m_requests) == 0)
+		return;
+
+	TwoBoneIKSolver::Solve(m_requests, m_results);
+	ApplyResults(m_results.data(), p_pose);
+}
+
+bool AnimationProgramming::Animation::LimbIK::HasTarget(const Limb& p_limb) const
+{
+	return p_limb.hasTarget || (m_hasIKBonePose && p_limb.ikBone < m_ikParents.size());
+}
+
+AltMath::Vector3f AnimationProgramming::Animation::LimbIK::CalculateIKBonePosition(uint32_t p_ikBone, const std::vector<Data::Transformation>& p_pose) const
+{
+	const uint32_t boneCount = static_cast<uint32_t>(m_parents.size());
+	AltMath::Vector3f position = m_ikBindPose[p_ikBone].first + m_ikPose[p_ikBone].first;
+	int32_t parent = m_ikParents[p_ikBone];
+
+	/* Up the IK bones, then up the bones of the skeleton */
+	while (parent >= static_cast<int32_t>(boneCount))
+	{
+		const uint32_t ikParent = static_cast<uint32_t>(parent) - boneCount;
+		const AltMath::Quaternion parentRotation = m_ikBindPose[ikParent].second * m_ikPose[ikParent].second;
+
+		position = m_ikBindPose[ikParent].first + m_ikPose[ikParent].first + parentRotation * position;
+		parent = m_ikParents[ikParent];
+	}
+
+	if (parent == -1)
+		return position;
+
+	const Data::Transformation parentTransformation = m_definition.CalculateModelTransformation(static_cast<uint32_t>(parent), p_pose);
+	return parentTransformation.first + parentTransformation.second * position;
+}
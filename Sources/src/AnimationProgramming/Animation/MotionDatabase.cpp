@@ -0,0 +1,351 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <immintrin.h>
+#include <limits>
+
+#include "AnimationProgramming/Animation/MotionDatabase.h"
+#include "AnimationProgramming/Tools/SIMD.h"
+#include "AnimationProgramming/Tools/SIMDTarget.h"
+
+namespace
+{
+	/* Number of frames compared by a thread pool task during a brute force search */
+	constexpr uint32_t kFramesPerChunk = 4096;
+
+	/* Below this standard deviation, a feature group is constant over the database : it is only weighted */
+	constexpr float kMinimumDeviation = 1e-6f;
+
+	struct SearchResult
+	{
+		uint32_t row = std::numeric_limits<uint32_t>::max();
+		float cost = std::numeric_limits<float>::max();
+	};
+
+	void SearchRowsScalar(const float* p_features, uint32_t p_stride, const float* p_query, uint32_t p_begin, uint32_t p_end, SearchResult& p_result)
+	{
+		for (uint32_t row = p_begin; row < p_end; ++row)
+		{
+			const float* features = p_features + static_cast<size_t>(row) * p_stride;
+			float cost = 0.0f;
+
+			for (uint32_t i = 0; i < p_stride; ++i)
+			{
+				const float offset = p_query[i] - features[i];
+				cost += offset * offset;
+			}
+
+			if (cost < p_result.cost)
+			{
+				p_result.cost = cost;
+				p_result.row = row;
+			}
+		}
+	}
+
+	SIMD_TARGET_AVX2 void SearchRowsAVX2(const float* p_features, uint32_t p_stride, const float* p_query, uint32_t p_begin, uint32_t p_end, SearchResult& p_result)
+	{
+		/* The rows are padded with zeros to a multiple of 8 floats, like the query */
+		for (uint32_t row = p_begin; row < p_end; ++row)
+		{
+			const float* features = p_features + static_cast<size_t>(row) * p_stride;
+			__m256 sum = _mm256_setzero_ps();
+
+			for (uint32_t i = 0; i < p_stride; i += 8)
+			{
+				const __m256 offset = _mm256_sub_ps(_mm256_loadu_ps(p_query + i), _mm256_loadu_ps(features + i));
+				sum = _mm256_fmadd_ps(offset, offset, sum);
+			}
+
+			__m128 half = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+			half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+			half = _mm_add_ss(half, _mm_shuffle_ps(half, half, 1));
+			const float cost = _mm_cvtss_f32(half);
+
+			if (cost < p_result.cost)
+			{
+				p_result.cost = cost;
+				p_result.row = row;
+			}
+		}
+	}
+
+	AltMath::Vector3f GetTranslation(const AnimationProgramming::Data::Matrix3x4& p_matrix)
+	{
+		return AltMath::Vector3f(p_matrix.elements[3], p_matrix.elements[7], p_matrix.elements[11]);
+	}
+}
+
+void AnimationProgramming::Animation::MotionDatabase::Build(const Rig::SkeletonDefinition& p_definition, const std::vector<const AnimationInstance*>& p_clips, const Settings& p_settings)
+{
+	const uint32_t boneCount = static_cast<uint32_t>(p_settings.featureBones.size());
+	const uint32_t trajectoryCount = static_cast<uint32_t>(p_settings.trajectoryKeys.size());
+
+	std::vector<FeatureGroup> groups;
+	for (uint32_t i = 0; i < boneCount; ++i)
+		groups.push_back({ 3, p_settings.positionWeight });
+	for (uint32_t i = 0; i < boneCount; ++i)
+		groups.push_back({ 3, p_settings.velocityWeight });
+	for (uint32_t i = 0; i < trajectoryCount; ++i)
+		groups.push_back({ 3, p_settings.trajectoryWeight });
+
+	std::vector<Frame> frames;
+	std::vector<float> features;
+	std::vector<Data::Transformation> pose;
+	std::vector<Data::Matrix3x4> modelMatrices;
+
+	/* World matrices of the root and of the feature bones, for every key of a clip */
+	std::vector<Data::Matrix3x4> rootMatrices;
+	std::vector<AltMath::Vector3f> bonePositions;
+
+	for (uint32_t clip = 0; clip < p_clips.size(); ++clip)
+	{
+		const AnimationInstance& animation = *p_clips[clip];
+		const uint32_t keyCount = animation.GetKeyCount();
+
+		rootMatrices.resize(keyCount);
+		bonePositions.resize(static_cast<size_t>(keyCount) * boneCount);
+
+		for (uint32_t key = 0; key < keyCount; ++key)
+		{
+			animation.SamplePose(static_cast<float>(key) * animation.frameDuration, pose);
+			p_definition.CalculateModelMatrices(pose, modelMatrices);
+			rootMatrices[key] = modelMatrices[p_settings.rootBone];
+
+			for (uint32_t bone = 0; bone < boneCount; ++bone)
+				bonePositions[static_cast<size_t>(key) * boneCount + bone] = GetTranslation(modelMatrices[p_settings.featureBones[bone]]);
+		}
+
+		/* Keys past the end wrap if the clip loops, and are clamped otherwise */
+		auto keyAhead = [&animation, keyCount](uint32_t p_key, uint32_t p_offset)
+		{
+			return animation.loop ? (p_key + p_offset) % keyCount : std::min(p_key + p_offset, keyCount - 1);
+		};
+
+		for (uint32_t key = 0; key < keyCount; ++key)
+		{
+			const Data::Matrix3x4 inverseRoot = rootMatrices[key].RigidInverse();
+			const uint32_t nextKey = keyAhead(key, 1);
+			const float velocityTime = nextKey != key ? animation.frameDuration : 1.0f;
+
+			frames.push_back({ clip, key });
+
+			for (uint32_t bone = 0; bone < boneCount; ++bone)
+			{
+				const AltMath::Vector3f position = inverseRoot.TransformPoint(bonePositions[static_cast<size_t>(key) * boneCount + bone]);
+				features.insert(features.end(), { position.x, position.y, position.z });
+			}
+
+			for (uint32_t bone = 0; bone < boneCount; ++bone)
+			{
+				/* Velocity in the space of the root of the current key */
+				const AltMath::Vector3f current = inverseRoot.TransformPoint(bonePositions[static_cast<size_t>(key) * boneCount + bone]);
+				const AltMath::Vector3f next = inverseRoot.TransformPoint(bonePositions[static_cast<size_t>(nextKey) * boneCount + bone]);
+				const AltMath::Vector3f velocity = (next - current) / velocityTime;
+				features.insert(features.end(), { velocity.x, velocity.y, velocity.z });
+			}
+
+			for (uint32_t trajectoryKey : p_settings.trajectoryKeys)
+			{
+				const AltMath::Vector3f position = inverseRoot.TransformPoint(GetTranslation(rootMatrices[keyAhead(key, trajectoryKey)]));
+				features.insert(features.end(), { position.x, position.y, position.z });
+			}
+		}
+	}
+
+	Build(frames, features, groups);
+
+	m_clips = p_clips;
+	m_clipFirstFrames.clear();
+	for (uint32_t frame = 0; frame < m_frames.size(); ++frame)
+	{
+		if (m_frames[frame].key == 0)
+			m_clipFirstFrames.push_back(frame);
+	}
+
+	m_trajectoryDimension = 6 * boneCount;
+}
+
+void AnimationProgramming::Animation::MotionDatabase::Build(const std::vector<Frame>& p_frames, const std::vector<float>& p_features, const std::vector<FeatureGroup>& p_groups)
+{
+	m_clips.clear();
+	m_clipFirstFrames.clear();
+	m_frames = p_frames;
+	m_groups = p_groups;
+
+	m_dimensions = 0;
+	for (const FeatureGroup& group : m_groups)
+		m_dimensions += group.size;
+
+	m_stride = (m_dimensions + RowAlignment - 1) / RowAlignment * RowAlignment;
+	m_trajectoryDimension = m_dimensions;
+
+	StoreFeatures(p_features);
+}
+
+uint32_t AnimationProgramming::Animation::MotionDatabase::GetFrameCount() const
+{
+	return static_cast<uint32_t>(m_frames.size());
+}
+
+uint32_t AnimationProgramming::Animation::MotionDatabase::GetDimensionCount() const
+{
+	return m_dimensions;
+}
+
+uint32_t AnimationProgramming::Animation::MotionDatabase::GetTrajectoryDimension() const
+{
+	return m_trajectoryDimension;
+}
+
+const AnimationProgramming::Animation::MotionDatabase::Frame& AnimationProgramming::Animation::MotionDatabase::GetFrame(uint32_t p_frame) const
+{
+	return m_frames[p_frame];
+}
+
+uint32_t AnimationProgramming::Animation::MotionDatabase::GetClipCount() const
+{
+	return static_cast<uint32_t>(m_clips.size());
+}
+
+const AnimationProgramming::Animation::AnimationInstance& AnimationProgramming::Animation::MotionDatabase::GetClip(uint32_t p_clip) const
+{
+	return *m_clips[p_clip];
+}
+
+uint32_t AnimationProgramming::Animation::MotionDatabase::GetClipFrame(uint32_t p_clip, uint32_t p_key) const
+{
+	return m_clipFirstFrames[p_clip] + std::min(p_key, m_clips[p_clip]->GetKeyCount() - 1);
+}
+
+const float* AnimationProgramming::Animation::MotionDatabase::GetNormalizedFeatures(uint32_t p_frame) const
+{
+	return m_features.data() + static_cast<size_t>(m_frameRows[p_frame]) * m_stride;
+}
+
+float AnimationProgramming::Animation::MotionDatabase::NormalizeFeature(uint32_t p_dimension, float p_value) const
+{
+	return (p_value - m_means[p_dimension]) * m_scales[p_dimension];
+}
+
+uint32_t AnimationProgramming::Animation::MotionDatabase::FindBestFrame(const float* p_query, float& p_cost, uint32_t p_maxLeafVisits) const
+{
+	const uint32_t row = m_tree.FindNearest(p_query, p_cost, p_maxLeafVisits);
+	return row < m_tree.GetCount() ? m_tree.GetOriginalIndex(row) : row;
+}
+
+uint32_t AnimationProgramming::Animation::MotionDatabase::FindBestFrameBruteForce(const float* p_query, float& p_cost, Tools::ThreadPool* p_threadPool) const
+{
+	/* The query is padded like the rows */
+	alignas(32) float query[64];
+	std::vector<float> largeQuery;
+	float* paddedQuery = query;
+
+	if (m_stride > 64)
+	{
+		largeQuery.resize(m_stride);
+		paddedQuery = largeQuery.data();
+	}
+
+	std::fill(paddedQuery, paddedQuery + m_stride, 0.0f);
+	std::copy(p_query, p_query + m_dimensions, paddedQuery);
+
+	const uint32_t rowCount = GetFrameCount();
+	const bool useAVX2 = Tools::SIMD::GetLevel() == Tools::ESIMDLevel::AVX2;
+
+	auto searchRows = [this, paddedQuery, useAVX2](uint32_t p_begin, uint32_t p_end, SearchResult& p_result)
+	{
+		if (useAVX2)
+			SearchRowsAVX2(m_features.data(), m_stride, paddedQuery, p_begin, p_end, p_result);
+		else
+			SearchRowsScalar(m_features.data(), m_stride, paddedQuery, p_begin, p_end, p_result);
+	};
+
+	SearchResult best;
+
+	if (p_threadPool)
+	{
+		/* Every chunk keeps its own best row, they are compared once every chunk is done */
+		std::vector<SearchResult> chunkResults((rowCount + kFramesPerChunk - 1) / kFramesPerChunk);
+
+		p_threadPool->ParallelFor(rowCount, kFramesPerChunk, [&chunkResults, &searchRows](uint32_t p_begin, uint32_t p_end)
+		{
+			searchRows(p_begin, p_end, chunkResults[p_begin / kFramesPerChunk]);
+		});
+
+		for (const SearchResult& result : chunkResults)
+		{
+			if (result.cost < best.cost)
+				best = result;
+		}
+	}
+	else
+	{
+		searchRows(0, rowCount, best);
+	}
+
+	p_cost = best.cost;
+	return best.row < rowCount ? m_tree.GetOriginalIndex(best.row) : best.row;
+}
+
+void AnimationProgramming::Animation::MotionDatabase::StoreFeatures(const std::vector<float>& p_features)
+{
+	const uint32_t frameCount = GetFrameCount();
+
+	m_means.assign(m_dimensions, 0.0f);
+	m_scales.assign(m_dimensions, 1.0f);
+
+	/* Mean of every feature, and standard deviation of every group (A group is scaled as a whole, to keep the direction of its vectors) */
+	uint32_t groupStart = 0;
+
+	for (const FeatureGroup& group : m_groups)
+	{
+		float deviation = 0.0f;
+
+		for (uint32_t dimension = groupStart; dimension < groupStart + group.size; ++dimension)
+		{
+			double sum = 0.0;
+			for (uint32_t frame = 0; frame < frameCount; ++frame)
+				sum += p_features[static_cast<size_t>(frame) * m_dimensions + dimension];
+
+			m_means[dimension] = frameCount > 0 ? static_cast<float>(sum / frameCount) : 0.0f;
+
+			double squaredSum = 0.0;
+			for (uint32_t frame = 0; frame < frameCount; ++frame)
+			{
+				const double offset = p_features[static_cast<size_t>(frame) * m_dimensions + dimension] - m_means[dimension];
+				squaredSum += offset * offset;
+			}
+
+			deviation += frameCount > 0 ? static_cast<float>(std::sqrt(squaredSum / frameCount)) : 0.0f;
+		}
+
+		deviation /= static_cast<float>(std::max(group.size, 1u));
+		const float scale = deviation > kMinimumDeviation ? group.weight / deviation : group.weight;
+
+		for (uint32_t dimension = groupStart; dimension < groupStart + group.size; ++dimension)
+			m_scales[dimension] = scale;
+
+		groupStart += group.size;
+	}
+
+	m_features.assign(static_cast<size_t>(frameCount) * m_stride, 0.0f);
+
+	for (uint32_t frame = 0; frame < frameCount; ++frame)
+	{
+		for (uint32_t dimension = 0; dimension < m_dimensions; ++dimension)
+			m_features[static_cast<size_t>(frame) * m_stride + dimension] = NormalizeFeature(dimension, p_features[static_cast<size_t>(frame) * m_dimensions + dimension]);
+	}
+
+	/* The tree reorders the rows : keep where every frame ends up */
+	m_tree.Build(m_features.data(), frameCount, m_dimensions, m_stride);
+
+	m_frameRows.resize(frameCount);
+	for (uint32_t row = 0; row < frameCount; ++row)
+		m_frameRows[m_tree.GetOriginalIndex(row)] = row;
+}
@@ -0,0 +1,176 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "AnimationProgramming/Animation/MotionMatcher.h"
+#include "AnimationProgramming/Tools/SIMD.h"
+
+namespace
+{
+	/* A best frame this close (In keys) after the current frame of the same clip is the natural continuation : no jump */
+	constexpr uint32_t kContinuationKeys = 3;
+
+	float AdvanceTime(const AnimationProgramming::Animation::AnimationInstance& p_clip, float p_time, float p_deltaTime)
+	{
+		const float duration = p_clip.GetDuration();
+		const float time = p_time + p_deltaTime * p_clip.speedCoefficient;
+
+		if (duration <= 0.0f)
+			return 0.0f;
+
+		if (!p_clip.loop)
+			return std::min(time, duration);
+
+		const float wrapped = std::fmod(time, duration);
+		return wrapped < 0.0f ? wrapped + duration : wrapped;
+	}
+}
+
+AnimationProgramming::Animation::MotionMatcher::MotionMatcher(const MotionDatabase& p_database) :
+	m_database(p_database)
+{
+}
+
+void AnimationProgramming::Animation::MotionMatcher::PlayFrame(uint32_t p_frame)
+{
+	const MotionDatabase::Frame& frame = m_database.GetFrame(p_frame);
+
+	m_clip = frame.clip;
+	m_time = static_cast<float>(frame.key) * m_database.GetClip(frame.clip).frameDuration;
+	m_transitionTime = m_transitionDuration;
+	m_searchTimer = 0.0f;
+}
+
+uint32_t AnimationProgramming::Animation::MotionMatcher::GetCurrentFrame() const
+{
+	const AnimationInstance& clip = m_database.GetClip(m_clip);
+	const uint32_t key = static_cast<uint32_t>(m_time / clip.frameDuration + 0.5f);
+
+	return m_database.GetClipFrame(m_clip, clip.loop ? key % clip.GetKeyCount() : key);
+}
+
+void AnimationProgramming::Animation::MotionMatcher::SetDesiredTrajectory(const std::vector<AltMath::Vector3f>& p_trajectory)
+{
+	m_desiredTrajectory = p_trajectory;
+}
+
+void AnimationProgramming::Animation::MotionMatcher::SetSearchInterval(float p_interval)
+{
+	m_searchInterval = p_interval;
+}
+
+void AnimationProgramming::Animation::MotionMatcher::SetSearchBudget(uint32_t p_maxLeafVisits)
+{
+	m_searchBudget = p_maxLeafVisits;
+}
+
+void AnimationProgramming::Animation::MotionMatcher::SetTransitionDuration(float p_duration)
+{
+	m_transitionDuration = p_duration;
+}
+
+void AnimationProgramming::Animation::MotionMatcher::Update(float p_deltaTime)
+{
+	const AnimationInstance& clip = m_database.GetClip(m_clip);
+
+	m_time = AdvanceTime(clip, m_time, p_deltaTime);
+	m_transitionTime = std::min(m_transitionTime + p_deltaTime, m_transitionDuration);
+
+	if (m_transitionTime < m_transitionDuration)
+		m_previousTime = AdvanceTime(m_database.GetClip(m_previousClip), m_previousTime, p_deltaTime);
+
+	/* A clip that doesn't loop can't be continued once finished : search right away */
+	m_searchTimer += p_deltaTime;
+	if (m_searchTimer >= m_searchInterval || (!clip.loop && m_time >= clip.GetDuration()))
+	{
+		m_searchTimer = 0.0f;
+		Search();
+	}
+}
+
+void AnimationProgramming::Animation::MotionMatcher::Evaluate(std::vector<Data::Transformation>& p_pose)
+{
+	m_database.GetClip(m_clip).SamplePose(m_time, p_pose);
+
+	if (m_transitionDuration <= 0.0f || m_transitionTime >= m_transitionDuration)
+		return;
+
+	m_database.GetClip(m_previousClip).SamplePose(m_previousTime, m_previousPose);
+
+	/* The previous frame fades out : blend from it towards the current frame */
+	const float alpha = m_transitionTime / m_transitionDuration;
+	const size_t boneCount = std::min(p_pose.size(), m_previousPose.size());
+
+	for (size_t bone = 0; bone < boneCount; ++bone)
+	{
+		p_pose[bone].first = Tools::SIMD::Lerp(m_previousPose[bone].first, p_pose[bone].first, alpha);
+		p_pose[bone].second = Tools::SIMD::Slerp(m_previousPose[bone].second, p_pose[bone].second, alpha);
+	}
+}
+
+void AnimationProgramming::Animation::MotionMatcher::Search()
+{
+	const uint32_t currentFrame = GetCurrentFrame();
+	const uint32_t dimensions = m_database.GetDimensionCount();
+	const uint32_t trajectoryDimension = m_database.GetTrajectoryDimension();
+
+	/* The query is the current pose features, with the desired trajectory instead of the trajectory of the clip */
+	const float* currentFeatures = m_database.GetNormalizedFeatures(currentFrame);
+	m_query.assign(currentFeatures, currentFeatures + dimensions);
+
+	const uint32_t trajectoryCount = std::min(static_cast<uint32_t>(m_desiredTrajectory.size()), (dimensions - trajectoryDimension) / 3);
+
+	for (uint32_t i = 0; i < trajectoryCount; ++i)
+	{
+		const uint32_t dimension = trajectoryDimension + 3 * i;
+		m_query[dimension] = m_database.NormalizeFeature(dimension, m_desiredTrajectory[i].x);
+		m_query[dimension + 1] = m_database.NormalizeFeature(dimension + 1, m_desiredTrajectory[i].y);
+		m_query[dimension + 2] = m_database.NormalizeFeature(dimension + 2, m_desiredTrajectory[i].z);
+	}
+
+	float cost = 0.0f;
+	const uint32_t bestFrame = m_database.FindBestFrame(m_query.data(), cost, m_searchBudget);
+
+	if (bestFrame >= m_database.GetFrameCount())
+		return;
+
+	const MotionDatabase::Frame& best = m_database.GetFrame(bestFrame);
+	const MotionDatabase::Frame& current = m_database.GetFrame(currentFrame);
+
+	if (best.clip == current.clip && best.key >= current.key && best.key - current.key <= kContinuationKeys)
+		return;
+
+	m_previousClip = m_clip;
+	m_previousTime = m_time;
+	m_transitionTime = 0.0f;
+
+	m_clip = best.clip;
+	m_time = static_cast<float>(best.key) * m_database.GetClip(best.clip).frameDuration;
+}
+
+void AnimationProgramming::Animation::MotionMatcher::SaveSnapshot(Tools::Snapshot& p_snapshot) const
+{
+	p_snapshot.Write(m_clip);
+	p_snapshot.Write(m_time);
+	p_snapshot.Write(m_previousClip);
+	p_snapshot.Write(m_previousTime);
+	p_snapshot.Write(m_transitionTime);
+	p_snapshot.Write(m_searchTimer);
+	p_snapshot.WriteArray(m_desiredTrajectory);
+}
+
+void AnimationProgramming::Animation::MotionMatcher::RestoreSnapshot(Tools::Snapshot& p_snapshot)
+{
+	p_snapshot.Read(m_clip);
+	p_snapshot.Read(m_time);
+	p_snapshot.Read(m_previousClip);
+	p_snapshot.Read(m_previousTime);
+	p_snapshot.Read(m_transitionTime);
+	p_snapshot.Read(m_searchTimer);
+	p_snapshot.ReadArray(m_desiredTrajectory);
+}
@@ -0,0 +1,135 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <cmath>
+#include <cstring>
+
+#include "AnimationProgramming/Animation/PoseCache.h"
+
+bool AnimationProgramming::Animation::PoseCacheKey::operator==(const PoseCacheKey& p_other) const
+{
+	return
+		skeleton == p_other.skeleton &&
+		clip == p_other.clip &&
+		currentKeyFrame == p_other.currentKeyFrame &&
+		nextKeyFrame == p_other.nextKeyFrame &&
+		quantizedAlpha == p_other.quantizedAlpha &&
+		effectors == p_other.effectors &&
+		paletteFormat == p_other.paletteFormat;
+}
+
+size_t AnimationProgramming::Animation::PoseCacheKeyHash::operator()(const PoseCacheKey& p_key) const
+{
+	/* Boost-like hash combination */
+	size_t hash = std::hash<const void*>()(p_key.skeleton);
+
+	auto combine = [&hash](size_t p_value)
+	{
+		hash ^= p_value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+	};
+
+	combine(std::hash<const void*>()(p_key.clip));
+	combine(p_key.currentKeyFrame);
+	combine(p_key.nextKeyFrame);
+	combine(p_key.quantizedAlpha);
+	combine(p_key.effectors);
+	combine(static_cast<size_t>(p_key.paletteFormat));
+
+	return hash;
+}
+
+AnimationProgramming::Animation::PoseCache::PoseCache(float p_alphaTolerance) :
+	m_alphaTolerance(p_alphaTolerance),
+	m_hitCount(0),
+	m_missCount(0)
+{
+}
+
+float AnimationProgramming::Animation::PoseCache::GetAlphaTolerance() const
+{
+	return m_alphaTolerance;
+}
+
+void AnimationProgramming::Animation::PoseCache::SetAlphaTolerance(float p_alphaTolerance)
+{
+	m_alphaTolerance = p_alphaTolerance;
+}
+
+AnimationProgramming::Animation::PoseCacheKey AnimationProgramming::Animation::PoseCache::MakeKey(const Rig::SkeletonDefinition& p_skeleton, const AnimationInfo& p_clip, uint32_t p_currentKeyFrame, uint32_t p_nextKeyFrame, float p_alpha, uint32_t p_effectors, ESkinningPaletteFormat p_paletteFormat) const
+{
+	PoseCacheKey key;
+	key.skeleton = &p_skeleton;
+	key.clip = &p_clip;
+	key.currentKeyFrame = p_currentKeyFrame;
+	key.nextKeyFrame = p_nextKeyFrame;
+	key.effectors = p_effectors;
+	key.paletteFormat = p_paletteFormat;
+
+	if (m_alphaTolerance > 0.0f)
+		key.quantizedAlpha = static_cast<uint32_t>(std::floor(p_alpha / m_alphaTolerance + 0.5f));
+	else
+		std::memcpy(&key.quantizedAlpha, &p_alpha, sizeof(float));
+
+	return key;
+}
+
+std::shared_ptr<const AnimationProgramming::Animation::CachedPose> AnimationProgramming::Animation::PoseCache::GetOrEvaluate(const PoseCacheKey& p_key, const std::function<void(CachedPose&)>& p_evaluate, bool& p_evaluated)
+{
+	std::shared_ptr<Entry> entry;
+
+	{
+		std::lock_guard<std::mutex> lock(m_entriesMutex);
+
+		std::shared_ptr<Entry>& found = m_entries[p_key];
+		if (!found)
+			found = std::make_shared<Entry>();
+
+		entry = found;
+	}
+
+	/* The evaluation happens outside of the map lock, so different poses can be evaluated in parallel. Threads requesting the same pose wait here */
+	p_evaluated = false;
+	std::call_once(entry->evaluated, [&]()
+	{
+		p_evaluate(entry->pose);
+		p_evaluated = true;
+	});
+
+	++(p_evaluated ? m_missCount : m_hitCount);
+
+	/* The returned pointer keeps the entry alive, even if BeginFrame is called meanwhile */
+	return std::shared_ptr<const CachedPose>(entry, &entry->pose);
+}
+
+void AnimationProgramming::Animation::PoseCache::BeginFrame()
+{
+	std::lock_guard<std::mutex> lock(m_entriesMutex);
+	m_entries.clear();
+}
+
+uint64_t AnimationProgramming::Animation::PoseCache::GetHitCount() const
+{
+	return m_hitCount;
+}
+
+uint64_t AnimationProgramming::Animation::PoseCache::GetMissCount() const
+{
+	return m_missCount;
+}
+
+float AnimationProgramming::Animation::PoseCache::GetHitRate() const
+{
+	const uint64_t hitCount = m_hitCount;
+	const uint64_t requestCount = hitCount + m_missCount;
+
+	return requestCount > 0 ? static_cast<float>(hitCount) / static_cast<float>(requestCount) : 0.0f;
+}
+
+void AnimationProgramming::Animation::PoseCache::ResetCounters()
+{
+	m_hitCount = 0;
+	m_missCount = 0;
+}
@@ -0,0 +1,237 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+
+#include "AnimationProgramming/Animation/PoseStreamReader.h"
+#include "AnimationProgramming/Animation/PoseStreamWriter.h"
+#include "AnimationProgramming/Tools/ZeroRunLength.h"
+
+namespace
+{
+	/* Magic, version, content, character count, bone count, precisions and frames per block */
+	constexpr std::streamoff kHeaderSize = 8 * sizeof(uint32_t);
+
+	/* Frame count, decompressed size and compressed size */
+	constexpr std::streamoff kBlockHeaderSize = 3 * sizeof(uint32_t);
+
+	template<typename T>
+	bool Read(std::ifstream& p_stream, T& p_value)
+	{
+		return static_cast<bool>(p_stream.read(reinterpret_cast<char*>(&p_value), sizeof(T)));
+	}
+
+	/**
+	* Read a variable length integer written by the PoseStreamWriter. Return false if the data ends before the integer
+	*/
+	bool ReadVarint(const std::vector<uint8_t>& p_source, size_t& p_cursor, int32_t& p_value)
+	{
+		uint32_t value = 0;
+
+		for (uint32_t shift = 0; shift < 35; shift += 7)
+		{
+			if (p_cursor == p_source.size())
+				return false;
+
+			const uint8_t byte = p_source[p_cursor++];
+			value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+
+			if (!(byte & 0x80))
+			{
+				p_value = static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
+
+AnimationProgramming::Animation::PoseStreamReader::PoseStreamReader(const std::string& p_path) :
+	m_file(p_path, std::ios::binary),
+	m_loaded(false),
+	m_content(EPoseStreamContent::LOCAL_POSE),
+	m_characterCount(0),
+	m_boneCount(0),
+	m_valuesPerBone(0),
+	m_frameCount(0),
+	m_frame(0),
+	m_fileSize(0),
+	m_firstBlockOffset(kHeaderSize),
+	m_blockCursor(0),
+	m_blockFramesLeft(0),
+	m_firstFrameOfBlock(false)
+{
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	uint32_t content = 0;
+	float positionPrecision = 0.0f;
+	float rotationPrecision = 0.0f;
+	uint32_t framesPerBlock = 0;
+
+	if (!Read(m_file, magic) || !Read(m_file, version) || !Read(m_file, content) || !Read(m_file, m_characterCount) || !Read(m_file, m_boneCount)
+		|| !Read(m_file, positionPrecision) || !Read(m_file, rotationPrecision) || !Read(m_file, framesPerBlock))
+		return;
+
+	if (magic != PoseStreamWriter::Magic || version != PoseStreamWriter::Version || content > static_cast<uint32_t>(EPoseStreamContent::SKINNING_PALETTE))
+		return;
+
+	m_content = static_cast<EPoseStreamContent>(content);
+	m_steps = PoseStreamWriter::CalculateQuantizationSteps(m_content, positionPrecision, rotationPrecision);
+	m_valuesPerBone = static_cast<uint32_t>(m_steps.size());
+	m_values.resize(static_cast<size_t>(m_characterCount) * m_boneCount * m_valuesPerBone, 0);
+
+	m_file.seekg(0, std::ios::end);
+	m_fileSize = static_cast<uint64_t>(m_file.tellg());
+
+	/* Count the frames of the complete blocks, only their headers are read */
+	std::streamoff offset = kHeaderSize;
+
+	while (offset + kBlockHeaderSize <= static_cast<std::streamoff>(m_fileSize))
+	{
+		uint32_t frameCount = 0;
+		uint32_t blockSize = 0;
+		uint32_t compressedSize = 0;
+
+		m_file.seekg(offset);
+
+		if (!Read(m_file, frameCount) || !Read(m_file, blockSize) || !Read(m_file, compressedSize))
+			break;
+
+		if (offset + kBlockHeaderSize + compressedSize > static_cast<std::streamoff>(m_fileSize))
+			break;
+
+		m_frameCount += frameCount;
+		offset += kBlockHeaderSize + compressedSize;
+	}
+
+	m_loaded = true;
+	Rewind();
+}
+
+bool AnimationProgramming::Animation::PoseStreamReader::IsLoaded() const
+{
+	return m_loaded;
+}
+
+AnimationProgramming::Animation::EPoseStreamContent AnimationProgramming::Animation::PoseStreamReader::GetContent() const
+{
+	return m_content;
+}
+
+uint32_t AnimationProgramming::Animation::PoseStreamReader::GetCharacterCount() const
+{
+	return m_characterCount;
+}
+
+uint32_t AnimationProgramming::Animation::PoseStreamReader::GetBoneCount() const
+{
+	return m_boneCount;
+}
+
+uint32_t AnimationProgramming::Animation::PoseStreamReader::GetFrameCount() const
+{
+	return m_frameCount;
+}
+
+uint64_t AnimationProgramming::Animation::PoseStreamReader::GetFileSize() const
+{
+	return m_fileSize;
+}
+
+float AnimationProgramming::Animation::PoseStreamReader::GetBytesPerCharacterFrame() const
+{
+	const uint64_t characterFrames = static_cast<uint64_t>(m_frameCount) * m_characterCount;
+	return characterFrames != 0 ? static_cast<float>(static_cast<double>(m_fileSize - kHeaderSize) / static_cast<double>(characterFrames)) : 0.0f;
+}
+
+void AnimationProgramming::Animation::PoseStreamReader::Rewind()
+{
+	m_file.clear();
+	m_file.seekg(m_firstBlockOffset);
+	m_frame = 0;
+	m_blockFramesLeft = 0;
+}
+
+bool AnimationProgramming::Animation::PoseStreamReader::ReadFrame()
+{
+	if (!m_loaded || m_frame == m_frameCount)
+		return false;
+
+	if (m_blockFramesLeft == 0 && !ReadBlock())
+		return false;
+
+	/* The first frame of a block is encoded from zero, the next ones from the previous frame */
+	for (int32_t& value : m_values)
+	{
+		int32_t delta = 0;
+
+		if (!ReadVarint(m_block, m_blockCursor, delta))
+			return false;
+
+		value = m_firstFrameOfBlock ? delta : value + delta;
+	}
+
+	m_firstFrameOfBlock = false;
+	--m_blockFramesLeft;
+	++m_frame;
+
+	return true;
+}
+
+void AnimationProgramming::Animation::PoseStreamReader::GetLocalPose(uint32_t p_character, std::vector<Data::Transformation>& p_pose) const
+{
+	p_pose.resize(m_boneCount);
+
+	if (m_content != EPoseStreamContent::LOCAL_POSE || p_character >= m_characterCount)
+		return;
+
+	const int32_t* values = m_values.data() + static_cast<size_t>(p_character) * m_boneCount * m_valuesPerBone;
+
+	for (uint32_t i = 0; i < m_boneCount; ++i, values += m_valuesPerBone)
+	{
+		p_pose[i].first = AltMath::Vector3f(values[0] * m_steps[0], values[1] * m_steps[1], values[2] * m_steps[2]);
+		p_pose[i].second = AltMath::Quaternion(values[3] * m_steps[3], values[4] * m_steps[4], values[5] * m_steps[5], values[6] * m_steps[6]);
+	}
+}
+
+void AnimationProgramming::Animation::PoseStreamReader::GetSkinningPalette(uint32_t p_character, std::vector<Data::Matrix3x4>& p_palette) const
+{
+	p_palette.resize(m_boneCount);
+
+	if (m_content != EPoseStreamContent::SKINNING_PALETTE || p_character >= m_characterCount)
+		return;
+
+	const int32_t* values = m_values.data() + static_cast<size_t>(p_character) * m_boneCount * m_valuesPerBone;
+
+	for (uint32_t i = 0; i < m_boneCount; ++i, values += m_valuesPerBone)
+		for (uint32_t j = 0; j < m_valuesPerBone; ++j)
+			p_palette[i].elements[j] = values[j] * m_steps[j];
+}
+
+bool AnimationProgramming::Animation::PoseStreamReader::ReadBlock()
+{
+	uint32_t frameCount = 0;
+	uint32_t blockSize = 0;
+	uint32_t compressedSize = 0;
+
+	if (!Read(m_file, frameCount) || !Read(m_file, blockSize) || !Read(m_file, compressedSize) || frameCount == 0)
+		return false;
+
+	m_compressedBlock.resize(compressedSize);
+
+	if (!m_file.read(reinterpret_cast<char*>(m_compressedBlock.data()), compressedSize))
+		return false;
+
+	if (!Tools::ZeroRunLength::Decompress(m_compressedBlock.data(), m_compressedBlock.size(), m_block) || m_block.size() != blockSize)
+		return false;
+
+	m_blockCursor = 0;
+	m_blockFramesLeft = frameCount;
+	m_firstFrameOfBlock = true;
+
+	return true;
+}
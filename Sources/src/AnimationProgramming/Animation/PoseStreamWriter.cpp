@@ -0,0 +1,277 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "AnimationProgramming/Animation/PoseStreamWriter.h"
+#include "AnimationProgramming/Tools/ZeroRunLength.h"
+
+namespace
+{
+	/* Time the background thread sleeps when there is nothing to encode */
+	constexpr std::chrono::milliseconds kIdleTime(1);
+
+	template<typename T>
+	void Write(std::ofstream& p_stream, const T& p_value)
+	{
+		p_stream.write(reinterpret_cast<const char*>(&p_value), sizeof(T));
+	}
+
+	/* Bytes of the largest variable length integer (32 bits, 7 bits per byte) */
+	constexpr uint32_t kMaxVarintSize = 5;
+
+	/**
+	* Write the given value as a variable length integer (7 bits per byte, zigzag encoded so that small negative values stay small).
+	* Return the position after the last written byte
+	*/
+	uint8_t* WriteVarint(int32_t p_value, uint8_t* p_destination)
+	{
+		uint32_t value = (static_cast<uint32_t>(p_value) << 1) ^ static_cast<uint32_t>(p_value >> 31);
+
+		while (value >= 0x80)
+		{
+			*p_destination++ = static_cast<uint8_t>(value | 0x80);
+			value >>= 7;
+		}
+
+		*p_destination++ = static_cast<uint8_t>(value);
+
+		return p_destination;
+	}
+}
+
+AnimationProgramming::Animation::PoseStreamWriter::PoseStreamWriter(const std::string& p_path, EPoseStreamContent p_content, uint32_t p_characterCount, uint32_t p_boneCount, float p_positionPrecision, float p_rotationPrecision, uint32_t p_framesPerBlock, uint32_t p_queueCapacity) :
+	m_content(p_content),
+	m_characterCount(p_characterCount),
+	m_boneCount(p_boneCount),
+	m_framesPerBlock(std::max(p_framesPerBlock, 1u)),
+	m_steps(CalculateQuantizationSteps(p_content, p_positionPrecision, p_rotationPrecision)),
+	m_queue(std::max(p_queueCapacity, 1u)),
+	m_file(p_path, std::ios::binary | std::ios::trunc),
+	m_blockFrameCount(0),
+	m_submittedFrameCount(0),
+	m_droppedFrameCount(0),
+	m_writtenFrameCount(0),
+	m_writtenBytes(0),
+	m_stopping(false)
+{
+	m_valuesPerBone = static_cast<uint32_t>(m_steps.size());
+
+	for (float step : m_steps)
+		m_inverseSteps.push_back(1.0f / step);
+
+	m_capture.resize(static_cast<size_t>(m_characterCount) * m_boneCount * m_valuesPerBone, 0.0f);
+	m_previous.resize(m_capture.size(), 0);
+
+	if (!m_file)
+		return;
+
+	Write(m_file, Magic);
+	Write(m_file, Version);
+	Write(m_file, static_cast<uint32_t>(m_content));
+	Write(m_file, m_characterCount);
+	Write(m_file, m_boneCount);
+	Write(m_file, p_positionPrecision);
+	Write(m_file, p_rotationPrecision);
+	Write(m_file, m_framesPerBlock);
+
+	m_thread = std::thread(&PoseStreamWriter::WriterLoop, this);
+}
+
+AnimationProgramming::Animation::PoseStreamWriter::~PoseStreamWriter()
+{
+	m_stopping = true;
+
+	if (m_thread.joinable())
+		m_thread.join();
+}
+
+bool AnimationProgramming::Animation::PoseStreamWriter::IsOpen() const
+{
+	return m_thread.joinable();
+}
+
+AnimationProgramming::Animation::EPoseStreamContent AnimationProgramming::Animation::PoseStreamWriter::GetContent() const
+{
+	return m_content;
+}
+
+uint32_t AnimationProgramming::Animation::PoseStreamWriter::GetCharacterCount() const
+{
+	return m_characterCount;
+}
+
+uint32_t AnimationProgramming::Animation::PoseStreamWriter::GetBoneCount() const
+{
+	return m_boneCount;
+}
+
+void AnimationProgramming::Animation::PoseStreamWriter::CaptureLocalPose(uint32_t p_character, const std::vector<Data::Transformation>& p_pose)
+{
+	if (m_content != EPoseStreamContent::LOCAL_POSE || p_character >= m_characterCount)
+		return;
+
+	float* values = m_capture.data() + static_cast<size_t>(p_character) * m_boneCount * m_valuesPerBone;
+	const uint32_t boneCount = std::min(m_boneCount, static_cast<uint32_t>(p_pose.size()));
+
+	for (uint32_t i = 0; i < boneCount; ++i, values += m_valuesPerBone)
+	{
+		const Data::Transformation& transformation = p_pose[i];
+
+		values[0] = transformation.first.x;
+		values[1] = transformation.first.y;
+		values[2] = transformation.first.z;
+		values[3] = transformation.second.GetXAxisValue();
+		values[4] = transformation.second.GetYAxisValue();
+		values[5] = transformation.second.GetZAxisValue();
+		values[6] = transformation.second.GetRealValue();
+	}
+}
+
+void AnimationProgramming::Animation::PoseStreamWriter::CaptureSkinningPalette(uint32_t p_character, const std::vector<Data::Matrix3x4>& p_palette)
+{
+	if (m_content != EPoseStreamContent::SKINNING_PALETTE || p_character >= m_characterCount)
+		return;
+
+	float* values = m_capture.data() + static_cast<size_t>(p_character) * m_boneCount * m_valuesPerBone;
+	const uint32_t boneCount = std::min(m_boneCount, static_cast<uint32_t>(p_palette.size()));
+
+	for (uint32_t i = 0; i < boneCount; ++i, values += m_valuesPerBone)
+		std::copy(p_palette[i].elements, p_palette[i].elements + 12, values);
+}
+
+bool AnimationProgramming::Animation::PoseStreamWriter::SubmitFrame()
+{
+	++m_submittedFrameCount;
+
+	std::vector<float>* slot = IsOpen() ? m_queue.BeginPush() : nullptr;
+
+	if (!slot)
+	{
+		++m_droppedFrameCount;
+		return false;
+	}
+
+	/* The slot keeps its memory from one use to the next : no allocation once every slot has been used */
+	slot->assign(m_capture.begin(), m_capture.end());
+	m_queue.EndPush();
+
+	return true;
+}
+
+uint32_t AnimationProgramming::Animation::PoseStreamWriter::GetSubmittedFrameCount() const
+{
+	return m_submittedFrameCount;
+}
+
+uint32_t AnimationProgramming::Animation::PoseStreamWriter::GetDroppedFrameCount() const
+{
+	return m_droppedFrameCount;
+}
+
+uint32_t AnimationProgramming::Animation::PoseStreamWriter::GetWrittenFrameCount() const
+{
+	return m_writtenFrameCount;
+}
+
+uint64_t AnimationProgramming::Animation::PoseStreamWriter::GetWrittenBytes() const
+{
+	return m_writtenBytes;
+}
+
+float AnimationProgramming::Animation::PoseStreamWriter::GetBytesPerCharacterFrame() const
+{
+	const uint64_t characterFrames = static_cast<uint64_t>(m_writtenFrameCount) * m_characterCount;
+	return characterFrames != 0 ? static_cast<float>(static_cast<double>(m_writtenBytes) / static_cast<double>(characterFrames)) : 0.0f;
+}
+
+std::vector<float> AnimationProgramming::Animation::PoseStreamWriter::CalculateQuantizationSteps(EPoseStreamContent p_content, float p_positionPrecision, float p_rotationPrecision)
+{
+	/* A local pose bone is a position and a quaternion, a palette bone is 3 rows of a rotation followed by a translation */
+	if (p_content == EPoseStreamContent::LOCAL_POSE)
+		return { p_positionPrecision, p_positionPrecision, p_positionPrecision, p_rotationPrecision, p_rotationPrecision, p_rotationPrecision, p_rotationPrecision };
+
+	std::vector<float> steps;
+
+	for (uint32_t row = 0; row < 3; ++row)
+		steps.insert(steps.end(), { p_rotationPrecision, p_rotationPrecision, p_rotationPrecision, p_positionPrecision });
+
+	return steps;
+}
+
+void AnimationProgramming::Animation::PoseStreamWriter::WriterLoop()
+{
+	for (;;)
+	{
+		/* Read before the queue : every frame submitted before the writer is destroyed is encoded */
+		const bool stopping = m_stopping;
+
+		if (std::vector<float>* frame = m_queue.Front())
+		{
+			EncodeFrame(*frame);
+			m_queue.Pop();
+		}
+		else if (stopping)
+		{
+			break;
+		}
+		else
+		{
+			std::this_thread::sleep_for(kIdleTime);
+		}
+	}
+
+	if (m_blockFrameCount != 0)
+		WriteBlock();
+
+	m_file.flush();
+}
+
+void AnimationProgramming::Animation::PoseStreamWriter::EncodeFrame(const std::vector<float>& p_frame)
+{
+	const bool firstFrameOfBlock = m_blockFrameCount == 0;
+	const float* values = p_frame.data();
+	int32_t* previous = m_previous.data();
+
+	/* The frame is encoded in a buffer large enough for the worst case, then appended to the block */
+	m_encodedFrame.resize(kMaxVarintSize * p_frame.size());
+	uint8_t* cursor = m_encodedFrame.data();
+
+	for (size_t bone = 0; bone < p_frame.size(); bone += m_valuesPerBone)
+	{
+		for (uint32_t i = 0; i < m_valuesPerBone; ++i)
+		{
+			const int32_t quantized = static_cast<int32_t>(std::lrint(values[bone + i] * m_inverseSteps[i]));
+
+			cursor = WriteVarint(firstFrameOfBlock ? quantized : quantized - previous[bone + i], cursor);
+			previous[bone + i] = quantized;
+		}
+	}
+
+	m_block.insert(m_block.end(), m_encodedFrame.data(), cursor);
+
+	if (++m_blockFrameCount == m_framesPerBlock)
+		WriteBlock();
+}
+
+void AnimationProgramming::Animation::PoseStreamWriter::WriteBlock()
+{
+	m_compressedBlock.clear();
+	Tools::ZeroRunLength::Compress(m_block.data(), m_block.size(), m_compressedBlock);
+
+	Write(m_file, m_blockFrameCount);
+	Write(m_file, static_cast<uint32_t>(m_block.size()));
+	Write(m_file, static_cast<uint32_t>(m_compressedBlock.size()));
+	m_file.write(reinterpret_cast<const char*>(m_compressedBlock.data()), m_compressedBlock.size());
+
+	m_writtenBytes += 3 * sizeof(uint32_t) + m_compressedBlock.size();
+	m_writtenFrameCount += m_blockFrameCount;
+
+	m_block.clear();
+	m_blockFrameCount = 0;
+}
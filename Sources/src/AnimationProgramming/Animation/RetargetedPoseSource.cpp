@@ -0,0 +1,73 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <cmath>
+
+#include "AnimationProgramming/Animation/RetargetedPoseSource.h"
+
+AnimationProgramming::Animation::RetargetedPoseSource::RetargetedPoseSource(const AnimationInstance& p_animation, const Retargeter& p_retargeter) :
+	m_animation(&p_animation),
+	m_retargeter(p_retargeter)
+{
+}
+
+AnimationProgramming::Animation::RetargetedPoseSource::RetargetedPoseSource(IPoseSource& p_source, const Retargeter& p_retargeter) :
+	m_source(&p_source),
+	m_retargeter(p_retargeter)
+{
+}
+
+float AnimationProgramming::Animation::RetargetedPoseSource::GetTime() const
+{
+	return m_time;
+}
+
+void AnimationProgramming::Animation::RetargetedPoseSource::SetTime(float p_time)
+{
+	m_time = p_time;
+}
+
+void AnimationProgramming::Animation::RetargetedPoseSource::Update(float p_deltaTime)
+{
+	if (m_source)
+	{
+		m_source->Update(p_deltaTime);
+		return;
+	}
+
+	m_time += p_deltaTime * m_animation->speedCoefficient;
+
+	/* Keep the time of a looping clip small (SamplePose wraps it anyway) to preserve its precision */
+	const float duration = m_animation->GetDuration();
+	if (m_animation->loop && duration > 0.0f)
+		m_time = std::fmod(m_time, duration);
+}
+
+void AnimationProgramming::Animation::RetargetedPoseSource::Evaluate(std::vector<Data::Transformation>& p_pose)
+{
+	if (m_source)
+		m_source->Evaluate(m_sourcePose);
+	else
+		m_animation->SamplePose(m_time, m_sourcePose);
+
+	m_retargeter.Retarget(m_sourcePose, p_pose);
+}
+
+void AnimationProgramming::Animation::RetargetedPoseSource::SaveSnapshot(Tools::Snapshot& p_snapshot) const
+{
+	p_snapshot.Write(m_time);
+
+	if (m_source)
+		m_source->SaveSnapshot(p_snapshot);
+}
+
+void AnimationProgramming::Animation::RetargetedPoseSource::RestoreSnapshot(Tools::Snapshot& p_snapshot)
+{
+	p_snapshot.Read(m_time);
+
+	if (m_source)
+		m_source->RestoreSnapshot(p_snapshot);
+}
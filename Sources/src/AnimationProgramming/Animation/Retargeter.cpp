@@ -0,0 +1,321 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+#include <immintrin.h>
+#include <limits>
+
+#include "AnimationProgramming/Animation/Retargeter.h"
+#include "AnimationProgramming/Data/AlignedTypes.h"
+#include "AnimationProgramming/Tools/SIMD.h"
+#include "AnimationProgramming/Tools/SIMDTarget.h"
+
+namespace
+{
+	constexpr uint32_t kLaneWidth = AnimationProgramming::Animation::Retargeter::LaneWidth;
+
+	/* Below this length, a bone has no length to compare : the ratio of the whole skeletons is used */
+	constexpr float kMinimumBoneLength = 1e-4f;
+
+	/**
+	* Return the rotation of every bone of the given skeleton in its bind pose (Model space)
+	* @param p_definition
+	*/
+	std::vector<AltMath::Quaternion> CalculateBindWorldRotations(const AnimationProgramming::Rig::SkeletonDefinition& p_definition)
+	{
+		const std::vector<int32_t>& parents = p_definition.GetParents();
+		const std::vector<AnimationProgramming::Data::Transformation>& bindPose = p_definition.GetBindPose();
+
+		std::vector<AltMath::Quaternion> rotations(p_definition.GetBoneCount());
+
+		for (uint32_t bone : p_definition.GetEvaluationOrder())
+			rotations[bone] = parents[bone] != -1 ? rotations[parents[bone]] * bindPose[bone].second : bindPose[bone].second;
+
+		return rotations;
+	}
+
+	/**
+	* The source transformations of one group of target bones (Component c of the lane l is at [c * kLaneWidth + l])
+	*/
+	struct alignas(32) PoseLanes
+	{
+		float rotation[4 * kLaneWidth];
+		float translation[3 * kLaneWidth];
+	};
+
+	/**
+	* Correct the transformations of one group of target bones, one lane after the other
+	*/
+	void CorrectGroupScalar(PoseLanes& p_pose, const float* p_rotationCorrection, const float* p_parentCorrection, const float* p_translationScale)
+	{
+		for (uint32_t lane = 0; lane < kLaneWidth; ++lane)
+		{
+			auto component = [lane](float* p_components, uint32_t p_component) -> float& { return p_components[p_component * kLaneWidth + lane]; };
+			auto correction = [lane](const float* p_components, uint32_t p_component) { return p_components[p_component * kLaneWidth + lane]; };
+
+			/* conjugate(C) * q */
+			const float cx = -correction(p_rotationCorrection, 0), cy = -correction(p_rotationCorrection, 1), cz = -correction(p_rotationCorrection, 2), cw = correction(p_rotationCorrection, 3);
+			const float qx = component(p_pose.rotation, 0), qy = component(p_pose.rotation, 1), qz = component(p_pose.rotation, 2), qw = component(p_pose.rotation, 3);
+
+			const float tx = cw * qx + cx * qw + cy * qz - cz * qy;
+			const float ty = cw * qy - cx * qz + cy * qw + cz * qx;
+			const float tz = cw * qz + cx * qy - cy * qx + cz * qw;
+			const float tw = cw * qw - cx * qx - cy * qy - cz * qz;
+
+			/* (conjugate(C) * q) * C */
+			const float rx = -cx, ry = -cy, rz = -cz, rw = cw;
+
+			component(p_pose.rotation, 0) = tw * rx + tx * rw + ty * rz - tz * ry;
+			component(p_pose.rotation, 1) = tw * ry - tx * rz + ty * rw + tz * rx;
+			component(p_pose.rotation, 2) = tw * rz + tx * ry - ty * rx + tz * rw;
+			component(p_pose.rotation, 3) = tw * rw - tx * rx - ty * ry - tz * rz;
+
+			/* rotate(conjugate(P), v) = v + 2w(u x v) + 2u x (u x v), with u = -P.xyz */
+			const float ux = -correction(p_parentCorrection, 0), uy = -correction(p_parentCorrection, 1), uz = -correction(p_parentCorrection, 2), uw = correction(p_parentCorrection, 3);
+			const float vx = component(p_pose.translation, 0), vy = component(p_pose.translation, 1), vz = component(p_pose.translation, 2);
+
+			const float ax = 2.0f * (uy * vz - uz * vy);
+			const float ay = 2.0f * (uz * vx - ux * vz);
+			const float az = 2.0f * (ux * vy - uy * vx);
+
+			const float scale = p_translationScale[lane];
+
+			component(p_pose.translation, 0) = (vx + uw * ax + (uy * az - uz * ay)) * scale;
+			component(p_pose.translation, 1) = (vy + uw * ay + (uz * ax - ux * az)) * scale;
+			component(p_pose.translation, 2) = (vz + uw * az + (ux * ay - uy * ax)) * scale;
+		}
+	}
+
+	/**
+	* Same as CorrectGroupScalar, every lane at once (The correction tables are vectors : they are read unaligned)
+	*/
+	SIMD_TARGET_AVX2 void CorrectGroupAVX2(PoseLanes& p_pose, const float* p_rotationCorrection, const float* p_parentCorrection, const float* p_translationScale)
+	{
+		const __m256 zero = _mm256_setzero_ps();
+		const __m256 two = _mm256_set1_ps(2.0f);
+
+		const __m256 cx = _mm256_sub_ps(zero, _mm256_loadu_ps(p_rotationCorrection));
+		const __m256 cy = _mm256_sub_ps(zero, _mm256_loadu_ps(p_rotationCorrection + kLaneWidth));
+		const __m256 cz = _mm256_sub_ps(zero, _mm256_loadu_ps(p_rotationCorrection + 2 * kLaneWidth));
+		const __m256 cw = _mm256_loadu_ps(p_rotationCorrection + 3 * kLaneWidth);
+
+		const __m256 qx = _mm256_load_ps(p_pose.rotation);
+		const __m256 qy = _mm256_load_ps(p_pose.rotation + kLaneWidth);
+		const __m256 qz = _mm256_load_ps(p_pose.rotation + 2 * kLaneWidth);
+		const __m256 qw = _mm256_load_ps(p_pose.rotation + 3 * kLaneWidth);
+
+		/* conjugate(C) * q */
+		const __m256 tx = _mm256_fmadd_ps(cw, qx, _mm256_fmadd_ps(cx, qw, _mm256_fmsub_ps(cy, qz, _mm256_mul_ps(cz, qy))));
+		const __m256 ty = _mm256_fmadd_ps(cw, qy, _mm256_fmadd_ps(cy, qw, _mm256_fmsub_ps(cz, qx, _mm256_mul_ps(cx, qz))));
+		const __m256 tz = _mm256_fmadd_ps(cw, qz, _mm256_fmadd_ps(cz, qw, _mm256_fmsub_ps(cx, qy, _mm256_mul_ps(cy, qx))));
+		const __m256 tw = _mm256_fmsub_ps(cw, qw, _mm256_fmadd_ps(cx, qx, _mm256_fmadd_ps(cy, qy, _mm256_mul_ps(cz, qz))));
+
+		/* (conjugate(C) * q) * C */
+		const __m256 rx = _mm256_sub_ps(zero, cx);
+		const __m256 ry = _mm256_sub_ps(zero, cy);
+		const __m256 rz = _mm256_sub_ps(zero, cz);
+
+		_mm256_store_ps(p_pose.rotation, _mm256_fmadd_ps(tw, rx, _mm256_fmadd_ps(tx, cw, _mm256_fmsub_ps(ty, rz, _mm256_mul_ps(tz, ry)))));
+		_mm256_store_ps(p_pose.rotation + kLaneWidth, _mm256_fmadd_ps(tw, ry, _mm256_fmadd_ps(ty, cw, _mm256_fmsub_ps(tz, rx, _mm256_mul_ps(tx, rz)))));
+		_mm256_store_ps(p_pose.rotation + 2 * kLaneWidth, _mm256_fmadd_ps(tw, rz, _mm256_fmadd_ps(tz, cw, _mm256_fmsub_ps(tx, ry, _mm256_mul_ps(ty, rx)))));
+		_mm256_store_ps(p_pose.rotation + 3 * kLaneWidth, _mm256_fmsub_ps(tw, cw, _mm256_fmadd_ps(tx, rx, _mm256_fmadd_ps(ty, ry, _mm256_mul_ps(tz, rz)))));
+
+		/* rotate(conjugate(P), v) = v + 2w(u x v) + 2u x (u x v), with u = -P.xyz */
+		const __m256 ux = _mm256_sub_ps(zero, _mm256_loadu_ps(p_parentCorrection));
+		const __m256 uy = _mm256_sub_ps(zero, _mm256_loadu_ps(p_parentCorrection + kLaneWidth));
+		const __m256 uz = _mm256_sub_ps(zero, _mm256_loadu_ps(p_parentCorrection + 2 * kLaneWidth));
+		const __m256 uw = _mm256_loadu_ps(p_parentCorrection + 3 * kLaneWidth);
+
+		const __m256 vx = _mm256_load_ps(p_pose.translation);
+		const __m256 vy = _mm256_load_ps(p_pose.translation + kLaneWidth);
+		const __m256 vz = _mm256_load_ps(p_pose.translation + 2 * kLaneWidth);
+
+		const __m256 ax = _mm256_mul_ps(two, _mm256_fmsub_ps(uy, vz, _mm256_mul_ps(uz, vy)));
+		const __m256 ay = _mm256_mul_ps(two, _mm256_fmsub_ps(uz, vx, _mm256_mul_ps(ux, vz)));
+		const __m256 az = _mm256_mul_ps(two, _mm256_fmsub_ps(ux, vy, _mm256_mul_ps(uy, vx)));
+
+		const __m256 scale = _mm256_loadu_ps(p_translationScale);
+
+		_mm256_store_ps(p_pose.translation, _mm256_mul_ps(_mm256_add_ps(_mm256_fmadd_ps(uw, ax, vx), _mm256_fmsub_ps(uy, az, _mm256_mul_ps(uz, ay))), scale));
+		_mm256_store_ps(p_pose.translation + kLaneWidth, _mm256_mul_ps(_mm256_add_ps(_mm256_fmadd_ps(uw, ay, vy), _mm256_fmsub_ps(uz, ax, _mm256_mul_ps(ux, az))), scale));
+		_mm256_store_ps(p_pose.translation + 2 * kLaneWidth, _mm256_mul_ps(_mm256_add_ps(_mm256_fmadd_ps(uw, az, vz), _mm256_fmsub_ps(ux, ay, _mm256_mul_ps(uy, ax))), scale));
+	}
+
+	/**
+	* Store the given quaternion as the component lanes of the given bone
+	*/
+	void StoreQuaternion(std::vector<float>& p_table, uint32_t p_bone, const AltMath::Quaternion& p_quaternion)
+	{
+		const AnimationProgramming::Data::AlignedQuaternion quaternion(p_quaternion);
+		float* group = p_table.data() + (p_bone / kLaneWidth) * 4 * kLaneWidth + p_bone % kLaneWidth;
+
+		group[0] = quaternion.x;
+		group[kLaneWidth] = quaternion.y;
+		group[2 * kLaneWidth] = quaternion.z;
+		group[3 * kLaneWidth] = quaternion.w;
+	}
+}
+
+void AnimationProgramming::Animation::Retargeter::Build(const Rig::SkeletonDefinition& p_source, const Rig::SkeletonDefinition& p_target, const RoleTable& p_sourceRoles, const RoleTable& p_targetRoles)
+{
+	const std::vector<Data::Transformation>& sourceBindPose = p_source.GetBindPose();
+	const std::vector<Data::Transformation>& targetBindPose = p_target.GetBindPose();
+
+	m_sourceBoneCount = p_source.GetBoneCount();
+	m_targetBoneCount = p_target.GetBoneCount();
+	m_mappedBoneCount = 0;
+
+	/* Source bone of every role */
+	std::unordered_map<std::string, uint32_t> sourceRoleBones;
+	for (uint32_t bone = 0; bone < m_sourceBoneCount; ++bone)
+	{
+		auto role = p_sourceRoles.find(p_source.GetName(bone));
+		if (role != p_sourceRoles.end())
+			sourceRoleBones[role->second] = bone;
+	}
+
+	m_sourceBones.assign(m_targetBoneCount, m_sourceBoneCount);
+
+	for (uint32_t bone = 0; bone < m_targetBoneCount; ++bone)
+	{
+		const std::string& name = p_target.GetName(bone);
+		auto role = p_targetRoles.find(name);
+		auto roleBone = role != p_targetRoles.end() ? sourceRoleBones.find(role->second) : sourceRoleBones.end();
+
+		const uint32_t sourceBone = roleBone != sourceRoleBones.end() ? roleBone->second : p_source.FindBone(name);
+
+		if (sourceBone < m_sourceBoneCount)
+		{
+			m_sourceBones[bone] = sourceBone;
+			++m_mappedBoneCount;
+		}
+	}
+
+	/* Ratio of the sizes of the skeletons, for the bones whose own ratio is unknown (The root for example) */
+	float sourceLength = 0.0f;
+	float targetLength = 0.0f;
+
+	for (uint32_t bone = 0; bone < m_targetBoneCount; ++bone)
+	{
+		if (m_sourceBones[bone] < m_sourceBoneCount)
+		{
+			sourceLength += sourceBindPose[m_sourceBones[bone]].first.Length();
+			targetLength += targetBindPose[bone].first.Length();
+		}
+	}
+
+	const float skeletonScale = sourceLength > kMinimumBoneLength && targetLength > kMinimumBoneLength ? targetLength / sourceLength : 1.0f;
+
+	const std::vector<AltMath::Quaternion> sourceWorldRotations = CalculateBindWorldRotations(p_source);
+	const std::vector<AltMath::Quaternion> targetWorldRotations = CalculateBindWorldRotations(p_target);
+
+	const uint32_t paddedCount = (m_targetBoneCount + kLaneWidth - 1) / kLaneWidth * kLaneWidth;
+	m_rotationCorrections.assign(4 * paddedCount, 0.0f);
+	m_parentCorrections.assign(4 * paddedCount, 0.0f);
+	m_translationScales.assign(paddedCount, 0.0f);
+
+	for (uint32_t bone = 0; bone < paddedCount; ++bone)
+	{
+		AltMath::Quaternion rotationCorrection = AltMath::Quaternion::Identity();
+		AltMath::Quaternion parentCorrection = AltMath::Quaternion::Identity();
+		float translationScale = 1.0f;
+
+		if (bone < m_targetBoneCount && m_sourceBones[bone] < m_sourceBoneCount)
+		{
+			const uint32_t source = m_sourceBones[bone];
+			const int32_t sourceParentBone = p_source.GetParents()[source];
+			const int32_t targetParentBone = p_target.GetParents()[bone];
+
+			/* A rotation relative to the bind pose of the source bone, expressed in the bind frame of the target bone */
+			rotationCorrection = AltMath::Quaternion::Conjugate(sourceWorldRotations[source]) * targetWorldRotations[bone];
+
+			/* A translation is expressed in the frame of the parent (The model space for a root) */
+			const AltMath::Quaternion sourceParent = sourceParentBone != -1 ? sourceWorldRotations[sourceParentBone] : AltMath::Quaternion::Identity();
+			const AltMath::Quaternion targetParent = targetParentBone != -1 ? targetWorldRotations[targetParentBone] : AltMath::Quaternion::Identity();
+			parentCorrection = AltMath::Quaternion::Conjugate(sourceParent) * targetParent;
+
+			const float sourceBoneLength = sourceBindPose[source].first.Length();
+			const float targetBoneLength = targetBindPose[bone].first.Length();
+			translationScale = sourceBoneLength > kMinimumBoneLength && targetBoneLength > kMinimumBoneLength ? targetBoneLength / sourceBoneLength : skeletonScale;
+		}
+
+		StoreQuaternion(m_rotationCorrections, bone, rotationCorrection);
+		StoreQuaternion(m_parentCorrections, bone, parentCorrection);
+		m_translationScales[bone] = translationScale;
+	}
+}
+
+uint32_t AnimationProgramming::Animation::Retargeter::GetSourceBoneCount() const
+{
+	return m_sourceBoneCount;
+}
+
+uint32_t AnimationProgramming::Animation::Retargeter::GetTargetBoneCount() const
+{
+	return m_targetBoneCount;
+}
+
+uint32_t AnimationProgramming::Animation::Retargeter::GetMappedBoneCount() const
+{
+	return m_mappedBoneCount;
+}
+
+uint32_t AnimationProgramming::Animation::Retargeter::GetSourceBone(uint32_t p_targetBone) const
+{
+	return m_sourceBones[p_targetBone] < m_sourceBoneCount ? m_sourceBones[p_targetBone] : std::numeric_limits<uint32_t>::max();
+}
+
+void AnimationProgramming::Animation::Retargeter::Retarget(const std::vector<Data::Transformation>& p_sourcePose, std::vector<Data::Transformation>& p_targetPose) const
+{
+	const bool useAVX2 = Tools::SIMD::GetLevel() == Tools::ESIMDLevel::AVX2;
+	const uint32_t sourceCount = std::min(m_sourceBoneCount, static_cast<uint32_t>(p_sourcePose.size()));
+
+	p_targetPose.resize(m_targetBoneCount);
+
+	PoseLanes lanes;
+
+	for (uint32_t first = 0; first < m_targetBoneCount; first += kLaneWidth)
+	{
+		const uint32_t laneCount = std::min(kLaneWidth, m_targetBoneCount - first);
+
+		/* Gather the source transformations (The identity for the bones without source bone, and the padding) */
+		for (uint32_t lane = 0; lane < kLaneWidth; ++lane)
+		{
+			const uint32_t sourceBone = lane < laneCount ? m_sourceBones[first + lane] : m_sourceBoneCount;
+			Data::AlignedQuaternion rotation;
+			AltMath::Vector3f translation(0.0f, 0.0f, 0.0f);
+
+			if (sourceBone < sourceCount)
+			{
+				rotation = Data::AlignedQuaternion(p_sourcePose[sourceBone].second);
+				translation = p_sourcePose[sourceBone].first;
+			}
+
+			lanes.rotation[lane] = rotation.x;
+			lanes.rotation[kLaneWidth + lane] = rotation.y;
+			lanes.rotation[2 * kLaneWidth + lane] = rotation.z;
+			lanes.rotation[3 * kLaneWidth + lane] = rotation.w;
+			lanes.translation[lane] = translation.x;
+			lanes.translation[kLaneWidth + lane] = translation.y;
+			lanes.translation[2 * kLaneWidth + lane] = translation.z;
+		}
+
+		const float* rotationCorrection = m_rotationCorrections.data() + 4 * first;
+		const float* parentCorrection = m_parentCorrections.data() + 4 * first;
+		const float* translationScale = m_translationScales.data() + first;
+
+		if (useAVX2)
+			CorrectGroupAVX2(lanes, rotationCorrection, parentCorrection, translationScale);
+		else
+			CorrectGroupScalar(lanes, rotationCorrection, parentCorrection, translationScale);
+
+		for (uint32_t lane = 0; lane < laneCount; ++lane)
+		{
+			p_targetPose[first + lane].first = AltMath::Vector3f(lanes.translation[lane], lanes.translation[kLaneWidth + lane], lanes.translation[2 * kLaneWidth + lane]);
+			p_targetPose[first + lane].second = AltMath::Quaternion(lanes.rotation[lane], lanes.rotation[kLaneWidth + lane], lanes.rotation[2 * kLaneWidth + lane], lanes.rotation[3 * kLaneWidth + lane]);
+		}
+	}
+}
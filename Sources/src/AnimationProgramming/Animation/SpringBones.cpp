@@ -0,0 +1,250 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "AnimationProgramming/Animation/SpringBones.h"
+#include "AnimationProgramming/Tools/Math.h"
+
+namespace
+{
+	/* Characters solved by a thread at once */
+	constexpr uint32_t kCharactersPerChunk = 8;
+}
+
+AnimationProgramming::Animation::SpringBones::SpringBones(const Rig::SkeletonDefinition& p_definition, float p_stepRate) :
+	m_definition(p_definition),
+	m_parents(p_definition.GetParents()),
+	m_bindPose(p_definition.GetBindPose()),
+	m_stepTime(1.0f / std::max(p_stepRate, 1.0f)),
+	m_accumulatedTime(0.0f),
+	m_rootPosition(0.0f, 0.0f, 0.0f),
+	m_enabled(true),
+	m_hasState(false)
+{
+}
+
+uint32_t AnimationProgramming::Animation::SpringBones::AddChain(uint32_t p_root, uint32_t p_end, float p_stiffness, float p_damping, const AltMath::Vector3f& p_gravity)
+{
+	const uint32_t boneCount = static_cast<uint32_t>(m_parents.size());
+
+	if (p_root >= boneCount || p_end >= boneCount || p_root == p_end)
+		return std::numeric_limits<uint32_t>::max();
+
+	/* Up from the end to the root */
+	std::vector<uint32_t> bones;
+	int32_t bone = static_cast<int32_t>(p_end);
+
+	while (bone != -1 && bone != static_cast<int32_t>(p_root))
+	{
+		bones.push_back(static_cast<uint32_t>(bone));
+		bone = m_parents[bone];
+	}
+
+	if (bone == -1)
+		return std::numeric_limits<uint32_t>::max();
+
+	bones.push_back(p_root);
+
+	Chain chain;
+	chain.firstJoint = static_cast<uint32_t>(m_bones.size());
+	chain.jointCount = static_cast<uint32_t>(bones.size());
+	chain.stiffness = std::clamp(p_stiffness, 0.0f, 1.0f);
+	chain.damping = std::clamp(p_damping, 0.0f, 1.0f);
+	chain.gravity = p_gravity;
+
+	m_bones.insert(m_bones.end(), bones.rbegin(), bones.rend());
+	m_lengths.resize(m_bones.size(), 0.0f);
+	m_positions.resize(m_bones.size(), AltMath::Vector3f(0.0f, 0.0f, 0.0f));
+	m_previousPositions.resize(m_bones.size(), AltMath::Vector3f(0.0f, 0.0f, 0.0f));
+	m_previousAnimatedPositions.resize(m_bones.size(), AltMath::Vector3f(0.0f, 0.0f, 0.0f));
+	m_animatedPositions.resize(m_bones.size(), AltMath::Vector3f(0.0f, 0.0f, 0.0f));
+	m_chains.push_back(chain);
+
+	/* The new particles start from the next pose */
+	Reset();
+
+	return static_cast<uint32_t>(m_chains.size() - 1);
+}
+
+uint32_t AnimationProgramming::Animation::SpringBones::GetChainCount() const
+{
+	return static_cast<uint32_t>(m_chains.size());
+}
+
+const AnimationProgramming::Animation::SpringBones::Chain& AnimationProgramming::Animation::SpringBones::GetChain(uint32_t p_chain) const
+{
+	return m_chains[p_chain];
+}
+
+void AnimationProgramming::Animation::SpringBones::SetEnabled(bool p_enabled)
+{
+	if (p_enabled && !m_enabled)
+		Reset();
+
+	m_enabled = p_enabled;
+}
+
+bool AnimationProgramming::Animation::SpringBones::IsEnabled() const
+{
+	return m_enabled;
+}
+
+void AnimationProgramming::Animation::SpringBones::SetRootPosition(const AltMath::Vector3f& p_position)
+{
+	m_rootPosition = p_position;
+}
+
+void AnimationProgramming::Animation::SpringBones::Reset()
+{
+	m_hasState = false;
+	m_accumulatedTime = 0.0f;
+}
+
+void AnimationProgramming::Animation::SpringBones::Solve(std::vector<Data::Transformation>& p_pose, float p_deltaTime)
+{
+	if (!m_enabled || m_chains.empty())
+		return;
+
+	CalculateAnimatedPositions(p_pose);
+
+	/* The particles start at rest, on the pose */
+	if (!m_hasState)
+	{
+		m_positions = m_animatedPositions;
+		m_previousPositions = m_animatedPositions;
+		m_previousAnimatedPositions = m_animatedPositions;
+		m_hasState = true;
+		return;
+	}
+
+	/* Fixed steps : the time left is kept for the next frame, the time beyond the last allowed step is dropped */
+	m_accumulatedTime += std::max(p_deltaTime, 0.0f);
+
+	uint32_t stepCount = static_cast<uint32_t>(m_accumulatedTime / m_stepTime);
+
+	if (stepCount > MaxStepsPerFrame)
+	{
+		stepCount = MaxStepsPerFrame;
+		m_accumulatedTime = 0.0f;
+	}
+	else
+	{
+		m_accumulatedTime -= static_cast<float>(stepCount) * m_stepTime;
+	}
+
+	if (stepCount > 0)
+	{
+		for (uint32_t step = 1; step <= stepCount; ++step)
+			Step(static_cast<float>(step) / static_cast<float>(stepCount));
+
+		m_previousAnimatedPositions = m_animatedPositions;
+	}
+
+	/* The particles are in world space : only the directions between them are applied */
+	for (const Chain& chain : m_chains)
+		m_definition.ApplyChainPositions(&m_bones[chain.firstJoint], &m_positions[chain.firstJoint], chain.jointCount, p_pose);
+}
+
+void AnimationProgramming::Animation::SpringBones::SolveCrowd(const std::vector<SpringBones*>& p_characters, const std::vector<std::vector<Data::Transformation>*>& p_poses, float p_deltaTime, Tools::ThreadPool* p_threadPool)
+{
+	/* The characters are independent : each chunk solves its own ones */
+	auto solveCharacters = [&p_characters, &p_poses, p_deltaTime](uint32_t p_begin, uint32_t p_end)
+	{
+		for (uint32_t i = p_begin; i < p_end; ++i)
+			p_characters[i]->Solve(*p_poses[i], p_deltaTime);
+	};
+
+	const uint32_t characterCount = static_cast<uint32_t>(p_characters.size());
+
+	if (p_threadPool)
+		p_threadPool->ParallelFor(characterCount, kCharactersPerChunk, solveCharacters);
+	else
+		solveCharacters(0, characterCount);
+}
+
+void AnimationProgramming::Animation::SpringBones::CalculateAnimatedPositions(const std::vector<Data::Transformation>& p_pose)
+{
+	for (const Chain& chain : m_chains)
+	{
+		const uint32_t first = chain.firstJoint;
+		const uint32_t last = first + chain.jointCount - 1;
+
+		/* Only the root walks up the hierarchy */
+		Data::Transformation joint = m_definition.CalculateModelTransformation(m_bones[first], p_pose);
+
+		m_animatedPositions[first] = m_rootPosition + joint.first;
+
+		for (uint32_t i = first + 1; i <= last; ++i)
+		{
+			const uint32_t bone = m_bones[i];
+
+			joint.first = joint.first + joint.second * (m_bindPose[bone].first + p_pose[bone].first);
+			joint.second = joint.second * (m_bindPose[bone].second * p_pose[bone].second);
+
+			m_animatedPositions[i] = m_rootPosition + joint.first;
+			m_lengths[i] = (m_animatedPositions[i] - m_animatedPositions[i - 1]).Length();
+		}
+	}
+}
+
+void AnimationProgramming::Animation::SpringBones::Step(float p_alpha)
+{
+	const float stepTime2 = m_stepTime * m_stepTime;
+
+	for (const Chain& chain : m_chains)
+	{
+		const uint32_t first = chain.firstJoint;
+		const uint32_t last = first + chain.jointCount - 1;
+		const AltMath::Vector3f gravity = chain.gravity * stepTime2;
+
+		/* The root follows the animation */
+		m_positions[first] = m_previousAnimatedPositions[first] + (m_animatedPositions[first] - m_previousAnimatedPositions[first]) * p_alpha;
+		m_previousPositions[first] = m_positions[first];
+
+		for (uint32_t i = first + 1; i <= last; ++i)
+		{
+			const AltMath::Vector3f animated = m_previousAnimatedPositions[i] + (m_animatedPositions[i] - m_previousAnimatedPositions[i]) * p_alpha;
+
+			/* Verlet integration, then the spring toward the animated position */
+			const AltMath::Vector3f velocity = (m_positions[i] - m_previousPositions[i]) * (1.0f - chain.damping);
+
+			m_previousPositions[i] = m_positions[i];
+			m_positions[i] = m_positions[i] + velocity + gravity;
+			m_positions[i] = m_positions[i] + (animated - m_positions[i]) * chain.stiffness;
+
+			/* The bone keeps its length */
+			const AltMath::Vector3f direction = Tools::Math::Normalize(m_positions[i] - m_positions[i - 1], Tools::Math::Normalize(animated - m_positions[i - 1], AltMath::Vector3f(0.0f, 0.0f, -1.0f)));
+			m_positions[i] = m_positions[i - 1] + direction * m_lengths[i];
+		}
+	}
+}
+
+void AnimationProgramming::Animation::SpringBones::SaveSnapshot(Tools::Snapshot& p_snapshot) const
+{
+	p_snapshot.WriteArray(m_positions);
+	p_snapshot.WriteArray(m_previousPositions);
+	p_snapshot.WriteArray(m_previousAnimatedPositions);
+	p_snapshot.WriteArray(m_animatedPositions);
+	p_snapshot.Write(m_accumulatedTime);
+	p_snapshot.Write(m_rootPosition);
+	p_snapshot.Write(m_enabled);
+	p_snapshot.Write(m_hasState);
+}
+
+void AnimationProgramming::Animation::SpringBones::RestoreSnapshot(Tools::Snapshot& p_snapshot)
+{
+	p_snapshot.ReadArray(m_positions);
+	p_snapshot.ReadArray(m_previousPositions);
+	p_snapshot.ReadArray(m_previousAnimatedPositions);
+	p_snapshot.ReadArray(m_animatedPositions);
+	p_snapshot.Read(m_accumulatedTime);
+	p_snapshot.Read(m_rootPosition);
+	p_snapshot.Read(m_enabled);
+	p_snapshot.Read(m_hasState);
+}
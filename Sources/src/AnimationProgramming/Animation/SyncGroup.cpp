@@ -0,0 +1,147 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "AnimationProgramming/Animation/SyncGroup.h"
+#include "AnimationProgramming/Tools/SIMD.h"
+
+void AnimationProgramming::Animation::SyncGroup::AddAnimation(const SyncMarkerTrack& p_track, float p_speed)
+{
+	/* The entries are kept sorted by speed, so that the blended animations are neighbours */
+	auto position = std::upper_bound(m_entries.begin(), m_entries.end(), p_speed, [](float p_value, const Entry& p_entry) { return p_value < p_entry.speed; });
+	m_entries.insert(position, { &p_track, p_speed, 0.0f });
+
+	UpdateWeights();
+}
+
+uint32_t AnimationProgramming::Animation::SyncGroup::GetAnimationCount() const
+{
+	return static_cast<uint32_t>(m_entries.size());
+}
+
+float AnimationProgramming::Animation::SyncGroup::GetSpeed() const
+{
+	return m_speed;
+}
+
+void AnimationProgramming::Animation::SyncGroup::SetSpeed(float p_speed)
+{
+	m_speed = p_speed;
+	UpdateWeights();
+}
+
+float AnimationProgramming::Animation::SyncGroup::GetWeight(uint32_t p_index) const
+{
+	return m_entries[p_index].weight;
+}
+
+float AnimationProgramming::Animation::SyncGroup::GetPhase() const
+{
+	return m_phase;
+}
+
+void AnimationProgramming::Animation::SyncGroup::SetPhase(float p_phase)
+{
+	m_phase = p_phase - std::floor(p_phase);
+	if (m_phase >= 1.0f)
+		m_phase = 0.0f;
+}
+
+void AnimationProgramming::Animation::SyncGroup::Update(float p_deltaTime)
+{
+	/* Every animation would complete its cycle at its own rate : the group completes its cycle at the blended rate */
+	float phaseRate = 0.0f;
+
+	for (const Entry& entry : m_entries)
+	{
+		const float cycleDuration = entry.track->GetCycleDuration();
+		if (entry.weight > 0.0f && cycleDuration > 0.0f)
+			phaseRate += entry.weight * entry.track->GetAnimation().speedCoefficient / cycleDuration;
+	}
+
+	SetPhase(m_phase + p_deltaTime * phaseRate);
+}
+
+void AnimationProgramming::Animation::SyncGroup::Evaluate(std::vector<Data::Transformation>& p_pose)
+{
+	bool sampled = false;
+
+	for (const Entry& entry : m_entries)
+	{
+		if (entry.weight <= 0.0f)
+			continue;
+
+		const AnimationInstance& animation = entry.track->GetAnimation();
+		const float time = entry.track->GetTime(m_phase);
+
+		if (!sampled)
+		{
+			animation.SamplePose(time, p_pose);
+			sampled = true;
+			continue;
+		}
+
+		/* At most two animations have a weight : the second one is blended over the first one */
+		animation.SamplePose(time, m_entryPose);
+
+		const size_t boneCount = std::min(p_pose.size(), m_entryPose.size());
+		for (size_t bone = 0; bone < boneCount; ++bone)
+		{
+			p_pose[bone].first = Tools::SIMD::Lerp(p_pose[bone].first, m_entryPose[bone].first, entry.weight);
+			p_pose[bone].second = Tools::SIMD::Slerp(p_pose[bone].second, m_entryPose[bone].second, entry.weight);
+		}
+	}
+}
+
+void AnimationProgramming::Animation::SyncGroup::UpdateWeights()
+{
+	for (Entry& entry : m_entries)
+		entry.weight = 0.0f;
+
+	if (m_entries.empty())
+		return;
+
+	if (m_speed <= m_entries.front().speed)
+	{
+		m_entries.front().weight = 1.0f;
+		return;
+	}
+
+	if (m_speed >= m_entries.back().speed)
+	{
+		m_entries.back().weight = 1.0f;
+		return;
+	}
+
+	/* The two animations surrounding the speed share the weight linearly */
+	for (size_t i = 0; i + 1 < m_entries.size(); ++i)
+	{
+		Entry& slower = m_entries[i];
+		Entry& faster = m_entries[i + 1];
+
+		if (m_speed < faster.speed)
+		{
+			faster.weight = (m_speed - slower.speed) / (faster.speed - slower.speed);
+			slower.weight = 1.0f - faster.weight;
+			return;
+		}
+	}
+}
+
+void AnimationProgramming::Animation::SyncGroup::SaveSnapshot(Tools::Snapshot& p_snapshot) const
+{
+	p_snapshot.Write(m_speed);
+	p_snapshot.Write(m_phase);
+}
+
+void AnimationProgramming::Animation::SyncGroup::RestoreSnapshot(Tools::Snapshot& p_snapshot)
+{
+	p_snapshot.Read(m_speed);
+	p_snapshot.Read(m_phase);
+	UpdateWeights();
+}
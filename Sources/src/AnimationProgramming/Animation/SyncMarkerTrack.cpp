@@ -0,0 +1,167 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "AnimationProgramming/Animation/SyncMarkerTrack.h"
+
+namespace
+{
+	float WrapTime(float p_time, float p_duration)
+	{
+		if (p_duration <= 0.0f)
+			return 0.0f;
+
+		const float time = std::fmod(p_time, p_duration);
+		return time < 0.0f ? time + p_duration : time;
+	}
+
+	float WrapPhase(float p_phase)
+	{
+		const float phase = p_phase - std::floor(p_phase);
+		return phase < 1.0f ? phase : 0.0f;
+	}
+
+	/**
+	* Return the time (Of the keys of the animation) where the given bone is the lowest along p_upAxis
+	*/
+	float FindLowestTime(AnimationProgramming::Rig::Skeleton& p_skeleton, const AnimationProgramming::Animation::AnimationInstance& p_animation, uint32_t p_bone, const AltMath::Vector3f& p_upAxis)
+	{
+		std::vector<AnimationProgramming::Data::Transformation> pose;
+		float lowestTime = 0.0f;
+		float lowestHeight = 0.0f;
+
+		for (uint32_t key = 0; key < p_animation.GetKeyCount(); ++key)
+		{
+			const float time = static_cast<float>(key) * p_animation.frameDuration;
+			p_animation.SamplePose(time, pose);
+
+			const AnimationProgramming::Data::Matrix3x4 world = p_skeleton.CalculateWorldMatrix(p_bone, pose);
+			const float height = AltMath::Vector3f::DotProduct(AltMath::Vector3f(world.elements[3], world.elements[7], world.elements[11]), p_upAxis);
+
+			if (key == 0 || height < lowestHeight)
+			{
+				lowestHeight = height;
+				lowestTime = time;
+			}
+		}
+
+		return lowestTime;
+	}
+}
+
+AnimationProgramming::Animation::SyncMarkerTrack::SyncMarkerTrack(const AnimationInstance& p_animation) :
+	m_animation(p_animation),
+	m_duration(p_animation.GetDuration())
+{
+	BuildPhaseTable();
+}
+
+AnimationProgramming::Animation::SyncMarkerTrack AnimationProgramming::Animation::SyncMarkerTrack::CreateFromFootContacts(Rig::Skeleton& p_skeleton, const AnimationInstance& p_animation, uint32_t p_leftFootBone, uint32_t p_rightFootBone, const AltMath::Vector3f& p_upAxis)
+{
+	SyncMarkerTrack track(p_animation);
+	track.AddMarker(LeftFootDown, FindLowestTime(p_skeleton, p_animation, p_leftFootBone, p_upAxis));
+	track.AddMarker(RightFootDown, FindLowestTime(p_skeleton, p_animation, p_rightFootBone, p_upAxis));
+	track.BuildPhaseTable(LeftFootDown);
+	return track;
+}
+
+void AnimationProgramming::Animation::SyncMarkerTrack::AddMarker(const std::string& p_name, float p_time)
+{
+	const float time = WrapTime(p_time, m_duration);
+	auto position = std::upper_bound(m_markers.begin(), m_markers.end(), time, [](float p_value, const Marker& p_marker) { return p_value < p_marker.time; });
+	m_markers.insert(position, { p_name, time });
+}
+
+const std::vector<AnimationProgramming::Animation::SyncMarkerTrack::Marker>& AnimationProgramming::Animation::SyncMarkerTrack::GetMarkers() const
+{
+	return m_markers;
+}
+
+void AnimationProgramming::Animation::SyncMarkerTrack::BuildPhaseTable(const std::string& p_originMarker, uint32_t p_tableSize)
+{
+	auto origin = std::find_if(m_markers.begin(), m_markers.end(), [&p_originMarker](const Marker& p_marker) { return p_marker.name == p_originMarker; });
+	m_originMarker = origin != m_markers.end() ? static_cast<uint32_t>(origin - m_markers.begin()) : 0;
+
+	/* One more entry than the table size : the last one closes the cycle, so that the lookup never wraps */
+	const uint32_t tableSize = std::max(p_tableSize, 1u);
+	m_phaseTable.resize(tableSize + 1);
+
+	for (uint32_t i = 0; i <= tableSize; ++i)
+		m_phaseTable[i] = CalculateTime(static_cast<float>(i) / static_cast<float>(tableSize));
+}
+
+const AnimationProgramming::Animation::AnimationInstance& AnimationProgramming::Animation::SyncMarkerTrack::GetAnimation() const
+{
+	return m_animation;
+}
+
+float AnimationProgramming::Animation::SyncMarkerTrack::GetCycleDuration() const
+{
+	return m_duration;
+}
+
+float AnimationProgramming::Animation::SyncMarkerTrack::GetTime(float p_phase) const
+{
+	const uint32_t tableSize = static_cast<uint32_t>(m_phaseTable.size()) - 1;
+	const float position = WrapPhase(p_phase) * static_cast<float>(tableSize);
+	const uint32_t index = std::min(static_cast<uint32_t>(position), tableSize - 1);
+	const float alpha = position - static_cast<float>(index);
+
+	return WrapTime(m_phaseTable[index] + (m_phaseTable[index + 1] - m_phaseTable[index]) * alpha, m_duration);
+}
+
+float AnimationProgramming::Animation::SyncMarkerTrack::GetPhase(float p_time) const
+{
+	const uint32_t markerCount = static_cast<uint32_t>(m_markers.size());
+
+	if (markerCount == 0 || m_duration <= 0.0f)
+		return m_duration > 0.0f ? WrapTime(p_time, m_duration) / m_duration : 0.0f;
+
+	/* The time relative to the origin marker, in [0, duration[ */
+	const float originTime = m_markers[m_originMarker].time;
+	const float time = WrapTime(p_time - originTime, m_duration);
+
+	for (uint32_t segment = 0; segment < markerCount; ++segment)
+	{
+		const uint32_t next = segment + 1;
+		const float segmentStart = WrapTime(m_markers[(m_originMarker + segment) % markerCount].time - originTime, m_duration);
+		const float segmentEnd = next < markerCount ? WrapTime(m_markers[(m_originMarker + next) % markerCount].time - originTime, m_duration) : m_duration;
+
+		if (time < segmentEnd || next == markerCount)
+		{
+			const float alpha = segmentEnd > segmentStart ? (time - segmentStart) / (segmentEnd - segmentStart) : 0.0f;
+			return WrapPhase((static_cast<float>(segment) + std::clamp(alpha, 0.0f, 1.0f)) / static_cast<float>(markerCount));
+		}
+	}
+
+	return 0.0f;
+}
+
+float AnimationProgramming::Animation::SyncMarkerTrack::CalculateTime(float p_phase) const
+{
+	const uint32_t markerCount = static_cast<uint32_t>(m_markers.size());
+
+	if (markerCount == 0)
+		return p_phase * m_duration;
+
+	/* The phase k / markerCount is the k-th marker after the origin, the times are unwrapped (A marker before the origin is one cycle later) */
+	auto markerTime = [this, markerCount](uint32_t p_offset)
+	{
+		const uint32_t index = m_originMarker + p_offset;
+		return m_markers[index % markerCount].time + m_duration * static_cast<float>(index / markerCount);
+	};
+
+	const float position = p_phase * static_cast<float>(markerCount);
+	const uint32_t segment = std::min(static_cast<uint32_t>(position), markerCount - 1);
+	const float alpha = position - static_cast<float>(segment);
+
+	const float start = markerTime(segment);
+	const float end = markerTime(segment + 1);
+
+	return start + (end - start) * alpha;
+}
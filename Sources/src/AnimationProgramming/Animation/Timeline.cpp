@@ -4,6 +4,8 @@
 * @version 1.0
 */
 
+#include <algorithm>
+
 #include "AnimationProgramming/Animation/Timeline.h"
 #include "AnimationProgramming/Tools/IniManager.h"
 #include "AnimationProgramming/Rendering/Renderer.h"
@@ -15,10 +17,10 @@ AnimationProgramming::Animation::Timeline::Timeline()
 
 void AnimationProgramming::Animation::Timeline::InitializeEffectors()
 {
-	m_effectors[ETimelineEffector::REWIND] = Tools::IniManager::Timeline->Get<bool>("rewind_effector");
-	m_effectors[ETimelineEffector::IGNORE_LOOPING] = Tools::IniManager::Timeline->Get<bool>("ignore_transitioning_effector");
-	m_effectors[ETimelineEffector::IGNORE_TRANSITIONING] = Tools::IniManager::Timeline->Get<bool>("ignore_looping_effector");
-	m_effectors[ETimelineEffector::IGNORE_FRAME_INTERPOLATION] = Tools::IniManager::Timeline->Get<bool>("ignore_frame_interpolation_effector");
+	SetEffector(ETimelineEffector::REWIND, Tools::IniManager::Timeline->Get<bool>("rewind_effector"));
+	SetEffector(ETimelineEffector::IGNORE_LOOPING, Tools::IniManager::Timeline->Get<bool>("ignore_transitioning_effector"));
+	SetEffector(ETimelineEffector::IGNORE_TRANSITIONING, Tools::IniManager::Timeline->Get<bool>("ignore_looping_effector"));
+	SetEffector(ETimelineEffector::IGNORE_FRAME_INTERPOLATION, Tools::IniManager::Timeline->Get<bool>("ignore_frame_interpolation_effector"));
 }
 
 bool AnimationProgramming::Animation::Timeline::IsPlaying() const
@@ -38,12 +40,12 @@ bool AnimationProgramming::Animation::Timeline::IsPaused() const
 
 bool AnimationProgramming::Animation::Timeline::IsReversed() const
 {
-	return m_effectors.at(ETimelineEffector::REWIND) ? !m_reverse : m_reverse;
+	return GetEffector(ETimelineEffector::REWIND) ? !m_reverse : m_reverse;
 }
 
 bool AnimationProgramming::Animation::Timeline::IsLooping() const
 {
-	return m_loop && !m_effectors.at(ETimelineEffector::IGNORE_LOOPING);
+	return m_loop && !GetEffector(ETimelineEffector::IGNORE_LOOPING);
 }
 
 bool AnimationProgramming::Animation::Timeline::IsLastKeyFrame(bool p_ignorePlayingDirection) const
@@ -58,17 +60,19 @@ bool AnimationProgramming::Animation::Timeline::IsFirstKeyFrame(bool p_ignorePla
 
 void AnimationProgramming::Animation::Timeline::SetEffector(ETimelineEffector p_effector, bool p_state)
 {
-	m_effectors[p_effector] = p_state;
+	const uint32_t flag = 1u << static_cast<uint32_t>(p_effector);
+
+	m_effectors = p_state ? m_effectors | flag : m_effectors & ~flag;
 }
 
 bool AnimationProgramming::Animation::Timeline::GetEffector(ETimelineEffector p_effector) const
 {
-	return m_effectors.at(p_effector);
+	return (m_effectors & (1u << static_cast<uint32_t>(p_effector))) != 0;
 }
 
 void AnimationProgramming::Animation::Timeline::ToggleEffector(ETimelineEffector p_effector)
 {
-	SetEffector(p_effector, !m_effectors[p_effector]);
+	SetEffector(p_effector, !GetEffector(p_effector));
 }
 
 uint32_t AnimationProgramming::Animation::Timeline::GetCurrentKeyFrame() const
@@ -132,10 +136,23 @@ void AnimationProgramming::Animation::Timeline::SyncToAnimation(const Animation:
 void AnimationProgramming::Animation::Timeline::Reset()
 {
 	m_currentKeyFrame = m_startKeyFrame;
+	m_hasEntryKeyFrame = false;
 	m_frameTimer = 0.0f;
 	m_transitionTimer = 0.0f;
 }
 
+uint32_t AnimationProgramming::Animation::Timeline::GetEntryKeyFrame() const
+{
+	return m_hasEntryKeyFrame ? m_entryKeyFrame : GetFirstKeyFrame();
+}
+
+void AnimationProgramming::Animation::Timeline::SetEntryKeyFrame(uint32_t p_keyFrame)
+{
+	m_entryKeyFrame = std::clamp(p_keyFrame, m_startKeyFrame, m_endKeyFrame);
+	m_hasEntryKeyFrame = true;
+	m_currentKeyFrame = m_entryKeyFrame;
+}
+
 void AnimationProgramming::Animation::Timeline::Play()
 {
 	m_currentState = ETimelineState::PLAYING;
@@ -143,9 +160,9 @@ void AnimationProgramming::Animation::Timeline::Play()
 
 void AnimationProgramming::Animation::Timeline::PlayTransition(float p_duration)
 {
-	if (!m_effectors[ETimelineEffector::IGNORE_TRANSITIONING])
+	if (!GetEffector(ETimelineEffector::IGNORE_TRANSITIONING))
 	{
-		m_currentKeyFrame = GetFirstKeyFrame();
+		m_currentKeyFrame = GetEntryKeyFrame();
 		m_transitionTimer = 0.0f;
 		m_transitionDuration = p_duration;
 		m_currentState = ETimelineState::TRANSITIONING;
@@ -174,7 +191,7 @@ void AnimationProgramming::Animation::Timeline::TogglePause()
 
 float AnimationProgramming::Animation::Timeline::CalculateInterpolationAlpha() const
 {
-	if (m_effectors.at(ETimelineEffector::IGNORE_FRAME_INTERPOLATION))
+	if (GetEffector(ETimelineEffector::IGNORE_FRAME_INTERPOLATION))
 		return 0.0f;
 
 	switch (m_currentState)
@@ -211,7 +228,7 @@ void AnimationProgramming::Animation::Timeline::UpdatePlayingState(float p_delta
 		GoToNextKeyFrame();
 
 		/* If we arrived at last frame and the animation shouldn't loop, we pause */
-		if (IsLastKeyFrame() && (!m_loop || m_effectors[ETimelineEffector::IGNORE_LOOPING]))
+		if (IsLastKeyFrame() && (!m_loop || GetEffector(ETimelineEffector::IGNORE_LOOPING)))
 			Pause();
 	}
 }
@@ -225,4 +242,40 @@ void AnimationProgramming::Animation::Timeline::UpdateTransitioningState(float p
 		Play();
 		FrameChangedEvent.Invoke();
 	}
+}
+
+void AnimationProgramming::Animation::Timeline::SaveSnapshot(Tools::Snapshot& p_snapshot) const
+{
+	p_snapshot.Write(m_currentKeyFrame);
+	p_snapshot.Write(m_startKeyFrame);
+	p_snapshot.Write(m_endKeyFrame);
+	p_snapshot.Write(m_entryKeyFrame);
+	p_snapshot.Write(m_hasEntryKeyFrame);
+	p_snapshot.Write(m_frameTimer);
+	p_snapshot.Write(m_frameDuration);
+	p_snapshot.Write(m_transitionTimer);
+	p_snapshot.Write(m_transitionDuration);
+	p_snapshot.Write(m_loop);
+	p_snapshot.Write(m_reverse);
+	p_snapshot.Write(m_pausePreviousState);
+	p_snapshot.Write(m_currentState);
+	p_snapshot.Write(m_effectors);
+}
+
+void AnimationProgramming::Animation::Timeline::RestoreSnapshot(Tools::Snapshot& p_snapshot)
+{
+	p_snapshot.Read(m_currentKeyFrame);
+	p_snapshot.Read(m_startKeyFrame);
+	p_snapshot.Read(m_endKeyFrame);
+	p_snapshot.Read(m_entryKeyFrame);
+	p_snapshot.Read(m_hasEntryKeyFrame);
+	p_snapshot.Read(m_frameTimer);
+	p_snapshot.Read(m_frameDuration);
+	p_snapshot.Read(m_transitionTimer);
+	p_snapshot.Read(m_transitionDuration);
+	p_snapshot.Read(m_loop);
+	p_snapshot.Read(m_reverse);
+	p_snapshot.Read(m_pausePreviousState);
+	p_snapshot.Read(m_currentState);
+	p_snapshot.Read(m_effectors);
 }
\ No newline at end of file
@@ -0,0 +1,298 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+#include "AnimationProgramming/Animation/TransitionIndex.h"
+
+namespace
+{
+	/* Identifies a cache file of transition index, and the version of its layout */
+	constexpr uint32_t kCacheMagic = 0x49545041;
+	constexpr uint32_t kCacheVersion = 1;
+
+	/* Number of source keys processed by a thread pool task */
+	constexpr uint32_t kKeysPerChunk = 8;
+
+	/* FNV-1a */
+	constexpr uint64_t kHashOffset = 14695981039346656037ull;
+	constexpr uint64_t kHashPrime = 1099511628211ull;
+
+	uint64_t HashBytes(uint64_t p_hash, const void* p_data, size_t p_size)
+	{
+		const unsigned char* bytes = static_cast<const unsigned char*>(p_data);
+
+		for (size_t i = 0; i < p_size; ++i)
+			p_hash = (p_hash ^ bytes[i]) * kHashPrime;
+
+		return p_hash;
+	}
+
+	template <typename T>
+	void Write(std::ofstream& p_stream, const T& p_value)
+	{
+		p_stream.write(reinterpret_cast<const char*>(&p_value), sizeof(T));
+	}
+
+	template <typename T>
+	bool Read(std::ifstream& p_stream, T& p_value)
+	{
+		return static_cast<bool>(p_stream.read(reinterpret_cast<char*>(&p_value), sizeof(T)));
+	}
+}
+
+void AnimationProgramming::Animation::TransitionIndex::Build(const Rig::SkeletonDefinition& p_definition, const std::vector<const AnimationInstance*>& p_clips, Tools::ThreadPool* p_threadPool, float p_velocityWeight)
+{
+	ExtractFeatures(p_definition, p_clips, p_threadPool);
+	m_signature = CalculateSignature(p_velocityWeight);
+	FindEntryKeys(p_threadPool, p_velocityWeight);
+
+	m_features.clear();
+	m_features.shrink_to_fit();
+}
+
+bool AnimationProgramming::Animation::TransitionIndex::LoadOrBuild(const std::string& p_cachePath, const Rig::SkeletonDefinition& p_definition, const std::vector<const AnimationInstance*>& p_clips, Tools::ThreadPool* p_threadPool, float p_velocityWeight)
+{
+	/* The features are cheap (Linear in the number of keys) : they identify the content of the cache */
+	ExtractFeatures(p_definition, p_clips, p_threadPool);
+	m_signature = CalculateSignature(p_velocityWeight);
+
+	const bool loaded = Load(p_cachePath, m_signature);
+
+	if (!loaded)
+	{
+		FindEntryKeys(p_threadPool, p_velocityWeight);
+		Save(p_cachePath);
+	}
+
+	m_features.clear();
+	m_features.shrink_to_fit();
+
+	return loaded;
+}
+
+bool AnimationProgramming::Animation::TransitionIndex::Save(const std::string& p_path) const
+{
+	std::ofstream file(p_path, std::ios::binary | std::ios::trunc);
+
+	if (!file)
+		return false;
+
+	Write(file, kCacheMagic);
+	Write(file, kCacheVersion);
+	Write(file, m_signature);
+	Write(file, GetClipCount());
+	Write(file, static_cast<uint32_t>(m_entryKeys.size()));
+	file.write(reinterpret_cast<const char*>(m_entryKeys.data()), m_entryKeys.size() * sizeof(uint32_t));
+
+	return static_cast<bool>(file);
+}
+
+uint32_t AnimationProgramming::Animation::TransitionIndex::GetClipCount() const
+{
+	return static_cast<uint32_t>(m_clips.size());
+}
+
+uint32_t AnimationProgramming::Animation::TransitionIndex::FindClip(const AnimationInstance& p_clip) const
+{
+	auto found = std::find(m_clips.begin(), m_clips.end(), &p_clip);
+	return found != m_clips.end() ? static_cast<uint32_t>(found - m_clips.begin()) : std::numeric_limits<uint32_t>::max();
+}
+
+uint32_t AnimationProgramming::Animation::TransitionIndex::GetEntryKey(uint32_t p_sourceClip, uint32_t p_sourceKey, uint32_t p_targetClip) const
+{
+	const uint32_t sourceKey = std::min(m_clipFirstKeys[p_sourceClip] + p_sourceKey, m_clipFirstKeys[p_sourceClip + 1] - 1);
+	return m_entryKeys[static_cast<size_t>(sourceKey) * m_clips.size() + p_targetClip];
+}
+
+bool AnimationProgramming::Animation::TransitionIndex::FindEntryKey(const AnimationInstance& p_source, uint32_t p_sourceKey, const AnimationInstance& p_target, uint32_t& p_entryKey) const
+{
+	const uint32_t sourceClip = FindClip(p_source);
+	const uint32_t targetClip = FindClip(p_target);
+
+	if (sourceClip >= GetClipCount() || targetClip >= GetClipCount() || m_entryKeys.empty())
+		return false;
+
+	p_entryKey = GetEntryKey(sourceClip, p_sourceKey, targetClip);
+	return true;
+}
+
+void AnimationProgramming::Animation::TransitionIndex::ExtractFeatures(const Rig::SkeletonDefinition& p_definition, const std::vector<const AnimationInstance*>& p_clips, Tools::ThreadPool* p_threadPool)
+{
+	const uint32_t boneCount = p_definition.GetBoneCount();
+
+	m_clips = p_clips;
+	m_clipFirstKeys.assign(1, 0);
+	for (const AnimationInstance* clip : m_clips)
+		m_clipFirstKeys.push_back(m_clipFirstKeys.back() + clip->GetKeyCount());
+
+	m_featureSize = 6 * boneCount;
+	m_features.assign(static_cast<size_t>(m_clipFirstKeys.back()) * m_featureSize, 0.0f);
+
+	auto extractClips = [this, &p_definition, boneCount](uint32_t p_begin, uint32_t p_end)
+	{
+		std::vector<Data::Transformation> pose;
+		std::vector<Data::Matrix3x4> modelMatrices;
+		std::vector<AltMath::Vector3f> positions;
+
+		for (uint32_t clipIndex = p_begin; clipIndex < p_end; ++clipIndex)
+		{
+			const AnimationInstance& clip = *m_clips[clipIndex];
+			const AnimationInfo& animation = clip.attachedAnimation;
+			const uint32_t keyCount = clip.GetKeyCount();
+
+			/* Positions of every bone in the space of the root bone, for every key */
+			positions.resize(static_cast<size_t>(keyCount) * boneCount);
+			pose.resize(animation.GetBonesCount());
+
+			for (uint32_t key = 0; key < keyCount; ++key)
+			{
+				for (uint32_t bone = 0; bone < pose.size(); ++bone)
+					pose[bone] = animation.GetBoneTransformations(bone, animation.GetStartKey() + key);
+
+				p_definition.CalculateModelMatrices(pose, modelMatrices);
+				const Data::Matrix3x4 inverseRoot = modelMatrices[0].RigidInverse();
+
+				for (uint32_t bone = 0; bone < boneCount; ++bone)
+				{
+					const Data::Matrix3x4 world = inverseRoot * modelMatrices[bone];
+					positions[static_cast<size_t>(key) * boneCount + bone] = AltMath::Vector3f(world.elements[3], world.elements[7], world.elements[11]);
+				}
+			}
+
+			/* Velocities in the playing direction : towards the next key (Wrapped if the clip loops), or from the previous key at the end of the clip */
+			const int32_t step = clip.reverse ? -1 : 1;
+
+			for (uint32_t key = 0; key < keyCount; ++key)
+			{
+				float* features = m_features.data() + static_cast<size_t>(m_clipFirstKeys[clipIndex] + key) * m_featureSize;
+
+				const int32_t next = static_cast<int32_t>(key) + step;
+				const bool nextInClip = next >= 0 && next < static_cast<int32_t>(keyCount);
+				uint32_t from = key;
+				uint32_t to = key;
+
+				if (nextInClip || clip.loop)
+					to = static_cast<uint32_t>((next + static_cast<int32_t>(keyCount)) % static_cast<int32_t>(keyCount));
+				else if (keyCount > 1)
+					from = static_cast<uint32_t>(static_cast<int32_t>(key) - step);
+
+				for (uint32_t bone = 0; bone < boneCount; ++bone)
+				{
+					const AltMath::Vector3f& position = positions[static_cast<size_t>(key) * boneCount + bone];
+					const AltMath::Vector3f velocity = (positions[static_cast<size_t>(to) * boneCount + bone] - positions[static_cast<size_t>(from) * boneCount + bone]) / clip.frameDuration;
+
+					features[3 * bone] = position.x;
+					features[3 * bone + 1] = position.y;
+					features[3 * bone + 2] = position.z;
+					features[3 * (boneCount + bone)] = velocity.x;
+					features[3 * (boneCount + bone) + 1] = velocity.y;
+					features[3 * (boneCount + bone) + 2] = velocity.z;
+				}
+			}
+		}
+	};
+
+	if (p_threadPool)
+		p_threadPool->ParallelFor(GetClipCount(), 1, extractClips);
+	else
+		extractClips(0, GetClipCount());
+}
+
+uint64_t AnimationProgramming::Animation::TransitionIndex::CalculateSignature(float p_velocityWeight) const
+{
+	uint64_t hash = kHashOffset;
+
+	hash = HashBytes(hash, &p_velocityWeight, sizeof(float));
+	hash = HashBytes(hash, m_clipFirstKeys.data(), m_clipFirstKeys.size() * sizeof(uint32_t));
+	hash = HashBytes(hash, &m_featureSize, sizeof(uint32_t));
+	hash = HashBytes(hash, m_features.data(), m_features.size() * sizeof(float));
+
+	return hash;
+}
+
+void AnimationProgramming::Animation::TransitionIndex::FindEntryKeys(Tools::ThreadPool* p_threadPool, float p_velocityWeight)
+{
+	const uint32_t clipCount = GetClipCount();
+	const uint32_t totalKeyCount = m_clipFirstKeys.back();
+	const uint32_t positionSize = m_featureSize / 2;
+
+	m_entryKeys.assign(static_cast<size_t>(totalKeyCount) * clipCount, 0);
+
+	/* Every source key is a row of the distance matrices : it is compared to every key of every clip, and only the best key of each clip is kept */
+	auto findRows = [this, clipCount, positionSize, p_velocityWeight](uint32_t p_begin, uint32_t p_end)
+	{
+		for (uint32_t sourceKey = p_begin; sourceKey < p_end; ++sourceKey)
+		{
+			const float* source = m_features.data() + static_cast<size_t>(sourceKey) * m_featureSize;
+
+			for (uint32_t targetClip = 0; targetClip < clipCount; ++targetClip)
+			{
+				float bestDistance = std::numeric_limits<float>::max();
+				uint32_t bestKey = 0;
+
+				for (uint32_t targetKey = m_clipFirstKeys[targetClip]; targetKey < m_clipFirstKeys[targetClip + 1]; ++targetKey)
+				{
+					const float* target = m_features.data() + static_cast<size_t>(targetKey) * m_featureSize;
+					float positionDistance = 0.0f;
+					float velocityDistance = 0.0f;
+
+					for (uint32_t i = 0; i < positionSize; ++i)
+					{
+						const float offset = source[i] - target[i];
+						positionDistance += offset * offset;
+					}
+
+					for (uint32_t i = positionSize; i < m_featureSize; ++i)
+					{
+						const float offset = source[i] - target[i];
+						velocityDistance += offset * offset;
+					}
+
+					const float distance = positionDistance + p_velocityWeight * velocityDistance;
+
+					if (distance < bestDistance)
+					{
+						bestDistance = distance;
+						bestKey = targetKey - m_clipFirstKeys[targetClip];
+					}
+				}
+
+				m_entryKeys[static_cast<size_t>(sourceKey) * clipCount + targetClip] = bestKey;
+			}
+		}
+	};
+
+	if (p_threadPool)
+		p_threadPool->ParallelFor(totalKeyCount, kKeysPerChunk, findRows);
+	else
+		findRows(0, totalKeyCount);
+}
+
+bool AnimationProgramming::Animation::TransitionIndex::Load(const std::string& p_path, uint64_t p_signature)
+{
+	std::ifstream file(p_path, std::ios::binary);
+
+	uint32_t magic = 0, version = 0, clipCount = 0, entryCount = 0;
+	uint64_t signature = 0;
+
+	if (!file || !Read(file, magic) || !Read(file, version) || !Read(file, signature) || !Read(file, clipCount) || !Read(file, entryCount))
+		return false;
+
+	const size_t expectedEntryCount = static_cast<size_t>(m_clipFirstKeys.back()) * m_clips.size();
+
+	if (magic != kCacheMagic || version != kCacheVersion || signature != p_signature || clipCount != GetClipCount() || entryCount != expectedEntryCount)
+		return false;
+
+	std::vector<uint32_t> entryKeys(entryCount);
+	if (!file.read(reinterpret_cast<char*>(entryKeys.data()), entryKeys.size() * sizeof(uint32_t)))
+		return false;
+
+	m_entryKeys = std::move(entryKeys);
+	return true;
+}
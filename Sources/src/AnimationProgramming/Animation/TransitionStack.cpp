@@ -0,0 +1,194 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "AnimationProgramming/Animation/TransitionStack.h"
+#include "AnimationProgramming/Tools/SIMD.h"
+
+AnimationProgramming::Animation::TransitionStack::TransitionStack(uint32_t p_maxSampledAnimations) :
+	m_maxSampledAnimations(std::max(p_maxSampledAnimations, 1u))
+{
+}
+
+uint32_t AnimationProgramming::Animation::TransitionStack::GetMaxSampledAnimations() const
+{
+	return m_maxSampledAnimations;
+}
+
+void AnimationProgramming::Animation::TransitionStack::SetMaxSampledAnimations(uint32_t p_maxSampledAnimations)
+{
+	m_maxSampledAnimations = std::max(p_maxSampledAnimations, 1u);
+}
+
+void AnimationProgramming::Animation::TransitionStack::Push(const AnimationInstance& p_animation, float p_transitionDuration, float p_startTime)
+{
+	if (p_transitionDuration <= 0.0f)
+		m_entries.clear();
+
+	/* Keep room for the new animation : the oldest entries are blended into a frozen pose until the cap is respected */
+	while (!m_entries.empty() && GetSampledAnimationCount() + 1 > m_maxSampledAnimations)
+	{
+		Entry frozen;
+
+		if (m_entries.size() > 1)
+			BlendEntries(0, 2, frozen.frozenPose);
+		else
+			SampleEntry(m_entries.front(), frozen.frozenPose);
+
+		m_entries.erase(m_entries.begin(), m_entries.begin() + std::min<size_t>(m_entries.size(), 2));
+		m_entries.insert(m_entries.begin(), std::move(frozen));
+	}
+
+	Entry entry;
+	entry.animation = &p_animation;
+	entry.time = p_startTime;
+	entry.duration = std::max(p_transitionDuration, 0.0f);
+	m_entries.push_back(std::move(entry));
+}
+
+void AnimationProgramming::Animation::TransitionStack::PushPose(const std::vector<Data::Transformation>& p_pose)
+{
+	Entry entry;
+	entry.frozenPose = p_pose;
+	m_entries.push_back(std::move(entry));
+}
+
+void AnimationProgramming::Animation::TransitionStack::Clear()
+{
+	m_entries.clear();
+}
+
+bool AnimationProgramming::Animation::TransitionStack::IsEmpty() const
+{
+	return m_entries.empty();
+}
+
+bool AnimationProgramming::Animation::TransitionStack::IsTransitioning() const
+{
+	return m_entries.size() > 1;
+}
+
+uint32_t AnimationProgramming::Animation::TransitionStack::GetEntryCount() const
+{
+	return static_cast<uint32_t>(m_entries.size());
+}
+
+uint32_t AnimationProgramming::Animation::TransitionStack::GetSampledAnimationCount() const
+{
+	return static_cast<uint32_t>(std::count_if(m_entries.begin(), m_entries.end(), [](const Entry& p_entry) { return p_entry.animation != nullptr; }));
+}
+
+void AnimationProgramming::Animation::TransitionStack::Update(float p_deltaTime)
+{
+	for (Entry& entry : m_entries)
+	{
+		entry.elapsed += p_deltaTime;
+
+		if (entry.animation)
+		{
+			entry.time += p_deltaTime * entry.animation->speedCoefficient;
+
+			/* Keep the time small, to keep its precision */
+			if (entry.animation->loop)
+				entry.time = std::fmod(entry.time, entry.animation->GetDuration());
+			else
+				entry.time = std::min(entry.time, entry.animation->GetDuration());
+		}
+	}
+
+	Collapse();
+}
+
+void AnimationProgramming::Animation::TransitionStack::Evaluate(std::vector<Data::Transformation>& p_pose)
+{
+	if (!m_entries.empty())
+		BlendEntries(0, m_entries.size(), p_pose);
+}
+
+void AnimationProgramming::Animation::TransitionStack::SaveSnapshot(Tools::Snapshot& p_snapshot) const
+{
+	p_snapshot.Write(m_maxSampledAnimations);
+	p_snapshot.Write(static_cast<uint32_t>(m_entries.size()));
+
+	for (const Entry& entry : m_entries)
+	{
+		p_snapshot.Write(entry.animation);
+		p_snapshot.Write(entry.time);
+		p_snapshot.Write(entry.elapsed);
+		p_snapshot.Write(entry.duration);
+		p_snapshot.WriteArray(entry.frozenPose);
+	}
+}
+
+void AnimationProgramming::Animation::TransitionStack::RestoreSnapshot(Tools::Snapshot& p_snapshot)
+{
+	uint32_t entryCount = 0;
+
+	p_snapshot.Read(m_maxSampledAnimations);
+	p_snapshot.Read(entryCount);
+
+	m_entries.resize(entryCount);
+
+	for (Entry& entry : m_entries)
+	{
+		p_snapshot.Read(entry.animation);
+		p_snapshot.Read(entry.time);
+		p_snapshot.Read(entry.elapsed);
+		p_snapshot.Read(entry.duration);
+		p_snapshot.ReadArray(entry.frozenPose);
+	}
+}
+
+float AnimationProgramming::Animation::TransitionStack::Entry::GetWeight() const
+{
+	return duration > 0.0f ? std::min(elapsed / duration, 1.0f) : 1.0f;
+}
+
+void AnimationProgramming::Animation::TransitionStack::SampleEntry(const Entry& p_entry, std::vector<Data::Transformation>& p_pose) const
+{
+	if (!p_entry.animation)
+	{
+		p_pose = p_entry.frozenPose;
+		return;
+	}
+
+	p_entry.animation->SamplePose(p_entry.time, p_pose);
+}
+
+void AnimationProgramming::Animation::TransitionStack::BlendEntries(size_t p_begin, size_t p_end, std::vector<Data::Transformation>& p_pose)
+{
+	SampleEntry(m_entries[p_begin], p_pose);
+
+	/* Every entry fades in over the blended result of the entries below it */
+	for (size_t i = p_begin + 1; i < p_end; ++i)
+	{
+		SampleEntry(m_entries[i], m_entryPose);
+
+		const float weight = m_entries[i].GetWeight();
+		const size_t boneCount = std::min(p_pose.size(), m_entryPose.size());
+
+		for (size_t bone = 0; bone < boneCount; ++bone)
+		{
+			p_pose[bone].first = Tools::SIMD::Lerp(p_pose[bone].first, m_entryPose[bone].first, weight);
+			p_pose[bone].second = Tools::SIMD::Slerp(p_pose[bone].second, m_entryPose[bone].second, weight);
+		}
+	}
+}
+
+void AnimationProgramming::Animation::TransitionStack::Collapse()
+{
+	/* The newest fully faded-in entry hides every entry below it */
+	for (size_t i = m_entries.size(); i-- > 1;)
+	{
+		if (m_entries[i].GetWeight() >= 1.0f)
+		{
+			m_entries.erase(m_entries.begin(), m_entries.begin() + i);
+			return;
+		}
+	}
+}
@@ -0,0 +1,425 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <immintrin.h>
+
+#include "AnimationProgramming/Animation/TwoBoneIKSolver.h"
+#include "AnimationProgramming/Tools/SIMD.h"
+#include "AnimationProgramming/Tools/SIMDTarget.h"
+
+namespace
+{
+	constexpr uint32_t kLaneWidth = AnimationProgramming::Animation::TwoBoneIKSolver::LaneWidth;
+
+	/* Groups of requests solved by a thread at once */
+	constexpr uint32_t kGroupsPerChunk = 8;
+
+	/* The chain never gets fully straight or fully folded (Relative to its length) : the bend plane would be lost */
+	constexpr float kReachMargin = 1e-3f;
+
+	/* Below this squared sine (Relative to the squared lengths), two directions are considered parallel */
+	constexpr float kParallelThreshold = 1e-6f;
+
+	constexpr float kEpsilon = 1e-8f;
+
+	/**
+	* Requests and results of one group (Component c of the lane l is at [c * kLaneWidth + l])
+	*/
+	struct alignas(32) ChainLanes
+	{
+		float root[3 * kLaneWidth];
+		float joint[3 * kLaneWidth];
+		float end[3 * kLaneWidth];
+		float target[3 * kLaneWidth];
+		float bendAxis[3 * kLaneWidth];
+		float weight[kLaneWidth];
+		float rootRotation[4 * kLaneWidth];
+		float jointRotation[4 * kLaneWidth];
+	};
+
+	/**
+	* Return the cosine of the half of the angle of the given cosine (For an angle in [0, PI])
+	*/
+	float HalfCos(float p_cos)
+	{
+		return std::sqrt(std::max(0.0f, 0.5f + 0.5f * p_cos));
+	}
+
+	/**
+	* Return the sine of the half of the angle of the given cosine (For an angle in [0, PI])
+	*/
+	float HalfSin(float p_cos)
+	{
+		return std::sqrt(std::max(0.0f, 0.5f - 0.5f * p_cos));
+	}
+
+	float ClampCos(float p_cos)
+	{
+		return std::min(std::max(p_cos, -1.0f), 1.0f);
+	}
+
+	/**
+	* Weight the given rotation (xyzw) with a normalized lerp from the identity, and store it in the given lane
+	*/
+	void StoreWeightedRotation(const float* p_rotation, float p_weight, float* p_output, uint32_t p_lane)
+	{
+		/* The shortest path to the identity */
+		const float sign = p_rotation[3] < 0.0f ? -p_weight : p_weight;
+		const float x = sign * p_rotation[0];
+		const float y = sign * p_rotation[1];
+		const float z = sign * p_rotation[2];
+		const float w = 1.0f - p_weight + sign * p_rotation[3];
+		const float inverseLength = 1.0f / std::sqrt(x * x + y * y + z * z + w * w);
+
+		p_output[p_lane] = x * inverseLength;
+		p_output[kLaneWidth + p_lane] = y * inverseLength;
+		p_output[2 * kLaneWidth + p_lane] = z * inverseLength;
+		p_output[3 * kLaneWidth + p_lane] = w * inverseLength;
+	}
+
+	/**
+	* Solve the chains of one group, one lane after the other
+	*/
+	void SolveGroupScalar(ChainLanes& p_lanes)
+	{
+		for (uint32_t lane = 0; lane < kLaneWidth; ++lane)
+		{
+			auto read = [lane](const float* p_components, uint32_t p_component) { return p_components[p_component * kLaneWidth + lane]; };
+
+			float ab[3], bc[3], ac[3], at[3];
+
+			for (uint32_t c = 0; c < 3; ++c)
+			{
+				ab[c] = read(p_lanes.joint, c) - read(p_lanes.root, c);
+				bc[c] = read(p_lanes.end, c) - read(p_lanes.joint, c);
+				ac[c] = read(p_lanes.end, c) - read(p_lanes.root, c);
+				at[c] = read(p_lanes.target, c) - read(p_lanes.root, c);
+			}
+
+			auto dot = [](const float* p_left, const float* p_right) { return p_left[0] * p_right[0] + p_left[1] * p_right[1] + p_left[2] * p_right[2]; };
+
+			const float ab2 = dot(ab, ab);
+			const float bc2 = dot(bc, bc);
+			const float ac2 = dot(ac, ac);
+			const float at2 = dot(at, at);
+			const float abLength = std::sqrt(ab2);
+			const float bcLength = std::sqrt(bc2);
+			const float acLength = std::sqrt(ac2);
+			const float atLength = std::sqrt(at2);
+
+			/* Distance between the root and the end once solved */
+			const float minReach = std::fabs(abLength - bcLength) + kReachMargin * (abLength + bcLength);
+			const float maxReach = (abLength + bcLength) * (1.0f - kReachMargin);
+			const float reach = std::min(std::max(atLength, minReach), maxReach);
+
+			/* Current and wanted angles (At the root between the chain and the first bone, at the joint between the two bones) */
+			const float rootCos = ClampCos(dot(ac, ab) / std::max(acLength * abLength, kEpsilon));
+			const float jointCos = ClampCos(-dot(ab, bc) / std::max(abLength * bcLength, kEpsilon));
+			const float targetCos = ClampCos(dot(ac, at) / std::max(acLength * atLength, kEpsilon));
+			const float solvedRootCos = ClampCos((ab2 + reach * reach - bc2) / std::max(2.0f * abLength * reach, kEpsilon));
+			const float solvedJointCos = ClampCos((ab2 + bc2 - reach * reach) / std::max(2.0f * abLength * bcLength, kEpsilon));
+
+			/* Bend axis (Normal of the plane of the chain), and axis turning the chain toward the target */
+			float bend[3] = { ac[1] * ab[2] - ac[2] * ab[1], ac[2] * ab[0] - ac[0] * ab[2], ac[0] * ab[1] - ac[1] * ab[0] };
+			const float bend2 = dot(bend, bend);
+
+			if (bend2 > kParallelThreshold * ac2 * ab2)
+			{
+				for (uint32_t c = 0; c < 3; ++c)
+					bend[c] /= std::sqrt(bend2);
+			}
+			else
+			{
+				/* Straight chain : the given axis, made orthogonal to the chain */
+				float axis[3] = { read(p_lanes.bendAxis, 0), read(p_lanes.bendAxis, 1), read(p_lanes.bendAxis, 2) };
+				const float projection = dot(axis, ac) / std::max(ac2, kEpsilon);
+
+				for (uint32_t c = 0; c < 3; ++c)
+					bend[c] = axis[c] - projection * ac[c];
+
+				const float orthogonal2 = dot(bend, bend);
+
+				for (uint32_t c = 0; c < 3; ++c)
+					bend[c] = orthogonal2 > kEpsilon ? bend[c] / std::sqrt(orthogonal2) : axis[c];
+			}
+
+			float turn[3] = { ac[1] * at[2] - ac[2] * at[1], ac[2] * at[0] - ac[0] * at[2], ac[0] * at[1] - ac[1] * at[0] };
+			const float turn2 = dot(turn, turn);
+
+			for (uint32_t c = 0; c < 3; ++c)
+				turn[c] = turn2 > kParallelThreshold * ac2 * at2 ? turn[c] / std::sqrt(turn2) : bend[c];
+
+			/* Half angles of the differences between the wanted and the current angles : cos(a - b) and sin(a - b) from the half angles of a and b */
+			const float rootSin = HalfSin(solvedRootCos) * HalfCos(rootCos) - HalfCos(solvedRootCos) * HalfSin(rootCos);
+			const float rootW = HalfCos(solvedRootCos) * HalfCos(rootCos) + HalfSin(solvedRootCos) * HalfSin(rootCos);
+			const float jointSin = HalfSin(solvedJointCos) * HalfCos(jointCos) - HalfCos(solvedJointCos) * HalfSin(jointCos);
+			const float jointW = HalfCos(solvedJointCos) * HalfCos(jointCos) + HalfSin(solvedJointCos) * HalfSin(jointCos);
+			const float turnSin = HalfSin(targetCos);
+			const float turnW = HalfCos(targetCos);
+
+			/* rootRotation = turn * bendRoot (Both about axes going through the root) */
+			const float turnDotBend = dot(turn, bend);
+			float root[4];
+			root[0] = turnW * rootSin * bend[0] + rootW * turnSin * turn[0] + turnSin * rootSin * (turn[1] * bend[2] - turn[2] * bend[1]);
+			root[1] = turnW * rootSin * bend[1] + rootW * turnSin * turn[1] + turnSin * rootSin * (turn[2] * bend[0] - turn[0] * bend[2]);
+			root[2] = turnW * rootSin * bend[2] + rootW * turnSin * turn[2] + turnSin * rootSin * (turn[0] * bend[1] - turn[1] * bend[0]);
+			root[3] = turnW * rootW - turnSin * rootSin * turnDotBend;
+
+			/* jointRotation = rootRotation * bendJoint */
+			const float rootDotBend = dot(root, bend);
+			float joint[4];
+			joint[0] = root[3] * jointSin * bend[0] + jointW * root[0] + jointSin * (root[1] * bend[2] - root[2] * bend[1]);
+			joint[1] = root[3] * jointSin * bend[1] + jointW * root[1] + jointSin * (root[2] * bend[0] - root[0] * bend[2]);
+			joint[2] = root[3] * jointSin * bend[2] + jointW * root[2] + jointSin * (root[0] * bend[1] - root[1] * bend[0]);
+			joint[3] = root[3] * jointW - jointSin * rootDotBend;
+
+			/* Weighted with a normalized lerp from the identity */
+			StoreWeightedRotation(root, read(p_lanes.weight, 0), p_lanes.rootRotation, lane);
+			StoreWeightedRotation(joint, read(p_lanes.weight, 0), p_lanes.jointRotation, lane);
+		}
+	}
+
+	/**
+	* Three component lanes
+	*/
+	struct Vector3Lanes
+	{
+		__m256 x, y, z;
+	};
+
+	SIMD_TARGET_AVX2 inline Vector3Lanes Load3(const float* p_components)
+	{
+		return { _mm256_load_ps(p_components), _mm256_load_ps(p_components + kLaneWidth), _mm256_load_ps(p_components + 2 * kLaneWidth) };
+	}
+
+	SIMD_TARGET_AVX2 inline Vector3Lanes Subtract3(const Vector3Lanes& p_left, const Vector3Lanes& p_right)
+	{
+		return { _mm256_sub_ps(p_left.x, p_right.x), _mm256_sub_ps(p_left.y, p_right.y), _mm256_sub_ps(p_left.z, p_right.z) };
+	}
+
+	SIMD_TARGET_AVX2 inline __m256 Dot3(const Vector3Lanes& p_left, const Vector3Lanes& p_right)
+	{
+		return _mm256_fmadd_ps(p_left.x, p_right.x, _mm256_fmadd_ps(p_left.y, p_right.y, _mm256_mul_ps(p_left.z, p_right.z)));
+	}
+
+	SIMD_TARGET_AVX2 inline Vector3Lanes Cross3(const Vector3Lanes& p_left, const Vector3Lanes& p_right)
+	{
+		return
+		{
+			_mm256_fmsub_ps(p_left.y, p_right.z, _mm256_mul_ps(p_left.z, p_right.y)),
+			_mm256_fmsub_ps(p_left.z, p_right.x, _mm256_mul_ps(p_left.x, p_right.z)),
+			_mm256_fmsub_ps(p_left.x, p_right.y, _mm256_mul_ps(p_left.y, p_right.x))
+		};
+	}
+
+	/**
+	* Return the normalized vector where its squared length is above the threshold, the fallback elsewhere
+	*/
+	SIMD_TARGET_AVX2 inline Vector3Lanes NormalizeOr3(const Vector3Lanes& p_vector, __m256 p_threshold, const Vector3Lanes& p_fallback)
+	{
+		const __m256 length2 = Dot3(p_vector, p_vector);
+		const __m256 valid = _mm256_cmp_ps(length2, p_threshold, _CMP_GT_OQ);
+		const __m256 inverseLength = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(_mm256_max_ps(length2, _mm256_set1_ps(kEpsilon))));
+
+		return
+		{
+			_mm256_blendv_ps(p_fallback.x, _mm256_mul_ps(p_vector.x, inverseLength), valid),
+			_mm256_blendv_ps(p_fallback.y, _mm256_mul_ps(p_vector.y, inverseLength), valid),
+			_mm256_blendv_ps(p_fallback.z, _mm256_mul_ps(p_vector.z, inverseLength), valid)
+		};
+	}
+
+	SIMD_TARGET_AVX2 inline __m256 ClampCosAVX2(__m256 p_cos)
+	{
+		return _mm256_min_ps(_mm256_max_ps(p_cos, _mm256_set1_ps(-1.0f)), _mm256_set1_ps(1.0f));
+	}
+
+	SIMD_TARGET_AVX2 inline __m256 HalfCosAVX2(__m256 p_cos)
+	{
+		return _mm256_sqrt_ps(_mm256_max_ps(_mm256_setzero_ps(), _mm256_fmadd_ps(_mm256_set1_ps(0.5f), p_cos, _mm256_set1_ps(0.5f))));
+	}
+
+	SIMD_TARGET_AVX2 inline __m256 HalfSinAVX2(__m256 p_cos)
+	{
+		return _mm256_sqrt_ps(_mm256_max_ps(_mm256_setzero_ps(), _mm256_fnmadd_ps(_mm256_set1_ps(0.5f), p_cos, _mm256_set1_ps(0.5f))));
+	}
+
+	/**
+	* Same as StoreWeightedRotation, every lane at once
+	*/
+	SIMD_TARGET_AVX2 inline void StoreWeightedRotationAVX2(const Vector3Lanes& p_xyz, __m256 p_w, __m256 p_weight, float* p_output)
+	{
+		/* The shortest path to the identity (blendv selects on the sign bit of w) */
+		const __m256 sign = _mm256_blendv_ps(p_weight, _mm256_sub_ps(_mm256_setzero_ps(), p_weight), p_w);
+		const __m256 w = _mm256_fmadd_ps(sign, p_w, _mm256_sub_ps(_mm256_set1_ps(1.0f), p_weight));
+		const __m256 x = _mm256_mul_ps(sign, p_xyz.x);
+		const __m256 y = _mm256_mul_ps(sign, p_xyz.y);
+		const __m256 z = _mm256_mul_ps(sign, p_xyz.z);
+		const __m256 length2 = _mm256_fmadd_ps(x, x, _mm256_fmadd_ps(y, y, _mm256_fmadd_ps(z, z, _mm256_mul_ps(w, w))));
+		const __m256 inverseLength = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(length2));
+
+		_mm256_store_ps(p_output, _mm256_mul_ps(x, inverseLength));
+		_mm256_store_ps(p_output + kLaneWidth, _mm256_mul_ps(y, inverseLength));
+		_mm256_store_ps(p_output + 2 * kLaneWidth, _mm256_mul_ps(z, inverseLength));
+		_mm256_store_ps(p_output + 3 * kLaneWidth, _mm256_mul_ps(w, inverseLength));
+	}
+
+	/**
+	* Same as SolveGroupScalar, every lane at once
+	*/
+	SIMD_TARGET_AVX2 void SolveGroupAVX2(ChainLanes& p_lanes)
+	{
+		const __m256 epsilon = _mm256_set1_ps(kEpsilon);
+		const __m256 parallelThreshold = _mm256_set1_ps(kParallelThreshold);
+		const __m256 signMask = _mm256_set1_ps(-0.0f);
+
+		const Vector3Lanes root = Load3(p_lanes.root);
+		const Vector3Lanes ab = Subtract3(Load3(p_lanes.joint), root);
+		const Vector3Lanes bc = Subtract3(Load3(p_lanes.end), Load3(p_lanes.joint));
+		const Vector3Lanes ac = Subtract3(Load3(p_lanes.end), root);
+		const Vector3Lanes at = Subtract3(Load3(p_lanes.target), root);
+
+		const __m256 ab2 = Dot3(ab, ab);
+		const __m256 bc2 = Dot3(bc, bc);
+		const __m256 ac2 = Dot3(ac, ac);
+		const __m256 at2 = Dot3(at, at);
+		const __m256 abLength = _mm256_sqrt_ps(ab2);
+		const __m256 bcLength = _mm256_sqrt_ps(bc2);
+		const __m256 acLength = _mm256_sqrt_ps(ac2);
+		const __m256 atLength = _mm256_sqrt_ps(at2);
+
+		/* Distance between the root and the end once solved */
+		const __m256 chainLength = _mm256_add_ps(abLength, bcLength);
+		const __m256 minReach = _mm256_fmadd_ps(_mm256_set1_ps(kReachMargin), chainLength, _mm256_andnot_ps(signMask, _mm256_sub_ps(abLength, bcLength)));
+		const __m256 maxReach = _mm256_mul_ps(chainLength, _mm256_set1_ps(1.0f - kReachMargin));
+		const __m256 reach = _mm256_min_ps(_mm256_max_ps(atLength, minReach), maxReach);
+		const __m256 reach2 = _mm256_mul_ps(reach, reach);
+
+		/* Current and wanted angles (At the root between the chain and the first bone, at the joint between the two bones) */
+		const __m256 rootCos = ClampCosAVX2(_mm256_div_ps(Dot3(ac, ab), _mm256_max_ps(_mm256_mul_ps(acLength, abLength), epsilon)));
+		const __m256 jointCos = ClampCosAVX2(_mm256_div_ps(_mm256_sub_ps(_mm256_setzero_ps(), Dot3(ab, bc)), _mm256_max_ps(_mm256_mul_ps(abLength, bcLength), epsilon)));
+		const __m256 targetCos = ClampCosAVX2(_mm256_div_ps(Dot3(ac, at), _mm256_max_ps(_mm256_mul_ps(acLength, atLength), epsilon)));
+		const __m256 solvedRootCos = ClampCosAVX2(_mm256_div_ps(_mm256_sub_ps(_mm256_add_ps(ab2, reach2), bc2), _mm256_max_ps(_mm256_mul_ps(_mm256_add_ps(abLength, abLength), reach), epsilon)));
+		const __m256 solvedJointCos = ClampCosAVX2(_mm256_div_ps(_mm256_sub_ps(_mm256_add_ps(ab2, bc2), reach2), _mm256_max_ps(_mm256_mul_ps(_mm256_add_ps(abLength, abLength), bcLength), epsilon)));
+
+		/* Bend axis (Normal of the plane of the chain), and axis turning the chain toward the target */
+		const Vector3Lanes axis = Load3(p_lanes.bendAxis);
+		const __m256 projection = _mm256_div_ps(Dot3(axis, ac), _mm256_max_ps(ac2, epsilon));
+		const Vector3Lanes orthogonalAxis = { _mm256_fnmadd_ps(projection, ac.x, axis.x), _mm256_fnmadd_ps(projection, ac.y, axis.y), _mm256_fnmadd_ps(projection, ac.z, axis.z) };
+
+		/* Straight chain : the given axis, made orthogonal to the chain */
+		const Vector3Lanes bend = NormalizeOr3(Cross3(ac, ab), _mm256_mul_ps(parallelThreshold, _mm256_mul_ps(ac2, ab2)), NormalizeOr3(orthogonalAxis, epsilon, axis));
+		const Vector3Lanes turn = NormalizeOr3(Cross3(ac, at), _mm256_mul_ps(parallelThreshold, _mm256_mul_ps(ac2, at2)), bend);
+
+		/* Half angles of the differences between the wanted and the current angles : cos(a - b) and sin(a - b) from the half angles of a and b */
+		const __m256 rootSin = _mm256_fmsub_ps(HalfSinAVX2(solvedRootCos), HalfCosAVX2(rootCos), _mm256_mul_ps(HalfCosAVX2(solvedRootCos), HalfSinAVX2(rootCos)));
+		const __m256 rootW = _mm256_fmadd_ps(HalfCosAVX2(solvedRootCos), HalfCosAVX2(rootCos), _mm256_mul_ps(HalfSinAVX2(solvedRootCos), HalfSinAVX2(rootCos)));
+		const __m256 jointSin = _mm256_fmsub_ps(HalfSinAVX2(solvedJointCos), HalfCosAVX2(jointCos), _mm256_mul_ps(HalfCosAVX2(solvedJointCos), HalfSinAVX2(jointCos)));
+		const __m256 jointW = _mm256_fmadd_ps(HalfCosAVX2(solvedJointCos), HalfCosAVX2(jointCos), _mm256_mul_ps(HalfSinAVX2(solvedJointCos), HalfSinAVX2(jointCos)));
+		const __m256 turnSin = HalfSinAVX2(targetCos);
+		const __m256 turnW = HalfCosAVX2(targetCos);
+
+		/* rootRotation = turn * bendRoot (Both about axes going through the root) */
+		const Vector3Lanes turnCrossBend = Cross3(turn, bend);
+		const __m256 turnRootSin = _mm256_mul_ps(turnSin, rootSin);
+		const __m256 bendScale = _mm256_mul_ps(turnW, rootSin);
+		const __m256 turnScale = _mm256_mul_ps(rootW, turnSin);
+
+		const Vector3Lanes rootXYZ =
+		{
+			_mm256_fmadd_ps(bendScale, bend.x, _mm256_fmadd_ps(turnScale, turn.x, _mm256_mul_ps(turnRootSin, turnCrossBend.x))),
+			_mm256_fmadd_ps(bendScale, bend.y, _mm256_fmadd_ps(turnScale, turn.y, _mm256_mul_ps(turnRootSin, turnCrossBend.y))),
+			_mm256_fmadd_ps(bendScale, bend.z, _mm256_fmadd_ps(turnScale, turn.z, _mm256_mul_ps(turnRootSin, turnCrossBend.z)))
+		};
+		const __m256 rootRotationW = _mm256_fmsub_ps(turnW, rootW, _mm256_mul_ps(turnRootSin, Dot3(turn, bend)));
+
+		/* jointRotation = rootRotation * bendJoint */
+		const Vector3Lanes rootCrossBend = Cross3(rootXYZ, bend);
+		const __m256 jointBendScale = _mm256_mul_ps(rootRotationW, jointSin);
+
+		const Vector3Lanes jointXYZ =
+		{
+			_mm256_fmadd_ps(jointBendScale, bend.x, _mm256_fmadd_ps(jointW, rootXYZ.x, _mm256_mul_ps(jointSin, rootCrossBend.x))),
+			_mm256_fmadd_ps(jointBendScale, bend.y, _mm256_fmadd_ps(jointW, rootXYZ.y, _mm256_mul_ps(jointSin, rootCrossBend.y))),
+			_mm256_fmadd_ps(jointBendScale, bend.z, _mm256_fmadd_ps(jointW, rootXYZ.z, _mm256_mul_ps(jointSin, rootCrossBend.z)))
+		};
+		const __m256 jointRotationW = _mm256_fmsub_ps(rootRotationW, jointW, _mm256_mul_ps(jointSin, Dot3(rootXYZ, bend)));
+
+		/* Weighted with a normalized lerp from the identity */
+		const __m256 weight = _mm256_load_ps(p_lanes.weight);
+		StoreWeightedRotationAVX2(rootXYZ, rootRotationW, weight, p_lanes.rootRotation);
+		StoreWeightedRotationAVX2(jointXYZ, jointRotationW, weight, p_lanes.jointRotation);
+	}
+
+	/**
+	* Store the given vector as the component lanes of the given lane
+	*/
+	void StoreVector(float* p_components, uint32_t p_lane, const AltMath::Vector3f& p_vector)
+	{
+		p_components[p_lane] = p_vector.x;
+		p_components[kLaneWidth + p_lane] = p_vector.y;
+		p_components[2 * kLaneWidth + p_lane] = p_vector.z;
+	}
+
+	/**
+	* Read the quaternion of the given lane
+	*/
+	AltMath::Quaternion ReadQuaternion(const float* p_components, uint32_t p_lane)
+	{
+		return AltMath::Quaternion(p_components[p_lane], p_components[kLaneWidth + p_lane], p_components[2 * kLaneWidth + p_lane], p_components[3 * kLaneWidth + p_lane]);
+	}
+}
+
+void AnimationProgramming::Animation::TwoBoneIKSolver::Solve(const std::vector<Request>& p_requests, std::vector<Result>& p_results, Tools::ThreadPool* p_threadPool)
+{
+	const uint32_t requestCount = static_cast<uint32_t>(p_requests.size());
+	const uint32_t groupCount = (requestCount + kLaneWidth - 1) / kLaneWidth;
+	const bool useAVX2 = Tools::SIMD::GetLevel() == Tools::ESIMDLevel::AVX2;
+
+	p_results.resize(requestCount);
+
+	auto solveGroups = [&p_requests, &p_results, requestCount, useAVX2](uint32_t p_begin, uint32_t p_end)
+	{
+		ChainLanes lanes;
+
+		for (uint32_t group = p_begin; group < p_end; ++group)
+		{
+			const uint32_t first = group * kLaneWidth;
+			const uint32_t laneCount = std::min(kLaneWidth, requestCount - first);
+
+			/* The padding lanes repeat the last request of the group */
+			for (uint32_t lane = 0; lane < kLaneWidth; ++lane)
+			{
+				const Request& request = p_requests[first + std::min(lane, laneCount - 1)];
+
+				StoreVector(lanes.root, lane, request.root);
+				StoreVector(lanes.joint, lane, request.joint);
+				StoreVector(lanes.end, lane, request.end);
+				StoreVector(lanes.target, lane, request.target);
+				StoreVector(lanes.bendAxis, lane, request.bendAxis);
+				lanes.weight[lane] = request.weight;
+			}
+
+			if (useAVX2)
+				SolveGroupAVX2(lanes);
+			else
+				SolveGroupScalar(lanes);
+
+			for (uint32_t lane = 0; lane < laneCount; ++lane)
+			{
+				p_results[first + lane].rootRotation = ReadQuaternion(lanes.rootRotation, lane);
+				p_results[first + lane].jointRotation = ReadQuaternion(lanes.jointRotation, lane);
+			}
+		}
+	};
+
+	if (p_threadPool)
+		p_threadPool->ParallelFor(groupCount, kGroupsPerChunk, solveGroups);
+	else
+		solveGroups(0, groupCount);
+}
@@ -14,22 +14,49 @@ void AnimationProgramming::Core::AnimationEngine::Run(ISimulation& p_simulation,
 	::Run(&p_simulation, p_windowWidth, p_windowHeight);
 }
 
-void AnimationProgramming::Core::AnimationEngine::SetSkinningPose(std::vector<AltMath::Matrix4f>& p_bonesTransformations)
+void AnimationProgramming::Core::AnimationEngine::SetSkinningPose(const std::vector<Data::Matrix3x4>& p_bonesTransformations)
 {
-	std::vector<float> gpuData;
+	/* Reused between calls to avoid an allocation per frame */
+	static std::vector<float> gpuData;
 	uint32_t boneCount = static_cast<uint32_t>(p_bonesTransformations.size());
 
-	for (AltMath::Matrix4f& boneTransformation : p_bonesTransformations)
-		for (uint8_t i = 0; i < 16; ++i)
-			gpuData.push_back(boneTransformation.ToArray()[i]);
+	gpuData.resize(boneCount * 16);
+
+	for (uint32_t boneIndex = 0; boneIndex < boneCount; ++boneIndex)
+		p_bonesTransformations[boneIndex].WriteMatrix4(gpuData.data() + boneIndex * 16);
+
+	::SetSkinningPose(gpuData.data(), boneCount);
+}
+
+void AnimationProgramming::Core::AnimationEngine::SetSkinningPose(const std::vector<Data::DualQuaternion>& p_bonesTransformations)
+{
+	static std::vector<float> gpuData;
+	uint32_t boneCount = static_cast<uint32_t>(p_bonesTransformations.size());
+
+	gpuData.resize(boneCount * 16);
+
+	for (uint32_t boneIndex = 0; boneIndex < boneCount; ++boneIndex)
+		p_bonesTransformations[boneIndex].ToMatrix3x4().WriteMatrix4(gpuData.data() + boneIndex * 16);
 
 	::SetSkinningPose(gpuData.data(), boneCount);
 }
 
 uint32_t AnimationProgramming::Core::AnimationEngine::GetSkeletonBoneCount()
 {
-	/* The minus 6 here is used to ignore IK (Can crash if I don't) */
-	return static_cast<uint32_t>(::GetSkeletonBoneCount() - 6);
+	/* The IK bones are ignored here (Can crash if I don't) */
+	return static_cast<uint32_t>(::GetSkeletonBoneCount()) - GetSkeletonIKBoneCount();
+}
+
+uint32_t AnimationProgramming::Core::AnimationEngine::GetSkeletonIKBoneCount()
+{
+	/* The IK bones (ik_foot_root, ik_foot_l...) are the last bones of the engine skeleton */
+	const uint32_t engineBoneCount = static_cast<uint32_t>(::GetSkeletonBoneCount());
+	uint32_t ikBoneCount = 0;
+
+	while (ikBoneCount < engineBoneCount && GetSkeletonBoneName(engineBoneCount - ikBoneCount - 1).compare(0, 3, "ik_") == 0)
+		++ikBoneCount;
+
+	return ikBoneCount;
 }
 
 std::string AnimationProgramming::Core::AnimationEngine::GetSkeletonBoneName(uint32_t p_boneIndex)
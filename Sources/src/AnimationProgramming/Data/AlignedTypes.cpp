@@ -0,0 +1,56 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <cstring>
+
+#include "AnimationProgramming/Data/AlignedTypes.h"
+
+AnimationProgramming::Data::AlignedVector3::AlignedVector3() :
+	x(0.0f), y(0.0f), z(0.0f), padding(0.0f)
+{
+}
+
+AnimationProgramming::Data::AlignedVector3::AlignedVector3(const AltMath::Vector3f& p_vector) :
+	x(p_vector.x), y(p_vector.y), z(p_vector.z), padding(0.0f)
+{
+}
+
+AltMath::Vector3f AnimationProgramming::Data::AlignedVector3::ToVector3() const
+{
+	return AltMath::Vector3f(x, y, z);
+}
+
+AnimationProgramming::Data::AlignedQuaternion::AlignedQuaternion() :
+	x(0.0f), y(0.0f), z(0.0f), w(1.0f)
+{
+}
+
+AnimationProgramming::Data::AlignedQuaternion::AlignedQuaternion(const AltMath::Quaternion& p_quaternion) :
+	x(p_quaternion.GetXAxisValue()), y(p_quaternion.GetYAxisValue()), z(p_quaternion.GetZAxisValue()), w(p_quaternion.GetRealValue())
+{
+}
+
+AltMath::Quaternion AnimationProgramming::Data::AlignedQuaternion::ToQuaternion() const
+{
+	return AltMath::Quaternion(x, y, z, w);
+}
+
+AnimationProgramming::Data::AlignedMatrix4::AlignedMatrix4()
+{
+	std::memcpy(elements, AltMath::Matrix4f::Identity.elements, 16 * sizeof(float));
+}
+
+AnimationProgramming::Data::AlignedMatrix4::AlignedMatrix4(const AltMath::Matrix4f& p_matrix)
+{
+	std::memcpy(elements, p_matrix.elements, 16 * sizeof(float));
+}
+
+AltMath::Matrix4f AnimationProgramming::Data::AlignedMatrix4::ToMatrix4() const
+{
+	AltMath::Matrix4f result;
+	std::memcpy(result.elements, elements, 16 * sizeof(float));
+	return result;
+}
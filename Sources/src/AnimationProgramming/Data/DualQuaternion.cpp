@@ -0,0 +1,159 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <cmath>
+
+#include "AnimationProgramming/Data/DualQuaternion.h"
+
+namespace
+{
+	/**
+	* Store the Hamilton product p_left * p_right into p_result ((x, y, z, w) layout)
+	*/
+	void MultiplyQuaternions(const float* p_left, const float* p_right, float* p_result)
+	{
+		const float x = p_left[3] * p_right[0] + p_left[0] * p_right[3] + p_left[1] * p_right[2] - p_left[2] * p_right[1];
+		const float y = p_left[3] * p_right[1] - p_left[0] * p_right[2] + p_left[1] * p_right[3] + p_left[2] * p_right[0];
+		const float z = p_left[3] * p_right[2] + p_left[0] * p_right[1] - p_left[1] * p_right[0] + p_left[2] * p_right[3];
+		const float w = p_left[3] * p_right[3] - p_left[0] * p_right[0] - p_left[1] * p_right[1] - p_left[2] * p_right[2];
+
+		p_result[0] = x;
+		p_result[1] = y;
+		p_result[2] = z;
+		p_result[3] = w;
+	}
+}
+
+AnimationProgramming::Data::DualQuaternion::DualQuaternion() :
+	real{ 0.0f, 0.0f, 0.0f, 1.0f },
+	dual{ 0.0f, 0.0f, 0.0f, 0.0f }
+{
+}
+
+AnimationProgramming::Data::DualQuaternion::DualQuaternion(const AltMath::Vector3f& p_position, const AltMath::Quaternion& p_rotation)
+{
+	const float x = p_rotation.GetXAxisValue();
+	const float y = p_rotation.GetYAxisValue();
+	const float z = p_rotation.GetZAxisValue();
+	const float w = p_rotation.GetRealValue();
+
+	const float lengthSquare = x * x + y * y + z * z + w * w;
+	const float inverseLength = lengthSquare > 0.0f ? 1.0f / std::sqrt(lengthSquare) : 0.0f;
+
+	real[0] = x * inverseLength;
+	real[1] = y * inverseLength;
+	real[2] = z * inverseLength;
+	real[3] = lengthSquare > 0.0f ? w * inverseLength : 1.0f;
+
+	/* Dual part = 0.5 * (Translation as a pure quaternion) * Rotation */
+	const float translation[4] = { 0.5f * p_position.x, 0.5f * p_position.y, 0.5f * p_position.z, 0.0f };
+	MultiplyQuaternions(translation, real, dual);
+}
+
+AnimationProgramming::Data::DualQuaternion AnimationProgramming::Data::DualQuaternion::Multiply(const DualQuaternion& p_left, const DualQuaternion& p_right)
+{
+	DualQuaternion result;
+
+	/* (r1 + e.d1) * (r2 + e.d2) = r1.r2 + e.(r1.d2 + d1.r2), since e^2 = 0 */
+	float realDual[4];
+	float dualReal[4];
+	MultiplyQuaternions(p_left.real, p_right.real, result.real);
+	MultiplyQuaternions(p_left.real, p_right.dual, realDual);
+	MultiplyQuaternions(p_left.dual, p_right.real, dualReal);
+
+	for (uint8_t i = 0; i < 4; ++i)
+		result.dual[i] = realDual[i] + dualReal[i];
+
+	return result;
+}
+
+AnimationProgramming::Data::DualQuaternion AnimationProgramming::Data::DualQuaternion::operator*(const DualQuaternion& p_other) const
+{
+	return Multiply(*this, p_other);
+}
+
+AnimationProgramming::Data::DualQuaternion AnimationProgramming::Data::DualQuaternion::Interpolate(const DualQuaternion& p_from, const DualQuaternion& p_to, float p_alpha)
+{
+	DualQuaternion result;
+
+	/* Both parts of p_to are negated if its rotation is on the other hemisphere (Same transformation, shortest path) */
+	float dot = 0.0f;
+
+	for (uint8_t i = 0; i < 4; ++i)
+		dot += p_from.real[i] * p_to.real[i];
+
+	const float toWeight = dot < 0.0f ? -p_alpha : p_alpha;
+	float lengthSquare = 0.0f;
+
+	for (uint8_t i = 0; i < 4; ++i)
+	{
+		result.real[i] = p_from.real[i] * (1.0f - p_alpha) + p_to.real[i] * toWeight;
+		result.dual[i] = p_from.dual[i] * (1.0f - p_alpha) + p_to.dual[i] * toWeight;
+		lengthSquare += result.real[i] * result.real[i];
+	}
+
+	/* Dividing both parts by the length of the real part keeps the translation */
+	const float inverseLength = 1.0f / std::sqrt(lengthSquare);
+
+	for (uint8_t i = 0; i < 4; ++i)
+	{
+		result.real[i] *= inverseLength;
+		result.dual[i] *= inverseLength;
+	}
+
+	return result;
+}
+
+AnimationProgramming::Data::DualQuaternion AnimationProgramming::Data::DualQuaternion::Inverse() const
+{
+	DualQuaternion result;
+
+	for (uint8_t i = 0; i < 3; ++i)
+	{
+		result.real[i] = -real[i];
+		result.dual[i] = -dual[i];
+	}
+
+	result.real[3] = real[3];
+	result.dual[3] = dual[3];
+
+	return result;
+}
+
+AltMath::Vector3f AnimationProgramming::Data::DualQuaternion::TransformPoint(const AltMath::Vector3f& p_point) const
+{
+	return TransformVector(p_point) + GetPosition();
+}
+
+AltMath::Vector3f AnimationProgramming::Data::DualQuaternion::TransformVector(const AltMath::Vector3f& p_vector) const
+{
+	/* v' = v + 2.q x (q x v + w.v), with q the vector part of the real quaternion */
+	const AltMath::Vector3f axis(real[0], real[1], real[2]);
+	const AltMath::Vector3f cross = AltMath::Vector3f::CrossProduct(axis, p_vector) + p_vector * real[3];
+
+	return p_vector + AltMath::Vector3f::CrossProduct(axis, cross) * 2.0f;
+}
+
+AltMath::Vector3f AnimationProgramming::Data::DualQuaternion::GetPosition() const
+{
+	/* Translation = 2 * Dual * Conjugate(Real), its vector part simplified */
+	return AltMath::Vector3f
+	(
+		2.0f * (-dual[3] * real[0] + dual[0] * real[3] - dual[1] * real[2] + dual[2] * real[1]),
+		2.0f * (-dual[3] * real[1] + dual[0] * real[2] + dual[1] * real[3] - dual[2] * real[0]),
+		2.0f * (-dual[3] * real[2] - dual[0] * real[1] + dual[1] * real[0] + dual[2] * real[3])
+	);
+}
+
+AltMath::Quaternion AnimationProgramming::Data::DualQuaternion::GetRotation() const
+{
+	return AltMath::Quaternion(real[0], real[1], real[2], real[3]);
+}
+
+AnimationProgramming::Data::Matrix3x4 AnimationProgramming::Data::DualQuaternion::ToMatrix3x4() const
+{
+	return Matrix3x4(GetPosition(), GetRotation());
+}
@@ -0,0 +1,64 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <immintrin.h>
+
+#include "AnimationProgramming/Data/HalfMatrix3x4.h"
+#include "AnimationProgramming/Tools/Math.h"
+#include "AnimationProgramming/Tools/SIMD.h"
+#include "AnimationProgramming/Tools/SIMDTarget.h"
+
+namespace
+{
+	/* F16C converts 8 halves per instruction, and is available on every CPU supporting the AVX2 level */
+	SIMD_TARGET_AVX2 void HalfToFloatF16C(const uint16_t* p_source, float* p_destination)
+	{
+		_mm256_storeu_ps(p_destination, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p_source))));
+		_mm_storeu_ps(p_destination + 8, _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p_source + 8))));
+	}
+}
+
+AnimationProgramming::Data::HalfMatrix3x4::HalfMatrix3x4() :
+	HalfMatrix3x4(Matrix3x4::Identity)
+{
+}
+
+AnimationProgramming::Data::HalfMatrix3x4::HalfMatrix3x4(const Matrix3x4& p_matrix)
+{
+	for (uint8_t i = 0; i < 12; ++i)
+		elements[i] = Tools::Math::FloatToHalf(p_matrix.elements[i]);
+}
+
+AnimationProgramming::Data::Matrix3x4 AnimationProgramming::Data::HalfMatrix3x4::ToMatrix3x4() const
+{
+	Matrix3x4 result;
+
+	if (Tools::SIMD::GetLevel() == Tools::ESIMDLevel::AVX2)
+	{
+		HalfToFloatF16C(elements, result.elements);
+	}
+	else
+	{
+		for (uint8_t i = 0; i < 12; ++i)
+			result.elements[i] = Tools::Math::HalfToFloat(elements[i]);
+	}
+
+	return result;
+}
+
+void AnimationProgramming::Data::HalfMatrix3x4::ToMatrix3x4(const HalfMatrix3x4* p_source, Matrix3x4* p_destination, size_t p_count)
+{
+	if (Tools::SIMD::GetLevel() == Tools::ESIMDLevel::AVX2)
+	{
+		for (size_t i = 0; i < p_count; ++i)
+			HalfToFloatF16C(p_source[i].elements, p_destination[i].elements);
+	}
+	else
+	{
+		for (size_t i = 0; i < p_count; ++i)
+			p_destination[i] = p_source[i].ToMatrix3x4();
+	}
+}
@@ -0,0 +1,206 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <cstring>
+#include <immintrin.h>
+
+#include "AnimationProgramming/Data/Matrix3x4.h"
+#include "AnimationProgramming/Tools/SIMD.h"
+#include "AnimationProgramming/Tools/SIMDTarget.h"
+
+/* Fused multiply-add is only available when compiling for AVX2 (/arch:AVX2), otherwise we fallback to mul + add (The AVX2 level always uses it) */
+#if defined(__AVX2__)
+#define MATRIX3X4_MADD(a, b, c) _mm_fmadd_ps(a, b, c)
+#else
+#define MATRIX3X4_MADD(a, b, c) _mm_add_ps(_mm_mul_ps(a, b), c)
+#endif
+
+#define MATRIX3X4_SPLAT(v, i) _mm_shuffle_ps(v, v, _MM_SHUFFLE(i, i, i, i))
+
+namespace
+{
+	/* The implicit (0, 0, 0, 1) last row of the right matrix means that the left translation is simply added to the result translation */
+
+	void MultiplySSE(const float* p_left, const float* p_right, float* p_result)
+	{
+		const __m128 translationMask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+		const __m128 right0 = _mm_load_ps(p_right + 0);
+		const __m128 right1 = _mm_load_ps(p_right + 4);
+		const __m128 right2 = _mm_load_ps(p_right + 8);
+
+		for (uint8_t row = 0; row < 3; ++row)
+		{
+			const __m128 left = _mm_load_ps(p_left + row * 4);
+			__m128 rowResult = _mm_mul_ps(MATRIX3X4_SPLAT(left, 0), right0);
+			rowResult = MATRIX3X4_MADD(MATRIX3X4_SPLAT(left, 1), right1, rowResult);
+			rowResult = MATRIX3X4_MADD(MATRIX3X4_SPLAT(left, 2), right2, rowResult);
+			_mm_store_ps(p_result + row * 4, _mm_add_ps(rowResult, _mm_and_ps(left, translationMask)));
+		}
+	}
+
+	/* Rows 0 and 1 of the left matrix are processed together in one 256 bits register, row 2 uses a 128 bits register */
+	SIMD_TARGET_AVX2 void MultiplyAVX2(const float* p_left, const float* p_right, float* p_result)
+	{
+		const __m128 translationMask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+		const __m256 right0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(p_right + 0));
+		const __m256 right1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(p_right + 4));
+		const __m256 right2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(p_right + 8));
+		const __m256 left01 = _mm256_loadu_ps(p_left);
+
+		__m256 result01 = _mm256_mul_ps(_mm256_permute_ps(left01, _MM_SHUFFLE(0, 0, 0, 0)), right0);
+		result01 = _mm256_fmadd_ps(_mm256_permute_ps(left01, _MM_SHUFFLE(1, 1, 1, 1)), right1, result01);
+		result01 = _mm256_fmadd_ps(_mm256_permute_ps(left01, _MM_SHUFFLE(2, 2, 2, 2)), right2, result01);
+		result01 = _mm256_add_ps(result01, _mm256_and_ps(left01, _mm256_set_m128(translationMask, translationMask)));
+		_mm256_storeu_ps(p_result, result01);
+
+		const __m128 left2 = _mm_load_ps(p_left + 8);
+		__m128 result2 = _mm_mul_ps(_mm_permute_ps(left2, _MM_SHUFFLE(0, 0, 0, 0)), _mm256_castps256_ps128(right0));
+		result2 = _mm_fmadd_ps(_mm_permute_ps(left2, _MM_SHUFFLE(1, 1, 1, 1)), _mm256_castps256_ps128(right1), result2);
+		result2 = _mm_fmadd_ps(_mm_permute_ps(left2, _MM_SHUFFLE(2, 2, 2, 2)), _mm256_castps256_ps128(right2), result2);
+		_mm_store_ps(p_result + 8, _mm_add_ps(result2, _mm_and_ps(left2, translationMask)));
+	}
+}
+
+const AnimationProgramming::Data::Matrix3x4 AnimationProgramming::Data::Matrix3x4::Identity;
+
+AnimationProgramming::Data::Matrix3x4::Matrix3x4() :
+	elements
+	{
+		1.0f, 0.0f, 0.0f, 0.0f,
+		0.0f, 1.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 1.0f, 0.0f
+	}
+{
+}
+
+AnimationProgramming::Data::Matrix3x4::Matrix3x4(const AltMath::Vector3f& p_position, const AltMath::Quaternion& p_rotation)
+{
+	const float x = p_rotation.GetXAxisValue();
+	const float y = p_rotation.GetYAxisValue();
+	const float z = p_rotation.GetZAxisValue();
+	const float w = p_rotation.GetRealValue();
+
+	/* Dividing by the squared length gives the same result as normalizing the quaternion first (Like Quaternion::ToMatrix4 does) */
+	const float lengthSquare = x * x + y * y + z * z + w * w;
+	const float s = lengthSquare > 0.0f ? 2.0f / lengthSquare : 0.0f;
+
+	const float xx = x * x * s, yy = y * y * s, zz = z * z * s;
+	const float xy = x * y * s, xz = x * z * s, yz = y * z * s;
+	const float xw = x * w * s, yw = y * w * s, zw = z * w * s;
+
+	elements[0] = 1.0f - yy - zz;	elements[1] = xy - zw;			elements[2] = xz + yw;			elements[3] = p_position.x;
+	elements[4] = xy + zw;			elements[5] = 1.0f - xx - zz;	elements[6] = yz - xw;			elements[7] = p_position.y;
+	elements[8] = xz - yw;			elements[9] = yz + xw;			elements[10] = 1.0f - xx - yy;	elements[11] = p_position.z;
+}
+
+AnimationProgramming::Data::Matrix3x4 AnimationProgramming::Data::Matrix3x4::Multiply(const Matrix3x4& p_left, const Matrix3x4& p_right)
+{
+	Matrix3x4 result;
+
+	if (Tools::SIMD::GetLevel() == Tools::ESIMDLevel::AVX2)
+		MultiplyAVX2(p_left.elements, p_right.elements, result.elements);
+	else
+		MultiplySSE(p_left.elements, p_right.elements, result.elements);
+
+	return result;
+}
+
+AnimationProgramming::Data::Matrix3x4 AnimationProgramming::Data::Matrix3x4::operator*(const Matrix3x4& p_other) const
+{
+	return Multiply(*this, p_other);
+}
+
+AnimationProgramming::Data::Matrix3x4 AnimationProgramming::Data::Matrix3x4::RigidInverse() const
+{
+	Matrix3x4 result;
+
+	__m128 row0 = _mm_load_ps(elements + 0);
+	__m128 row1 = _mm_load_ps(elements + 4);
+	__m128 row2 = _mm_load_ps(elements + 8);
+
+	/* Inverse translation = -(Transpose(R) * t), calculated as a linear combination of the rows of R */
+	__m128 inverseTranslation = _mm_mul_ps(row0, MATRIX3X4_SPLAT(row0, 3));
+	inverseTranslation = MATRIX3X4_MADD(row1, MATRIX3X4_SPLAT(row1, 3), inverseTranslation);
+	inverseTranslation = MATRIX3X4_MADD(row2, MATRIX3X4_SPLAT(row2, 3), inverseTranslation);
+	inverseTranslation = _mm_sub_ps(_mm_setzero_ps(), inverseTranslation);
+
+	/* Transposing (row0, row1, row2, inverseTranslation) gives Transpose(R) with the inverse translation as fourth column */
+	_MM_TRANSPOSE4_PS(row0, row1, row2, inverseTranslation);
+
+	_mm_store_ps(result.elements + 0, row0);
+	_mm_store_ps(result.elements + 4, row1);
+	_mm_store_ps(result.elements + 8, row2);
+
+	return result;
+}
+
+AltMath::Vector3f AnimationProgramming::Data::Matrix3x4::TransformPoint(const AltMath::Vector3f& p_point) const
+{
+	const __m128 point = _mm_set_ps(1.0f, p_point.z, p_point.y, p_point.x);
+
+	__m128 product0 = _mm_mul_ps(_mm_load_ps(elements + 0), point);
+	__m128 product1 = _mm_mul_ps(_mm_load_ps(elements + 4), point);
+	__m128 product2 = _mm_mul_ps(_mm_load_ps(elements + 8), point);
+	__m128 product3 = _mm_setzero_ps();
+
+	/* Transposing the products allows us to sum them vertically instead of doing horizontal additions */
+	_MM_TRANSPOSE4_PS(product0, product1, product2, product3);
+
+	alignas(16) float result[4];
+	_mm_store_ps(result, _mm_add_ps(_mm_add_ps(product0, product1), _mm_add_ps(product2, product3)));
+
+	return AltMath::Vector3f(result[0], result[1], result[2]);
+}
+
+AltMath::Vector3f AnimationProgramming::Data::Matrix3x4::TransformVector(const AltMath::Vector3f& p_vector) const
+{
+	const __m128 vector = _mm_set_ps(0.0f, p_vector.z, p_vector.y, p_vector.x);
+
+	__m128 product0 = _mm_mul_ps(_mm_load_ps(elements + 0), vector);
+	__m128 product1 = _mm_mul_ps(_mm_load_ps(elements + 4), vector);
+	__m128 product2 = _mm_mul_ps(_mm_load_ps(elements + 8), vector);
+	__m128 product3 = _mm_setzero_ps();
+
+	_MM_TRANSPOSE4_PS(product0, product1, product2, product3);
+
+	alignas(16) float result[4];
+	_mm_store_ps(result, _mm_add_ps(_mm_add_ps(product0, product1), _mm_add_ps(product2, product3)));
+
+	return AltMath::Vector3f(result[0], result[1], result[2]);
+}
+
+AltMath::Vector3f AnimationProgramming::Data::Matrix3x4::GetPosition() const
+{
+	return AltMath::Vector3f(elements[3], elements[7], elements[11]);
+}
+
+AltMath::Quaternion AnimationProgramming::Data::Matrix3x4::GetRotation() const
+{
+	AltMath::Matrix3f rotationMatrix(elements[0], elements[1], elements[2], elements[4], elements[5], elements[6], elements[8], elements[9], elements[10]);
+	return AltMath::Quaternion(rotationMatrix);
+}
+
+AltMath::Matrix4f AnimationProgramming::Data::Matrix3x4::ToMatrix4() const
+{
+	AltMath::Matrix4f result;
+	WriteMatrix4(result.elements);
+	return result;
+}
+
+void AnimationProgramming::Data::Matrix3x4::WriteMatrix4(float* p_destination) const
+{
+	std::memcpy(p_destination, elements, 12 * sizeof(float));
+
+	p_destination[12] = 0.0f;
+	p_destination[13] = 0.0f;
+	p_destination[14] = 0.0f;
+	p_destination[15] = 1.0f;
+}
+
+float AnimationProgramming::Data::Matrix3x4::operator()(uint8_t p_row, uint8_t p_column) const
+{
+	return elements[4 * p_row + p_column];
+}
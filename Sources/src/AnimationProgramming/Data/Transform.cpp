@@ -23,12 +23,11 @@ void AnimationProgramming::Data::Transform::SetParent(Data::Transform& p_parent,
 
 void AnimationProgramming::Data::Transform::GenerateMatrices(AltMath::Vector3f p_position, AltMath::Quaternion p_rotation)
 {
-	m_localMatrix = AltMath::Matrix4f::Identity;
-	m_worldMatrix = AltMath::Matrix4f::Identity;
-
-	m_localMatrix.Translate(p_position);
-	m_localMatrix *= p_rotation.ToMatrix4();
+	/* Position and rotation are kept, so getters don't have to extract them back from the matrix (The rotation is normalized, like the one the matrix represents) */
+	m_localPosition = p_position;
+	m_localRotation = AltMath::Quaternion::Normalize(p_rotation);
 
+	m_localMatrix = Data::Matrix3x4(p_position, p_rotation);
 	m_worldMatrix = HasParent() ? m_parent->GetWorldMatrix() * m_localMatrix : m_localMatrix;
 
 	TransformChangedEvent.Invoke();
@@ -36,7 +35,6 @@ void AnimationProgramming::Data::Transform::GenerateMatrices(AltMath::Vector3f p
 
 void AnimationProgramming::Data::Transform::UpdateWorldMatrices()
 {
-	m_worldMatrix = AltMath::Matrix4f::Identity;
 	m_worldMatrix = HasParent() ? m_parent->GetWorldMatrix() * m_localMatrix : m_localMatrix;
 
 	TransformChangedEvent.Invoke();
@@ -57,34 +55,48 @@ void AnimationProgramming::Data::Transform::SetRotation(AltMath::Quaternion p_ne
 	GenerateMatrices(GetLocalPosition(), p_newRotation);
 }
 
-AltMath::Vector3f AnimationProgramming::Data::Transform::GetLocalPosition()
+AltMath::Vector3f AnimationProgramming::Data::Transform::GetLocalPosition() const
 {
-	return AltMath::Vector3f(m_localMatrix(0, 3), m_localMatrix(1, 3), m_localMatrix(2, 3));
+	return m_localPosition;
 }
 
-AltMath::Quaternion AnimationProgramming::Data::Transform::GetLocalRotation()
+AltMath::Quaternion AnimationProgramming::Data::Transform::GetLocalRotation() const
 {
-	AltMath::Matrix3f rotationMatrix(m_localMatrix(0, 0), m_localMatrix(0, 1), m_localMatrix(0, 2), m_localMatrix(1, 0), m_localMatrix(1, 1), m_localMatrix(1, 2), m_localMatrix(2, 0), m_localMatrix(2, 1), m_localMatrix(2, 2));
-	return AltMath::Quaternion(rotationMatrix);
+	return m_localRotation;
 }
 
 AltMath::Vector3f AnimationProgramming::Data::Transform::GetWorldPosition()
 {
-	return AltMath::Vector3f(m_worldMatrix(0, 3), m_worldMatrix(1, 3), m_worldMatrix(2, 3));
+	return m_worldMatrix.GetPosition();
 }	
 
 AltMath::Quaternion AnimationProgramming::Data::Transform::GetWorldRotation()
 {
-	AltMath::Matrix3f rotationMatrix(m_worldMatrix(0, 0), m_worldMatrix(0, 1), m_worldMatrix(0, 2), m_worldMatrix(1, 0), m_worldMatrix(1, 1), m_worldMatrix(1, 2), m_worldMatrix(2, 0), m_worldMatrix(2, 1), m_worldMatrix(2, 2));
-	return AltMath::Quaternion(rotationMatrix);
+	return m_worldMatrix.GetRotation();
 }
 
-const AltMath::Matrix4f & AnimationProgramming::Data::Transform::GetLocalMatrix() const
+const AnimationProgramming::Data::Matrix3x4 & AnimationProgramming::Data::Transform::GetLocalMatrix() const
 {
 	return m_localMatrix;
 }
 
-const AltMath::Matrix4f & AnimationProgramming::Data::Transform::GetWorldMatrix() const
+const AnimationProgramming::Data::Matrix3x4 & AnimationProgramming::Data::Transform::GetWorldMatrix() const
 {
 	return m_worldMatrix;
 }
+
+void AnimationProgramming::Data::Transform::SaveSnapshot(Tools::Snapshot& p_snapshot) const
+{
+	p_snapshot.Write(m_localMatrix);
+	p_snapshot.Write(m_worldMatrix);
+	p_snapshot.Write(m_localPosition);
+	p_snapshot.Write(m_localRotation);
+}
+
+void AnimationProgramming::Data::Transform::RestoreSnapshot(Tools::Snapshot& p_snapshot)
+{
+	p_snapshot.Read(m_localMatrix);
+	p_snapshot.Read(m_worldMatrix);
+	p_snapshot.Read(m_localPosition);
+	p_snapshot.Read(m_localRotation);
+}
@@ -1,17 +1,38 @@
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
 #include "AnimationProgramming/Input/InputManager.h"
 
 void AnimationProgramming::Input::InputManager::Update()
 {
 	m_keyEvents.clear();
+	m_frameEvents.clear();
 
 	for (uint8_t i = 0; i < 255; ++i)
 	{
-		bool keyState = GetKeyState(static_cast<int>(i)) & 0x8000;
-		m_keyEvents[i] = keyState && !m_keyStates[i]; /* Boolean = the key wasn't pressed and is now pressed */
-		m_keyStates[i] = keyState;
+#ifdef _WIN32
+		SetKeyState(i, GetKeyState(static_cast<int>(i)) & 0x8000);
+#else
+		SetKeyState(i, false);
+#endif
 	}
 }
 
+void AnimationProgramming::Input::InputManager::Update(const std::vector<KeyEvent>& p_events)
+{
+	m_keyEvents.clear();
+	m_frameEvents.clear();
+
+	for (const KeyEvent& event : p_events)
+		SetKeyState(event.key, event.pressed);
+}
+
+const std::vector<AnimationProgramming::Input::KeyEvent>& AnimationProgramming::Input::InputManager::GetFrameEvents() const
+{
+	return m_frameEvents;
+}
+
 bool AnimationProgramming::Input::InputManager::IsKeyPressed(char p_key)
 {
 	return m_keyStates[p_key];
@@ -21,3 +42,14 @@ bool AnimationProgramming::Input::InputManager::IsKeyEventOccured(char p_key)
 {
 	return m_keyEvents[p_key];
 }
+
+void AnimationProgramming::Input::InputManager::SetKeyState(uint8_t p_key, bool p_pressed)
+{
+	const char key = static_cast<char>(p_key);
+
+	if (p_pressed != m_keyStates[key])
+		m_frameEvents.push_back({ p_key, p_pressed });
+
+	m_keyEvents[key] = p_pressed && !m_keyStates[key]; /* Boolean = the key wasn't pressed and is now pressed */
+	m_keyStates[key] = p_pressed;
+}
@@ -0,0 +1,56 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+
+#include "AnimationProgramming/Input/InputRecorder.h"
+
+namespace
+{
+	template<typename T>
+	void Write(std::ofstream& p_stream, const T& p_value)
+	{
+		p_stream.write(reinterpret_cast<const char*>(&p_value), sizeof(T));
+	}
+}
+
+AnimationProgramming::Input::InputRecorder::InputRecorder(const std::string& p_path) :
+	m_file(p_path, std::ios::binary | std::ios::trunc),
+	m_frameCount(0)
+{
+	if (!m_file)
+		return;
+
+	Write(m_file, Magic);
+	Write(m_file, Version);
+}
+
+bool AnimationProgramming::Input::InputRecorder::IsOpen() const
+{
+	return static_cast<bool>(m_file);
+}
+
+uint32_t AnimationProgramming::Input::InputRecorder::GetFrameCount() const
+{
+	return m_frameCount;
+}
+
+void AnimationProgramming::Input::InputRecorder::RecordFrame(float p_deltaTime, const std::vector<KeyEvent>& p_events)
+{
+	if (!m_file)
+		return;
+
+	/* Only the key is written : an event always toggles the state of its key */
+	const uint8_t eventCount = static_cast<uint8_t>(std::min<size_t>(p_events.size(), UINT8_MAX));
+
+	Write(m_file, p_deltaTime);
+	Write(m_file, eventCount);
+
+	for (uint8_t i = 0; i < eventCount; ++i)
+		Write(m_file, p_events[i].key);
+
+	++m_frameCount;
+}
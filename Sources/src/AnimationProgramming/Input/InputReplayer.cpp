@@ -0,0 +1,106 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "AnimationProgramming/Input/InputRecorder.h"
+#include "AnimationProgramming/Input/InputReplayer.h"
+
+namespace
+{
+	/* Magic and version */
+	constexpr size_t kHeaderSize = 2 * sizeof(uint32_t);
+
+	/* Delta time and number of events */
+	constexpr size_t kFrameHeaderSize = sizeof(float) + sizeof(uint8_t);
+}
+
+AnimationProgramming::Input::InputReplayer::InputReplayer(const std::string& p_path) :
+	m_frameCount(0),
+	m_cursor(kHeaderSize),
+	m_frame(0)
+{
+	Rewind();
+
+	std::ifstream file(p_path, std::ios::binary);
+
+	if (!file)
+		return;
+
+	std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	uint32_t magic = 0;
+	uint32_t version = 0;
+
+	if (data.size() < kHeaderSize)
+		return;
+
+	std::memcpy(&magic, data.data(), sizeof(uint32_t));
+	std::memcpy(&version, data.data() + sizeof(uint32_t), sizeof(uint32_t));
+
+	if (magic != InputRecorder::Magic || version != InputRecorder::Version)
+		return;
+
+	/* Count the complete frames (A session interrupted while recording may end with a truncated one) */
+	size_t cursor = kHeaderSize;
+
+	while (cursor + kFrameHeaderSize <= data.size() && cursor + kFrameHeaderSize + data[cursor + sizeof(float)] <= data.size())
+	{
+		cursor += kFrameHeaderSize + data[cursor + sizeof(float)];
+		++m_frameCount;
+	}
+
+	m_data = std::move(data);
+}
+
+bool AnimationProgramming::Input::InputReplayer::IsLoaded() const
+{
+	return !m_data.empty();
+}
+
+uint32_t AnimationProgramming::Input::InputReplayer::GetFrameCount() const
+{
+	return m_frameCount;
+}
+
+bool AnimationProgramming::Input::InputReplayer::IsFinished() const
+{
+	return m_frame >= m_frameCount;
+}
+
+void AnimationProgramming::Input::InputReplayer::Rewind()
+{
+	m_cursor = kHeaderSize;
+	m_frame = 0;
+	std::memset(m_keyStates, 0, sizeof(m_keyStates));
+}
+
+bool AnimationProgramming::Input::InputReplayer::ReadFrame(float& p_deltaTime, std::vector<KeyEvent>& p_events)
+{
+	if (IsFinished())
+		return false;
+
+	const uint8_t eventCount = m_data[m_cursor + sizeof(float)];
+
+	std::memcpy(&p_deltaTime, m_data.data() + m_cursor, sizeof(float));
+	m_cursor += kFrameHeaderSize;
+
+	p_events.clear();
+
+	for (uint8_t i = 0; i < eventCount; ++i)
+	{
+		const uint8_t key = m_data[m_cursor++];
+
+		m_keyStates[key] = !m_keyStates[key];
+		p_events.push_back({ key, m_keyStates[key] });
+	}
+
+	++m_frame;
+
+	return true;
+}
@@ -7,6 +7,7 @@
 #include "AnimationProgramming/Core/AnimationEngine.h"
 #include "AnimationProgramming/Simulations/CSimulation.h"
 #include "AnimationProgramming/Tools/IniManager.h"
+#include "AnimationProgramming/Tools/SIMD.h"
 
 using namespace AnimationProgramming;
 using namespace AnimationProgramming::Core;
@@ -16,6 +17,7 @@ using namespace AnimationProgramming::Simulations;
 int main()
 { 
 	IniManager::Initialize();
+	SIMD::Initialize();
 
 	CSimulation simulation;
 
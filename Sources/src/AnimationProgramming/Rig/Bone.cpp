@@ -67,11 +67,21 @@ uint32_t AnimationProgramming::Rig::Bone::GetIndex()
 	return m_index;
 }
 
+const std::string& AnimationProgramming::Rig::Bone::GetName() const
+{
+	return m_name;
+}
+
 AnimationProgramming::Data::Transform & AnimationProgramming::Rig::Bone::GetTransform()
 {
 	return m_transform;
 }
 
+const AnimationProgramming::Data::Transform & AnimationProgramming::Rig::Bone::GetTransform() const
+{
+	return m_transform;
+}
+
 AnimationProgramming::Data::Transform & AnimationProgramming::Rig::Bone::GetDefaultTransform()
 {
 	return m_defaultTransform;
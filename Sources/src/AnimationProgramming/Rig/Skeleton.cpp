@@ -4,14 +4,36 @@
 * @version 1.0
 */
 
+#include <algorithm>
+#include <limits>
+
 #include "AnimationProgramming/Rig/Skeleton.h"
+#include "AnimationProgramming/Rig/SkeletonDefinition.h"
 
 void AnimationProgramming::Rig::Skeleton::CreateSkeletonFromBindPose()
 {
+	m_definition.reset();
 	CreateBones();
 	DefineBonesParent();
 }
 
+void AnimationProgramming::Rig::Skeleton::CreateSkeletonFromDescription(const std::vector<BoneDescription>& p_bones)
+{
+	/* Every bone is created before the parents are set : the bones must not move once they are linked */
+	m_definition.reset();
+	m_bones.clear();
+	m_bones.reserve(p_bones.size());
+
+	for (uint32_t boneIndex = 0; boneIndex < p_bones.size(); ++boneIndex)
+		m_bones.emplace_back(p_bones[boneIndex].name, boneIndex, p_bones[boneIndex].bindPose.first, p_bones[boneIndex].bindPose.second);
+
+	for (uint32_t boneIndex = 0; boneIndex < p_bones.size(); ++boneIndex)
+	{
+		if (p_bones[boneIndex].parentIndex != -1)
+			m_bones[boneIndex].SetParent(m_bones[p_bones[boneIndex].parentIndex]);
+	}
+}
+
 void AnimationProgramming::Rig::Skeleton::CreateBones()
 {
 	for (uint32_t boneIndex = 0; boneIndex < Core::AnimationEngine::GetSkeletonBoneCount(); ++boneIndex)
@@ -36,4 +58,42 @@ void AnimationProgramming::Rig::Skeleton::DefineBonesParent()
 std::vector<AnimationProgramming::Rig::Bone>& AnimationProgramming::Rig::Skeleton::GetBones()
 {
 	return m_bones;
+}
+
+uint32_t AnimationProgramming::Rig::Skeleton::FindBone(const std::string& p_name) const
+{
+	auto found = std::find_if(m_bones.begin(), m_bones.end(), [&p_name](const Bone& p_bone) { return p_bone.GetName() == p_name; });
+	return found != m_bones.end() ? static_cast<uint32_t>(found - m_bones.begin()) : std::numeric_limits<uint32_t>::max();
+}
+
+std::shared_ptr<const AnimationProgramming::Rig::SkeletonDefinition> AnimationProgramming::Rig::Skeleton::GetDefinition()
+{
+	if (!m_definition)
+		m_definition = std::make_shared<const SkeletonDefinition>(*this);
+
+	return m_definition;
+}
+
+AnimationProgramming::Data::Matrix3x4 AnimationProgramming::Rig::Skeleton::CalculateWorldMatrix(uint32_t p_boneIndex, const std::vector<Data::Transformation>& p_localPose)
+{
+	Bone& bone = m_bones[p_boneIndex];
+	Data::Transform& defaultTransform = bone.GetDefaultTransform();
+	const auto&[position, rotation] = p_localPose[p_boneIndex];
+
+	/* Same rule as Bone::SetRelativePositionAndRotation : the pose is relative to the bind pose */
+	const Data::Matrix3x4 localMatrix(defaultTransform.GetLocalPosition() + position, defaultTransform.GetLocalRotation() * rotation);
+
+	return bone.HasParent() ? CalculateWorldMatrix(bone.GetParent().GetIndex(), p_localPose) * localMatrix : localMatrix;
+}
+
+void AnimationProgramming::Rig::Skeleton::SaveSnapshot(Tools::Snapshot& p_snapshot) const
+{
+	for (const Bone& bone : m_bones)
+		bone.GetTransform().SaveSnapshot(p_snapshot);
+}
+
+void AnimationProgramming::Rig::Skeleton::RestoreSnapshot(Tools::Snapshot& p_snapshot)
+{
+	for (Bone& bone : m_bones)
+		bone.GetTransform().RestoreSnapshot(p_snapshot);
 }
\ No newline at end of file
@@ -0,0 +1,225 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+#include <limits>
+
+#include "AnimationProgramming/Rig/SkeletonDefinition.h"
+#include "AnimationProgramming/Tools/Math.h"
+
+AnimationProgramming::Rig::SkeletonDefinition::SkeletonDefinition(Skeleton& p_skeleton)
+{
+	std::vector<Bone>& bones = p_skeleton.GetBones();
+
+	m_names.resize(bones.size());
+	m_parents.resize(bones.size());
+	m_bindPose.resize(bones.size());
+	m_paletteIndices.resize(bones.size());
+
+	/* The palette keeps the bones order, without the IK bones (Like Animator::CalculateMatrixPalette) */
+	for (Bone& bone : bones)
+	{
+		const uint32_t index = bone.GetIndex();
+		Data::Transform& defaultTransform = bone.GetDefaultTransform();
+
+		m_names[index] = bone.GetName();
+		m_parents[index] = bone.HasParent() ? static_cast<int32_t>(bone.GetParent().GetIndex()) : -1;
+		m_bindPose[index] = { defaultTransform.GetLocalPosition(), defaultTransform.GetLocalRotation() };
+
+		if (bone.IsIK())
+		{
+			m_paletteIndices[index] = -1;
+		}
+		else
+		{
+			m_paletteIndices[index] = static_cast<int32_t>(m_inverseBindPalette.size());
+			m_inverseBindPalette.push_back(defaultTransform.GetWorldMatrix().RigidInverse());
+		}
+	}
+
+	/* Every parent is evaluated before its children */
+	std::vector<bool> added(bones.size(), false);
+
+	for (uint32_t i = 0; i < bones.size(); ++i)
+	{
+		std::vector<uint32_t> chain;
+
+		for (int32_t bone = static_cast<int32_t>(i); bone >= 0 && !added[bone]; bone = m_parents[bone])
+		{
+			chain.push_back(static_cast<uint32_t>(bone));
+			added[bone] = true;
+		}
+
+		m_order.insert(m_order.end(), chain.rbegin(), chain.rend());
+	}
+
+	/* The bind pose never changes, so its inverse dual quaternions are only calculated once */
+	std::vector<Data::DualQuaternion> bindDualQuaternions(bones.size());
+
+	for (uint32_t bone : m_order)
+	{
+		const Data::DualQuaternion local(m_bindPose[bone].first, m_bindPose[bone].second);
+		bindDualQuaternions[bone] = m_parents[bone] >= 0 ? bindDualQuaternions[m_parents[bone]] * local : local;
+	}
+
+	for (uint32_t bone = 0; bone < bones.size(); ++bone)
+	{
+		if (m_paletteIndices[bone] >= 0)
+			m_inverseBindDualQuaternions.push_back(bindDualQuaternions[bone].Inverse());
+	}
+}
+
+uint32_t AnimationProgramming::Rig::SkeletonDefinition::GetBoneCount() const
+{
+	return static_cast<uint32_t>(m_parents.size());
+}
+
+uint32_t AnimationProgramming::Rig::SkeletonDefinition::GetPaletteSize() const
+{
+	return static_cast<uint32_t>(m_inverseBindPalette.size());
+}
+
+const std::string& AnimationProgramming::Rig::SkeletonDefinition::GetName(uint32_t p_bone) const
+{
+	return m_names[p_bone];
+}
+
+uint32_t AnimationProgramming::Rig::SkeletonDefinition::FindBone(const std::string& p_name) const
+{
+	auto found = std::find(m_names.begin(), m_names.end(), p_name);
+	return found != m_names.end() ? static_cast<uint32_t>(found - m_names.begin()) : std::numeric_limits<uint32_t>::max();
+}
+
+const std::vector<int32_t>& AnimationProgramming::Rig::SkeletonDefinition::GetParents() const
+{
+	return m_parents;
+}
+
+const std::vector<uint32_t>& AnimationProgramming::Rig::SkeletonDefinition::GetEvaluationOrder() const
+{
+	return m_order;
+}
+
+const std::vector<AnimationProgramming::Data::Transformation>& AnimationProgramming::Rig::SkeletonDefinition::GetBindPose() const
+{
+	return m_bindPose;
+}
+
+const std::vector<AnimationProgramming::Data::Matrix3x4>& AnimationProgramming::Rig::SkeletonDefinition::GetInverseBindPalette() const
+{
+	return m_inverseBindPalette;
+}
+
+const std::vector<AnimationProgramming::Data::DualQuaternion>& AnimationProgramming::Rig::SkeletonDefinition::GetInverseBindDualQuaternions() const
+{
+	return m_inverseBindDualQuaternions;
+}
+
+const std::vector<int32_t>& AnimationProgramming::Rig::SkeletonDefinition::GetPaletteIndices() const
+{
+	return m_paletteIndices;
+}
+
+std::vector<uint8_t> AnimationProgramming::Rig::SkeletonDefinition::CreateBranchMask(uint32_t p_root) const
+{
+	std::vector<uint8_t> mask(m_parents.size(), 0);
+	mask[p_root] = 1;
+
+	/* The parents come first : a bone is in the branch if its parent is */
+	for (uint32_t bone : m_order)
+	{
+		if (m_parents[bone] >= 0 && mask[m_parents[bone]])
+			mask[bone] = 1;
+	}
+
+	return mask;
+}
+
+void AnimationProgramming::Rig::SkeletonDefinition::CalculateModelMatrices(const std::vector<Data::Transformation>& p_localPose, std::vector<Data::Matrix3x4>& p_modelMatrices) const
+{
+	p_modelMatrices.resize(m_parents.size());
+
+	for (uint32_t bone : m_order)
+	{
+		const auto&[position, rotation] = p_localPose[bone];
+		const Data::Matrix3x4 localMatrix(m_bindPose[bone].first + position, m_bindPose[bone].second * rotation);
+
+		p_modelMatrices[bone] = m_parents[bone] >= 0 ? p_modelMatrices[m_parents[bone]] * localMatrix : localMatrix;
+	}
+}
+
+void AnimationProgramming::Rig::SkeletonDefinition::CalculateSkinningPalette(const std::vector<Data::Matrix3x4>& p_modelMatrices, std::vector<Data::Matrix3x4>& p_palette) const
+{
+	p_palette.resize(m_inverseBindPalette.size());
+
+	for (uint32_t bone = 0; bone < m_paletteIndices.size(); ++bone)
+	{
+		if (m_paletteIndices[bone] >= 0)
+			p_palette[m_paletteIndices[bone]] = p_modelMatrices[bone] * m_inverseBindPalette[m_paletteIndices[bone]];
+	}
+}
+
+void AnimationProgramming::Rig::SkeletonDefinition::CalculateDualQuaternionPalette(const std::vector<Data::Transformation>& p_localPose, std::vector<Data::DualQuaternion>& p_worldDualQuaternions, std::vector<Data::DualQuaternion>& p_palette) const
+{
+	p_worldDualQuaternions.resize(m_parents.size());
+	p_palette.resize(m_inverseBindDualQuaternions.size());
+
+	for (uint32_t bone : m_order)
+	{
+		const auto&[position, rotation] = p_localPose[bone];
+		const Data::DualQuaternion local(m_bindPose[bone].first + position, m_bindPose[bone].second * rotation);
+
+		p_worldDualQuaternions[bone] = m_parents[bone] >= 0 ? p_worldDualQuaternions[m_parents[bone]] * local : local;
+
+		/* Same rule as the matrix palette : BoneCurrentWorld * Inverse(BoneTPoseWorld) */
+		if (m_paletteIndices[bone] >= 0)
+			p_palette[m_paletteIndices[bone]] = p_worldDualQuaternions[bone] * m_inverseBindDualQuaternions[m_paletteIndices[bone]];
+	}
+}
+
+AnimationProgramming::Data::Transformation AnimationProgramming::Rig::SkeletonDefinition::CalculateModelTransformation(uint32_t p_bone, const std::vector<Data::Transformation>& p_localPose) const
+{
+	AltMath::Vector3f position = m_bindPose[p_bone].first + p_localPose[p_bone].first;
+	AltMath::Quaternion rotation = m_bindPose[p_bone].second * p_localPose[p_bone].second;
+
+	for (int32_t parent = m_parents[p_bone]; parent != -1; parent = m_parents[parent])
+	{
+		const AltMath::Quaternion parentRotation = m_bindPose[parent].second * p_localPose[parent].second;
+
+		position = m_bindPose[parent].first + p_localPose[parent].first + parentRotation * position;
+		rotation = parentRotation * rotation;
+	}
+
+	return std::make_pair(position, rotation);
+}
+
+void AnimationProgramming::Rig::SkeletonDefinition::ApplyChainPositions(const uint32_t* p_bones, const AltMath::Vector3f* p_positions, uint32_t p_count, std::vector<Data::Transformation>& p_localPose) const
+{
+	if (p_count < 2)
+		return;
+
+	const int32_t rootParent = m_parents[p_bones[0]];
+	AltMath::Quaternion parentRotation = rootParent != -1 ? CalculateModelTransformation(static_cast<uint32_t>(rootParent), p_localPose).second : AltMath::Quaternion::Identity();
+
+	/* Down the chain, each bone is turned so that its child lands on its position (The world offset cancels out) */
+	for (uint32_t i = 0; i + 1 < p_count; ++i)
+	{
+		const uint32_t bone = p_bones[i];
+		const uint32_t child = p_bones[i + 1];
+		const AltMath::Quaternion world = parentRotation * (m_bindPose[bone].second * p_localPose[bone].second);
+		const AltMath::Vector3f current = world * (m_bindPose[child].first + p_localPose[child].first);
+		const AltMath::Vector3f wanted = p_positions[i + 1] - p_positions[i];
+
+		AltMath::Quaternion wantedWorld = world;
+
+		if (current.LengthSquare() > Tools::Math::MinimumLength2 && wanted.LengthSquare() > Tools::Math::MinimumLength2)
+			wantedWorld = Tools::Math::CalculateRotationBetween(current / current.Length(), wanted / wanted.Length()) * world;
+
+		/* Back to the local space, relative to the bind pose */
+		p_localPose[bone].second = AltMath::Quaternion::Conjugate(m_bindPose[bone].second) * (AltMath::Quaternion::Conjugate(parentRotation) * wantedWorld);
+		parentRotation = wantedWorld;
+	}
+}
@@ -0,0 +1,100 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include "AnimationProgramming/Rig/SkeletonInstance.h"
+
+AnimationProgramming::Rig::SkeletonInstance::SkeletonInstance(std::shared_ptr<const SkeletonDefinition> p_definition) :
+	m_definition(std::move(p_definition)),
+	m_modelMatrices(m_definition->GetBoneCount()),
+	m_skinningPalette(m_definition->GetPaletteSize())
+{
+	ResetToBindPose();
+	UpdateModelMatrices();
+	CalculateSkinningPalette();
+}
+
+const AnimationProgramming::Rig::SkeletonDefinition& AnimationProgramming::Rig::SkeletonInstance::GetDefinition() const
+{
+	return *m_definition;
+}
+
+std::vector<AnimationProgramming::Data::Transformation>& AnimationProgramming::Rig::SkeletonInstance::GetLocalPose()
+{
+	return m_localPose;
+}
+
+const std::vector<AnimationProgramming::Data::Transformation>& AnimationProgramming::Rig::SkeletonInstance::GetLocalPose() const
+{
+	return m_localPose;
+}
+
+void AnimationProgramming::Rig::SkeletonInstance::ResetToBindPose()
+{
+	m_localPose.assign(m_definition->GetBoneCount(), { AltMath::Vector3f(0.0f, 0.0f, 0.0f), AltMath::Quaternion::Identity() });
+}
+
+void AnimationProgramming::Rig::SkeletonInstance::UpdateModelMatrices()
+{
+	m_definition->CalculateModelMatrices(m_localPose, m_modelMatrices);
+}
+
+void AnimationProgramming::Rig::SkeletonInstance::CalculateSkinningPalette()
+{
+	m_definition->CalculateSkinningPalette(m_modelMatrices, m_skinningPalette);
+}
+
+void AnimationProgramming::Rig::SkeletonInstance::CalculateDualQuaternionPalette()
+{
+	m_definition->CalculateDualQuaternionPalette(m_localPose, m_worldDualQuaternions, m_dualQuaternionPalette);
+}
+
+const std::vector<AnimationProgramming::Data::Matrix3x4>& AnimationProgramming::Rig::SkeletonInstance::GetModelMatrices() const
+{
+	return m_modelMatrices;
+}
+
+const std::vector<AnimationProgramming::Data::Matrix3x4>& AnimationProgramming::Rig::SkeletonInstance::GetSkinningPalette() const
+{
+	return m_skinningPalette;
+}
+
+std::vector<AnimationProgramming::Data::Matrix3x4>& AnimationProgramming::Rig::SkeletonInstance::GetSkinningPalette()
+{
+	return m_skinningPalette;
+}
+
+const std::vector<AnimationProgramming::Data::DualQuaternion>& AnimationProgramming::Rig::SkeletonInstance::GetDualQuaternionPalette() const
+{
+	return m_dualQuaternionPalette;
+}
+
+std::vector<AnimationProgramming::Data::DualQuaternion>& AnimationProgramming::Rig::SkeletonInstance::GetDualQuaternionPalette()
+{
+	return m_dualQuaternionPalette;
+}
+
+size_t AnimationProgramming::Rig::SkeletonInstance::GetMemorySize() const
+{
+	return sizeof(SkeletonInstance) + m_localPose.capacity() * sizeof(Data::Transformation)
+		+ (m_modelMatrices.capacity() + m_skinningPalette.capacity()) * sizeof(Data::Matrix3x4)
+		+ (m_worldDualQuaternions.capacity() + m_dualQuaternionPalette.capacity()) * sizeof(Data::DualQuaternion);
+}
+
+void AnimationProgramming::Rig::SkeletonInstance::SaveSnapshot(Tools::Snapshot& p_snapshot) const
+{
+	p_snapshot.WriteArray(m_localPose);
+	p_snapshot.WriteArray(m_modelMatrices);
+	p_snapshot.WriteArray(m_skinningPalette);
+	p_snapshot.WriteArray(m_dualQuaternionPalette);
+}
+
+void AnimationProgramming::Rig::SkeletonInstance::RestoreSnapshot(Tools::Snapshot& p_snapshot)
+{
+	p_snapshot.ReadArray(m_localPose);
+	p_snapshot.ReadArray(m_modelMatrices);
+	p_snapshot.ReadArray(m_skinningPalette);
+	p_snapshot.ReadArray(m_dualQuaternionPalette);
+}
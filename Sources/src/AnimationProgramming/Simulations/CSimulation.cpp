@@ -4,6 +4,8 @@
 * @version 1.0
 */
 
+#include <cmath>
+
 #include "AnimationProgramming/Core/AnimationEngine.h"
 #include "AnimationProgramming/Simulations/CSimulation.h"
 #include "AnimationProgramming/Tools/IniManager.h"
@@ -24,6 +26,13 @@ void AnimationProgramming::Simulations::CSimulation::Init()
 	CreateCustomAnimations();
 	CreateAnimationInstances();
 	CreateSkeleton();
+	CreateSyncGroups();
+	CreateTransitionIndex();
+	CreateLimbIK();
+	CreateLookAt();
+	CreateFootPlanting();
+	CreateInputRecording();
+	CreatePoseCapture();
 	PlayDefaultAnimation();
 	PrintHelpTip();
 }
@@ -118,8 +127,161 @@ void AnimationProgramming::Simulations::CSimulation::CreateSkeleton()
 	m_skeleton.CreateSkeletonFromBindPose();
 }
 
+void AnimationProgramming::Simulations::CSimulation::CreateSyncGroups()
+{
+	uint32_t leftFoot = Core::AnimationEngine::GetSkeletonBoneIndex("foot_l");
+	uint32_t rightFoot = Core::AnimationEngine::GetSkeletonBoneIndex("foot_r");
+
+	/* The markers are detected once : the runtime only reads the phase tables */
+	m_walkSyncMarkers = std::make_unique<Animation::SyncMarkerTrack>(Animation::SyncMarkerTrack::CreateFromFootContacts(m_skeleton, *m_walkAnimationInstance, leftFoot, rightFoot));
+	m_runSyncMarkers = std::make_unique<Animation::SyncMarkerTrack>(Animation::SyncMarkerTrack::CreateFromFootContacts(m_skeleton, *m_runAnimationInstance, leftFoot, rightFoot));
+
+	/* Speed 1 is the walk, speed 2 is the run */
+	m_locomotionSyncGroup.AddAnimation(*m_walkSyncMarkers, 1.0f);
+	m_locomotionSyncGroup.AddAnimation(*m_runSyncMarkers, 2.0f);
+	m_locomotionSyncGroup.SetSpeed(1.0f);
+}
+
+void AnimationProgramming::Simulations::CSimulation::CreateTransitionIndex()
+{
+	if (!Tools::IniManager::Animation->Get<bool>("use_transition_index"))
+		return;
+
+	const std::vector<const Animation::AnimationInstance*> animations = { m_walkAnimationInstance.get(), m_runAnimationInstance.get(), m_dabAnimationInstance.get(), m_squatAnimationInstance.get() };
+
+	/* The analysis is quadratic in the number of keys : it is only done when the animations changed since the cache was written */
+	Tools::ThreadPool threadPool;
+	m_transitionIndex.LoadOrBuild(Tools::IniManager::Animation->Get<std::string>("transition_index_cache"), *m_skeleton.GetDefinition(), animations, &threadPool);
+
+	m_animator.SetTransitionIndex(&m_transitionIndex);
+}
+
+void AnimationProgramming::Simulations::CSimulation::CreateLimbIK()
+{
+	if (!Tools::IniManager::Animation->Get<bool>("use_limb_ik"))
+		return;
+
+	/* The limbs reach the IK bones of the played animations (ik_foot_l, ik_foot_r...), only loaded when the limbs are used */
+	for (Animation::AnimationInfo* animation : { m_walkAnimation.get(), m_runAnimation.get(), m_dabAnimation.get(), m_squatAnimation.get() })
+		animation->LoadIKBoneTransformations();
+
+	m_limbIK = std::make_unique<Animation::LimbIK>(*m_skeleton.GetDefinition());
+	m_limbIK->AddMannequinLimbs();
+
+	m_animator.SetLimbIK(m_limbIK.get());
+}
+
+void AnimationProgramming::Simulations::CSimulation::CreateLookAt()
+{
+	if (!Tools::IniManager::Animation->Get<bool>("use_look_at"))
+		return;
+
+	const std::vector<uint32_t> chain =
+	{
+		Core::AnimationEngine::GetSkeletonBoneIndex("spine_02"),
+		Core::AnimationEngine::GetSkeletonBoneIndex("neck_01"),
+		Core::AnimationEngine::GetSkeletonBoneIndex("head")
+	};
+
+	/* The face is along Y in the space of the head. The spine and the neck take a quarter of the rotation each, the head turns by 70 degrees at most */
+	m_lookAt = std::make_unique<Animation::AimConstraints>(*m_skeleton.GetDefinition());
+	const uint32_t constraint = m_lookAt->AddLookAt(chain, AltMath::Vector3f(0.0f, 1.0f, 0.0f), 1.22f, { 0.25f, 0.25f });
+
+	if (constraint == m_lookAt->GetConstraintCount() - 1)
+	{
+		/* A point on the left of the character, at the height of its eyes */
+		m_animator.SetAimConstraints(m_lookAt.get());
+		m_animator.SetAimTarget(constraint, AltMath::Vector3f(150.0f, 200.0f, 160.0f));
+	}
+}
+
+void AnimationProgramming::Simulations::CSimulation::CreateFootPlanting()
+{
+	if (!Tools::IniManager::Animation->Get<bool>("use_foot_planting"))
+		return;
+
+	const uint32_t pelvis = Core::AnimationEngine::GetSkeletonBoneIndex("pelvis");
+	const uint32_t leftFoot = Core::AnimationEngine::GetSkeletonBoneIndex("foot_l");
+	const uint32_t rightFoot = Core::AnimationEngine::GetSkeletonBoneIndex("foot_r");
+
+	/* Gentle waves around the character (16m x 16m) */
+	const uint32_t sampleCount = 65;
+	const float cellSize = 25.0f;
+
+	m_ground = std::make_unique<Animation::HeightfieldGroundProvider>(sampleCount, sampleCount, cellSize, AltMath::Vector2f(-800.0f, -800.0f));
+
+	for (uint32_t y = 0; y < sampleCount; ++y)
+		for (uint32_t x = 0; x < sampleCount; ++x)
+			m_ground->SetHeight(x, y, 8.0f * std::sin(static_cast<float>(x) * 0.6f) * std::cos(static_cast<float>(y) * 0.4f));
+
+	m_walkFootContacts = std::make_unique<Animation::FootContactTrack>(m_skeleton, *m_walkAnimation, leftFoot, rightFoot);
+	m_runFootContacts = std::make_unique<Animation::FootContactTrack>(m_skeleton, *m_runAnimation, leftFoot, rightFoot);
+
+	m_footPlanting = std::make_unique<Animation::FootPlanting>(*m_skeleton.GetDefinition(), pelvis, leftFoot, rightFoot);
+	m_footPlanting->AddContactTrack(*m_walkFootContacts);
+	m_footPlanting->AddContactTrack(*m_runFootContacts);
+
+	if (m_footPlanting->IsValid())
+		m_animator.SetFootPlanting(m_footPlanting.get(), m_ground.get());
+}
+
+void AnimationProgramming::Simulations::CSimulation::CreateInputRecording()
+{
+	const std::string recordingFile = Tools::IniManager::Animation->Get<std::string>("input_recording_file");
+
+	/* A replayed session can't be recorded over the file it is read from */
+	if (Tools::IniManager::Animation->Get<bool>("replay_inputs"))
+	{
+		m_inputReplayer = std::make_unique<Input::InputReplayer>(recordingFile);
+
+		if (m_inputReplayer->IsLoaded())
+			std::cout << "Replaying " << m_inputReplayer->GetFrameCount() << " frames of inputs from " << recordingFile << "\n";
+		else
+			m_inputReplayer.reset();
+	}
+	else if (Tools::IniManager::Animation->Get<bool>("record_inputs"))
+	{
+		m_inputRecorder = std::make_unique<Input::InputRecorder>(recordingFile);
+
+		if (m_inputRecorder->IsOpen())
+			std::cout << "Recording the inputs to " << recordingFile << "\n";
+		else
+			m_inputRecorder.reset();
+	}
+}
+
+void AnimationProgramming::Simulations::CSimulation::CreatePoseCapture()
+{
+	if (!Tools::IniManager::Animation->Get<bool>("capture_poses"))
+		return;
+
+	const std::string captureFile = Tools::IniManager::Animation->Get<std::string>("pose_capture_file");
+
+	/* The local pose has every bone, the palette skips the IK bones */
+	if (Tools::IniManager::Animation->Get<std::string>("pose_capture_content") == "skinning_palette")
+		m_poseCapture = std::make_unique<Animation::PoseStreamWriter>(captureFile, Animation::EPoseStreamContent::SKINNING_PALETTE, 1, Core::AnimationEngine::GetSkeletonBoneCount());
+	else
+		m_poseCapture = std::make_unique<Animation::PoseStreamWriter>(captureFile, Animation::EPoseStreamContent::LOCAL_POSE, 1, static_cast<uint32_t>(m_skeleton.GetBones().size()));
+
+	if (m_poseCapture->IsOpen())
+		std::cout << "Capturing the poses to " << captureFile << "\n";
+	else
+		m_poseCapture.reset();
+}
+
 void AnimationProgramming::Simulations::CSimulation::PlayDefaultAnimation()
 {
+	const std::string transitionMode = Tools::IniManager::Animation->Get<std::string>("transition_mode");
+
+	if (transitionMode == "inertialization")
+		m_animator.SetTransitionMode(Animation::ETransitionMode::INERTIALIZATION);
+	else if (transitionMode == "stack")
+		m_animator.SetTransitionMode(Animation::ETransitionMode::STACK);
+	else
+		m_animator.SetTransitionMode(Animation::ETransitionMode::CROSSFADE);
+
+	/* The animation ticks at its own rate, the frames show the poses interpolated between ticks */
+	m_animator.SetTickRate(Tools::IniManager::Animation->Get<float>("tick_rate"));
 	m_animator.PlayAnimation(*m_walkAnimationInstance);
 }
 
@@ -140,6 +302,7 @@ void AnimationProgramming::Simulations::CSimulation::DisplayInputs()
 	std::cout << "# - [N] to speed down the animator          #\n";
 	std::cout << "# - [M] to speed up the animator            #\n";
 	std::cout << "# - [J] to reset the speed of the animator  #\n";
+	std::cout << "# - [B] to change the transition mode       #\n";
 	std::cout << "#                                           #\n";
 	std::cout << "############# RENDERING INPUTS ##############\n";
 	std::cout << "#                                           #\n";
@@ -151,6 +314,8 @@ void AnimationProgramming::Simulations::CSimulation::DisplayInputs()
 	std::cout << "#                                           #\n";
 	std::cout << "# - [1][2][3][4] to change animation        #\n";
 	std::cout << "# - [5] to play bind pose (T-Pose)          #\n";
+	std::cout << "# - [6] to play the walk/run blend          #\n";
+	std::cout << "# - [7][8] to slow down/speed up the blend  #\n";
 	std::cout << "# - [F] to print the framerate in console   #\n";
 	std::cout << "# - [H] to re-print the input list          #\n";
 	std::cout << "#                                           #\n";
@@ -159,15 +324,24 @@ void AnimationProgramming::Simulations::CSimulation::DisplayInputs()
 
 void AnimationProgramming::Simulations::CSimulation::Update(float p_deltaTime)
 {
-	CheckInputs(p_deltaTime);
-	UpdateAnimators(p_deltaTime);
+	float deltaTime = p_deltaTime;
+
+	/* A replayed frame replaces the delta time and the keyboard (The keyboard takes over at the end of the recording) */
+	if (m_inputReplayer && m_inputReplayer->ReadFrame(deltaTime, m_replayedKeyEvents))
+		m_inputManager.Update(m_replayedKeyEvents);
+	else
+		m_inputManager.Update();
+
+	if (m_inputRecorder)
+		m_inputRecorder->RecordFrame(deltaTime, m_inputManager.GetFrameEvents());
+
+	CheckInputs(deltaTime);
+	UpdateAnimators(deltaTime);
 	DrawScene();
 }
 
 void AnimationProgramming::Simulations::CSimulation::CheckInputs(float p_deltaTime)
 {
-	m_inputManager.Update();
-
 	if (m_inputManager.IsKeyEventOccured('1'))
 		m_animator.PlayAnimation(*m_walkAnimationInstance);
 
@@ -183,6 +357,15 @@ void AnimationProgramming::Simulations::CSimulation::CheckInputs(float p_deltaTi
 	if (m_inputManager.IsKeyEventOccured('5'))
 		m_animator.StopAnimation();
 
+	if (m_inputManager.IsKeyEventOccured('6'))
+		m_animator.PlayPoseSource(m_locomotionSyncGroup, m_walkAnimationInstance->transitionDuration);
+
+	if (m_inputManager.IsKeyEventOccured('7'))
+		ChangeLocomotionSpeed(-0.25f);
+
+	if (m_inputManager.IsKeyEventOccured('8'))
+		ChangeLocomotionSpeed(0.25f);
+
 	if (m_inputManager.IsKeyEventOccured('I'))
 		m_animator.GetTimeline().ToggleEffector(Animation::ETimelineEffector::IGNORE_FRAME_INTERPOLATION);
 
@@ -210,6 +393,9 @@ void AnimationProgramming::Simulations::CSimulation::CheckInputs(float p_deltaTi
 	if (m_inputManager.IsKeyEventOccured('J'))
 		m_animator.SetGlobalSpeedCoefficient(1.0f);
 
+	if (m_inputManager.IsKeyEventOccured('B'))
+		ToggleTransitionMode();
+
 	if (m_inputManager.IsKeyEventOccured('G'))
 		Tools::IniManager::Rendering->Set<bool>("show_gizmo", !Tools::IniManager::Rendering->Get<bool>("show_gizmo"));
 
@@ -241,6 +427,13 @@ void AnimationProgramming::Simulations::CSimulation::CheckInputs(float p_deltaTi
 void AnimationProgramming::Simulations::CSimulation::UpdateAnimators(float p_deltaTime)
 {
 	m_animator.Update(p_deltaTime);
+
+	if (m_poseCapture)
+	{
+		m_poseCapture->CaptureLocalPose(0, m_animator.GetLocalPose());
+		m_poseCapture->CaptureSkinningPalette(0, m_animator.GetSkinningPalette());
+		m_poseCapture->SubmitFrame();
+	}
 }
 
 void AnimationProgramming::Simulations::CSimulation::DrawScene()
@@ -252,7 +445,11 @@ void AnimationProgramming::Simulations::CSimulation::DrawScene()
 		Rendering::Renderer::DrawGizmo(Data::Color::Red, Data::Color::Green, Data::Color::Blue, Tools::IniManager::Rendering->Get<float>("gizmo_size"));
 
 	if (Tools::IniManager::Rendering->Get<bool>("show_skeleton"))
+	{
+		/* The bones may lag behind the pose if it came from a pose cache */
+		m_animator.UpdateSkeleton();
 		m_skeletonDrawer.Draw(m_skeleton, AltMath::Vector3f::Zero);
+	}
 
 	if (Tools::IniManager::Rendering->Get<bool>("show_timeline") && m_animator.HasAnimation())
 		m_timelineDrawer.Draw(m_animator.GetTimeline(), AltMath::Vector3f(0.0f, 0.0, 225.0f));
@@ -266,6 +463,33 @@ void AnimationProgramming::Simulations::CSimulation::ToggleWireframe()
 	Rendering::Renderer::SetDrawMode(Rendering::Renderer::GetDrawMode() == Rendering::EDrawMode::WIREFRAME ? Rendering::EDrawMode::NORMAL : Rendering::EDrawMode::WIREFRAME);
 }
 
+void AnimationProgramming::Simulations::CSimulation::ToggleTransitionMode()
+{
+	switch (m_animator.GetTransitionMode())
+	{
+	case Animation::ETransitionMode::CROSSFADE:
+		m_animator.SetTransitionMode(Animation::ETransitionMode::INERTIALIZATION);
+		std::cout << "Transition mode: inertialization" << std::endl;
+		break;
+
+	case Animation::ETransitionMode::INERTIALIZATION:
+		m_animator.SetTransitionMode(Animation::ETransitionMode::STACK);
+		std::cout << "Transition mode: stack" << std::endl;
+		break;
+
+	case Animation::ETransitionMode::STACK:
+		m_animator.SetTransitionMode(Animation::ETransitionMode::CROSSFADE);
+		std::cout << "Transition mode: crossfade" << std::endl;
+		break;
+	}
+}
+
+void AnimationProgramming::Simulations::CSimulation::ChangeLocomotionSpeed(float p_offset)
+{
+	m_locomotionSyncGroup.SetSpeed(std::clamp(m_locomotionSyncGroup.GetSpeed() + p_offset, 1.0f, 2.0f));
+	std::cout << "Locomotion speed: " << m_locomotionSyncGroup.GetSpeed() << " (1 = walk, 2 = run)" << std::endl;
+}
+
 void AnimationProgramming::Simulations::CSimulation::PrintFramerate(float p_deltaTime)
 {
 	std::cout << "Actual Framerate: " << 1.0f / p_deltaTime << " FPS" << std::endl;
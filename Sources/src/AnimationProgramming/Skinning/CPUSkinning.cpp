@@ -0,0 +1,355 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <immintrin.h>
+
+#include "AnimationProgramming/Skinning/CPUSkinning.h"
+#include "AnimationProgramming/Tools/SIMD.h"
+#include "AnimationProgramming/Tools/SIMDTarget.h"
+
+namespace
+{
+	using namespace AnimationProgramming;
+
+	/* The kernels address the palette as one float array, 12 floats per bone */
+	static_assert(sizeof(Data::Matrix3x4) == 12 * sizeof(float), "Matrix3x4 must be tightly packed");
+
+	constexpr uint8_t kMaxInfluences = Skinning::SkinWeights::MaxInfluences;
+
+	/**
+	* Raw pointers to every array used by the kernels
+	*/
+	struct SkinningStreams final
+	{
+		const float* palette;
+		const float* positions[3];
+		const float* normals[3];
+		const int32_t* boneIndices[kMaxInfluences];
+		const float* weights[kMaxInfluences];
+		float* skinnedPositions[3];
+		float* skinnedNormals[3];
+	};
+
+	void SkinScalar(const SkinningStreams& p_streams, uint32_t p_begin, uint32_t p_end)
+	{
+		for (uint32_t vertex = p_begin; vertex < p_end; ++vertex)
+		{
+			/* Blend the matrices first, so the vertex is transformed only once */
+			float blended[12] = {};
+
+			for (uint8_t influence = 0; influence < kMaxInfluences; ++influence)
+			{
+				const float weight = p_streams.weights[influence][vertex];
+				const float* matrix = p_streams.palette + p_streams.boneIndices[influence][vertex] * 12;
+
+				for (uint8_t element = 0; element < 12; ++element)
+					blended[element] += weight * matrix[element];
+			}
+
+			const float x = p_streams.positions[0][vertex], y = p_streams.positions[1][vertex], z = p_streams.positions[2][vertex];
+			const float nx = p_streams.normals[0][vertex], ny = p_streams.normals[1][vertex], nz = p_streams.normals[2][vertex];
+
+			float normal[3];
+
+			for (uint8_t row = 0; row < 3; ++row)
+			{
+				const float* rowElements = blended + row * 4;
+				p_streams.skinnedPositions[row][vertex] = rowElements[0] * x + rowElements[1] * y + rowElements[2] * z + rowElements[3];
+				normal[row] = rowElements[0] * nx + rowElements[1] * ny + rowElements[2] * nz;
+			}
+
+			const float lengthSquare = normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2];
+			const float inverseLength = lengthSquare > 0.0f ? 1.0f / std::sqrt(lengthSquare) : 0.0f;
+
+			for (uint8_t axis = 0; axis < 3; ++axis)
+				p_streams.skinnedNormals[axis][vertex] = normal[axis] * inverseLength;
+		}
+	}
+
+	SIMD_TARGET_SSE41 void SkinSSE41(const SkinningStreams& p_streams, uint32_t p_begin, uint32_t p_end)
+	{
+		for (uint32_t vertex = p_begin; vertex < p_end; ++vertex)
+		{
+			/* One register per row of the blended matrix */
+			__m128 row0 = _mm_setzero_ps();
+			__m128 row1 = _mm_setzero_ps();
+			__m128 row2 = _mm_setzero_ps();
+
+			for (uint8_t influence = 0; influence < kMaxInfluences; ++influence)
+			{
+				const __m128 weight = _mm_set1_ps(p_streams.weights[influence][vertex]);
+				const float* matrix = p_streams.palette + p_streams.boneIndices[influence][vertex] * 12;
+
+				row0 = _mm_add_ps(row0, _mm_mul_ps(weight, _mm_load_ps(matrix + 0)));
+				row1 = _mm_add_ps(row1, _mm_mul_ps(weight, _mm_load_ps(matrix + 4)));
+				row2 = _mm_add_ps(row2, _mm_mul_ps(weight, _mm_load_ps(matrix + 8)));
+			}
+
+			/* Transposing gives the columns, so the vertex is transformed with multiplications and additions only (No horizontal operation) */
+			__m128 translation = _mm_setzero_ps();
+			_MM_TRANSPOSE4_PS(row0, row1, row2, translation);
+
+			const __m128 position = _mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(row0, _mm_set1_ps(p_streams.positions[0][vertex])),
+				_mm_mul_ps(row1, _mm_set1_ps(p_streams.positions[1][vertex]))), _mm_add_ps(
+				_mm_mul_ps(row2, _mm_set1_ps(p_streams.positions[2][vertex])), translation));
+
+			const __m128 normal = _mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(row0, _mm_set1_ps(p_streams.normals[0][vertex])),
+				_mm_mul_ps(row1, _mm_set1_ps(p_streams.normals[1][vertex]))),
+				_mm_mul_ps(row2, _mm_set1_ps(p_streams.normals[2][vertex])));
+
+			/* 0x7F : dot product of x, y and z, broadcasted to every component */
+			const __m128 lengthSquare = _mm_dp_ps(normal, normal, 0x7F);
+			const __m128 inverseLength = _mm_and_ps(_mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lengthSquare)), _mm_cmpgt_ps(lengthSquare, _mm_setzero_ps()));
+
+			alignas(16) float skinnedPosition[4];
+			alignas(16) float skinnedNormal[4];
+			_mm_store_ps(skinnedPosition, position);
+			_mm_store_ps(skinnedNormal, _mm_mul_ps(normal, inverseLength));
+
+			for (uint8_t axis = 0; axis < 3; ++axis)
+			{
+				p_streams.skinnedPositions[axis][vertex] = skinnedPosition[axis];
+				p_streams.skinnedNormals[axis][vertex] = skinnedNormal[axis];
+			}
+		}
+	}
+
+	SIMD_TARGET_AVX2 void SkinAVX2(const SkinningStreams& p_streams, uint32_t p_begin, uint32_t p_end)
+	{
+		uint32_t vertex = p_begin;
+
+		/* 8 vertices per iteration. The matrices are blended per vertex (Rows 0 and 1 in one 256 bits register, row 2 in a 128 bits one),
+		then transposed so each register holds the same element for the 8 vertices. Loading whole rows and transposing them is
+		cheaper than gathering each element from the palette */
+		for (; vertex + 8 <= p_end; vertex += 8)
+		{
+			__m256 rows01[8];
+			__m128 rows2[8];
+
+			for (uint8_t lane = 0; lane < 8; ++lane)
+			{
+				rows01[lane] = _mm256_setzero_ps();
+				rows2[lane] = _mm_setzero_ps();
+
+				for (uint8_t influence = 0; influence < kMaxInfluences; ++influence)
+				{
+					const float weight = p_streams.weights[influence][vertex + lane];
+					const float* matrix = p_streams.palette + p_streams.boneIndices[influence][vertex + lane] * 12;
+
+					rows01[lane] = _mm256_fmadd_ps(_mm256_set1_ps(weight), _mm256_loadu_ps(matrix), rows01[lane]);
+					rows2[lane] = _mm_fmadd_ps(_mm_set1_ps(weight), _mm_load_ps(matrix + 8), rows2[lane]);
+				}
+			}
+
+			__m256 blended[12];
+
+			/* 8x8 transpose of rows 0 and 1 (Elements 0 to 7) */
+			const __m256 low01 = _mm256_unpacklo_ps(rows01[0], rows01[1]);
+			const __m256 high01 = _mm256_unpackhi_ps(rows01[0], rows01[1]);
+			const __m256 low23 = _mm256_unpacklo_ps(rows01[2], rows01[3]);
+			const __m256 high23 = _mm256_unpackhi_ps(rows01[2], rows01[3]);
+			const __m256 low45 = _mm256_unpacklo_ps(rows01[4], rows01[5]);
+			const __m256 high45 = _mm256_unpackhi_ps(rows01[4], rows01[5]);
+			const __m256 low67 = _mm256_unpacklo_ps(rows01[6], rows01[7]);
+			const __m256 high67 = _mm256_unpackhi_ps(rows01[6], rows01[7]);
+
+			const __m256 element0123[4] =
+			{
+				_mm256_shuffle_ps(low01, low23, _MM_SHUFFLE(1, 0, 1, 0)),
+				_mm256_shuffle_ps(low01, low23, _MM_SHUFFLE(3, 2, 3, 2)),
+				_mm256_shuffle_ps(high01, high23, _MM_SHUFFLE(1, 0, 1, 0)),
+				_mm256_shuffle_ps(high01, high23, _MM_SHUFFLE(3, 2, 3, 2))
+			};
+
+			const __m256 element4567[4] =
+			{
+				_mm256_shuffle_ps(low45, low67, _MM_SHUFFLE(1, 0, 1, 0)),
+				_mm256_shuffle_ps(low45, low67, _MM_SHUFFLE(3, 2, 3, 2)),
+				_mm256_shuffle_ps(high45, high67, _MM_SHUFFLE(1, 0, 1, 0)),
+				_mm256_shuffle_ps(high45, high67, _MM_SHUFFLE(3, 2, 3, 2))
+			};
+
+			for (uint8_t element = 0; element < 4; ++element)
+			{
+				blended[element] = _mm256_permute2f128_ps(element0123[element], element4567[element], 0x20);
+				blended[element + 4] = _mm256_permute2f128_ps(element0123[element], element4567[element], 0x31);
+			}
+
+			/* 4x4 transpose of row 2 (Elements 8 to 11), vertices 0 to 3 in the low lane and 4 to 7 in the high lane */
+			const __m256 row2Vertices04 = _mm256_set_m128(rows2[4], rows2[0]);
+			const __m256 row2Vertices15 = _mm256_set_m128(rows2[5], rows2[1]);
+			const __m256 row2Vertices26 = _mm256_set_m128(rows2[6], rows2[2]);
+			const __m256 row2Vertices37 = _mm256_set_m128(rows2[7], rows2[3]);
+
+			const __m256 row2Low01 = _mm256_unpacklo_ps(row2Vertices04, row2Vertices15);
+			const __m256 row2High01 = _mm256_unpackhi_ps(row2Vertices04, row2Vertices15);
+			const __m256 row2Low23 = _mm256_unpacklo_ps(row2Vertices26, row2Vertices37);
+			const __m256 row2High23 = _mm256_unpackhi_ps(row2Vertices26, row2Vertices37);
+
+			blended[8] = _mm256_shuffle_ps(row2Low01, row2Low23, _MM_SHUFFLE(1, 0, 1, 0));
+			blended[9] = _mm256_shuffle_ps(row2Low01, row2Low23, _MM_SHUFFLE(3, 2, 3, 2));
+			blended[10] = _mm256_shuffle_ps(row2High01, row2High23, _MM_SHUFFLE(1, 0, 1, 0));
+			blended[11] = _mm256_shuffle_ps(row2High01, row2High23, _MM_SHUFFLE(3, 2, 3, 2));
+
+			const __m256 x = _mm256_loadu_ps(p_streams.positions[0] + vertex);
+			const __m256 y = _mm256_loadu_ps(p_streams.positions[1] + vertex);
+			const __m256 z = _mm256_loadu_ps(p_streams.positions[2] + vertex);
+			const __m256 nx = _mm256_loadu_ps(p_streams.normals[0] + vertex);
+			const __m256 ny = _mm256_loadu_ps(p_streams.normals[1] + vertex);
+			const __m256 nz = _mm256_loadu_ps(p_streams.normals[2] + vertex);
+
+			__m256 normal[3];
+
+			for (uint8_t row = 0; row < 3; ++row)
+			{
+				const __m256* rowElements = blended + row * 4;
+
+				__m256 position = _mm256_fmadd_ps(rowElements[0], x, rowElements[3]);
+				position = _mm256_fmadd_ps(rowElements[1], y, position);
+				position = _mm256_fmadd_ps(rowElements[2], z, position);
+				_mm256_storeu_ps(p_streams.skinnedPositions[row] + vertex, position);
+
+				normal[row] = _mm256_mul_ps(rowElements[0], nx);
+				normal[row] = _mm256_fmadd_ps(rowElements[1], ny, normal[row]);
+				normal[row] = _mm256_fmadd_ps(rowElements[2], nz, normal[row]);
+			}
+
+			__m256 lengthSquare = _mm256_mul_ps(normal[0], normal[0]);
+			lengthSquare = _mm256_fmadd_ps(normal[1], normal[1], lengthSquare);
+			lengthSquare = _mm256_fmadd_ps(normal[2], normal[2], lengthSquare);
+
+			/* A full precision division rather than _mm256_rsqrt_ps, to stay within the tolerance of the scalar path */
+			const __m256 inverseLength = _mm256_and_ps(_mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(lengthSquare)), _mm256_cmp_ps(lengthSquare, _mm256_setzero_ps(), _CMP_GT_OQ));
+
+			for (uint8_t axis = 0; axis < 3; ++axis)
+				_mm256_storeu_ps(p_streams.skinnedNormals[axis] + vertex, _mm256_mul_ps(normal[axis], inverseLength));
+		}
+
+		/* Remaining vertices (Less than 8) */
+		SkinSSE41(p_streams, vertex, p_end);
+	}
+}
+
+void AnimationProgramming::Skinning::CPUSkinning::Skin(const std::vector<Data::Matrix3x4>& p_palette, const VertexBuffer& p_bindPose, const SkinWeights& p_weights, VertexBuffer& p_result)
+{
+	p_result.Resize(p_bindPose.GetVertexCount());
+	SkinRange(p_palette, p_bindPose, p_weights, p_result, 0, p_bindPose.GetVertexCount());
+}
+
+void AnimationProgramming::Skinning::CPUSkinning::Skin(const std::vector<Data::Matrix3x4>& p_palette, const VertexBuffer& p_bindPose, const SkinWeights& p_weights, VertexBuffer& p_result, Tools::ThreadPool& p_threadPool, uint32_t p_chunkSize)
+{
+	p_result.Resize(p_bindPose.GetVertexCount());
+
+	p_threadPool.ParallelFor(p_bindPose.GetVertexCount(), p_chunkSize, [&](uint32_t p_begin, uint32_t p_end)
+	{
+		SkinRange(p_palette, p_bindPose, p_weights, p_result, p_begin, p_end);
+	});
+}
+
+void AnimationProgramming::Skinning::CPUSkinning::SkinRange(const std::vector<Data::Matrix3x4>& p_palette, const VertexBuffer& p_bindPose, const SkinWeights& p_weights, VertexBuffer& p_result, uint32_t p_begin, uint32_t p_end)
+{
+	assert(p_weights.GetVertexCount() == p_bindPose.GetVertexCount());
+	assert(p_result.GetVertexCount() == p_bindPose.GetVertexCount());
+
+	if (p_begin >= p_end || p_palette.empty())
+		return;
+
+	SkinningStreams streams;
+	streams.palette = p_palette.front().elements;
+	streams.positions[0] = p_bindPose.positionsX.data();
+	streams.positions[1] = p_bindPose.positionsY.data();
+	streams.positions[2] = p_bindPose.positionsZ.data();
+	streams.normals[0] = p_bindPose.normalsX.data();
+	streams.normals[1] = p_bindPose.normalsY.data();
+	streams.normals[2] = p_bindPose.normalsZ.data();
+	streams.skinnedPositions[0] = p_result.positionsX.data();
+	streams.skinnedPositions[1] = p_result.positionsY.data();
+	streams.skinnedPositions[2] = p_result.positionsZ.data();
+	streams.skinnedNormals[0] = p_result.normalsX.data();
+	streams.skinnedNormals[1] = p_result.normalsY.data();
+	streams.skinnedNormals[2] = p_result.normalsZ.data();
+
+	for (uint8_t influence = 0; influence < kMaxInfluences; ++influence)
+	{
+		streams.boneIndices[influence] = p_weights.boneIndices[influence].data();
+		streams.weights[influence] = p_weights.weights[influence].data();
+	}
+
+	switch (Tools::SIMD::GetLevel())
+	{
+	case Tools::ESIMDLevel::AVX2:	SkinAVX2(streams, p_begin, p_end);		break;
+	case Tools::ESIMDLevel::SSE41:	SkinSSE41(streams, p_begin, p_end);	break;
+	default:						SkinScalar(streams, p_begin, p_end);	break;
+	}
+}
+
+void AnimationProgramming::Skinning::CPUSkinning::Skin(const std::vector<Data::DualQuaternion>& p_palette, const VertexBuffer& p_bindPose, const SkinWeights& p_weights, VertexBuffer& p_result)
+{
+	p_result.Resize(p_bindPose.GetVertexCount());
+	SkinRange(p_palette, p_bindPose, p_weights, p_result, 0, p_bindPose.GetVertexCount());
+}
+
+void AnimationProgramming::Skinning::CPUSkinning::Skin(const std::vector<Data::DualQuaternion>& p_palette, const VertexBuffer& p_bindPose, const SkinWeights& p_weights, VertexBuffer& p_result, Tools::ThreadPool& p_threadPool, uint32_t p_chunkSize)
+{
+	p_result.Resize(p_bindPose.GetVertexCount());
+
+	p_threadPool.ParallelFor(p_bindPose.GetVertexCount(), p_chunkSize, [&](uint32_t p_begin, uint32_t p_end)
+	{
+		SkinRange(p_palette, p_bindPose, p_weights, p_result, p_begin, p_end);
+	});
+}
+
+void AnimationProgramming::Skinning::CPUSkinning::SkinRange(const std::vector<Data::DualQuaternion>& p_palette, const VertexBuffer& p_bindPose, const SkinWeights& p_weights, VertexBuffer& p_result, uint32_t p_begin, uint32_t p_end)
+{
+	assert(p_weights.GetVertexCount() == p_bindPose.GetVertexCount());
+	assert(p_result.GetVertexCount() == p_bindPose.GetVertexCount());
+
+	if (p_palette.empty())
+		return;
+
+	for (uint32_t vertex = p_begin; vertex < p_end; ++vertex)
+	{
+		Data::DualQuaternion blended;
+		std::fill(std::begin(blended.real), std::end(blended.real), 0.0f);
+
+		const Data::DualQuaternion& first = p_palette[p_weights.boneIndices[0][vertex]];
+
+		for (uint8_t influence = 0; influence < SkinWeights::MaxInfluences; ++influence)
+		{
+			const Data::DualQuaternion& dualQuaternion = p_palette[p_weights.boneIndices[influence][vertex]];
+
+			/* q and -q are the same rotation, the one in the hemisphere of the first influence is used so the blend takes the shortest path */
+			const float hemisphereDot = first.real[0] * dualQuaternion.real[0] + first.real[1] * dualQuaternion.real[1] + first.real[2] * dualQuaternion.real[2] + first.real[3] * dualQuaternion.real[3];
+			const float weight = hemisphereDot < 0.0f ? -p_weights.weights[influence][vertex] : p_weights.weights[influence][vertex];
+
+			for (uint8_t i = 0; i < 4; ++i)
+			{
+				blended.real[i] += weight * dualQuaternion.real[i];
+				blended.dual[i] += weight * dualQuaternion.dual[i];
+			}
+		}
+
+		/* Dividing both parts by the length of the real part gives a unit dual quaternion again (Translation is preserved) */
+		const float lengthSquare = blended.real[0] * blended.real[0] + blended.real[1] * blended.real[1] + blended.real[2] * blended.real[2] + blended.real[3] * blended.real[3];
+		const float inverseLength = lengthSquare > 0.0f ? 1.0f / std::sqrt(lengthSquare) : 0.0f;
+
+		for (uint8_t i = 0; i < 4; ++i)
+		{
+			blended.real[i] *= inverseLength;
+			blended.dual[i] *= inverseLength;
+		}
+
+		const AltMath::Vector3f position = blended.TransformPoint(p_bindPose.GetPosition(vertex));
+		const AltMath::Vector3f normal = blended.TransformVector(p_bindPose.GetNormal(vertex));
+
+		p_result.SetVertex(vertex, position, normal);
+	}
+}
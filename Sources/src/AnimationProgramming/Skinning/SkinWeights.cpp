@@ -0,0 +1,38 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include "AnimationProgramming/Skinning/SkinWeights.h"
+
+void AnimationProgramming::Skinning::SkinWeights::Resize(uint32_t p_vertexCount)
+{
+	for (uint8_t influence = 0; influence < MaxInfluences; ++influence)
+	{
+		boneIndices[influence].resize(p_vertexCount);
+		weights[influence].resize(p_vertexCount);
+	}
+}
+
+uint32_t AnimationProgramming::Skinning::SkinWeights::GetVertexCount() const
+{
+	return static_cast<uint32_t>(weights[0].size());
+}
+
+void AnimationProgramming::Skinning::SkinWeights::SetInfluences(uint32_t p_index, const std::array<uint32_t, MaxInfluences>& p_boneIndices, const std::array<float, MaxInfluences>& p_weights)
+{
+	float weightSum = 0.0f;
+	for (float weight : p_weights)
+		weightSum += weight > 0.0f ? weight : 0.0f;
+
+	const float normalization = weightSum > 0.0f ? 1.0f / weightSum : 0.0f;
+
+	for (uint8_t influence = 0; influence < MaxInfluences; ++influence)
+	{
+		/* An unused influence points to the first bone, its weight of 0 cancels it */
+		const bool isUsed = p_weights[influence] > 0.0f;
+		boneIndices[influence][p_index] = isUsed ? static_cast<int32_t>(p_boneIndices[influence]) : 0;
+		weights[influence][p_index] = isUsed ? p_weights[influence] * normalization : 0.0f;
+	}
+}
@@ -0,0 +1,42 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include "AnimationProgramming/Skinning/VertexBuffer.h"
+
+void AnimationProgramming::Skinning::VertexBuffer::Resize(uint32_t p_vertexCount)
+{
+	positionsX.resize(p_vertexCount);
+	positionsY.resize(p_vertexCount);
+	positionsZ.resize(p_vertexCount);
+	normalsX.resize(p_vertexCount);
+	normalsY.resize(p_vertexCount);
+	normalsZ.resize(p_vertexCount);
+}
+
+uint32_t AnimationProgramming::Skinning::VertexBuffer::GetVertexCount() const
+{
+	return static_cast<uint32_t>(positionsX.size());
+}
+
+void AnimationProgramming::Skinning::VertexBuffer::SetVertex(uint32_t p_index, const AltMath::Vector3f& p_position, const AltMath::Vector3f& p_normal)
+{
+	positionsX[p_index] = p_position.x;
+	positionsY[p_index] = p_position.y;
+	positionsZ[p_index] = p_position.z;
+	normalsX[p_index] = p_normal.x;
+	normalsY[p_index] = p_normal.y;
+	normalsZ[p_index] = p_normal.z;
+}
+
+AltMath::Vector3f AnimationProgramming::Skinning::VertexBuffer::GetPosition(uint32_t p_index) const
+{
+	return AltMath::Vector3f(positionsX[p_index], positionsY[p_index], positionsZ[p_index]);
+}
+
+AltMath::Vector3f AnimationProgramming::Skinning::VertexBuffer::GetNormal(uint32_t p_index) const
+{
+	return AltMath::Vector3f(normalsX[p_index], normalsY[p_index], normalsZ[p_index]);
+}
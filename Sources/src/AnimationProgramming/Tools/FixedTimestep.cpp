@@ -0,0 +1,75 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+
+#include "AnimationProgramming/Tools/FixedTimestep.h"
+
+AnimationProgramming::Tools::FixedTimestep::FixedTimestep(float p_tickRate, uint32_t p_maxTicksPerFrame) :
+	m_tickTime(1.0f / std::max(p_tickRate, 1.0f)),
+	m_maxTicksPerFrame(std::max(p_maxTicksPerFrame, 1u)),
+	m_accumulatedTime(0.0f)
+{
+}
+
+void AnimationProgramming::Tools::FixedTimestep::SetTickRate(float p_tickRate)
+{
+	m_tickTime = 1.0f / std::max(p_tickRate, 1.0f);
+}
+
+float AnimationProgramming::Tools::FixedTimestep::GetTickRate() const
+{
+	return 1.0f / m_tickTime;
+}
+
+float AnimationProgramming::Tools::FixedTimestep::GetTickTime() const
+{
+	return m_tickTime;
+}
+
+uint32_t AnimationProgramming::Tools::FixedTimestep::Advance(float p_deltaTime)
+{
+	m_accumulatedTime += std::max(p_deltaTime, 0.0f);
+
+	uint32_t tickCount = static_cast<uint32_t>(m_accumulatedTime / m_tickTime);
+
+	/* The time beyond the last allowed tick is dropped */
+	if (tickCount > m_maxTicksPerFrame)
+	{
+		tickCount = m_maxTicksPerFrame;
+		m_accumulatedTime = 0.0f;
+	}
+	else
+	{
+		m_accumulatedTime = std::max(m_accumulatedTime - static_cast<float>(tickCount) * m_tickTime, 0.0f);
+	}
+
+	return tickCount;
+}
+
+float AnimationProgramming::Tools::FixedTimestep::GetAlpha() const
+{
+	return std::min(m_accumulatedTime / m_tickTime, 1.0f);
+}
+
+void AnimationProgramming::Tools::FixedTimestep::Reset()
+{
+	m_accumulatedTime = 0.0f;
+}
+
+void AnimationProgramming::Tools::FixedTimestep::SaveSnapshot(Snapshot& p_snapshot) const
+{
+	p_snapshot.Write(m_tickTime);
+	p_snapshot.Write(m_maxTicksPerFrame);
+	p_snapshot.Write(m_accumulatedTime);
+}
+
+void AnimationProgramming::Tools::FixedTimestep::RestoreSnapshot(Snapshot& p_snapshot)
+{
+	p_snapshot.Read(m_tickTime);
+	p_snapshot.Read(m_maxTicksPerFrame);
+	p_snapshot.Read(m_accumulatedTime);
+}
@@ -0,0 +1,195 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+#include <limits>
+
+#include "AnimationProgramming/Tools/KDTree.h"
+
+namespace
+{
+	constexpr uint32_t kNoChild = std::numeric_limits<uint32_t>::max();
+}
+
+void AnimationProgramming::Tools::KDTree::Build(float* p_points, uint32_t p_count, uint32_t p_dimensions, uint32_t p_stride, uint32_t p_leafSize)
+{
+	m_points = p_points;
+	m_count = p_count;
+	m_dimensions = p_dimensions;
+	m_stride = std::max(p_stride, p_dimensions);
+	m_leafSize = std::max(p_leafSize, 1u);
+
+	m_nodes.clear();
+	m_originalIndices.resize(m_count);
+
+	for (uint32_t i = 0; i < m_count; ++i)
+		m_originalIndices[i] = i;
+
+	if (m_count == 0)
+		return;
+
+	/* The tree is built on the indices, the rows are moved once at the end */
+	BuildNode(0, m_count);
+
+	/* Apply the permutation in place, cycle by cycle (Row i receives the original row m_originalIndices[i]) */
+	std::vector<bool> placed(m_count, false);
+	std::vector<float> row(m_stride);
+
+	for (uint32_t start = 0; start < m_count; ++start)
+	{
+		if (placed[start] || m_originalIndices[start] == start)
+			continue;
+
+		std::copy(m_points + static_cast<size_t>(start) * m_stride, m_points + static_cast<size_t>(start + 1) * m_stride, row.begin());
+
+		uint32_t current = start;
+		while (m_originalIndices[current] != start)
+		{
+			const uint32_t source = m_originalIndices[current];
+			std::copy(m_points + static_cast<size_t>(source) * m_stride, m_points + static_cast<size_t>(source + 1) * m_stride, m_points + static_cast<size_t>(current) * m_stride);
+			placed[current] = true;
+			current = source;
+		}
+
+		std::copy(row.begin(), row.end(), m_points + static_cast<size_t>(current) * m_stride);
+		placed[current] = true;
+	}
+}
+
+uint32_t AnimationProgramming::Tools::KDTree::GetCount() const
+{
+	return m_count;
+}
+
+uint32_t AnimationProgramming::Tools::KDTree::GetOriginalIndex(uint32_t p_row) const
+{
+	return m_originalIndices[p_row];
+}
+
+uint32_t AnimationProgramming::Tools::KDTree::FindNearest(const float* p_query, float& p_squaredDistance, uint32_t p_maxLeafVisits) const
+{
+	uint32_t nearest = kNoChild;
+	p_squaredDistance = std::numeric_limits<float>::max();
+
+	if (m_nodes.empty())
+		return nearest;
+
+	/* Depth first, closest child first : a node is skipped when the distance to its splitting plane is already too big */
+	struct PendingNode
+	{
+		uint32_t node;
+		float lowerBound;
+	};
+
+	PendingNode stack[64];
+	uint32_t stackSize = 0;
+	uint32_t leafVisits = 0;
+
+	stack[stackSize++] = { 0, 0.0f };
+
+	while (stackSize > 0)
+	{
+		const PendingNode pending = stack[--stackSize];
+		if (pending.lowerBound >= p_squaredDistance)
+			continue;
+
+		const Node& node = m_nodes[pending.node];
+
+		if (node.children[0] == kNoChild)
+		{
+			for (uint32_t row = node.begin; row < node.end; ++row)
+			{
+				const float distance = CalculateSquaredDistance(p_query, row);
+				if (distance < p_squaredDistance)
+				{
+					p_squaredDistance = distance;
+					nearest = row;
+				}
+			}
+
+			if (p_maxLeafVisits > 0 && ++leafVisits >= p_maxLeafVisits)
+				break;
+
+			continue;
+		}
+
+		const float offset = p_query[node.dimension] - node.split;
+		const uint32_t nearChild = offset < 0.0f ? node.children[0] : node.children[1];
+		const uint32_t farChild = offset < 0.0f ? node.children[1] : node.children[0];
+
+		stack[stackSize++] = { farChild, std::max(pending.lowerBound, offset * offset) };
+		stack[stackSize++] = { nearChild, pending.lowerBound };
+	}
+
+	return nearest;
+}
+
+uint32_t AnimationProgramming::Tools::KDTree::BuildNode(uint32_t p_begin, uint32_t p_end)
+{
+	const uint32_t index = static_cast<uint32_t>(m_nodes.size());
+	m_nodes.push_back({ p_begin, p_end, { kNoChild, kNoChild }, 0, 0.0f });
+
+	if (p_end - p_begin <= m_leafSize)
+		return index;
+
+	/* Split along the dimension with the largest spread */
+	uint32_t splitDimension = 0;
+	float largestSpread = -1.0f;
+
+	for (uint32_t dimension = 0; dimension < m_dimensions; ++dimension)
+	{
+		float minimum = std::numeric_limits<float>::max();
+		float maximum = std::numeric_limits<float>::lowest();
+
+		for (uint32_t i = p_begin; i < p_end; ++i)
+		{
+			const float value = m_points[static_cast<size_t>(m_originalIndices[i]) * m_stride + dimension];
+			minimum = std::min(minimum, value);
+			maximum = std::max(maximum, value);
+		}
+
+		if (maximum - minimum > largestSpread)
+		{
+			largestSpread = maximum - minimum;
+			splitDimension = dimension;
+		}
+	}
+
+	/* Every row is the same point : splitting wouldn't help */
+	if (largestSpread <= 0.0f)
+		return index;
+
+	const uint32_t middle = p_begin + (p_end - p_begin) / 2;
+	auto value = [this, splitDimension](uint32_t p_index) { return m_points[static_cast<size_t>(p_index) * m_stride + splitDimension]; };
+
+	std::nth_element(m_originalIndices.begin() + p_begin, m_originalIndices.begin() + middle, m_originalIndices.begin() + p_end, [&value](uint32_t p_left, uint32_t p_right) { return value(p_left) < value(p_right); });
+
+	const float split = value(m_originalIndices[middle]);
+
+	const uint32_t left = BuildNode(p_begin, middle);
+	const uint32_t right = BuildNode(middle, p_end);
+
+	m_nodes[index].children[0] = left;
+	m_nodes[index].children[1] = right;
+	m_nodes[index].dimension = splitDimension;
+	m_nodes[index].split = split;
+
+	return index;
+}
+
+float AnimationProgramming::Tools::KDTree::CalculateSquaredDistance(const float* p_query, uint32_t p_row) const
+{
+	const float* point = m_points + static_cast<size_t>(p_row) * m_stride;
+	float distance = 0.0f;
+
+	for (uint32_t dimension = 0; dimension < m_dimensions; ++dimension)
+	{
+		const float offset = p_query[dimension] - point[dimension];
+		distance += offset * offset;
+	}
+
+	return distance;
+}
@@ -1,3 +1,6 @@
+#include <cmath>
+#include <cstring>
+
 #include "AnimationProgramming/Tools/Math.h"
 
 AltMath::Quaternion AnimationProgramming::Tools::Math::CreateQuaternionFromEuler(const AltMath::Vector3f & p_euler)
@@ -17,3 +20,125 @@ AltMath::Quaternion AnimationProgramming::Tools::Math::CreateQuaternionFromEuler
 		cy * cp * cr + sy * sp * sr
 	);
 }
+
+AltMath::Vector3f AnimationProgramming::Tools::Math::CalculateOrthogonal(const AltMath::Vector3f& p_direction)
+{
+	AltMath::Vector3f orthogonal = AltMath::Vector3f::CrossProduct(p_direction, AltMath::Vector3f(1.0f, 0.0f, 0.0f));
+
+	if (orthogonal.LengthSquare() < 1e-6f)
+		orthogonal = AltMath::Vector3f::CrossProduct(p_direction, AltMath::Vector3f(0.0f, 1.0f, 0.0f));
+
+	return orthogonal / orthogonal.Length();
+}
+
+AltMath::Vector3f AnimationProgramming::Tools::Math::Normalize(const AltMath::Vector3f& p_vector, const AltMath::Vector3f& p_fallback)
+{
+	const float length2 = p_vector.LengthSquare();
+	return length2 > MinimumLength2 ? p_vector / std::sqrt(length2) : p_fallback;
+}
+
+AltMath::Quaternion AnimationProgramming::Tools::Math::CalculateRotationBetween(const AltMath::Vector3f& p_from, const AltMath::Vector3f& p_to)
+{
+	const float cosine = AltMath::Vector3f::DotProduct(p_from, p_to);
+
+	/* Half a turn around any orthogonal axis */
+	if (cosine < OppositeCosine)
+	{
+		const AltMath::Vector3f axis = CalculateOrthogonal(p_from);
+		return AltMath::Quaternion(axis.x, axis.y, axis.z, 0.0f);
+	}
+
+	/* The half angle comes from normalizing (sin(a) * axis, 1 + cos(a)) */
+	const AltMath::Vector3f axis = AltMath::Vector3f::CrossProduct(p_from, p_to);
+	return AltMath::Quaternion::Normalize(AltMath::Quaternion(axis.x, axis.y, axis.z, 1.0f + cosine));
+}
+
+uint16_t AnimationProgramming::Tools::Math::FloatToHalf(float p_value)
+{
+	uint32_t bits;
+	std::memcpy(&bits, &p_value, sizeof(float));
+
+	const uint32_t sign = (bits >> 16) & 0x8000;
+	const uint32_t exponent = (bits >> 23) & 0xFF;
+	uint32_t mantissa = bits & 0x7FFFFF;
+
+	/* NaN and infinity */
+	if (exponent == 0xFF)
+		return static_cast<uint16_t>(sign | 0x7C00 | (mantissa ? 0x200 : 0));
+
+	const int32_t halfExponent = static_cast<int32_t>(exponent) - 127 + 15;
+
+	/* Too big : infinity */
+	if (halfExponent >= 0x1F)
+		return static_cast<uint16_t>(sign | 0x7C00);
+
+	/* Too small for a normal half : subnormal (Or zero) */
+	if (halfExponent <= 0)
+	{
+		if (halfExponent < -10)
+			return static_cast<uint16_t>(sign);
+
+		mantissa |= 0x800000;
+		const uint32_t shift = static_cast<uint32_t>(14 - halfExponent);
+		uint32_t halfMantissa = mantissa >> shift;
+
+		/* Round to nearest even */
+		const uint32_t remainder = mantissa & ((1u << shift) - 1);
+		const uint32_t halfway = 1u << (shift - 1);
+		if (remainder > halfway || (remainder == halfway && (halfMantissa & 1)))
+			++halfMantissa;
+
+		return static_cast<uint16_t>(sign | halfMantissa);
+	}
+
+	uint32_t half = sign | (static_cast<uint32_t>(halfExponent) << 10) | (mantissa >> 13);
+
+	/* Round to nearest even (A carry into the exponent is still correct, and gives infinity on overflow) */
+	const uint32_t remainder = mantissa & 0x1FFF;
+	if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+		++half;
+
+	return static_cast<uint16_t>(half);
+}
+
+float AnimationProgramming::Tools::Math::HalfToFloat(uint16_t p_value)
+{
+	const uint32_t sign = static_cast<uint32_t>(p_value & 0x8000) << 16;
+	uint32_t exponent = (p_value >> 10) & 0x1F;
+	uint32_t mantissa = p_value & 0x3FF;
+
+	uint32_t bits;
+
+	if (exponent == 0x1F)
+	{
+		/* NaN and infinity */
+		bits = sign | 0x7F800000 | (mantissa << 13);
+	}
+	else if (exponent == 0)
+	{
+		if (mantissa == 0)
+		{
+			bits = sign;
+		}
+		else
+		{
+			/* Subnormal half : normalize it, every subnormal half is a normal float */
+			exponent = 127 - 15 + 1;
+			while ((mantissa & 0x400) == 0)
+			{
+				mantissa <<= 1;
+				--exponent;
+			}
+
+			bits = sign | (exponent << 23) | ((mantissa & 0x3FF) << 13);
+		}
+	}
+	else
+	{
+		bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+	}
+
+	float result;
+	std::memcpy(&result, &bits, sizeof(float));
+	return result;
+}
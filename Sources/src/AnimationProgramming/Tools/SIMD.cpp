@@ -0,0 +1,461 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <cmath>
+#include <cstring>
+#include <immintrin.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+#include "AnimationProgramming/Tools/SIMD.h"
+#include "AnimationProgramming/Tools/SIMDTarget.h"
+
+#define SIMD_SPLAT(v, i) _mm_shuffle_ps(v, v, _MM_SHUFFLE(i, i, i, i))
+
+namespace
+{
+	using namespace AnimationProgramming;
+
+	/* AltMath Slerp falls back to a normalized lerp above this dot product (The comparison is done in double precision) */
+	constexpr double kSlerpLerpThreshold = 0.9998;
+
+	/* AltMath Matrix4::Inverse returns identity if the absolute determinant is under this value */
+	constexpr float kInverseEpsilon = 0.00001f;
+
+	/**
+	* Every dispatched operation works on raw floats (16 for matrices, 4 for quaternions and padded vectors)
+	*/
+	struct KernelTable
+	{
+		void(*multiply)(const float*, const float*, float*);
+		void(*inverse)(const float*, float*);
+		void(*slerp)(const float*, const float*, float, float*);
+		void(*toMatrix4)(const float*, float*);
+		void(*lerp)(const float*, const float*, float, float*);
+	};
+
+	/* Scalar level : forwards to AltMath */
+
+	void MultiplyScalar(const float* p_left, const float* p_right, float* p_result)
+	{
+		AltMath::Matrix4f left, right;
+		std::memcpy(left.elements, p_left, 16 * sizeof(float));
+		std::memcpy(right.elements, p_right, 16 * sizeof(float));
+		std::memcpy(p_result, (left * right).elements, 16 * sizeof(float));
+	}
+
+	void InverseScalar(const float* p_matrix, float* p_result)
+	{
+		AltMath::Matrix4f matrix;
+		std::memcpy(matrix.elements, p_matrix, 16 * sizeof(float));
+		std::memcpy(p_result, matrix.Inverse().elements, 16 * sizeof(float));
+	}
+
+	void SlerpScalar(const float* p_start, const float* p_end, float p_alpha, float* p_result)
+	{
+		AltMath::Quaternion start(p_start[0], p_start[1], p_start[2], p_start[3]);
+		AltMath::Quaternion end(p_end[0], p_end[1], p_end[2], p_end[3]);
+		const AltMath::Quaternion result = AltMath::Quaternion::Slerp(start, end, p_alpha);
+
+		p_result[0] = result.GetXAxisValue();
+		p_result[1] = result.GetYAxisValue();
+		p_result[2] = result.GetZAxisValue();
+		p_result[3] = result.GetRealValue();
+	}
+
+	void ToMatrix4Scalar(const float* p_quaternion, float* p_result)
+	{
+		AltMath::Quaternion quaternion(p_quaternion[0], p_quaternion[1], p_quaternion[2], p_quaternion[3]);
+		std::memcpy(p_result, quaternion.ToMatrix4().elements, 16 * sizeof(float));
+	}
+
+	void LerpScalar(const float* p_start, const float* p_end, float p_alpha, float* p_result)
+	{
+		const AltMath::Vector3f result = AltMath::Vector3f::Lerp(AltMath::Vector3f(p_start[0], p_start[1], p_start[2]), AltMath::Vector3f(p_end[0], p_end[1], p_end[2]), p_alpha);
+
+		p_result[0] = result.x;
+		p_result[1] = result.y;
+		p_result[2] = result.z;
+		p_result[3] = 0.0f;
+	}
+
+	/* SSE4.1 level */
+
+	SIMD_TARGET_SSE41 void MultiplySSE41(const float* p_left, const float* p_right, float* p_result)
+	{
+		const __m128 right0 = _mm_loadu_ps(p_right + 0);
+		const __m128 right1 = _mm_loadu_ps(p_right + 4);
+		const __m128 right2 = _mm_loadu_ps(p_right + 8);
+		const __m128 right3 = _mm_loadu_ps(p_right + 12);
+
+		/* Each row of the result is a linear combination of the rows of the right matrix */
+		for (uint8_t row = 0; row < 4; ++row)
+		{
+			const __m128 left = _mm_loadu_ps(p_left + row * 4);
+			__m128 result = _mm_mul_ps(SIMD_SPLAT(left, 0), right0);
+			result = _mm_add_ps(result, _mm_mul_ps(SIMD_SPLAT(left, 1), right1));
+			result = _mm_add_ps(result, _mm_mul_ps(SIMD_SPLAT(left, 2), right2));
+			result = _mm_add_ps(result, _mm_mul_ps(SIMD_SPLAT(left, 3), right3));
+			_mm_storeu_ps(p_result + row * 4, result);
+		}
+	}
+
+	/* 2x2 matrices (Row-major, stored in one register) helpers used by the block-wise inverse */
+	SIMD_TARGET_SSE41 __m128 Matrix2Multiply(__m128 p_left, __m128 p_right)
+	{
+		return _mm_add_ps
+		(
+			_mm_mul_ps(p_left, _mm_shuffle_ps(p_right, p_right, _MM_SHUFFLE(3, 0, 3, 0))),
+			_mm_mul_ps(_mm_shuffle_ps(p_left, p_left, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(p_right, p_right, _MM_SHUFFLE(1, 2, 1, 2)))
+		);
+	}
+
+	/* Adjugate(p_left) * p_right */
+	SIMD_TARGET_SSE41 __m128 Matrix2AdjugateMultiply(__m128 p_left, __m128 p_right)
+	{
+		return _mm_sub_ps
+		(
+			_mm_mul_ps(_mm_shuffle_ps(p_left, p_left, _MM_SHUFFLE(0, 0, 3, 3)), p_right),
+			_mm_mul_ps(_mm_shuffle_ps(p_left, p_left, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(p_right, p_right, _MM_SHUFFLE(1, 0, 3, 2)))
+		);
+	}
+
+	/* p_left * Adjugate(p_right) */
+	SIMD_TARGET_SSE41 __m128 Matrix2MultiplyAdjugate(__m128 p_left, __m128 p_right)
+	{
+		return _mm_sub_ps
+		(
+			_mm_mul_ps(p_left, _mm_shuffle_ps(p_right, p_right, _MM_SHUFFLE(0, 3, 0, 3))),
+			_mm_mul_ps(_mm_shuffle_ps(p_left, p_left, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(p_right, p_right, _MM_SHUFFLE(1, 2, 1, 2)))
+		);
+	}
+
+	SIMD_TARGET_SSE41 void InverseSSE41(const float* p_matrix, float* p_result)
+	{
+		const __m128 row0 = _mm_loadu_ps(p_matrix + 0);
+		const __m128 row1 = _mm_loadu_ps(p_matrix + 4);
+		const __m128 row2 = _mm_loadu_ps(p_matrix + 8);
+		const __m128 row3 = _mm_loadu_ps(p_matrix + 12);
+
+		/* The matrix is split into four 2x2 blocks : | A B | */
+		/*                                             | C D | */
+		const __m128 a = _mm_movelh_ps(row0, row1);
+		const __m128 b = _mm_movehl_ps(row1, row0);
+		const __m128 c = _mm_movelh_ps(row2, row3);
+		const __m128 d = _mm_movehl_ps(row3, row2);
+
+		/* Determinants of the four blocks (|A|, |B|, |C|, |D|) */
+		const __m128 blockDeterminants = _mm_sub_ps
+		(
+			_mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(3, 1, 3, 1))),
+			_mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(2, 0, 2, 0)))
+		);
+
+		const __m128 determinantA = SIMD_SPLAT(blockDeterminants, 0);
+		const __m128 determinantB = SIMD_SPLAT(blockDeterminants, 1);
+		const __m128 determinantC = SIMD_SPLAT(blockDeterminants, 2);
+		const __m128 determinantD = SIMD_SPLAT(blockDeterminants, 3);
+
+		const __m128 adjugateDC = Matrix2AdjugateMultiply(d, c);
+		const __m128 adjugateAB = Matrix2AdjugateMultiply(a, b);
+
+		__m128 x = _mm_sub_ps(_mm_mul_ps(determinantD, a), Matrix2Multiply(b, adjugateDC));
+		__m128 w = _mm_sub_ps(_mm_mul_ps(determinantA, d), Matrix2Multiply(c, adjugateAB));
+		__m128 y = _mm_sub_ps(_mm_mul_ps(determinantB, c), Matrix2MultiplyAdjugate(d, adjugateAB));
+		__m128 z = _mm_sub_ps(_mm_mul_ps(determinantC, b), Matrix2MultiplyAdjugate(a, adjugateDC));
+
+		/* |M| = |A| * |D| + |B| * |C| - Trace(Adjugate(A) * B * Adjugate(D) * C) */
+		__m128 trace = _mm_mul_ps(adjugateAB, _mm_shuffle_ps(adjugateDC, adjugateDC, _MM_SHUFFLE(3, 1, 2, 0)));
+		trace = _mm_hadd_ps(trace, trace);
+		trace = _mm_hadd_ps(trace, trace);
+
+		const __m128 determinant = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(determinantA, determinantD), _mm_mul_ps(determinantB, determinantC)), trace);
+
+		if (std::fabs(_mm_cvtss_f32(determinant)) <= kInverseEpsilon)
+		{
+			std::memcpy(p_result, AltMath::Matrix4f::Identity.elements, 16 * sizeof(float));
+			return;
+		}
+
+		const __m128 inverseDeterminant = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), determinant);
+
+		x = _mm_mul_ps(x, inverseDeterminant);
+		y = _mm_mul_ps(y, inverseDeterminant);
+		z = _mm_mul_ps(z, inverseDeterminant);
+		w = _mm_mul_ps(w, inverseDeterminant);
+
+		/* The adjugate shuffle of each block is combined with the shuffle that rebuilds the rows */
+		_mm_storeu_ps(p_result + 0, _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+		_mm_storeu_ps(p_result + 4, _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+		_mm_storeu_ps(p_result + 8, _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+		_mm_storeu_ps(p_result + 12, _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+	}
+
+	SIMD_TARGET_SSE41 __m128 NormalizeQuaternionSSE41(__m128 p_quaternion)
+	{
+		return _mm_div_ps(p_quaternion, _mm_sqrt_ps(_mm_dp_ps(p_quaternion, p_quaternion, 0xFF)));
+	}
+
+	SIMD_TARGET_SSE41 void SlerpSSE41(const float* p_start, const float* p_end, float p_alpha, float* p_result)
+	{
+		const __m128 start = NormalizeQuaternionSSE41(_mm_loadu_ps(p_start));
+		__m128 end = NormalizeQuaternionSSE41(_mm_loadu_ps(p_end));
+
+		float dot = _mm_cvtss_f32(_mm_dp_ps(start, end, 0xFF));
+
+		/* Take the shortest path */
+		if (dot < 0.0f)
+		{
+			end = _mm_xor_ps(end, _mm_set1_ps(-0.0f));
+			dot = -dot;
+		}
+
+		__m128 result;
+
+		if (static_cast<double>(dot) > kSlerpLerpThreshold)
+		{
+			/* The quaternions are almost the same, acos would be imprecise so we use a normalized lerp */
+			result = _mm_add_ps(start, _mm_mul_ps(_mm_sub_ps(end, start), _mm_set1_ps(p_alpha)));
+			result = NormalizeQuaternionSSE41(result);
+		}
+		else
+		{
+			const float theta = std::acos(dot);
+			const float inverseSinTheta = 1.0f / std::sin(theta);
+			const __m128 startWeight = _mm_set1_ps(std::sin((1.0f - p_alpha) * theta) * inverseSinTheta);
+			const __m128 endWeight = _mm_set1_ps(std::sin(p_alpha * theta) * inverseSinTheta);
+			result = _mm_add_ps(_mm_mul_ps(start, startWeight), _mm_mul_ps(end, endWeight));
+		}
+
+		_mm_storeu_ps(p_result, result);
+	}
+
+	SIMD_TARGET_SSE41 void ToMatrix4SSE41(const float* p_quaternion, float* p_result)
+	{
+		const __m128 quaternion = NormalizeQuaternionSSE41(_mm_loadu_ps(p_quaternion));
+		const __m128 xyzMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+
+		/* (2xx, 2yy, 2zz, 2ww) */
+		const __m128 doubled = _mm_add_ps(quaternion, quaternion);
+		const __m128 squares = _mm_mul_ps(quaternion, doubled);
+
+		/* Diagonal : (1 - 2yy - 2zz, 1 - 2xx - 2zz, 1 - 2xx - 2yy, 0) */
+		__m128 diagonal = _mm_sub_ps(_mm_setr_ps(1.0f, 1.0f, 1.0f, 0.0f), _mm_and_ps(_mm_shuffle_ps(squares, squares, _MM_SHUFFLE(3, 0, 0, 1)), xyzMask));
+		diagonal = _mm_sub_ps(diagonal, _mm_and_ps(_mm_shuffle_ps(squares, squares, _MM_SHUFFLE(3, 1, 2, 2)), xyzMask));
+
+		/* (2xz, 2xy, 2yz) and (2yw, 2zw, 2xw) */
+		const __m128 products = _mm_mul_ps(_mm_shuffle_ps(quaternion, quaternion, _MM_SHUFFLE(3, 1, 0, 0)), _mm_shuffle_ps(doubled, doubled, _MM_SHUFFLE(3, 2, 1, 2)));
+		const __m128 realProducts = _mm_mul_ps(SIMD_SPLAT(quaternion, 3), _mm_shuffle_ps(doubled, doubled, _MM_SHUFFLE(3, 0, 2, 1)));
+
+		/* (2xz + 2yw, 2xy + 2zw, 2yz + 2xw) and (2xz - 2yw, 2xy - 2zw, 2yz - 2xw) */
+		const __m128 sums = _mm_add_ps(products, realProducts);
+		const __m128 differences = _mm_sub_ps(products, realProducts);
+
+		/* Column-vector convention (Same layout as AltMath Quaternion::ToMatrix4), the last lane of the diagonal is already 0 */
+		const __m128 row0 = _mm_blend_ps(_mm_blend_ps(diagonal, differences, 0x2), _mm_shuffle_ps(sums, sums, _MM_SHUFFLE(3, 0, 0, 0)), 0x4);
+		const __m128 row1 = _mm_blend_ps(_mm_blend_ps(diagonal, _mm_shuffle_ps(sums, sums, _MM_SHUFFLE(3, 1, 1, 1)), 0x1), differences, 0x4);
+		const __m128 row2 = _mm_blend_ps(_mm_blend_ps(diagonal, differences, 0x1), _mm_shuffle_ps(sums, sums, _MM_SHUFFLE(3, 2, 2, 2)), 0x2);
+
+		_mm_storeu_ps(p_result + 0, row0);
+		_mm_storeu_ps(p_result + 4, row1);
+		_mm_storeu_ps(p_result + 8, row2);
+		_mm_storeu_ps(p_result + 12, _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+	}
+
+	SIMD_TARGET_SSE41 void LerpSSE41(const float* p_start, const float* p_end, float p_alpha, float* p_result)
+	{
+		const __m128 start = _mm_loadu_ps(p_start);
+		const __m128 end = _mm_loadu_ps(p_end);
+		_mm_storeu_ps(p_result, _mm_add_ps(start, _mm_mul_ps(_mm_set1_ps(p_alpha), _mm_sub_ps(end, start))));
+	}
+
+	/* AVX2 level : only the matrix multiply benefits from 256 bits registers, other operations reuse the SSE4.1 kernels */
+
+	SIMD_TARGET_AVX2 void MultiplyAVX2(const float* p_left, const float* p_right, float* p_result)
+	{
+		const __m256 right0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(p_right + 0));
+		const __m256 right1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(p_right + 4));
+		const __m256 right2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(p_right + 8));
+		const __m256 right3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(p_right + 12));
+
+		/* Two rows of the left matrix are processed per register */
+		for (uint8_t row = 0; row < 4; row += 2)
+		{
+			const __m256 left = _mm256_loadu_ps(p_left + row * 4);
+			__m256 result = _mm256_mul_ps(_mm256_permute_ps(left, _MM_SHUFFLE(0, 0, 0, 0)), right0);
+			result = _mm256_fmadd_ps(_mm256_permute_ps(left, _MM_SHUFFLE(1, 1, 1, 1)), right1, result);
+			result = _mm256_fmadd_ps(_mm256_permute_ps(left, _MM_SHUFFLE(2, 2, 2, 2)), right2, result);
+			result = _mm256_fmadd_ps(_mm256_permute_ps(left, _MM_SHUFFLE(3, 3, 3, 3)), right3, result);
+			_mm256_storeu_ps(p_result + row * 4, result);
+		}
+	}
+
+	constexpr KernelTable kScalarKernels	= { MultiplyScalar, InverseScalar, SlerpScalar, ToMatrix4Scalar, LerpScalar };
+	constexpr KernelTable kSSE41Kernels		= { MultiplySSE41, InverseSSE41, SlerpSSE41, ToMatrix4SSE41, LerpSSE41 };
+	constexpr KernelTable kAVX2Kernels		= { MultiplyAVX2, InverseSSE41, SlerpSSE41, ToMatrix4SSE41, LerpSSE41 };
+
+	const KernelTable& GetKernels(Tools::ESIMDLevel p_level)
+	{
+		switch (p_level)
+		{
+		case Tools::ESIMDLevel::AVX2:	return kAVX2Kernels;
+		case Tools::ESIMDLevel::SSE41:	return kSSE41Kernels;
+		default:						return kScalarKernels;
+		}
+	}
+
+	Tools::ESIMDLevel DetectSupportedLevel()
+	{
+		int registers[4] = { 0, 0, 0, 0 }; /* EAX, EBX, ECX, EDX */
+
+		auto cpuid = [&registers](int p_leaf)
+		{
+#if defined(_MSC_VER)
+			__cpuidex(registers, p_leaf, 0);
+#else
+			unsigned int eax, ebx, ecx, edx;
+			__cpuid_count(p_leaf, 0, eax, ebx, ecx, edx);
+			registers[0] = eax; registers[1] = ebx; registers[2] = ecx; registers[3] = edx;
+#endif
+		};
+
+		cpuid(0);
+		const int highestLeaf = registers[0];
+
+		cpuid(1);
+		const bool sse41 = (registers[2] & (1 << 19)) != 0;
+		const bool fma = (registers[2] & (1 << 12)) != 0;
+		const bool osxsave = (registers[2] & (1 << 27)) != 0;
+		const bool avx = (registers[2] & (1 << 28)) != 0;
+		const bool f16c = (registers[2] & (1 << 29)) != 0;
+
+		if (!sse41)
+			return Tools::ESIMDLevel::SCALAR;
+
+		bool avx2 = false;
+
+		if (highestLeaf >= 7 && osxsave && avx && fma && f16c)
+		{
+			/* The OS must save the YMM registers on context switches (XCR0 bits 1 and 2) */
+#if defined(_MSC_VER)
+			const unsigned long long xcr0 = _xgetbv(0);
+#else
+			unsigned int xcr0Low, xcr0High;
+			__asm__ volatile("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+			const unsigned long long xcr0 = xcr0Low;
+#endif
+			cpuid(7);
+			avx2 = (xcr0 & 0x6) == 0x6 && (registers[1] & (1 << 5)) != 0;
+		}
+
+		return avx2 ? Tools::ESIMDLevel::AVX2 : Tools::ESIMDLevel::SSE41;
+	}
+
+	Tools::ESIMDLevel g_supportedLevel = Tools::ESIMDLevel::SCALAR;
+	Tools::ESIMDLevel g_currentLevel = Tools::ESIMDLevel::SCALAR;
+	const KernelTable* g_kernels = &kScalarKernels;
+}
+
+void AnimationProgramming::Tools::SIMD::Initialize()
+{
+	g_supportedLevel = DetectSupportedLevel();
+	SetLevel(g_supportedLevel);
+}
+
+AnimationProgramming::Tools::ESIMDLevel AnimationProgramming::Tools::SIMD::GetSupportedLevel()
+{
+	return g_supportedLevel;
+}
+
+AnimationProgramming::Tools::ESIMDLevel AnimationProgramming::Tools::SIMD::GetLevel()
+{
+	return g_currentLevel;
+}
+
+void AnimationProgramming::Tools::SIMD::SetLevel(ESIMDLevel p_level)
+{
+	g_currentLevel = static_cast<int>(p_level) > static_cast<int>(g_supportedLevel) ? g_supportedLevel : p_level;
+	g_kernels = &GetKernels(g_currentLevel);
+}
+
+const char* AnimationProgramming::Tools::SIMD::GetLevelName(ESIMDLevel p_level)
+{
+	switch (p_level)
+	{
+	case ESIMDLevel::AVX2:	return "AVX2";
+	case ESIMDLevel::SSE41:	return "SSE4.1";
+	default:				return "Scalar";
+	}
+}
+
+void AnimationProgramming::Tools::SIMD::Multiply(const Data::AlignedMatrix4& p_left, const Data::AlignedMatrix4& p_right, Data::AlignedMatrix4& p_result)
+{
+	g_kernels->multiply(p_left.elements, p_right.elements, p_result.elements);
+}
+
+void AnimationProgramming::Tools::SIMD::Inverse(const Data::AlignedMatrix4& p_matrix, Data::AlignedMatrix4& p_result)
+{
+	g_kernels->inverse(p_matrix.elements, p_result.elements);
+}
+
+void AnimationProgramming::Tools::SIMD::Slerp(const Data::AlignedQuaternion& p_start, const Data::AlignedQuaternion& p_end, float p_alpha, Data::AlignedQuaternion& p_result)
+{
+	g_kernels->slerp(&p_start.x, &p_end.x, p_alpha, &p_result.x);
+}
+
+void AnimationProgramming::Tools::SIMD::ToMatrix4(const Data::AlignedQuaternion& p_quaternion, Data::AlignedMatrix4& p_result)
+{
+	g_kernels->toMatrix4(&p_quaternion.x, p_result.elements);
+}
+
+void AnimationProgramming::Tools::SIMD::Lerp(const Data::AlignedVector3& p_start, const Data::AlignedVector3& p_end, float p_alpha, Data::AlignedVector3& p_result)
+{
+	g_kernels->lerp(&p_start.x, &p_end.x, p_alpha, &p_result.x);
+}
+
+AltMath::Matrix4f AnimationProgramming::Tools::SIMD::Multiply(const AltMath::Matrix4f& p_left, const AltMath::Matrix4f& p_right)
+{
+	AltMath::Matrix4f result;
+	g_kernels->multiply(p_left.elements, p_right.elements, result.elements);
+	return result;
+}
+
+AltMath::Matrix4f AnimationProgramming::Tools::SIMD::Inverse(const AltMath::Matrix4f& p_matrix)
+{
+	AltMath::Matrix4f result;
+	g_kernels->inverse(p_matrix.elements, result.elements);
+	return result;
+}
+
+AltMath::Quaternion AnimationProgramming::Tools::SIMD::Slerp(const AltMath::Quaternion& p_start, const AltMath::Quaternion& p_end, float p_alpha)
+{
+	const Data::AlignedQuaternion start(p_start);
+	const Data::AlignedQuaternion end(p_end);
+	Data::AlignedQuaternion result;
+	g_kernels->slerp(&start.x, &end.x, p_alpha, &result.x);
+	return result.ToQuaternion();
+}
+
+AltMath::Matrix4f AnimationProgramming::Tools::SIMD::ToMatrix4(const AltMath::Quaternion& p_quaternion)
+{
+	const Data::AlignedQuaternion quaternion(p_quaternion);
+	AltMath::Matrix4f result;
+	g_kernels->toMatrix4(&quaternion.x, result.elements);
+	return result;
+}
+
+AltMath::Vector3f AnimationProgramming::Tools::SIMD::Lerp(const AltMath::Vector3f& p_start, const AltMath::Vector3f& p_end, float p_alpha)
+{
+	const Data::AlignedVector3 start(p_start);
+	const Data::AlignedVector3 end(p_end);
+	Data::AlignedVector3 result;
+	g_kernels->lerp(&start.x, &end.x, p_alpha, &result.x);
+	return result.ToVector3();
+}
@@ -0,0 +1,192 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+
+#include "AnimationProgramming/Tools/Snapshot.h"
+
+namespace
+{
+	/* Plain copies of the AltMath values (Written as bytes) */
+	struct PlainVector3
+	{
+		float x, y, z;
+	};
+
+	struct PlainQuaternion
+	{
+		float x, y, z, w;
+	};
+
+	struct PlainTransformation
+	{
+		PlainVector3 position;
+		PlainQuaternion rotation;
+	};
+
+	PlainVector3 ToPlain(const AltMath::Vector3f& p_value)
+	{
+		return { p_value.x, p_value.y, p_value.z };
+	}
+
+	PlainQuaternion ToPlain(const AltMath::Quaternion& p_value)
+	{
+		return { p_value.GetXAxisValue(), p_value.GetYAxisValue(), p_value.GetZAxisValue(), p_value.GetRealValue() };
+	}
+
+	AltMath::Vector3f FromPlain(const PlainVector3& p_value)
+	{
+		return AltMath::Vector3f(p_value.x, p_value.y, p_value.z);
+	}
+
+	AltMath::Quaternion FromPlain(const PlainQuaternion& p_value)
+	{
+		return AltMath::Quaternion(p_value.x, p_value.y, p_value.z, p_value.w);
+	}
+}
+
+void AnimationProgramming::Tools::Snapshot::Clear()
+{
+	m_size = 0;
+	Rewind();
+}
+
+void AnimationProgramming::Tools::Snapshot::Rewind()
+{
+	m_cursor = 0;
+	m_overflow = false;
+}
+
+size_t AnimationProgramming::Tools::Snapshot::GetSize() const
+{
+	return m_size;
+}
+
+const uint8_t* AnimationProgramming::Tools::Snapshot::GetData() const
+{
+	return m_data.data();
+}
+
+void AnimationProgramming::Tools::Snapshot::Assign(const uint8_t* p_data, size_t p_size)
+{
+	Clear();
+	WriteBytes(p_data, p_size);
+}
+
+bool AnimationProgramming::Tools::Snapshot::IsFullyRead() const
+{
+	return !m_overflow && m_cursor == m_size;
+}
+
+void AnimationProgramming::Tools::Snapshot::WriteBytes(const void* p_source, size_t p_size)
+{
+	if (m_size + p_size > m_data.size())
+		m_data.resize(std::max(m_size + p_size, 2 * m_data.size()));
+
+	if (p_size != 0)
+		std::memcpy(m_data.data() + m_size, p_source, p_size);
+
+	m_size += p_size;
+}
+
+void AnimationProgramming::Tools::Snapshot::ReadBytes(void* p_destination, size_t p_size)
+{
+	if (m_overflow || m_cursor + p_size > m_size)
+	{
+		m_overflow = true;
+		return;
+	}
+
+	if (p_size != 0)
+		std::memcpy(p_destination, m_data.data() + m_cursor, p_size);
+
+	m_cursor += p_size;
+}
+
+void AnimationProgramming::Tools::Snapshot::Write(const AltMath::Vector3f& p_value)
+{
+	Write(ToPlain(p_value));
+}
+
+void AnimationProgramming::Tools::Snapshot::Write(const AltMath::Quaternion& p_value)
+{
+	Write(ToPlain(p_value));
+}
+
+void AnimationProgramming::Tools::Snapshot::WriteArray(const std::vector<AltMath::Vector3f>& p_values)
+{
+	Write(static_cast<uint32_t>(p_values.size()));
+
+	for (const AltMath::Vector3f& value : p_values)
+		Write(ToPlain(value));
+}
+
+void AnimationProgramming::Tools::Snapshot::WriteArray(const std::vector<std::pair<AltMath::Vector3f, AltMath::Quaternion>>& p_values)
+{
+	Write(static_cast<uint32_t>(p_values.size()));
+
+	for (const auto&[position, rotation] : p_values)
+		Write(PlainTransformation{ ToPlain(position), ToPlain(rotation) });
+}
+
+void AnimationProgramming::Tools::Snapshot::Read(AltMath::Vector3f& p_value)
+{
+	PlainVector3 value{};
+	Read(value);
+	p_value = FromPlain(value);
+}
+
+void AnimationProgramming::Tools::Snapshot::Read(AltMath::Quaternion& p_value)
+{
+	PlainQuaternion value{ 0.0f, 0.0f, 0.0f, 1.0f };
+	Read(value);
+	p_value = FromPlain(value);
+}
+
+void AnimationProgramming::Tools::Snapshot::ReadArray(std::vector<AltMath::Vector3f>& p_values)
+{
+	const uint32_t size = ReadArraySize(sizeof(PlainVector3));
+
+	if (m_overflow)
+		return;
+
+	p_values.resize(size);
+
+	for (AltMath::Vector3f& value : p_values)
+		Read(value);
+}
+
+void AnimationProgramming::Tools::Snapshot::ReadArray(std::vector<std::pair<AltMath::Vector3f, AltMath::Quaternion>>& p_values)
+{
+	const uint32_t size = ReadArraySize(sizeof(PlainTransformation));
+
+	if (m_overflow)
+		return;
+
+	p_values.resize(size);
+
+	for (auto&[position, rotation] : p_values)
+	{
+		PlainTransformation value{};
+		Read(value);
+		position = FromPlain(value.position);
+		rotation = FromPlain(value.rotation);
+	}
+}
+
+uint32_t AnimationProgramming::Tools::Snapshot::ReadArraySize(size_t p_elementSize)
+{
+	uint32_t size = 0;
+	Read(size);
+
+	if (m_cursor + static_cast<size_t>(size) * p_elementSize > m_size)
+	{
+		m_overflow = true;
+		return 0;
+	}
+
+	return size;
+}
@@ -0,0 +1,118 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <algorithm>
+#include <atomic>
+
+#include "AnimationProgramming/Tools/ThreadPool.h"
+
+AnimationProgramming::Tools::ThreadPool::ThreadPool(uint32_t p_workerCount)
+{
+	m_workers.reserve(p_workerCount);
+
+	for (uint32_t i = 0; i < p_workerCount; ++i)
+		m_workers.emplace_back(&ThreadPool::WorkerLoop, this);
+}
+
+AnimationProgramming::Tools::ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_tasksMutex);
+		m_stopping = true;
+	}
+
+	m_tasksCondition.notify_all();
+
+	for (std::thread& worker : m_workers)
+		worker.join();
+}
+
+uint32_t AnimationProgramming::Tools::ThreadPool::GetThreadCount() const
+{
+	return static_cast<uint32_t>(m_workers.size()) + 1;
+}
+
+void AnimationProgramming::Tools::ThreadPool::ParallelFor(uint32_t p_count, uint32_t p_chunkSize, const RangeFunction& p_function)
+{
+	if (p_count == 0)
+		return;
+
+	const uint32_t chunkSize = std::max(p_chunkSize, 1u);
+	const uint32_t chunkCount = (p_count + chunkSize - 1) / chunkSize;
+	const uint32_t helperCount = std::min(static_cast<uint32_t>(m_workers.size()), chunkCount - 1);
+
+	/* Not worth waking up the workers */
+	if (helperCount == 0)
+	{
+		p_function(0, p_count);
+		return;
+	}
+
+	/* Chunks are claimed dynamically, so a slow thread doesn't hold the others back. The state lives on this stack since we wait for the helpers */
+	std::atomic<uint32_t> nextChunk(0);
+	uint32_t remainingHelpers = helperCount;
+	std::mutex doneMutex;
+	std::condition_variable doneCondition;
+
+	auto processChunks = [&]()
+	{
+		for (uint32_t chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++)
+		{
+			const uint32_t begin = chunk * chunkSize;
+			p_function(begin, std::min(begin + chunkSize, p_count));
+		}
+	};
+
+	{
+		std::lock_guard<std::mutex> lock(m_tasksMutex);
+
+		for (uint32_t i = 0; i < helperCount; ++i)
+		{
+			m_tasks.push([&]()
+			{
+				processChunks();
+
+				std::lock_guard<std::mutex> doneLock(doneMutex);
+				if (--remainingHelpers == 0)
+					doneCondition.notify_one();
+			});
+		}
+	}
+
+	m_tasksCondition.notify_all();
+
+	processChunks();
+
+	std::unique_lock<std::mutex> doneLock(doneMutex);
+	doneCondition.wait(doneLock, [&remainingHelpers] { return remainingHelpers == 0; });
+}
+
+uint32_t AnimationProgramming::Tools::ThreadPool::GetDefaultWorkerCount()
+{
+	const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+	return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+}
+
+void AnimationProgramming::Tools::ThreadPool::WorkerLoop()
+{
+	while (true)
+	{
+		std::function<void()> task;
+
+		{
+			std::unique_lock<std::mutex> lock(m_tasksMutex);
+			m_tasksCondition.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+
+			if (m_stopping && m_tasks.empty())
+				return;
+
+			task = std::move(m_tasks.front());
+			m_tasks.pop();
+		}
+
+		task();
+	}
+}
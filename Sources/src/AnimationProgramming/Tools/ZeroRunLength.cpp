@@ -0,0 +1,52 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include "AnimationProgramming/Tools/ZeroRunLength.h"
+
+void AnimationProgramming::Tools::ZeroRunLength::Compress(const uint8_t* p_source, size_t p_size, std::vector<uint8_t>& p_destination)
+{
+	for (size_t i = 0; i < p_size;)
+	{
+		if (p_source[i] != 0)
+		{
+			p_destination.push_back(p_source[i++]);
+			continue;
+		}
+
+		uint8_t run = 0;
+
+		while (i < p_size && p_source[i] == 0 && run < UINT8_MAX)
+		{
+			++run;
+			++i;
+		}
+
+		p_destination.push_back(0);
+		p_destination.push_back(run);
+	}
+}
+
+bool AnimationProgramming::Tools::ZeroRunLength::Decompress(const uint8_t* p_source, size_t p_size, std::vector<uint8_t>& p_destination)
+{
+	p_destination.clear();
+
+	for (size_t i = 0; i < p_size; ++i)
+	{
+		if (p_source[i] != 0)
+		{
+			p_destination.push_back(p_source[i]);
+			continue;
+		}
+
+		/* A run of zeros needs its length */
+		if (++i == p_size || p_source[i] == 0)
+			return false;
+
+		p_destination.insert(p_destination.end(), p_source[i], 0);
+	}
+
+	return true;
+}
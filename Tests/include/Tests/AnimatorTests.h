@@ -0,0 +1,32 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _ANIMATORTESTS_H
+#define _ANIMATORTESTS_H
+
+#include "Tests/TestSuite.h"
+
+namespace AnimationProgramming::Tests
+{
+	/**
+	* Tests of the Animator transitions, on the skeleton and the animations of the stub engine
+	*/
+	class AnimatorTests final
+	{
+	public:
+		/* Prevent this static class from being instancied */
+		AnimatorTests() = delete;
+
+		/**
+		* Add every test of this category to the given suite
+		* @param p_suite
+		*/
+		static void Register(TestSuite& p_suite);
+	};
+}
+
+#endif // _ANIMATORTESTS_H
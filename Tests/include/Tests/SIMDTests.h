@@ -0,0 +1,32 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _SIMDTESTS_H
+#define _SIMDTESTS_H
+
+#include "Tests/TestSuite.h"
+
+namespace AnimationProgramming::Tests
+{
+	/**
+	* Equivalence of the SIMD kernels (Tools::SIMD, Matrix3x4, HalfMatrix3x4) with their scalar reference, at every level supported by the CPU
+	*/
+	class SIMDTests final
+	{
+	public:
+		/* Prevent this static class from being instancied */
+		SIMDTests() = delete;
+
+		/**
+		* Add every test of this category to the given suite
+		* @param p_suite
+		*/
+		static void Register(TestSuite& p_suite);
+	};
+}
+
+#endif // _SIMDTESTS_H
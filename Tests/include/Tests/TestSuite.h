@@ -0,0 +1,61 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#pragma once
+#ifndef _TESTSUITE_H
+#define _TESTSUITE_H
+
+#include <functional>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace AnimationProgramming::Tests
+{
+	/**
+	* A list of named tests. A test passes if every check it makes passes
+	*/
+	class TestSuite final
+	{
+	public:
+		/**
+		* Register a test
+		* @param p_name (Use "Category/Test" names so they can be filtered)
+		* @param p_test
+		*/
+		void Add(const std::string& p_name, std::function<void()> p_test);
+
+		/**
+		* Run every test whose name contains p_filter and return the number of failed tests (Results are printed to the standard output)
+		* @param p_filter (Empty to run every test)
+		*/
+		uint32_t Run(const std::string& p_filter) const;
+
+		/**
+		* Return the number of tests whose name contains p_filter
+		* @param p_filter
+		*/
+		uint32_t Count(const std::string& p_filter) const;
+
+		/**
+		* Verify a condition of the running test (Only failed checks are printed)
+		* @param p_description
+		* @param p_passed
+		*/
+		static void Check(const std::string& p_description, bool p_passed);
+
+	private:
+		struct Test final
+		{
+			std::string name;
+			std::function<void()> body;
+		};
+
+		std::vector<Test> m_tests;
+	};
+}
+
+#endif // _TESTSUITE_H
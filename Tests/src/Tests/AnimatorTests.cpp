@@ -0,0 +1,223 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <cmath>
+#include <vector>
+
+#include "AnimationProgramming/Animation/Animator.h"
+#include "AnimationProgramming/Animation/IPoseSource.h"
+#include "AnimationProgramming/Animation/PoseCache.h"
+#include "AnimationProgramming/Rig/Skeleton.h"
+
+#include "Tests/AnimatorTests.h"
+
+namespace
+{
+	using namespace AnimationProgramming;
+	using namespace AnimationProgramming::Tests;
+
+	constexpr float kFrameTime = 1.0f / 60.0f;
+
+	/* Largest difference allowed between two poses that should be the same (Blends with a weight of 1 aren't bit exact) */
+	constexpr float kPoseTolerance = 1e-4f;
+
+	/**
+	* A pose source holding every bone rotated by the same angle
+	*/
+	class TwistedPoseSource final : public Animation::IPoseSource
+	{
+	public:
+		TwistedPoseSource(uint32_t p_boneCount) :
+			m_boneCount(p_boneCount)
+		{}
+
+		void Update(float p_deltaTime) override
+		{
+			m_time += p_deltaTime;
+		}
+
+		void Evaluate(std::vector<Data::Transformation>& p_pose) override
+		{
+			p_pose.assign(m_boneCount, Data::Transformation(AltMath::Vector3f(0.0f, 0.0f, 0.0f), AltMath::Quaternion(AltMath::Vector3f(0.0f, 0.0f, 1.0f), 0.5f + m_time)));
+		}
+
+		void SaveSnapshot(Tools::Snapshot& p_snapshot) const override
+		{
+			p_snapshot.Write(m_time);
+		}
+
+		void RestoreSnapshot(Tools::Snapshot& p_snapshot) override
+		{
+			p_snapshot.Read(m_time);
+		}
+
+	private:
+		uint32_t m_boneCount;
+		float m_time = 0.0f;
+	};
+
+	/**
+	* Return true if both poses have the same bones and their transformations are within kPoseTolerance (A quaternion and its opposite are the same rotation)
+	*/
+	bool IsSamePose(const std::vector<Data::Transformation>& p_left, const std::vector<Data::Transformation>& p_right)
+	{
+		if (p_left.size() != p_right.size())
+			return false;
+
+		for (size_t i = 0; i < p_left.size(); ++i)
+		{
+			const AltMath::Vector3f positionOffset = p_left[i].first - p_right[i].first;
+			const float dot = AltMath::Quaternion::DotProduct(p_left[i].second, p_right[i].second);
+
+			if (positionOffset.Length() > kPoseTolerance || 1.0f - std::fabs(dot) > kPoseTolerance)
+				return false;
+		}
+
+		return true;
+	}
+
+	/**
+	* A clip stacked after a pose source fades from the current pose with the transition stack : once the fade is over, the pose is the clip
+	*/
+	void TestStackAfterPoseSource()
+	{
+		Rig::Skeleton skeleton;
+		skeleton.CreateSkeletonFromBindPose();
+
+		Animation::AnimationInfo walkAnimation("ThirdPersonWalk.anim");
+		Animation::AnimationInfo runAnimation("ThirdPersonRun.anim");
+		Animation::AnimationInstance walkAnimationInstance(walkAnimation);
+		Animation::AnimationInstance runAnimationInstance(runAnimation);
+		walkAnimationInstance.loop = true;
+		runAnimationInstance.loop = true;
+		runAnimationInstance.transitionDuration = 0.2f;
+
+		Animation::Animator animator(skeleton);
+		animator.SetTransitionMode(Animation::ETransitionMode::STACK);
+		animator.PlayAnimation(walkAnimationInstance);
+
+		for (uint32_t frame = 0; frame < 10; ++frame)
+			animator.UpdatePose(kFrameTime);
+
+		/* The transition to the pose source lasts far longer than the test */
+		TwistedPoseSource poseSource(static_cast<uint32_t>(animator.GetLocalPose().size()));
+		animator.PlayPoseSource(poseSource, 10.0f);
+
+		for (uint32_t frame = 0; frame < 10; ++frame)
+			animator.UpdatePose(kFrameTime);
+
+		animator.PlayAnimation(runAnimationInstance);
+
+		/* The reference plays the clip from the same time, without any transition */
+		Animation::Animator reference(skeleton);
+		reference.SetTransitionMode(Animation::ETransitionMode::STACK);
+		reference.PlayAnimation(runAnimationInstance);
+
+		for (uint32_t frame = 0; frame < 30; ++frame)
+		{
+			animator.UpdatePose(kFrameTime);
+			reference.UpdatePose(kFrameTime);
+		}
+
+		TestSuite::Check("The pose is the stacked clip once its fade is over", IsSamePose(animator.GetLocalPose(), reference.GetLocalPose()));
+	}
+
+	/**
+	* Two animators of the same skeleton share its definition : the second one reuses the pose evaluated by the first one
+	*/
+	void TestPoseCacheSharedBySkeleton()
+	{
+		Rig::Skeleton skeleton;
+		skeleton.CreateSkeletonFromBindPose();
+
+		Animation::AnimationInfo walkAnimation("ThirdPersonWalk.anim");
+		Animation::AnimationInstance walkAnimationInstance(walkAnimation);
+		walkAnimationInstance.loop = true;
+
+		Animation::PoseCache poseCache;
+		Animation::Animator first(skeleton);
+		Animation::Animator second(skeleton);
+
+		for (Animation::Animator* animator : { &first, &second })
+		{
+			animator->SetPoseCache(&poseCache);
+			animator->PlayAnimation(walkAnimationInstance);
+		}
+
+		poseCache.BeginFrame();
+		first.UpdatePose(kFrameTime);
+		second.UpdatePose(kFrameTime);
+
+		TestSuite::Check("The skeleton gives the same definition to every user", skeleton.GetDefinition() == skeleton.GetDefinition());
+		TestSuite::Check("The second animator reuses the pose of the first one", poseCache.GetMissCount() == 1 && poseCache.GetHitCount() == 1);
+		TestSuite::Check("Both animators have the same pose", IsSamePose(first.GetLocalPose(), second.GetLocalPose()));
+	}
+
+	/**
+	* A snapshot taken while a pose source is played replays the same poses : on the same animator, and on another animator with its own pose source
+	*/
+	void TestRollbackWithPoseSource()
+	{
+		Rig::Skeleton skeleton;
+		skeleton.CreateSkeletonFromBindPose();
+
+		Animation::AnimationInfo walkAnimation("ThirdPersonWalk.anim");
+		Animation::AnimationInstance walkAnimationInstance(walkAnimation);
+		walkAnimationInstance.loop = true;
+
+		Animation::Animator animator(skeleton);
+		animator.SetTransitionMode(Animation::ETransitionMode::INERTIALIZATION);
+		animator.PlayAnimation(walkAnimationInstance);
+
+		for (uint32_t frame = 0; frame < 10; ++frame)
+			animator.UpdatePose(kFrameTime);
+
+		/* The snapshot is taken in the middle of the transition to the pose source */
+		TwistedPoseSource poseSource(static_cast<uint32_t>(animator.GetLocalPose().size()));
+		animator.PlayPoseSource(poseSource, 0.5f);
+
+		for (uint32_t frame = 0; frame < 10; ++frame)
+			animator.UpdatePose(kFrameTime);
+
+		Tools::Snapshot snapshot;
+		animator.SaveSnapshot(snapshot);
+
+		for (uint32_t frame = 0; frame < 20; ++frame)
+			animator.UpdatePose(kFrameTime);
+
+		const std::vector<Data::Transformation> played = animator.GetLocalPose();
+
+		snapshot.Rewind();
+		animator.RestoreSnapshot(snapshot);
+		const bool fullyRead = snapshot.IsFullyRead();
+
+		for (uint32_t frame = 0; frame < 20; ++frame)
+			animator.UpdatePose(kFrameTime);
+
+		/* The other animator has its own pose source, added at the same index */
+		TwistedPoseSource otherPoseSource(poseSource);
+		Animation::Animator other(skeleton);
+		other.SetTransitionMode(Animation::ETransitionMode::INERTIALIZATION);
+		other.AddPoseSource(otherPoseSource);
+
+		snapshot.Rewind();
+		other.RestoreSnapshot(snapshot);
+
+		for (uint32_t frame = 0; frame < 20; ++frame)
+			other.UpdatePose(kFrameTime);
+
+		TestSuite::Check("The snapshot is fully read", fullyRead && snapshot.IsFullyRead());
+		TestSuite::Check("The rolled back animator plays the same poses", IsSamePose(played, animator.GetLocalPose()));
+		TestSuite::Check("Another animator plays the same poses with its own pose source", IsSamePose(played, other.GetLocalPose()));
+	}
+}
+
+void AnimationProgramming::Tests::AnimatorTests::Register(TestSuite& p_suite)
+{
+	p_suite.Add("Animator/StackAfterPoseSource", TestStackAfterPoseSource);
+	p_suite.Add("Animator/PoseCacheSharedBySkeleton", TestPoseCacheSharedBySkeleton);
+	p_suite.Add("Animator/RollbackWithPoseSource", TestRollbackWithPoseSource);
+}
@@ -0,0 +1,51 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "AnimationProgramming/Tools/IniManager.h"
+#include "AnimationProgramming/Tools/SIMD.h"
+
+#include "Tests/AnimatorTests.h"
+#include "Tests/SIMDTests.h"
+#include "Tests/TestSuite.h"
+
+using namespace AnimationProgramming;
+using namespace AnimationProgramming::Tests;
+
+int main(int p_argc, char** p_argv)
+{
+	if (p_argc > 2)
+	{
+		std::cout << "Usage: Tests [filter] (Only run the tests whose name contains the filter)" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	const std::string filter = p_argc == 2 ? p_argv[1] : "";
+
+	/* The timeline reads its effectors from the ini files, like in the application */
+	Tools::IniManager::Initialize();
+	Tools::SIMD::Initialize();
+
+	std::cout << "Supported SIMD level: " << Tools::SIMD::GetLevelName(Tools::SIMD::GetSupportedLevel()) << std::endl;
+
+	TestSuite suite;
+	SIMDTests::Register(suite);
+	AnimatorTests::Register(suite);
+
+	if (suite.Count(filter) == 0)
+	{
+		std::cerr << "No test matches " << filter << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	const uint32_t failedTestCount = suite.Run(filter);
+	std::cout << failedTestCount << " test(s) failed" << std::endl;
+
+	return failedTestCount == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
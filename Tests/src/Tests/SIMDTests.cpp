@@ -0,0 +1,439 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "AnimationProgramming/Data/AlignedTypes.h"
+#include "AnimationProgramming/Data/HalfMatrix3x4.h"
+#include "AnimationProgramming/Data/Matrix3x4.h"
+#include "AnimationProgramming/Tools/Math.h"
+#include "AnimationProgramming/Tools/SIMD.h"
+
+#include "Tests/SIMDTests.h"
+
+namespace
+{
+	using namespace AnimationProgramming;
+	using namespace AnimationProgramming::Tests;
+
+	/* Random inputs per kernel and level, on top of the edge cases */
+	constexpr uint32_t kRandomSampleCount = 10000;
+
+	/* Largest difference allowed between a kernel and its reference (Relative to the magnitude of the expected value) */
+	constexpr float kTolerance = 1e-4f;
+
+	/* Smallest positive denormal float, and one closer to the normal range */
+	const float kDenormal = std::numeric_limits<float>::denorm_min();
+	const float kLargeDenormal = std::numeric_limits<float>::min() * 0.5f;
+
+	bool IsNear(const float* p_values, const float* p_expected, uint8_t p_count)
+	{
+		for (uint8_t i = 0; i < p_count; ++i)
+		{
+			if (!(std::fabs(p_values[i] - p_expected[i]) <= kTolerance * std::fmax(1.0f, std::fabs(p_expected[i]))))
+				return false;
+		}
+
+		return true;
+	}
+
+	/**
+	* Generates the inputs of the tests (Fixed seed, so a failure can be reproduced)
+	*/
+	struct InputGenerator final
+	{
+		Data::AlignedQuaternion Quaternion()
+		{
+			Data::AlignedQuaternion quaternion;
+
+			do
+			{
+				quaternion.x = unit(generator);
+				quaternion.y = unit(generator);
+				quaternion.z = unit(generator);
+				quaternion.w = unit(generator);
+			} while (quaternion.x * quaternion.x + quaternion.y * quaternion.y + quaternion.z * quaternion.z + quaternion.w * quaternion.w < 0.01f);
+
+			return quaternion;
+		}
+
+		/* Bone-like matrices : rotation * scale with a translation */
+		Data::AlignedMatrix4 Matrix()
+		{
+			Data::AlignedMatrix4 matrix(Quaternion().ToQuaternion().ToMatrix4());
+			const float scale = scaleDistribution(generator);
+
+			for (uint8_t row = 0; row < 3; ++row)
+			{
+				for (uint8_t column = 0; column < 3; ++column)
+					matrix.elements[row * 4 + column] *= scale;
+
+				matrix.elements[row * 4 + 3] = unit(generator) * 100.0f;
+			}
+
+			return matrix;
+		}
+
+		/* A matrix whose rotation and translation contain denormals */
+		Data::AlignedMatrix4 DenormalMatrix()
+		{
+			Data::AlignedMatrix4 matrix = Matrix();
+			matrix.elements[1] = kDenormal;
+			matrix.elements[6] = -kLargeDenormal;
+			matrix.elements[7] = kLargeDenormal;
+			return matrix;
+		}
+
+		Data::AlignedVector3 Vector()
+		{
+			return Data::AlignedVector3(AltMath::Vector3f(unit(generator), unit(generator), unit(generator)) * 100.0f);
+		}
+
+		float Alpha()
+		{
+			return alphaDistribution(generator);
+		}
+
+		std::mt19937 generator{ 42 };
+		std::uniform_real_distribution<float> unit{ -1.0f, 1.0f };
+		std::uniform_real_distribution<float> alphaDistribution{ 0.0f, 1.0f };
+		std::uniform_real_distribution<float> scaleDistribution{ 0.5f, 2.0f };
+	};
+
+	Data::AlignedQuaternion Negate(const Data::AlignedQuaternion& p_quaternion)
+	{
+		return Data::AlignedQuaternion(AltMath::Quaternion(-p_quaternion.x, -p_quaternion.y, -p_quaternion.z, -p_quaternion.w));
+	}
+
+	/**
+	* Run the given test at every level supported by the CPU (The level is restored afterward)
+	* @param p_test (Receives the name of the level)
+	*/
+	void ForEachSupportedLevel(const std::function<void(const std::string&)>& p_test)
+	{
+		const Tools::ESIMDLevel previousLevel = Tools::SIMD::GetLevel();
+
+		for (int level = static_cast<int>(Tools::ESIMDLevel::SCALAR); level <= static_cast<int>(Tools::SIMD::GetSupportedLevel()); ++level)
+		{
+			Tools::SIMD::SetLevel(static_cast<Tools::ESIMDLevel>(level));
+			p_test(Tools::SIMD::GetLevelName(Tools::SIMD::GetLevel()));
+		}
+
+		Tools::SIMD::SetLevel(previousLevel);
+	}
+
+	/**
+	* Check that every result matched its reference
+	* @param p_description
+	* @param p_mismatches
+	* @param p_total
+	*/
+	void CheckMismatches(const std::string& p_description, uint32_t p_mismatches, uint32_t p_total)
+	{
+		TestSuite::Check(p_description + ": " + std::to_string(p_mismatches) + " of " + std::to_string(p_total) + " results differ from the reference", p_mismatches == 0);
+	}
+
+	void TestMultiply()
+	{
+		ForEachSupportedLevel([](const std::string& p_level)
+		{
+			InputGenerator inputs;
+			std::vector<std::pair<Data::AlignedMatrix4, Data::AlignedMatrix4>> cases =
+			{
+				{ Data::AlignedMatrix4(), Data::AlignedMatrix4() },
+				{ Data::AlignedMatrix4(), inputs.Matrix() },
+				{ inputs.Matrix(), Data::AlignedMatrix4() },
+				{ inputs.DenormalMatrix(), inputs.Matrix() },
+				{ inputs.Matrix(), inputs.DenormalMatrix() }
+			};
+
+			for (uint32_t i = 0; i < kRandomSampleCount; ++i)
+				cases.emplace_back(inputs.Matrix(), inputs.Matrix());
+
+			uint32_t mismatches = 0;
+
+			for (const auto& [left, right] : cases)
+			{
+				Data::AlignedMatrix4 result;
+				Tools::SIMD::Multiply(left, right, result);
+				const Data::AlignedMatrix4 expected(left.ToMatrix4() * right.ToMatrix4());
+				mismatches += !IsNear(result.elements, expected.elements, 16);
+			}
+
+			CheckMismatches(p_level + " Multiply", mismatches, static_cast<uint32_t>(cases.size()));
+		});
+	}
+
+	void TestInverse()
+	{
+		ForEachSupportedLevel([](const std::string& p_level)
+		{
+			InputGenerator inputs;
+
+			/* A null scale makes the matrix singular : AltMath returns identity */
+			Data::AlignedMatrix4 singular = inputs.Matrix();
+			for (uint8_t column = 0; column < 3; ++column)
+				singular.elements[column] = 0.0f;
+
+			std::vector<Data::AlignedMatrix4> cases = { Data::AlignedMatrix4(), singular, inputs.DenormalMatrix() };
+
+			for (uint32_t i = 0; i < kRandomSampleCount; ++i)
+				cases.push_back(inputs.Matrix());
+
+			uint32_t mismatches = 0;
+
+			for (const Data::AlignedMatrix4& matrix : cases)
+			{
+				Data::AlignedMatrix4 result;
+				Tools::SIMD::Inverse(matrix, result);
+				const Data::AlignedMatrix4 expected(matrix.ToMatrix4().Inverse());
+				mismatches += !IsNear(result.elements, expected.elements, 16);
+			}
+
+			CheckMismatches(p_level + " Inverse", mismatches, static_cast<uint32_t>(cases.size()));
+		});
+	}
+
+	void TestSlerp()
+	{
+		ForEachSupportedLevel([](const std::string& p_level)
+		{
+			InputGenerator inputs;
+
+			struct SlerpCase
+			{
+				Data::AlignedQuaternion start;
+				Data::AlignedQuaternion end;
+				float alpha;
+			};
+
+			const Data::AlignedQuaternion identity;
+			const Data::AlignedQuaternion random = inputs.Quaternion();
+			const Data::AlignedQuaternion almostRandom(AltMath::Quaternion(random.x + 0.001f, random.y, random.z, random.w));
+			const Data::AlignedQuaternion denormal(AltMath::Quaternion(kDenormal, -kLargeDenormal, kDenormal, 1.0f));
+
+			std::vector<SlerpCase> cases;
+
+			/* Identity, same, antipodal, almost identical and denormal quaternions, each at both bounds and in the middle of the interpolation */
+			for (float alpha : { 0.0f, 1.0f, 0.5f })
+			{
+				cases.push_back({ identity, identity, alpha });
+				cases.push_back({ identity, random, alpha });
+				cases.push_back({ random, identity, alpha });
+				cases.push_back({ random, random, alpha });
+				cases.push_back({ random, Negate(random), alpha });
+				cases.push_back({ identity, Negate(identity), alpha });
+				cases.push_back({ random, almostRandom, alpha });
+				cases.push_back({ denormal, identity, alpha });
+				cases.push_back({ denormal, random, alpha });
+			}
+
+			for (uint32_t i = 0; i < kRandomSampleCount; ++i)
+			{
+				const Data::AlignedQuaternion start = inputs.Quaternion();
+				const Data::AlignedQuaternion end = inputs.Quaternion();
+				cases.push_back({ start, end, inputs.Alpha() });
+			}
+
+			uint32_t mismatches = 0;
+
+			for (const SlerpCase& slerpCase : cases)
+			{
+				Data::AlignedQuaternion result;
+				Tools::SIMD::Slerp(slerpCase.start, slerpCase.end, slerpCase.alpha, result);
+
+				/* AltMath normalizes its inputs in place */
+				AltMath::Quaternion start = slerpCase.start.ToQuaternion();
+				AltMath::Quaternion end = slerpCase.end.ToQuaternion();
+				const Data::AlignedQuaternion expected(AltMath::Quaternion::Slerp(start, end, slerpCase.alpha));
+
+				mismatches += !IsNear(&result.x, &expected.x, 4);
+			}
+
+			CheckMismatches(p_level + " Slerp", mismatches, static_cast<uint32_t>(cases.size()));
+		});
+	}
+
+	void TestToMatrix4()
+	{
+		ForEachSupportedLevel([](const std::string& p_level)
+		{
+			InputGenerator inputs;
+
+			/* Identity, antipodal (Same rotation), denormal and not normalized quaternions */
+			const Data::AlignedQuaternion random = inputs.Quaternion();
+			std::vector<Data::AlignedQuaternion> cases =
+			{
+				Data::AlignedQuaternion(),
+				Negate(Data::AlignedQuaternion()),
+				random,
+				Negate(random),
+				Data::AlignedQuaternion(AltMath::Quaternion(kDenormal, -kLargeDenormal, kDenormal, 1.0f)),
+				Data::AlignedQuaternion(AltMath::Quaternion(random.x * 3.0f, random.y * 3.0f, random.z * 3.0f, random.w * 3.0f))
+			};
+
+			for (uint32_t i = 0; i < kRandomSampleCount; ++i)
+				cases.push_back(inputs.Quaternion());
+
+			uint32_t mismatches = 0;
+
+			for (const Data::AlignedQuaternion& quaternion : cases)
+			{
+				Data::AlignedMatrix4 result;
+				Tools::SIMD::ToMatrix4(quaternion, result);
+				const Data::AlignedMatrix4 expected(quaternion.ToQuaternion().ToMatrix4());
+				mismatches += !IsNear(result.elements, expected.elements, 16);
+			}
+
+			CheckMismatches(p_level + " ToMatrix4", mismatches, static_cast<uint32_t>(cases.size()));
+		});
+	}
+
+	void TestLerp()
+	{
+		ForEachSupportedLevel([](const std::string& p_level)
+		{
+			InputGenerator inputs;
+
+			struct LerpCase
+			{
+				Data::AlignedVector3 start;
+				Data::AlignedVector3 end;
+				float alpha;
+			};
+
+			const Data::AlignedVector3 random = inputs.Vector();
+			const Data::AlignedVector3 denormal(AltMath::Vector3f(kDenormal, -kLargeDenormal, 0.0f));
+
+			std::vector<LerpCase> cases;
+
+			for (float alpha : { 0.0f, 1.0f, 0.5f })
+			{
+				cases.push_back({ Data::AlignedVector3(), random, alpha });
+				cases.push_back({ random, random, alpha });
+				cases.push_back({ denormal, random, alpha });
+				cases.push_back({ denormal, denormal, alpha });
+			}
+
+			for (uint32_t i = 0; i < kRandomSampleCount; ++i)
+			{
+				const Data::AlignedVector3 start = inputs.Vector();
+				const Data::AlignedVector3 end = inputs.Vector();
+				cases.push_back({ start, end, inputs.Alpha() });
+			}
+
+			uint32_t mismatches = 0;
+
+			for (const LerpCase& lerpCase : cases)
+			{
+				Data::AlignedVector3 result;
+				Tools::SIMD::Lerp(lerpCase.start, lerpCase.end, lerpCase.alpha, result);
+				const Data::AlignedVector3 expected(AltMath::Vector3f::Lerp(lerpCase.start.ToVector3(), lerpCase.end.ToVector3(), lerpCase.alpha));
+				mismatches += !IsNear(&result.x, &expected.x, 3);
+			}
+
+			CheckMismatches(p_level + " Lerp", mismatches, static_cast<uint32_t>(cases.size()));
+		});
+	}
+
+	void TestMatrix3x4Multiply()
+	{
+		ForEachSupportedLevel([](const std::string& p_level)
+		{
+			InputGenerator inputs;
+
+			auto toMatrix3x4 = [](const Data::AlignedMatrix4& p_matrix)
+			{
+				Data::Matrix3x4 matrix;
+				std::memcpy(matrix.elements, p_matrix.elements, sizeof(matrix.elements));
+				return matrix;
+			};
+
+			std::vector<std::pair<Data::AlignedMatrix4, Data::AlignedMatrix4>> cases =
+			{
+				{ Data::AlignedMatrix4(), Data::AlignedMatrix4() },
+				{ Data::AlignedMatrix4(), inputs.Matrix() },
+				{ inputs.Matrix(), Data::AlignedMatrix4() },
+				{ inputs.DenormalMatrix(), inputs.Matrix() },
+				{ inputs.Matrix(), inputs.DenormalMatrix() }
+			};
+
+			for (uint32_t i = 0; i < kRandomSampleCount; ++i)
+				cases.emplace_back(inputs.Matrix(), inputs.Matrix());
+
+			uint32_t mismatches = 0;
+
+			/* The implicit last row of Matrix3x4 is the one of the bone matrices : (0, 0, 0, 1) */
+			for (const auto& [left, right] : cases)
+			{
+				const Data::Matrix3x4 result = Data::Matrix3x4::Multiply(toMatrix3x4(left), toMatrix3x4(right));
+				const Data::AlignedMatrix4 expected(left.ToMatrix4() * right.ToMatrix4());
+				mismatches += !IsNear(result.elements, expected.elements, 12);
+			}
+
+			CheckMismatches(p_level + " Matrix3x4::Multiply", mismatches, static_cast<uint32_t>(cases.size()));
+		});
+	}
+
+	void TestHalfMatrix3x4()
+	{
+		ForEachSupportedLevel([](const std::string& p_level)
+		{
+			InputGenerator inputs;
+
+			/* Half denormals (Under 6.1e-5), signed zeros and the largest half, on top of bone matrices */
+			Data::Matrix3x4 edges;
+			const float edgeValues[12] = { 0.0f, -0.0f, 1e-5f, -3e-7f, 6e-8f, 65504.0f, -65504.0f, 1.0f, -1.0f, 0.5f, 1e-4f, 2048.0f };
+			std::memcpy(edges.elements, edgeValues, sizeof(edgeValues));
+
+			std::vector<Data::HalfMatrix3x4> cases = { Data::HalfMatrix3x4(), Data::HalfMatrix3x4(edges) };
+
+			for (uint32_t i = 0; i < kRandomSampleCount; ++i)
+			{
+				const Data::AlignedMatrix4 matrix = inputs.Matrix();
+				Data::Matrix3x4 matrix3x4;
+				std::memcpy(matrix3x4.elements, matrix.elements, sizeof(matrix3x4.elements));
+				cases.emplace_back(matrix3x4);
+			}
+
+			std::vector<Data::Matrix3x4> converted(cases.size());
+			Data::HalfMatrix3x4::ToMatrix3x4(cases.data(), converted.data(), cases.size());
+
+			/* The conversion is exact, every level must give the bits of Tools::Math::HalfToFloat */
+			uint32_t mismatches = 0;
+
+			for (size_t i = 0; i < cases.size(); ++i)
+			{
+				float expected[12];
+				for (uint8_t element = 0; element < 12; ++element)
+					expected[element] = Tools::Math::HalfToFloat(cases[i].elements[element]);
+
+				const Data::Matrix3x4 single = cases[i].ToMatrix3x4();
+				mismatches += std::memcmp(single.elements, expected, sizeof(expected)) != 0;
+				mismatches += std::memcmp(converted[i].elements, expected, sizeof(expected)) != 0;
+			}
+
+			CheckMismatches(p_level + " HalfMatrix3x4::ToMatrix3x4", mismatches, static_cast<uint32_t>(cases.size() * 2));
+		});
+	}
+}
+
+void AnimationProgramming::Tests::SIMDTests::Register(TestSuite& p_suite)
+{
+	p_suite.Add("SIMD/Multiply", TestMultiply);
+	p_suite.Add("SIMD/Inverse", TestInverse);
+	p_suite.Add("SIMD/Slerp", TestSlerp);
+	p_suite.Add("SIMD/ToMatrix4", TestToMatrix4);
+	p_suite.Add("SIMD/Lerp", TestLerp);
+	p_suite.Add("SIMD/Matrix3x4::Multiply", TestMatrix3x4Multiply);
+	p_suite.Add("SIMD/HalfMatrix3x4::ToMatrix3x4", TestHalfMatrix3x4);
+}
@@ -0,0 +1,58 @@
+/**
+* Project AnimationProgramming
+* @author Adrien Givry
+* @version 1.0
+*/
+
+#include <iostream>
+
+#include "Tests/TestSuite.h"
+
+namespace
+{
+	/* Incremented by Check, reset before each test */
+	uint32_t g_failedCheckCount = 0;
+}
+
+void AnimationProgramming::Tests::TestSuite::Add(const std::string& p_name, std::function<void()> p_test)
+{
+	m_tests.push_back({ p_name, std::move(p_test) });
+}
+
+uint32_t AnimationProgramming::Tests::TestSuite::Run(const std::string& p_filter) const
+{
+	uint32_t failedTestCount = 0;
+
+	for (const Test& test : m_tests)
+	{
+		if (!p_filter.empty() && test.name.find(p_filter) == std::string::npos)
+			continue;
+
+		g_failedCheckCount = 0;
+		test.body();
+
+		std::cout << (g_failedCheckCount == 0 ? "[ OK ] " : "[FAIL] ") << test.name << std::endl;
+		failedTestCount += g_failedCheckCount != 0;
+	}
+
+	return failedTestCount;
+}
+
+uint32_t AnimationProgramming::Tests::TestSuite::Count(const std::string& p_filter) const
+{
+	uint32_t count = 0;
+
+	for (const Test& test : m_tests)
+		count += p_filter.empty() || test.name.find(p_filter) != std::string::npos;
+
+	return count;
+}
+
+void AnimationProgramming::Tests::TestSuite::Check(const std::string& p_description, bool p_passed)
+{
+	if (!p_passed)
+	{
+		std::cout << "       FAILED: " << p_description << std::endl;
+		++g_failedCheckCount;
+	}
+}